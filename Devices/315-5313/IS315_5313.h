@@ -39,7 +39,7 @@ public:
 
 public:
 	// Interface version functions
-	static inline unsigned int ThisIS315_5313Version() { return 1; }
+	static inline unsigned int ThisIS315_5313Version() { return 2; }
 	virtual unsigned int GetIS315_5313Version() const = 0;
 
 	// Device access functions
@@ -57,8 +57,8 @@ public:
 	virtual unsigned int GetImageLastRenderedFrameToken() const = 0;
 	virtual unsigned int GetImageCompletedBufferPlaneNo() const = 0;
 	virtual unsigned int GetImageDrawingBufferPlaneNo() const = 0;
-	virtual void LockImageBufferData(unsigned int planeNo) = 0;
-	virtual void UnlockImageBufferData(unsigned int planeNo) = 0;
+	virtual unsigned int LockImageBufferData() = 0;
+	virtual void UnlockImageBufferData() = 0;
 	virtual const unsigned char* GetImageBufferData(unsigned int planeNo) const = 0;
 	virtual const ImageBufferInfo* GetImageBufferInfo(unsigned int planeNo) const = 0;
 	virtual const ImageBufferInfo* GetImageBufferInfo(unsigned int planeNo, unsigned int lineNo, unsigned int pixelNo) const = 0;
@@ -138,6 +138,8 @@ public:
 	inline void SetVideoEnableFullImageBufferInfo(bool data);
 	inline bool GetGensKModDebuggingEnabled() const;
 	inline void SetGensKModDebuggingEnabled(bool data);
+	inline bool GetDMAAccessSlotBatchingEnabled() const;
+	inline void SetDMAAccessSlotBatchingEnabled(bool data);
 
 	// Layer removal
 	inline bool GetEnableLayerA() const;
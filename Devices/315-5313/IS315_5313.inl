@@ -147,6 +147,7 @@ enum class IS315_5313::IS315_5313DataSource
 	SettingsVideoEnableSpriteHigh,
 	SettingsVideoEnableSpriteLow,
 	SettingsGensKModDebuggingEnabled,
+	SettingsDMAAccessSlotBatchingEnabled,
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -578,6 +579,21 @@ void IS315_5313::SetGensKModDebuggingEnabled(bool data)
 	WriteGenericData((unsigned int)IS315_5313DataSource::SettingsGensKModDebuggingEnabled, 0, genericData);
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+bool IS315_5313::GetDMAAccessSlotBatchingEnabled() const
+{
+	GenericAccessDataValueBool genericData;
+	ReadGenericData((unsigned int)IS315_5313DataSource::SettingsDMAAccessSlotBatchingEnabled, 0, genericData);
+	return genericData.GetValue();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void IS315_5313::SetDMAAccessSlotBatchingEnabled(bool data)
+{
+	GenericAccessDataValueBool genericData(data);
+	WriteGenericData((unsigned int)IS315_5313DataSource::SettingsDMAAccessSlotBatchingEnabled, 0, genericData);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Layer removal
 //----------------------------------------------------------------------------------------------------------------------
@@ -90,6 +90,7 @@ _renderSpriteDisplayCellCache(maxSpriteDisplayCellCacheSize)
 	// initialization the first time the system is booted.
 	_renderThreadActive = false;
 	_drawingImageBufferPlane = 0;
+	_imageBufferExchangeState = (1 << ImageBufferStateFrontPlaneShift) | (2 << ImageBufferStateReadyPlaneShift);
 	_lastRenderedFrameToken = 0;
 	for (unsigned int bufferPlaneNo = 0; bufferPlaneNo < ImageBufferPlanes; ++bufferPlaneNo)
 	{
@@ -143,6 +144,8 @@ _renderSpriteDisplayCellCache(maxSpriteDisplayCellCacheSize)
 	_gensKmodIgnoreNextDebugStop = false;
 	_gensKmodDebugTimerRunning = false;
 
+	_dmaAccessSlotBatchingEnabled = true;
+
 	_logStatusRegisterRead = false;
 	_logDataPortRead = false;
 	_logHVCounterRead = false;
@@ -217,6 +220,7 @@ bool S315_5313::BuildDevice()
 	result &= AddGenericDataInfo((new GenericAccessDataInfo(IS315_5313DataSource::SettingsVideoShowBoundaryTitleSafe, IGenericAccessDataValue::DataType::Bool)));
 	result &= AddGenericDataInfo((new GenericAccessDataInfo(IS315_5313DataSource::SettingsVideoEnableFullImageBufferInfo, IGenericAccessDataValue::DataType::Bool)));
 	result &= AddGenericDataInfo((new GenericAccessDataInfo(IS315_5313DataSource::SettingsGensKModDebuggingEnabled, IGenericAccessDataValue::DataType::Bool)));
+	result &= AddGenericDataInfo((new GenericAccessDataInfo(IS315_5313DataSource::SettingsDMAAccessSlotBatchingEnabled, IGenericAccessDataValue::DataType::Bool)));
 	result &= AddGenericDataInfo((new GenericAccessDataInfo(IS315_5313DataSource::SettingsOutputPortAccessDebugMessages, IGenericAccessDataValue::DataType::Bool)));
 	result &= AddGenericDataInfo((new GenericAccessDataInfo(IS315_5313DataSource::SettingsOutputTimingDebugMessages, IGenericAccessDataValue::DataType::Bool)));
 	result &= AddGenericDataInfo((new GenericAccessDataInfo(IS315_5313DataSource::SettingsOutputRenderSyncDebugMessages, IGenericAccessDataValue::DataType::Bool)));
@@ -255,7 +259,8 @@ bool S315_5313::BuildDevice()
 	                     ->AddEntry(new GenericAccessGroupDataEntry(IS315_5313DataSource::SettingsOutputPortAccessDebugMessages, L"Port Access Debug"))
 	                     ->AddEntry(new GenericAccessGroupDataEntry(IS315_5313DataSource::SettingsOutputTimingDebugMessages, L"Timing Debug"))
 	                     ->AddEntry(new GenericAccessGroupDataEntry(IS315_5313DataSource::SettingsOutputRenderSyncDebugMessages, L"Render Sync Debug"))
-	                     ->AddEntry(new GenericAccessGroupDataEntry(IS315_5313DataSource::SettingsOutputInterruptDebugMessages, L"Interrupt Debug")))
+	                     ->AddEntry(new GenericAccessGroupDataEntry(IS315_5313DataSource::SettingsOutputInterruptDebugMessages, L"Interrupt Debug"))
+	                     ->AddEntry(new GenericAccessGroupDataEntry(IS315_5313DataSource::SettingsDMAAccessSlotBatchingEnabled, L"Batch DMA Slots")))
 	                 ->AddEntry((new GenericAccessGroup(L"Software Debug Link"))
 	                     ->AddEntry(new GenericAccessGroupDataEntry(IS315_5313DataSource::SettingsGensKModDebuggingEnabled, L"Gens KMod Debug")));
 	result &= AddGenericAccessPage(debugSettingsPage);
@@ -1063,6 +1068,12 @@ double S315_5313::GetNextTimingPointInDeviceTime(unsigned int& accessContext) co
 	return timeFromEndOfLastTimesliceToNextEventInSystemTime;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+bool S315_5313::UsesTimingPoints() const
+{
+	return true;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void S315_5313::ExecuteRollback()
 {
@@ -1480,12 +1491,26 @@ void S315_5313::ExecuteCommit()
 	}
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+bool S315_5313::UsesParallelCommit() const
+{
+	// Our commit and rollback operations only touch our own state, and the VRAM, CRAM,
+	// VSRAM, and sprite cache timed buffers. Those buffers are owned by separate devices,
+	// but those devices never commit or roll them back themselves, and we're the only
+	// device which drives them, so we can safely be committed in parallel with other
+	// devices. Our render and DMA worker threads are only synchronized with through our
+	// own mutexes.
+	return true;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // DMA functions
 //----------------------------------------------------------------------------------------------------------------------
 void S315_5313::DMAWorkerThread()
 {
 	std::unique_lock<std::mutex> lock(_workerThreadMutex);
+	ITraceRecorder& traceRecorder = GetSystemInterface().GetTraceRecorder();
+	traceRecorder.SetCurrentThreadTraceName(L"VDPDMA - " + GetDeviceInstanceName());
 
 	//##DEBUG##
 //	std::wcout << L"DMAWorkerThread running\n";
@@ -1536,6 +1561,8 @@ void S315_5313::DMAWorkerThread()
 			// the end of the current timeslice.
 			if (_dmaTransferActive && _busGranted)
 			{
+				ITraceRecorder::Scope traceScope(traceRecorder, "DMATransferStep");
+
 				// Advance the DMA operation. Note that we execute up to exactly 1 more
 				// MCLK cycle than is available in the current timeslice. We need to do
 				// this because there may be additional time remaining in the timeslice
@@ -1833,17 +1860,30 @@ void S315_5313::UpdateInternalState(unsigned int mclkCyclesTarget, bool checkFif
 		// fill once the FIFO returns to an empty state.
 		if (_commandCode.GetBit(5) && _dmd1 && !_dmd0 && _dmaFillOperationRunning && IsWriteFIFOEmpty())
 		{
-			PerformDMAFillOperation();
+			PerformDMAFillOperation(GetProcessorStateMclkCurrent());
 			AdvanceDMAState();
 		}
 
 		// Advance a DMA copy operation
 		if (_commandCode.GetBit(5) && _dmd1 && _dmd0)
 		{
-			PerformDMACopyOperation();
+			PerformDMACopyOperation(GetProcessorStateMclkCurrent());
 			AdvanceDMAState();
 		}
 
+		// If a DMA fill or copy operation is still running, and the caller isn't waiting on
+		// a FIFO or read state change which could occur at the next access slot, apply all
+		// the remaining fill or copy writes which fall within this update step in bulk,
+		// rather than returning to this loop for each individual access slot. Port accesses
+		// and register changes are only ever made between calls to this function, so
+		// nothing else can interleave with the operation before the update target is
+		// reached. Batching can be disabled from the debug settings, to compare against
+		// the per-slot path.
+		if (_dmaAccessSlotBatchingEnabled && !stopWhenFifoEmpty && !stopWhenFifoFull && !stopWhenFifoNotFull && !stopWhenReadDataAvailable && !allowAdvancePastCycleTarget)
+		{
+			PerformDMAFillOrCopyBatch(mclkCyclesTarget);
+		}
+
 		// Perform a VRAM read cache operation
 		bool readOperationPerformed = false;
 		if (IsWriteFIFOEmpty() && !_readDataAvailable && ValidReadTargetInCommandCode())
@@ -1962,60 +2002,9 @@ bool S315_5313::AdvanceProcessorState(unsigned int mclkCyclesTarget, bool stopAt
 		const HScanSettings& hscanSettings = GetHScanSettings(_screenModeRS0, _screenModeRS1);
 		const VScanSettings& vscanSettings = GetVScanSettings(_screenModeV30, _palMode, _interlaceEnabled);
 
-		// If the caller has requested the update to stop at the next access slot, gather
-		// information on the next access slot update point.
-		bool updatePointAccessSlotActive = false;
-		unsigned int pixelClockTicksBeforeUpdatePointAccessSlot = 0;
-		if (stopAtNextAccessSlot)
-		{
-			// Calculate the number of pixel clock ticks which will occur before the next
-			// access slot occurs
-			updatePointAccessSlotActive = true;
-			pixelClockTicksBeforeUpdatePointAccessSlot = GetPixelClockTicksUntilNextAccessSlot(hscanSettings, vscanSettings, _hcounter.GetData(), _screenModeRS0, _screenModeRS1, _displayEnabledCached, _vcounter.GetData());
-		}
-
-		// Gather information on the next hblank update point
-		bool updatePointHBlankActive = false;
-		unsigned int pixelClockTicksBeforeUpdatePointHBlank = 0;
-		if (hscanSettingsChanged)
-		{
-			// Calculate the number of pixel clock ticks until the hblank event occurs, and
-			// new screen mode settings are latched.
-			updatePointHBlankActive = true;
-			pixelClockTicksBeforeUpdatePointHBlank = GetPixelClockStepsBetweenHCounterValues(hscanSettings, _hcounter.GetData(), hscanSettings.hblankSetPoint);
-		}
-
-		// Gather information on the next vblank update point
-		bool updatePointVBlankActive = false;
-		unsigned int pixelClockTicksBeforeUpdatePointVBlank = 0;
-		if (vscanSettingsChanged)
-		{
-			// Calculate the number of pixel clock ticks until the vblank event occurs, and
-			// new screen mode settings are latched.
-			updatePointVBlankActive = true;
-			pixelClockTicksBeforeUpdatePointVBlank = GetPixelClockStepsBetweenHVCounterValues(true, hscanSettings, _hcounter.GetData(), hscanSettings.vcounterIncrementPoint, vscanSettings, _interlaceEnabled, GetStatusFlagOddInterlaceFrame(), _vcounter.GetData(), vscanSettings.vblankSetPoint);
-		}
-
-		// Gather information on the next vint update point
-		bool updatePointVIntActive = true;
-		unsigned int pixelClockTicksBeforeUpdatePointVInt = GetPixelClockStepsBetweenHVCounterValues(true, hscanSettings, _hcounter.GetData(), hscanSettings.fflagSetPoint, vscanSettings, _interlaceEnabled, GetStatusFlagOddInterlaceFrame(), _vcounter.GetData(), vscanSettings.vblankSetPoint);
-
-		// Gather information on the next exint update point
-		bool updatePointEXIntActive = false;
-		unsigned int pixelClockTicksBeforeUpdatePointEXInt = 0;
-		if (_externalInterruptVideoTriggerPointPending)
-		{
-			pixelClockTicksBeforeUpdatePointEXInt = GetPixelClockStepsBetweenHVCounterValues(true, hscanSettings, _hcounter.GetData(), _externalInterruptVideoTriggerPointHCounter, vscanSettings, _interlaceEnabled, GetStatusFlagOddInterlaceFrame(), _vcounter.GetData(), _externalInterruptVideoTriggerPointVCounter);
-		}
-
-		// Gather information on the next hint counter advance update point
-		bool updatePointHIntCounterAdvanceActive = true;
-		// Note that since the HINT counter is advanced on the vcounter increment point, we
-		// always need to increment the vcounter by 1 to get the vcounter event pos, since
-		// no matter what the current value of the vcounter is, it must always be advanced
-		// by 1 before we can reach the target event.
-		unsigned int updatePointHIntCounterAdvanceVCounter = AddStepsToVCounter(hscanSettings, _hcounter.GetData(), vscanSettings, _interlaceEnabled, GetStatusFlagOddInterlaceFrame(), _vcounter.GetData(), 1);
-		unsigned int pixelClockTicksBeforeUpdatePointHIntCounterAdvance = GetPixelClockStepsBetweenHVCounterValues(true, hscanSettings, _hcounter.GetData(), hscanSettings.vcounterIncrementPoint, vscanSettings, _interlaceEnabled, GetStatusFlagOddInterlaceFrame(), _vcounter.GetData(), updatePointHIntCounterAdvanceVCounter);
+		// Gather information on each update point which could split this update step
+		UpdateStepPoints updatePoints;
+		GetUpdateStepPoints(hscanSettings, vscanSettings, _hcounter.GetData(), _vcounter.GetData(), GetStatusFlagOddInterlaceFrame(), stopAtNextAccessSlot, hscanSettingsChanged, vscanSettingsChanged, updatePoints);
 
 		// Calculate the number of mclk cycles available to advance in this next step in
 		// order to reach the target mclk cycle count.
@@ -2027,43 +2016,13 @@ bool S315_5313::AdvanceProcessorState(unsigned int mclkCyclesTarget, bool stopAt
 		unsigned int pixelClockCyclesAvailableInUpdateStep = GetPixelClockTicksForMclkTicks(hscanSettings, _stateLastUpdateMclkUnused + mclkCyclesAvailableInUpdateStep, _hcounter.GetData(), _screenModeRS0, _screenModeRS1, mclkRemainingCycles);
 
 		// Set this advance operation to stop at the next update point if required
+		bool stepEndsAtUpdatePoint;
 		unsigned int mclkCyclesToAdvanceThisStep = mclkCyclesAvailableInUpdateStep;
-		unsigned int pixelClockCyclesToAdvanceThisStep = pixelClockCyclesAvailableInUpdateStep;
-		if (updatePointAccessSlotActive && stopAtNextAccessSlot && ((pixelClockTicksBeforeUpdatePointAccessSlot < pixelClockCyclesToAdvanceThisStep) || allowAdvancePastTargetForAccessSlot))
+		unsigned int pixelClockCyclesToAdvanceThisStep = GetPixelClockTicksForUpdateStep(updatePoints, pixelClockCyclesAvailableInUpdateStep, allowAdvancePastTargetForAccessSlot, stepEndsAtUpdatePoint);
+		if (stepEndsAtUpdatePoint)
 		{
-			mclkCyclesToAdvanceThisStep = GetMclkTicksForPixelClockTicks(hscanSettings, pixelClockTicksBeforeUpdatePointAccessSlot, _hcounter.GetData(), _screenModeRS0, _screenModeRS1) - _stateLastUpdateMclkUnused;
+			mclkCyclesToAdvanceThisStep = GetMclkTicksForPixelClockTicks(hscanSettings, pixelClockCyclesToAdvanceThisStep, _hcounter.GetData(), _screenModeRS0, _screenModeRS1) - _stateLastUpdateMclkUnused;
 			mclkRemainingCycles = 0;
-			pixelClockCyclesToAdvanceThisStep = pixelClockTicksBeforeUpdatePointAccessSlot;
-		}
-		if (updatePointHBlankActive && (pixelClockTicksBeforeUpdatePointHBlank < pixelClockCyclesToAdvanceThisStep))
-		{
-			mclkCyclesToAdvanceThisStep = GetMclkTicksForPixelClockTicks(hscanSettings, pixelClockTicksBeforeUpdatePointHBlank, _hcounter.GetData(), _screenModeRS0, _screenModeRS1) - _stateLastUpdateMclkUnused;
-			mclkRemainingCycles = 0;
-			pixelClockCyclesToAdvanceThisStep = pixelClockTicksBeforeUpdatePointHBlank;
-		}
-		if (updatePointVBlankActive && (pixelClockTicksBeforeUpdatePointVBlank < pixelClockCyclesToAdvanceThisStep))
-		{
-			mclkCyclesToAdvanceThisStep = GetMclkTicksForPixelClockTicks(hscanSettings, pixelClockTicksBeforeUpdatePointVBlank, _hcounter.GetData(), _screenModeRS0, _screenModeRS1) - _stateLastUpdateMclkUnused;
-			mclkRemainingCycles = 0;
-			pixelClockCyclesToAdvanceThisStep = pixelClockTicksBeforeUpdatePointVBlank;
-		}
-		if (updatePointVIntActive && (pixelClockTicksBeforeUpdatePointVInt < pixelClockCyclesToAdvanceThisStep))
-		{
-			mclkCyclesToAdvanceThisStep = GetMclkTicksForPixelClockTicks(hscanSettings, pixelClockTicksBeforeUpdatePointVInt, _hcounter.GetData(), _screenModeRS0, _screenModeRS1) - _stateLastUpdateMclkUnused;
-			mclkRemainingCycles = 0;
-			pixelClockCyclesToAdvanceThisStep = pixelClockTicksBeforeUpdatePointVInt;
-		}
-		if (updatePointEXIntActive && (pixelClockTicksBeforeUpdatePointEXInt < pixelClockCyclesToAdvanceThisStep))
-		{
-			mclkCyclesToAdvanceThisStep = GetMclkTicksForPixelClockTicks(hscanSettings, pixelClockTicksBeforeUpdatePointEXInt, _hcounter.GetData(), _screenModeRS0, _screenModeRS1) - _stateLastUpdateMclkUnused;
-			mclkRemainingCycles = 0;
-			pixelClockCyclesToAdvanceThisStep = pixelClockTicksBeforeUpdatePointEXInt;
-		}
-		if (updatePointHIntCounterAdvanceActive && (pixelClockTicksBeforeUpdatePointHIntCounterAdvance < pixelClockCyclesToAdvanceThisStep))
-		{
-			mclkCyclesToAdvanceThisStep = GetMclkTicksForPixelClockTicks(hscanSettings, pixelClockTicksBeforeUpdatePointHIntCounterAdvance, _hcounter.GetData(), _screenModeRS0, _screenModeRS1) - _stateLastUpdateMclkUnused;
-			mclkRemainingCycles = 0;
-			pixelClockCyclesToAdvanceThisStep = pixelClockTicksBeforeUpdatePointHIntCounterAdvance;
 		}
 
 		//##DEBUG##
@@ -2212,14 +2171,14 @@ bool S315_5313::AdvanceProcessorState(unsigned int mclkCyclesTarget, bool stopAt
 
 		// If we're stopping at an access slot, flag that we've reached the target access
 		// slot.
-		if (updatePointAccessSlotActive && (pixelClockTicksBeforeUpdatePointAccessSlot == pixelClockCyclesToAdvanceThisStep))
+		if (updatePoints.accessSlotActive && (updatePoints.pixelClockTicksBeforeAccessSlot == pixelClockCyclesToAdvanceThisStep))
 		{
 			stoppedAtAccessSlot = true;
 		}
 
 		// If horizontal scan information has changed, and we've just advanced to hblank,
 		// latch the new screen mode settings.
-		if (updatePointHBlankActive && (pixelClockTicksBeforeUpdatePointHBlank == pixelClockCyclesToAdvanceThisStep))
+		if (updatePoints.hblankActive && (updatePoints.pixelClockTicksBeforeHBlank == pixelClockCyclesToAdvanceThisStep))
 		{
 			//##FIX## These settings changes are supposed to take effect immediately
 			_screenModeRS0 = screenModeRS0New;
@@ -2232,7 +2191,7 @@ bool S315_5313::AdvanceProcessorState(unsigned int mclkCyclesTarget, bool stopAt
 
 		// If vertical scan information has changed, and we've just advanced to vblank,
 		// latch the new screen mode settings.
-		if (updatePointVBlankActive && (pixelClockTicksBeforeUpdatePointVBlank == pixelClockCyclesToAdvanceThisStep))
+		if (updatePoints.vblankActive && (updatePoints.pixelClockTicksBeforeVBlank == pixelClockCyclesToAdvanceThisStep))
 		{
 			// If the interlace mode has changed, the new setting is latched when the
 			// vblank set event occurs. This has been verified in all video modes through
@@ -2254,7 +2213,7 @@ bool S315_5313::AdvanceProcessorState(unsigned int mclkCyclesTarget, bool stopAt
 		// flag. Note that the actual analog VINT line state change would have already been
 		// raised in advance to occur at this time, we simply need to set the digital state
 		// of the VDP to reflect this now.
-		if (updatePointVIntActive && (pixelClockTicksBeforeUpdatePointVInt == pixelClockCyclesToAdvanceThisStep))
+		if (updatePoints.vintActive && (updatePoints.pixelClockTicksBeforeVInt == pixelClockCyclesToAdvanceThisStep))
 		{
 			// Set the VINT pending flag, to indicate that the VDP needs to trigger a
 			// vertical interrupt.
@@ -2273,7 +2232,7 @@ bool S315_5313::AdvanceProcessorState(unsigned int mclkCyclesTarget, bool stopAt
 		// pending flag. Note that the actual analog EXINT line state change would have
 		// already been raised in advance to occur at this time, we simply need to set the
 		// digital state of the VDP to reflect this now.
-		if (updatePointEXIntActive && (pixelClockTicksBeforeUpdatePointEXInt == pixelClockCyclesToAdvanceThisStep))
+		if (updatePoints.exintActive && (updatePoints.pixelClockTicksBeforeEXInt == pixelClockCyclesToAdvanceThisStep))
 		{
 			// Since this external interrupt trigger point has now been processed, flag
 			// that it is no longer pending.
@@ -2297,9 +2256,9 @@ bool S315_5313::AdvanceProcessorState(unsigned int mclkCyclesTarget, bool stopAt
 		// counter and calculate its new value. Note that horizontal interrupt generation
 		// would have already been raised at the correct time, but we need to change the
 		// digital state of the VDP to reflect this.
-		if (updatePointHIntCounterAdvanceActive && (pixelClockTicksBeforeUpdatePointHIntCounterAdvance == pixelClockCyclesToAdvanceThisStep))
+		if (updatePoints.hintCounterAdvanceActive && (updatePoints.pixelClockTicksBeforeHIntCounterAdvance == pixelClockCyclesToAdvanceThisStep))
 		{
-			if (updatePointHIntCounterAdvanceVCounter > vscanSettings.vblankSetPoint)
+			if (updatePoints.hintCounterAdvanceVCounter > vscanSettings.vblankSetPoint)
 			{
 				// Latch the initial hintCounter value for the frame
 				_hintCounter = _hintCounterReloadValue;
@@ -2335,6 +2294,111 @@ bool S315_5313::AdvanceProcessorState(unsigned int mclkCyclesTarget, bool stopAt
 	return !stoppedAtAccessSlot;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void S315_5313::GetUpdateStepPoints(const HScanSettings& hscanSettings, const VScanSettings& vscanSettings, unsigned int hcounter, unsigned int vcounter, bool oddFlagSet, bool stopAtNextAccessSlot, bool hscanSettingsChanged, bool vscanSettingsChanged, UpdateStepPoints& updatePoints) const
+{
+	// Note that this is used both to advance the processor state, and to predict the
+	// access slots a DMA operation will use ahead of time, so the HV counter position is
+	// supplied by the caller rather than being taken from the current processor state.
+
+	// If the caller has requested the update to stop at the next access slot, gather
+	// information on the next access slot update point.
+	updatePoints.accessSlotActive = false;
+	updatePoints.pixelClockTicksBeforeAccessSlot = 0;
+	if (stopAtNextAccessSlot)
+	{
+		// Calculate the number of pixel clock ticks which will occur before the next
+		// access slot occurs
+		updatePoints.accessSlotActive = true;
+		updatePoints.pixelClockTicksBeforeAccessSlot = GetPixelClockTicksUntilNextAccessSlot(hscanSettings, vscanSettings, hcounter, _screenModeRS0, _screenModeRS1, _displayEnabledCached, vcounter);
+	}
+
+	// Gather information on the next hblank update point
+	updatePoints.hblankActive = false;
+	updatePoints.pixelClockTicksBeforeHBlank = 0;
+	if (hscanSettingsChanged)
+	{
+		// Calculate the number of pixel clock ticks until the hblank event occurs, and new
+		// screen mode settings are latched.
+		updatePoints.hblankActive = true;
+		updatePoints.pixelClockTicksBeforeHBlank = GetPixelClockStepsBetweenHCounterValues(hscanSettings, hcounter, hscanSettings.hblankSetPoint);
+	}
+
+	// Gather information on the next vblank update point
+	updatePoints.vblankActive = false;
+	updatePoints.pixelClockTicksBeforeVBlank = 0;
+	if (vscanSettingsChanged)
+	{
+		// Calculate the number of pixel clock ticks until the vblank event occurs, and new
+		// screen mode settings are latched.
+		updatePoints.vblankActive = true;
+		updatePoints.pixelClockTicksBeforeVBlank = GetPixelClockStepsBetweenHVCounterValues(true, hscanSettings, hcounter, hscanSettings.vcounterIncrementPoint, vscanSettings, _interlaceEnabled, oddFlagSet, vcounter, vscanSettings.vblankSetPoint);
+	}
+
+	// Gather information on the next vint update point
+	updatePoints.vintActive = true;
+	updatePoints.pixelClockTicksBeforeVInt = GetPixelClockStepsBetweenHVCounterValues(true, hscanSettings, hcounter, hscanSettings.fflagSetPoint, vscanSettings, _interlaceEnabled, oddFlagSet, vcounter, vscanSettings.vblankSetPoint);
+
+	// Gather information on the next exint update point
+	updatePoints.exintActive = false;
+	updatePoints.pixelClockTicksBeforeEXInt = 0;
+	if (_externalInterruptVideoTriggerPointPending)
+	{
+		updatePoints.pixelClockTicksBeforeEXInt = GetPixelClockStepsBetweenHVCounterValues(true, hscanSettings, hcounter, _externalInterruptVideoTriggerPointHCounter, vscanSettings, _interlaceEnabled, oddFlagSet, vcounter, _externalInterruptVideoTriggerPointVCounter);
+	}
+
+	// Gather information on the next hint counter advance update point
+	updatePoints.hintCounterAdvanceActive = true;
+	// Note that since the HINT counter is advanced on the vcounter increment point, we
+	// always need to increment the vcounter by 1 to get the vcounter event pos, since no
+	// matter what the current value of the vcounter is, it must always be advanced by 1
+	// before we can reach the target event.
+	updatePoints.hintCounterAdvanceVCounter = AddStepsToVCounter(hscanSettings, hcounter, vscanSettings, _interlaceEnabled, oddFlagSet, vcounter, 1);
+	updatePoints.pixelClockTicksBeforeHIntCounterAdvance = GetPixelClockStepsBetweenHVCounterValues(true, hscanSettings, hcounter, hscanSettings.vcounterIncrementPoint, vscanSettings, _interlaceEnabled, oddFlagSet, vcounter, updatePoints.hintCounterAdvanceVCounter);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int S315_5313::GetPixelClockTicksForUpdateStep(const UpdateStepPoints& updatePoints, unsigned int pixelClockCyclesAvailable, bool allowAdvancePastTargetForAccessSlot, bool& stepEndsAtUpdatePoint)
+{
+	// Stop the update step at the nearest active update point, if one occurs before the
+	// available number of pixel clock cycles runs out. Note that if we're allowed to
+	// advance past the target to reach the next access slot, the access slot always ends
+	// the step, even if it lies beyond the available cycles.
+	stepEndsAtUpdatePoint = false;
+	unsigned int pixelClockCyclesToAdvanceThisStep = pixelClockCyclesAvailable;
+	if (updatePoints.accessSlotActive && ((updatePoints.pixelClockTicksBeforeAccessSlot < pixelClockCyclesToAdvanceThisStep) || allowAdvancePastTargetForAccessSlot))
+	{
+		stepEndsAtUpdatePoint = true;
+		pixelClockCyclesToAdvanceThisStep = updatePoints.pixelClockTicksBeforeAccessSlot;
+	}
+	if (updatePoints.hblankActive && (updatePoints.pixelClockTicksBeforeHBlank < pixelClockCyclesToAdvanceThisStep))
+	{
+		stepEndsAtUpdatePoint = true;
+		pixelClockCyclesToAdvanceThisStep = updatePoints.pixelClockTicksBeforeHBlank;
+	}
+	if (updatePoints.vblankActive && (updatePoints.pixelClockTicksBeforeVBlank < pixelClockCyclesToAdvanceThisStep))
+	{
+		stepEndsAtUpdatePoint = true;
+		pixelClockCyclesToAdvanceThisStep = updatePoints.pixelClockTicksBeforeVBlank;
+	}
+	if (updatePoints.vintActive && (updatePoints.pixelClockTicksBeforeVInt < pixelClockCyclesToAdvanceThisStep))
+	{
+		stepEndsAtUpdatePoint = true;
+		pixelClockCyclesToAdvanceThisStep = updatePoints.pixelClockTicksBeforeVInt;
+	}
+	if (updatePoints.exintActive && (updatePoints.pixelClockTicksBeforeEXInt < pixelClockCyclesToAdvanceThisStep))
+	{
+		stepEndsAtUpdatePoint = true;
+		pixelClockCyclesToAdvanceThisStep = updatePoints.pixelClockTicksBeforeEXInt;
+	}
+	if (updatePoints.hintCounterAdvanceActive && (updatePoints.pixelClockTicksBeforeHIntCounterAdvance < pixelClockCyclesToAdvanceThisStep))
+	{
+		stepEndsAtUpdatePoint = true;
+		pixelClockCyclesToAdvanceThisStep = updatePoints.pixelClockTicksBeforeHIntCounterAdvance;
+	}
+	return pixelClockCyclesToAdvanceThisStep;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void S315_5313::PerformReadCacheOperation()
 {
@@ -2621,7 +2685,7 @@ void S315_5313::PerformFIFOWriteOperation()
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void S315_5313::PerformDMACopyOperation()
+void S315_5313::PerformDMACopyOperation(unsigned int mclkTime)
 {
 	// Get the current source address
 	unsigned int sourceAddress = (_dmaSourceAddressByte1) | (_dmaSourceAddressByte2 << 8);
@@ -2661,7 +2725,7 @@ void S315_5313::PerformDMACopyOperation()
 	// Perform the copy. Note that hardware tests have shown that DMA copy operations
 	// always target VRAM, regardless of the state of CD0-CD3.
 	RAMAccessTarget ramAccessTarget;
-	ramAccessTarget.AccessTime(GetProcessorStateMclkCurrent());
+	ramAccessTarget.AccessTime(mclkTime);
 	unsigned char data;
 	data = _vram->Read(sourceAddressByteswapped.GetData(), ramAccessTarget);
 	_vram->Write(targetAddressByteswapped.GetData(), data, ramAccessTarget);
@@ -2671,7 +2735,7 @@ void S315_5313::PerformDMACopyOperation()
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void S315_5313::PerformDMAFillOperation()
+void S315_5313::PerformDMAFillOperation(unsigned int mclkTime)
 {
 	//##FIX## We need to determine how the VDP knows a write has been made to the data
 	// port. VSRAM and CRAM fill targets grab the next available entry in the FIFO, after
@@ -2784,7 +2848,7 @@ void S315_5313::PerformDMAFillOperation()
 	//##TODO## Test on hardware to determine what happens when the data port is written to
 	// while a DMA fill operation is in progress.
 	RAMAccessTarget ramAccessTarget;
-	ramAccessTarget.AccessTime(GetProcessorStateMclkCurrent());
+	ramAccessTarget.AccessTime(mclkTime);
 	switch (_commandCode.GetDataSegment(0, 4))
 	{
 	case 0x01: //??0001 VRAM Write
@@ -2817,6 +2881,129 @@ void S315_5313::PerformDMAFillOperation()
 	_commandAddress += _autoIncrementData;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void S315_5313::PerformDMAFillOrCopyBatch(unsigned int mclkCyclesTarget)
+{
+	// Only batch a DMA fill or copy operation while it has exclusive use of the access
+	// slots. If the write FIFO holds pending data, or a read cache operation is waiting to
+	// run, these compete for the same access slots, and we have to step through them one
+	// at a time. Note that DMA transfer operations are never batched. Each transfer word
+	// is read from the external bus at a time the bus owner is able to stall, then passes
+	// through the write FIFO before it reaches VRAM, so the FIFO state at each access slot
+	// depends on the timing of those reads, and each step has to be taken individually.
+	bool dmaFillOperationActive = _commandCode.GetBit(5) && _dmd1 && !_dmd0 && _dmaFillOperationRunning;
+	bool dmaCopyOperationActive = _commandCode.GetBit(5) && _dmd1 && _dmd0;
+	if ((!dmaFillOperationActive && !dmaCopyOperationActive) || !IsWriteFIFOEmpty() || (ValidReadTargetInCommandCode() && !_readDataAvailable))
+	{
+		return;
+	}
+
+	// Build the schedule of access slots the operation will use before the target time is
+	// reached, limited to the number of steps remaining in the operation. Note that a DMA
+	// length counter of 0 is equivalent to a transfer count of 0x10000.
+	unsigned int dmaStepsRemaining = (_dmaLengthCounter == 0)? 0x10000: _dmaLengthCounter;
+	unsigned int scheduledSlotCount = BuildDMAAccessSlotSchedule(mclkCyclesTarget, dmaStepsRemaining);
+	if (scheduledSlotCount == 0)
+	{
+		return;
+	}
+
+	// Apply the writes for all but the last scheduled access slot directly at their
+	// scheduled times. The timed buffers accept the writes with the correct timestamps
+	// without the processor state being advanced to each slot individually.
+	for (unsigned int i = 0; i < (scheduledSlotCount - 1); ++i)
+	{
+		if (dmaFillOperationActive)
+		{
+			PerformDMAFillOperation(_dmaAccessSlotSchedule[i]);
+		}
+		else
+		{
+			PerformDMACopyOperation(_dmaAccessSlotSchedule[i]);
+		}
+		AdvanceDMAState();
+	}
+
+	// Advance the processor state to the last scheduled access slot in a single step, then
+	// perform the final write. We hold back the last write until after the advance, so
+	// that the VSRAM render read cache, which is latched as the processor state advances,
+	// sees the same VSRAM contents it would have if each slot had been stepped through
+	// individually.
+	AdvanceProcessorState(_dmaAccessSlotSchedule[scheduledSlotCount - 1], false, false);
+	if (dmaFillOperationActive)
+	{
+		PerformDMAFillOperation(GetProcessorStateMclkCurrent());
+	}
+	else
+	{
+		PerformDMACopyOperation(GetProcessorStateMclkCurrent());
+	}
+	AdvanceDMAState();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int S315_5313::BuildDMAAccessSlotSchedule(unsigned int mclkCyclesTarget, unsigned int maxSlotCount)
+{
+	// If any screen mode settings are waiting to be latched, the access slot positions
+	// can change part way through the update, so we don't attempt to build a schedule.
+	// The settings changes are latched as normal as the operation is stepped through one
+	// slot at a time.
+	bool hscanSettingsChanged = (_screenModeRS0 != _screenModeRS0Cached) || (_screenModeRS1 != _screenModeRS1Cached);
+	bool vscanSettingsChanged = (_screenModeV30 != _screenModeV30Cached) || (_palMode != _palModeLineState) || (_interlaceEnabled != _interlaceEnabledCached);
+	_dmaAccessSlotSchedule.clear();
+	if (hscanSettingsChanged || vscanSettingsChanged)
+	{
+		return 0;
+	}
+
+	// Walk a copy of the HV counter forward, splitting the walk into the same update
+	// steps AdvanceProcessorState would take when stopping at each access slot in turn,
+	// and record the mclk time of each access slot we reach. Both functions obtain their
+	// update points and step lengths from GetUpdateStepPoints and
+	// GetPixelClockTicksForUpdateStep, so the schedule can't drift from the per-slot path.
+	const HScanSettings& hscanSettings = GetHScanSettings(_screenModeRS0, _screenModeRS1);
+	const VScanSettings& vscanSettings = GetVScanSettings(_screenModeV30, _palMode, _interlaceEnabled);
+	unsigned int hcounter = _hcounter.GetData();
+	unsigned int vcounter = _vcounter.GetData();
+	bool oddFlagSet = GetStatusFlagOddInterlaceFrame();
+	unsigned int mclkCurrent = GetProcessorStateMclkCurrent();
+	unsigned int mclkUnused = _stateLastUpdateMclkUnused;
+	while ((_dmaAccessSlotSchedule.size() < maxSlotCount) && (mclkCurrent < mclkCyclesTarget))
+	{
+		// Gather information on each update point which could split this update step
+		UpdateStepPoints updatePoints;
+		GetUpdateStepPoints(hscanSettings, vscanSettings, hcounter, vcounter, oddFlagSet, true, false, false, updatePoints);
+
+		// Stop building the schedule at the first access slot the processor state wouldn't
+		// stop at before reaching the target time. Any remaining time is stepped through as
+		// normal.
+		unsigned int mclkRemainingCycles;
+		unsigned int pixelClockCyclesAvailable = GetPixelClockTicksForMclkTicks(hscanSettings, mclkUnused + (mclkCyclesTarget - mclkCurrent), hcounter, _screenModeRS0, _screenModeRS1, mclkRemainingCycles);
+		if (updatePoints.pixelClockTicksBeforeAccessSlot >= pixelClockCyclesAvailable)
+		{
+			break;
+		}
+
+		// Advance to the nearest update point
+		bool stepEndsAtUpdatePoint;
+		unsigned int pixelClockCyclesToAdvanceThisStep = GetPixelClockTicksForUpdateStep(updatePoints, pixelClockCyclesAvailable, false, stepEndsAtUpdatePoint);
+		if (pixelClockCyclesToAdvanceThisStep == 0)
+		{
+			break;
+		}
+		mclkCurrent = (mclkCurrent - mclkUnused) + GetMclkTicksForPixelClockTicks(hscanSettings, pixelClockCyclesToAdvanceThisStep, hcounter, _screenModeRS0, _screenModeRS1);
+		mclkUnused = 0;
+		AdvanceHVCounters(hscanSettings, hcounter, vscanSettings, _interlaceEnabled, oddFlagSet, vcounter, pixelClockCyclesToAdvanceThisStep);
+
+		// If this step ended on an access slot, add it to the schedule.
+		if (pixelClockCyclesToAdvanceThisStep == updatePoints.pixelClockTicksBeforeAccessSlot)
+		{
+			_dmaAccessSlotSchedule.push_back(mclkCurrent);
+		}
+	}
+	return (unsigned int)_dmaAccessSlotSchedule.size();
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void S315_5313::CacheDMATransferReadData(unsigned int mclkTime)
 {
@@ -3193,11 +3380,9 @@ void S315_5313::M5WriteVSRAM(const Data& address, const Data& data, const RAMAcc
 //----------------------------------------------------------------------------------------------------------------------
 bool S315_5313::GetScreenshot(IImage& targetImage) const
 {
-	// Determine the index of the current image plane that is being used for display
-	unsigned int displayingImageBufferPlane = GetImageCompletedBufferPlaneNo();
-
-	// Obtain a read lock on the image buffer
-	_imageBufferLock[displayingImageBufferPlane].ObtainReadLock();
+	// Pin the latest completed image plane for reading. This prevents the plane being
+	// handed back to the render thread to draw a new frame while we're reading from it.
+	unsigned int displayingImageBufferPlane = AcquireDisplayingImageBufferPlane();
 
 	// Calculate the width and height of the output image. We take the line width of the
 	// first line as the width of the output image, but it should be noted that the width
@@ -3222,7 +3407,7 @@ bool S315_5313::GetScreenshot(IImage& targetImage) const
 			Image lineImage(lineWidth, 1, IImage::PIXELFORMAT_RGB, IImage::DATAFORMAT_8BIT);
 			for (unsigned int xpos = 0; xpos < lineWidth; ++xpos)
 			{
-				const ImageBufferColorEntry& imageBufferEntry = *((const ImageBufferColorEntry*)&_imageBuffer[_drawingImageBufferPlane][((ypos * ImageBufferWidth) + xpos) * 4]);
+				const ImageBufferColorEntry& imageBufferEntry = *((const ImageBufferColorEntry*)&_imageBuffer[displayingImageBufferPlane][((ypos * ImageBufferWidth) + xpos) * 4]);
 				lineImage.WritePixelData(xpos, 0, 0, imageBufferEntry.r);
 				lineImage.WritePixelData(xpos, 0, 1, imageBufferEntry.g);
 				lineImage.WritePixelData(xpos, 0, 2, imageBufferEntry.b);
@@ -3245,7 +3430,7 @@ bool S315_5313::GetScreenshot(IImage& targetImage) const
 		{
 			for (unsigned int xpos = 0; xpos < imageWidth; ++xpos)
 			{
-				const ImageBufferColorEntry& imageBufferEntry = *((const ImageBufferColorEntry*)&_imageBuffer[_drawingImageBufferPlane][((ypos * ImageBufferWidth) + xpos) * 4]);
+				const ImageBufferColorEntry& imageBufferEntry = *((const ImageBufferColorEntry*)&_imageBuffer[displayingImageBufferPlane][((ypos * ImageBufferWidth) + xpos) * 4]);
 				targetImage.WritePixelData(xpos, ypos, 0, imageBufferEntry.r);
 				targetImage.WritePixelData(xpos, ypos, 1, imageBufferEntry.g);
 				targetImage.WritePixelData(xpos, ypos, 2, imageBufferEntry.b);
@@ -3253,8 +3438,8 @@ bool S315_5313::GetScreenshot(IImage& targetImage) const
 		}
 	}
 
-	// Release the read lock on the image buffer
-	_imageBufferLock[displayingImageBufferPlane].ReleaseReadLock();
+	// Release our pin on the image buffer plane
+	ReleaseDisplayingImageBufferPlane();
 
 	return true;
 }
@@ -3759,6 +3944,7 @@ void S315_5313::LoadDebuggerState(IHierarchicalStorageNode& node)
 				else if (registerName == L"VideoShowBoundaryTitleSafe")		_videoShowBoundaryTitleSafe = (*i)->ExtractData<bool>();
 				else if (registerName == L"VideoEnableFullImageBufferInfo")	_videoEnableFullImageBufferInfo = (*i)->ExtractData<bool>();
 				else if (registerName == L"GensKmodDebugActive")	_gensKmodDebugActive = (*i)->ExtractData<bool>();
+				else if (registerName == L"DMAAccessSlotBatchingEnabled")	_dmaAccessSlotBatchingEnabled = (*i)->ExtractData<bool>();
 				// Layer removal settings
 				else if (registerName == L"EnableLayerAHigh")		_enableLayerAHigh = (*i)->ExtractData<bool>();
 				else if (registerName == L"EnableLayerALow")			_enableLayerALow = (*i)->ExtractData<bool>();
@@ -3791,6 +3977,7 @@ void S315_5313::SaveDebuggerState(IHierarchicalStorageNode& node) const
 	node.CreateChild(L"Register", _videoShowBoundaryTitleSafe).CreateAttribute(L"name", L"VideoShowBoundaryTitleSafe");
 	node.CreateChild(L"Register", _videoEnableFullImageBufferInfo).CreateAttribute(L"name", L"VideoEnableFullImageBufferInfo");
 	node.CreateChild(L"Register", _gensKmodDebugActive).CreateAttribute(L"name", L"GensKmodDebugActive");
+	node.CreateChild(L"Register", _dmaAccessSlotBatchingEnabled).CreateAttribute(L"name", L"DMAAccessSlotBatchingEnabled");
 
 	// Layer removal settings
 	node.CreateChild(L"Register", _enableLayerAHigh).CreateAttribute(L"name", L"EnableLayerAHigh");
@@ -4039,6 +4226,8 @@ bool S315_5313::ReadGenericData(unsigned int dataID, const DataContext* dataCont
 		return dataValue.SetValue(_outputInterruptDebugMessages);
 	case IS315_5313DataSource::SettingsGensKModDebuggingEnabled:
 		return dataValue.SetValue(_gensKmodDebugActive);
+	case IS315_5313DataSource::SettingsDMAAccessSlotBatchingEnabled:
+		return dataValue.SetValue(_dmaAccessSlotBatchingEnabled);
 	case IS315_5313DataSource::SettingsVideoDisableRenderOutput:
 		return dataValue.SetValue(_videoDisableRenderOutput);
 	case IS315_5313DataSource::SettingsVideoEnableSpriteBoxing:
@@ -4719,6 +4908,11 @@ bool S315_5313::WriteGenericData(unsigned int dataID, const DataContext* dataCon
 		IGenericAccessDataValueBool& dataValueAsBool = (IGenericAccessDataValueBool&)dataValue;
 		_gensKmodDebugActive = dataValueAsBool.GetValue();
 		return true;}
+	case IS315_5313DataSource::SettingsDMAAccessSlotBatchingEnabled:{
+		if (dataType != IGenericAccessDataValue::DataType::Bool) return false;
+		IGenericAccessDataValueBool& dataValueAsBool = (IGenericAccessDataValueBool&)dataValue;
+		_dmaAccessSlotBatchingEnabled = dataValueAsBool.GetValue();
+		return true;}
 	case IS315_5313DataSource::SettingsVideoDisableRenderOutput:{
 		if (dataType != IGenericAccessDataValue::DataType::Bool) return false;
 		IGenericAccessDataValueBool& dataValueAsBool = (IGenericAccessDataValueBool&)dataValue;
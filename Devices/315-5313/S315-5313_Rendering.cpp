@@ -66,8 +66,15 @@ unsigned int S315_5313::GetImageLastRenderedFrameToken() const
 //----------------------------------------------------------------------------------------------------------------------
 unsigned int S315_5313::GetImageCompletedBufferPlaneNo() const
 {
-	unsigned int displayingImageBufferPlane = _videoSingleBuffering? _drawingImageBufferPlane: ((_drawingImageBufferPlane + ImageBufferPlanes) - 1) % ImageBufferPlanes;
-	return displayingImageBufferPlane;
+	// Note that this returns the plane currently being displayed by readers, which only
+	// moves on to a newer completed frame when a reader calls LockImageBufferData. Callers
+	// which need the contents of the plane to remain stable should use the plane number
+	// returned from LockImageBufferData instead.
+	if (_videoSingleBuffering)
+	{
+		return _drawingImageBufferPlane;
+	}
+	return (_imageBufferExchangeState.load(std::memory_order_acquire) >> ImageBufferStateFrontPlaneShift) & ImageBufferStatePlaneMask;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -77,15 +84,15 @@ unsigned int S315_5313::GetImageDrawingBufferPlaneNo() const
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void S315_5313::LockImageBufferData(unsigned int planeNo)
+unsigned int S315_5313::LockImageBufferData()
 {
-	_imageBufferLock[planeNo].ObtainReadLock();
+	return AcquireDisplayingImageBufferPlane();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void S315_5313::UnlockImageBufferData(unsigned int planeNo)
+void S315_5313::UnlockImageBufferData()
 {
-	_imageBufferLock[planeNo].ReleaseReadLock();
+	ReleaseDisplayingImageBufferPlane();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -143,12 +150,76 @@ void S315_5313::GetImageBufferActiveScanPosY(unsigned int planeNo, unsigned int&
 	endPosY = _imageBufferActiveScanPosYEnd[planeNo];
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int S315_5313::AcquireDisplayingImageBufferPlane() const
+{
+	// The three image buffer planes are exchanged as a triple buffer. The render thread
+	// owns the drawing plane outright, the most recently completed frame waits in the
+	// ready plane, and readers share the front plane. The front and ready plane numbers,
+	// a flag indicating the ready plane holds a frame readers haven't seen yet, and the
+	// number of readers currently holding the front plane, are all packed into a single
+	// atomic state word. When no other reader holds the front plane and a new frame is
+	// waiting, the first reader in swaps the front and ready planes as part of the same
+	// atomic operation which registers it as a reader. Readers never wait for the render
+	// thread, and the render thread never waits for readers.
+	unsigned int currentState = _imageBufferExchangeState.load(std::memory_order_relaxed);
+	unsigned int newState;
+	do
+	{
+		newState = currentState;
+		if (((currentState >> ImageBufferStateReaderCountShift) == 0) && ((currentState & ImageBufferStateNewFrameFlag) != 0))
+		{
+			unsigned int frontPlane = (currentState >> ImageBufferStateFrontPlaneShift) & ImageBufferStatePlaneMask;
+			unsigned int readyPlane = (currentState >> ImageBufferStateReadyPlaneShift) & ImageBufferStatePlaneMask;
+			newState &= ~((ImageBufferStatePlaneMask << ImageBufferStateFrontPlaneShift) | (ImageBufferStatePlaneMask << ImageBufferStateReadyPlaneShift) | ImageBufferStateNewFrameFlag);
+			newState |= (readyPlane << ImageBufferStateFrontPlaneShift) | (frontPlane << ImageBufferStateReadyPlaneShift);
+		}
+		newState += ImageBufferStateReaderCountIncrement;
+	}
+	while (!_imageBufferExchangeState.compare_exchange_weak(currentState, newState, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+	// If single buffering is active, readers see the frame as it's being drawn. We still
+	// register as a reader above so that the reader count remains balanced if the
+	// buffering mode is changed while the plane is held.
+	if (_videoSingleBuffering)
+	{
+		return _drawingImageBufferPlane;
+	}
+	return (newState >> ImageBufferStateFrontPlaneShift) & ImageBufferStatePlaneMask;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void S315_5313::ReleaseDisplayingImageBufferPlane() const
+{
+	_imageBufferExchangeState.fetch_sub(ImageBufferStateReaderCountIncrement, std::memory_order_acq_rel);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void S315_5313::PublishDrawingImageBufferPlane()
+{
+	// Swap the plane we just finished drawing into the ready slot, and take whatever
+	// plane was previously in the ready slot as our new drawing plane. Readers only ever
+	// hold the front plane, so the plane we receive here is never in use by a reader. If
+	// the previous ready frame was never picked up by a reader, it's simply dropped.
+	unsigned int currentState = _imageBufferExchangeState.load(std::memory_order_relaxed);
+	unsigned int newState;
+	do
+	{
+		newState = currentState & ~(ImageBufferStatePlaneMask << ImageBufferStateReadyPlaneShift);
+		newState |= (_drawingImageBufferPlane << ImageBufferStateReadyPlaneShift) | ImageBufferStateNewFrameFlag;
+	}
+	while (!_imageBufferExchangeState.compare_exchange_weak(currentState, newState, std::memory_order_acq_rel, std::memory_order_relaxed));
+	_drawingImageBufferPlane = (currentState >> ImageBufferStateReadyPlaneShift) & ImageBufferStatePlaneMask;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Rendering functions
 //----------------------------------------------------------------------------------------------------------------------
 void S315_5313::RenderThread()
 {
 	std::unique_lock<std::mutex> lock(_renderThreadMutex);
+	ITraceRecorder& traceRecorder = GetSystemInterface().GetTraceRecorder();
+	traceRecorder.SetCurrentThreadTraceName(L"VDPRender - " + GetDeviceInstanceName());
 
 	// Start the render loop
 	bool done = false;
@@ -229,6 +300,8 @@ void S315_5313::RenderThread()
 
 		if (!_videoDisableRenderOutput)
 		{
+			ITraceRecorder::Scope traceScope(traceRecorder, "RenderBatch");
+
 			//##DEBUG##
 			if (_outputTimingDebugMessages)
 			{
@@ -1132,18 +1205,24 @@ void S315_5313::UpdateAnalogRenderProcess(const AccessTarget& accessTarget, cons
 	}
 	else if ((_renderDigitalHCounterPos == hscanSettings.vcounterIncrementPoint) && (_renderDigitalVCounterPos == vscanSettings.vsyncClearedPoint))
 	{
-		// Calculate the image buffer plane to use for the next frame
-		unsigned int newDrawingImageBufferPlane = _videoSingleBuffering? _drawingImageBufferPlane: (_drawingImageBufferPlane + 1) % ImageBufferPlanes;
-
-		// Obtain a write lock on the new drawing image buffer plane
-		_imageBufferLock[newDrawingImageBufferPlane].ObtainWriteLock();
-
-		// Advance the drawing image buffer to the next plane
-		_drawingImageBufferPlane = newDrawingImageBufferPlane;
-
 		// Now that we've completed another frame, advance the last rendered frame token.
+		// Note that we do this before publishing the frame, so that any reader which picks
+		// up the new frame is guaranteed to also see the new token value.
 		++_lastRenderedFrameToken;
 
+		// Publish the image buffer plane we just finished drawing as the latest completed
+		// frame, and advance the drawing image buffer to a plane which no reader can be
+		// holding. If single buffering is active, we keep drawing into the same plane.
+		if (!_videoSingleBuffering)
+		{
+			PublishDrawingImageBufferPlane();
+		}
+		ITraceRecorder& traceRecorder = GetSystemInterface().GetTraceRecorder();
+		if (traceRecorder.TraceRecordingEnabled())
+		{
+			traceRecorder.RecordTraceEvent(ITraceRecorder::EventType::Instant, "FrameComplete");
+		}
+
 		// Record the odd interlace frame flag
 		_imageBufferLineCount[_drawingImageBufferPlane] = _renderDigitalOddFlagSet;
 
@@ -1157,9 +1236,6 @@ void S315_5313::UpdateAnalogRenderProcess(const AccessTarget& accessTarget, cons
 		// Clear the cache of sprite boundary lines in this frame
 		std::unique_lock<std::mutex> spriteLock(_spriteBoundaryMutex[_drawingImageBufferPlane]);
 		_imageBufferSpriteBoundaryLines[_drawingImageBufferPlane].clear();
-
-		// Release the write lock on the image buffer plane
-		_imageBufferLock[newDrawingImageBufferPlane].ReleaseWriteLock();
 	}
 
 	// Read the display enable register. If this register is cleared, the output for this
@@ -2131,27 +2207,19 @@ void S315_5313::DigitalRenderBuildSpriteCellList(const HScanSettings& hscanSetti
 //----------------------------------------------------------------------------------------------------------------------
 unsigned int S315_5313::DigitalRenderReadPixelIndex(const Data& patternRow, bool horizontalFlip, unsigned int pixelIndex) const
 {
-	static const unsigned int patternDataPixelEntryBitCount = 4;
-	if (!horizontalFlip)
-	{
-		// Pattern data row format (no horizontal flip):
-		// ---------------------------------------------------------------------------------------------------------------------------------
-		// |31 |30 |29 |28 |27 |26 |25 |24 |23 |22 |21 |20 |19 |18 |17 |16 |15 |14 |13 |12 |11 |10 | 9 | 8 | 7 | 6 | 5 | 4 | 3 | 2 | 1 | 0 |
-		// |-------------------------------------------------------------------------------------------------------------------------------|
-		// |    Pixel 1    |    Pixel 2    |    Pixel 3    |    Pixel 4    |    Pixel 5    |    Pixel 6    |    Pixel 7    |    Pixel 8    |
-		// ---------------------------------------------------------------------------------------------------------------------------------
-		return patternRow.GetDataSegment(((cellBlockSizeH - 1) - pixelIndex) * patternDataPixelEntryBitCount, 4);
-	}
-	else
-	{
-		// Pattern data row format (with horizontal flip):
-		// ---------------------------------------------------------------------------------------------------------------------------------
-		// |31 |30 |29 |28 |27 |26 |25 |24 |23 |22 |21 |20 |19 |18 |17 |16 |15 |14 |13 |12 |11 |10 | 9 | 8 | 7 | 6 | 5 | 4 | 3 | 2 | 1 | 0 |
-		// |-------------------------------------------------------------------------------------------------------------------------------|
-		// |    Pixel 8    |    Pixel 7    |    Pixel 6    |    Pixel 5    |    Pixel 4    |    Pixel 3    |    Pixel 2    |    Pixel 1    |
-		// ---------------------------------------------------------------------------------------------------------------------------------
-		return patternRow.GetDataSegment(pixelIndex * patternDataPixelEntryBitCount, 4);
-	}
+	// Pattern data row format (no horizontal flip):
+	// ---------------------------------------------------------------------------------------------------------------------------------
+	// |31 |30 |29 |28 |27 |26 |25 |24 |23 |22 |21 |20 |19 |18 |17 |16 |15 |14 |13 |12 |11 |10 | 9 | 8 | 7 | 6 | 5 | 4 | 3 | 2 | 1 | 0 |
+	// |-------------------------------------------------------------------------------------------------------------------------------|
+	// |    Pixel 1    |    Pixel 2    |    Pixel 3    |    Pixel 4    |    Pixel 5    |    Pixel 6    |    Pixel 7    |    Pixel 8    |
+	// ---------------------------------------------------------------------------------------------------------------------------------
+	// Pattern data row format (with horizontal flip):
+	// ---------------------------------------------------------------------------------------------------------------------------------
+	// |31 |30 |29 |28 |27 |26 |25 |24 |23 |22 |21 |20 |19 |18 |17 |16 |15 |14 |13 |12 |11 |10 | 9 | 8 | 7 | 6 | 5 | 4 | 3 | 2 | 1 | 0 |
+	// |-------------------------------------------------------------------------------------------------------------------------------|
+	// |    Pixel 8    |    Pixel 7    |    Pixel 6    |    Pixel 5    |    Pixel 4    |    Pixel 3    |    Pixel 2    |    Pixel 1    |
+	// ---------------------------------------------------------------------------------------------------------------------------------
+	return VDPDecoder::ReadPixelIndex(patternRow.GetData(), horizontalFlip, pixelIndex);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -2318,9 +2386,7 @@ unsigned int S315_5313::CalculatePatternDataRowNumber(unsigned int patternRowNum
 	// PalRow: The palette row number to use when displaying the pattern data
 	// VF:     Vertical Flip
 	// HF:     Horizontal Flip
-	const unsigned int rowsPerTile = (!interlaceMode2Active)? 8: 16;
-	unsigned int patternRowNumber = mappingData.GetBit(12)? (rowsPerTile - 1) - patternRowNumberNoFlip: patternRowNumberNoFlip;
-	return patternRowNumber;
+	return VDPDecoder::CalculatePatternRowNumber(patternRowNumberNoFlip, interlaceMode2Active, mappingData.GetData());
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -2348,11 +2414,7 @@ unsigned int S315_5313::CalculatePatternDataRowAddress(unsigned int patternRowNu
 	// mapping data are effective when determining the block number, or the lower 10 bits
 	// in the case of interlace mode 2.
 	//##TODO## Test the above assertion on the TeraDrive with the larger VRAM mode active
-	static const unsigned int patternDataRowByteSize = 4;
-	const unsigned int rowsPerTile = (!interlaceMode2Active)? 8: 16;
-	const unsigned int blockPatternByteSize = rowsPerTile * patternDataRowByteSize;
-	unsigned int patternDataAddress = (((mappingData.GetData() + patternCellOffset) * blockPatternByteSize) + (patternRowNumber * patternDataRowByteSize)) % VramSize;
-	return patternDataAddress;
+	return VDPDecoder::CalculatePatternRowAddress(patternRowNumber, patternCellOffset, interlaceMode2Active, mappingData.GetData());
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -2468,16 +2530,17 @@ S315_5313::SpriteMappingTableEntry S315_5313::GetSpriteMappingTableEntry(unsigne
 	// Word3  |---------------------------------------------------------------|
 	//        |                         Horizontal Pos                        |
 	//        -----------------------------------------------------------------
-	entry.ypos = entry.rawDataWord0.GetData();
-	entry.width = entry.rawDataWord1.GetDataSegment(10, 2);
-	entry.height = entry.rawDataWord1.GetDataSegment(8, 2);
-	entry.link = entry.rawDataWord1.GetDataSegment(0, 7);
-	entry.priority = entry.rawDataWord2.GetBit(15);
-	entry.paletteLine = entry.rawDataWord2.GetDataSegment(13, 2);
-	entry.vflip = entry.rawDataWord2.GetBit(12);
-	entry.hflip = entry.rawDataWord2.GetBit(11);
-	entry.blockNumber = entry.rawDataWord2.GetDataSegment(0, 11);
-	entry.xpos = entry.rawDataWord3.GetData();
+	VDPDecoder::SpriteTableEntry decodedEntry = VDPDecoder::DecodeSpriteTableEntry(entry.rawDataWord0.GetData(), entry.rawDataWord1.GetData(), entry.rawDataWord2.GetData(), entry.rawDataWord3.GetData());
+	entry.ypos = decodedEntry.ypos;
+	entry.width = decodedEntry.width;
+	entry.height = decodedEntry.height;
+	entry.link = decodedEntry.link;
+	entry.priority = decodedEntry.priority;
+	entry.paletteLine = decodedEntry.paletteLine;
+	entry.vflip = decodedEntry.vflip;
+	entry.hflip = decodedEntry.hflip;
+	entry.blockNumber = decodedEntry.blockNumber;
+	entry.xpos = decodedEntry.xpos;
 
 	return entry;
 }
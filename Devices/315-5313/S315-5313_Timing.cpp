@@ -673,6 +673,228 @@ const S315_5313::InternalRenderOp S315_5313::InternalOperationsH40[420] = {
 	{S315_5313::InternalRenderOp::NONE, 0},               {S315_5313::InternalRenderOp::NONE, 0},         {S315_5313::InternalRenderOp::NONE, 0},         {S315_5313::InternalRenderOp::NONE, 0},         // 0x1FC-0x1FF
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+// Access slot tables
+//----------------------------------------------------------------------------------------------------------------------
+// The following tables map each internal hcounter value to the hcounter value of the next
+// available access slot for external VRAM access. These tables are generated from the
+// access slot and refresh slot positions listed with each table. Note that hardware tests
+// have shown that there are in fact 5 refresh slots in H32 mode in non-active lines, and
+// 6 refresh slots in H40 mode in non-active lines. This is one more than there is during
+// an active line.
+
+//----------------------------------------------------------------------------------------------------------------------
+// External access slots on an active line (H32):
+// ---------------
+// |Slot|HCounter|
+// |-------------|
+// |  1 |  0x005 |
+// |  2 |  0x015 |
+// |  3 |  0x025 |
+// |  4 |  0x045 |
+// |  5 |  0x055 |
+// |  6 |  0x065 |
+// |  7 |  0x085 |
+// |  8 |  0x095 |
+// |  9 |  0x0A5 |
+// | 10 |  0x0C5 |
+// | 11 |  0x0D5 |
+// | 12 |  0x0E5 |
+// | 13 |  0x103 |
+// | 14 |  0x105 | // Vcounter increments at 0x10A
+// | 15 |  0x121 | // Next line
+// | 16 |  0x1E7 | // Next line
+// ---------------
+const unsigned short S315_5313::AccessSlotNextHCounterH32ActiveLine[0x200] = {
+	0x005, 0x005, 0x005, 0x005, 0x005, 0x015, 0x015, 0x015, 0x015, 0x015, 0x015, 0x015, 0x015, 0x015, 0x015, 0x015, // 0x000-0x00F
+	0x015, 0x015, 0x015, 0x015, 0x015, 0x025, 0x025, 0x025, 0x025, 0x025, 0x025, 0x025, 0x025, 0x025, 0x025, 0x025, // 0x010-0x01F
+	0x025, 0x025, 0x025, 0x025, 0x025, 0x045, 0x045, 0x045, 0x045, 0x045, 0x045, 0x045, 0x045, 0x045, 0x045, 0x045, // 0x020-0x02F
+	0x045, 0x045, 0x045, 0x045, 0x045, 0x045, 0x045, 0x045, 0x045, 0x045, 0x045, 0x045, 0x045, 0x045, 0x045, 0x045, // 0x030-0x03F
+	0x045, 0x045, 0x045, 0x045, 0x045, 0x055, 0x055, 0x055, 0x055, 0x055, 0x055, 0x055, 0x055, 0x055, 0x055, 0x055, // 0x040-0x04F
+	0x055, 0x055, 0x055, 0x055, 0x055, 0x065, 0x065, 0x065, 0x065, 0x065, 0x065, 0x065, 0x065, 0x065, 0x065, 0x065, // 0x050-0x05F
+	0x065, 0x065, 0x065, 0x065, 0x065, 0x085, 0x085, 0x085, 0x085, 0x085, 0x085, 0x085, 0x085, 0x085, 0x085, 0x085, // 0x060-0x06F
+	0x085, 0x085, 0x085, 0x085, 0x085, 0x085, 0x085, 0x085, 0x085, 0x085, 0x085, 0x085, 0x085, 0x085, 0x085, 0x085, // 0x070-0x07F
+	0x085, 0x085, 0x085, 0x085, 0x085, 0x095, 0x095, 0x095, 0x095, 0x095, 0x095, 0x095, 0x095, 0x095, 0x095, 0x095, // 0x080-0x08F
+	0x095, 0x095, 0x095, 0x095, 0x095, 0x0A5, 0x0A5, 0x0A5, 0x0A5, 0x0A5, 0x0A5, 0x0A5, 0x0A5, 0x0A5, 0x0A5, 0x0A5, // 0x090-0x09F
+	0x0A5, 0x0A5, 0x0A5, 0x0A5, 0x0A5, 0x0C5, 0x0C5, 0x0C5, 0x0C5, 0x0C5, 0x0C5, 0x0C5, 0x0C5, 0x0C5, 0x0C5, 0x0C5, // 0x0A0-0x0AF
+	0x0C5, 0x0C5, 0x0C5, 0x0C5, 0x0C5, 0x0C5, 0x0C5, 0x0C5, 0x0C5, 0x0C5, 0x0C5, 0x0C5, 0x0C5, 0x0C5, 0x0C5, 0x0C5, // 0x0B0-0x0BF
+	0x0C5, 0x0C5, 0x0C5, 0x0C5, 0x0C5, 0x0D5, 0x0D5, 0x0D5, 0x0D5, 0x0D5, 0x0D5, 0x0D5, 0x0D5, 0x0D5, 0x0D5, 0x0D5, // 0x0C0-0x0CF
+	0x0D5, 0x0D5, 0x0D5, 0x0D5, 0x0D5, 0x0E5, 0x0E5, 0x0E5, 0x0E5, 0x0E5, 0x0E5, 0x0E5, 0x0E5, 0x0E5, 0x0E5, 0x0E5, // 0x0D0-0x0DF
+	0x0E5, 0x0E5, 0x0E5, 0x0E5, 0x0E5, 0x103, 0x103, 0x103, 0x103, 0x103, 0x103, 0x103, 0x103, 0x103, 0x103, 0x103, // 0x0E0-0x0EF
+	0x103, 0x103, 0x103, 0x103, 0x103, 0x103, 0x103, 0x103, 0x103, 0x103, 0x103, 0x103, 0x103, 0x103, 0x103, 0x103, // 0x0F0-0x0FF
+	0x103, 0x103, 0x103, 0x105, 0x105, 0x121, 0x121, 0x121, 0x121, 0x121, 0x121, 0x121, 0x121, 0x121, 0x121, 0x121, // 0x100-0x10F
+	0x121, 0x121, 0x121, 0x121, 0x121, 0x121, 0x121, 0x121, 0x121, 0x121, 0x121, 0x121, 0x121, 0x121, 0x121, 0x121, // 0x110-0x11F
+	0x121, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, // 0x120-0x12F
+	0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, // 0x130-0x13F
+	0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, // 0x140-0x14F
+	0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, // 0x150-0x15F
+	0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, // 0x160-0x16F
+	0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, // 0x170-0x17F
+	0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, // 0x180-0x18F
+	0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, // 0x190-0x19F
+	0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, // 0x1A0-0x1AF
+	0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, // 0x1B0-0x1BF
+	0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, // 0x1C0-0x1CF
+	0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, // 0x1D0-0x1DF
+	0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x1E7, 0x005, 0x005, 0x005, 0x005, 0x005, 0x005, 0x005, 0x005, 0x005, // 0x1E0-0x1EF
+	0x005, 0x005, 0x005, 0x005, 0x005, 0x005, 0x005, 0x005, 0x005, 0x005, 0x005, 0x005, 0x005, 0x005, 0x005, 0x005, // 0x1F0-0x1FF
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Access slots on a non-active line (H32). Every odd hcounter value is an access slot,
+// except where one of the following refresh cycle slots occurs:
+// ---------------
+// |Slot|HCounter|
+// |-------------|
+// |  1 |  0x035 |
+// |  2 |  0x075 |
+// |  3 |  0x0B5 |
+// |  4 |  0x0F5 |
+// |  5 |  0x1F5 |
+// ---------------
+const unsigned short S315_5313::AccessSlotNextHCounterH32InactiveLine[0x200] = {
+	0x001, 0x003, 0x003, 0x005, 0x005, 0x007, 0x007, 0x009, 0x009, 0x00B, 0x00B, 0x00D, 0x00D, 0x00F, 0x00F, 0x011, // 0x000-0x00F
+	0x011, 0x013, 0x013, 0x015, 0x015, 0x017, 0x017, 0x019, 0x019, 0x01B, 0x01B, 0x01D, 0x01D, 0x01F, 0x01F, 0x021, // 0x010-0x01F
+	0x021, 0x023, 0x023, 0x025, 0x025, 0x027, 0x027, 0x029, 0x029, 0x02B, 0x02B, 0x02D, 0x02D, 0x02F, 0x02F, 0x031, // 0x020-0x02F
+	0x031, 0x033, 0x033, 0x035, 0x035, 0x03B, 0x03B, 0x03B, 0x03B, 0x03B, 0x03B, 0x03D, 0x03D, 0x03F, 0x03F, 0x041, // 0x030-0x03F
+	0x041, 0x043, 0x043, 0x045, 0x045, 0x047, 0x047, 0x049, 0x049, 0x04B, 0x04B, 0x04D, 0x04D, 0x04F, 0x04F, 0x051, // 0x040-0x04F
+	0x051, 0x053, 0x053, 0x055, 0x055, 0x057, 0x057, 0x059, 0x059, 0x05B, 0x05B, 0x05D, 0x05D, 0x05F, 0x05F, 0x061, // 0x050-0x05F
+	0x061, 0x063, 0x063, 0x065, 0x065, 0x067, 0x067, 0x069, 0x069, 0x06B, 0x06B, 0x06D, 0x06D, 0x06F, 0x06F, 0x071, // 0x060-0x06F
+	0x071, 0x073, 0x073, 0x075, 0x075, 0x07B, 0x07B, 0x07B, 0x07B, 0x07B, 0x07B, 0x07D, 0x07D, 0x07F, 0x07F, 0x081, // 0x070-0x07F
+	0x081, 0x083, 0x083, 0x085, 0x085, 0x087, 0x087, 0x089, 0x089, 0x08B, 0x08B, 0x08D, 0x08D, 0x08F, 0x08F, 0x091, // 0x080-0x08F
+	0x091, 0x093, 0x093, 0x095, 0x095, 0x097, 0x097, 0x099, 0x099, 0x09B, 0x09B, 0x09D, 0x09D, 0x09F, 0x09F, 0x0A1, // 0x090-0x09F
+	0x0A1, 0x0A3, 0x0A3, 0x0A5, 0x0A5, 0x0A7, 0x0A7, 0x0A9, 0x0A9, 0x0AB, 0x0AB, 0x0AD, 0x0AD, 0x0AF, 0x0AF, 0x0B1, // 0x0A0-0x0AF
+	0x0B1, 0x0B3, 0x0B3, 0x0B5, 0x0B5, 0x0BB, 0x0BB, 0x0BB, 0x0BB, 0x0BB, 0x0BB, 0x0BD, 0x0BD, 0x0BF, 0x0BF, 0x0C1, // 0x0B0-0x0BF
+	0x0C1, 0x0C3, 0x0C3, 0x0C5, 0x0C5, 0x0C7, 0x0C7, 0x0C9, 0x0C9, 0x0CB, 0x0CB, 0x0CD, 0x0CD, 0x0CF, 0x0CF, 0x0D1, // 0x0C0-0x0CF
+	0x0D1, 0x0D3, 0x0D3, 0x0D5, 0x0D5, 0x0D7, 0x0D7, 0x0D9, 0x0D9, 0x0DB, 0x0DB, 0x0DD, 0x0DD, 0x0DF, 0x0DF, 0x0E1, // 0x0D0-0x0DF
+	0x0E1, 0x0E3, 0x0E3, 0x0E5, 0x0E5, 0x0E7, 0x0E7, 0x0E9, 0x0E9, 0x0EB, 0x0EB, 0x0ED, 0x0ED, 0x0EF, 0x0EF, 0x0F1, // 0x0E0-0x0EF
+	0x0F1, 0x0F3, 0x0F3, 0x0F5, 0x0F5, 0x0FB, 0x0FB, 0x0FB, 0x0FB, 0x0FB, 0x0FB, 0x0FD, 0x0FD, 0x0FF, 0x0FF, 0x101, // 0x0F0-0x0FF
+	0x101, 0x103, 0x103, 0x105, 0x105, 0x107, 0x107, 0x109, 0x109, 0x10B, 0x10B, 0x10D, 0x10D, 0x10F, 0x10F, 0x111, // 0x100-0x10F
+	0x111, 0x113, 0x113, 0x115, 0x115, 0x117, 0x117, 0x119, 0x119, 0x11B, 0x11B, 0x11D, 0x11D, 0x11F, 0x11F, 0x121, // 0x110-0x11F
+	0x121, 0x123, 0x123, 0x125, 0x125, 0x127, 0x127, 0x1D3, 0x1D3, 0x1D5, 0x1D5, 0x1D7, 0x1D7, 0x1D9, 0x1D9, 0x1DB, // 0x120-0x12F
+	0x1DB, 0x1DD, 0x1DD, 0x1DF, 0x1DF, 0x1E1, 0x1E1, 0x1E3, 0x1E3, 0x1E5, 0x1E5, 0x1E7, 0x1E7, 0x1E9, 0x1E9, 0x1EB, // 0x130-0x13F
+	0x1EB, 0x1ED, 0x1ED, 0x1EF, 0x1EF, 0x1F1, 0x1F1, 0x1F3, 0x1F3, 0x1F5, 0x1F5, 0x1F7, 0x1F7, 0x1F9, 0x1F9, 0x1FB, // 0x140-0x14F
+	0x1FB, 0x1FD, 0x1FD, 0x1FF, 0x1FF, 0x001, 0x001, 0x003, 0x003, 0x005, 0x005, 0x007, 0x007, 0x009, 0x009, 0x00B, // 0x150-0x15F
+	0x00B, 0x00D, 0x00D, 0x00F, 0x00F, 0x011, 0x011, 0x013, 0x013, 0x015, 0x015, 0x017, 0x017, 0x019, 0x019, 0x01B, // 0x160-0x16F
+	0x01B, 0x01D, 0x01D, 0x01F, 0x01F, 0x021, 0x021, 0x023, 0x023, 0x025, 0x025, 0x027, 0x027, 0x029, 0x029, 0x02B, // 0x170-0x17F
+	0x02B, 0x02D, 0x02D, 0x02F, 0x02F, 0x031, 0x031, 0x033, 0x033, 0x035, 0x035, 0x037, 0x037, 0x039, 0x039, 0x03B, // 0x180-0x18F
+	0x03B, 0x03D, 0x03D, 0x03F, 0x03F, 0x041, 0x041, 0x043, 0x043, 0x045, 0x045, 0x047, 0x047, 0x049, 0x049, 0x04B, // 0x190-0x19F
+	0x04B, 0x04D, 0x04D, 0x04F, 0x04F, 0x051, 0x051, 0x053, 0x053, 0x055, 0x055, 0x057, 0x057, 0x059, 0x059, 0x05B, // 0x1A0-0x1AF
+	0x05B, 0x05D, 0x05D, 0x05F, 0x05F, 0x061, 0x061, 0x063, 0x063, 0x065, 0x065, 0x067, 0x067, 0x069, 0x069, 0x06B, // 0x1B0-0x1BF
+	0x06B, 0x06D, 0x06D, 0x06F, 0x06F, 0x071, 0x071, 0x073, 0x073, 0x075, 0x075, 0x077, 0x077, 0x079, 0x079, 0x07B, // 0x1C0-0x1CF
+	0x07B, 0x07D, 0x1D3, 0x1D5, 0x1D5, 0x1D7, 0x1D7, 0x1D9, 0x1D9, 0x1DB, 0x1DB, 0x1DD, 0x1DD, 0x1DF, 0x1DF, 0x1E1, // 0x1D0-0x1DF
+	0x1E1, 0x1E3, 0x1E3, 0x1E5, 0x1E5, 0x1E7, 0x1E7, 0x1E9, 0x1E9, 0x1EB, 0x1EB, 0x1ED, 0x1ED, 0x1EF, 0x1EF, 0x1F1, // 0x1E0-0x1EF
+	0x1F1, 0x1F3, 0x1F3, 0x1F5, 0x1F5, 0x1FB, 0x1FB, 0x1FB, 0x1FB, 0x1FB, 0x1FB, 0x1FD, 0x1FD, 0x1FF, 0x1FF, 0x001, // 0x1F0-0x1FF
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// External access slots on an active line (H40):
+// ---------------
+// |Slot|HCounter|
+// |-------------|
+// |  1 |  0x002 |
+// |  2 |  0x012 |
+// |  3 |  0x022 |
+// |  4 |  0x042 |
+// |  5 |  0x052 |
+// |  6 |  0x062 |
+// |  7 |  0x082 |
+// |  8 |  0x092 |
+// |  9 |  0x0A2 |
+// | 10 |  0x0C2 |
+// | 11 |  0x0D2 |
+// | 12 |  0x0E2 |
+// | 13 |  0x102 |
+// | 14 |  0x112 |
+// | 15 |  0x122 |
+// | 16 |  0x140 |
+// | 17 |  0x142 | // Vcounter increments at 0x14A
+// | 18 |  0x1CE | // Next line
+// ---------------
+const unsigned short S315_5313::AccessSlotNextHCounterH40ActiveLine[0x200] = {
+	0x002, 0x002, 0x012, 0x012, 0x012, 0x012, 0x012, 0x012, 0x012, 0x012, 0x012, 0x012, 0x012, 0x012, 0x012, 0x012, // 0x000-0x00F
+	0x012, 0x012, 0x022, 0x022, 0x022, 0x022, 0x022, 0x022, 0x022, 0x022, 0x022, 0x022, 0x022, 0x022, 0x022, 0x022, // 0x010-0x01F
+	0x022, 0x022, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, // 0x020-0x02F
+	0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, // 0x030-0x03F
+	0x042, 0x042, 0x052, 0x052, 0x052, 0x052, 0x052, 0x052, 0x052, 0x052, 0x052, 0x052, 0x052, 0x052, 0x052, 0x052, // 0x040-0x04F
+	0x052, 0x052, 0x062, 0x062, 0x062, 0x062, 0x062, 0x062, 0x062, 0x062, 0x062, 0x062, 0x062, 0x062, 0x062, 0x062, // 0x050-0x05F
+	0x062, 0x062, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, // 0x060-0x06F
+	0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, // 0x070-0x07F
+	0x082, 0x082, 0x092, 0x092, 0x092, 0x092, 0x092, 0x092, 0x092, 0x092, 0x092, 0x092, 0x092, 0x092, 0x092, 0x092, // 0x080-0x08F
+	0x092, 0x092, 0x0A2, 0x0A2, 0x0A2, 0x0A2, 0x0A2, 0x0A2, 0x0A2, 0x0A2, 0x0A2, 0x0A2, 0x0A2, 0x0A2, 0x0A2, 0x0A2, // 0x090-0x09F
+	0x0A2, 0x0A2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, // 0x0A0-0x0AF
+	0x0C2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, 0x0C2, // 0x0B0-0x0BF
+	0x0C2, 0x0C2, 0x0D2, 0x0D2, 0x0D2, 0x0D2, 0x0D2, 0x0D2, 0x0D2, 0x0D2, 0x0D2, 0x0D2, 0x0D2, 0x0D2, 0x0D2, 0x0D2, // 0x0C0-0x0CF
+	0x0D2, 0x0D2, 0x0E2, 0x0E2, 0x0E2, 0x0E2, 0x0E2, 0x0E2, 0x0E2, 0x0E2, 0x0E2, 0x0E2, 0x0E2, 0x0E2, 0x0E2, 0x0E2, // 0x0D0-0x0DF
+	0x0E2, 0x0E2, 0x102, 0x102, 0x102, 0x102, 0x102, 0x102, 0x102, 0x102, 0x102, 0x102, 0x102, 0x102, 0x102, 0x102, // 0x0E0-0x0EF
+	0x102, 0x102, 0x102, 0x102, 0x102, 0x102, 0x102, 0x102, 0x102, 0x102, 0x102, 0x102, 0x102, 0x102, 0x102, 0x102, // 0x0F0-0x0FF
+	0x102, 0x102, 0x112, 0x112, 0x112, 0x112, 0x112, 0x112, 0x112, 0x112, 0x112, 0x112, 0x112, 0x112, 0x112, 0x112, // 0x100-0x10F
+	0x112, 0x112, 0x122, 0x122, 0x122, 0x122, 0x122, 0x122, 0x122, 0x122, 0x122, 0x122, 0x122, 0x122, 0x122, 0x122, // 0x110-0x11F
+	0x122, 0x122, 0x140, 0x140, 0x140, 0x140, 0x140, 0x140, 0x140, 0x140, 0x140, 0x140, 0x140, 0x140, 0x140, 0x140, // 0x120-0x12F
+	0x140, 0x140, 0x140, 0x140, 0x140, 0x140, 0x140, 0x140, 0x140, 0x140, 0x140, 0x140, 0x140, 0x140, 0x140, 0x140, // 0x130-0x13F
+	0x142, 0x142, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, // 0x140-0x14F
+	0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, // 0x150-0x15F
+	0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, // 0x160-0x16F
+	0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, // 0x170-0x17F
+	0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, // 0x180-0x18F
+	0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, // 0x190-0x19F
+	0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, // 0x1A0-0x1AF
+	0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, // 0x1B0-0x1BF
+	0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x1CE, 0x002, 0x002, // 0x1C0-0x1CF
+	0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, // 0x1D0-0x1DF
+	0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, // 0x1E0-0x1EF
+	0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, // 0x1F0-0x1FF
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Access slots on a non-active line (H40). Every even hcounter value is an access slot,
+// except where one of the following refresh cycle slots occurs:
+// ---------------
+// |Slot|HCounter|
+// |-------------|
+// |  1 |  0x032 |
+// |  2 |  0x072 |
+// |  3 |  0x0B2 |
+// |  4 |  0x0F2 |
+// |  5 |  0x132 |
+// |  6 |  0x1F2 |
+// ---------------
+const unsigned short S315_5313::AccessSlotNextHCounterH40InactiveLine[0x200] = {
+	0x002, 0x002, 0x004, 0x004, 0x006, 0x006, 0x008, 0x008, 0x00A, 0x00A, 0x00C, 0x00C, 0x00E, 0x00E, 0x010, 0x010, // 0x000-0x00F
+	0x012, 0x012, 0x014, 0x014, 0x016, 0x016, 0x018, 0x018, 0x01A, 0x01A, 0x01C, 0x01C, 0x01E, 0x01E, 0x020, 0x020, // 0x010-0x01F
+	0x022, 0x022, 0x024, 0x024, 0x026, 0x026, 0x028, 0x028, 0x02A, 0x02A, 0x02C, 0x02C, 0x02E, 0x02E, 0x030, 0x030, // 0x020-0x02F
+	0x036, 0x036, 0x036, 0x036, 0x036, 0x036, 0x038, 0x038, 0x03A, 0x03A, 0x03C, 0x03C, 0x03E, 0x03E, 0x040, 0x040, // 0x030-0x03F
+	0x042, 0x042, 0x044, 0x044, 0x046, 0x046, 0x048, 0x048, 0x04A, 0x04A, 0x04C, 0x04C, 0x04E, 0x04E, 0x050, 0x050, // 0x040-0x04F
+	0x052, 0x052, 0x054, 0x054, 0x056, 0x056, 0x058, 0x058, 0x05A, 0x05A, 0x05C, 0x05C, 0x05E, 0x05E, 0x060, 0x060, // 0x050-0x05F
+	0x062, 0x062, 0x064, 0x064, 0x066, 0x066, 0x068, 0x068, 0x06A, 0x06A, 0x06C, 0x06C, 0x06E, 0x06E, 0x070, 0x070, // 0x060-0x06F
+	0x076, 0x076, 0x076, 0x076, 0x076, 0x076, 0x078, 0x078, 0x07A, 0x07A, 0x07C, 0x07C, 0x07E, 0x07E, 0x080, 0x080, // 0x070-0x07F
+	0x082, 0x082, 0x084, 0x084, 0x086, 0x086, 0x088, 0x088, 0x08A, 0x08A, 0x08C, 0x08C, 0x08E, 0x08E, 0x090, 0x090, // 0x080-0x08F
+	0x092, 0x092, 0x094, 0x094, 0x096, 0x096, 0x098, 0x098, 0x09A, 0x09A, 0x09C, 0x09C, 0x09E, 0x09E, 0x0A0, 0x0A0, // 0x090-0x09F
+	0x0A2, 0x0A2, 0x0A4, 0x0A4, 0x0A6, 0x0A6, 0x0A8, 0x0A8, 0x0AA, 0x0AA, 0x0AC, 0x0AC, 0x0AE, 0x0AE, 0x0B0, 0x0B0, // 0x0A0-0x0AF
+	0x0B6, 0x0B6, 0x0B6, 0x0B6, 0x0B6, 0x0B6, 0x0B8, 0x0B8, 0x0BA, 0x0BA, 0x0BC, 0x0BC, 0x0BE, 0x0BE, 0x0C0, 0x0C0, // 0x0B0-0x0BF
+	0x0C2, 0x0C2, 0x0C4, 0x0C4, 0x0C6, 0x0C6, 0x0C8, 0x0C8, 0x0CA, 0x0CA, 0x0CC, 0x0CC, 0x0CE, 0x0CE, 0x0D0, 0x0D0, // 0x0C0-0x0CF
+	0x0D2, 0x0D2, 0x0D4, 0x0D4, 0x0D6, 0x0D6, 0x0D8, 0x0D8, 0x0DA, 0x0DA, 0x0DC, 0x0DC, 0x0DE, 0x0DE, 0x0E0, 0x0E0, // 0x0D0-0x0DF
+	0x0E2, 0x0E2, 0x0E4, 0x0E4, 0x0E6, 0x0E6, 0x0E8, 0x0E8, 0x0EA, 0x0EA, 0x0EC, 0x0EC, 0x0EE, 0x0EE, 0x0F0, 0x0F0, // 0x0E0-0x0EF
+	0x0F6, 0x0F6, 0x0F6, 0x0F6, 0x0F6, 0x0F6, 0x0F8, 0x0F8, 0x0FA, 0x0FA, 0x0FC, 0x0FC, 0x0FE, 0x0FE, 0x100, 0x100, // 0x0F0-0x0FF
+	0x102, 0x102, 0x104, 0x104, 0x106, 0x106, 0x108, 0x108, 0x10A, 0x10A, 0x10C, 0x10C, 0x10E, 0x10E, 0x110, 0x110, // 0x100-0x10F
+	0x112, 0x112, 0x114, 0x114, 0x116, 0x116, 0x118, 0x118, 0x11A, 0x11A, 0x11C, 0x11C, 0x11E, 0x11E, 0x120, 0x120, // 0x110-0x11F
+	0x122, 0x122, 0x124, 0x124, 0x126, 0x126, 0x128, 0x128, 0x12A, 0x12A, 0x12C, 0x12C, 0x12E, 0x12E, 0x130, 0x130, // 0x120-0x12F
+	0x136, 0x136, 0x136, 0x136, 0x136, 0x136, 0x138, 0x138, 0x13A, 0x13A, 0x13C, 0x13C, 0x13E, 0x13E, 0x140, 0x140, // 0x130-0x13F
+	0x142, 0x142, 0x144, 0x144, 0x146, 0x146, 0x148, 0x148, 0x14A, 0x14A, 0x14C, 0x14C, 0x14E, 0x14E, 0x150, 0x150, // 0x140-0x14F
+	0x152, 0x152, 0x154, 0x154, 0x156, 0x156, 0x158, 0x158, 0x15A, 0x15A, 0x15C, 0x15C, 0x15E, 0x15E, 0x160, 0x160, // 0x150-0x15F
+	0x162, 0x162, 0x164, 0x164, 0x166, 0x166, 0x168, 0x168, 0x16A, 0x16A, 0x16C, 0x16C, 0x1CA, 0x1CA, 0x1CC, 0x1CC, // 0x160-0x16F
+	0x1CE, 0x1CE, 0x1D0, 0x1D0, 0x1D2, 0x1D2, 0x1D4, 0x1D4, 0x1D6, 0x1D6, 0x1D8, 0x1D8, 0x1DA, 0x1DA, 0x1DC, 0x1DC, // 0x170-0x17F
+	0x1DE, 0x1DE, 0x1E0, 0x1E0, 0x1E2, 0x1E2, 0x1E4, 0x1E4, 0x1E6, 0x1E6, 0x1E8, 0x1E8, 0x1EA, 0x1EA, 0x1EC, 0x1EC, // 0x180-0x18F
+	0x1EE, 0x1EE, 0x1F0, 0x1F0, 0x1F2, 0x1F2, 0x1F4, 0x1F4, 0x1F6, 0x1F6, 0x1F8, 0x1F8, 0x1FA, 0x1FA, 0x1FC, 0x1FC, // 0x190-0x19F
+	0x1FE, 0x1FE, 0x000, 0x000, 0x002, 0x002, 0x004, 0x004, 0x006, 0x006, 0x008, 0x008, 0x00A, 0x00A, 0x00C, 0x00C, // 0x1A0-0x1AF
+	0x00E, 0x00E, 0x010, 0x010, 0x012, 0x012, 0x014, 0x014, 0x016, 0x016, 0x018, 0x018, 0x01A, 0x01A, 0x01C, 0x01C, // 0x1B0-0x1BF
+	0x01E, 0x01E, 0x020, 0x020, 0x022, 0x022, 0x024, 0x024, 0x026, 0x1CA, 0x1CC, 0x1CC, 0x1CE, 0x1CE, 0x1D0, 0x1D0, // 0x1C0-0x1CF
+	0x1D2, 0x1D2, 0x1D4, 0x1D4, 0x1D6, 0x1D6, 0x1D8, 0x1D8, 0x1DA, 0x1DA, 0x1DC, 0x1DC, 0x1DE, 0x1DE, 0x1E0, 0x1E0, // 0x1D0-0x1DF
+	0x1E2, 0x1E2, 0x1E4, 0x1E4, 0x1E6, 0x1E6, 0x1E8, 0x1E8, 0x1EA, 0x1EA, 0x1EC, 0x1EC, 0x1EE, 0x1EE, 0x1F0, 0x1F0, // 0x1E0-0x1EF
+	0x1F6, 0x1F6, 0x1F6, 0x1F6, 0x1F6, 0x1F6, 0x1F8, 0x1F8, 0x1FA, 0x1FA, 0x1FC, 0x1FC, 0x1FE, 0x1FE, 0x000, 0x000, // 0x1F0-0x1FF
+};
+
+
 //----------------------------------------------------------------------------------------------------------------------
 // HV counter internal/linear conversion
 //----------------------------------------------------------------------------------------------------------------------
@@ -1444,194 +1666,46 @@ unsigned int S315_5313::GetPixelClockTicksUntilNextAccessSlot(const HScanSetting
 
 	// Determine when the next access slot will occur, based on the hcounter position and
 	// the current screen mode settings. Note that we can safely assume the horizontal
-	// screen mode doesn't change when making these calculations. Also note that hardware
-	// tests have shown that there are in fact 5 refresh slots in H32 mode in non-active
-	// lines, and 6 refresh slots in H40 mode in non-active lines. This is one more than
-	// there is during an active line.
-	//##TODO## Consider using table lookups here to eliminate branching.
-	unsigned int nextAccessSlotHCounter = 0;
+	// screen mode doesn't change when making these calculations. The next access slot for
+	// each hcounter position is precomputed in a lookup table for each screen mode, for
+	// both active and non-active lines. Refer to the definitions of these tables for the
+	// list of access slots in each case. We only need to make adjustments here for the
+	// cases where the line type is about to change on the next vcounter increment.
+	unsigned int nextAccessSlotHCounter;
 	if (!currentLineActiveDisplayRegion || !displayEnabled)
 	{
-		if (!screenModeRS1Current)
-		{
-			// Refresh cycle slots (H32):
-			// ---------------
-			// |Slot|HCounter|
-			// |-------------|
-			// |  1 |  0x035 |
-			// |  2 |  0x075 |
-			// |  3 |  0x0B5 |
-			// |  4 |  0x0F5 |
-			// |  5 |  0x1F5 |
-			// ---------------
-			if     ((hcounterCurrent >= 0x035) && (hcounterCurrent <= 0x03A)) {nextAccessSlotHCounter = 0x03B;}
-			else if ((hcounterCurrent >= 0x075) && (hcounterCurrent <= 0x07A)) {nextAccessSlotHCounter = 0x07B;}
-			else if ((hcounterCurrent >= 0x0B5) && (hcounterCurrent <= 0x0BA)) {nextAccessSlotHCounter = 0x0BB;}
-			else if ((hcounterCurrent >= 0x0F5) && (hcounterCurrent <= 0x0FA)) {nextAccessSlotHCounter = 0x0FB;}
-			else if ((hcounterCurrent >= 0x1F5) && (hcounterCurrent <= 0x1FA)) {nextAccessSlotHCounter = 0x1FB;}
-			else
-			{
-				// If none of the above cases apply, our next access slot is on the next
-				// odd hcounter value.
-				unsigned int hcounterStepsToAdd = ((hcounterCurrent % 2) == 0)? 1: 2;
-				nextAccessSlotHCounter = AddStepsToHCounter(hscanSettings, hcounterCurrent, hcounterStepsToAdd);
-
-				// If we're at the end of a non-display line, and the vcounter is going to
-				// be incremented before the next access slot and bring us into an active
-				// display line, set the next access slot based on the first allowed access
-				// slot after vcounter increment in an active display line for this screen
-				// mode.
-				if (displayEnabled && nextLineActiveDisplayRegion && ((hcounterCurrent < hscanSettings.vcounterIncrementPoint) && (nextAccessSlotHCounter >= hscanSettings.vcounterIncrementPoint)))
-				{
-					nextAccessSlotHCounter = 0x121;
-				}
-			}
-		}
-		else
+		nextAccessSlotHCounter = (!screenModeRS1Current)? AccessSlotNextHCounterH32InactiveLine[hcounterCurrent & 0x1FF]: AccessSlotNextHCounterH40InactiveLine[hcounterCurrent & 0x1FF];
+
+		// If we're at the end of a non-display line, and the vcounter is going to be
+		// incremented before the next access slot and bring us into an active display line,
+		// set the next access slot based on the first allowed access slot after vcounter
+		// increment in an active display line for this screen mode.
+		if (displayEnabled && nextLineActiveDisplayRegion && ((hcounterCurrent < hscanSettings.vcounterIncrementPoint) && (nextAccessSlotHCounter >= hscanSettings.vcounterIncrementPoint)))
 		{
-			// Refresh cycle slots (H40):
-			// ---------------
-			// |Slot|HCounter|
-			// |-------------|
-			// |  1 |  0x032 |
-			// |  2 |  0x072 |
-			// |  3 |  0x0B2 |
-			// |  4 |  0x0F2 |
-			// |  5 |  0x132 |
-			// |  6 |  0x1F2 |
-			// ---------------
-			if     ((hcounterCurrent >= 0x030) && (hcounterCurrent <= 0x035)) {nextAccessSlotHCounter = 0x036;}
-			else if ((hcounterCurrent >= 0x070) && (hcounterCurrent <= 0x075)) {nextAccessSlotHCounter = 0x076;}
-			else if ((hcounterCurrent >= 0x0B0) && (hcounterCurrent <= 0x0B5)) {nextAccessSlotHCounter = 0x0B6;}
-			else if ((hcounterCurrent >= 0x0F0) && (hcounterCurrent <= 0x0F5)) {nextAccessSlotHCounter = 0x0F6;}
-			else if ((hcounterCurrent >= 0x130) && (hcounterCurrent <= 0x135)) {nextAccessSlotHCounter = 0x136;}
-			else if ((hcounterCurrent >= 0x1F0) && (hcounterCurrent <= 0x1F5)) {nextAccessSlotHCounter = 0x1F6;}
-			else
-			{
-				// If none of the above cases apply, our next access slot is on the next
-				// even hcounter value.
-				unsigned int hcounterStepsToAdd = ((hcounterCurrent % 2) != 0)? 1: 2;
-				nextAccessSlotHCounter = AddStepsToHCounter(hscanSettings, hcounterCurrent, hcounterStepsToAdd);
-
-				// If we're at the end of a non-display line, and the vcounter is going to
-				// be incremented before the next access slot and bring us into an active
-				// display line, set the next access slot based on the first allowed access
-				// slot after vcounter increment in an active display line for this screen
-				// mode.
-				if (displayEnabled && nextLineActiveDisplayRegion && ((hcounterCurrent < hscanSettings.vcounterIncrementPoint) && (nextAccessSlotHCounter >= hscanSettings.vcounterIncrementPoint)))
-				{
-					nextAccessSlotHCounter = 0x1CE;
-				}
-			}
+			nextAccessSlotHCounter = (!screenModeRS1Current)? 0x121: 0x1CE;
 		}
 	}
 	else
 	{
-		if (!screenModeRS1Current)
+		nextAccessSlotHCounter = (!screenModeRS1Current)? AccessSlotNextHCounterH32ActiveLine[hcounterCurrent & 0x1FF]: AccessSlotNextHCounterH40ActiveLine[hcounterCurrent & 0x1FF];
+
+		// If we're going to pass from an active line to a non-active line on the next
+		// vcounter increment, and there are no remaining access slots on the current line
+		// before the vcounter increment, we set the next access slot to occur on the
+		// vcounter increment point, aligned to the nearest following odd hcounter value in
+		// H32 mode, or even hcounter value in H40 mode.
+		unsigned int lastAccessSlotBeforeVCounterIncrement = (!screenModeRS1Current)? 0x105: 0x142;
+		if (!nextLineActiveDisplayRegion && (hcounterCurrent >= lastAccessSlotBeforeVCounterIncrement) && (hcounterCurrent < hscanSettings.vcounterIncrementPoint))
 		{
-			// External access slots (H32):
-			// ---------------
-			// |Slot|HCounter|
-			// |-------------|
-			// |  1 |  0x005 |
-			// |  2 |  0x015 |
-			// |  3 |  0x025 |
-			// |  4 |  0x045 |
-			// |  5 |  0x055 |
-			// |  6 |  0x065 |
-			// |  7 |  0x085 |
-			// |  8 |  0x095 |
-			// |  9 |  0x0A5 |
-			// | 10 |  0x0C5 |
-			// | 11 |  0x0D5 |
-			// | 12 |  0x0E5 |
-			// | 13 |  0x103 |
-			// | 14 |  0x105 | // Vcounter increments at 0x10A
-			// | 15 |  0x121 | // Next line
-			// | 16 |  0x1E7 | // Next line
-			// ---------------
-			if     (hcounterCurrent < 0x005) {nextAccessSlotHCounter = 0x005;}
-			else if (hcounterCurrent < 0x015) {nextAccessSlotHCounter = 0x015;}
-			else if (hcounterCurrent < 0x025) {nextAccessSlotHCounter = 0x025;}
-			else if (hcounterCurrent < 0x045) {nextAccessSlotHCounter = 0x045;}
-			else if (hcounterCurrent < 0x055) {nextAccessSlotHCounter = 0x055;}
-			else if (hcounterCurrent < 0x065) {nextAccessSlotHCounter = 0x065;}
-			else if (hcounterCurrent < 0x085) {nextAccessSlotHCounter = 0x085;}
-			else if (hcounterCurrent < 0x095) {nextAccessSlotHCounter = 0x095;}
-			else if (hcounterCurrent < 0x0A5) {nextAccessSlotHCounter = 0x0A5;}
-			else if (hcounterCurrent < 0x0C5) {nextAccessSlotHCounter = 0x0C5;}
-			else if (hcounterCurrent < 0x0D5) {nextAccessSlotHCounter = 0x0D5;}
-			else if (hcounterCurrent < 0x0E5) {nextAccessSlotHCounter = 0x0E5;}
-			else if (hcounterCurrent < 0x103) {nextAccessSlotHCounter = 0x103;}
-			else if (hcounterCurrent < 0x105) {nextAccessSlotHCounter = 0x105;}
-			else if (!nextLineActiveDisplayRegion && (hcounterCurrent < hscanSettings.vcounterIncrementPoint))
+			nextAccessSlotHCounter = hscanSettings.vcounterIncrementPoint;
+			if (!screenModeRS1Current)
 			{
-				// If we're going to pass from an active line to a non-active line on the
-				// next vcounter increment, and there are no remaining access slots on the
-				// current line before the vcounter increment, we set the next access slot
-				// to occur on the vcounter increment point, aligned to the nearest
-				// following odd hcounter value.
-				nextAccessSlotHCounter = hscanSettings.vcounterIncrementPoint;
 				nextAccessSlotHCounter += ((nextAccessSlotHCounter % 2) != 0)? 0: 1;
 			}
-			else if (hcounterCurrent < 0x121) {nextAccessSlotHCounter = 0x121;}
-			else if (hcounterCurrent < 0x1E7) {nextAccessSlotHCounter = 0x1E7;}
-			else                             {nextAccessSlotHCounter = 0x005;}
-		}
-		else
-		{
-			// External access slots (H40):
-			// ---------------
-			// |Slot|HCounter|
-			// |-------------|
-			// |  1 |  0x002 |
-			// |  2 |  0x012 |
-			// |  3 |  0x022 |
-			// |  4 |  0x042 |
-			// |  5 |  0x052 |
-			// |  6 |  0x062 |
-			// |  7 |  0x082 |
-			// |  8 |  0x092 |
-			// |  9 |  0x0A2 |
-			// | 10 |  0x0C2 |
-			// | 11 |  0x0D2 |
-			// | 12 |  0x0E2 |
-			// | 13 |  0x102 |
-			// | 14 |  0x112 |
-			// | 15 |  0x122 |
-			// | 16 |  0x140 |
-			// | 17 |  0x142 | // Vcounter increments at 0x14A
-			// | 18 |  0x1CE | // Next line
-			// ---------------
-			if     (hcounterCurrent < 0x002) {nextAccessSlotHCounter = 0x002;}
-			else if (hcounterCurrent < 0x012) {nextAccessSlotHCounter = 0x012;}
-			else if (hcounterCurrent < 0x022) {nextAccessSlotHCounter = 0x022;}
-			else if (hcounterCurrent < 0x042) {nextAccessSlotHCounter = 0x042;}
-			else if (hcounterCurrent < 0x052) {nextAccessSlotHCounter = 0x052;}
-			else if (hcounterCurrent < 0x062) {nextAccessSlotHCounter = 0x062;}
-			else if (hcounterCurrent < 0x082) {nextAccessSlotHCounter = 0x082;}
-			else if (hcounterCurrent < 0x092) {nextAccessSlotHCounter = 0x092;}
-			else if (hcounterCurrent < 0x0A2) {nextAccessSlotHCounter = 0x0A2;}
-			else if (hcounterCurrent < 0x0C2) {nextAccessSlotHCounter = 0x0C2;}
-			else if (hcounterCurrent < 0x0D2) {nextAccessSlotHCounter = 0x0D2;}
-			else if (hcounterCurrent < 0x0E2) {nextAccessSlotHCounter = 0x0E2;}
-			else if (hcounterCurrent < 0x102) {nextAccessSlotHCounter = 0x102;}
-			else if (hcounterCurrent < 0x112) {nextAccessSlotHCounter = 0x112;}
-			else if (hcounterCurrent < 0x122) {nextAccessSlotHCounter = 0x122;}
-			else if (hcounterCurrent < 0x140) {nextAccessSlotHCounter = 0x140;}
-			else if (hcounterCurrent < 0x142) {nextAccessSlotHCounter = 0x142;}
-			else if (!nextLineActiveDisplayRegion && (hcounterCurrent < hscanSettings.vcounterIncrementPoint))
+			else
 			{
-				// If we're going to pass from an active line to a non-active line on the
-				// next vcounter increment, and there are no remaining access slots on the
-				// current line before the vcounter increment, we set the next access slot
-				// to occur on the vcounter increment point, aligned to the nearest
-				// following even hcounter value.
-				nextAccessSlotHCounter = hscanSettings.vcounterIncrementPoint;
 				nextAccessSlotHCounter += ((nextAccessSlotHCounter % 2) != 0)? 1: 0;
 			}
-			else if (hcounterCurrent < 0x1CE) {nextAccessSlotHCounter = 0x1CE;}
-			else                             {nextAccessSlotHCounter = 0x002;}
 		}
 	}
 
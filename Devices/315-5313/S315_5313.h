@@ -56,11 +56,13 @@ References:
 #include "WindowsSupport/WindowsSupport.pkg"
 #include "DeviceInterface/DeviceInterface.pkg"
 #include "TimedBuffers/TimedBuffers.pkg"
+#include "VDPDecoder.h"
 #include <vector>
 #include <list>
 #include <map>
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
 
 class S315_5313 :public Device, public GenericAccessBase<IS315_5313>
 {
@@ -118,8 +120,10 @@ public:
 	virtual void ExecuteTimeslice(double nanoseconds);
 	virtual void ExecuteTimesliceTimingPointStep(unsigned int accessContext);
 	virtual double GetNextTimingPointInDeviceTime(unsigned int& accessContext) const;
+	virtual bool UsesTimingPoints() const;
 	virtual void ExecuteRollback();
 	virtual void ExecuteCommit();
+	virtual bool UsesParallelCommit() const;
 
 	// CE line state functions
 	virtual unsigned int GetCELineID(const Marshal::In<std::wstring>& lineName, bool inputLine) const;
@@ -172,6 +176,7 @@ private:
 	struct InternalRenderOp;
 	struct FIFOBufferEntry;
 	struct HVCounterAdvanceSession;
+	struct UpdateStepPoints;
 	struct ImageBufferColorEntry;
 
 	// Typedefs
@@ -191,6 +196,20 @@ private:
 	static const InternalRenderOp InternalOperationsH32[342];
 	static const InternalRenderOp InternalOperationsH40[420];
 
+	// Access slot tables
+	static const unsigned short AccessSlotNextHCounterH32ActiveLine[0x200];
+	static const unsigned short AccessSlotNextHCounterH32InactiveLine[0x200];
+	static const unsigned short AccessSlotNextHCounterH40ActiveLine[0x200];
+	static const unsigned short AccessSlotNextHCounterH40InactiveLine[0x200];
+
+	// Image buffer exchange state settings
+	static const unsigned int ImageBufferStatePlaneMask = 0x3;
+	static const unsigned int ImageBufferStateFrontPlaneShift = 0;
+	static const unsigned int ImageBufferStateReadyPlaneShift = 2;
+	static const unsigned int ImageBufferStateNewFrameFlag = 0x10;
+	static const unsigned int ImageBufferStateReaderCountShift = 5;
+	static const unsigned int ImageBufferStateReaderCountIncrement = 1 << ImageBufferStateReaderCountShift;
+
 	// Interrupt settings
 	static const unsigned int ExintIPLLineState = 2;
 	static const unsigned int HintIPLLineState = 4;
@@ -231,8 +250,8 @@ private:
 	virtual unsigned int GetImageLastRenderedFrameToken() const;
 	virtual unsigned int GetImageCompletedBufferPlaneNo() const;
 	virtual unsigned int GetImageDrawingBufferPlaneNo() const;
-	virtual void LockImageBufferData(unsigned int planeNo);
-	virtual void UnlockImageBufferData(unsigned int planeNo);
+	virtual unsigned int LockImageBufferData();
+	virtual void UnlockImageBufferData();
 	virtual const unsigned char* GetImageBufferData(unsigned int planeNo) const;
 	virtual const ImageBufferInfo* GetImageBufferInfo(unsigned int planeNo) const;
 	virtual const ImageBufferInfo* GetImageBufferInfo(unsigned int planeNo, unsigned int lineNo, unsigned int pixelNo) const;
@@ -241,6 +260,9 @@ private:
 	virtual unsigned int GetImageBufferLineWidth(unsigned int planeNo, unsigned int lineNo) const;
 	virtual void GetImageBufferActiveScanPosX(unsigned int planeNo, unsigned int lineNo, unsigned int& startPosX, unsigned int& endPosX) const;
 	virtual void GetImageBufferActiveScanPosY(unsigned int planeNo, unsigned int& startPosY, unsigned int& endPosY) const;
+	unsigned int AcquireDisplayingImageBufferPlane() const;
+	void ReleaseDisplayingImageBufferPlane() const;
+	void PublishDrawingImageBufferPlane();
 
 	// DMA functions
 	void DMAWorkerThread();
@@ -335,10 +357,14 @@ private:
 	// Processor state advancement functions
 	void UpdateInternalState(unsigned int mclkCyclesTarget, bool checkFifoStateBeforeUpdate, bool stopWhenFifoEmpty, bool stopWhenFifoFull, bool stopWhenFifoNotFull, bool stopWhenReadDataAvailable, bool stopWhenNoDMAOperationInProgress, bool allowAdvancePastCycleTarget);
 	bool AdvanceProcessorState(unsigned int mclkCyclesTarget, bool stopAtNextAccessSlot, bool allowAdvancePastTargetForAccessSlot);
+	void GetUpdateStepPoints(const HScanSettings& hscanSettings, const VScanSettings& vscanSettings, unsigned int hcounter, unsigned int vcounter, bool oddFlagSet, bool stopAtNextAccessSlot, bool hscanSettingsChanged, bool vscanSettingsChanged, UpdateStepPoints& updatePoints) const;
+	static unsigned int GetPixelClockTicksForUpdateStep(const UpdateStepPoints& updatePoints, unsigned int pixelClockCyclesAvailable, bool allowAdvancePastTargetForAccessSlot, bool& stepEndsAtUpdatePoint);
 	void PerformReadCacheOperation();
 	void PerformFIFOWriteOperation();
-	void PerformDMACopyOperation();
-	void PerformDMAFillOperation();
+	void PerformDMACopyOperation(unsigned int mclkTime);
+	void PerformDMAFillOperation(unsigned int mclkTime);
+	void PerformDMAFillOrCopyBatch(unsigned int mclkCyclesTarget);
+	unsigned int BuildDMAAccessSlotSchedule(unsigned int mclkCyclesTarget, unsigned int maxSlotCount);
 	void CacheDMATransferReadData(unsigned int mclkTime);
 	void PerformDMATransferOperation();
 	void AdvanceDMAState();
@@ -891,8 +917,8 @@ private:
 
 	// Analog render data buffers
 	unsigned int _drawingImageBufferPlane;
+	mutable std::atomic<unsigned int> _imageBufferExchangeState;
 	volatile unsigned int _lastRenderedFrameToken;
-	mutable ReadWriteLock _imageBufferLock[ImageBufferPlanes];
 	unsigned char _imageBuffer[ImageBufferPlanes][ImageBufferHeight * ImageBufferWidth * 4];
 	ImageBufferInfo _imageBufferInfo[ImageBufferPlanes][ImageBufferHeight * ImageBufferWidth];
 	bool _imageBufferOddInterlaceFrame[ImageBufferPlanes];
@@ -932,6 +958,8 @@ private:
 	bool _bdmaTransferInvalidPortWriteCached;
 	unsigned int _dmaTransferInvalidPortWriteAddressCache;
 	unsigned int _bdmaTransferInvalidPortWriteAddressCache;
+	std::vector<unsigned int> _dmaAccessSlotSchedule;
+	bool _dmaAccessSlotBatchingEnabled;
 	Data _dmaTransferInvalidPortWriteDataCache;
 	Data _bdmaTransferInvalidPortWriteDataCache;
 	volatile bool _dmaAdvanceUntilDMAComplete;
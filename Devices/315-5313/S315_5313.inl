@@ -404,6 +404,24 @@ struct S315_5313::HVCounterAdvanceSession
 	unsigned int mclkTicksAdvanced;
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+struct S315_5313::UpdateStepPoints
+{
+	bool accessSlotActive;
+	unsigned int pixelClockTicksBeforeAccessSlot;
+	bool hblankActive;
+	unsigned int pixelClockTicksBeforeHBlank;
+	bool vblankActive;
+	unsigned int pixelClockTicksBeforeVBlank;
+	bool vintActive;
+	unsigned int pixelClockTicksBeforeVInt;
+	bool exintActive;
+	unsigned int pixelClockTicksBeforeEXInt;
+	bool hintCounterAdvanceActive;
+	unsigned int hintCounterAdvanceVCounter;
+	unsigned int pixelClockTicksBeforeHIntCounterAdvance;
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 struct S315_5313::ImageBufferColorEntry
 {
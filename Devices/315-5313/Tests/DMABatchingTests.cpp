@@ -0,0 +1,250 @@
+#include "catch.hpp"
+#include "../S315_5313.h"
+#include "OfflineSystemInterface.h"
+#include <vector>
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Port accesses are grouped into timeslices of one millisecond, and committed in the same
+// way the system does during normal execution. The status register is sampled at regular
+// intervals through each timeslice, which forces the VDP to advance to each sample point
+// part way through any DMA operation in progress.
+//----------------------------------------------------------------------------------------------------------------------
+static const double MclkRate = 53693175.0;
+static const double TimesliceLength = 1000000.0;
+static const double PortWriteSpacing = 100.0;
+static const unsigned int StatusReadsPerTimeslice = 16;
+static const unsigned int VRAMSize = 0x10000;
+static const unsigned int FIFOEntryCount = 4;
+
+//----------------------------------------------------------------------------------------------------------------------
+struct PortWrite
+{
+	unsigned int timesliceNo;
+	unsigned int location;
+	unsigned int data;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+struct VDPStateSnapshot
+{
+	std::vector<unsigned int> statusReads;
+	std::vector<unsigned int> vramData;
+	std::vector<unsigned int> fifoState;
+	unsigned int hcounter;
+	unsigned int vcounter;
+	unsigned int dmaLengthCounter;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+static void AddRegisterWrite(std::vector<PortWrite>& portWrites, unsigned int timesliceNo, unsigned int registerNo, unsigned int data)
+{
+	portWrites.push_back({timesliceNo, 0x4, 0x8000 | (registerNo << 8) | data});
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static void AddCommandWrite(std::vector<PortWrite>& portWrites, unsigned int timesliceNo, unsigned int commandCode, unsigned int address)
+{
+	portWrites.push_back({timesliceNo, 0x4, ((commandCode & 0x3) << 14) | (address & 0x3FFF)});
+	portWrites.push_back({timesliceNo, 0x4, ((commandCode & 0x3C) << 2) | ((address >> 14) & 0x3)});
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Switches the VDP into mode 5 with DMA enabled, in either H32 or H40 mode. Note that
+// access slots are only spread out across the line when the display is enabled, so we
+// test with both settings to cover both access slot layouts.
+//----------------------------------------------------------------------------------------------------------------------
+static void AddDisplaySetup(std::vector<PortWrite>& portWrites, unsigned int timesliceNo, bool h40ModeEnabled, bool displayEnabled)
+{
+	AddRegisterWrite(portWrites, timesliceNo, 0, 0x04);
+	AddRegisterWrite(portWrites, timesliceNo, 1, 0x14 | (displayEnabled? 0x40: 0x00));
+	AddRegisterWrite(portWrites, timesliceNo, 12, h40ModeEnabled? 0x81: 0x00);
+	AddRegisterWrite(portWrites, timesliceNo, 15, 0x02);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static void AddDMAFill(std::vector<PortWrite>& portWrites, unsigned int timesliceNo, unsigned int targetAddress, unsigned int length, unsigned int fillData)
+{
+	AddRegisterWrite(portWrites, timesliceNo, 19, length & 0xFF);
+	AddRegisterWrite(portWrites, timesliceNo, 20, (length >> 8) & 0xFF);
+	AddRegisterWrite(portWrites, timesliceNo, 23, 0x80);
+	AddCommandWrite(portWrites, timesliceNo, 0x21, targetAddress);
+	portWrites.push_back({timesliceNo, 0x0, fillData});
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static void AddDMACopy(std::vector<PortWrite>& portWrites, unsigned int timesliceNo, unsigned int sourceAddress, unsigned int targetAddress, unsigned int length)
+{
+	AddRegisterWrite(portWrites, timesliceNo, 15, 0x01);
+	AddRegisterWrite(portWrites, timesliceNo, 19, length & 0xFF);
+	AddRegisterWrite(portWrites, timesliceNo, 20, (length >> 8) & 0xFF);
+	AddRegisterWrite(portWrites, timesliceNo, 21, sourceAddress & 0xFF);
+	AddRegisterWrite(portWrites, timesliceNo, 22, (sourceAddress >> 8) & 0xFF);
+	AddRegisterWrite(portWrites, timesliceNo, 23, 0xC0);
+	AddCommandWrite(portWrites, timesliceNo, 0x30, targetAddress);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Writes a block of data into VRAM through the data port, so that a DMA copy operation has
+// some varied source data to work with.
+//----------------------------------------------------------------------------------------------------------------------
+static void AddVRAMDataWrites(std::vector<PortWrite>& portWrites, unsigned int timesliceNo, unsigned int targetAddress, unsigned int wordCount)
+{
+	AddCommandWrite(portWrites, timesliceNo, 0x01, targetAddress);
+	for (unsigned int i = 0; i < wordCount; ++i)
+	{
+		portWrites.push_back({timesliceNo, 0x0, ((i * 0x1357) + 0x2468) & 0xFFFF});
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Runs the given port writes through the device, and returns the values returned by every
+// status register read, along with the final VRAM contents and FIFO state.
+//----------------------------------------------------------------------------------------------------------------------
+static VDPStateSnapshot RunPortWrites(const std::vector<PortWrite>& portWrites, unsigned int timesliceCount, bool dmaBatchingEnabled)
+{
+	OfflineSystemInterface systemInterface;
+	OfflineBusInterface busInterface;
+	OfflineTimedBufferDevice vram(L"VRAM", VRAMSize);
+	OfflineTimedBufferDevice cram(L"CRAM", 0x80);
+	OfflineTimedBufferDevice vsram(L"VSRAM", 0x50, true);
+	OfflineTimedBufferDevice spriteCache(L"SpriteCache", 0x140);
+	S315_5313 device(L"315-5313", L"VDP", 0);
+	IS315_5313& deviceInterface = device;
+	device.BindToSystemInterface(&systemInterface);
+	device.BindToDeviceContext(new OfflineDeviceContext(device));
+	device.BuildDevice();
+	device.AddReference(L"BusInterface", &busInterface);
+	device.AddReference(L"VRAM", &vram);
+	device.AddReference(L"CRAM", &cram);
+	device.AddReference(L"VSRAM", &vsram);
+	device.AddReference(L"SpriteCache", &spriteCache);
+	device.TransparentSetClockSourceRate(device.GetClockSourceID(L"MCLK"), MclkRate);
+	deviceInterface.SetDMAAccessSlotBatchingEnabled(dmaBatchingEnabled);
+	REQUIRE(device.ValidateDevice());
+	vram.Initialize();
+	cram.Initialize();
+	vsram.Initialize();
+	spriteCache.Initialize();
+	device.Initialize();
+
+	VDPStateSnapshot snapshot;
+	device.BeginExecution();
+	std::vector<PortWrite>::const_iterator nextWrite = portWrites.begin();
+	for (unsigned int timesliceNo = 0; timesliceNo < timesliceCount; ++timesliceNo)
+	{
+		device.NotifyUpcomingTimeslice(TimesliceLength);
+		device.ExecuteTimeslice(TimesliceLength);
+		double accessTime = 0;
+		while ((nextWrite != portWrites.end()) && (nextWrite->timesliceNo == timesliceNo))
+		{
+			device.WriteInterface(0, nextWrite->location, Data(16, nextWrite->data), 0, accessTime, 0);
+			accessTime += PortWriteSpacing;
+			++nextWrite;
+		}
+		for (unsigned int readNo = 1; readNo <= StatusReadsPerTimeslice; ++readNo)
+		{
+			Data status(16);
+			device.ReadInterface(0, 0x4, status, 0, readNo * (TimesliceLength / (StatusReadsPerTimeslice + 1)), 0);
+			snapshot.statusReads.push_back(status.GetData());
+		}
+		device.NotifyAfterExecuteCalled();
+		device.ExecuteCommit();
+	}
+	device.SuspendExecution();
+	REQUIRE(!systemInterface.RollbackRequested());
+
+	ITimedBufferInt* vramBuffer = vram.GetTimedBuffer();
+	for (unsigned int address = 0; address < VRAMSize; ++address)
+	{
+		snapshot.vramData.push_back(vramBuffer->ReadLatest(address));
+	}
+	for (unsigned int entryNo = 0; entryNo < FIFOEntryCount; ++entryNo)
+	{
+		snapshot.fifoState.push_back(deviceInterface.RegGetFIFOCode(entryNo));
+		snapshot.fifoState.push_back(deviceInterface.RegGetFIFOAddress(entryNo));
+		snapshot.fifoState.push_back(deviceInterface.RegGetFIFOData(entryNo));
+		snapshot.fifoState.push_back(deviceInterface.RegGetFIFOWritePending(entryNo)? 1: 0);
+	}
+	snapshot.fifoState.push_back(deviceInterface.RegGetFIFONextReadEntry());
+	snapshot.fifoState.push_back(deviceInterface.RegGetFIFONextWriteEntry());
+	snapshot.hcounter = deviceInterface.RegGetHCounterInternal();
+	snapshot.vcounter = deviceInterface.RegGetVCounterInternal();
+	snapshot.dmaLengthCounter = deviceInterface.RegGetDMALengthCounter();
+	return snapshot;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Runs the given port writes with DMA access slot batching enabled and disabled, and
+// confirms the device ends up in exactly the same state, and returned exactly the same
+// status register values along the way.
+//----------------------------------------------------------------------------------------------------------------------
+static void CompareBatchedAndPerSlotDMA(const std::vector<PortWrite>& portWrites, unsigned int timesliceCount)
+{
+	VDPStateSnapshot perSlotState = RunPortWrites(portWrites, timesliceCount, false);
+	VDPStateSnapshot batchedState = RunPortWrites(portWrites, timesliceCount, true);
+
+	// Confirm the test actually sampled the device while a DMA operation was in progress,
+	// and that the operation wrote some data into VRAM.
+	bool dmaBusySampled = std::any_of(perSlotState.statusReads.begin(), perSlotState.statusReads.end(), [](unsigned int status) { return (status & 0x2) != 0; });
+	REQUIRE(dmaBusySampled);
+	REQUIRE(std::count(perSlotState.vramData.begin(), perSlotState.vramData.end(), 0u) < (std::ptrdiff_t)VRAMSize);
+
+	// Report the first point of difference in each set of results, rather than the full
+	// contents, to keep any failure output readable.
+	unsigned int firstDifferentStatusRead = (unsigned int)(std::mismatch(perSlotState.statusReads.begin(), perSlotState.statusReads.end(), batchedState.statusReads.begin()).first - perSlotState.statusReads.begin());
+	unsigned int firstDifferentVRAMAddress = (unsigned int)(std::mismatch(perSlotState.vramData.begin(), perSlotState.vramData.end(), batchedState.vramData.begin()).first - perSlotState.vramData.begin());
+	CHECK(firstDifferentStatusRead == (unsigned int)perSlotState.statusReads.size());
+	CHECK(firstDifferentVRAMAddress == VRAMSize);
+	CHECK(batchedState.fifoState == perSlotState.fifoState);
+	CHECK(batchedState.hcounter == perSlotState.hcounter);
+	CHECK(batchedState.vcounter == perSlotState.vcounter);
+	CHECK(batchedState.dmaLengthCounter == perSlotState.dmaLengthCounter);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST_CASE("DMA access slot batching matches per-slot processing", "")
+{
+	SECTION("DMA fill with display enabled in H40 mode", "")
+	{
+		std::vector<PortWrite> portWrites;
+		AddDisplaySetup(portWrites, 0, true, true);
+		AddDMAFill(portWrites, 1, 0x1000, 0x4000, 0xA55A);
+		CompareBatchedAndPerSlotDMA(portWrites, 40);
+	}
+
+	SECTION("DMA fill with display disabled in H32 mode", "")
+	{
+		std::vector<PortWrite> portWrites;
+		AddDisplaySetup(portWrites, 0, false, false);
+		AddDMAFill(portWrites, 1, 0x2001, 0x8000, 0x1234);
+		CompareBatchedAndPerSlotDMA(portWrites, 20);
+	}
+
+	SECTION("DMA fill interrupted by a data port write", "")
+	{
+		std::vector<PortWrite> portWrites;
+		AddDisplaySetup(portWrites, 0, true, true);
+		AddDMAFill(portWrites, 1, 0x0000, 0x4000, 0xFFFF);
+		portWrites.push_back({5, 0x0, 0x8421});
+		CompareBatchedAndPerSlotDMA(portWrites, 40);
+	}
+
+	SECTION("DMA fill across a screen mode change", "")
+	{
+		std::vector<PortWrite> portWrites;
+		AddDisplaySetup(portWrites, 0, false, true);
+		AddDMAFill(portWrites, 1, 0x4000, 0x4000, 0x5AA5);
+		AddRegisterWrite(portWrites, 6, 12, 0x81);
+		CompareBatchedAndPerSlotDMA(portWrites, 40);
+	}
+
+	SECTION("DMA copy with display enabled in H40 mode", "")
+	{
+		std::vector<PortWrite> portWrites;
+		AddDisplaySetup(portWrites, 0, true, true);
+		AddVRAMDataWrites(portWrites, 0, 0x0000, 64);
+		AddDMACopy(portWrites, 2, 0x0000, 0x8000, 0x2000);
+		CompareBatchedAndPerSlotDMA(portWrites, 40);
+	}
+}
@@ -0,0 +1,127 @@
+#ifndef __OFFLINESYSTEMINTERFACE_H__
+#define __OFFLINESYSTEMINTERFACE_H__
+#include "DeviceInterface/DeviceInterface.pkg"
+#include "TimedBuffers/TimedBuffers.pkg"
+#include "Device/Device.pkg"
+#include "../../Memory/TimedBufferInt.h"
+
+// Minimal trace recorder for running devices outside a system. Tracing is always disabled.
+class NullTraceRecorder :public ITraceRecorder
+{
+public:
+	virtual unsigned int GetITraceRecorderVersion() const { return ThisITraceRecorderVersion(); }
+	virtual bool TraceRecordingEnabled() const { return false; }
+	virtual void RecordTraceEvent(EventType eventType, const char* eventName) { }
+	virtual void SetCurrentThreadTraceName(const Marshal::In<std::wstring>& threadName) { }
+};
+
+// Minimal system interface for running devices outside a system. Port accesses are
+// replayed in order, so rollbacks should never be requested, and we report any that are.
+class OfflineSystemInterface :public ISystemDeviceInterface
+{
+public:
+	OfflineSystemInterface() :_rollbackRequested(false) { }
+	bool RollbackRequested() const { return _rollbackRequested; }
+	virtual unsigned int GetISystemDeviceInterfaceVersion() const { return ThisISystemDeviceInterfaceVersion(); }
+	virtual Marshal::Ret<std::wstring> GetCapturePath() const { return L""; }
+	virtual void WriteLogEvent(const ILogEntry& entry) const { }
+	virtual void FlagStopSystem() { }
+	virtual bool IsSystemRollbackFlagged() const { return false; }
+	virtual double SystemRollbackTime() const { return 0; }
+	virtual void SetSystemRollback(IDeviceContext* triggerDevice, IDeviceContext* rollbackDevice, double targetTime, double conflictingEventTime, unsigned int accessContext, void (*callbackFunction)(void*), void* callbackParams) { _rollbackRequested = true; }
+	virtual bool PerformingSingleDeviceStep() const { return false; }
+	virtual bool TranslateKeyCode(unsigned int platformKeyCode, KeyCode& inputKeyCode) const { return false; }
+	virtual bool TranslateJoystickButton(unsigned int joystickNo, unsigned int buttonNo, KeyCode& inputKeyCode) const { return false; }
+	virtual bool TranslateJoystickAxisAsButton(unsigned int joystickNo, unsigned int axisNo, bool positiveAxis, KeyCode& inputKeyCode) const { return false; }
+	virtual bool TranslateJoystickAxis(unsigned int joystickNo, unsigned int axisNo, AxisCode& inputAxisCode) const { return false; }
+	virtual void HandleInputKeyDown(KeyCode keyCode) { }
+	virtual void HandleInputKeyUp(KeyCode keyCode) { }
+	virtual void HandleInputAxisUpdate(AxisCode axisCode, float newValue) { }
+	virtual void HandleInputScrollUpdate(ScrollCode scrollCode, int scrollTicks) { }
+	virtual ITraceRecorder& GetTraceRecorder() const { return _traceRecorder; }
+
+private:
+	bool _rollbackRequested;
+	mutable NullTraceRecorder _traceRecorder;
+};
+
+// Minimal device context for running a device outside a system. The device always runs
+// in isolation, so suspension and dependency requests are accepted and ignored. Note that
+// the bound device takes ownership of the context, and deletes it when it is destroyed.
+class OfflineDeviceContext :public IDeviceContext
+{
+public:
+	OfflineDeviceContext(IDevice& targetDevice) :_targetDevice(targetDevice), _executionProgress(0), _transientExecutionActive(false) { }
+	virtual unsigned int GetIDeviceContextVersion() const { return ThisIDeviceContextVersion(); }
+	virtual double GetCurrentTimesliceProgress() const { return _executionProgress; }
+	virtual void SetCurrentTimesliceProgress(double executionProgress) { _executionProgress = executionProgress; }
+	virtual bool DeviceEnabled() const { return true; }
+	virtual void SetDeviceEnabled(bool state) { }
+	virtual IDevice& GetTargetDevice() const { return _targetDevice; }
+	virtual unsigned int GetDeviceIndexNo() const { return 0; }
+	virtual void WriteLogEvent(const ILogEntry& entry) { }
+	virtual void FlagStopSystem() { }
+	virtual void StopSystem() { }
+	virtual void RunSystem() { }
+	virtual void ExecuteDeviceStep() { }
+	virtual Marshal::Ret<std::wstring> GetFullyQualifiedDeviceInstanceName() const { return _targetDevice.GetDeviceInstanceName(); }
+	virtual Marshal::Ret<std::wstring> GetModuleDisplayName() const { return L""; }
+	virtual Marshal::Ret<std::wstring> GetModuleInstanceName() const { return L""; }
+	virtual bool UsesExecuteSuspend() const { return false; }
+	virtual bool UsesTransientExecution() const { return false; }
+	virtual bool TimesliceExecutionSuspended() const { return false; }
+	virtual void SuspendTimesliceExecution() { }
+	virtual void WaitForTimesliceExecutionResume() const { }
+	virtual void ResumeTimesliceExecution() { }
+	virtual bool TimesliceSuspensionDisabled() const { return true; }
+	virtual bool TransientExecutionActive() const { return _transientExecutionActive; }
+	virtual void SetTransientExecutionActive(bool state) { _transientExecutionActive = state; }
+	virtual bool TimesliceExecutionCompleted() const { return false; }
+	virtual void SetDeviceDependencyEnable(IDeviceContext* targetDevice, bool state) { }
+
+private:
+	IDevice& _targetDevice;
+	double _executionProgress;
+	bool _transientExecutionActive;
+};
+
+// Minimal bus interface for running a device outside a system. Nothing else is mapped on
+// the bus, so memory reads return zero, writes are discarded, and line state changes are
+// accepted without being routed anywhere.
+class OfflineBusInterface :public IBusInterface
+{
+public:
+	virtual unsigned int GetIBusInterfaceVersion() const { return ThisIBusInterfaceVersion(); }
+	virtual AccessResult ReadMemory(unsigned int location, Data& data, IDeviceContext* caller, double accessTime, unsigned int accessContext, void* calculateCELineStateContext = 0) { data = 0; return AccessResult(false); }
+	virtual AccessResult WriteMemory(unsigned int location, const Data& data, IDeviceContext* caller, double accessTime, unsigned int accessContext, void* calculateCELineStateContext = 0) { return AccessResult(false); }
+	virtual void TransparentReadMemory(unsigned int location, Data& data, IDeviceContext* caller, unsigned int accessContext, void* calculateCELineStateContext = 0) const { data = 0; }
+	virtual void TransparentWriteMemory(unsigned int location, const Data& data, IDeviceContext* caller, unsigned int accessContext, void* calculateCELineStateContext = 0) const { }
+	virtual AccessResult ReadPort(unsigned int location, Data& data, IDeviceContext* caller, double accessTime, unsigned int accessContext, void* calculateCELineStateContext = 0) { data = 0; return AccessResult(false); }
+	virtual AccessResult WritePort(unsigned int location, const Data& data, IDeviceContext* caller, double accessTime, unsigned int accessContext, void* calculateCELineStateContext = 0) { return AccessResult(false); }
+	virtual void TransparentReadPort(unsigned int location, Data& data, IDeviceContext* caller, unsigned int accessContext, void* calculateCELineStateContext = 0) const { data = 0; }
+	virtual void TransparentWritePort(unsigned int location, const Data& data, IDeviceContext* caller, unsigned int accessContext, void* calculateCELineStateContext = 0) const { }
+	virtual bool SetLineState(unsigned int sourceLine, const Data& lineData, IDeviceContext* sourceDevice, IDeviceContext* callingDevice, double accessTime, unsigned int accessContext) { return true; }
+	virtual bool RevokeSetLineState(unsigned int sourceLine, const Data& lineData, double reportedTime, IDeviceContext* sourceDevice, IDeviceContext* callingDevice, double accessTime, unsigned int accessContext) { return true; }
+	virtual bool AdvanceToLineState(unsigned int sourceLine, const Data& lineData, IDeviceContext* sourceDevice, IDeviceContext* callingDevice, double accessTime, unsigned int accessContext) { return true; }
+	virtual void SetClockRate(double newClockRate, const IClockSource* sourceClock, IDeviceContext* callingDevice, double accessTime, unsigned int accessContext) { }
+	virtual void TransparentSetClockRate(double newClockRate, const IClockSource* sourceClock) { }
+};
+
+// Minimal timed buffer device, which owns a timed buffer of the requested size, in the same
+// way as the TimedBufferIntDevice memory device does within a system.
+class OfflineTimedBufferDevice :public Device, public ITimedBufferIntDevice
+{
+public:
+	OfflineTimedBufferDevice(const std::wstring& instanceName, unsigned int bufferSize, bool keepLatestBufferCopy = false)
+	:Device(L"TimedBufferIntDevice", instanceName, 0)
+	{
+		_bufferShell.Resize(bufferSize, keepLatestBufferCopy);
+	}
+	virtual void Initialize() { _bufferShell.Initialize(); }
+	virtual ITimedBufferInt* GetTimedBuffer() { return &_bufferShell; }
+
+private:
+	TimedBufferInt _bufferShell;
+};
+
+#endif
@@ -0,0 +1,264 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include "../VDPDecoder.h"
+
+const unsigned int TileSheetIterations = 200;
+const unsigned int NameTableIterations = 200;
+const unsigned int TilesPerSheetRow = 32;
+
+// Reference implementations of the pattern and name table decoding, which read each pixel
+// individually in the same way as the original inline debugger view code. These are used
+// both to verify the output of the decoder, and as a baseline for the timing tests.
+unsigned int ReferenceReadPixelIndex(const std::vector<unsigned char>& vramData, unsigned int patternRowAddress, unsigned int patternColumnNo)
+{
+	unsigned char patternByte = vramData[(patternRowAddress + (patternColumnNo / 2)) % VDPDecoder::VramSize];
+	return ((patternColumnNo % 2) == 0)? (patternByte >> 4): (patternByte & 0x0F);
+}
+
+void ReferenceDecodeTileSheet(const std::vector<unsigned char>& vramData, const VDPDecoder::RGBAColor* paletteRow, std::vector<VDPDecoder::RGBAColor>& outputBuffer)
+{
+	for (unsigned int byteNo = 0; byteNo < VDPDecoder::VramSize; ++byteNo)
+	{
+		for (unsigned int pixelNo = 0; pixelNo < 2; ++pixelNo)
+		{
+			unsigned int index = (vramData[byteNo] >> ((1 - pixelNo) * 4)) & 0x0F;
+			unsigned int blockNo = (byteNo * 2) / (8 * 8);
+			unsigned int pixelNoWithinBlock = ((byteNo * 2) + pixelNo) % (8 * 8);
+			unsigned int bufferRowNo = ((blockNo / TilesPerSheetRow) * 8) + (pixelNoWithinBlock / 8);
+			unsigned int bufferColumnNo = ((blockNo % TilesPerSheetRow) * 8) + (pixelNoWithinBlock % 8);
+			outputBuffer[(bufferRowNo * TilesPerSheetRow * 8) + bufferColumnNo] = paletteRow[index];
+		}
+	}
+}
+
+void ReferenceDecodeNameTable(const std::vector<unsigned char>& vramData, unsigned int mappingBase, unsigned int patternBase, unsigned int planeWidth, unsigned int planeHeight, unsigned int regionWidth, unsigned int regionHeight, const VDPDecoder::RGBAColor* palette, const VDPDecoder::RGBAColor& backdropColor, std::vector<VDPDecoder::RGBAColor>& outputBuffer)
+{
+	for (unsigned int ypos = 0; ypos < regionHeight; ++ypos)
+	{
+		for (unsigned int xpos = 0; xpos < regionWidth; ++xpos)
+		{
+			unsigned int mappingIndex = (((ypos / 8) % planeHeight) * planeWidth) + ((xpos / 8) % planeWidth);
+			unsigned int mappingAddress = (mappingBase + (mappingIndex * 2)) % VDPDecoder::VramSize;
+			unsigned int mappingData = ((unsigned int)vramData[mappingAddress] << 8) | (unsigned int)vramData[(mappingAddress + 1) % VDPDecoder::VramSize];
+			unsigned int patternRowNumber = ((mappingData & 0x1000) != 0)? 7 - (ypos % 8): (ypos % 8);
+			unsigned int patternRowAddress = patternBase + (((mappingData * 32) + (patternRowNumber * 4)) % VDPDecoder::VramSize);
+			unsigned int patternColumnNo = ((mappingData & 0x0800) != 0)? 7 - (xpos % 8): (xpos % 8);
+			unsigned int paletteIndex = ReferenceReadPixelIndex(vramData, patternRowAddress, patternColumnNo);
+			unsigned int paletteRow = (mappingData >> 13) & 0x03;
+			outputBuffer[(ypos * regionWidth) + xpos] = (paletteIndex == 0)? backdropColor: palette[(paletteRow * 16) + paletteIndex];
+		}
+	}
+}
+
+bool CompareBuffers(const std::vector<VDPDecoder::RGBAColor>& first, const std::vector<VDPDecoder::RGBAColor>& second)
+{
+	for (size_t i = 0; i < first.size(); ++i)
+	{
+		if ((first[i].r != second[i].r) || (first[i].g != second[i].g) || (first[i].b != second[i].b) || (first[i].a != second[i].a))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool TestUnpackPatternData()
+{
+	// Verify the unpack kernel against the scalar nibble order for lengths which exercise
+	// both the vectorized and remainder loops.
+	unsigned char patternData[40];
+	for (unsigned int i = 0; i < sizeof(patternData); ++i)
+	{
+		patternData[i] = (unsigned char)((i * 37) + 11);
+	}
+	for (unsigned int byteCount = 0; byteCount <= sizeof(patternData); ++byteCount)
+	{
+		unsigned char paletteIndices[sizeof(patternData) * 2];
+		VDPDecoder::UnpackPatternData(&patternData[0], byteCount, &paletteIndices[0]);
+		for (unsigned int i = 0; i < byteCount; ++i)
+		{
+			if ((paletteIndices[(i * 2) + 0] != (patternData[i] >> 4)) || (paletteIndices[(i * 2) + 1] != (patternData[i] & 0x0F)))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+bool TestReadPixelIndex()
+{
+	unsigned int patternRow = 0x12345678;
+	for (unsigned int pixelNo = 0; pixelNo < 8; ++pixelNo)
+	{
+		if ((VDPDecoder::ReadPixelIndex(patternRow, false, pixelNo) != (pixelNo + 1)) || (VDPDecoder::ReadPixelIndex(patternRow, true, pixelNo) != (8 - pixelNo)))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool TestDecodeSprite(const std::vector<unsigned char>& vramData, const VDPDecoder::RGBAColor* palette)
+{
+	// Draw a sprite with each combination of size and flip settings, partially clipped by
+	// the region, and compare the result against a per-pixel reference.
+	const unsigned int regionPosX = 128;
+	const unsigned int regionPosY = 128;
+	const unsigned int regionWidth = 64;
+	const unsigned int regionHeight = 64;
+	for (unsigned int settings = 0; settings < 64; ++settings)
+	{
+		unsigned int rawDataWord0 = regionPosY - 12 + (settings % 7);
+		unsigned int rawDataWord1 = (settings & 0x0F) << 8;
+		unsigned int rawDataWord2 = 0x4123 | ((settings & 0x30) << 7);
+		unsigned int rawDataWord3 = regionPosX + 40 + (settings % 5);
+		VDPDecoder::SpriteTableEntry entry = VDPDecoder::DecodeSpriteTableEntry(rawDataWord0, rawDataWord1, rawDataWord2, rawDataWord3);
+		std::vector<VDPDecoder::RGBAColor> referenceBuffer(regionWidth * regionHeight);
+		std::vector<VDPDecoder::RGBAColor> decodedBuffer(regionWidth * regionHeight);
+		VDPDecoder::DecodeSprite(&vramData[0], 0x2000, entry, false, palette, regionPosX, regionPosY, regionWidth, regionHeight, &decodedBuffer[0], regionWidth);
+
+		unsigned int spriteHeightInCells = entry.height + 1;
+		unsigned int spriteWidthInCells = entry.width + 1;
+		for (unsigned int ypos = 0; ypos < (spriteHeightInCells * 8); ++ypos)
+		{
+			for (unsigned int xpos = 0; xpos < (spriteWidthInCells * 8); ++xpos)
+			{
+				if (((entry.xpos + xpos) < regionPosX) || ((entry.xpos + xpos) >= (regionPosX + regionWidth)) || ((entry.ypos + ypos) < regionPosY) || ((entry.ypos + ypos) >= (regionPosY + regionHeight)))
+				{
+					continue;
+				}
+				unsigned int pixelRowNo = (entry.vflip)? ((spriteHeightInCells * 8) - 1) - ypos: ypos;
+				unsigned int pixelColumnNo = (entry.hflip)? ((spriteWidthInCells * 8) - 1) - xpos: xpos;
+				unsigned int blockOffset = ((pixelColumnNo / 8) * spriteHeightInCells) + (pixelRowNo / 8);
+				unsigned int patternRowAddress = 0x2000 + ((((entry.blockNumber + blockOffset) * 32) + ((pixelRowNo % 8) * 4)) % VDPDecoder::VramSize);
+				unsigned int paletteIndex = ReferenceReadPixelIndex(vramData, patternRowAddress, pixelColumnNo % 8);
+				if (paletteIndex != 0)
+				{
+					referenceBuffer[(((entry.ypos + ypos) - regionPosY) * regionWidth) + ((entry.xpos + xpos) - regionPosX)] = palette[(entry.paletteLine * 16) + paletteIndex];
+				}
+			}
+		}
+		if (!CompareBuffers(referenceBuffer, decodedBuffer))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool TestSpriteTableEntry()
+{
+	unsigned char vramData[VDPDecoder::VramSize] = {};
+	unsigned char entryData[VDPDecoder::SpriteTableEntryByteSize] = { 0x01, 0x23, 0x0E, 0x45, 0xD9, 0xAB, 0x01, 0xCD };
+	for (unsigned int i = 0; i < VDPDecoder::SpriteTableEntryByteSize; ++i)
+	{
+		vramData[0xFC00 + (3 * VDPDecoder::SpriteTableEntryByteSize) + i] = entryData[i];
+	}
+	VDPDecoder::SpriteTableEntry entry = VDPDecoder::DecodeSpriteTableEntry(&vramData[0], 0xFC00, 3);
+	return (entry.ypos == 0x123) && (entry.width == 3) && (entry.height == 2) && (entry.link == 0x45)
+	    && entry.priority && (entry.paletteLine == 2) && entry.vflip && entry.hflip && (entry.blockNumber == 0x1AB) && (entry.xpos == 0x1CD);
+}
+
+bool ReportTestResult(const char* testName, bool testResult)
+{
+	std::cout << testName << "\t" << (testResult? "Passed": "FAILED") << std::endl;
+	return testResult;
+}
+
+int main()
+{
+	std::cout << "VDPDecoder tests" << std::endl;
+	std::cout << std::showpoint << std::fixed << std::setprecision(8);
+
+	// Build a VRAM image filled with pseudo-random data, and a palette with a distinct
+	// colour for each entry.
+	std::vector<unsigned char> vramData(VDPDecoder::VramSize);
+	unsigned int seed = 12345;
+	for (unsigned int i = 0; i < VDPDecoder::VramSize; ++i)
+	{
+		seed = (seed * 1103515245) + 12345;
+		vramData[i] = (unsigned char)(seed >> 16);
+	}
+	VDPDecoder::RGBAColor palette[VDPDecoder::PaletteRowCount * VDPDecoder::PaletteRowEntryCount];
+	for (unsigned int i = 0; i < (VDPDecoder::PaletteRowCount * VDPDecoder::PaletteRowEntryCount); ++i)
+	{
+		palette[i] = VDPDecoder::RGBAColor((unsigned char)(i * 4), (unsigned char)(255 - (i * 4)), (unsigned char)(i * 7));
+	}
+	VDPDecoder::RGBAColor backdropColor(1, 2, 3);
+
+	// Run the basic correctness tests
+	bool result = true;
+	result &= ReportTestResult("UnpackPatternData", TestUnpackPatternData());
+	result &= ReportTestResult("ReadPixelIndex", TestReadPixelIndex());
+	result &= ReportTestResult("SpriteTableEntry", TestSpriteTableEntry());
+	result &= ReportTestResult("DecodeSprite", TestDecodeSprite(vramData, &palette[0]));
+
+	// Verify and time the decode of the entire VRAM contents as a sheet of 8x8 tiles
+	const unsigned int tileCount = VDPDecoder::VramSize / (8 * VDPDecoder::PatternRowByteSize);
+	const unsigned int sheetWidth = TilesPerSheetRow * 8;
+	std::vector<VDPDecoder::RGBAColor> referenceSheet(tileCount * 8 * 8);
+	std::vector<VDPDecoder::RGBAColor> decodedSheet(tileCount * 8 * 8);
+	auto tileSheetDecode = [&]()
+	{
+		for (unsigned int tileNo = 0; tileNo < tileCount; ++tileNo)
+		{
+			unsigned int outputOffset = ((tileNo / TilesPerSheetRow) * 8 * sheetWidth) + ((tileNo % TilesPerSheetRow) * 8);
+			VDPDecoder::DecodePattern(&vramData[0], tileNo * 8 * VDPDecoder::PatternRowByteSize, 8, &palette[0], &decodedSheet[outputOffset], sheetWidth);
+		}
+	};
+	ReferenceDecodeTileSheet(vramData, &palette[0], referenceSheet);
+	tileSheetDecode();
+	result &= ReportTestResult("DecodePattern", CompareBuffers(referenceSheet, decodedSheet));
+
+	// Verify and time the decode of a full 64x64 cell scroll plane
+	const unsigned int planeWidth = 64;
+	const unsigned int planeHeight = 64;
+	const unsigned int regionWidth = planeWidth * 8;
+	const unsigned int regionHeight = planeHeight * 8;
+	std::vector<VDPDecoder::RGBAColor> referencePlane(regionWidth * regionHeight);
+	std::vector<VDPDecoder::RGBAColor> decodedPlane(regionWidth * regionHeight);
+	auto nameTableDecode = [&]()
+	{
+		VDPDecoder::DecodeNameTableRegion(&vramData[0], 0xC000, 0, planeWidth, planeHeight, false, 0, 0, regionWidth, regionHeight, &palette[0], backdropColor, &decodedPlane[0], regionWidth);
+	};
+	ReferenceDecodeNameTable(vramData, 0xC000, 0, planeWidth, planeHeight, regionWidth, regionHeight, &palette[0], backdropColor, referencePlane);
+	nameTableDecode();
+	result &= ReportTestResult("DecodeNameTableRegion", CompareBuffers(referencePlane, decodedPlane));
+
+	// Time each decode against the per-pixel reference implementation
+	std::cout << "Operation\tReference\tDecoder" << std::endl;
+	auto t0 = std::chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < TileSheetIterations; ++i)
+	{
+		ReferenceDecodeTileSheet(vramData, &palette[0], referenceSheet);
+	}
+	auto t1 = std::chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < TileSheetIterations; ++i)
+	{
+		tileSheetDecode();
+	}
+	auto t2 = std::chrono::high_resolution_clock::now();
+	std::chrono::duration<float> referenceDuration = t1 - t0;
+	std::chrono::duration<float> decoderDuration = t2 - t1;
+	std::cout << "TileSheet\t" << referenceDuration.count() << "\t" << decoderDuration.count() << " " << (int)((decoderDuration.count() / referenceDuration.count()) * 100) << "%" << std::endl;
+
+	t0 = std::chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < NameTableIterations; ++i)
+	{
+		ReferenceDecodeNameTable(vramData, 0xC000, 0, planeWidth, planeHeight, regionWidth, regionHeight, &palette[0], backdropColor, referencePlane);
+	}
+	t1 = std::chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < NameTableIterations; ++i)
+	{
+		nameTableDecode();
+	}
+	t2 = std::chrono::high_resolution_clock::now();
+	referenceDuration = t1 - t0;
+	decoderDuration = t2 - t1;
+	std::cout << "NameTable\t" << referenceDuration.count() << "\t" << decoderDuration.count() << " " << (int)((decoderDuration.count() / referenceDuration.count()) * 100) << "%" << std::endl;
+
+	return result? 0: 1;
+}
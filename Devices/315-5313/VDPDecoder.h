@@ -0,0 +1,58 @@
+/*--------------------------------------------------------------------------------------------------------------------*\
+Things to do:
+-Add a NEON version of the pattern unpack kernel for ARM targets
+-Consider adding support for decoding the Mode 4 pattern format used in SMS
+compatibility mode
+\*--------------------------------------------------------------------------------------------------------------------*/
+#ifndef __VDPDECODER_H__
+#define __VDPDECODER_H__
+#if defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)) || defined(__SSE2__)
+#define VDPDECODER_SSE2
+#include <emmintrin.h>
+#endif
+
+// This class decodes the pattern, name table, and sprite attribute table data used by the
+// 315-5313 VDP directly from a raw copy of VRAM. It has no dependencies on the device
+// itself or on any platform-specific code, so that the same decoding logic can be shared
+// between the VDP core and the debug views, and tested in isolation. All VRAM addresses
+// are wrapped to the VRAM size, and all buffers of VRAM data passed in must be VramSize
+// bytes in length.
+class VDPDecoder
+{
+public:
+	// Structures
+	struct RGBAColor;
+	struct SpriteTableEntry;
+
+	// Constants
+	static const unsigned int VramSize = 0x10000;
+	static const unsigned int CellPixelWidth = 8;
+	static const unsigned int PatternRowByteSize = 4;
+	static const unsigned int MappingByteSize = 2;
+	static const unsigned int SpriteTableEntryByteSize = 8;
+	static const unsigned int PaletteRowCount = 4;
+	static const unsigned int PaletteRowEntryCount = 16;
+
+public:
+	// Pattern decode functions
+	inline static unsigned int GetPatternRowCount(bool interlaceMode2Active);
+	inline static unsigned int ReadPixelIndex(unsigned int patternRow, bool horizontalFlip, unsigned int pixelIndex);
+	inline static unsigned int CalculatePatternRowNumber(unsigned int patternRowNumberNoFlip, bool interlaceMode2Active, unsigned int mappingData);
+	inline static unsigned int CalculatePatternRowAddress(unsigned int patternRowNumber, unsigned int patternCellOffset, bool interlaceMode2Active, unsigned int mappingData);
+	inline static void UnpackPatternData(const unsigned char* patternData, unsigned int byteCount, unsigned char* paletteIndices);
+	inline static void UnpackPatternRow(const unsigned char* vramData, unsigned int patternRowAddress, bool horizontalFlip, unsigned char* paletteIndices);
+
+	// Tile decode functions
+	inline static void DecodePattern(const unsigned char* vramData, unsigned int patternAddress, unsigned int patternRowCount, const RGBAColor* paletteRow, RGBAColor* outputBuffer, unsigned int outputStride);
+
+	// Name table decode functions
+	inline static void DecodeNameTableRegion(const unsigned char* vramData, unsigned int mappingBaseAddress, unsigned int patternBaseAddress, unsigned int planeWidth, unsigned int planeHeight, bool interlaceMode2Active, unsigned int regionPosX, unsigned int regionPosY, unsigned int regionWidth, unsigned int regionHeight, const RGBAColor* palette, const RGBAColor& backdropColor, RGBAColor* outputBuffer, unsigned int outputStride);
+
+	// Sprite table decode functions
+	inline static SpriteTableEntry DecodeSpriteTableEntry(unsigned int rawDataWord0, unsigned int rawDataWord1, unsigned int rawDataWord2, unsigned int rawDataWord3);
+	inline static SpriteTableEntry DecodeSpriteTableEntry(const unsigned char* vramData, unsigned int spriteTableBaseAddress, unsigned int entryNo);
+	inline static void DecodeSprite(const unsigned char* vramData, unsigned int patternBaseAddress, const SpriteTableEntry& entry, bool interlaceMode2Active, const RGBAColor* palette, unsigned int regionPosX, unsigned int regionPosY, unsigned int regionWidth, unsigned int regionHeight, RGBAColor* outputBuffer, unsigned int outputStride);
+};
+
+#include "VDPDecoder.inl"
+#endif
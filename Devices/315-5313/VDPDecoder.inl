@@ -0,0 +1,344 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Structures
+//----------------------------------------------------------------------------------------------------------------------
+struct VDPDecoder::RGBAColor
+{
+	RGBAColor()
+	:r(0), g(0), b(0), a(0xFF)
+	{ }
+	RGBAColor(unsigned char ar, unsigned char ag, unsigned char ab, unsigned char aa = 0xFF)
+	:r(ar), g(ag), b(ab), a(aa)
+	{ }
+
+	unsigned char r;
+	unsigned char g;
+	unsigned char b;
+	unsigned char a;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+struct VDPDecoder::SpriteTableEntry
+{
+	SpriteTableEntry()
+	:rawDataWord0(0), rawDataWord1(0), rawDataWord2(0), rawDataWord3(0)
+	{ }
+
+	unsigned int rawDataWord0;
+	unsigned int rawDataWord1;
+	unsigned int rawDataWord2;
+	unsigned int rawDataWord3;
+
+	unsigned int blockNumber;
+	unsigned int paletteLine;
+	unsigned int xpos;
+	unsigned int ypos;
+	unsigned int width;
+	unsigned int height;
+	unsigned int link;
+	bool priority;
+	bool vflip;
+	bool hflip;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Pattern decode functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int VDPDecoder::GetPatternRowCount(bool interlaceMode2Active)
+{
+	return (!interlaceMode2Active)? 8: 16;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int VDPDecoder::ReadPixelIndex(unsigned int patternRow, bool horizontalFlip, unsigned int pixelIndex)
+{
+	// Pattern data row format (no horizontal flip):
+	// ---------------------------------------------------------------------------------------------------------------------------------
+	// |31 |30 |29 |28 |27 |26 |25 |24 |23 |22 |21 |20 |19 |18 |17 |16 |15 |14 |13 |12 |11 |10 | 9 | 8 | 7 | 6 | 5 | 4 | 3 | 2 | 1 | 0 |
+	// |-------------------------------------------------------------------------------------------------------------------------------|
+	// |    Pixel 1    |    Pixel 2    |    Pixel 3    |    Pixel 4    |    Pixel 5    |    Pixel 6    |    Pixel 7    |    Pixel 8    |
+	// ---------------------------------------------------------------------------------------------------------------------------------
+	// When horizontal flip is active, the order of the pixels within the row is reversed.
+	static const unsigned int patternDataPixelEntryBitCount = 4;
+	unsigned int pixelShift = (!horizontalFlip)? ((CellPixelWidth - 1) - pixelIndex) * patternDataPixelEntryBitCount: pixelIndex * patternDataPixelEntryBitCount;
+	return (patternRow >> pixelShift) & 0x0F;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int VDPDecoder::CalculatePatternRowNumber(unsigned int patternRowNumberNoFlip, bool interlaceMode2Active, unsigned int mappingData)
+{
+	// Calculate the final number of the pattern row to read, taking into account vertical
+	// flip if it is specified in the block mapping.
+	// Mapping (Pattern Name) data format:
+	// -----------------------------------------------------------------
+	// |15 |14 |13 |12 |11 |10 | 9 | 8 | 7 | 6 | 5 | 4 | 3 | 2 | 1 | 0 |
+	// |---------------------------------------------------------------|
+	// |Pri|PalRow |VF |HF |              Pattern Number               |
+	// -----------------------------------------------------------------
+	unsigned int rowsPerTile = GetPatternRowCount(interlaceMode2Active);
+	return ((mappingData & 0x1000) != 0)? (rowsPerTile - 1) - patternRowNumberNoFlip: patternRowNumberNoFlip;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int VDPDecoder::CalculatePatternRowAddress(unsigned int patternRowNumber, unsigned int patternCellOffset, bool interlaceMode2Active, unsigned int mappingData)
+{
+	// The address of the pattern data to read is determined by combining the number of the
+	// pattern (tile) with the row of the pattern to be read. Patterns are 16 rows high
+	// under interlace mode 2, and 8 rows high otherwise. Note that we use the entire
+	// mapping data block as the block number, and rely on the resulting address being
+	// wrapped to keep it within the VRAM boundaries. See
+	// S315_5313::CalculatePatternDataRowAddress for more information.
+	unsigned int blockPatternByteSize = GetPatternRowCount(interlaceMode2Active) * PatternRowByteSize;
+	return (((mappingData + patternCellOffset) * blockPatternByteSize) + (patternRowNumber * PatternRowByteSize)) % VramSize;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Expands each byte of 4-bit packed pattern data into two palette index values, one per
+// byte, with the upper nibble of each source byte appearing first. The output buffer must
+// be twice the size of the input data.
+//----------------------------------------------------------------------------------------------------------------------
+void VDPDecoder::UnpackPatternData(const unsigned char* patternData, unsigned int byteCount, unsigned char* paletteIndices)
+{
+	unsigned int byteNo = 0;
+#ifdef VDPDECODER_SSE2
+	// Unpack 16 bytes of pattern data into 32 palette indices at a time. We split the
+	// upper and lower nibbles of each byte into separate registers, then interleave them
+	// back together so that each nibble ends up in its own byte.
+	const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+	while ((byteNo + 16) <= byteCount)
+	{
+		__m128i packedData = _mm_loadu_si128((const __m128i*)(patternData + byteNo));
+		__m128i upperNibbles = _mm_and_si128(_mm_srli_epi16(packedData, 4), nibbleMask);
+		__m128i lowerNibbles = _mm_and_si128(packedData, nibbleMask);
+		_mm_storeu_si128((__m128i*)(paletteIndices + (byteNo * 2)), _mm_unpacklo_epi8(upperNibbles, lowerNibbles));
+		_mm_storeu_si128((__m128i*)(paletteIndices + (byteNo * 2) + 16), _mm_unpackhi_epi8(upperNibbles, lowerNibbles));
+		byteNo += 16;
+	}
+#endif
+
+	// Unpack any remaining bytes of pattern data
+	while (byteNo < byteCount)
+	{
+		unsigned char packedData = patternData[byteNo];
+		paletteIndices[(byteNo * 2) + 0] = (unsigned char)(packedData >> 4);
+		paletteIndices[(byteNo * 2) + 1] = (unsigned char)(packedData & 0x0F);
+		++byteNo;
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void VDPDecoder::UnpackPatternRow(const unsigned char* vramData, unsigned int patternRowAddress, bool horizontalFlip, unsigned char* paletteIndices)
+{
+	for (unsigned int byteNo = 0; byteNo < PatternRowByteSize; ++byteNo)
+	{
+		unsigned char packedData = vramData[(patternRowAddress + byteNo) % VramSize];
+		unsigned char firstPixel = (unsigned char)(packedData >> 4);
+		unsigned char secondPixel = (unsigned char)(packedData & 0x0F);
+		if (!horizontalFlip)
+		{
+			paletteIndices[(byteNo * 2) + 0] = firstPixel;
+			paletteIndices[(byteNo * 2) + 1] = secondPixel;
+		}
+		else
+		{
+			paletteIndices[(CellPixelWidth - 1) - ((byteNo * 2) + 0)] = firstPixel;
+			paletteIndices[(CellPixelWidth - 1) - ((byteNo * 2) + 1)] = secondPixel;
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Tile decode functions
+//----------------------------------------------------------------------------------------------------------------------
+void VDPDecoder::DecodePattern(const unsigned char* vramData, unsigned int patternAddress, unsigned int patternRowCount, const RGBAColor* paletteRow, RGBAColor* outputBuffer, unsigned int outputStride)
+{
+	// Unpack the palette indices for the entire pattern. If the pattern data doesn't wrap
+	// around the end of VRAM, we can unpack it in a single pass.
+	static const unsigned int maxPatternRowCount = 16;
+	unsigned char paletteIndices[maxPatternRowCount * CellPixelWidth];
+	patternRowCount = (patternRowCount > maxPatternRowCount)? maxPatternRowCount: patternRowCount;
+	patternAddress %= VramSize;
+	unsigned int patternByteSize = patternRowCount * PatternRowByteSize;
+	if ((patternAddress + patternByteSize) <= VramSize)
+	{
+		UnpackPatternData(vramData + patternAddress, patternByteSize, &paletteIndices[0]);
+	}
+	else
+	{
+		for (unsigned int rowNo = 0; rowNo < patternRowCount; ++rowNo)
+		{
+			UnpackPatternRow(vramData, patternAddress + (rowNo * PatternRowByteSize), false, &paletteIndices[rowNo * CellPixelWidth]);
+		}
+	}
+
+	// Convert each palette index into its corresponding colour
+	for (unsigned int rowNo = 0; rowNo < patternRowCount; ++rowNo)
+	{
+		RGBAColor* outputRow = outputBuffer + (rowNo * outputStride);
+		const unsigned char* paletteIndexRow = &paletteIndices[rowNo * CellPixelWidth];
+		for (unsigned int pixelNo = 0; pixelNo < CellPixelWidth; ++pixelNo)
+		{
+			outputRow[pixelNo] = paletteRow[paletteIndexRow[pixelNo]];
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Name table decode functions
+//----------------------------------------------------------------------------------------------------------------------
+// Decodes a rectangular region of a scroll plane into colour values. The region position
+// is specified in pixels from the top left corner of the plane, and wraps around the edges
+// of the plane in both directions. The palette must contain all 64 colour entries, and the
+// backdrop colour is used for all transparent pixels.
+//----------------------------------------------------------------------------------------------------------------------
+void VDPDecoder::DecodeNameTableRegion(const unsigned char* vramData, unsigned int mappingBaseAddress, unsigned int patternBaseAddress, unsigned int planeWidth, unsigned int planeHeight, bool interlaceMode2Active, unsigned int regionPosX, unsigned int regionPosY, unsigned int regionWidth, unsigned int regionHeight, const RGBAColor* palette, const RGBAColor& backdropColor, RGBAColor* outputBuffer, unsigned int outputStride)
+{
+	// Ensure the plane dimensions are valid
+	if ((planeWidth <= 0) || (planeHeight <= 0))
+	{
+		return;
+	}
+
+	unsigned int patternRowCount = GetPatternRowCount(interlaceMode2Active);
+	for (unsigned int ypos = 0; ypos < regionHeight; ++ypos)
+	{
+		// Calculate the row of mappings to decode for this line
+		unsigned int layerPixelPosY = regionPosY + ypos;
+		unsigned int mappingRowNo = (layerPixelPosY / patternRowCount) % planeHeight;
+		unsigned int patternRowNumberNoFlip = layerPixelPosY % patternRowCount;
+		RGBAColor* outputRow = outputBuffer + (ypos * outputStride);
+
+		// Decode each cell which intersects this line of the region
+		unsigned int xpos = 0;
+		while (xpos < regionWidth)
+		{
+			// Read the mapping data for the target cell
+			unsigned int layerPixelPosX = regionPosX + xpos;
+			unsigned int mappingColumnNo = (layerPixelPosX / CellPixelWidth) % planeWidth;
+			unsigned int mappingAddress = mappingBaseAddress + (((mappingRowNo * planeWidth) + mappingColumnNo) * MappingByteSize);
+			unsigned int mappingData = ((unsigned int)vramData[mappingAddress % VramSize] << 8) | (unsigned int)vramData[(mappingAddress + 1) % VramSize];
+
+			// Unpack the target row of pattern data for this cell
+			unsigned int patternRowNumber = CalculatePatternRowNumber(patternRowNumberNoFlip, interlaceMode2Active, mappingData);
+			unsigned int patternRowAddress = patternBaseAddress + CalculatePatternRowAddress(patternRowNumber, 0, interlaceMode2Active, mappingData);
+			unsigned char paletteIndices[CellPixelWidth];
+			UnpackPatternRow(vramData, patternRowAddress, (mappingData & 0x0800) != 0, &paletteIndices[0]);
+
+			// Output the colour for each pixel in this cell which lies within the region
+			const RGBAColor* paletteRow = palette + (((mappingData >> 13) & 0x03) * PaletteRowEntryCount);
+			unsigned int pixelNo = layerPixelPosX % CellPixelWidth;
+			while ((pixelNo < CellPixelWidth) && (xpos < regionWidth))
+			{
+				unsigned int paletteIndex = paletteIndices[pixelNo++];
+				outputRow[xpos++] = (paletteIndex == 0)? backdropColor: paletteRow[paletteIndex];
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Sprite table decode functions
+//----------------------------------------------------------------------------------------------------------------------
+VDPDecoder::SpriteTableEntry VDPDecoder::DecodeSpriteTableEntry(unsigned int rawDataWord0, unsigned int rawDataWord1, unsigned int rawDataWord2, unsigned int rawDataWord3)
+{
+	// Decode the sprite mapping data
+	//        -----------------------------------------------------------------
+	//        |15 |14 |13 |12 |11 |10 | 9 | 8 | 7 | 6 | 5 | 4 | 3 | 2 | 1 | 0 |
+	// Word0  |---------------------------------------------------------------|
+	//        |                          Vertical Pos                         |
+	//        -----------------------------------------------------------------
+	//        -----------------------------------------------------------------
+	//        |15 |14 |13 |12 |11 |10 | 9 | 8 | 7 | 6 | 5 | 4 | 3 | 2 | 1 | 0 |
+	// Word1  |---------------------------------------------------------------|
+	//        | /   /   /   / | HSize | VSize | / |         Link Data         |
+	//        -----------------------------------------------------------------
+	//        -----------------------------------------------------------------
+	//        |15 |14 |13 |12 |11 |10 | 9 | 8 | 7 | 6 | 5 | 4 | 3 | 2 | 1 | 0 |
+	// Word2  |---------------------------------------------------------------|
+	//        |Pri|PalRow |VF |HF |              Pattern Number               |
+	//        -----------------------------------------------------------------
+	//        -----------------------------------------------------------------
+	//        |15 |14 |13 |12 |11 |10 | 9 | 8 | 7 | 6 | 5 | 4 | 3 | 2 | 1 | 0 |
+	// Word3  |---------------------------------------------------------------|
+	//        |                         Horizontal Pos                        |
+	//        -----------------------------------------------------------------
+	SpriteTableEntry entry;
+	entry.rawDataWord0 = rawDataWord0 & 0xFFFF;
+	entry.rawDataWord1 = rawDataWord1 & 0xFFFF;
+	entry.rawDataWord2 = rawDataWord2 & 0xFFFF;
+	entry.rawDataWord3 = rawDataWord3 & 0xFFFF;
+	entry.ypos = entry.rawDataWord0;
+	entry.width = (entry.rawDataWord1 >> 10) & 0x03;
+	entry.height = (entry.rawDataWord1 >> 8) & 0x03;
+	entry.link = entry.rawDataWord1 & 0x7F;
+	entry.priority = (entry.rawDataWord2 & 0x8000) != 0;
+	entry.paletteLine = (entry.rawDataWord2 >> 13) & 0x03;
+	entry.vflip = (entry.rawDataWord2 & 0x1000) != 0;
+	entry.hflip = (entry.rawDataWord2 & 0x0800) != 0;
+	entry.blockNumber = entry.rawDataWord2 & 0x07FF;
+	entry.xpos = entry.rawDataWord3;
+	return entry;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+VDPDecoder::SpriteTableEntry VDPDecoder::DecodeSpriteTableEntry(const unsigned char* vramData, unsigned int spriteTableBaseAddress, unsigned int entryNo)
+{
+	unsigned int entryAddress = spriteTableBaseAddress + (entryNo * SpriteTableEntryByteSize);
+	unsigned int rawDataWords[4];
+	for (unsigned int wordNo = 0; wordNo < 4; ++wordNo)
+	{
+		unsigned int wordAddress = entryAddress + (wordNo * 2);
+		rawDataWords[wordNo] = ((unsigned int)vramData[wordAddress % VramSize] << 8) | (unsigned int)vramData[(wordAddress + 1) % VramSize];
+	}
+	return DecodeSpriteTableEntry(rawDataWords[0], rawDataWords[1], rawDataWords[2], rawDataWords[3]);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Draws the non-transparent pixels of a sprite into a region of the sprite plane. The
+// region position is specified in pixels from the top left corner of the sprite plane,
+// using the same coordinate system as the raw sprite position data.
+//----------------------------------------------------------------------------------------------------------------------
+void VDPDecoder::DecodeSprite(const unsigned char* vramData, unsigned int patternBaseAddress, const SpriteTableEntry& entry, bool interlaceMode2Active, const RGBAColor* palette, unsigned int regionPosX, unsigned int regionPosY, unsigned int regionWidth, unsigned int regionHeight, RGBAColor* outputBuffer, unsigned int outputStride)
+{
+	unsigned int patternRowCount = GetPatternRowCount(interlaceMode2Active);
+	unsigned int spriteHeightInCells = entry.height + 1;
+	unsigned int spriteWidthInCells = entry.width + 1;
+	unsigned int spriteHeightInPixels = spriteHeightInCells * patternRowCount;
+	const RGBAColor* paletteRow = palette + (entry.paletteLine * PaletteRowEntryCount);
+	for (unsigned int ypos = 0; ypos < spriteHeightInPixels; ++ypos)
+	{
+		// If this line of the sprite lies outside the region, skip it.
+		unsigned int layerPixelPosY = entry.ypos + ypos;
+		if ((layerPixelPosY < regionPosY) || (layerPixelPosY >= (regionPosY + regionHeight)))
+		{
+			continue;
+		}
+		RGBAColor* outputRow = outputBuffer + ((layerPixelPosY - regionPosY) * outputStride);
+
+		// Calculate the target pixel row within the sprite. Note that sprite cells are
+		// arranged in column-major order.
+		unsigned int pixelRowNo = (entry.vflip)? (spriteHeightInPixels - 1) - ypos: ypos;
+		unsigned int blockRowNo = pixelRowNo / patternRowCount;
+		unsigned int patternRowNo = pixelRowNo % patternRowCount;
+		for (unsigned int cellNo = 0; cellNo < spriteWidthInCells; ++cellNo)
+		{
+			// Unpack the target row of pattern data for this cell
+			unsigned int blockColumnNo = (entry.hflip)? (spriteWidthInCells - 1) - cellNo: cellNo;
+			unsigned int blockOffset = (blockColumnNo * spriteHeightInCells) + blockRowNo;
+			unsigned int patternRowAddress = patternBaseAddress + CalculatePatternRowAddress(patternRowNo, blockOffset, interlaceMode2Active, entry.blockNumber);
+			unsigned char paletteIndices[CellPixelWidth];
+			UnpackPatternRow(vramData, patternRowAddress, entry.hflip, &paletteIndices[0]);
+
+			// Output each visible non-transparent pixel in this cell
+			for (unsigned int pixelNo = 0; pixelNo < CellPixelWidth; ++pixelNo)
+			{
+				unsigned int layerPixelPosX = entry.xpos + (cellNo * CellPixelWidth) + pixelNo;
+				unsigned int paletteIndex = paletteIndices[pixelNo];
+				if ((paletteIndex == 0) || (layerPixelPosX < regionPosX) || (layerPixelPosX >= (regionPosX + regionWidth)))
+				{
+					continue;
+				}
+				outputRow[layerPixelPosX - regionPosX] = paletteRow[paletteIndex];
+			}
+		}
+	}
+}
@@ -0,0 +1,25 @@
+#ifndef __IROMMEMORY_H__
+#define __IROMMEMORY_H__
+
+class IROMMemory
+{
+public:
+	// Structures
+	struct DataStoreStatistics;
+
+public:
+	// Constructors
+	inline virtual ~IROMMemory() = 0;
+
+	// Interface version functions
+	static inline unsigned int ThisIROMMemoryVersion() { return 1; }
+	virtual unsigned int GetIROMMemoryVersion() const = 0;
+
+	// Shared data functions
+	virtual bool IsROMDataShared() const = 0;
+	virtual void GetROMDataStoreStatistics(DataStoreStatistics& statistics) const = 0;
+};
+IROMMemory::~IROMMemory() { }
+
+#include "IROMMemory.inl"
+#endif
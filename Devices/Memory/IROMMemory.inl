@@ -0,0 +1,23 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Structures
+//----------------------------------------------------------------------------------------------------------------------
+struct IROMMemory::DataStoreStatistics
+{
+	DataStoreStatistics()
+	:blockCount(0), residentBytes(0), referencedBytes(0), bytesShared(0), bytesCopied(0), bytesCopiedOnWrite(0)
+	{ }
+
+	// The number of unique data blocks currently held, and their total size in bytes
+	unsigned int blockCount;
+	unsigned long long residentBytes;
+
+	// The total size in bytes of all data currently referenced by ROM devices. The
+	// difference between this and the resident byte count is the memory saved by sharing.
+	unsigned long long referencedBytes;
+
+	// Running totals of bytes satisfied by an existing block, bytes copied into a new
+	// block, and bytes copied out to private arrays when a device modified its data.
+	unsigned long long bytesShared;
+	unsigned long long bytesCopied;
+	unsigned long long bytesCopiedOnWrite;
+};
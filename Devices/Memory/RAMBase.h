@@ -22,6 +22,7 @@ public:
 	// Execute functions
 	virtual void ExecuteRollback();
 	virtual void ExecuteCommit();
+	virtual bool UsesParallelCommit() const;
 
 	// Memory locking functions
 	virtual bool IsMemoryLockingSupported() const;
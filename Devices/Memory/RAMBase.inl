@@ -188,6 +188,15 @@ void RAMBase<T>::ExecuteCommit()
 	_buffer.clear();
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+bool RAMBase<T>::UsesParallelCommit() const
+{
+	// Our commit and rollback operations only touch our own rollback buffer and memory
+	// array, so we can safely be committed in parallel with other devices.
+	return true;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Memory locking functions
 //----------------------------------------------------------------------------------------------------------------------
@@ -31,6 +31,7 @@ void ROM16::TransparentReadInterface(unsigned int interfaceNumber, unsigned int
 //----------------------------------------------------------------------------------------------------------------------
 void ROM16::TransparentWriteInterface(unsigned int interfaceNumber, unsigned int location, const Data& data, IDeviceContext* caller, unsigned int accessContext)
 {
+	EnsureMemoryArrayWritable();
 	_memoryArray[LimitLocationToMemorySize(location)] = (unsigned short)data.GetData();
 }
 
@@ -45,5 +46,6 @@ unsigned int ROM16::ReadMemoryEntry(unsigned int location) const
 //----------------------------------------------------------------------------------------------------------------------
 void ROM16::WriteMemoryEntry(unsigned int location, unsigned int data)
 {
+	EnsureMemoryArrayWritable();
 	_memoryArray[LimitLocationToMemorySize(location)] = (unsigned short)data;
 }
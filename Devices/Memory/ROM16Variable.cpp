@@ -62,6 +62,7 @@ void ROM16Variable::TransparentReadInterface(unsigned int interfaceNumber, unsig
 //----------------------------------------------------------------------------------------------------------------------
 void ROM16Variable::TransparentWriteInterface(unsigned int interfaceNumber, unsigned int location, const Data& data, IDeviceContext* caller, unsigned int accessContext)
 {
+	EnsureMemoryArrayWritable();
 	static const unsigned int arrayEntryByteSize = 2;
 	switch (interfaceNumber)
 	{
@@ -110,5 +111,6 @@ unsigned int ROM16Variable::ReadMemoryEntry(unsigned int location) const
 //----------------------------------------------------------------------------------------------------------------------
 void ROM16Variable::WriteMemoryEntry(unsigned int location, unsigned int data)
 {
+	EnsureMemoryArrayWritable();
 	_memoryArray[LimitLocationToMemorySize(location)] = (unsigned short)data;
 }
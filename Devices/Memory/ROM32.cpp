@@ -31,6 +31,7 @@ void ROM32::TransparentReadInterface(unsigned int interfaceNumber, unsigned int
 //----------------------------------------------------------------------------------------------------------------------
 void ROM32::TransparentWriteInterface(unsigned int interfaceNumber, unsigned int location, const Data& data, IDeviceContext* caller, unsigned int accessContext)
 {
+	EnsureMemoryArrayWritable();
 	_memoryArray[LimitLocationToMemorySize(location)] = (unsigned int)data.GetData();
 }
 
@@ -45,5 +46,6 @@ unsigned int ROM32::ReadMemoryEntry(unsigned int location) const
 //----------------------------------------------------------------------------------------------------------------------
 void ROM32::WriteMemoryEntry(unsigned int location, unsigned int data)
 {
+	EnsureMemoryArrayWritable();
 	_memoryArray[LimitLocationToMemorySize(location)] = data;
 }
@@ -59,6 +59,7 @@ void ROM32Variable::TransparentReadInterface(unsigned int interfaceNumber, unsig
 //----------------------------------------------------------------------------------------------------------------------
 void ROM32Variable::TransparentWriteInterface(unsigned int interfaceNumber, unsigned int location, const Data& data, IDeviceContext* caller, unsigned int accessContext)
 {
+	EnsureMemoryArrayWritable();
 	static const unsigned int arrayEntryByteSize = 4;
 	switch (interfaceNumber)
 	{
@@ -103,5 +104,6 @@ unsigned int ROM32Variable::ReadMemoryEntry(unsigned int location) const
 //----------------------------------------------------------------------------------------------------------------------
 void ROM32Variable::WriteMemoryEntry(unsigned int location, unsigned int data)
 {
+	EnsureMemoryArrayWritable();
 	_memoryArray[LimitLocationToMemorySize(location)] = data;
 }
@@ -31,6 +31,7 @@ void ROM8::TransparentReadInterface(unsigned int interfaceNumber, unsigned int l
 //----------------------------------------------------------------------------------------------------------------------
 void ROM8::TransparentWriteInterface(unsigned int interfaceNumber, unsigned int location, const Data& data, IDeviceContext* caller, unsigned int accessContext)
 {
+	EnsureMemoryArrayWritable();
 	_memoryArray[LimitLocationToMemorySize(location)] = (unsigned char)data.GetData();
 }
 
@@ -45,5 +46,6 @@ unsigned int ROM8::ReadMemoryEntry(unsigned int location) const
 //----------------------------------------------------------------------------------------------------------------------
 void ROM8::WriteMemoryEntry(unsigned int location, unsigned int data)
 {
+	EnsureMemoryArrayWritable();
 	_memoryArray[LimitLocationToMemorySize(location)] = (unsigned char)data;
 }
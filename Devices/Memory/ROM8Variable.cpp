@@ -53,6 +53,7 @@ void ROM8Variable::TransparentReadInterface(unsigned int interfaceNumber, unsign
 //----------------------------------------------------------------------------------------------------------------------
 void ROM8Variable::TransparentWriteInterface(unsigned int interfaceNumber, unsigned int location, const Data& data, IDeviceContext* caller, unsigned int accessContext)
 {
+	EnsureMemoryArrayWritable();
 	static const unsigned int arrayEntryByteSize = 1;
 	switch (interfaceNumber)
 	{
@@ -93,5 +94,6 @@ unsigned int ROM8Variable::ReadMemoryEntry(unsigned int location) const
 //----------------------------------------------------------------------------------------------------------------------
 void ROM8Variable::WriteMemoryEntry(unsigned int location, unsigned int data)
 {
+	EnsureMemoryArrayWritable();
 	_memoryArray[LimitLocationToMemorySize(location)] = (unsigned char)data;
 }
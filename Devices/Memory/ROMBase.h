@@ -1,34 +1,62 @@
 #ifndef __ROMBASE_H__
 #define __ROMBASE_H__
 #include "MemoryRead.h"
+#include "IROMMemory.h"
+#include "ROMDataStore.h"
 
 template<class T>
-class ROMBase :public MemoryRead
+class ROMBase :public MemoryRead, public IROMMemory
 {
 public:
 	// Constructors
 	inline ROMBase(const std::wstring& implementationName, const std::wstring& instanceName, unsigned int moduleID);
 	virtual ~ROMBase();
 
+	// Interface version functions
+	virtual unsigned int GetIROMMemoryVersion() const;
+
 	// Initialization functions
 	virtual bool Construct(IHierarchicalStorageNode& node);
 
 	// Memory size functions
 	virtual unsigned int GetMemoryEntrySizeInBytes() const;
 
+	// Block memory functions
+	virtual void TransparentWriteInterfaceBlock(unsigned int interfaceNumber, unsigned int location, const Marshal::In<std::vector<unsigned int>>& data, unsigned int dataBitCount, IDeviceContext* caller, unsigned int accessContext);
+
+	// Shared data functions
+	virtual bool IsROMDataShared() const;
+	virtual void GetROMDataStoreStatistics(DataStoreStatistics& statistics) const;
+
 protected:
 	// Memory location functions
 	inline unsigned int LimitLocationToMemorySize(unsigned int location) const;
 
+	// Shared data functions
+	inline void EnsureMemoryArrayWritable();
+
 private:
+	// Shared data functions
+	void ShareMemoryArray();
+	void CopySharedMemoryArray();
+	void ReleasePrivateMemoryArray();
+	void ReleaseRetiredMemoryArrays();
+	void ReleaseMemoryArray();
+
 	// Memory location functions
 	unsigned int LimitMemoryLocationToMemorySizePowerOfTwo(unsigned int location) const;
 	unsigned int LimitMemoryLocationToMemorySizeNonPowerOfTwo(unsigned int location) const;
 
 protected:
+	// Note that when our data is being shared through the ROM data store, this array
+	// refers to read-only memory. Derived classes must call EnsureMemoryArrayWritable
+	// before modifying the contents of this array.
 	T* _memoryArray;
 
 private:
+	const T* _sharedMemoryArray;
+	std::vector<T*> _retiredMemoryArrays;
+	std::vector<const T*> _retiredSharedMemoryArrays;
 	unsigned int _memoryArraySize;
 	unsigned int _memoryArraySizeMask;
 	unsigned int (ROMBase::*_memoryLimitFunction)(unsigned int) const;
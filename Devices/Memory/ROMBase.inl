@@ -3,14 +3,23 @@
 //----------------------------------------------------------------------------------------------------------------------
 template<class T>
 ROMBase<T>::ROMBase(const std::wstring& implementationName, const std::wstring& instanceName, unsigned int moduleID)
-:MemoryRead(implementationName, instanceName, moduleID), _memoryArraySize(0), _memoryArray(0)
+:MemoryRead(implementationName, instanceName, moduleID), _memoryArraySize(0), _memoryArray(0), _sharedMemoryArray(0)
 { }
 
 //----------------------------------------------------------------------------------------------------------------------
 template<class T>
 ROMBase<T>::~ROMBase()
 {
-	delete _memoryArray;
+	ReleaseMemoryArray();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Interface version functions
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+unsigned int ROMBase<T>::GetIROMMemoryVersion() const
+{
+	return ThisIROMMemoryVersion();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -21,6 +30,10 @@ bool ROMBase<T>::Construct(IHierarchicalStorageNode& node)
 {
 	bool result = MemoryRead::Construct(node);
 
+	// Release any memory arrays we retired while our previous data was in use. Nothing
+	// can be reading through them while we're being reconstructed.
+	ReleaseRetiredMemoryArrays();
+
 	// Obtain the size in bytes of a single entry in the memory array
 	unsigned int memoryArrayEntryByteSize = (unsigned int)sizeof(T);
 
@@ -75,7 +88,7 @@ bool ROMBase<T>::Construct(IHierarchicalStorageNode& node)
 
 		// Resize the internal memory array based on the calculated array size, and
 		// initialize all elements to 0.
-		delete _memoryArray;
+		ReleasePrivateMemoryArray();
 		_memoryArray = new T[_memoryArraySize];
 		memset(&_memoryArray[0], 0, (_memoryArraySize * memoryArrayEntryByteSize));
 
@@ -131,6 +144,10 @@ bool ROMBase<T>::Construct(IHierarchicalStorageNode& node)
 				_memoryArray[i] = _memoryArray[originalDataIndex];
 			}
 		}
+
+		// Now that our data has been fully decoded, replace our private copy with a
+		// reference to the shared copy held in the ROM data store.
+		ShareMemoryArray();
 	}
 	else
 	{
@@ -149,9 +166,10 @@ bool ROMBase<T>::Construct(IHierarchicalStorageNode& node)
 
 		// Resize the internal memory array based on the calculated array size, and
 		// initialize all elements to 0.
-		delete _memoryArray;
+		ReleasePrivateMemoryArray();
 		_memoryArray = new T[_memoryArraySize];
 		memset(&_memoryArray[0], 0, (_memoryArraySize * memoryArrayEntryByteSize));
+		ShareMemoryArray();
 	}
 
 	return result;
@@ -166,6 +184,160 @@ unsigned int ROMBase<T>::GetMemoryEntrySizeInBytes() const
 	return sizeof(T);
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Block memory functions
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+void ROMBase<T>::TransparentWriteInterfaceBlock(unsigned int interfaceNumber, unsigned int location, const Marshal::In<std::vector<unsigned int>>& data, unsigned int dataBitCount, IDeviceContext* caller, unsigned int accessContext)
+{
+	// If our memory array hasn't been constructed, there's nothing to write to
+	if (_memoryArray == 0)
+	{
+		return;
+	}
+
+	// Apply all the supplied data to a private copy of our memory array, then submit the
+	// final result to the ROM data store as a whole. This allows a complete ROM image to
+	// be replaced, such as when embedded ROM data is reloaded, while still sharing the
+	// new data with any other devices holding the same image. Each entry is still written
+	// through the transparent write function, so the data is decoded exactly as it would
+	// be for a single write.
+	EnsureMemoryArrayWritable();
+	MemoryRead::TransparentWriteInterfaceBlock(interfaceNumber, location, data, dataBitCount, caller, accessContext);
+	ShareMemoryArray();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Shared data functions
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+bool ROMBase<T>::IsROMDataShared() const
+{
+	return (_sharedMemoryArray != 0) && (_memoryArray == _sharedMemoryArray);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+void ROMBase<T>::GetROMDataStoreStatistics(DataStoreStatistics& statistics) const
+{
+	statistics = ROMDataStore::GetInstance().GetStatistics();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+void ROMBase<T>::EnsureMemoryArrayWritable()
+{
+	if ((_sharedMemoryArray != 0) && (_memoryArray == _sharedMemoryArray))
+	{
+		CopySharedMemoryArray();
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+void ROMBase<T>::ShareMemoryArray()
+{
+	// Submit our decoded data to the ROM data store. If another ROM device already holds
+	// identical data, we'll be given a reference to its block. Note that our memory array
+	// must be a private copy at this point. Any block we were sharing previously is only
+	// released after the new block has been acquired, so that when identical data is
+	// loaded again, such as when the same cartridge is reloaded, we pick up the existing
+	// block rather than freeing it and immediately allocating it again. If the store
+	// fails to allocate a block, we simply retain our private copy. Note that other
+	// threads, such as the debugger, may still be reading through our old memory array
+	// pointer, so neither our private copy nor the previous shared block are freed here.
+	// They're retired instead, and released when this device is reconstructed or
+	// destroyed.
+	size_t memoryArrayByteSize = (size_t)_memoryArraySize * sizeof(T);
+	bool sharedWithExistingBlock;
+	ROMDataStore& dataStore = ROMDataStore::GetInstance();
+	const T* previousSharedMemoryArray = _sharedMemoryArray;
+	const T* sharedMemoryArray = (const T*)dataStore.AcquireDataBlock(_memoryArray, memoryArrayByteSize, sharedWithExistingBlock);
+	_sharedMemoryArray = sharedMemoryArray;
+	if (sharedMemoryArray != 0)
+	{
+		_retiredMemoryArrays.push_back(_memoryArray);
+		_memoryArray = const_cast<T*>(sharedMemoryArray);
+	}
+	if (previousSharedMemoryArray != 0)
+	{
+		_retiredSharedMemoryArrays.push_back(previousSharedMemoryArray);
+	}
+	if (sharedMemoryArray == 0)
+	{
+		return;
+	}
+
+	// Log the fact that this ROM device is now sharing its data, along with the overall
+	// savings achieved by the data store.
+	if (sharedWithExistingBlock)
+	{
+		ROMDataStore::Statistics statistics = dataStore.GetStatistics();
+		LogEntry logEntry(LogEntry::EventLevel::Info);
+		logEntry << L"ROM data shared with an existing instance (" << memoryArrayByteSize << L" bytes). ROM data store now holds " << statistics.residentBytes << L" bytes for " << statistics.referencedBytes << L" bytes referenced.";
+		GetDeviceContext()->WriteLogEvent(logEntry);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+void ROMBase<T>::CopySharedMemoryArray()
+{
+	// Take a private copy of our shared data so that it can be modified. Note that we
+	// retain our reference to the shared block until this device is destroyed or
+	// reconstructed, since other threads may still be reading through the old pointer.
+	// The ROM data store only publishes our copy if our memory array still refers to the
+	// shared block, so if another thread published its own copy first, we discard ours.
+	size_t memoryArrayByteSize = (size_t)_memoryArraySize * sizeof(T);
+	T* memoryArray = new T[_memoryArraySize];
+	memcpy(&memoryArray[0], _sharedMemoryArray, memoryArrayByteSize);
+	if (!ROMDataStore::GetInstance().PublishPrivateCopy((void**)&_memoryArray, _sharedMemoryArray, memoryArray, memoryArrayByteSize))
+	{
+		delete[] memoryArray;
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+void ROMBase<T>::ReleasePrivateMemoryArray()
+{
+	if (_memoryArray != _sharedMemoryArray)
+	{
+		delete[] _memoryArray;
+	}
+	_memoryArray = 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+void ROMBase<T>::ReleaseRetiredMemoryArrays()
+{
+	for (unsigned int i = 0; i < (unsigned int)_retiredMemoryArrays.size(); ++i)
+	{
+		delete[] _retiredMemoryArrays[i];
+	}
+	_retiredMemoryArrays.clear();
+	ROMDataStore& dataStore = ROMDataStore::GetInstance();
+	for (unsigned int i = 0; i < (unsigned int)_retiredSharedMemoryArrays.size(); ++i)
+	{
+		dataStore.ReleaseDataBlock(_retiredSharedMemoryArrays[i]);
+	}
+	_retiredSharedMemoryArrays.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class T>
+void ROMBase<T>::ReleaseMemoryArray()
+{
+	ReleasePrivateMemoryArray();
+	ReleaseRetiredMemoryArrays();
+	if (_sharedMemoryArray != 0)
+	{
+		ROMDataStore::GetInstance().ReleaseDataBlock(_sharedMemoryArray);
+		_sharedMemoryArray = 0;
+	}
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Memory location functions
 //----------------------------------------------------------------------------------------------------------------------
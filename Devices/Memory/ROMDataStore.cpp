@@ -0,0 +1,188 @@
+#include "ROMDataStore.h"
+#include <windows.h>
+#include <cstring>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+ROMDataStore::ROMDataStore()
+:_bytesShared(0), _bytesCopied(0), _bytesCopiedOnWrite(0)
+{ }
+
+//----------------------------------------------------------------------------------------------------------------------
+ROMDataStore::~ROMDataStore()
+{
+	// Free any blocks which are still outstanding. This should only occur if a ROM device
+	// failed to release its data before the module was unloaded.
+	for (std::map<const void*, DataBlock*>::iterator i = _dataBlocksByAddress.begin(); i != _dataBlocksByAddress.end(); ++i)
+	{
+		FreeBlockMemory(i->second->data);
+		delete i->second;
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Instance functions
+//----------------------------------------------------------------------------------------------------------------------
+ROMDataStore& ROMDataStore::GetInstance()
+{
+	static ROMDataStore instance;
+	return instance;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Data block functions
+//----------------------------------------------------------------------------------------------------------------------
+const void* ROMDataStore::AcquireDataBlock(const void* data, size_t byteSize, bool& sharedWithExistingBlock)
+{
+	// Hash the supplied data outside the lock, since this is the expensive part of the
+	// lookup for large ROM images.
+	unsigned long long hash = CalculateDataHash(data, byteSize);
+	std::unique_lock<std::mutex> lock(_accessMutex);
+
+	// If an identical block is already held, add a reference to it and return it. We
+	// verify the contents of any block with a matching hash before sharing it, so a hash
+	// collision can never cause a device to see the wrong data.
+	std::pair<std::multimap<unsigned long long, DataBlock*>::iterator, std::multimap<unsigned long long, DataBlock*>::iterator> matchingBlocks = _dataBlocksByHash.equal_range(hash);
+	for (std::multimap<unsigned long long, DataBlock*>::iterator i = matchingBlocks.first; i != matchingBlocks.second; ++i)
+	{
+		DataBlock& dataBlock = *i->second;
+		if ((dataBlock.byteSize == byteSize) && (memcmp(dataBlock.data, data, byteSize) == 0))
+		{
+			++dataBlock.referenceCount;
+			_bytesShared += byteSize;
+			sharedWithExistingBlock = true;
+			return dataBlock.data;
+		}
+	}
+
+	// Copy the data into a new read-only block and add it to the store
+	void* blockMemory = AllocateBlockMemory(data, byteSize);
+	if (blockMemory == 0)
+	{
+		return 0;
+	}
+	DataBlock* dataBlock = new DataBlock(blockMemory, byteSize, hash);
+	_dataBlocksByHash.insert(std::pair<unsigned long long, DataBlock*>(hash, dataBlock));
+	_dataBlocksByAddress.insert(std::pair<const void*, DataBlock*>(blockMemory, dataBlock));
+	_bytesCopied += byteSize;
+	sharedWithExistingBlock = false;
+	return blockMemory;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ROMDataStore::ReleaseDataBlock(const void* dataBlock)
+{
+	std::unique_lock<std::mutex> lock(_accessMutex);
+	std::map<const void*, DataBlock*>::iterator dataBlockIterator = _dataBlocksByAddress.find(dataBlock);
+	if (dataBlockIterator == _dataBlocksByAddress.end())
+	{
+		return;
+	}
+
+	// Decrement the reference count for the block, and free it if this was the last
+	// reference.
+	DataBlock* dataBlockEntry = dataBlockIterator->second;
+	if (--dataBlockEntry->referenceCount > 0)
+	{
+		return;
+	}
+	std::pair<std::multimap<unsigned long long, DataBlock*>::iterator, std::multimap<unsigned long long, DataBlock*>::iterator> matchingBlocks = _dataBlocksByHash.equal_range(dataBlockEntry->hash);
+	for (std::multimap<unsigned long long, DataBlock*>::iterator i = matchingBlocks.first; i != matchingBlocks.second; ++i)
+	{
+		if (i->second == dataBlockEntry)
+		{
+			_dataBlocksByHash.erase(i);
+			break;
+		}
+	}
+	_dataBlocksByAddress.erase(dataBlockIterator);
+	FreeBlockMemory(dataBlockEntry->data);
+	delete dataBlockEntry;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Private copy functions
+//----------------------------------------------------------------------------------------------------------------------
+bool ROMDataStore::PublishPrivateCopy(void** memoryArray, const void* dataBlock, void* privateCopy, size_t byteSize)
+{
+	// Replace the caller's reference to the shared data block with their private copy,
+	// provided the reference still refers to the shared block. Two threads may attempt to
+	// modify the same ROM device at once, such as a debugger write during an embedded ROM
+	// reload, and both of them may have taken a private copy. The check here is made under
+	// our lock, so only one copy is ever published, and the caller discards their copy if
+	// we return false.
+	std::unique_lock<std::mutex> lock(_accessMutex);
+	if (*memoryArray != dataBlock)
+	{
+		return false;
+	}
+	*memoryArray = privateCopy;
+	_bytesCopiedOnWrite += byteSize;
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Statistics functions
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+ROMDataStore::Statistics ROMDataStore::GetStatistics() const
+{
+	std::unique_lock<std::mutex> lock(_accessMutex);
+	Statistics statistics;
+	for (std::map<const void*, DataBlock*>::const_iterator i = _dataBlocksByAddress.begin(); i != _dataBlocksByAddress.end(); ++i)
+	{
+		const DataBlock& dataBlock = *i->second;
+		++statistics.blockCount;
+		statistics.residentBytes += dataBlock.byteSize;
+		statistics.referencedBytes += (unsigned long long)dataBlock.byteSize * dataBlock.referenceCount;
+	}
+	statistics.bytesShared = _bytesShared;
+	statistics.bytesCopied = _bytesCopied;
+	statistics.bytesCopiedOnWrite = _bytesCopiedOnWrite;
+	return statistics;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Hash functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned long long ROMDataStore::CalculateDataHash(const void* data, size_t byteSize)
+{
+	// Calculate a 64-bit FNV-1a hash of the data. This is only used to locate candidate
+	// blocks, with a full comparison performed before any block is shared, so a fast
+	// non-cryptographic hash is all we need here.
+	const unsigned char* dataAsBytes = (const unsigned char*)data;
+	unsigned long long hash = 14695981039346656037ULL;
+	for (size_t i = 0; i < byteSize; ++i)
+	{
+		hash ^= dataAsBytes[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Block allocation functions
+//----------------------------------------------------------------------------------------------------------------------
+void* ROMDataStore::AllocateBlockMemory(const void* data, size_t byteSize)
+{
+	// Allocate the block directly from the virtual memory manager so that we can mark the
+	// pages read-only once they've been populated. Any attempt to write to shared ROM data
+	// without first taking a private copy will fault immediately rather than silently
+	// corrupting the data seen by other devices.
+	void* blockMemory = VirtualAlloc(NULL, byteSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+	if (blockMemory == NULL)
+	{
+		return 0;
+	}
+	memcpy(blockMemory, data, byteSize);
+	DWORD oldProtect;
+	VirtualProtect(blockMemory, byteSize, PAGE_READONLY, &oldProtect);
+	return blockMemory;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ROMDataStore::FreeBlockMemory(void* blockMemory)
+{
+	VirtualFree(blockMemory, 0, MEM_RELEASE);
+}
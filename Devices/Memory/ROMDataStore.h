@@ -0,0 +1,60 @@
+#ifndef __ROMDATASTORE_H__
+#define __ROMDATASTORE_H__
+#include "IROMMemory.h"
+#include <mutex>
+#include <map>
+
+// This class provides a process-wide, reference-counted store of immutable ROM data
+// blocks. ROM devices construct their decoded memory arrays as normal, then submit them
+// here. Blocks are keyed on a hash of their contents, so any number of ROM devices across
+// loaded modules and system instances which hold identical data will all reference the
+// same block, rather than each holding their own copy. Blocks are committed as read-only
+// pages once populated, so a device which needs to modify its data must take a private
+// copy first.
+class ROMDataStore
+{
+public:
+	// Typedefs
+	typedef IROMMemory::DataStoreStatistics Statistics;
+
+public:
+	// Instance functions
+	static ROMDataStore& GetInstance();
+
+	// Data block functions
+	const void* AcquireDataBlock(const void* data, size_t byteSize, bool& sharedWithExistingBlock);
+	void ReleaseDataBlock(const void* dataBlock);
+
+	// Private copy functions
+	bool PublishPrivateCopy(void** memoryArray, const void* dataBlock, void* privateCopy, size_t byteSize);
+
+	// Statistics functions
+	Statistics GetStatistics() const;
+
+private:
+	// Structures
+	struct DataBlock;
+
+private:
+	// Constructors
+	ROMDataStore();
+	~ROMDataStore();
+
+	// Hash functions
+	static unsigned long long CalculateDataHash(const void* data, size_t byteSize);
+
+	// Block allocation functions
+	static void* AllocateBlockMemory(const void* data, size_t byteSize);
+	static void FreeBlockMemory(void* blockMemory);
+
+private:
+	mutable std::mutex _accessMutex;
+	std::multimap<unsigned long long, DataBlock*> _dataBlocksByHash;
+	std::map<const void*, DataBlock*> _dataBlocksByAddress;
+	unsigned long long _bytesShared;
+	unsigned long long _bytesCopied;
+	unsigned long long _bytesCopiedOnWrite;
+};
+
+#include "ROMDataStore.inl"
+#endif
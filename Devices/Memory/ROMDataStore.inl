@@ -0,0 +1,14 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Structures
+//----------------------------------------------------------------------------------------------------------------------
+struct ROMDataStore::DataBlock
+{
+	DataBlock(void* adata, size_t abyteSize, unsigned long long ahash)
+	:data(adata), byteSize(abyteSize), hash(ahash), referenceCount(1)
+	{ }
+
+	void* data;
+	size_t byteSize;
+	unsigned long long hash;
+	unsigned int referenceCount;
+};
@@ -60,6 +60,12 @@ void SharedRAM::ExecuteCommit()
 	_buffer.clear();
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+bool SharedRAM::UsesParallelCommit() const
+{
+	return true;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Memory interface functions
 //----------------------------------------------------------------------------------------------------------------------
@@ -21,6 +21,7 @@ public:
 	// Execute functions
 	virtual void ExecuteRollback();
 	virtual void ExecuteCommit();
+	virtual bool UsesParallelCommit() const;
 
 	// Memory interface functions
 	virtual IBusInterface::AccessResult ReadInterface(unsigned int interfaceNumber, unsigned int location, Data& data, IDeviceContext* caller, double accessTime, unsigned int accessContext);
@@ -84,6 +84,12 @@ void TimedBufferInt::GetLatestBufferCopy(DataType* buffer, unsigned int bufferSi
 	_memory.GetLatestBufferCopy(buffer, bufferSize);
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int TimedBufferInt::GetLatestBufferChanges(unsigned int sinceGeneration, DataType* buffer, unsigned int bufferSize, unsigned int* changedBlockBitmap) const
+{
+	return _memory.GetLatestBufferChanges(sinceGeneration, buffer, bufferSize, changedBlockBitmap);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Time management functions
 //----------------------------------------------------------------------------------------------------------------------
@@ -53,6 +53,7 @@ public:
 protected:
 	// Access functions
 	virtual void GetLatestBufferCopy(DataType* buffer, unsigned int bufferSize) const;
+	virtual unsigned int GetLatestBufferChanges(unsigned int sinceGeneration, DataType* buffer, unsigned int bufferSize, unsigned int* changedBlockBitmap) const;
 
 private:
 	RandomTimeAccessBuffer<DataType, TimesliceType> _memory;
@@ -0,0 +1,52 @@
+#ifndef __BANDLIMITEDSTEPBUFFER_H__
+#define __BANDLIMITEDSTEPBUFFER_H__
+#include <vector>
+
+// This class synthesizes an output signal at a target sample rate from a series of
+// amplitude steps, where each step occurs at an arbitrary point in time measured in cycles
+// of an input clock. Rather than generating the signal at the input clock rate and
+// resampling it, each step is inserted directly into the output as a band-limited step
+// (BLEP), using a table of windowed sinc kernels indexed by the fractional position of the
+// step within an output sample. The cost of synthesis is therefore proportional to the
+// number of steps and output samples, not the number of input clock cycles. Steps are
+// added relative to the start of the current frame, and output samples become available
+// to be read once a frame is ended. This class has no dependencies on any device, so that
+// it can be tested in isolation.
+class BandLimitedStepBuffer
+{
+public:
+	// Constants
+	static const unsigned int KernelPhaseCount = 64;
+	static const unsigned int KernelWidth = 16;
+
+public:
+	// Constructors
+	inline BandLimitedStepBuffer();
+
+	// Configuration functions
+	inline void SetRates(double inputClockRate, double outputSampleRate);
+	inline double GetOutputSamplesPerClock() const;
+	inline void Clear();
+
+	// Step functions
+	inline void AddStep(double clockOffset, float delta);
+	inline void EndFrame(double clockCount);
+
+	// Output functions
+	inline unsigned int GetAvailableSampleCount() const;
+	inline void ReadSamples(std::vector<short>& outputBuffer, float outputScale);
+
+private:
+	// Kernel functions
+	inline void BuildKernel();
+
+private:
+	float _kernel[KernelPhaseCount + 1][KernelWidth];
+	std::vector<float> _deltaBuffer;
+	double _outputSamplesPerClock;
+	double _framePosition;
+	double _integrator;
+};
+
+#include "BandLimitedStepBuffer.inl"
+#endif
@@ -0,0 +1,149 @@
+#include <cmath>
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+BandLimitedStepBuffer::BandLimitedStepBuffer()
+:_outputSamplesPerClock(1.0), _framePosition(0.0), _integrator(0.0)
+{
+	BuildKernel();
+	_deltaBuffer.resize(KernelWidth, 0.0f);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Configuration functions
+//----------------------------------------------------------------------------------------------------------------------
+void BandLimitedStepBuffer::SetRates(double inputClockRate, double outputSampleRate)
+{
+	_outputSamplesPerClock = outputSampleRate / inputClockRate;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+double BandLimitedStepBuffer::GetOutputSamplesPerClock() const
+{
+	return _outputSamplesPerClock;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void BandLimitedStepBuffer::Clear()
+{
+	_deltaBuffer.assign(KernelWidth, 0.0f);
+	_framePosition = 0.0;
+	_integrator = 0.0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Step functions
+//----------------------------------------------------------------------------------------------------------------------
+void BandLimitedStepBuffer::AddStep(double clockOffset, float delta)
+{
+	// Calculate the position of this step in the output stream, and select the kernel
+	// which corresponds with the fractional position of the step within its output sample.
+	double position = _framePosition + (clockOffset * _outputSamplesPerClock);
+	unsigned int sampleIndex = (unsigned int)position;
+	unsigned int phase = (unsigned int)(((position - (double)sampleIndex) * (double)KernelPhaseCount) + 0.5);
+
+	// Accumulate the differentiated step into the delta buffer. The output is recovered by
+	// integrating the delta buffer as samples are read.
+	if (_deltaBuffer.size() < (sampleIndex + KernelWidth))
+	{
+		_deltaBuffer.resize(sampleIndex + KernelWidth, 0.0f);
+	}
+	const float* kernel = &_kernel[phase][0];
+	float* target = &_deltaBuffer[sampleIndex];
+	for (unsigned int i = 0; i < KernelWidth; ++i)
+	{
+		target[i] += kernel[i] * delta;
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void BandLimitedStepBuffer::EndFrame(double clockCount)
+{
+	_framePosition += clockCount * _outputSamplesPerClock;
+	unsigned int requiredBufferSize = (unsigned int)_framePosition + KernelWidth;
+	if (_deltaBuffer.size() < requiredBufferSize)
+	{
+		_deltaBuffer.resize(requiredBufferSize, 0.0f);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Output functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int BandLimitedStepBuffer::GetAvailableSampleCount() const
+{
+	// Since steps can only be added at or after the start of the current frame, and each
+	// kernel only extends forward from the sample the step lands in, all samples before
+	// the start of the current frame are final.
+	return (unsigned int)_framePosition;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void BandLimitedStepBuffer::ReadSamples(std::vector<short>& outputBuffer, float outputScale)
+{
+	// Integrate the delta buffer to produce each available output sample, and append the
+	// scaled and clamped samples to the output buffer.
+	unsigned int sampleCount = GetAvailableSampleCount();
+	size_t outputBufferPos = outputBuffer.size();
+	outputBuffer.resize(outputBufferPos + sampleCount);
+	for (unsigned int i = 0; i < sampleCount; ++i)
+	{
+		_integrator += _deltaBuffer[i];
+		double sample = _integrator * outputScale;
+		sample = (sample > 32767.0)? 32767.0: ((sample < -32768.0)? -32768.0: sample);
+		outputBuffer[outputBufferPos++] = (short)sample;
+	}
+
+	// Discard the samples we've just consumed from the delta buffer
+	_deltaBuffer.erase(_deltaBuffer.begin(), _deltaBuffer.begin() + sampleCount);
+	_deltaBuffer.resize(std::max(_deltaBuffer.size(), (size_t)KernelWidth), 0.0f);
+	_framePosition -= (double)sampleCount;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Kernel functions
+//----------------------------------------------------------------------------------------------------------------------
+void BandLimitedStepBuffer::BuildKernel()
+{
+	// Build a band-limited step for each fractional step position by integrating a
+	// Blackman windowed sinc impulse, then store the difference between successive output
+	// samples of the step. Note that we can't simply store the sampled impulse itself, as
+	// the running sum we use to recover the output is a discrete integration, which would
+	// boost high frequencies relative to the true step. The cutoff is placed slightly below
+	// the output Nyquist frequency to leave room for the transition band of the window.
+	const double pi = 3.14159265358979323846;
+	const double cutoff = 0.9;
+	const double halfWidth = (double)(KernelWidth / 2);
+	const unsigned int integrationStepsPerSample = 64;
+	for (unsigned int phase = 0; phase <= KernelPhaseCount; ++phase)
+	{
+		double center = (halfWidth - 1.0) + ((double)phase / (double)KernelPhaseCount);
+		double stepLevel[KernelWidth];
+		double integral = 0.0;
+		for (unsigned int i = 0; i < KernelWidth; ++i)
+		{
+			// Integrate the impulse over the region leading up to this output sample
+			for (unsigned int integrationStepNo = 0; integrationStepNo < integrationStepsPerSample; ++integrationStepNo)
+			{
+				double t = ((double)i - 1.0 + (((double)integrationStepNo + 0.5) / (double)integrationStepsPerSample)) - center;
+				double sinc = (t == 0.0)? 1.0: (std::sin(pi * cutoff * t) / (pi * cutoff * t));
+				double x = t / halfWidth;
+				double window = (std::fabs(x) >= 1.0)? 0.0: (0.42 + (0.5 * std::cos(pi * x)) + (0.08 * std::cos(2.0 * pi * x)));
+				integral += sinc * window;
+			}
+			stepLevel[i] = integral;
+		}
+
+		// Normalize the step to unity gain, so that a step of a given delta always moves
+		// the integrated output by exactly that delta, and store the differences.
+		double previousLevel = 0.0;
+		for (unsigned int i = 0; i < KernelWidth; ++i)
+		{
+			double level = stepLevel[i] / integral;
+			_kernel[phase][i] = (float)(level - previousLevel);
+			previousLevel = level;
+		}
+	}
+}
@@ -48,6 +48,8 @@ public:
 	inline void SetNoiseChannelWhiteNoiseTappedBitMask(unsigned int data);
 	inline unsigned int GetNoiseChannelPeriodicNoiseTappedBitMask() const;
 	inline void SetNoiseChannelPeriodicNoiseTappedBitMask(unsigned int data);
+	inline bool IsBandLimitedSynthesisEnabled() const;
+	inline void SetBandLimitedSynthesisEnabled(bool data);
 
 	// Audio logging functions
 	inline bool IsAudioLoggingEnabled() const;
@@ -58,6 +60,12 @@ public:
 	inline void SetAudioLoggingOutputPath(const std::wstring& data);
 	inline std::wstring GetChannelAudioLoggingOutputPath(unsigned int channelNo) const;
 	inline void SetChannelAudioLoggingOutputPath(unsigned int channelNo, const std::wstring& data);
+
+	// Register logging functions
+	inline bool IsRegisterLoggingEnabled() const;
+	inline void SetRegisterLoggingEnabled(bool data);
+	inline std::wstring GetRegisterLoggingOutputPath() const;
+	inline void SetRegisterLoggingOutputPath(const std::wstring& data);
 };
 
 #include "ISN76489.inl"
@@ -31,7 +31,10 @@ enum class ISN76489::ISN76489DataSource
 	Channel1AudioLoggingPath,
 	Channel2AudioLoggingPath,
 	Channel3AudioLoggingPath,
-	Channel4AudioLoggingPath
+	Channel4AudioLoggingPath,
+	BandLimitedSynthesisEnabled,
+	RegisterLoggingEnabled,
+	RegisterLoggingPath
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -205,6 +208,21 @@ void ISN76489::SetNoiseChannelPeriodicNoiseTappedBitMask(unsigned int data)
 	WriteGenericData((unsigned int)ISN76489DataSource::PeriodicNoiseTappedBitMask, 0, genericData);
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+bool ISN76489::IsBandLimitedSynthesisEnabled() const
+{
+	GenericAccessDataValueBool genericData;
+	ReadGenericData((unsigned int)ISN76489DataSource::BandLimitedSynthesisEnabled, 0, genericData);
+	return genericData.GetValue();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ISN76489::SetBandLimitedSynthesisEnabled(bool data)
+{
+	GenericAccessDataValueBool genericData(data);
+	WriteGenericData((unsigned int)ISN76489DataSource::BandLimitedSynthesisEnabled, 0, genericData);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Audio logging functions
 //----------------------------------------------------------------------------------------------------------------------
@@ -266,3 +284,35 @@ void ISN76489::SetChannelAudioLoggingOutputPath(unsigned int channelNo, const st
 	GenericAccessDataValueFilePath genericData(data);
 	WriteGenericData((unsigned int)ISN76489DataSource::Channel1AudioLoggingPath + channelNo, 0, genericData);
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Register logging functions
+//----------------------------------------------------------------------------------------------------------------------
+bool ISN76489::IsRegisterLoggingEnabled() const
+{
+	GenericAccessDataValueBool genericData;
+	ReadGenericData((unsigned int)ISN76489DataSource::RegisterLoggingEnabled, 0, genericData);
+	return genericData.GetValue();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ISN76489::SetRegisterLoggingEnabled(bool data)
+{
+	GenericAccessDataValueBool genericData(data);
+	WriteGenericData((unsigned int)ISN76489DataSource::RegisterLoggingEnabled, 0, genericData);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::wstring ISN76489::GetRegisterLoggingOutputPath() const
+{
+	GenericAccessDataValueFilePath genericData;
+	ReadGenericData((unsigned int)ISN76489DataSource::RegisterLoggingPath, 0, genericData);
+	return genericData.GetValue();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ISN76489::SetRegisterLoggingOutputPath(const std::wstring& data)
+{
+	GenericAccessDataValueFilePath genericData(data);
+	WriteGenericData((unsigned int)ISN76489DataSource::RegisterLoggingPath, 0, genericData);
+}
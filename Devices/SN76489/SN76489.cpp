@@ -30,6 +30,7 @@ SN76489::SN76489(const std::wstring& implementationName, const std::wstring& ins
 	_shiftRegisterDefaultValue = 0x8000;
 	_noiseWhiteTappedBitMask = 0x0009;
 	_noisePeriodicTappedBitMask = 0x0001;
+	_bandLimitedSynthesisEnabled = false;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -58,9 +59,18 @@ bool SN76489::BuildDevice()
 		_wavLoggingChannelPath[channelNo] = PathCombinePaths(captureFolder, wavLoggingChannelFileName.str());
 	}
 
+	// Initialize the register logging state
+	_registerLoggingEnabled = false;
+	_registerLoggingSnapshotPending = false;
+	_registerLoggingTime = 0;
+	std::wstring registerLoggingFileName = GetDeviceInstanceName() + L".vgm";
+	_registerLoggingPath = PathCombinePaths(captureFolder, registerLoggingFileName);
+
 	// Register each data source with the generic data access base class
 	std::wstring audioLogExtensionFilter = L"Wave file|wav";
 	std::wstring audioLogDefaultExtension = L"wav";
+	std::wstring registerLogExtensionFilter = L"VGM file|vgm";
+	std::wstring registerLogDefaultExtension = L"vgm";
 	GenericAccessDataInfo* dataInfoShiftRegister;
 	GenericAccessDataInfo* dataInfoShiftRegisterDefaultValue;
 	GenericAccessDataInfo* dataInfoShiftRegisterWhiteNoiseBits;
@@ -85,6 +95,7 @@ bool SN76489::BuildDevice()
 	result &= AddGenericDataInfo(dataInfoShiftRegisterDefaultValue = (new GenericAccessDataInfo(ISN76489DataSource::ShiftRegisterDefaultValue, IGenericAccessDataValue::DataType::UInt))->SetUIntMaxValue((1<<GetShiftRegisterBitCount())-1)->SetIntDisplayMode(IGenericAccessDataValue::IntDisplayMode::Hexadecimal));
 	result &= AddGenericDataInfo(dataInfoShiftRegisterWhiteNoiseBits = (new GenericAccessDataInfo(ISN76489DataSource::WhiteNoiseTappedBitMask, IGenericAccessDataValue::DataType::UInt))->SetUIntMaxValue((1<<GetShiftRegisterBitCount())-1)->SetIntDisplayMode(IGenericAccessDataValue::IntDisplayMode::Hexadecimal));
 	result &= AddGenericDataInfo(dataInfoShiftRegisterPeriodicNoiseBits = (new GenericAccessDataInfo(ISN76489DataSource::PeriodicNoiseTappedBitMask, IGenericAccessDataValue::DataType::UInt))->SetUIntMaxValue((1<<GetShiftRegisterBitCount())-1)->SetIntDisplayMode(IGenericAccessDataValue::IntDisplayMode::Hexadecimal));
+	result &= AddGenericDataInfo((new GenericAccessDataInfo(ISN76489DataSource::BandLimitedSynthesisEnabled, IGenericAccessDataValue::DataType::Bool)));
 	result &= AddGenericDataInfo((new GenericAccessDataInfo(ISN76489DataSource::AudioLoggingEnabled, IGenericAccessDataValue::DataType::Bool)));
 	result &= AddGenericDataInfo((new GenericAccessDataInfo(ISN76489DataSource::AudioLoggingPath, IGenericAccessDataValue::DataType::FilePath))->SetFilePathExtensionFilter(audioLogExtensionFilter)->SetFilePathDefaultExtension(audioLogDefaultExtension)->SetFilePathCreatingTarget(true));
 	result &= AddGenericDataInfo((new GenericAccessDataInfo(ISN76489DataSource::Channel1AudioLoggingEnabled, IGenericAccessDataValue::DataType::Bool)));
@@ -95,6 +106,8 @@ bool SN76489::BuildDevice()
 	result &= AddGenericDataInfo((new GenericAccessDataInfo(ISN76489DataSource::Channel2AudioLoggingPath, IGenericAccessDataValue::DataType::FilePath))->SetFilePathExtensionFilter(audioLogExtensionFilter)->SetFilePathDefaultExtension(audioLogDefaultExtension)->SetFilePathCreatingTarget(true));
 	result &= AddGenericDataInfo((new GenericAccessDataInfo(ISN76489DataSource::Channel3AudioLoggingPath, IGenericAccessDataValue::DataType::FilePath))->SetFilePathExtensionFilter(audioLogExtensionFilter)->SetFilePathDefaultExtension(audioLogDefaultExtension)->SetFilePathCreatingTarget(true));
 	result &= AddGenericDataInfo((new GenericAccessDataInfo(ISN76489DataSource::Channel4AudioLoggingPath, IGenericAccessDataValue::DataType::FilePath))->SetFilePathExtensionFilter(audioLogExtensionFilter)->SetFilePathDefaultExtension(audioLogDefaultExtension)->SetFilePathCreatingTarget(true));
+	result &= AddGenericDataInfo((new GenericAccessDataInfo(ISN76489DataSource::RegisterLoggingEnabled, IGenericAccessDataValue::DataType::Bool)));
+	result &= AddGenericDataInfo((new GenericAccessDataInfo(ISN76489DataSource::RegisterLoggingPath, IGenericAccessDataValue::DataType::FilePath))->SetFilePathExtensionFilter(registerLogExtensionFilter)->SetFilePathDefaultExtension(registerLogDefaultExtension)->SetFilePathCreatingTarget(true));
 
 	// Save references to the data info structures which contain values that need to have
 	// their limits changed when the bitcount for the shift register is changed.
@@ -147,6 +160,7 @@ bool SN76489::BuildDevice()
 	GenericAccessPage* parametersPage = new GenericAccessPage(L"Parameters", L"Parameters");
 	parametersPage->AddEntry(new GenericAccessGroupDataEntry(ISN76489DataSource::ExternalClockRate, L"External Clock Rate"))
 	              ->AddEntry(new GenericAccessGroupDataEntry(ISN76489DataSource::ExternalClockDivider, L"External Clock Divider"))
+	              ->AddEntry(new GenericAccessGroupDataEntry(ISN76489DataSource::BandLimitedSynthesisEnabled, L"Band-Limited Synthesis"))
 	              ->AddEntry((new GenericAccessGroup(L"Noise Channel"))
 	                  ->AddEntry(new GenericAccessGroupDataEntry(ISN76489DataSource::ShiftRegisterBitCount, L"Shift Register Bit Count"))
 	                  ->AddEntry(new GenericAccessGroupDataEntry(ISN76489DataSource::ShiftRegisterDefaultValue, L"Shift Register Default Value"))
@@ -163,7 +177,10 @@ bool SN76489::BuildDevice()
 	                ->AddEntry(new GenericAccessGroupDataEntry(ISN76489DataSource::Channel1AudioLoggingPath, L"Channel 1 Log Path"))
 	                ->AddEntry(new GenericAccessGroupDataEntry(ISN76489DataSource::Channel2AudioLoggingPath, L"Channel 2 Log Path"))
 	                ->AddEntry(new GenericAccessGroupDataEntry(ISN76489DataSource::Channel3AudioLoggingPath, L"Channel 3 Log Path"))
-	                ->AddEntry(new GenericAccessGroupDataEntry(ISN76489DataSource::Channel4AudioLoggingPath, L"Channel 4 Log Path"));
+	                ->AddEntry(new GenericAccessGroupDataEntry(ISN76489DataSource::Channel4AudioLoggingPath, L"Channel 4 Log Path"))
+	                ->AddEntry((new GenericAccessGroup(L"Register Write Log"))
+	                    ->AddEntry(new GenericAccessGroupDataEntry(ISN76489DataSource::RegisterLoggingEnabled, L"Log Enabled"))
+	                    ->AddEntry(new GenericAccessGroupDataEntry(ISN76489DataSource::RegisterLoggingPath, L"Log Path")));
 	result &= AddGenericAccessPage(audioLoggingPage);
 
 	return result;
@@ -190,6 +207,12 @@ void SN76489::Initialize()
 	_noiseShiftRegister = _shiftRegisterDefaultValue;
 	_noiseOutputMasked = true;
 	_outputBuffer.clear();
+	_bandLimitedSynthesisActive = false;
+	_bandLimitedStepBuffer.Clear();
+	for (unsigned int i = 0; i < ChannelCount; ++i)
+	{
+		_bandLimitedChannelLevel[i] = 0.0f;
+	}
 
 	// Initialize the register block, and set the correct register sizes for each entry.
 	_reg.Initialize();
@@ -396,6 +419,8 @@ void SN76489::ExecuteCommit()
 void SN76489::RenderThread()
 {
 	std::unique_lock<std::mutex> lock(_renderThreadMutex);
+	ITraceRecorder& traceRecorder = GetSystemInterface().GetTraceRecorder();
+	traceRecorder.SetCurrentThreadTraceName(L"SN76489Render - " + GetDeviceInstanceName());
 
 	// Start the render loop
 	bool done = false;
@@ -444,9 +469,45 @@ void SN76489::RenderThread()
 			continue;
 		}
 
+		// Determine whether we're synthesizing the output directly at the output sample
+		// rate for this timeslice. Since audio logs are recorded at the internal sample
+		// rate of the device, we always render at the internal sample rate while any audio
+		// logging is active. If we're changing between output modes, we discard any
+		// pending output from the previous mode.
+		bool bandLimitedSynthesis = _bandLimitedSynthesisEnabled && !_wavLoggingEnabled;
+		for (unsigned int channelNo = 0; channelNo < ChannelCount; ++channelNo)
+		{
+			bandLimitedSynthesis &= !_wavLoggingChannelEnabled[channelNo];
+		}
+		if (bandLimitedSynthesis != _bandLimitedSynthesisActive)
+		{
+			_outputBuffer.clear();
+			_bandLimitedStepBuffer.Clear();
+			for (unsigned int channelNo = 0; channelNo < ChannelCount; ++channelNo)
+			{
+				_bandLimitedChannelLevel[channelNo] = 0.0f;
+			}
+			_bandLimitedSynthesisActive = bandLimitedSynthesis;
+		}
+
+		// Hold the register logging lock for the entire render operation. If register
+		// logging has just been enabled, we record the committed register state at the
+		// start of this timeslice before any other writes, so that the log reproduces the
+		// correct output when replayed from the point where capture began.
+		std::unique_lock<std::mutex> registerLoggingLock(_registerLoggingMutex);
+		AccessTarget accessTarget;
+		accessTarget.AccessCommitted();
+		if (_registerLoggingEnabled && _registerLoggingSnapshotPending)
+		{
+			WriteRegisterLogSnapshot(accessTarget);
+			_registerLoggingSnapshotPending = false;
+		}
+
 		// Render the audio output
 		size_t outputBufferPos = _outputBuffer.size();
 		double outputFrequency = _externalClockRate / _externalClockDivider;
+		_bandLimitedStepBuffer.SetRates(outputFrequency, (double)_outputSampleRate);
+		unsigned int ultrasonicTonePeriodLimit = (unsigned int)(outputFrequency / (double)_outputSampleRate);
 		bool moreSamplesRemaining = true;
 		while (moreSamplesRemaining)
 		{
@@ -455,7 +516,9 @@ void SN76489::RenderThread()
 			// the end of a timeslice. Negative times won't cause writes to be processed at
 			// the incorrect time under the current model, but we do need to ensure that
 			// remainingRenderTime isn't negative before attempting to generate an output.
-			_remainingRenderTime += _reg.GetNextWriteTime(regTimesliceCopy);
+			double nextWriteTime = _reg.GetNextWriteTime(regTimesliceCopy);
+			_remainingRenderTime += nextWriteTime;
+			_registerLoggingTime += nextWriteTime;
 
 			// Calculate the output sample count. Note that remainingRenderTime may be
 			// negative, but we catch that below before using outputSampleCount.
@@ -465,38 +528,51 @@ void SN76489::RenderThread()
 			// change or the end of the target timeslice, generate and output the samples.
 			if ((_remainingRenderTime > 0) && (outputSampleCount > 0))
 			{
-				// Resize the output buffer to fit the samples we're about to add
-				_outputBuffer.resize(_outputBuffer.size() + outputSampleCount);
-
-				// For each channel, calculate the output data for the elapsed time
-				std::vector<float> channelBuffer[ChannelCount];
-				for (unsigned int channelNo = 0; channelNo < ChannelCount; ++channelNo)
+				if (bandLimitedSynthesis)
 				{
-					channelBuffer[channelNo].resize(outputSampleCount);
-					UpdateChannel(channelNo, outputSampleCount, channelBuffer[channelNo]);
+					// For each channel, insert a band-limited step into the output at each
+					// point where the channel output changes over the elapsed time.
+					for (unsigned int channelNo = 0; channelNo < ChannelCount; ++channelNo)
+					{
+						UpdateChannelBandLimited(channelNo, outputSampleCount, ultrasonicTonePeriodLimit);
+					}
+					_bandLimitedStepBuffer.EndFrame((double)outputSampleCount);
+				}
+				else
+				{
+					// Resize the output buffer to fit the samples we're about to add
+					_outputBuffer.resize(_outputBuffer.size() + outputSampleCount);
 
-					// Output the channel wave log
-					if (_wavLoggingChannelEnabled[channelNo])
+					// For each channel, calculate the output data for the elapsed time
+					std::vector<float> channelBuffer[ChannelCount];
+					for (unsigned int channelNo = 0; channelNo < ChannelCount; ++channelNo)
 					{
-						std::unique_lock<std::mutex> waveLoggingLock(_waveLoggingMutex);
-						for (unsigned int i = 0; i < channelBuffer[channelNo].size(); ++i)
+						channelBuffer[channelNo].resize(outputSampleCount);
+						UpdateChannel(channelNo, outputSampleCount, channelBuffer[channelNo]);
+
+						// Output the channel wave log
+						if (_wavLoggingChannelEnabled[channelNo])
 						{
-							short sample = (short)(channelBuffer[channelNo][i] * (32767.0f/ChannelCount));
-							_wavLogChannel[channelNo].WriteData(sample);
+							std::unique_lock<std::mutex> waveLoggingLock(_waveLoggingMutex);
+							for (unsigned int i = 0; i < channelBuffer[channelNo].size(); ++i)
+							{
+								short sample = (short)(channelBuffer[channelNo][i] * (32767.0f/ChannelCount));
+								_wavLogChannel[channelNo].WriteSample(sample);
+							}
 						}
 					}
-				}
 
-				// Mix the output from each channel into a combined output buffer
-				for (unsigned int sampleNo = 0; sampleNo < outputSampleCount; ++sampleNo)
-				{
-					float mixedSample = 0.0;
-					for (unsigned int channelNo = 0; channelNo < ChannelCount; ++channelNo)
+					// Mix the output from each channel into a combined output buffer
+					for (unsigned int sampleNo = 0; sampleNo < outputSampleCount; ++sampleNo)
 					{
-						mixedSample += channelBuffer[channelNo][sampleNo];
+						float mixedSample = 0.0;
+						for (unsigned int channelNo = 0; channelNo < ChannelCount; ++channelNo)
+						{
+							mixedSample += channelBuffer[channelNo][sampleNo];
+						}
+						mixedSample /= ChannelCount;
+						_outputBuffer[outputBufferPos++] = (short)(mixedSample * (32767.0f / 6.0f));
 					}
-					mixedSample /= ChannelCount;
-					_outputBuffer[outputBufferPos++] = (short)(mixedSample * (32767.0f / 6.0f));
 				}
 
 				RandomTimeAccessBuffer<Data, double>::WriteInfo writeInfo = _reg.GetWriteInfo(0, regTimesliceCopy);
@@ -515,33 +591,69 @@ void SN76489::RenderThread()
 				_remainingRenderTime -= (double)outputSampleCount * (1000000000.0 / outputFrequency);
 			}
 
+			// Record any register write at this step in the register log. Note that this is
+			// done independently of the output generation above, since writes can occur
+			// without any samples being generated before them.
+			if (_registerLoggingEnabled)
+			{
+				RandomTimeAccessBuffer<Data, double>::WriteInfo writeInfo = _reg.GetWriteInfo(0, regTimesliceCopy);
+				if (writeInfo.exists)
+				{
+					WriteRegisterLogEntry(writeInfo.writeAddress, writeInfo.newValue.GetData());
+				}
+			}
+
 			// Advance to the next write operation, or the end of the current timeslice.
 			moreSamplesRemaining = _reg.AdvanceByStep(regTimesliceCopy);
 		}
+		registerLoggingLock.unlock();
 
-		// Output the mixed channel wave log
-		if (_wavLoggingEnabled)
-		{
-			std::unique_lock<std::mutex> waveLoggingLock(_waveLoggingMutex);
-			_wavLog.WriteData(_outputBuffer);
-		}
-
-		// Play the mixed audio stream. Note that we fold samples from successive render
+		// Play the rendered audio output. Note that we fold samples from successive render
 		// operations together, ensuring that we only send data to the output audio stream
 		// when we have a significant number of samples to send.
-		size_t minimumSamplesToOutput = (size_t)(outputFrequency / 60.0);
-		if (_outputBuffer.size() >= minimumSamplesToOutput)
+		if (bandLimitedSynthesis)
 		{
-			unsigned int internalSampleCount = (unsigned int)_outputBuffer.size();
-			unsigned int outputSampleCount = (unsigned int)((double)internalSampleCount * ((double)_outputSampleRate / outputFrequency));
-			AudioStream::AudioBuffer* outputBufferFinal = _outputStream.CreateAudioBuffer(outputSampleCount, 1);
-			if (outputBufferFinal != 0)
+			// Since the output was synthesized directly at the output sample rate, all
+			// completed samples can be sent to the output audio stream without conversion.
+			_bandLimitedStepBuffer.ReadSamples(_outputBuffer, 32767.0f / 6.0f);
+			size_t minimumSamplesToOutput = (size_t)(_outputSampleRate / 60);
+			if (_outputBuffer.size() >= minimumSamplesToOutput)
 			{
-				_outputStream.ConvertSampleRate(_outputBuffer, internalSampleCount, 1, outputBufferFinal->buffer, outputSampleCount);
-				_outputStream.PlayBuffer(outputBufferFinal);
+				AudioStream::AudioBuffer* outputBufferFinal = _outputStream.CreateAudioBuffer((unsigned int)_outputBuffer.size(), 1);
+				if (outputBufferFinal != 0)
+				{
+					ITraceRecorder::Scope traceScope(traceRecorder, "AudioBufferSubmit");
+					outputBufferFinal->buffer.assign(_outputBuffer.begin(), _outputBuffer.end());
+					_outputStream.PlayBuffer(outputBufferFinal);
+				}
+				_outputBuffer.clear();
+			}
+		}
+		else
+		{
+			// Output the mixed channel wave log
+			if (_wavLoggingEnabled)
+			{
+				std::unique_lock<std::mutex> waveLoggingLock(_waveLoggingMutex);
+				_wavLog.WriteSamples(_outputBuffer);
+			}
+
+			// Convert the mixed audio stream to the output sample rate, and play it.
+			size_t minimumSamplesToOutput = (size_t)(outputFrequency / 60.0);
+			if (_outputBuffer.size() >= minimumSamplesToOutput)
+			{
+				unsigned int internalSampleCount = (unsigned int)_outputBuffer.size();
+				unsigned int outputSampleCount = (unsigned int)((double)internalSampleCount * ((double)_outputSampleRate / outputFrequency));
+				AudioStream::AudioBuffer* outputBufferFinal = _outputStream.CreateAudioBuffer(outputSampleCount, 1);
+				if (outputBufferFinal != 0)
+				{
+					ITraceRecorder::Scope traceScope(traceRecorder, "AudioBufferSubmit");
+					_outputStream.ConvertSampleRate(_outputBuffer, internalSampleCount, 1, outputBufferFinal->buffer, outputSampleCount);
+					_outputStream.PlayBuffer(outputBufferFinal);
+				}
+				_outputBuffer.clear();
+				_outputBuffer.reserve(minimumSamplesToOutput * 2);
 			}
-			_outputBuffer.clear();
-			_outputBuffer.reserve(minimumSamplesToOutput * 2);
 		}
 
 		// Advance past the timeslice we've just rendered from
@@ -558,10 +670,164 @@ void SN76489::UpdateChannel(unsigned int channelNo, unsigned int outputSampleCou
 {
 	ChannelRenderData* renderData = &_channelRenderData[channelNo];
 
+	// Read current register data, and calculate the output amplitude and tone period
+	float amplitude;
+	unsigned int tonePeriod;
+	bool whiteNoiseSelected;
+	GetChannelRenderParameters(channelNo, amplitude, tonePeriod, whiteNoiseSelected);
+
+	// If we were partway through a cycle on this channel when we rendered the last step,
+	// resume the last cycle.
+	unsigned int samplesWritten = 0;
+	while ((renderData->remainingToneCycles > 0) && (samplesWritten < outputSampleCount))
+	{
+		// If we're starting the output on a negative cycle, negate the output data.
+		float writeData = (renderData->polarityNegative)? -amplitude: amplitude;
+
+		// If we're updating the noise register, calculate the output data based on
+		// the shift register.
+		if (channelNo == NoiseChannelNo)
+		{
+			// Use the current noise bit to calculate the output data
+			writeData = (_noiseOutputMasked)? 0: amplitude;
+		}
+
+		// Write the sample to the output buffer
+		outputBuffer[samplesWritten++] = writeData;
+		--renderData->remainingToneCycles;
+	}
+
+	// Output repeating oscillations of the wave at the target frequency and amplitude
+	while (samplesWritten < outputSampleCount)
+	{
+		unsigned int samplesToWrite = tonePeriod;
+
+		// Invert the polarity of the wave in preparation for the new cycle
+		renderData->polarityNegative = !renderData->polarityNegative;
+
+		// If we're starting the output on a negative cycle, negate the output data.
+		float writeData = (renderData->polarityNegative)? -amplitude: amplitude;
+
+		// If we're updating the noise register, calculate the output data based on
+		// the shift register.
+		if (channelNo == NoiseChannelNo)
+		{
+			// If the polarity has shifted from -1 to +1, read a new output bit
+			// and adjust the shift register.
+			if (!renderData->polarityNegative)
+			{
+				ClockNoiseShiftRegister(whiteNoiseSelected);
+			}
+
+			// Use the current noise bit to calculate the output data
+			writeData = (_noiseOutputMasked)? 0: amplitude;
+		}
+
+		if (samplesToWrite > (outputSampleCount - samplesWritten))
+		{
+			// If we don't have enough samples remaining in this step to complete
+			// the next cycle, clamp the number of samples to write, and save the
+			// number of additional samples we need to complete for the next step.
+			renderData->initialToneCycles = samplesToWrite;
+			renderData->remainingToneCycles = samplesToWrite - (outputSampleCount - samplesWritten);
+			samplesToWrite = (outputSampleCount - samplesWritten);
+		}
+
+		// Write a block of samples to the output buffer
+		for (unsigned int i = 0; i < samplesToWrite; ++i)
+		{
+			outputBuffer[samplesWritten++] = writeData;
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void SN76489::UpdateChannelBandLimited(unsigned int channelNo, unsigned int cycleCount, unsigned int ultrasonicTonePeriodLimit)
+{
+	ChannelRenderData* renderData = &_channelRenderData[channelNo];
+
+	// Read current register data, and calculate the output amplitude and tone period
+	float amplitude;
+	unsigned int tonePeriod;
+	bool whiteNoiseSelected;
+	GetChannelRenderParameters(channelNo, amplitude, tonePeriod, whiteNoiseSelected);
+
+	// If we were partway through a cycle on this channel when we rendered the last step,
+	// resume the last cycle. Note that the channel amplitude may have changed since the
+	// last step, so we always re-evaluate the output level at the start of the step.
+	unsigned int cyclesCompleted = 0;
+	if (renderData->remainingToneCycles > 0)
+	{
+		float level = (renderData->polarityNegative)? -amplitude: amplitude;
+		if (channelNo == NoiseChannelNo)
+		{
+			level = (_noiseOutputMasked)? 0: amplitude;
+		}
+		AddChannelStep(channelNo, 0, level);
+		cyclesCompleted = (renderData->remainingToneCycles < cycleCount)? renderData->remainingToneCycles: cycleCount;
+		renderData->remainingToneCycles -= cyclesCompleted;
+	}
+
+	// If this is a tone channel with a frequency above the Nyquist frequency of the
+	// output, nothing of the channel output would survive band limiting except its
+	// average level, which is zero. In this case, rather than inserting a step for every
+	// polarity change, we hold the output at zero and advance the polarity state directly.
+	// This is important for software such as "After Burner II", which sets the tone data
+	// to 0 in all PSG channels, causing each channel to toggle on every internal cycle.
+	if ((channelNo != NoiseChannelNo) && (tonePeriod < ultrasonicTonePeriodLimit) && (cyclesCompleted < cycleCount))
+	{
+		unsigned int cyclesRemaining = cycleCount - cyclesCompleted;
+		unsigned int cyclesStarted = (cyclesRemaining + (tonePeriod - 1)) / tonePeriod;
+		renderData->polarityNegative = ((cyclesStarted % 2) != 0)? !renderData->polarityNegative: renderData->polarityNegative;
+		unsigned int cyclesOverrun = (cyclesStarted * tonePeriod) - cyclesRemaining;
+		if (cyclesOverrun > 0)
+		{
+			renderData->initialToneCycles = tonePeriod;
+			renderData->remainingToneCycles = cyclesOverrun;
+		}
+		AddChannelStep(channelNo, cyclesCompleted, 0.0f);
+		return;
+	}
+
+	// Insert a step at the start of each new cycle of the wave
+	while (cyclesCompleted < cycleCount)
+	{
+		unsigned int cyclesToAdvance = tonePeriod;
+
+		// Invert the polarity of the wave in preparation for the new cycle, and calculate
+		// the new output level.
+		renderData->polarityNegative = !renderData->polarityNegative;
+		float level = (renderData->polarityNegative)? -amplitude: amplitude;
+		if (channelNo == NoiseChannelNo)
+		{
+			if (!renderData->polarityNegative)
+			{
+				ClockNoiseShiftRegister(whiteNoiseSelected);
+			}
+			level = (_noiseOutputMasked)? 0: amplitude;
+		}
+		AddChannelStep(channelNo, cyclesCompleted, level);
+
+		// If we don't have enough cycles remaining in this step to complete the next
+		// cycle, save the number of additional cycles we need to complete for the next
+		// step.
+		if (cyclesToAdvance > (cycleCount - cyclesCompleted))
+		{
+			renderData->initialToneCycles = cyclesToAdvance;
+			renderData->remainingToneCycles = cyclesToAdvance - (cycleCount - cyclesCompleted);
+			cyclesToAdvance = (cycleCount - cyclesCompleted);
+		}
+		cyclesCompleted += cyclesToAdvance;
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void SN76489::GetChannelRenderParameters(unsigned int channelNo, float& amplitude, unsigned int& tonePeriod, bool& whiteNoiseSelected) const
+{
 	// Read current register data, and calculate half-frequency and amplitude
 	Data volumeRegisterData(GetVolumeRegister(channelNo, AccessTarget().AccessCommitted()));
 	Data toneRegisterData(GetToneRegister(channelNo, AccessTarget().AccessCommitted()));
-	float amplitude = 0.0;
+	amplitude = 0.0;
 	if (volumeRegisterData.GetData() < 0xF)
 	{
 		//##NOTE## There is an error in SN76489.txt regarding attenuation. The document
@@ -581,7 +847,7 @@ void SN76489::UpdateChannel(unsigned int channelNo, unsigned int outputSampleCou
 	}
 
 	// If we're updating the noise register, decode the noise register data.
-	bool whiteNoiseSelected = false;
+	whiteNoiseSelected = false;
 	if (channelNo == NoiseChannelNo)
 	{
 		// Noise register format
@@ -611,27 +877,6 @@ void SN76489::UpdateChannel(unsigned int channelNo, unsigned int outputSampleCou
 		}
 	}
 
-	// If we were partway through a cycle on this channel when we rendered the last step,
-	// resume the last cycle.
-	unsigned int samplesWritten = 0;
-	while ((renderData->remainingToneCycles > 0) && (samplesWritten < outputSampleCount))
-	{
-		// If we're starting the output on a negative cycle, negate the output data.
-		float writeData = (renderData->polarityNegative)? -amplitude: amplitude;
-
-		// If we're updating the noise register, calculate the output data based on
-		// the shift register.
-		if (channelNo == NoiseChannelNo)
-		{
-			// Use the current noise bit to calculate the output data
-			writeData = (_noiseOutputMasked)? 0: amplitude;
-		}
-
-		// Write the sample to the output buffer
-		outputBuffer[samplesWritten++] = writeData;
-		--renderData->remainingToneCycles;
-	}
-
 	//##NOTE## Hardware tests on the SEGA integrated chip have shown that when the tone
 	// data is set to 0, it behaves the same as a tone data value of 1. This includes the
 	// noise channel when the period is obtained from the channel 2 tone data. This
@@ -650,55 +895,20 @@ void SN76489::UpdateChannel(unsigned int channelNo, unsigned int outputSampleCou
 		toneRegisterData = 1;
 	}
 
-	// Output repeating oscillations of the wave at the target frequency and amplitude
-	while (samplesWritten < outputSampleCount)
-	{
-		unsigned int samplesToWrite = toneRegisterData.GetData();
-
-		// Invert the polarity of the wave in preparation for the new cycle
-		renderData->polarityNegative = !renderData->polarityNegative;
-
-		// If we're starting the output on a negative cycle, negate the output data.
-		float writeData = (renderData->polarityNegative)? -amplitude: amplitude;
-
-		// If we're updating the noise register, calculate the output data based on
-		// the shift register.
-		if (channelNo == NoiseChannelNo)
-		{
-			unsigned int tappedBitMask = whiteNoiseSelected? _noiseWhiteTappedBitMask: _noisePeriodicTappedBitMask;
-
-			// If the polarity has shifted from -1 to +1, read a new output bit
-			// and adjust the shift register.
-			if (!renderData->polarityNegative)
-			{
-				Data shiftRegister(_shiftRegisterBitCount, _noiseShiftRegister);
-				_noiseOutputMasked = !shiftRegister.GetBit(0);
-				bool newUpperBit = !((shiftRegister & tappedBitMask).ParityEven());
-				shiftRegister >>= 1;
-				shiftRegister.SetBit(shiftRegister.GetBitCount() - 1, newUpperBit);
-				_noiseShiftRegister = shiftRegister.GetData();
-			}
-
-			// Use the current noise bit to calculate the output data
-			writeData = (_noiseOutputMasked)? 0: amplitude;
-		}
-
-		if (samplesToWrite > (outputSampleCount - samplesWritten))
-		{
-			// If we don't have enough samples remaining in this step to complete
-			// the next cycle, clamp the number of samples to write, and save the
-			// number of additional samples we need to complete for the next step.
-			renderData->initialToneCycles = samplesToWrite;
-			renderData->remainingToneCycles = samplesToWrite - (outputSampleCount - samplesWritten);
-			samplesToWrite = (outputSampleCount - samplesWritten);
-		}
+	tonePeriod = toneRegisterData.GetData();
+}
 
-		// Write a block of samples to the output buffer
-		for (unsigned int i = 0; i < samplesToWrite; ++i)
-		{
-			outputBuffer[samplesWritten++] = writeData;
-		}
-	}
+//----------------------------------------------------------------------------------------------------------------------
+void SN76489::ClockNoiseShiftRegister(bool whiteNoiseSelected)
+{
+	// Read a new output bit and adjust the shift register
+	unsigned int tappedBitMask = whiteNoiseSelected? _noiseWhiteTappedBitMask: _noisePeriodicTappedBitMask;
+	Data shiftRegister(_shiftRegisterBitCount, _noiseShiftRegister);
+	_noiseOutputMasked = !shiftRegister.GetBit(0);
+	bool newUpperBit = !((shiftRegister & tappedBitMask).ParityEven());
+	shiftRegister >>= 1;
+	shiftRegister.SetBit(shiftRegister.GetBitCount() - 1, newUpperBit);
+	_noiseShiftRegister = shiftRegister.GetData();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -993,6 +1203,8 @@ bool SN76489::ReadGenericData(unsigned int dataID, const DataContext* dataContex
 		return dataValue.SetValue(_noiseWhiteTappedBitMask);
 	case ISN76489DataSource::PeriodicNoiseTappedBitMask:
 		return dataValue.SetValue(_noisePeriodicTappedBitMask);
+	case ISN76489DataSource::BandLimitedSynthesisEnabled:
+		return dataValue.SetValue(_bandLimitedSynthesisEnabled);
 	case ISN76489DataSource::AudioLoggingEnabled:
 		return dataValue.SetValue(_wavLoggingEnabled);
 	case ISN76489DataSource::AudioLoggingPath:
@@ -1013,6 +1225,10 @@ bool SN76489::ReadGenericData(unsigned int dataID, const DataContext* dataContex
 		return dataValue.SetValue(_wavLoggingChannelPath[2]);
 	case ISN76489DataSource::Channel4AudioLoggingPath:
 		return dataValue.SetValue(_wavLoggingChannelPath[3]);
+	case ISN76489DataSource::RegisterLoggingEnabled:
+		return dataValue.SetValue(_registerLoggingEnabled);
+	case ISN76489DataSource::RegisterLoggingPath:
+		return dataValue.SetValue(_registerLoggingPath);
 	}
 	return false;
 }
@@ -1098,6 +1314,9 @@ bool SN76489::WriteGenericData(unsigned int dataID, const DataContext* dataConte
 		case ISN76489DataSource::VolumeRegisterLatched:
 			_latchedVolume = dataValueAsBool.GetValue();
 			return true;
+		case ISN76489DataSource::BandLimitedSynthesisEnabled:
+			_bandLimitedSynthesisEnabled = dataValueAsBool.GetValue();
+			return true;
 		case ISN76489DataSource::AudioLoggingEnabled:
 			SetAudioLoggingEnabled(dataValueAsBool.GetValue());
 			return true;
@@ -1113,6 +1332,9 @@ bool SN76489::WriteGenericData(unsigned int dataID, const DataContext* dataConte
 		case ISN76489DataSource::Channel4AudioLoggingEnabled:
 			SetChannelAudioLoggingEnabled(3, dataValueAsBool.GetValue());
 			return true;
+		case ISN76489DataSource::RegisterLoggingEnabled:
+			SetRegisterLoggingEnabled(dataValueAsBool.GetValue());
+			return true;
 		}
 	}
 	else if (dataType == IGenericAccessDataValue::DataType::Double)
@@ -1148,6 +1370,10 @@ bool SN76489::WriteGenericData(unsigned int dataID, const DataContext* dataConte
 		case ISN76489DataSource::Channel4AudioLoggingPath:
 			_wavLoggingChannelPath[3] = dataValueAsFilePath.GetValue();
 			return true;
+		case ISN76489DataSource::RegisterLoggingPath:{
+			std::unique_lock<std::mutex> lock(_registerLoggingMutex);
+			_registerLoggingPath = dataValueAsFilePath.GetValue();
+			return true;}
 		}
 	}
 	return false;
@@ -1236,8 +1462,7 @@ void SN76489::SetAudioLoggingEnabled(bool state)
 		if (state)
 		{
 			double outputFrequency = _externalClockRate / _externalClockDivider;
-			_wavLog.SetDataFormat(1, 16, (unsigned int)outputFrequency);
-			_wavLog.Open(_wavLoggingPath, Stream::WAVFile::OpenMode::WriteOnly, Stream::WAVFile::CreateMode::Create);
+			_wavLog.Open(_wavLoggingPath, 1, (unsigned int)outputFrequency);
 		}
 		else
 		{
@@ -1256,8 +1481,7 @@ void SN76489::SetChannelAudioLoggingEnabled(unsigned int channelNo, bool state)
 		if (state)
 		{
 			double outputFrequency = _externalClockRate / _externalClockDivider;
-			_wavLogChannel[channelNo].SetDataFormat(1, 16, (unsigned int)outputFrequency);
-			_wavLogChannel[channelNo].Open(_wavLoggingChannelPath[channelNo], Stream::WAVFile::OpenMode::WriteOnly, Stream::WAVFile::CreateMode::Create);
+			_wavLogChannel[channelNo].Open(_wavLoggingChannelPath[channelNo], 1, (unsigned int)outputFrequency);
 		}
 		else
 		{
@@ -1266,3 +1490,72 @@ void SN76489::SetChannelAudioLoggingEnabled(unsigned int channelNo, bool state)
 		_wavLoggingChannelEnabled[channelNo] = state;
 	}
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Register logging functions
+//----------------------------------------------------------------------------------------------------------------------
+void SN76489::SetRegisterLoggingEnabled(bool state)
+{
+	std::unique_lock<std::mutex> lock(_registerLoggingMutex);
+	if (state == _registerLoggingEnabled)
+	{
+		return;
+	}
+	if (state)
+	{
+		// Begin a new log. The current register state is written to the log by the render
+		// thread when it next begins a render operation.
+		_registerLog.Clear();
+		_registerLog.SetSN76489ClockRate((unsigned int)_externalClockRate);
+		_registerLog.SetSN76489NoiseFeedback(_noiseWhiteTappedBitMask);
+		_registerLog.SetSN76489ShiftRegisterWidth(_shiftRegisterBitCount);
+		_registerLoggingSnapshotPending = true;
+	}
+	else
+	{
+		// Extend the log to cover the time since the last register write, and save it.
+		_registerLog.AdvanceToSample(Stream::VGMFile::ConvertTimeToSampleNo(_registerLoggingTime));
+		_registerLog.Save(_registerLoggingPath);
+		_registerLog.Clear();
+	}
+	_registerLoggingEnabled = state;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void SN76489::WriteRegisterLogEntry(unsigned int registerNo, unsigned int data)
+{
+	// Our register buffer holds the complete value of each register, so we encode each
+	// register change back into the byte sequence which produces it. Volume and noise
+	// register values fit within a single latch/data byte, while tone register values
+	// require a latch/data byte followed by a data byte.
+	unsigned long long sampleNo = Stream::VGMFile::ConvertTimeToSampleNo(_registerLoggingTime);
+	unsigned int channelNo = registerNo / 2;
+	bool volumeRegister = ((registerNo % 2) == 0);
+	if (volumeRegister)
+	{
+		_registerLog.AddRegisterWrite(Stream::VGMFile::Command::SN76489Write, 0, 0x90 | (channelNo << 5) | (data & 0x0F), sampleNo);
+	}
+	else if (channelNo == NoiseChannelNo)
+	{
+		_registerLog.AddRegisterWrite(Stream::VGMFile::Command::SN76489Write, 0, 0x80 | (channelNo << 5) | (data & 0x07), sampleNo);
+	}
+	else
+	{
+		_registerLog.AddRegisterWrite(Stream::VGMFile::Command::SN76489Write, 0, 0x80 | (channelNo << 5) | (data & 0x0F), sampleNo);
+		_registerLog.AddRegisterWrite(Stream::VGMFile::Command::SN76489Write, 0, (data >> 4) & 0x3F, sampleNo);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void SN76489::WriteRegisterLogSnapshot(const AccessTarget& accessTarget)
+{
+	// Log times are measured from the point where the snapshot is taken
+	_registerLoggingTime = 0;
+
+	// Record the current volume and tone register values for each channel
+	for (unsigned int channelNo = 0; channelNo < ChannelCount; ++channelNo)
+	{
+		WriteRegisterLogEntry((channelNo * 2) + 1, GetToneRegister(channelNo, accessTarget).GetData());
+		WriteRegisterLogEntry(channelNo * 2, GetVolumeRegister(channelNo, accessTarget).GetData());
+	}
+}
@@ -49,6 +49,7 @@ References:
 #include "Device/Device.pkg"
 #include "AudioStream/AudioStream.pkg"
 #include "Stream/Stream.pkg"
+#include "BandLimitedStepBuffer.h"
 #include <mutex>
 #include <condition_variable>
 
@@ -123,6 +124,10 @@ private:
 	// Render functions
 	void RenderThread();
 	void UpdateChannel(unsigned int channelNo, unsigned int outputSampleCount, std::vector<float>& outputBuffer);
+	void UpdateChannelBandLimited(unsigned int channelNo, unsigned int cycleCount, unsigned int ultrasonicTonePeriodLimit);
+	void GetChannelRenderParameters(unsigned int channelNo, float& amplitude, unsigned int& tonePeriod, bool& whiteNoiseSelected) const;
+	void ClockNoiseShiftRegister(bool whiteNoiseSelected);
+	inline void AddChannelStep(unsigned int channelNo, unsigned int cycleOffset, float level);
 
 	// Raw register functions
 	inline Data GetVolumeRegister(unsigned int channelNo, const AccessTarget& accessTarget) const;
@@ -134,6 +139,11 @@ private:
 	void SetAudioLoggingEnabled(bool state);
 	void SetChannelAudioLoggingEnabled(unsigned int channelNo, bool state);
 
+	// Register logging functions
+	void SetRegisterLoggingEnabled(bool state);
+	void WriteRegisterLogEntry(unsigned int registerNo, unsigned int data);
+	void WriteRegisterLogSnapshot(const AccessTarget& accessTarget);
+
 private:
 	// Registers
 	mutable std::mutex _accessMutex;
@@ -159,6 +169,9 @@ private:
 	unsigned int _outputSampleRate;
 	AudioStream _outputStream;
 	std::vector<short> _outputBuffer;
+	bool _bandLimitedSynthesisActive;
+	BandLimitedStepBuffer _bandLimitedStepBuffer;
+	float _bandLimitedChannelLevel[ChannelCount];
 
 	// Render data
 	ChannelRenderData _channelRenderData[ChannelCount];
@@ -172,6 +185,7 @@ private:
 	unsigned int _shiftRegisterDefaultValue;
 	unsigned int _noiseWhiteTappedBitMask;
 	unsigned int _noisePeriodicTappedBitMask;
+	bool _bandLimitedSynthesisEnabled;
 	std::list<GenericAccessDataInfo*> _genericDataToUpdateOnShiftRegisterBitCountChange;
 
 	// Register locking
@@ -186,8 +200,16 @@ private:
 	bool _wavLoggingChannelEnabled[ChannelCount];
 	std::wstring _wavLoggingPath;
 	std::wstring _wavLoggingChannelPath[ChannelCount];
-	Stream::WAVFile _wavLog;
-	Stream::WAVFile _wavLogChannel[ChannelCount];
+	Stream::WAVFileAsyncWriter _wavLog;
+	Stream::WAVFileAsyncWriter _wavLogChannel[ChannelCount];
+
+	// Register logging
+	mutable std::mutex _registerLoggingMutex;
+	bool _registerLoggingEnabled;
+	bool _registerLoggingSnapshotPending;
+	double _registerLoggingTime;
+	std::wstring _registerLoggingPath;
+	Stream::VGMFile _registerLog;
 };
 
 #include "SN76489.inl"
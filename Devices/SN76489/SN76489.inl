@@ -35,3 +35,18 @@ void SN76489::SetToneRegister(unsigned int channelNo, const Data& adata, const A
 {
 	_reg.Write((channelNo * 2) + 1, adata, accessTarget);
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Render functions
+//----------------------------------------------------------------------------------------------------------------------
+void SN76489::AddChannelStep(unsigned int channelNo, unsigned int cycleOffset, float level)
+{
+	// Insert a band-limited step into the output if the output level of this channel has
+	// changed. Channels are mixed by averaging, so each step is scaled by the channel count.
+	float previousLevel = _bandLimitedChannelLevel[channelNo];
+	if (level != previousLevel)
+	{
+		_bandLimitedStepBuffer.AddStep((double)cycleOffset, (level - previousLevel) / (float)ChannelCount);
+		_bandLimitedChannelLevel[channelNo] = level;
+	}
+}
@@ -0,0 +1,229 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <cmath>
+#include "../BandLimitedStepBuffer.h"
+
+const double InternalSampleRate = 3579545.0 / 16.0;
+const unsigned int OutputSampleRate = 48000;
+const unsigned int ChannelCount = 4;
+const float OutputScale = 32767.0f / 6.0f;
+const unsigned int RenderSeconds = 10;
+const unsigned int SpectrumSampleCount = OutputSampleRate;
+
+// Reference implementation of the sample rate conversion performed on the output of the
+// device when rendering at the internal sample rate, which averages the source samples
+// covered by each output sample.
+void ReferenceConvertSampleRate(const std::vector<short>& sourceData, std::vector<short>& targetData, unsigned int targetSampleCount)
+{
+	targetData.resize(targetSampleCount);
+	float sampleConversionRatio = (float)sourceData.size() / (float)targetSampleCount;
+	for (unsigned int targetSampleNo = 0; targetSampleNo < targetSampleCount; ++targetSampleNo)
+	{
+		float firstSamplePoint = (float)targetSampleNo * sampleConversionRatio;
+		float lastSamplePoint = (float)(targetSampleNo + 1) * sampleConversionRatio;
+		unsigned int firstSamplePos = (unsigned int)firstSamplePoint;
+		unsigned int lastSamplePos = (unsigned int)lastSamplePoint;
+		float finalSample = 0.0f;
+		for (unsigned int sourceSampleNo = firstSamplePos; sourceSampleNo <= lastSamplePos; ++sourceSampleNo)
+		{
+			float sampleStartPoint = (sourceSampleNo == firstSamplePos)? firstSamplePoint - (float)firstSamplePos: 0.0f;
+			float sampleEndPoint = (sourceSampleNo == lastSamplePos)? lastSamplePoint - (float)lastSamplePos: 1.0f;
+			finalSample += (float)sourceData[sourceSampleNo % sourceData.size()] * (sampleEndPoint - sampleStartPoint);
+		}
+		targetData[targetSampleNo] = (short)(finalSample / (lastSamplePoint - firstSamplePoint));
+	}
+}
+
+// Renders a set of square wave tone channels at the internal sample rate, in the same way
+// as the accuracy rendering mode of the device, then converts the result to the output
+// sample rate.
+void RenderReference(const std::vector<unsigned int>& tonePeriods, unsigned int internalSampleCount, std::vector<short>& outputBuffer)
+{
+	std::vector<short> mixedBuffer(internalSampleCount);
+	std::vector<float> channelBuffer(internalSampleCount);
+	std::vector<float> mixBuffer(internalSampleCount, 0.0f);
+	for (unsigned int channelNo = 0; channelNo < tonePeriods.size(); ++channelNo)
+	{
+		bool polarityNegative = false;
+		unsigned int sampleNo = 0;
+		while (sampleNo < internalSampleCount)
+		{
+			polarityNegative = !polarityNegative;
+			float writeData = polarityNegative? -1.0f: 1.0f;
+			for (unsigned int i = 0; (i < tonePeriods[channelNo]) && (sampleNo < internalSampleCount); ++i)
+			{
+				channelBuffer[sampleNo++] = writeData;
+			}
+		}
+		for (unsigned int i = 0; i < internalSampleCount; ++i)
+		{
+			mixBuffer[i] += channelBuffer[i];
+		}
+	}
+	for (unsigned int i = 0; i < internalSampleCount; ++i)
+	{
+		mixedBuffer[i] = (short)((mixBuffer[i] / ChannelCount) * OutputScale);
+	}
+	ReferenceConvertSampleRate(mixedBuffer, outputBuffer, (unsigned int)((double)internalSampleCount * ((double)OutputSampleRate / InternalSampleRate)));
+}
+
+// Renders the same set of channels by inserting a band-limited step at each polarity
+// change, in the same way as the band-limited rendering mode of the device.
+void RenderBandLimited(const std::vector<unsigned int>& tonePeriods, unsigned int internalSampleCount, std::vector<short>& outputBuffer)
+{
+	BandLimitedStepBuffer stepBuffer;
+	stepBuffer.SetRates(InternalSampleRate, (double)OutputSampleRate);
+	const unsigned int frameLength = (unsigned int)(InternalSampleRate / 60.0);
+	std::vector<unsigned int> nextTransition(tonePeriods.size(), 0);
+	std::vector<float> channelLevel(tonePeriods.size(), 0.0f);
+	std::vector<bool> polarityNegative(tonePeriods.size(), false);
+	outputBuffer.clear();
+	for (unsigned int frameStart = 0; frameStart < internalSampleCount; frameStart += frameLength)
+	{
+		unsigned int frameEnd = (frameStart + frameLength < internalSampleCount)? frameStart + frameLength: internalSampleCount;
+		for (unsigned int channelNo = 0; channelNo < tonePeriods.size(); ++channelNo)
+		{
+			while (nextTransition[channelNo] < frameEnd)
+			{
+				polarityNegative[channelNo] = !polarityNegative[channelNo];
+				float level = polarityNegative[channelNo]? -1.0f: 1.0f;
+				stepBuffer.AddStep((double)(nextTransition[channelNo] - frameStart), (level - channelLevel[channelNo]) / (float)ChannelCount);
+				channelLevel[channelNo] = level;
+				nextTransition[channelNo] += tonePeriods[channelNo];
+			}
+		}
+		stepBuffer.EndFrame((double)(frameEnd - frameStart));
+		stepBuffer.ReadSamples(outputBuffer, OutputScale);
+	}
+}
+
+// Calculates the magnitude of a single frequency within a block of samples, after applying
+// a Hann window to the block to limit spectral leakage between frequencies.
+double GoertzelMagnitude(const std::vector<short>& samples, unsigned int startSample, unsigned int sampleCount, double frequency)
+{
+	const double pi = 3.14159265358979323846;
+	double coefficient = 2.0 * std::cos(2.0 * pi * frequency / (double)OutputSampleRate);
+	double s1 = 0.0;
+	double s2 = 0.0;
+	for (unsigned int i = 0; i < sampleCount; ++i)
+	{
+		double window = 0.5 - (0.5 * std::cos(2.0 * pi * (double)i / (double)sampleCount));
+		double s0 = ((double)samples[startSample + i] * window) + (coefficient * s1) - s2;
+		s2 = s1;
+		s1 = s0;
+	}
+	return std::sqrt((s1 * s1) + (s2 * s2) - (coefficient * s1 * s2)) / ((double)sampleCount / 4.0);
+}
+
+// Measures the level of the fundamental of a square wave, and the proportion of the signal
+// energy which doesn't fall on a harmonic of the fundamental frequency. Harmonics which
+// fall above the output Nyquist frequency are folded back into the audible range by
+// aliasing, so any energy away from the harmonics below the Nyquist frequency is aliasing.
+void MeasureSpectrum(const std::vector<short>& samples, double toneFrequency, double& fundamentalLevel, double& aliasRatio)
+{
+	unsigned int startSample = (unsigned int)(samples.size() - SpectrumSampleCount);
+	fundamentalLevel = GoertzelMagnitude(samples, startSample, SpectrumSampleCount, toneFrequency);
+	double harmonicEnergy = 0.0;
+	double aliasEnergy = 0.0;
+	for (unsigned int bin = 20; bin < 20000; bin += 5)
+	{
+		double magnitude = GoertzelMagnitude(samples, startSample, SpectrumSampleCount, (double)bin);
+		double harmonicNo = (double)bin / toneFrequency;
+		bool harmonicBin = (std::fabs(harmonicNo - std::floor(harmonicNo + 0.5)) * toneFrequency) < 5.0;
+		((harmonicBin)? harmonicEnergy: aliasEnergy) += magnitude * magnitude;
+	}
+	aliasRatio = aliasEnergy / (harmonicEnergy + aliasEnergy);
+}
+
+bool TestStepResponse()
+{
+	// Verify that a single step settles to exactly the step size
+	BandLimitedStepBuffer stepBuffer;
+	stepBuffer.SetRates(InternalSampleRate, (double)OutputSampleRate);
+	stepBuffer.AddStep(1234.5, 0.5f);
+	stepBuffer.EndFrame(InternalSampleRate / 100.0);
+	std::vector<short> outputBuffer;
+	stepBuffer.ReadSamples(outputBuffer, 1000.0f);
+	if (outputBuffer.empty() || (std::abs(outputBuffer.back() - 500) > 1))
+	{
+		std::wcout << L"Step response failed to settle to the step size" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+bool TestSpectralComparison()
+{
+	// Compare the spectra produced by both rendering modes for a range of single tone
+	// periods, from low notes up to periods near the top of the audible range.
+	bool result = true;
+	unsigned int tonePeriods[] = {254, 127, 64, 32, 16, 10};
+	for (unsigned int tonePeriod : tonePeriods)
+	{
+		std::vector<unsigned int> channels(1, tonePeriod);
+		unsigned int internalSampleCount = (unsigned int)(InternalSampleRate * 2.0);
+		std::vector<short> referenceOutput;
+		std::vector<short> bandLimitedOutput;
+		RenderReference(channels, internalSampleCount, referenceOutput);
+		RenderBandLimited(channels, internalSampleCount, bandLimitedOutput);
+
+		double toneFrequency = InternalSampleRate / (2.0 * (double)tonePeriod);
+		double referenceLevel;
+		double referenceAliasRatio;
+		double bandLimitedLevel;
+		double bandLimitedAliasRatio;
+		MeasureSpectrum(referenceOutput, toneFrequency, referenceLevel, referenceAliasRatio);
+		MeasureSpectrum(bandLimitedOutput, toneFrequency, bandLimitedLevel, bandLimitedAliasRatio);
+		double idealLevel = (4.0 / 3.14159265358979323846) * ((double)OutputScale / (double)ChannelCount);
+		double referenceDifference = 20.0 * std::log10(referenceLevel / idealLevel);
+		double levelDifference = 20.0 * std::log10(bandLimitedLevel / idealLevel);
+		std::wcout << L"Tone period " << std::setw(3) << tonePeriod << L" (" << std::fixed << std::setprecision(1) << std::setw(7) << toneFrequency << L"Hz):"
+		           << L" Fundamental reference " << std::setprecision(2) << std::setw(5) << referenceDifference << L"dB,"
+		           << L" band-limited " << std::setw(5) << levelDifference << L"dB,"
+		           << L" Alias energy reference " << std::setprecision(4) << (referenceAliasRatio * 100.0) << L"%,"
+		           << L" band-limited " << (bandLimitedAliasRatio * 100.0) << L"%" << std::endl;
+
+		// The fundamental of the band-limited output should be within 0.1dB of the level
+		// of an ideal square wave, and the band-limited output should contain no more alias
+		// energy than the reference output.
+		if ((std::fabs(levelDifference) > 0.1) || (bandLimitedAliasRatio > referenceAliasRatio))
+		{
+			std::wcout << L"Spectral comparison failed for tone period " << tonePeriod << std::endl;
+			result = false;
+		}
+	}
+	return result;
+}
+
+void TestPerformance()
+{
+	// Render several seconds of output from four channels of typical music tone periods
+	// using each rendering mode, and report the time taken.
+	std::vector<unsigned int> channels = {254, 190, 151, 32};
+	unsigned int internalSampleCount = (unsigned int)(InternalSampleRate * (double)RenderSeconds);
+	std::vector<short> outputBuffer;
+
+	std::chrono::steady_clock::time_point referenceStartTime = std::chrono::steady_clock::now();
+	RenderReference(channels, internalSampleCount, outputBuffer);
+	double referenceMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - referenceStartTime).count();
+
+	std::chrono::steady_clock::time_point bandLimitedStartTime = std::chrono::steady_clock::now();
+	RenderBandLimited(channels, internalSampleCount, outputBuffer);
+	double bandLimitedMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - bandLimitedStartTime).count();
+
+	std::wcout << L"Rendering " << RenderSeconds << L" seconds of output:" << std::endl;
+	std::wcout << L" Internal rate with conversion: " << std::setprecision(2) << referenceMilliseconds << L"ms" << std::endl;
+	std::wcout << L" Band-limited synthesis:        " << bandLimitedMilliseconds << L"ms" << std::endl;
+}
+
+int main()
+{
+	bool result = true;
+	result &= TestStepResponse();
+	result &= TestSpectralComparison();
+	TestPerformance();
+	std::wcout << (result? L"All tests passed": L"One or more tests failed") << std::endl;
+	return result? 0: 1;
+}
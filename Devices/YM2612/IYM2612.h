@@ -163,6 +163,16 @@ public:
 	inline void SetChannelAudioLoggingOutputPath(unsigned int channelNo, const std::wstring& data);
 	inline std::wstring GetOperatorAudioLoggingOutputPath(unsigned int channelNo, unsigned int operatorNo) const;
 	inline void SetOperatorAudioLoggingOutputPath(unsigned int channelNo, unsigned int operatorNo, const std::wstring& data);
+
+	// Render settings functions
+	inline bool IsSilentOperatorSkipEnabled() const;
+	inline void SetSilentOperatorSkipEnabled(bool data);
+
+	// Register logging functions
+	inline bool IsRegisterLoggingEnabled() const;
+	inline void SetRegisterLoggingEnabled(bool data);
+	inline std::wstring GetRegisterLoggingOutputPath() const;
+	inline void SetRegisterLoggingOutputPath(const std::wstring& data);
 };
 
 #include "IYM2612.inl"
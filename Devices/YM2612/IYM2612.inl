@@ -68,7 +68,12 @@ enum class IYM2612::IYM2612DataSource
 	ChannelAudioLoggingEnabled,
 	ChannelAudioLoggingPath,
 	OperatorAudioLoggingEnabled,
-	OperatorAudioLoggingPath
+	OperatorAudioLoggingPath,
+
+	SilentOperatorSkipEnabled,
+
+	RegisterLoggingEnabled,
+	RegisterLoggingPath
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1084,3 +1089,52 @@ void IYM2612::SetOperatorAudioLoggingOutputPath(unsigned int channelNo, unsigned
 	OperatorDataContext dataContext(channelNo, operatorNo);
 	WriteGenericData((unsigned int)IYM2612DataSource::OperatorAudioLoggingPath, &dataContext, genericData);
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Render settings functions
+//----------------------------------------------------------------------------------------------------------------------
+bool IYM2612::IsSilentOperatorSkipEnabled() const
+{
+	GenericAccessDataValueBool genericData;
+	ReadGenericData((unsigned int)IYM2612DataSource::SilentOperatorSkipEnabled, 0, genericData);
+	return genericData.GetValue();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void IYM2612::SetSilentOperatorSkipEnabled(bool data)
+{
+	GenericAccessDataValueBool genericData(data);
+	WriteGenericData((unsigned int)IYM2612DataSource::SilentOperatorSkipEnabled, 0, genericData);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Register logging functions
+//----------------------------------------------------------------------------------------------------------------------
+bool IYM2612::IsRegisterLoggingEnabled() const
+{
+	GenericAccessDataValueBool genericData;
+	ReadGenericData((unsigned int)IYM2612DataSource::RegisterLoggingEnabled, 0, genericData);
+	return genericData.GetValue();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void IYM2612::SetRegisterLoggingEnabled(bool data)
+{
+	GenericAccessDataValueBool genericData(data);
+	WriteGenericData((unsigned int)IYM2612DataSource::RegisterLoggingEnabled, 0, genericData);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::wstring IYM2612::GetRegisterLoggingOutputPath() const
+{
+	GenericAccessDataValueFilePath genericData;
+	ReadGenericData((unsigned int)IYM2612DataSource::RegisterLoggingPath, 0, genericData);
+	return genericData.GetValue();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void IYM2612::SetRegisterLoggingOutputPath(const std::wstring& data)
+{
+	GenericAccessDataValueFilePath genericData(data);
+	WriteGenericData((unsigned int)IYM2612DataSource::RegisterLoggingPath, 0, genericData);
+}
@@ -0,0 +1,45 @@
+#ifndef __OFFLINESYSTEMINTERFACE_H__
+#define __OFFLINESYSTEMINTERFACE_H__
+#include "DeviceInterface/DeviceInterface.pkg"
+
+// Minimal trace recorder for running devices outside a system. Tracing is always disabled.
+class NullTraceRecorder :public ITraceRecorder
+{
+public:
+	virtual unsigned int GetITraceRecorderVersion() const { return ThisITraceRecorderVersion(); }
+	virtual bool TraceRecordingEnabled() const { return false; }
+	virtual void RecordTraceEvent(EventType eventType, const char* eventName) { }
+	virtual void SetCurrentThreadTraceName(const Marshal::In<std::wstring>& threadName) { }
+};
+
+// Minimal system interface for running devices outside a system. Register writes are
+// replayed in order, so rollbacks should never be requested, and we report any that are.
+class OfflineSystemInterface :public ISystemDeviceInterface
+{
+public:
+	OfflineSystemInterface() :_rollbackRequested(false) { }
+	bool RollbackRequested() const { return _rollbackRequested; }
+	virtual unsigned int GetISystemDeviceInterfaceVersion() const { return ThisISystemDeviceInterfaceVersion(); }
+	virtual Marshal::Ret<std::wstring> GetCapturePath() const { return L""; }
+	virtual void WriteLogEvent(const ILogEntry& entry) const { }
+	virtual void FlagStopSystem() { }
+	virtual bool IsSystemRollbackFlagged() const { return false; }
+	virtual double SystemRollbackTime() const { return 0; }
+	virtual void SetSystemRollback(IDeviceContext* triggerDevice, IDeviceContext* rollbackDevice, double targetTime, double conflictingEventTime, unsigned int accessContext, void (*callbackFunction)(void*), void* callbackParams) { _rollbackRequested = true; }
+	virtual bool PerformingSingleDeviceStep() const { return false; }
+	virtual bool TranslateKeyCode(unsigned int platformKeyCode, KeyCode& inputKeyCode) const { return false; }
+	virtual bool TranslateJoystickButton(unsigned int joystickNo, unsigned int buttonNo, KeyCode& inputKeyCode) const { return false; }
+	virtual bool TranslateJoystickAxisAsButton(unsigned int joystickNo, unsigned int axisNo, bool positiveAxis, KeyCode& inputKeyCode) const { return false; }
+	virtual bool TranslateJoystickAxis(unsigned int joystickNo, unsigned int axisNo, AxisCode& inputAxisCode) const { return false; }
+	virtual void HandleInputKeyDown(KeyCode keyCode) { }
+	virtual void HandleInputKeyUp(KeyCode keyCode) { }
+	virtual void HandleInputAxisUpdate(AxisCode axisCode, float newValue) { }
+	virtual void HandleInputScrollUpdate(ScrollCode scrollCode, int scrollTicks) { }
+	virtual ITraceRecorder& GetTraceRecorder() const { return _traceRecorder; }
+
+private:
+	bool _rollbackRequested;
+	mutable NullTraceRecorder _traceRecorder;
+};
+
+#endif
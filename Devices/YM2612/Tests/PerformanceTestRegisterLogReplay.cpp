@@ -0,0 +1,322 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <string>
+#include "../YM2612.h"
+#include "../../SN76489/SN76489.h"
+#include "OfflineSystemInterface.h"
+#include "WindowsSupport/WindowsSupport.pkg"
+
+const unsigned int DefaultYM2612ClockRate = 7670453;
+const unsigned int DefaultSN76489ClockRate = 3579545;
+const unsigned int TimesliceSampleCount = 735;
+const unsigned int GeneratedLogSeconds = 30;
+
+// Results from a single replay of a register log through a device
+struct ReplayResult
+{
+	unsigned long long sampleCount;
+	double audioSeconds;
+	double milliseconds;
+	bool outputCaptured;
+	unsigned long long outputHash;
+	bool rollbackRequested;
+};
+
+// Calculates a 64-bit FNV-1a hash of the rendered output, so that the output from two
+// renders can be compared exactly.
+unsigned long long HashOutput(const std::vector<short>& outputBuffer)
+{
+	unsigned long long hash = 0xCBF29CE484222325ULL;
+	for (short sample : outputBuffer)
+	{
+		unsigned short sampleBits = (unsigned short)sample;
+		hash = (hash ^ (sampleBits & 0xFF)) * 0x100000001B3ULL;
+		hash = (hash ^ (sampleBits >> 8)) * 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+// Generates a register log exercising both sound chips, for use when no log file is
+// supplied. All six FM channels play a repeating pattern of notes with varied algorithms
+// and release rates, so that operators move regularly between active and silent states,
+// while the PSG plays tones on all three tone channels, with periodic noise bursts.
+void GenerateRegisterLog(Stream::VGMFile& registerLog)
+{
+	registerLog.Clear();
+	registerLog.SetYM2612ClockRate(DefaultYM2612ClockRate);
+	registerLog.SetSN76489ClockRate(DefaultSN76489ClockRate);
+	registerLog.SetSN76489NoiseFeedback(0x0009);
+	registerLog.SetSN76489ShiftRegisterWidth(16);
+	registerLog.AddRegisterWrite(Stream::VGMFile::Command::YM2612Port0Write, 0x22, 0x0B, 0);
+	registerLog.AddRegisterWrite(Stream::VGMFile::Command::YM2612Port0Write, 0x27, 0x00, 0);
+	registerLog.AddRegisterWrite(Stream::VGMFile::Command::YM2612Port0Write, 0x2B, 0x00, 0);
+	for (unsigned int channelNo = 0; channelNo < 6; ++channelNo)
+	{
+		Stream::VGMFile::Command command = (channelNo < 3)? Stream::VGMFile::Command::YM2612Port0Write: Stream::VGMFile::Command::YM2612Port1Write;
+		unsigned int channelIndex = channelNo % 3;
+		for (unsigned int operatorNo = 0; operatorNo < 4; ++operatorNo)
+		{
+			unsigned int operatorOffset = channelIndex + (operatorNo * 4);
+			registerLog.AddRegisterWrite(command, 0x30 + operatorOffset, 0x01 + operatorNo, 0);
+			registerLog.AddRegisterWrite(command, 0x40 + operatorOffset, (operatorNo == 3)? 0x00: 0x20 + (operatorNo * 4), 0);
+			registerLog.AddRegisterWrite(command, 0x50 + operatorOffset, 0x1F, 0);
+			registerLog.AddRegisterWrite(command, 0x60 + operatorOffset, 0x08 + channelNo, 0);
+			registerLog.AddRegisterWrite(command, 0x70 + operatorOffset, 0x04, 0);
+			registerLog.AddRegisterWrite(command, 0x80 + operatorOffset, 0x20 | (0x04 + channelNo), 0);
+			registerLog.AddRegisterWrite(command, 0x90 + operatorOffset, 0x00, 0);
+		}
+		registerLog.AddRegisterWrite(command, 0xB0 + channelIndex, ((channelNo % 4) << 3) | channelNo, 0);
+		registerLog.AddRegisterWrite(command, 0xB4 + channelIndex, 0xC0 | ((channelNo % 2) << 4) | (channelNo % 3), 0);
+	}
+
+	const unsigned int noteFrequencies[] = {0x269, 0x28E, 0x2B5, 0x2DE, 0x30A, 0x339, 0x36A, 0x39E};
+	const unsigned int noteLengthInSamples = 11025;
+	unsigned int noteCount = (GeneratedLogSeconds * Stream::VGMFile::SampleRate) / noteLengthInSamples;
+	for (unsigned int noteNo = 0; noteNo < noteCount; ++noteNo)
+	{
+		unsigned long long noteStart = (unsigned long long)noteNo * noteLengthInSamples;
+		for (unsigned int channelNo = 0; channelNo < 6; ++channelNo)
+		{
+			// Leave some channels idle for part of the pattern, so there are periods where
+			// entire channels are silent.
+			if (((noteNo + channelNo) % 5) == 4)
+			{
+				continue;
+			}
+			Stream::VGMFile::Command command = (channelNo < 3)? Stream::VGMFile::Command::YM2612Port0Write: Stream::VGMFile::Command::YM2612Port1Write;
+			unsigned int channelIndex = channelNo % 3;
+			unsigned int keyOnChannel = (channelNo < 3)? channelNo: channelNo + 1;
+			unsigned int frequency = noteFrequencies[(noteNo + (channelNo * 3)) % 8];
+			unsigned int block = 3 + (channelNo % 3);
+			registerLog.AddRegisterWrite(command, 0xA4 + channelIndex, (block << 3) | (frequency >> 8), noteStart);
+			registerLog.AddRegisterWrite(command, 0xA0 + channelIndex, frequency & 0xFF, noteStart);
+			registerLog.AddRegisterWrite(Stream::VGMFile::Command::YM2612Port0Write, 0x28, 0xF0 | keyOnChannel, noteStart);
+			registerLog.AddRegisterWrite(Stream::VGMFile::Command::YM2612Port0Write, 0x28, keyOnChannel, noteStart + (noteLengthInSamples / 3));
+		}
+		for (unsigned int channelNo = 0; channelNo < 3; ++channelNo)
+		{
+			unsigned int tonePeriod = 0x0FE - (((noteNo + channelNo) % 8) * 0x10);
+			registerLog.AddRegisterWrite(Stream::VGMFile::Command::SN76489Write, 0, 0x80 | (channelNo << 5) | (tonePeriod & 0x0F), noteStart);
+			registerLog.AddRegisterWrite(Stream::VGMFile::Command::SN76489Write, 0, (tonePeriod >> 4) & 0x3F, noteStart);
+			registerLog.AddRegisterWrite(Stream::VGMFile::Command::SN76489Write, 0, 0x90 | (channelNo << 5) | (channelNo * 2), noteStart);
+			registerLog.AddRegisterWrite(Stream::VGMFile::Command::SN76489Write, 0, 0x90 | (channelNo << 5) | 0x0F, noteStart + (noteLengthInSamples / 2));
+		}
+		if ((noteNo % 4) == 0)
+		{
+			registerLog.AddRegisterWrite(Stream::VGMFile::Command::SN76489Write, 0, 0xE4 | (noteNo % 3), noteStart);
+			registerLog.AddRegisterWrite(Stream::VGMFile::Command::SN76489Write, 0, 0xF4, noteStart);
+			registerLog.AddRegisterWrite(Stream::VGMFile::Command::SN76489Write, 0, 0xFF, noteStart + (noteLengthInSamples / 4));
+		}
+	}
+	registerLog.AdvanceToSample((unsigned long long)GeneratedLogSeconds * Stream::VGMFile::SampleRate);
+}
+
+// Reads back all samples from a wave log written by a device
+std::vector<short> ReadWAVFileSamples(const std::wstring& filePath)
+{
+	std::vector<short> samples;
+	Stream::WAVFile wavFile;
+	if (wavFile.Open(filePath, Stream::WAVFile::OpenMode::ReadOnly, Stream::WAVFile::CreateMode::Open))
+	{
+		short sample;
+		while (!wavFile.IsAtEnd() && wavFile.ReadData(sample))
+		{
+			samples.push_back(sample);
+		}
+		wavFile.Close();
+	}
+	return samples;
+}
+
+// Replays all register writes for a single device from a register log. The writes are
+// grouped into timeslices of one sixtieth of a second, and each timeslice is committed
+// in the same way the system does during normal execution, so the render thread for the
+// device processes the writes exactly as it would in a live session. The rendered output
+// goes to the normal audio output stream for the device.
+template<class DeviceType, class WriteFunction>
+ReplayResult ReplayRegisterLog(DeviceType& device, const OfflineSystemInterface& systemInterface, const std::vector<Stream::VGMFile::RegisterWrite>& registerWrites, unsigned long long totalSampleCount, WriteFunction writeFunction)
+{
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	device.BeginExecution();
+	std::vector<Stream::VGMFile::RegisterWrite>::const_iterator nextWrite = registerWrites.begin();
+	for (unsigned long long timesliceStart = 0; timesliceStart < totalSampleCount; timesliceStart += TimesliceSampleCount)
+	{
+		unsigned long long timesliceEnd = timesliceStart + TimesliceSampleCount;
+		double timesliceStartTime = Stream::VGMFile::ConvertSampleNoToTime(timesliceStart);
+		device.NotifyUpcomingTimeslice(Stream::VGMFile::ConvertSampleNoToTime(timesliceEnd) - timesliceStartTime);
+		while ((nextWrite != registerWrites.end()) && (nextWrite->sampleNo < timesliceEnd))
+		{
+			writeFunction(device, *nextWrite, Stream::VGMFile::ConvertSampleNoToTime(nextWrite->sampleNo) - timesliceStartTime);
+			++nextWrite;
+		}
+		device.ExecuteTimeslice(Stream::VGMFile::ConvertSampleNoToTime(timesliceEnd) - timesliceStartTime);
+		device.ExecuteCommit();
+	}
+	device.SuspendExecution();
+	double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+	ReplayResult result;
+	result.sampleCount = totalSampleCount;
+	result.audioSeconds = (double)totalSampleCount / (double)Stream::VGMFile::SampleRate;
+	result.milliseconds = milliseconds;
+	result.outputCaptured = false;
+	result.outputHash = 0;
+	result.rollbackRequested = systemInterface.RollbackRequested();
+	return result;
+}
+
+// Replays the YM2612 register writes from a register log. We capture the output through
+// the audio logging support in the device, which records every sample at the native
+// output rate of the device, so that the output from two renders can be compared exactly.
+ReplayResult ReplayYM2612(const Stream::VGMFile& registerLog, const std::vector<Stream::VGMFile::RegisterWrite>& registerWrites, bool silentOperatorSkipEnabled)
+{
+	wchar_t tempPath[MAX_PATH + 1];
+	DWORD tempPathLength = GetTempPathW(MAX_PATH + 1, tempPath);
+	std::wstring wavLogPath = PathCombinePaths(std::wstring(tempPath, tempPathLength), L"YM2612PerformanceTestRegisterLogReplay.wav");
+
+	OfflineSystemInterface systemInterface;
+	YM2612 device(L"YM2612", L"YM2612", 0);
+	IYM2612& deviceInterface = device;
+	device.BindToSystemInterface(&systemInterface);
+	device.BuildDevice();
+	device.SetExternalClockRate((registerLog.GetYM2612ClockRate() != 0)? (double)registerLog.GetYM2612ClockRate(): (double)DefaultYM2612ClockRate);
+	deviceInterface.SetSilentOperatorSkipEnabled(silentOperatorSkipEnabled);
+	deviceInterface.SetAudioLoggingOutputPath(wavLogPath);
+	device.ValidateDevice();
+	device.Initialize();
+	deviceInterface.SetAudioLoggingEnabled(true);
+	ReplayResult result = ReplayRegisterLog(device, systemInterface, registerWrites, registerLog.GetTotalSampleCount(), [](YM2612& targetDevice, const Stream::VGMFile::RegisterWrite& registerWrite, double accessTime)
+	{
+		if ((registerWrite.command == Stream::VGMFile::Command::YM2612Port0Write) || (registerWrite.command == Stream::VGMFile::Command::YM2612Port1Write))
+		{
+			unsigned int portBase = (registerWrite.command == Stream::VGMFile::Command::YM2612Port0Write)? 0: 2;
+			targetDevice.WriteInterface(0, portBase + 0, Data(8, registerWrite.address), 0, accessTime, 0);
+			targetDevice.WriteInterface(0, portBase + 1, Data(8, registerWrite.data), 0, accessTime, 0);
+		}
+	});
+	deviceInterface.SetAudioLoggingEnabled(false);
+
+	std::vector<short> outputSamples = ReadWAVFileSamples(wavLogPath);
+	DeleteFileW(wavLogPath.c_str());
+	result.outputCaptured = !outputSamples.empty();
+	result.outputHash = HashOutput(outputSamples);
+	return result;
+}
+
+// Replays the SN76489 register writes from a register log. Note that we don't capture the
+// output here, as enabling audio logging on the SN76489 disables band-limited synthesis,
+// which would change the render path we're measuring.
+ReplayResult ReplaySN76489(const Stream::VGMFile& registerLog, const std::vector<Stream::VGMFile::RegisterWrite>& registerWrites)
+{
+	OfflineSystemInterface systemInterface;
+	SN76489 device(L"SN76489", L"SN76489", 0);
+	device.BindToSystemInterface(&systemInterface);
+	device.BuildDevice();
+	device.SetExternalClockRate((registerLog.GetSN76489ClockRate() != 0)? (double)registerLog.GetSN76489ClockRate(): (double)DefaultSN76489ClockRate);
+	if (registerLog.GetSN76489NoiseFeedback() != 0)
+	{
+		device.SetNoiseChannelWhiteNoiseTappedBitMask(registerLog.GetSN76489NoiseFeedback());
+	}
+	if (registerLog.GetSN76489ShiftRegisterWidth() != 0)
+	{
+		device.SetShiftRegisterBitCount(registerLog.GetSN76489ShiftRegisterWidth());
+	}
+	device.ValidateDevice();
+	device.Initialize();
+	return ReplayRegisterLog(device, systemInterface, registerWrites, registerLog.GetTotalSampleCount(), [](SN76489& targetDevice, const Stream::VGMFile::RegisterWrite& registerWrite, double accessTime)
+	{
+		if (registerWrite.command == Stream::VGMFile::Command::SN76489Write)
+		{
+			targetDevice.WriteInterface(0, 0, Data(8, registerWrite.data), 0, accessTime, 0);
+		}
+	});
+}
+
+void PrintResult(const std::wstring& name, const ReplayResult& result)
+{
+	double samplesPerSecond = (result.milliseconds > 0)? ((double)result.sampleCount / (result.milliseconds / 1000.0)): 0;
+	double realtimeFactor = (result.milliseconds > 0)? ((result.audioSeconds * 1000.0) / result.milliseconds): 0;
+	std::wcout << name << L":" << std::endl;
+	std::wcout << L" Rendered " << result.sampleCount << L" samples for " << std::fixed << std::setprecision(2) << result.audioSeconds << L" seconds of audio in " << result.milliseconds << L"ms" << std::endl;
+	std::wcout << L" " << std::setprecision(0) << samplesPerSecond << L" samples/second, " << std::setprecision(2) << realtimeFactor << L"x realtime" << std::endl;
+	if (result.outputCaptured)
+	{
+		std::wcout << L" Output hash " << std::hex << std::setw(16) << std::setfill(L'0') << result.outputHash << std::dec << std::setfill(L' ') << std::endl;
+	}
+}
+
+int wmain(int argc, wchar_t* argv[])
+{
+	// Load the register log to replay, or generate one if no log was specified.
+	Stream::VGMFile registerLog;
+	if (argc > 1)
+	{
+		if (!registerLog.Load(argv[1]))
+		{
+			std::wcout << L"Failed to load register log " << argv[1] << std::endl;
+			return 1;
+		}
+	}
+	else
+	{
+		GenerateRegisterLog(registerLog);
+	}
+	std::vector<Stream::VGMFile::RegisterWrite> registerWrites;
+	if (!registerLog.DecodeRegisterWrites(registerWrites))
+	{
+		std::wcout << L"Failed to decode register log" << std::endl;
+		return 1;
+	}
+
+	bool result = true;
+	bool ym2612Present = false;
+	bool sn76489Present = false;
+	for (const Stream::VGMFile::RegisterWrite& registerWrite : registerWrites)
+	{
+		ym2612Present |= (registerWrite.command != Stream::VGMFile::Command::SN76489Write);
+		sn76489Present |= (registerWrite.command == Stream::VGMFile::Command::SN76489Write);
+	}
+
+	// Replay the YM2612 register writes with silent operator skipping enabled and
+	// disabled. Skipping silent operators is an optimization only, so the output from
+	// both renders must be identical.
+	if (ym2612Present)
+	{
+		ReplayResult skipResult = ReplayYM2612(registerLog, registerWrites, true);
+		ReplayResult fullResult = ReplayYM2612(registerLog, registerWrites, false);
+		PrintResult(L"YM2612 (silent operator skip enabled)", skipResult);
+		PrintResult(L"YM2612 (silent operator skip disabled)", fullResult);
+		if (!skipResult.outputCaptured || !fullResult.outputCaptured)
+		{
+			std::wcout << L"YM2612 output could not be captured" << std::endl;
+			result = false;
+		}
+		else if (skipResult.outputHash != fullResult.outputHash)
+		{
+			std::wcout << L"YM2612 output differs when silent operators are skipped" << std::endl;
+			result = false;
+		}
+		if (skipResult.rollbackRequested || fullResult.rollbackRequested)
+		{
+			std::wcout << L"YM2612 requested a rollback during replay" << std::endl;
+			result = false;
+		}
+	}
+
+	// Replay the SN76489 register writes
+	if (sn76489Present)
+	{
+		ReplayResult psgResult = ReplaySN76489(registerLog, registerWrites);
+		PrintResult(L"SN76489", psgResult);
+		if (psgResult.rollbackRequested)
+		{
+			std::wcout << L"SN76489 requested a rollback during replay" << std::endl;
+			result = false;
+		}
+	}
+
+	std::wcout << (result? L"All tests passed": L"One or more tests failed") << std::endl;
+	return result? 0: 1;
+}
@@ -0,0 +1,210 @@
+#include "catch.hpp"
+#include "../YM2612.h"
+#include "OfflineSystemInterface.h"
+#include "WindowsSupport/WindowsSupport.pkg"
+#include <vector>
+#include <string>
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Register writes are grouped into timeslices of one sixtieth of a second, and committed in
+// the same way the system does during normal execution.
+//----------------------------------------------------------------------------------------------------------------------
+static const double ExternalClockRate = 7670453.0;
+static const double TimesliceLength = 1000000000.0 / 60.0;
+
+//----------------------------------------------------------------------------------------------------------------------
+struct RegisterWrite
+{
+	unsigned int timesliceNo;
+	unsigned int partNo;
+	unsigned int address;
+	unsigned int data;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Sets up a channel with a fast attack and release on every operator, so that operators
+// regularly move between active and silent states, and all channels are silent within a
+// few timeslices of being keyed off.
+//----------------------------------------------------------------------------------------------------------------------
+static void AddChannelSetup(std::vector<RegisterWrite>& registerWrites, unsigned int channelNo, unsigned int algorithm, unsigned int pms, unsigned int ssgEGMode)
+{
+	unsigned int partNo = channelNo / 3;
+	unsigned int channelIndex = channelNo % 3;
+	for (unsigned int operatorNo = 0; operatorNo < 4; ++operatorNo)
+	{
+		unsigned int operatorOffset = channelIndex + (operatorNo * 4);
+		registerWrites.push_back({0, partNo, 0x30 + operatorOffset, 0x01 + operatorNo});
+		registerWrites.push_back({0, partNo, 0x40 + operatorOffset, (operatorNo == 3)? 0x00: 0x18 + (operatorNo * 4)});
+		registerWrites.push_back({0, partNo, 0x50 + operatorOffset, 0x1F});
+		registerWrites.push_back({0, partNo, 0x60 + operatorOffset, 0x0A + channelNo});
+		registerWrites.push_back({0, partNo, 0x70 + operatorOffset, 0x04});
+		registerWrites.push_back({0, partNo, 0x80 + operatorOffset, 0x2F});
+		registerWrites.push_back({0, partNo, 0x90 + operatorOffset, ssgEGMode});
+	}
+	registerWrites.push_back({0, partNo, 0xA4 + channelIndex, 0x20 | (channelIndex + 2)});
+	registerWrites.push_back({0, partNo, 0xA0 + channelIndex, 0x69 + (channelNo * 0x10)});
+	registerWrites.push_back({0, partNo, 0xB0 + channelIndex, ((channelNo % 4) << 3) | algorithm});
+	registerWrites.push_back({0, partNo, 0xB4 + channelIndex, 0xC0 | pms});
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static void AddKeyState(std::vector<RegisterWrite>& registerWrites, unsigned int timesliceNo, unsigned int channelNo, bool keyOn)
+{
+	unsigned int keyChannelCode = (channelNo < 3)? channelNo: channelNo + 1;
+	registerWrites.push_back({timesliceNo, 0, 0x28, (keyOn? 0xF0: 0x00) | keyChannelCode});
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Keys all channels on and off twice, with a long enough gap between the key off and the
+// next key on that every operator has time to become silent.
+//----------------------------------------------------------------------------------------------------------------------
+static void AddKeyPattern(std::vector<RegisterWrite>& registerWrites)
+{
+	for (unsigned int channelNo = 0; channelNo < 6; ++channelNo)
+	{
+		AddKeyState(registerWrites, 1 + channelNo, channelNo, true);
+		AddKeyState(registerWrites, 10 + channelNo, channelNo, false);
+		AddKeyState(registerWrites, 30 + channelNo, channelNo, true);
+		AddKeyState(registerWrites, 40 + channelNo, channelNo, false);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static std::wstring GetTemporaryFilePath(const std::wstring& fileName)
+{
+	wchar_t tempPath[MAX_PATH + 1];
+	DWORD tempPathLength = GetTempPathW(MAX_PATH + 1, tempPath);
+	return PathCombinePaths(std::wstring(tempPath, tempPathLength), fileName);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Renders the given register writes through the device, and returns the rendered output.
+// We capture the output through the audio logging support in the device, which records
+// every sample the render thread produces, before any sample rate conversion is performed
+// for playback.
+//----------------------------------------------------------------------------------------------------------------------
+static std::vector<short> RenderRegisterWrites(std::vector<RegisterWrite> registerWrites, unsigned int timesliceCount, bool silentOperatorSkipEnabled)
+{
+	std::stable_sort(registerWrites.begin(), registerWrites.end(), [](const RegisterWrite& first, const RegisterWrite& second) { return first.timesliceNo < second.timesliceNo; });
+	std::wstring wavLogPath = GetTemporaryFilePath(silentOperatorSkipEnabled? L"YM2612UnitTest - Skip Enabled.wav": L"YM2612UnitTest - Skip Disabled.wav");
+	OfflineSystemInterface systemInterface;
+	YM2612 device(L"YM2612", L"YM2612", 0);
+	IYM2612& deviceInterface = device;
+	device.BindToSystemInterface(&systemInterface);
+	device.BuildDevice();
+	device.SetExternalClockRate(ExternalClockRate);
+	deviceInterface.SetSilentOperatorSkipEnabled(silentOperatorSkipEnabled);
+	deviceInterface.SetAudioLoggingOutputPath(wavLogPath);
+	device.ValidateDevice();
+	device.Initialize();
+	deviceInterface.SetAudioLoggingEnabled(true);
+
+	device.BeginExecution();
+	std::vector<RegisterWrite>::const_iterator nextWrite = registerWrites.begin();
+	for (unsigned int timesliceNo = 0; timesliceNo < timesliceCount; ++timesliceNo)
+	{
+		device.NotifyUpcomingTimeslice(TimesliceLength);
+		while ((nextWrite != registerWrites.end()) && (nextWrite->timesliceNo == timesliceNo))
+		{
+			unsigned int portBase = nextWrite->partNo * 2;
+			device.WriteInterface(0, portBase + 0, Data(8, nextWrite->address), 0, 0, 0);
+			device.WriteInterface(0, portBase + 1, Data(8, nextWrite->data), 0, 0, 0);
+			++nextWrite;
+		}
+		device.ExecuteTimeslice(TimesliceLength);
+		device.ExecuteCommit();
+	}
+	device.SuspendExecution();
+	deviceInterface.SetAudioLoggingEnabled(false);
+	REQUIRE(!systemInterface.RollbackRequested());
+
+	std::vector<short> output;
+	Stream::WAVFile wavFile;
+	REQUIRE(wavFile.Open(wavLogPath, Stream::WAVFile::OpenMode::ReadOnly, Stream::WAVFile::CreateMode::Open));
+	short sample;
+	while (!wavFile.IsAtEnd() && wavFile.ReadData(sample))
+	{
+		output.push_back(sample);
+	}
+	wavFile.Close();
+	DeleteFileW(wavLogPath.c_str());
+	return output;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Skipping silent operators is an optimization only, so the output with skipping enabled
+// must be identical to the output with every operator updated on every sample.
+//----------------------------------------------------------------------------------------------------------------------
+static void RequireIdenticalOutputWithSkipEnabledAndDisabled(const std::vector<RegisterWrite>& registerWrites, unsigned int timesliceCount)
+{
+	std::vector<short> skipEnabledOutput = RenderRegisterWrites(registerWrites, timesliceCount, true);
+	std::vector<short> skipDisabledOutput = RenderRegisterWrites(registerWrites, timesliceCount, false);
+
+	// Make sure the device actually produced some sound, so that we know we're comparing
+	// something meaningful.
+	bool nonZeroSampleFound = false;
+	for (short sample : skipDisabledOutput)
+	{
+		nonZeroSampleFound |= (sample != 0);
+	}
+	REQUIRE(nonZeroSampleFound);
+
+	// Compare the two renders, and report the first sample where they differ.
+	REQUIRE(skipEnabledOutput.size() == skipDisabledOutput.size());
+	size_t firstDifferentSampleNo = 0;
+	while ((firstDifferentSampleNo < skipEnabledOutput.size()) && (skipEnabledOutput[firstDifferentSampleNo] == skipDisabledOutput[firstDifferentSampleNo]))
+	{
+		++firstDifferentSampleNo;
+	}
+	REQUIRE(firstDifferentSampleNo == skipEnabledOutput.size());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST_CASE("YM2612 silent operator skipping", "")
+{
+	std::vector<RegisterWrite> registerWrites;
+	registerWrites.push_back({0, 0, 0x27, 0x00});
+	registerWrites.push_back({0, 0, 0x2B, 0x00});
+
+	SECTION("Channels keyed on and released to silence", "")
+	{
+		registerWrites.push_back({0, 0, 0x22, 0x00});
+		for (unsigned int channelNo = 0; channelNo < 6; ++channelNo)
+		{
+			AddChannelSetup(registerWrites, channelNo, channelNo % 8, 0, 0);
+		}
+		AddKeyPattern(registerWrites);
+		RequireIdenticalOutputWithSkipEnabledAndDisabled(registerWrites, 60);
+	}
+
+	SECTION("Phase modulation active on silent channels", "")
+	{
+		// With phase modulation active, the phase counter for a silent operator is advanced
+		// on every sample rather than in a single step at the end of the render step.
+		registerWrites.push_back({0, 0, 0x22, 0x0F});
+		for (unsigned int channelNo = 0; channelNo < 6; ++channelNo)
+		{
+			AddChannelSetup(registerWrites, channelNo, channelNo % 8, ((channelNo % 2) == 0)? 7: 0, 0);
+		}
+		AddKeyPattern(registerWrites);
+		RequireIdenticalOutputWithSkipEnabledAndDisabled(registerWrites, 60);
+	}
+
+	SECTION("SSG-EG and CSM mode", "")
+	{
+		// Operators with SSG-EG enabled, and channel 3 while CSM mode is active, are never
+		// treated as silent, since either can change operator state on any sample.
+		registerWrites.push_back({0, 0, 0x22, 0x00});
+		for (unsigned int channelNo = 0; channelNo < 6; ++channelNo)
+		{
+			AddChannelSetup(registerWrites, channelNo, channelNo % 8, 0, ((channelNo % 2) == 0)? 0x0A: 0);
+		}
+		AddKeyPattern(registerWrites);
+		registerWrites.push_back({20, 0, 0x24, 0xF0});
+		registerWrites.push_back({20, 0, 0x25, 0x00});
+		registerWrites.push_back({20, 0, 0x27, 0x85});
+		registerWrites.push_back({50, 0, 0x27, 0x00});
+		RequireIdenticalOutputWithSkipEnabledAndDisabled(registerWrites, 60);
+	}
+}
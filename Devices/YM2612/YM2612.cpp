@@ -143,6 +143,10 @@ _timerAOverflowTimes(false)
 	_timerAClockDivider = 1;
 	_timerBClockDivider = 16;
 
+	// Operators which are keyed off and fully attenuated are skipped by default during
+	// rendering. This produces an identical output to evaluating every operator.
+	_silentOperatorSkipEnabled = true;
+
 	// Initialize the audio output stream
 	_outputSampleRate = 48000;	// 44100;
 	_outputStream.Open(2, 16, _outputSampleRate, _outputSampleRate/4, _outputSampleRate/20);
@@ -273,9 +277,18 @@ bool YM2612::BuildDevice()
 		}
 	}
 
+	// Initialize the register logging state
+	_registerLoggingEnabled = false;
+	_registerLoggingSnapshotPending = false;
+	_registerLoggingTime = 0;
+	std::wstring registerLoggingFileName = GetDeviceInstanceName() + L".vgm";
+	_registerLoggingPath = PathCombinePaths(captureFolder, registerLoggingFileName);
+
 	// Register each data source with the generic data access base class
 	std::wstring audioLogExtensionFilter = L"Wave file|wav";
 	std::wstring audioLogDefaultExtension = L"wav";
+	std::wstring registerLogExtensionFilter = L"VGM file|vgm";
+	std::wstring registerLogDefaultExtension = L"vgm";
 	bool result = true;
 	result &= AddGenericDataInfo((new GenericAccessDataInfo(IYM2612DataSource::RawRegister, IGenericAccessDataValue::DataType::UInt))->SetLockingSupported(true)->SetUIntMaxValue(0xFF)->SetIntDisplayMode(IGenericAccessDataValue::IntDisplayMode::Hexadecimal));
 	result &= AddGenericDataInfo((new GenericAccessDataInfo(IYM2612DataSource::TestData, IGenericAccessDataValue::DataType::UInt))->SetLockingSupported(true)->SetUIntMaxValue(0xFF)->SetIntDisplayMode(IGenericAccessDataValue::IntDisplayMode::Hexadecimal));
@@ -336,6 +349,9 @@ bool YM2612::BuildDevice()
 	result &= AddGenericDataInfo((new GenericAccessDataInfo(IYM2612DataSource::ChannelAudioLoggingPath, IGenericAccessDataValue::DataType::FilePath))->SetFilePathExtensionFilter(audioLogExtensionFilter)->SetFilePathDefaultExtension(audioLogDefaultExtension)->SetFilePathCreatingTarget(true));
 	result &= AddGenericDataInfo((new GenericAccessDataInfo(IYM2612DataSource::OperatorAudioLoggingEnabled, IGenericAccessDataValue::DataType::Bool)));
 	result &= AddGenericDataInfo((new GenericAccessDataInfo(IYM2612DataSource::OperatorAudioLoggingPath, IGenericAccessDataValue::DataType::FilePath))->SetFilePathExtensionFilter(audioLogExtensionFilter)->SetFilePathDefaultExtension(audioLogDefaultExtension)->SetFilePathCreatingTarget(true));
+	result &= AddGenericDataInfo((new GenericAccessDataInfo(IYM2612DataSource::SilentOperatorSkipEnabled, IGenericAccessDataValue::DataType::Bool)));
+	result &= AddGenericDataInfo((new GenericAccessDataInfo(IYM2612DataSource::RegisterLoggingEnabled, IGenericAccessDataValue::DataType::Bool)));
+	result &= AddGenericDataInfo((new GenericAccessDataInfo(IYM2612DataSource::RegisterLoggingPath, IGenericAccessDataValue::DataType::FilePath))->SetFilePathExtensionFilter(registerLogExtensionFilter)->SetFilePathDefaultExtension(registerLogDefaultExtension)->SetFilePathCreatingTarget(true));
 
 	// Register page layouts for generic access to this device
 	GenericAccessPage* audioLoggingPage = new GenericAccessPage(L"Audio Logging", L"Audio Logging");
@@ -377,6 +393,9 @@ bool YM2612::BuildDevice()
 		operatorGroup->AddEntry(channelGroupForOperators);
 	}
 	audioLoggingPage->AddEntry(operatorGroup);
+	audioLoggingPage->AddEntry((new GenericAccessGroup(L"Register Write Log"))
+	                    ->AddEntry(new GenericAccessGroupDataEntry(IYM2612DataSource::RegisterLoggingEnabled, L"Log Enabled"))
+	                    ->AddEntry(new GenericAccessGroupDataEntry(IYM2612DataSource::RegisterLoggingPath, L"Log Path")));
 	result &= AddGenericAccessPage(audioLoggingPage);
 
 	return result;
@@ -871,11 +890,22 @@ void YM2612::ExecuteCommit()
 	}
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+bool YM2612::UsesParallelCommit() const
+{
+	// Our commit and rollback operations only touch our own register and timer buffers,
+	// and hand timeslices over to our own render thread, so we can safely be committed in
+	// parallel with other devices.
+	return true;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 //##TODO## Refactor this function to break it down into a set of smaller functions
 void YM2612::RenderThread()
 {
 	std::unique_lock<std::mutex> lock(_renderThreadMutex);
+	ITraceRecorder& traceRecorder = GetSystemInterface().GetTraceRecorder();
+	traceRecorder.SetCurrentThreadTraceName(L"YM2612Render - " + GetDeviceInstanceName());
 
 	// Start the render loop
 	bool done = false;
@@ -938,6 +968,21 @@ void YM2612::RenderThread()
 		size_t outputBufferPos = _outputBuffer.size();
 //		unsigned int outputBufferMultiplexedPos = 0;
 //		std::vector<short> outputBufferMultiplexed(0);
+		// Hold the wave logging lock for the entire render operation, rather than taking
+		// it for each individual sample. Captured samples are only appended to in-memory
+		// blocks here, with the file writes performed on a separate thread.
+		std::unique_lock<std::mutex> waveLoggingLock(_waveLoggingMutex);
+
+		// Hold the register logging lock for the entire render operation too. If register
+		// logging has just been enabled, we record the committed register state at the
+		// start of this timeslice before any other writes, so that the log reproduces the
+		// correct output when replayed from the point where capture began.
+		std::unique_lock<std::mutex> registerLoggingLock(_registerLoggingMutex);
+		if (_registerLoggingEnabled && _registerLoggingSnapshotPending)
+		{
+			WriteRegisterLogSnapshot(accessTarget);
+			_registerLoggingSnapshotPending = false;
+		}
 		bool moreSamplesRemaining = true;
 		while (moreSamplesRemaining)
 		{
@@ -946,7 +991,9 @@ void YM2612::RenderThread()
 			// the end of a timeslice. Negative times won't cause writes to be processed at
 			// the incorrect time under the current model, but we do need to ensure that
 			// remainingRenderTime isn't negative before attempting to generate an output.
-			_remainingRenderTime += _reg.GetNextWriteTime(regTimesliceCopy);
+			double nextWriteTime = _reg.GetNextWriteTime(regTimesliceCopy);
+			_remainingRenderTime += nextWriteTime;
+			_registerLoggingTime += nextWriteTime;
 
 			//##DEBUG##
 //			std::wcout << "YM2612 Buffer:\t" << remainingRenderTime << '\t' << outputBuffer.size() << '\t' << ((unsigned int)(remainingRenderTime / fmClockPeriod) * 2) << '\n';
@@ -963,6 +1010,30 @@ void YM2612::RenderThread()
 				_outputBuffer.resize(_outputBuffer.size() + outputSampleCount);
 	//			outputBufferMultiplexed.resize(outputBufferMultiplexed.size() + (outputSampleCount * channelCount));
 
+				// Determine which operators are currently silent. An operator is silent when
+				// it has been keyed off and its envelope has reached maximum attenuation, in
+				// which case its output is always 0, and its envelope generator state can't
+				// change. Since register changes are only applied between render steps, an
+				// operator which is silent now will remain silent until at least the end of
+				// this render step. We skip the envelope generator and operator unit for
+				// silent operators, and where the phase increment is constant, we simply
+				// count the phase generator updates we skip, and advance the phase counter in
+				// a single step once the render step is complete. This keeps the phase
+				// counter identical to the value it would have if every operator was updated.
+				bool silentOperatorSkipEnabled = _silentOperatorSkipEnabled.load();
+				bool operatorSilent[ChannelCount][OperatorCount];
+				unsigned int skippedPhaseUpdateCount[ChannelCount][OperatorCount];
+				bool channelPhaseModulationEnabled[ChannelCount];
+				for (unsigned int channelNo = 0; channelNo < ChannelCount; ++channelNo)
+				{
+					channelPhaseModulationEnabled[channelNo] = (GetPMSData(GetChannelBlockAddressOffset(channelNo), accessTarget) != 0);
+					for (unsigned int operatorNo = 0; operatorNo < OperatorCount; ++operatorNo)
+					{
+						operatorSilent[channelNo][operatorNo] = silentOperatorSkipEnabled && IsOperatorSilent(channelNo, operatorNo, GetOperatorBlockAddressOffset(channelNo, operatorNo), accessTarget);
+						skippedPhaseUpdateCount[channelNo][operatorNo] = 0;
+					}
+				}
+
 				//##TODO## Change the way we advance the render thread so that the update
 				// steps are driven by integer cycle numbers, rather than timeslice values.
 				// Refer to the timer update function.
@@ -1001,7 +1072,22 @@ void YM2612::RenderThread()
 					{
 						for (unsigned int operatorNo = 0; operatorNo < OperatorCount; ++operatorNo)
 						{
-							UpdateOperator(channelNo, operatorNo, updateEnvelopeGenerator);
+							if (!operatorSilent[channelNo][operatorNo])
+							{
+								UpdateOperator(channelNo, operatorNo, updateEnvelopeGenerator);
+								operatorSilent[channelNo][operatorNo] = silentOperatorSkipEnabled && IsOperatorSilent(channelNo, operatorNo, GetOperatorBlockAddressOffset(channelNo, operatorNo), accessTarget);
+							}
+							else if (channelPhaseModulationEnabled[channelNo] && (((_currentLFOCounter >> 2) & ((1 << PhaseModIndexBitCount) - 1)) != 0))
+							{
+								// Phase modulation is currently being applied to this channel,
+								// so the phase increment varies with the LFO counter. In this
+								// case we need to update the phase generator directly.
+								UpdatePhaseGenerator(channelNo, operatorNo, GetChannelBlockAddressOffset(channelNo), GetOperatorBlockAddressOffset(channelNo, operatorNo));
+							}
+							else
+							{
+								++skippedPhaseUpdateCount[channelNo][operatorNo];
+							}
 						}
 					}
 
@@ -1041,80 +1127,85 @@ void YM2612::RenderThread()
 							// the target channel and operator
 							unsigned int operatorAddressOffset = GetOperatorBlockAddressOffset(channelNo, operatorNo);
 
-							// Calculate the phase modulation input for the operator unit
-							int phaseModulation = 0;
-							if ((operatorNo == OPERATOR2) && ((algorithmNo == 0) || (algorithmNo == 3) || (algorithmNo == 4) || (algorithmNo == 5) || (algorithmNo == 6)))
-							{
-								phaseModulation = _operatorOutput[channelNo][OPERATOR1];
-							}
-							else if ((operatorNo == OPERATOR3) && ((algorithmNo == 0) || (algorithmNo == 2)))
-							{
-								phaseModulation = _operatorOutput[channelNo][OPERATOR2];
-							}
-							else if ((operatorNo == OPERATOR3) && (algorithmNo == 1))
-							{
-								phaseModulation = _operatorOutput[channelNo][OPERATOR1] + _operatorOutput[channelNo][OPERATOR2];
-							}
-							else if ((operatorNo == OPERATOR3) && (algorithmNo == 5))
-							{
-								phaseModulation = _operatorOutput[channelNo][OPERATOR1];
-							}
-							else if ((operatorNo == OPERATOR4) && ((algorithmNo == 0) || (algorithmNo == 1) || (algorithmNo == 4)))
-							{
-								phaseModulation = _operatorOutput[channelNo][OPERATOR3];
-							}
-							else if ((operatorNo == OPERATOR4) && (algorithmNo == 2))
-							{
-								phaseModulation = _operatorOutput[channelNo][OPERATOR1] + _operatorOutput[channelNo][OPERATOR3];
-							}
-							else if ((operatorNo == OPERATOR4) && (algorithmNo == 3))
-							{
-								phaseModulation = _operatorOutput[channelNo][OPERATOR2] + _operatorOutput[channelNo][OPERATOR3];
-							}
-							else if ((operatorNo == OPERATOR4) && (algorithmNo == 5))
-							{
-								phaseModulation = _operatorOutput[channelNo][OPERATOR1];
-							}
-							// Convert the 14-bit operator unit output from the modulator into
-							// a 10-bit phase modulation input. Note that the bits are not
-							// mapped quite the way you might expect. The operator output is
-							// shifted down by 1 when it is mapped to the phase modulation
-							// input. The remaining upper 3 bits of the operator output are
-							// discarded.
-							//  ---------------------------------------------------------
-							//  |               Operator Output (14-bit)                |
-							//  |-------------------------------------------------------|
-							//  |13 |12 |11 |10 | 9 | 8 | 7 | 6 | 5 | 4 | 3 | 2 | 1 | 0 |
-							//  ------------=========================================----
-							//              |       Modulation Input (10-bit)       |
-							//              |---------------------------------------|
-							//              | 9 | 8 | 7 | 6 | 5 | 4 | 3 | 2 | 1 | 0 |
-							//              -----------------------------------------
-							phaseModulation >>= 1;
-							phaseModulation &= ((1 << PhaseBitCount) - 1);
-
-							// If we're updating operator 1, calculate the self-feedback value
-							// for phase modulation.
-							if (operatorNo == OPERATOR1)
+							// Silent operators are fully attenuated, so their output is always 0
+							int result = 0;
+							if (!operatorSilent[channelNo][operatorNo])
 							{
-								unsigned int feedback = GetFeedbackData(channelAddressOffset, accessTarget);
-								if (feedback > 0)
+								// Calculate the phase modulation input for the operator unit
+								int phaseModulation = 0;
+								if ((operatorNo == OPERATOR2) && ((algorithmNo == 0) || (algorithmNo == 3) || (algorithmNo == 4) || (algorithmNo == 5) || (algorithmNo == 6)))
 								{
-									phaseModulation = _feedbackBuffer[channelNo][0] + _feedbackBuffer[channelNo][1];
-									phaseModulation >>= (10 - feedback);
-
-									phaseModulation &= ((1 << PhaseBitCount) - 1);
+									phaseModulation = _operatorOutput[channelNo][OPERATOR1];
+								}
+								else if ((operatorNo == OPERATOR3) && ((algorithmNo == 0) || (algorithmNo == 2)))
+								{
+									phaseModulation = _operatorOutput[channelNo][OPERATOR2];
+								}
+								else if ((operatorNo == OPERATOR3) && (algorithmNo == 1))
+								{
+									phaseModulation = _operatorOutput[channelNo][OPERATOR1] + _operatorOutput[channelNo][OPERATOR2];
+								}
+								else if ((operatorNo == OPERATOR3) && (algorithmNo == 5))
+								{
+									phaseModulation = _operatorOutput[channelNo][OPERATOR1];
+								}
+								else if ((operatorNo == OPERATOR4) && ((algorithmNo == 0) || (algorithmNo == 1) || (algorithmNo == 4)))
+								{
+									phaseModulation = _operatorOutput[channelNo][OPERATOR3];
+								}
+								else if ((operatorNo == OPERATOR4) && (algorithmNo == 2))
+								{
+									phaseModulation = _operatorOutput[channelNo][OPERATOR1] + _operatorOutput[channelNo][OPERATOR3];
+								}
+								else if ((operatorNo == OPERATOR4) && (algorithmNo == 3))
+								{
+									phaseModulation = _operatorOutput[channelNo][OPERATOR2] + _operatorOutput[channelNo][OPERATOR3];
+								}
+								else if ((operatorNo == OPERATOR4) && (algorithmNo == 5))
+								{
+									phaseModulation = _operatorOutput[channelNo][OPERATOR1];
+								}
+								// Convert the 14-bit operator unit output from the modulator into
+								// a 10-bit phase modulation input. Note that the bits are not
+								// mapped quite the way you might expect. The operator output is
+								// shifted down by 1 when it is mapped to the phase modulation
+								// input. The remaining upper 3 bits of the operator output are
+								// discarded.
+								//  ---------------------------------------------------------
+								//  |               Operator Output (14-bit)                |
+								//  |-------------------------------------------------------|
+								//  |13 |12 |11 |10 | 9 | 8 | 7 | 6 | 5 | 4 | 3 | 2 | 1 | 0 |
+								//  ------------=========================================----
+								//              |       Modulation Input (10-bit)       |
+								//              |---------------------------------------|
+								//              | 9 | 8 | 7 | 6 | 5 | 4 | 3 | 2 | 1 | 0 |
+								//              -----------------------------------------
+								phaseModulation >>= 1;
+								phaseModulation &= ((1 << PhaseBitCount) - 1);
+
+								// If we're updating operator 1, calculate the self-feedback value
+								// for phase modulation.
+								if (operatorNo == OPERATOR1)
+								{
+									unsigned int feedback = GetFeedbackData(channelAddressOffset, accessTarget);
+									if (feedback > 0)
+									{
+										phaseModulation = _feedbackBuffer[channelNo][0] + _feedbackBuffer[channelNo][1];
+										phaseModulation >>= (10 - feedback);
+
+										phaseModulation &= ((1 << PhaseBitCount) - 1);
+									}
 								}
-							}
 
-							// Read the current phase value from the phase generator
-							unsigned int phase = GetCurrentPhase(channelNo, operatorNo);
+								// Read the current phase value from the phase generator
+								unsigned int phase = GetCurrentPhase(channelNo, operatorNo);
 
-							// Read the current attenuation value from the envelope generator
-							unsigned int attenuation = GetOutputAttenuation(channelNo, operatorNo, channelAddressOffset, operatorAddressOffset);
+								// Read the current attenuation value from the envelope generator
+								unsigned int attenuation = GetOutputAttenuation(channelNo, operatorNo, channelAddressOffset, operatorAddressOffset);
 
-							// Calculate the output from the operator unit
-							int result = CalculateOperator(phase, phaseModulation, attenuation);
+								// Calculate the output from the operator unit
+								result = CalculateOperator(phase, phaseModulation, attenuation);
+							}
 							_operatorOutput[channelNo][operatorNo] = result;
 
 							// If we're updating operator 1, add the output sample to the
@@ -1128,13 +1219,12 @@ void YM2612::RenderThread()
 							// Write to the wav log
 							if (_wavLoggingOperatorEnabled[channelNo][operatorNo])
 							{
-								std::unique_lock<std::mutex> waveLoggingLock(_waveLoggingMutex);
 								short outputSample;
 								float operatorOutputNormalized = (float)_operatorOutput[channelNo][operatorNo] / ((1 << (OperatorOutputBitCount - 1)) - 1);
 								// We halve the amplitude of the operator output just to
 								// make it a little easier to work with.
 								outputSample = (short)(operatorOutputNormalized * (32767.0f/2));
-								_wavLogOperator[channelNo][operatorNo].WriteData(outputSample);
+								_wavLogOperator[channelNo][operatorNo].WriteSample(outputSample);
 							}
 						}
 
@@ -1267,7 +1357,6 @@ void YM2612::RenderThread()
 						// Write to the wave log
 						if (_wavLoggingChannelEnabled[channelNo])
 						{
-							std::unique_lock<std::mutex> waveLoggingLock(_waveLoggingMutex);
 							short outputSampleLeft;
 							short outputSampleRight;
 							float channelOutputLeftNormalized = (float)channelOutput[channelNo][0] / ((1 << (AccumulatorOutputBitCount - 1)) - 1);
@@ -1276,8 +1365,8 @@ void YM2612::RenderThread()
 							// make it a little easier to work with.
 							outputSampleLeft = (short)(channelOutputLeftNormalized * (32767.0f/2));
 							outputSampleRight = (short)(channelOutputRightNormalized * (32767.0f/2));
-							_wavLogChannel[channelNo].WriteData(outputSampleLeft);
-							_wavLogChannel[channelNo].WriteData(outputSampleRight);
+							_wavLogChannel[channelNo].WriteSample(outputSampleLeft);
+							_wavLogChannel[channelNo].WriteSample(outputSampleRight);
 						}
 					}
 
@@ -1328,10 +1417,8 @@ void YM2612::RenderThread()
 					// Write to the wave log
 					if (_wavLoggingEnabled)
 					{
-						std::unique_lock<std::mutex> waveLoggingLock(_waveLoggingMutex);
-						Stream::ViewBinary wavlogStream(_wavLog);
-						wavlogStream << outputSampleLeft;
-						wavlogStream << outputSampleRight;
+						_wavLog.WriteSample(outputSampleLeft);
+						_wavLog.WriteSample(outputSampleRight);
 					}
 
 					////Calculate the true multiplexed output for the YM2612
@@ -1355,11 +1442,33 @@ void YM2612::RenderThread()
 
 					_remainingRenderTime -= fmClockPeriod;
 				}
+
+				// Apply the phase generator updates we skipped for silent operators. The
+				// phase increment for each of these updates was unaffected by phase
+				// modulation, and the registers it depends on can't change within a render
+				// step, so all the skipped updates can be applied together.
+				for (unsigned int channelNo = 0; channelNo < ChannelCount; ++channelNo)
+				{
+					for (unsigned int operatorNo = 0; operatorNo < OperatorCount; ++operatorNo)
+					{
+						if (skippedPhaseUpdateCount[channelNo][operatorNo] > 0)
+						{
+							unsigned int phaseIncrement = CalculatePhaseIncrement(channelNo, operatorNo, GetChannelBlockAddressOffset(channelNo), GetOperatorBlockAddressOffset(channelNo, operatorNo), 0);
+							_operatorData[channelNo][operatorNo].phaseCounter += phaseIncrement * skippedPhaseUpdateCount[channelNo][operatorNo];
+						}
+					}
+				}
 			}
 
 			RandomTimeAccessBuffer<Data, double>::WriteInfo writeInfo = _reg.GetWriteInfo(0, regTimesliceCopy);
 			if (writeInfo.exists)
 			{
+				// Record this register write in the register log
+				if (_registerLoggingEnabled)
+				{
+					WriteRegisterLogEntry(writeInfo.writeAddress, writeInfo.newValue.GetData());
+				}
+
 				// Handle any special case register changes
 				switch (writeInfo.writeAddress)
 				{
@@ -1441,6 +1550,8 @@ void YM2612::RenderThread()
 			}
 			moreSamplesRemaining = _reg.AdvanceByStep(regTimesliceCopy);
 		}
+		registerLoggingLock.unlock();
+		waveLoggingLock.unlock();
 
 		// Play the mixed audio stream. Note that we fold samples from successive render
 		// operations together, ensuring that we only send data to the output audio stream
@@ -1454,6 +1565,7 @@ void YM2612::RenderThread()
 			AudioStream::AudioBuffer* outputBufferFinal = _outputStream.CreateAudioBuffer(outputSampleCount, 2);
 			if (outputBufferFinal != 0)
 			{
+				ITraceRecorder::Scope traceScope(traceRecorder, "AudioBufferSubmit");
 				_outputStream.ConvertSampleRate(_outputBuffer, internalSampleCount, 2, outputBufferFinal->buffer, outputSampleCount);
 				_outputStream.PlayBuffer(outputBufferFinal);
 			}
@@ -1666,6 +1778,32 @@ void YM2612::UpdateOperator(unsigned int channelNo, unsigned int operatorNo, boo
 	UpdatePhaseGenerator(channelNo, operatorNo, channelAddressOffset, operatorAddressOffset);
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+bool YM2612::IsOperatorSilent(unsigned int channelNo, unsigned int operatorNo, unsigned int operatorAddressOffset, const AccessTarget& accessTarget) const
+{
+	const OperatorData* state = &_operatorData[channelNo][operatorNo];
+
+	// An operator is silent when it is in the release phase with the internal attenuation
+	// value at its maximum, and no key-on event is pending. At this level of attenuation,
+	// the output from the operator unit is always 0, regardless of TL, amplitude
+	// modulation, or the current phase. Since the release phase clamps the attenuation at
+	// its maximum value, the envelope generator state can't change from this point until
+	// key-on occurs. When SSG-EG is enabled, the output inversion state and phase counter
+	// can still be altered each sample, and CSM mode can trigger key-on events for channel
+	// 3 on any sample, so we never treat operators as silent in these cases.
+	if ((state->phase != OperatorData::ADSR_RELEASE)
+		|| (state->attenuation != ((1 << AttenuationBitCount) - 1))
+		|| state->keyon || state->csmKeyOn || state->keyonPrevious)
+	{
+		return false;
+	}
+	if ((channelNo == CHANNEL3) && (GetCH3Mode(accessTarget) == 2))
+	{
+		return false;
+	}
+	return !GetSSGEnabled(operatorAddressOffset, accessTarget);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // This function implements the KeyCode formula as described on page 25 of the YM2608
 // documentation. Result is a 5-bit number with the following structure:
@@ -1693,10 +1831,17 @@ unsigned int YM2612::CalculateKeyCode(unsigned int block, unsigned int fnumber)
 // Phase generator functions
 //----------------------------------------------------------------------------------------------------------------------
 void YM2612::UpdatePhaseGenerator(unsigned int channelNo, unsigned int operatorNo, unsigned int channelAddressOffset, unsigned int operatorAddressOffset)
+{
+	// Apply the phase increment to the phase counter
+	OperatorData* state = &_operatorData[channelNo][operatorNo];
+	state->phaseCounter += CalculatePhaseIncrement(channelNo, operatorNo, channelAddressOffset, operatorAddressOffset, _currentLFOCounter);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int YM2612::CalculatePhaseIncrement(unsigned int channelNo, unsigned int operatorNo, unsigned int channelAddressOffset, unsigned int operatorAddressOffset, unsigned int lfoCounter) const
 {
 	AccessTarget accessTarget;
 	accessTarget.AccessCommitted();
-	OperatorData* state = &_operatorData[channelNo][operatorNo];
 
 	// This algorithm is primarily based on the F-Number calculation given in the YM2608
 	// manual, page 24. That formula is as follows:
@@ -1719,7 +1864,7 @@ void YM2612::UpdatePhaseGenerator(unsigned int channelNo, unsigned int operatorN
 	//      |-------------------|
 	//      | 4 | 3 | 2 | 1 | 0 |
 	//      ---------------------
-	Data pmCounter(PhaseModIndexBitCount, _currentLFOCounter >> 2);
+	Data pmCounter(PhaseModIndexBitCount, lfoCounter >> 2);
 	unsigned int pmSensitivity = GetPMSData(channelAddressOffset, accessTarget);
 	if ((pmCounter != 0) && (pmSensitivity != 0))
 	{
@@ -1838,9 +1983,7 @@ void YM2612::UpdatePhaseGenerator(unsigned int channelNo, unsigned int operatorN
 	{
 		phaseIncrement *= mul;
 	}
-
-	// Apply the phase increment to the phase counter
-	state->phaseCounter += phaseIncrement;
+	return phaseIncrement;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -3393,6 +3536,12 @@ bool YM2612::ReadGenericData(unsigned int dataID, const DataContext* dataContext
 	case IYM2612DataSource::OperatorAudioLoggingPath:{
 		const OperatorDataContext& operatorDataContext = *((const OperatorDataContext*)dataContext);
 		return dataValue.SetValue(_wavLoggingOperatorPath[operatorDataContext.channelNo][operatorDataContext.operatorNo]);}
+	case IYM2612DataSource::SilentOperatorSkipEnabled:
+		return dataValue.SetValue(_silentOperatorSkipEnabled.load());
+	case IYM2612DataSource::RegisterLoggingEnabled:
+		return dataValue.SetValue(_registerLoggingEnabled);
+	case IYM2612DataSource::RegisterLoggingPath:
+		return dataValue.SetValue(_registerLoggingPath);
 	}
 	return false;
 }
@@ -3762,6 +3911,22 @@ bool YM2612::WriteGenericData(unsigned int dataID, const DataContext* dataContex
 		const OperatorDataContext& operatorDataContext = *((const OperatorDataContext*)dataContext);
 		_wavLoggingOperatorPath[operatorDataContext.channelNo][operatorDataContext.operatorNo] = dataValueAsFilePath.GetValue();
 		return true;}
+	case IYM2612DataSource::SilentOperatorSkipEnabled:{
+		if (dataType != IGenericAccessDataValue::DataType::Bool) return false;
+		IGenericAccessDataValueBool& dataValueAsBool = (IGenericAccessDataValueBool&)dataValue;
+		_silentOperatorSkipEnabled.store(dataValueAsBool.GetValue());
+		return true;}
+	case IYM2612DataSource::RegisterLoggingEnabled:{
+		if (dataType != IGenericAccessDataValue::DataType::Bool) return false;
+		IGenericAccessDataValueBool& dataValueAsBool = (IGenericAccessDataValueBool&)dataValue;
+		SetRegisterLoggingEnabled(dataValueAsBool.GetValue());
+		return true;}
+	case IYM2612DataSource::RegisterLoggingPath:{
+		if (dataType != IGenericAccessDataValue::DataType::FilePath) return false;
+		IGenericAccessDataValueFilePath& dataValueAsFilePath = (IGenericAccessDataValueFilePath&)dataValue;
+		std::unique_lock<std::mutex> lock(_registerLoggingMutex);
+		_registerLoggingPath = dataValueAsFilePath.GetValue();
+		return true;}
 	}
 	return false;
 }
@@ -4021,36 +4186,38 @@ bool YM2612::SetGenericDataLocked(unsigned int dataID, const DataContext* dataCo
 //----------------------------------------------------------------------------------------------------------------------
 void YM2612::SetAudioLoggingEnabled(bool state)
 {
+	std::unique_lock<std::mutex> lock(_waveLoggingMutex);
 	double fmClock = (_externalClockRate / _fmClockDivider) / _outputClockDivider;
-	ToggleLoggingEnabledState(_wavLog, _wavLoggingPath, _wavLoggingEnabled, state, 2, 16, (unsigned int)fmClock);
+	ToggleLoggingEnabledState(_wavLog, _wavLoggingPath, _wavLoggingEnabled, state, 2, (unsigned int)fmClock);
 	_wavLoggingEnabled = state;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void YM2612::SetChannelAudioLoggingEnabled(unsigned int channelNo, bool state)
 {
+	std::unique_lock<std::mutex> lock(_waveLoggingMutex);
 	double fmClock = (_externalClockRate / _fmClockDivider) / _outputClockDivider;
-	ToggleLoggingEnabledState(_wavLogChannel[channelNo], _wavLoggingChannelPath[channelNo], _wavLoggingChannelEnabled[channelNo], state, 2, 16, (unsigned int)fmClock);
+	ToggleLoggingEnabledState(_wavLogChannel[channelNo], _wavLoggingChannelPath[channelNo], _wavLoggingChannelEnabled[channelNo], state, 2, (unsigned int)fmClock);
 	_wavLoggingChannelEnabled[channelNo] = state;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void YM2612::SetOperatorAudioLoggingEnabled(unsigned int channelNo, unsigned int operatorNo, bool state)
 {
+	std::unique_lock<std::mutex> lock(_waveLoggingMutex);
 	double fmClock = (_externalClockRate / _fmClockDivider) / _outputClockDivider;
-	ToggleLoggingEnabledState(_wavLogOperator[channelNo][operatorNo], _wavLoggingOperatorPath[channelNo][operatorNo], _wavLoggingOperatorEnabled[channelNo][operatorNo], state, 1, 16, (unsigned int)fmClock);
+	ToggleLoggingEnabledState(_wavLogOperator[channelNo][operatorNo], _wavLoggingOperatorPath[channelNo][operatorNo], _wavLoggingOperatorEnabled[channelNo][operatorNo], state, 1, (unsigned int)fmClock);
 	_wavLoggingOperatorEnabled[channelNo][operatorNo] = state;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-bool YM2612::ToggleLoggingEnabledState(Stream::WAVFile& wavFile, const std::wstring& fileName, bool currentState, bool newState, unsigned int channelCount, unsigned int bitsPerSample, unsigned int samplesPerSec)
+bool YM2612::ToggleLoggingEnabledState(Stream::WAVFileAsyncWriter& wavFile, const std::wstring& fileName, bool currentState, bool newState, unsigned int channelCount, unsigned int samplesPerSec)
 {
 	if (newState != currentState)
 	{
 		if (newState)
 		{
-			wavFile.SetDataFormat(channelCount, bitsPerSample, samplesPerSec);
-			wavFile.Open(fileName, Stream::WAVFile::OpenMode::WriteOnly, Stream::WAVFile::CreateMode::Create);
+			wavFile.Open(fileName, channelCount, samplesPerSec);
 		}
 		else
 		{
@@ -4059,3 +4226,102 @@ bool YM2612::ToggleLoggingEnabledState(Stream::WAVFile& wavFile, const std::wstr
 	}
 	return newState;
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Register logging functions
+//----------------------------------------------------------------------------------------------------------------------
+void YM2612::SetRegisterLoggingEnabled(bool state)
+{
+	std::unique_lock<std::mutex> lock(_registerLoggingMutex);
+	if (state == _registerLoggingEnabled)
+	{
+		return;
+	}
+	if (state)
+	{
+		// Begin a new log. The current register state is written to the log by the render
+		// thread when it next begins a render operation.
+		_registerLog.Clear();
+		_registerLog.SetYM2612ClockRate((unsigned int)_externalClockRate);
+		_registerLoggingSnapshotPending = true;
+	}
+	else
+	{
+		// Extend the log to cover the time since the last register write, and save it.
+		_registerLog.AdvanceToSample(Stream::VGMFile::ConvertTimeToSampleNo(_registerLoggingTime));
+		_registerLog.Save(_registerLoggingPath);
+		_registerLog.Clear();
+	}
+	_registerLoggingEnabled = state;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void YM2612::WriteRegisterLogEntry(unsigned int registerNo, unsigned int data)
+{
+	Stream::VGMFile::Command command = (registerNo < RegisterCountPerPart)? Stream::VGMFile::Command::YM2612Port0Write: Stream::VGMFile::Command::YM2612Port1Write;
+	_registerLog.AddRegisterWrite(command, registerNo % RegisterCountPerPart, data, Stream::VGMFile::ConvertTimeToSampleNo(_registerLoggingTime));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void YM2612::WriteRegisterLogSnapshot(const AccessTarget& accessTarget)
+{
+	// Log times are measured from the point where the snapshot is taken
+	_registerLoggingTime = 0;
+
+	// Record the global registers. Note that the key-on register is reconstructed from the
+	// current key state of each operator below, rather than from its last written value.
+	for (unsigned int registerNo = 0x22; registerNo <= 0x2B; ++registerNo)
+	{
+		if (registerNo != 0x28)
+		{
+			WriteRegisterLogEntry(registerNo, GetRegisterData(registerNo, accessTarget).GetData());
+		}
+	}
+
+	// Record the operator and channel registers for each part. The block/fnum registers
+	// are latched on write, and only committed when the corresponding fnum register is
+	// written, so they're recorded in the same order a program would need to write them.
+	for (unsigned int partNo = 0; partNo < PartCount; ++partNo)
+	{
+		unsigned int partBase = partNo * RegisterCountPerPart;
+		for (unsigned int registerNo = 0x30; registerNo <= 0x9F; ++registerNo)
+		{
+			if ((registerNo & 0x03) != 0x03)
+			{
+				WriteRegisterLogEntry(partBase + registerNo, GetRegisterData(partBase + registerNo, accessTarget).GetData());
+			}
+		}
+		for (unsigned int channelIndex = 0; channelIndex < 3; ++channelIndex)
+		{
+			WriteRegisterLogEntry(partBase + 0xA4 + channelIndex, GetRegisterData(partBase + 0xA4 + channelIndex, accessTarget).GetData());
+			WriteRegisterLogEntry(partBase + 0xA0 + channelIndex, GetRegisterData(partBase + 0xA0 + channelIndex, accessTarget).GetData());
+		}
+		if (partNo == 0)
+		{
+			for (unsigned int operatorIndex = 0; operatorIndex < 3; ++operatorIndex)
+			{
+				WriteRegisterLogEntry(0xAC + operatorIndex, GetRegisterData(0xAC + operatorIndex, accessTarget).GetData());
+				WriteRegisterLogEntry(0xA8 + operatorIndex, GetRegisterData(0xA8 + operatorIndex, accessTarget).GetData());
+			}
+		}
+		for (unsigned int channelIndex = 0; channelIndex < 3; ++channelIndex)
+		{
+			WriteRegisterLogEntry(partBase + 0xB0 + channelIndex, GetRegisterData(partBase + 0xB0 + channelIndex, accessTarget).GetData());
+			WriteRegisterLogEntry(partBase + 0xB4 + channelIndex, GetRegisterData(partBase + 0xB4 + channelIndex, accessTarget).GetData());
+		}
+	}
+
+	// Record the current key state of each channel
+	for (unsigned int channelNo = 0; channelNo < ChannelCount; ++channelNo)
+	{
+		unsigned int keyOnData = (channelNo < 3)? channelNo: (channelNo + 1);
+		for (unsigned int operatorNo = 0; operatorNo < OperatorCount; ++operatorNo)
+		{
+			if (_operatorData[channelNo][operatorNo].keyon)
+			{
+				keyOnData |= (1 << (4 + operatorNo));
+			}
+		}
+		WriteRegisterLogEntry(0x28, keyOnData);
+	}
+}
@@ -58,6 +58,7 @@ References:
 #include <list>
 #include <set>
 #include <map>
+#include <atomic>
 #include "Device/Device.pkg"
 #include "TimedBuffers/TimedBuffers.pkg"
 #include "AudioStream/AudioStream.pkg"
@@ -105,6 +106,7 @@ public:
 	virtual void ExecuteTimeslice(double nanoseconds);
 	virtual void ExecuteRollback();
 	virtual void ExecuteCommit();
+	virtual bool UsesParallelCommit() const;
 
 	// Memory interface functions
 	virtual IBusInterface::AccessResult ReadInterface(unsigned int interfaceNumber, unsigned int location, Data& data, IDeviceContext* caller, double accessTime, unsigned int accessContext);
@@ -234,10 +236,12 @@ private:
 
 	// General operator functions
 	void UpdateOperator(unsigned int channelNo, unsigned int operatorNo, bool updateEnvelopeGenerator);
+	bool IsOperatorSilent(unsigned int channelNo, unsigned int operatorNo, unsigned int operatorAddressOffset, const AccessTarget& accessTarget) const;
 	unsigned int CalculateKeyCode(unsigned int block, unsigned int fnumber) const;
 
 	// Phase generator functions
 	void UpdatePhaseGenerator(unsigned int channelNo, unsigned int operatorNo, unsigned int channelAddressOffset, unsigned int operatorAddressOffset);
+	unsigned int CalculatePhaseIncrement(unsigned int channelNo, unsigned int operatorNo, unsigned int channelAddressOffset, unsigned int operatorAddressOffset, unsigned int lfoCounter) const;
 	unsigned int GetCurrentPhase(unsigned int channelNo, unsigned int operatorNo) const;
 	unsigned int GetFrequencyData(unsigned int channelNo, unsigned int operatorNo, unsigned int operatorAddressOffset, const AccessTarget& accessTarget) const;
 	unsigned int GetBlockData(unsigned int channelNo, unsigned int operatorNo, unsigned int operatorAddressOffset, const AccessTarget& accessTarget) const;
@@ -368,7 +372,12 @@ private:
 	void SetAudioLoggingEnabled(bool state);
 	void SetChannelAudioLoggingEnabled(unsigned int channelNo, bool state);
 	void SetOperatorAudioLoggingEnabled(unsigned int channelNo, unsigned int operatorNo, bool state);
-	static bool ToggleLoggingEnabledState(Stream::WAVFile& wavFile, const std::wstring& fileName, bool currentState, bool newState, unsigned int channelCount, unsigned int bitsPerSample, unsigned int samplesPerSec);
+	static bool ToggleLoggingEnabledState(Stream::WAVFileAsyncWriter& wavFile, const std::wstring& fileName, bool currentState, bool newState, unsigned int channelCount, unsigned int samplesPerSec);
+
+	// Register logging functions
+	void SetRegisterLoggingEnabled(bool state);
+	void WriteRegisterLogEntry(unsigned int registerNo, unsigned int data);
+	void WriteRegisterLogSnapshot(const AccessTarget& accessTarget);
 
 private:
 	// Calculated internal lookup tables
@@ -469,6 +478,11 @@ private:
 	int _cyclesUntilLFOIncrement;
 	unsigned int _currentLFOCounter;
 
+	// Render settings
+	// Note that this setting is changed through the generic data interface while the render
+	// thread is running, and the render thread samples it once per render step.
+	std::atomic<bool> _silentOperatorSkipEnabled;
+
 	// Register locking
 	mutable std::mutex _registerLockMutex;
 	bool _keyStateLocking[ChannelCount][OperatorCount];
@@ -485,9 +499,17 @@ private:
 	std::wstring _wavLoggingPath;
 	std::wstring _wavLoggingChannelPath[ChannelCount];
 	std::wstring _wavLoggingOperatorPath[ChannelCount][OperatorCount];
-	Stream::WAVFile _wavLog;
-	Stream::WAVFile _wavLogChannel[ChannelCount];
-	Stream::WAVFile _wavLogOperator[ChannelCount][OperatorCount];
+	Stream::WAVFileAsyncWriter _wavLog;
+	Stream::WAVFileAsyncWriter _wavLogChannel[ChannelCount];
+	Stream::WAVFileAsyncWriter _wavLogOperator[ChannelCount][OperatorCount];
+
+	// Register logging
+	mutable std::mutex _registerLoggingMutex;
+	bool _registerLoggingEnabled;
+	bool _registerLoggingSnapshotPending;
+	double _registerLoggingTime;
+	std::wstring _registerLoggingPath;
+	Stream::VGMFile _registerLog;
 };
 
 #include "YM2612.inl"
@@ -113,6 +113,7 @@ bool ExodusInterface::InitializePrefs()
 	SetGlobalPreferencePathWorkspaces(L"Workspaces");
 	SetGlobalPreferencePathCaptures(L"Captures");
 	SetGlobalPreferencePathAssemblies(L"Plugins");
+	SetGlobalPreferencePathModuleCache(L"Cache");
 	SetGlobalPreferenceEnableThrottling(true);
 	SetGlobalPreferenceRunWhenProgramModuleLoaded(true);
 	SetGlobalPreferenceEnablePersistentState(true);
@@ -1271,6 +1272,10 @@ bool ExodusInterface::LoadPrefs(const std::wstring& filePath)
 		{
 			SetGlobalPreferencePathAssemblies((*i)->GetData());
 		}
+		else if ((*i)->GetName() == L"ModuleCachePath")
+		{
+			SetGlobalPreferencePathModuleCache((*i)->GetData());
+		}
 		else if ((*i)->GetName() == L"DefaultSystem")
 		{
 			SetGlobalPreferenceInitialSystem((*i)->GetData());
@@ -1323,6 +1328,7 @@ void ExodusInterface::SavePrefs(const std::wstring& filePath)
 	rootNode.CreateChild(L"WorkspacesPath").SetData(PathRemoveBasePath(_preferenceDirectoryPath, _prefs.pathWorkspaces));
 	rootNode.CreateChild(L"CapturesPath").SetData(PathRemoveBasePath(_preferenceDirectoryPath, _prefs.pathCaptures));
 	rootNode.CreateChild(L"AssembliesPath").SetData(PathRemoveBasePath(_preferenceDirectoryPath, _prefs.pathAssemblies));
+	rootNode.CreateChild(L"ModuleCachePath").SetData(PathRemoveBasePath(_preferenceDirectoryPath, _prefs.pathModuleCache));
 	rootNode.CreateChild(L"DefaultSystem").SetData(PathRemoveBasePath(_prefs.pathModules, _prefs.loadSystem));
 	rootNode.CreateChild(L"DefaultWorkspace").SetData(PathRemoveBasePath(_prefs.pathWorkspaces, _prefs.loadWorkspace));
 	rootNode.CreateChild(L"EnableThrottling").SetData(_prefs.enableThrottling);
@@ -1573,6 +1579,24 @@ void ExodusInterface::SetGlobalPreferencePathAssemblies(const std::wstring& stat
 	_prefs.pathAssemblies = absolutePath;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void ExodusInterface::SetGlobalPreferencePathModuleCache(const std::wstring& state)
+{
+	// Ensure the specified path is an absolute path
+	std::wstring absolutePath = state;
+	if (PathIsRelativePath(state))
+	{
+		absolutePath = PathCombinePaths(_preferenceDirectoryPath, state);
+	}
+
+	// Ensure the target directory exists
+	CreateDirectory(absolutePath, true);
+
+	// Apply the new preference setting
+	_prefs.pathModuleCache = absolutePath;
+	_system->SetModuleCachePath(_prefs.pathModuleCache);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void ExodusInterface::SetGlobalPreferenceInitialSystem(const std::wstring& state)
 {
@@ -3126,8 +3150,23 @@ LRESULT CALLBACK ExodusInterface::WndSavestateCellProc(HWND hwnd, UINT msg, WPAR
 		std::wstring debuggerSaveFileName = exodusInterface->GetSavestateAutoFileNamePrefix() + L" - " + savePostfix + L" - DebugState" + L".exs";
 		std::wstring saveFilePath = PathCombinePaths(exodusInterface->_prefs.pathSavestates, saveFileName);
 		std::wstring debuggerSaveFilePath = PathCombinePaths(exodusInterface->_prefs.pathSavestates, debuggerSaveFileName);
-		ISystemGUIInterface::StateInfo stateInfo = exodusInterface->_system->GetStateInfo(saveFilePath, ISystemGUIInterface::FileType::ZIP);
-		ISystemGUIInterface::StateInfo debuggerStateInfo = exodusInterface->_system->GetStateInfo(debuggerSaveFilePath, ISystemGUIInterface::FileType::ZIP);
+
+		// Attempt to load the savestate info from the header record at the start of each
+		// savestate file. If no header is present, the savestate was created before
+		// headers were introduced, and we fall back to loading the info from the full
+		// savestate.
+		Image thumbnail;
+		Image debuggerThumbnail;
+		ISystemGUIInterface::StateInfo stateInfo = exodusInterface->_system->GetStateHeaderInfo(saveFilePath, ISystemGUIInterface::FileType::ZIP, thumbnail);
+		ISystemGUIInterface::StateInfo debuggerStateInfo = exodusInterface->_system->GetStateHeaderInfo(debuggerSaveFilePath, ISystemGUIInterface::FileType::ZIP, debuggerThumbnail);
+		if (!stateInfo.valid)
+		{
+			stateInfo = exodusInterface->_system->GetStateInfo(saveFilePath, ISystemGUIInterface::FileType::ZIP);
+		}
+		if (!debuggerStateInfo.valid)
+		{
+			debuggerStateInfo = exodusInterface->_system->GetStateInfo(debuggerSaveFilePath, ISystemGUIInterface::FileType::ZIP);
+		}
 		if ((state->savestatePresent == stateInfo.valid)
 		&& (state->debugStatePresent == debuggerStateInfo.valid)
 		&& (state->date == (state->savestatePresent? stateInfo.creationDate: debuggerStateInfo.creationDate))
@@ -3150,9 +3189,18 @@ LRESULT CALLBACK ExodusInterface::WndSavestateCellProc(HWND hwnd, UINT msg, WPAR
 			state->initializedBitmap = false;
 		}
 
-		// Load the screenshot
+		// Load the screenshot. If a thumbnail was present in the savestate header we use
+		// it directly, otherwise we need to decompress the full screenshot from the
+		// savestate archive.
 		state->screenshotPresent = stateInfo.valid && stateInfo.screenshotPresent;
-		if (stateInfo.screenshotPresent)
+		if (stateInfo.valid && stateInfo.thumbnailPresent)
+		{
+			state->originalImage = thumbnail;
+			state->screenshotPresent = true;
+			state->bitmapWidth = state->originalImage.GetImageWidth();
+			state->bitmapHeight = state->originalImage.GetImageHeight();
+		}
+		else if (stateInfo.screenshotPresent)
 		{
 			// Open the target file
 			std::wstring filePath = PathCombinePaths(exodusInterface->_prefs.pathSavestates, saveFileName);
@@ -146,6 +146,7 @@ public:
 	void SetGlobalPreferencePathWorkspaces(const std::wstring& state);
 	void SetGlobalPreferencePathCaptures(const std::wstring& state);
 	void SetGlobalPreferencePathAssemblies(const std::wstring& state);
+	void SetGlobalPreferencePathModuleCache(const std::wstring& state);
 	void SetGlobalPreferenceInitialSystem(const std::wstring& state);
 	void SetGlobalPreferenceInitialWorkspace(const std::wstring& state);
 	void SetGlobalPreferenceEnableThrottling(bool state);
@@ -183,6 +184,7 @@ private:
 		std::wstring pathWorkspaces;
 		std::wstring pathCaptures;
 		std::wstring pathAssemblies;
+		std::wstring pathModuleCache;
 		std::wstring loadSystem;
 		std::wstring loadWorkspace;
 		bool enableThrottling;
@@ -88,6 +88,26 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 		return 30;
 	}
 
+	// If we've been asked to run a list of batch jobs, load the plugins, run each job, and
+	// save the results, without creating the main interface window. Batch jobs are run with
+	// the following command line:
+	// Exodus.exe -batch <jobListFilePath> <resultsFilePath> [-verify]
+	int argumentCount = 0;
+	LPWSTR* arguments = CommandLineToArgvW(GetCommandLineW(), &argumentCount);
+	if ((arguments != NULL) && (argumentCount >= 4) && (std::wstring(arguments[1]) == L"-batch"))
+	{
+		std::wstring jobListFilePath = arguments[2];
+		std::wstring resultsFilePath = arguments[3];
+		bool verifyDeterminism = (argumentCount >= 5) && (std::wstring(arguments[4]) == L"-verify");
+		LocalFree(arguments);
+		exodusInterface.LoadAssembliesFromFolderSynchronous(exodusInterface.GetGlobalPreferencePathAssemblies());
+		bool batchResult = systemObject->RunBatchJobs(jobListFilePath, resultsFilePath, verifyDeterminism);
+		exodusInterface.UnbindFromSystem();
+		systemDestructor(systemObject);
+		return (batchResult)? 0: 60;
+	}
+	LocalFree(arguments);
+
 	// Create the main interface window
 	HWND hwnd = exodusInterface.CreateMainInterface(hInstance);
 	if (hwnd == NULL)
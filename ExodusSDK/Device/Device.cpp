@@ -486,3 +486,48 @@ void Device::HandleInputKeyDown(unsigned int keyCodeID)
 //----------------------------------------------------------------------------------------------------------------------
 void Device::HandleInputKeyUp(unsigned int keyCodeID)
 { }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Commit functions
+//----------------------------------------------------------------------------------------------------------------------
+// Devices which return true from UsesParallelCommit may have their ExecuteCommit and
+// ExecuteRollback functions called on any thread, concurrently with the ExecuteCommit
+// and ExecuteRollback functions of every other device which also returns true. A device
+// may only opt in if these functions touch nothing but the device's own state, and make
+// no calls into other devices, extensions, or the system. A timed buffer obtained from
+// another device counts as the device's own state, provided that device never commits or
+// rolls the buffer back itself, and no other device drives it. All other devices are
+// committed and rolled back serially, in the order they were added to the system.
+//----------------------------------------------------------------------------------------------------------------------
+bool Device::UsesParallelCommit() const
+{
+	return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Block memory functions
+//----------------------------------------------------------------------------------------------------------------------
+void Device::TransparentWriteInterfaceBlock(unsigned int interfaceNumber, unsigned int location, const Marshal::In<std::vector<unsigned int>>& data, unsigned int dataBitCount, IDeviceContext* caller, unsigned int accessContext)
+{
+	// By default, we simply write each entry in turn through the transparent write
+	// function. Devices which are able to load a complete block of data more efficiently
+	// in a single operation can override this function.
+	std::vector<unsigned int> dataEntries = data.Get();
+	Data dataEntry(dataBitCount);
+	for (unsigned int i = 0; i < (unsigned int)dataEntries.size(); ++i)
+	{
+		dataEntry.SetData(dataEntries[i]);
+		TransparentWriteInterface(interfaceNumber, location + i, dataEntry, caller, accessContext);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Timing point functions
+//----------------------------------------------------------------------------------------------------------------------
+// Devices which return true from UsesTimingPoints have GetNextTimingPointInDeviceTime
+// called on every system step. All other devices are never asked for timing points.
+//----------------------------------------------------------------------------------------------------------------------
+bool Device::UsesTimingPoints() const
+{
+	return false;
+}
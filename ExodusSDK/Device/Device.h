@@ -123,6 +123,15 @@ public:
 	virtual void HandleInputKeyDown(unsigned int keyCodeID);
 	virtual void HandleInputKeyUp(unsigned int keyCodeID);
 
+	// Commit functions
+	virtual bool UsesParallelCommit() const;
+
+	// Block memory functions
+	virtual void TransparentWriteInterfaceBlock(unsigned int interfaceNumber, unsigned int location, const Marshal::In<std::vector<unsigned int>>& data, unsigned int dataBitCount, IDeviceContext* caller, unsigned int accessContext);
+
+	// Timing point functions
+	virtual bool UsesTimingPoints() const;
+
 private:
 	std::wstring _implementationName;
 	std::wstring _instanceName;
@@ -7,6 +7,7 @@
 #include "HierarchicalStorageInterface/HierarchicalStorageInterface.pkg"
 #include <string>
 #include <list>
+#include <vector>
 class Data;
 class ISystemDeviceInterface;
 class IDeviceContext;
@@ -25,7 +26,7 @@ public:
 	inline virtual ~IDevice() = 0;
 
 	// Interface version functions
-	static inline unsigned int ThisIDeviceVersion() { return 1; }
+	static inline unsigned int ThisIDeviceVersion() { return 3; }
 	virtual unsigned int GetIDeviceVersion() const = 0;
 
 	// Initialization functions
@@ -151,6 +152,15 @@ public:
 	virtual Marshal::Ret<std::wstring> GetKeyCodeName(unsigned int keyCodeID) const = 0;
 	virtual void HandleInputKeyDown(unsigned int keyCodeID) = 0;
 	virtual void HandleInputKeyUp(unsigned int keyCodeID) = 0;
+
+	// Commit functions
+	virtual bool UsesParallelCommit() const = 0;
+
+	// Block memory functions
+	virtual void TransparentWriteInterfaceBlock(unsigned int interfaceNumber, unsigned int location, const Marshal::In<std::vector<unsigned int>>& data, unsigned int dataBitCount, IDeviceContext* caller, unsigned int accessContext) = 0;
+
+	// Timing point functions
+	virtual bool UsesTimingPoints() const = 0;
 };
 IDevice::~IDevice() { }
 
@@ -3,6 +3,7 @@
 #include "MarshalSupport/MarshalSupport.pkg"
 #include <string>
 using namespace MarshalSupport::Operators;
+class ITraceRecorder;
 
 class ISystemDeviceInterface
 {
@@ -17,7 +18,7 @@ public:
 	inline virtual ~ISystemDeviceInterface() = 0;
 
 	// Interface version functions
-	static inline unsigned int ThisISystemDeviceInterfaceVersion() { return 1; }
+	static inline unsigned int ThisISystemDeviceInterfaceVersion() { return 2; }
 	virtual unsigned int GetISystemDeviceInterfaceVersion() const = 0;
 
 	// Path functions
@@ -43,6 +44,9 @@ public:
 	virtual void HandleInputKeyUp(KeyCode keyCode) = 0;
 	virtual void HandleInputAxisUpdate(AxisCode axisCode, float newValue) = 0;
 	virtual void HandleInputScrollUpdate(ScrollCode scrollCode, int scrollTicks) = 0;
+
+	// Tracing functions
+	virtual ITraceRecorder& GetTraceRecorder() const = 0;
 };
 ISystemDeviceInterface::~ISystemDeviceInterface() { }
 
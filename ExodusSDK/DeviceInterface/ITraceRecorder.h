@@ -0,0 +1,32 @@
+#ifndef __ITRACERECORDER_H__
+#define __ITRACERECORDER_H__
+#include "MarshalSupport/MarshalSupport.pkg"
+#include <string>
+using namespace MarshalSupport::Operators;
+
+class ITraceRecorder
+{
+public:
+	// Enumerations
+	enum class EventType;
+
+	// Nested types
+	class Scope;
+
+public:
+	// Constructors
+	inline virtual ~ITraceRecorder() = 0;
+
+	// Interface version functions
+	static inline unsigned int ThisITraceRecorderVersion() { return 1; }
+	virtual unsigned int GetITraceRecorderVersion() const = 0;
+
+	// Recording functions
+	virtual bool TraceRecordingEnabled() const = 0;
+	virtual void RecordTraceEvent(EventType eventType, const char* eventName) = 0;
+	virtual void SetCurrentThreadTraceName(const Marshal::In<std::wstring>& threadName) = 0;
+};
+ITraceRecorder::~ITraceRecorder() { }
+
+#include "ITraceRecorder.inl"
+#endif
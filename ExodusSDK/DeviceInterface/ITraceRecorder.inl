@@ -0,0 +1,46 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Enumerations
+//----------------------------------------------------------------------------------------------------------------------
+enum class ITraceRecorder::EventType
+{
+	Begin,
+	End,
+	Instant
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Nested types
+//----------------------------------------------------------------------------------------------------------------------
+// Records a begin event when constructed and a matching end event when destroyed. If
+// trace recording is disabled when the scope is entered, nothing is recorded for the
+// scope, so the only cost is the enable check.
+class ITraceRecorder::Scope
+{
+public:
+	// Constructors
+	Scope(ITraceRecorder& traceRecorder, const char* eventName)
+	:_traceRecorder(traceRecorder), _eventName(eventName), _active(traceRecorder.TraceRecordingEnabled())
+	{
+		if (_active)
+		{
+			_traceRecorder.RecordTraceEvent(EventType::Begin, _eventName);
+		}
+	}
+	~Scope()
+	{
+		if (_active)
+		{
+			_traceRecorder.RecordTraceEvent(EventType::End, _eventName);
+		}
+	}
+
+private:
+	// Prevent copying of this object
+	Scope(const Scope& source) = delete;
+	Scope& operator=(const Scope& source) = delete;
+
+private:
+	ITraceRecorder& _traceRecorder;
+	const char* _eventName;
+	bool _active;
+};
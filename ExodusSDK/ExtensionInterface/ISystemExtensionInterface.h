@@ -12,7 +12,7 @@ class ISystemExtensionInterface :public ISystemDeviceInterface
 {
 public:
 	// Interface version functions
-	static inline unsigned int ThisISystemExtensionInterfaceVersion() { return 1; }
+	static inline unsigned int ThisISystemExtensionInterfaceVersion() { return 2; }
 	virtual unsigned int GetISystemExtensionInterfaceVersion() const = 0;
 
 	// System interface functions
@@ -49,6 +49,9 @@ public:
 	virtual void StopSystem() = 0;
 	virtual void ExecuteDeviceStep(IDevice* device) = 0;
 	virtual void ExecuteSystemStep(double maximumTimeslice) = 0;
+
+	// Batch execution functions
+	virtual void ExecuteDeviceSteps(IDevice* device, unsigned int stepCount) = 0;
 };
 
 #endif
@@ -3,6 +3,7 @@
 #include "ExtensionInterface/ExtensionInterface.pkg"
 #include "CallbackSupport/CallbackSupport.pkg"
 #include "MarshalSupport/MarshalSupport.pkg"
+#include "ImageInterface/ImageInterface.pkg"
 #include "IEmbeddedROMInfo.h"
 #include "IModuleSettingInfo.h"
 #include "IModuleSettingOptionInfo.h"
@@ -28,6 +29,9 @@ public:
 	struct ConnectorDefinitionImport;
 	struct ConnectorDefinitionExport;
 	struct SystemLogEntry;
+	struct ExecutionProfileDeviceEntry;
+	struct ExecutionProfile;
+	struct ThrottlingStatistics;
 
 	// Typedefs
 	typedef std::map<unsigned int, ModuleRelationship> ModuleRelationshipMap;
@@ -41,14 +45,16 @@ public:
 
 public:
 	// Interface version functions
-	static inline unsigned int ThisISystemGUIInterfaceVersion() { return 1; }
+	static inline unsigned int ThisISystemGUIInterfaceVersion() { return 5; }
 	virtual unsigned int GetISystemGUIInterfaceVersion() const = 0;
 
 	// Path functions
 	virtual void SetCapturePath(const Marshal::In<std::wstring>& path) = 0;
+	virtual void SetModuleCachePath(const Marshal::In<std::wstring>& path) = 0;
 
 	// Logging functions
 	virtual Marshal::Ret<std::vector<SystemLogEntry>> GetEventLog() const = 0;
+	virtual unsigned int GetEventLogEntries(unsigned int firstEntryNo, const Marshal::Out<std::vector<SystemLogEntry>>& entries) const = 0;
 	virtual unsigned int GetEventLogLastModifiedToken() const = 0;
 	virtual void ClearEventLog() = 0;
 	virtual unsigned int GetEventLogSize() const = 0;
@@ -77,6 +83,21 @@ public:
 	virtual void SetRunWhenProgramModuleLoadedState(bool state) = 0;
 	virtual bool GetEnablePersistentState() const = 0;
 	virtual void SetEnablePersistentState(bool state) = 0;
+	virtual bool GetRollbackPredictionState() const = 0;
+	virtual void SetRollbackPredictionState(bool state) = 0;
+	virtual bool GetCooperativeExecutionState() const = 0;
+	virtual void SetCooperativeExecutionState(bool state) = 0;
+
+	// Execution profiling functions
+	virtual Marshal::Ret<ExecutionProfile> GetExecutionProfile() const = 0;
+	virtual void ResetExecutionProfile() = 0;
+	virtual bool SaveExecutionProfile(const Marshal::In<std::wstring>& filePath) const = 0;
+
+	// Tracing functions
+	virtual bool GetTraceRecordingState() const = 0;
+	virtual void SetTraceRecordingState(bool state) = 0;
+	virtual void ClearTrace() = 0;
+	virtual bool SaveTrace(const Marshal::In<std::wstring>& filePath) const = 0;
 
 	// Device registration
 	virtual bool RegisterDevice(const IDeviceInfo& entry, AssemblyHandle assemblyHandle) = 0;
@@ -144,6 +165,22 @@ public:
 	virtual bool RestoreViewStateForDevice(const Marshal::In<std::wstring>& viewGroupName, const Marshal::In<std::wstring>& viewName, IHierarchicalStorageNode& viewState, IViewPresenter** restoredViewPresenter, unsigned int moduleID, const Marshal::In<std::wstring>& deviceInstanceName) const = 0;
 	virtual bool RestoreViewStateForExtension(const Marshal::In<std::wstring>& viewGroupName, const Marshal::In<std::wstring>& viewName, IHierarchicalStorageNode& viewState, IViewPresenter** restoredViewPresenter, const Marshal::In<std::wstring>& extensionInstanceName) const = 0;
 	virtual bool RestoreViewStateForExtension(const Marshal::In<std::wstring>& viewGroupName, const Marshal::In<std::wstring>& viewName, IHierarchicalStorageNode& viewState, IViewPresenter** restoredViewPresenter, unsigned int moduleID, const Marshal::In<std::wstring>& extensionInstanceName) const = 0;
+
+	// Throttling functions
+	virtual double GetThrottlingSyncInterval() const = 0;
+	virtual void SetThrottlingSyncInterval(double intervalInNanoseconds) = 0;
+	virtual Marshal::Ret<ThrottlingStatistics> GetThrottlingStatistics() const = 0;
+
+	// Event log cursor functions
+	virtual unsigned int GetEventLogClearGeneration() const = 0;
+
+	// Batch execution functions
+	virtual bool RunBatchJobs(const Marshal::In<std::wstring>& jobListFilePath, const Marshal::In<std::wstring>& resultsFilePath, bool verifyDeterminism) = 0;
+
+	// Savestate header functions
+	virtual Marshal::Ret<StateInfo> GetStateHeaderInfo(const Marshal::In<std::wstring>& filePath, FileType fileType, IImage& thumbnail) const = 0;
+	virtual Marshal::Ret<std::wstring> GetSaveStateComments() const = 0;
+	virtual void SetSaveStateComments(const Marshal::In<std::wstring>& comments) = 0;
 };
 
 #include "ISystemGUIInterface.inl"
@@ -24,16 +24,16 @@ struct ISystemGUIInterface::StateInfo
 public:
 	// Constructors
 	StateInfo()
-	:valid(false), debuggerState(false), screenshotPresent(false)
+	:valid(false), debuggerState(false), screenshotPresent(false), thumbnailPresent(false)
 	{ }
 	StateInfo(MarshalSupport::marshal_object_tag, const StateInfo& source)
 	{
-		source.MarshalToTarget(valid, debuggerState, creationDate, creationTime, comments, screenshotPresent, screenshotFilename);
+		source.MarshalToTarget(valid, debuggerState, creationDate, creationTime, comments, screenshotPresent, screenshotFilename, thumbnailPresent);
 	}
 
 private:
 	// Marshalling methods
-	virtual void MarshalToTarget(bool& validMarshaller, bool& debuggerStateMarshaller, const Marshal::Out<std::wstring>& creationDateMarshaller, const Marshal::Out<std::wstring>& creationTimeMarshaller, const Marshal::Out<std::wstring>& commentsMarshaller, bool& screenshotPresentMarshaller, const Marshal::Out<std::wstring>& screenshotFilenameMarshaller) const
+	virtual void MarshalToTarget(bool& validMarshaller, bool& debuggerStateMarshaller, const Marshal::Out<std::wstring>& creationDateMarshaller, const Marshal::Out<std::wstring>& creationTimeMarshaller, const Marshal::Out<std::wstring>& commentsMarshaller, bool& screenshotPresentMarshaller, const Marshal::Out<std::wstring>& screenshotFilenameMarshaller, bool& thumbnailPresentMarshaller) const
 	{
 		validMarshaller = valid;
 		debuggerStateMarshaller = debuggerState;
@@ -42,6 +42,7 @@ private:
 		commentsMarshaller = comments;
 		screenshotPresentMarshaller = screenshotPresent;
 		screenshotFilenameMarshaller = screenshotFilename;
+		thumbnailPresentMarshaller = thumbnailPresent;
 	}
 
 public:
@@ -52,6 +53,7 @@ public:
 	std::wstring comments;
 	bool screenshotPresent;
 	std::wstring screenshotFilename;
+	bool thumbnailPresent;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -288,6 +290,159 @@ public:
 	std::wstring eventTimeString;
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+struct ISystemGUIInterface::ExecutionProfileDeviceEntry
+{
+public:
+	// Constructors
+	ExecutionProfileDeviceEntry()
+	:timesliceCount(0), timesliceNanoseconds(0), timingPointStepCount(0), timingPointStepNanoseconds(0), suspendCount(0), resumeCount(0), suspendWaitNanoseconds(0), commitNanoseconds(0), rollbackNanoseconds(0), rollbackRequestCount(0), rollbackTriggerCount(0)
+	{ }
+	ExecutionProfileDeviceEntry(MarshalSupport::marshal_object_tag, const ExecutionProfileDeviceEntry& sourceObject)
+	{
+		sourceObject.MarshalToTarget(deviceName, timesliceCount, timesliceNanoseconds, timingPointStepCount, timingPointStepNanoseconds, suspendCount, resumeCount, suspendWaitNanoseconds, commitNanoseconds, rollbackNanoseconds, rollbackRequestCount, rollbackTriggerCount);
+	}
+
+private:
+	// Marshalling methods
+	virtual void MarshalToTarget(const Marshal::Out<std::wstring>& deviceNameMarshaller, unsigned long long& timesliceCountMarshaller, unsigned long long& timesliceNanosecondsMarshaller, unsigned long long& timingPointStepCountMarshaller, unsigned long long& timingPointStepNanosecondsMarshaller, unsigned long long& suspendCountMarshaller, unsigned long long& resumeCountMarshaller, unsigned long long& suspendWaitNanosecondsMarshaller, unsigned long long& commitNanosecondsMarshaller, unsigned long long& rollbackNanosecondsMarshaller, unsigned long long& rollbackRequestCountMarshaller, unsigned long long& rollbackTriggerCountMarshaller) const
+	{
+		deviceNameMarshaller = deviceName;
+		timesliceCountMarshaller = timesliceCount;
+		timesliceNanosecondsMarshaller = timesliceNanoseconds;
+		timingPointStepCountMarshaller = timingPointStepCount;
+		timingPointStepNanosecondsMarshaller = timingPointStepNanoseconds;
+		suspendCountMarshaller = suspendCount;
+		resumeCountMarshaller = resumeCount;
+		suspendWaitNanosecondsMarshaller = suspendWaitNanoseconds;
+		commitNanosecondsMarshaller = commitNanoseconds;
+		rollbackNanosecondsMarshaller = rollbackNanoseconds;
+		rollbackRequestCountMarshaller = rollbackRequestCount;
+		rollbackTriggerCountMarshaller = rollbackTriggerCount;
+	}
+
+public:
+	// Note that the timeslice time for a device is the wall time from when the timeslice
+	// was sent to the device until the device finished it, so it includes any time the
+	// device spent suspended or waiting on its dependencies. The rollback request count
+	// records every rollback the device asked for, while the trigger count only records
+	// the rollbacks that were actually performed because of this device.
+	std::wstring deviceName;
+	unsigned long long timesliceCount;
+	unsigned long long timesliceNanoseconds;
+	unsigned long long timingPointStepCount;
+	unsigned long long timingPointStepNanoseconds;
+	unsigned long long suspendCount;
+	unsigned long long resumeCount;
+	unsigned long long suspendWaitNanoseconds;
+	unsigned long long commitNanoseconds;
+	unsigned long long rollbackNanoseconds;
+	unsigned long long rollbackRequestCount;
+	unsigned long long rollbackTriggerCount;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+struct ISystemGUIInterface::ExecutionProfile
+{
+public:
+	// Constructors
+	ExecutionProfile()
+	:notifyUpcomingTimesliceCount(0), notifyUpcomingTimesliceNanoseconds(0), executeTimesliceCount(0), executeTimesliceNanoseconds(0), commitCount(0), commitNanoseconds(0), rollbackCount(0), rollbackNanoseconds(0), timingPointSearchCount(0), timingPointSearchNanoseconds(0), timingPointStepCount(0), timingPointStepNanoseconds(0), suspendCheckCount(0), suspendCheckNanoseconds(0), suspendReleaseCount(0), rollbackPredictionCount(0), rollbackAvoidedCount(0), rollbackMispredictionCount(0)
+	{ }
+	ExecutionProfile(MarshalSupport::marshal_object_tag, const ExecutionProfile& sourceObject)
+	{
+		sourceObject.MarshalToTarget(notifyUpcomingTimesliceCount, notifyUpcomingTimesliceNanoseconds, executeTimesliceCount, executeTimesliceNanoseconds, commitCount, commitNanoseconds, rollbackCount, rollbackNanoseconds, timingPointSearchCount, timingPointSearchNanoseconds, timingPointStepCount, timingPointStepNanoseconds, suspendCheckCount, suspendCheckNanoseconds, suspendReleaseCount, rollbackPredictionCount, rollbackAvoidedCount, rollbackMispredictionCount, timesliceLengthHistogram, devices);
+	}
+
+private:
+	// Marshalling methods
+	virtual void MarshalToTarget(unsigned long long& notifyUpcomingTimesliceCountMarshaller, unsigned long long& notifyUpcomingTimesliceNanosecondsMarshaller, unsigned long long& executeTimesliceCountMarshaller, unsigned long long& executeTimesliceNanosecondsMarshaller, unsigned long long& commitCountMarshaller, unsigned long long& commitNanosecondsMarshaller, unsigned long long& rollbackCountMarshaller, unsigned long long& rollbackNanosecondsMarshaller, unsigned long long& timingPointSearchCountMarshaller, unsigned long long& timingPointSearchNanosecondsMarshaller, unsigned long long& timingPointStepCountMarshaller, unsigned long long& timingPointStepNanosecondsMarshaller, unsigned long long& suspendCheckCountMarshaller, unsigned long long& suspendCheckNanosecondsMarshaller, unsigned long long& suspendReleaseCountMarshaller, unsigned long long& rollbackPredictionCountMarshaller, unsigned long long& rollbackAvoidedCountMarshaller, unsigned long long& rollbackMispredictionCountMarshaller, const Marshal::Out<std::vector<unsigned long long>>& timesliceLengthHistogramMarshaller, const Marshal::Out<std::vector<ExecutionProfileDeviceEntry>>& devicesMarshaller) const
+	{
+		notifyUpcomingTimesliceCountMarshaller = notifyUpcomingTimesliceCount;
+		notifyUpcomingTimesliceNanosecondsMarshaller = notifyUpcomingTimesliceNanoseconds;
+		executeTimesliceCountMarshaller = executeTimesliceCount;
+		executeTimesliceNanosecondsMarshaller = executeTimesliceNanoseconds;
+		commitCountMarshaller = commitCount;
+		commitNanosecondsMarshaller = commitNanoseconds;
+		rollbackCountMarshaller = rollbackCount;
+		rollbackNanosecondsMarshaller = rollbackNanoseconds;
+		timingPointSearchCountMarshaller = timingPointSearchCount;
+		timingPointSearchNanosecondsMarshaller = timingPointSearchNanoseconds;
+		timingPointStepCountMarshaller = timingPointStepCount;
+		timingPointStepNanosecondsMarshaller = timingPointStepNanoseconds;
+		suspendCheckCountMarshaller = suspendCheckCount;
+		suspendCheckNanosecondsMarshaller = suspendCheckNanoseconds;
+		suspendReleaseCountMarshaller = suspendReleaseCount;
+		rollbackPredictionCountMarshaller = rollbackPredictionCount;
+		rollbackAvoidedCountMarshaller = rollbackAvoidedCount;
+		rollbackMispredictionCountMarshaller = rollbackMispredictionCount;
+		timesliceLengthHistogramMarshaller = timesliceLengthHistogram;
+		devicesMarshaller = devices;
+	}
+
+public:
+	// Note that entry 0 in the timeslice length histogram counts timeslices with a length
+	// of zero, and each entry n after that counts timeslices with a length in
+	// nanoseconds in the range [2^(n-1), 2^n). The last entry also counts all longer
+	// timeslices. The rollback prediction counts report how many timeslices were ended
+	// early at a predicted rollback point, how many of those reached the predicted point
+	// without the predicted rollback occurring, and how many rolled back anyway.
+	unsigned long long notifyUpcomingTimesliceCount;
+	unsigned long long notifyUpcomingTimesliceNanoseconds;
+	unsigned long long executeTimesliceCount;
+	unsigned long long executeTimesliceNanoseconds;
+	unsigned long long commitCount;
+	unsigned long long commitNanoseconds;
+	unsigned long long rollbackCount;
+	unsigned long long rollbackNanoseconds;
+	unsigned long long timingPointSearchCount;
+	unsigned long long timingPointSearchNanoseconds;
+	unsigned long long timingPointStepCount;
+	unsigned long long timingPointStepNanoseconds;
+	unsigned long long suspendCheckCount;
+	unsigned long long suspendCheckNanoseconds;
+	unsigned long long suspendReleaseCount;
+	unsigned long long rollbackPredictionCount;
+	unsigned long long rollbackAvoidedCount;
+	unsigned long long rollbackMispredictionCount;
+	std::vector<unsigned long long> timesliceLengthHistogram;
+	std::vector<ExecutionProfileDeviceEntry> devices;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+struct ISystemGUIInterface::ThrottlingStatistics
+{
+public:
+	// Constructors
+	ThrottlingStatistics()
+	:syncCount(0), averageJitterInNanoseconds(0), maxJitterInNanoseconds(0), sleepLatencyInNanoseconds(0)
+	{ }
+	ThrottlingStatistics(MarshalSupport::marshal_object_tag, const ThrottlingStatistics& sourceObject)
+	{
+		sourceObject.MarshalToTarget(syncCount, averageJitterInNanoseconds, maxJitterInNanoseconds, sleepLatencyInNanoseconds);
+	}
+
+private:
+	// Marshalling methods
+	virtual void MarshalToTarget(unsigned int& syncCountMarshaller, double& averageJitterInNanosecondsMarshaller, double& maxJitterInNanosecondsMarshaller, double& sleepLatencyInNanosecondsMarshaller) const
+	{
+		syncCountMarshaller = syncCount;
+		averageJitterInNanosecondsMarshaller = averageJitterInNanoseconds;
+		maxJitterInNanosecondsMarshaller = maxJitterInNanoseconds;
+		sleepLatencyInNanosecondsMarshaller = sleepLatencyInNanoseconds;
+	}
+
+public:
+	// Note that the jitter figures measure how far from the target time the system
+	// resumed execution after each synchronization point, regardless of whether it
+	// resumed early or late. The sleep latency is the current estimate of how late the
+	// execution thread wakes up after a requested sleep.
+	unsigned int syncCount;
+	double averageJitterInNanoseconds;
+	double maxJitterInNanoseconds;
+	double sleepLatencyInNanoseconds;
+};
+
 // Restore the disabled warnings
 #ifdef _MSC_VER
 #pragma warning(pop)
@@ -36,6 +36,8 @@ public:
 	virtual DataType ReadLatest(unsigned int address) const = 0;
 	virtual void WriteLatest(unsigned int address, const DataType& data) = 0;
 	inline void GetLatestBufferCopy(std::vector<DataType>& buffer) const;
+	inline unsigned int GetLatestBufferChanges(unsigned int sinceGeneration, std::vector<DataType>& buffer, std::vector<unsigned int>& changedBlockBitmap) const;
+	inline static unsigned int GetDirtyBlockSize();
 
 	// Time management functions
 	virtual void Initialize() = 0;
@@ -63,6 +65,7 @@ public:
 protected:
 	// Access functions
 	virtual void GetLatestBufferCopy(DataType* buffer, unsigned int bufferSize) const = 0;
+	virtual unsigned int GetLatestBufferChanges(unsigned int sinceGeneration, DataType* buffer, unsigned int bufferSize, unsigned int* changedBlockBitmap) const = 0;
 };
 ITimedBufferInt::~ITimedBufferInt() { }
 
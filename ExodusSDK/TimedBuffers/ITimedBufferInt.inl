@@ -10,3 +10,33 @@ void ITimedBufferInt::GetLatestBufferCopy(std::vector<DataType>& buffer) const
 		GetLatestBufferCopy(&buffer[0], bufferSize);
 	}
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Updates a buffer previously populated by this function with only the blocks of data
+// which have changed since the supplied generation number, and returns the generation
+// number to pass in on the next call. Bits in changedBlockBitmap are set for each block of
+// GetDirtyBlockSize() entries which was updated. If the target buffer doesn't match the
+// current buffer size, or the supplied generation number is 0, the whole buffer is copied.
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int ITimedBufferInt::GetLatestBufferChanges(unsigned int sinceGeneration, std::vector<DataType>& buffer, std::vector<unsigned int>& changedBlockBitmap) const
+{
+	unsigned int bufferSize = Size();
+	if (buffer.size() != bufferSize)
+	{
+		buffer.resize(bufferSize);
+		sinceGeneration = 0;
+	}
+	unsigned int blockCount = (bufferSize + (GetDirtyBlockSize() - 1)) / GetDirtyBlockSize();
+	changedBlockBitmap.resize((blockCount + 31) / 32);
+	if (bufferSize <= 0)
+	{
+		return sinceGeneration;
+	}
+	return GetLatestBufferChanges(sinceGeneration, &buffer[0], bufferSize, &changedBlockBitmap[0]);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int ITimedBufferInt::GetDirtyBlockSize()
+{
+	return 32;
+}
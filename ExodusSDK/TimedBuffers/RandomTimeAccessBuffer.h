@@ -60,6 +60,9 @@ public:
 	typedef TimedBufferAdvanceSession<DataType, TimesliceType> AdvanceSession;
 	typedef typename std::list<TimesliceEntry>::iterator Timeslice;
 
+	// Constants
+	static const unsigned int DirtyBlockSize = 32;
+
 	// Constructors
 	inline RandomTimeAccessBuffer();
 	inline RandomTimeAccessBuffer(const DataType& defaultValue);
@@ -92,6 +95,8 @@ public:
 	void WriteLatest(unsigned int address, const DataType& data);
 	void GetLatestBufferCopy(std::vector<DataType>& buffer) const;
 	void GetLatestBufferCopy(DataType* buffer, unsigned int bufferSize) const;
+	unsigned int GetLatestBufferChanges(unsigned int sinceGeneration, DataType* buffer, unsigned int bufferSize, unsigned int* changedBlockBitmap) const;
+	inline static unsigned int GetDirtyBlockCount(unsigned int bufferSize);
 
 	// Time management functions
 	void Initialize();
@@ -121,6 +126,11 @@ private:
 	struct TimesliceSaveEntry;
 	struct WriteSaveEntry;
 
+	// Dirty block tracking functions
+	inline void MarkAddressDirty(unsigned int address) const;
+	void MarkAllDirty();
+	inline void ReleaseReferencedBlocks();
+
 	// Time management functions
 	TimesliceType GetNextWriteTimeNoLock(const Timeslice& targetTimeslice) const;
 	void AdvanceBySessionInternal(TimesliceType currentProgress, AdvanceSession& advanceSession, const Timeslice& targetTimeslice);
@@ -140,6 +150,9 @@ private:
 	std::vector<DataType> _memory;
 	bool _latestMemoryBufferExists;
 	std::vector<DataType> _latestMemory;
+	mutable std::vector<unsigned int> _blockGeneration;
+	mutable unsigned int _dirtyGeneration;
+	std::vector<unsigned int> _referencedBlocks;
 	DataType _defaultValue;
 	TimesliceType _currentTimeOffset;
 };
@@ -64,37 +64,39 @@ struct RandomTimeAccessBuffer<DataType, TimesliceType>::WriteSaveEntry
 //----------------------------------------------------------------------------------------------------------------------
 template<class DataType, class TimesliceType>
 RandomTimeAccessBuffer<DataType, TimesliceType>::RandomTimeAccessBuffer()
-:_latestMemoryBufferExists(false)
+:_latestMemoryBufferExists(false), _dirtyGeneration(1)
 { }
 
 //----------------------------------------------------------------------------------------------------------------------
 template<class DataType, class TimesliceType>
 RandomTimeAccessBuffer<DataType, TimesliceType>::RandomTimeAccessBuffer(const DataType& defaultValue)
-:_defaultValue(defaultValue)
+:_defaultValue(defaultValue), _dirtyGeneration(1)
 { }
 
 //----------------------------------------------------------------------------------------------------------------------
 template<class DataType, class TimesliceType>
 RandomTimeAccessBuffer<DataType, TimesliceType>::RandomTimeAccessBuffer(unsigned int size, bool keepLatestCopy)
-:_latestMemoryBufferExists(keepLatestCopy)
+:_latestMemoryBufferExists(keepLatestCopy), _dirtyGeneration(1)
 {
 	_memory.resize(size);
 	if (_latestMemoryBufferExists)
 	{
 		_latestMemory.resize(size);
 	}
+	MarkAllDirty();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 template<class DataType, class TimesliceType>
 RandomTimeAccessBuffer<DataType, TimesliceType>::RandomTimeAccessBuffer(unsigned int size, bool keepLatestCopy, const DataType& defaultValue)
-:_defaultValue(defaultValue), _latestMemoryBufferExists(keepLatestCopy)
+:_defaultValue(defaultValue), _latestMemoryBufferExists(keepLatestCopy), _dirtyGeneration(1)
 {
 	_memory.resize(size, _defaultValue);
 	if (_latestMemoryBufferExists)
 	{
 		_latestMemory.resize(size, _defaultValue);
 	}
+	MarkAllDirty();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -111,6 +113,7 @@ template<class DataType, class TimesliceType>
 void RandomTimeAccessBuffer<DataType, TimesliceType>::Resize(unsigned int size, bool keepLatestCopy)
 {
 	std::unique_lock<std::mutex> lock(_accessLock);
+	_referencedBlocks.clear();
 	_latestMemoryBufferExists = keepLatestCopy;
 	_memory.resize(size, _defaultValue);
 	if (_latestMemoryBufferExists)
@@ -121,6 +124,7 @@ void RandomTimeAccessBuffer<DataType, TimesliceType>::Resize(unsigned int size,
 	{
 		_latestMemory.clear();
 	}
+	MarkAllDirty();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -241,6 +245,7 @@ template<class DataType, class TimesliceType>
 void RandomTimeAccessBuffer<DataType, TimesliceType>::Write(unsigned int address, TimesliceType writeTime, const DataType& data)
 {
 	std::unique_lock<std::mutex> lock(_accessLock);
+	ReleaseReferencedBlocks();
 
 	WriteEntry entry(address, writeTime, data, _latestTimeslice);
 
@@ -257,6 +262,7 @@ void RandomTimeAccessBuffer<DataType, TimesliceType>::Write(unsigned int address
 		++i;
 	}
 	_writeList.insert(i.base(), entry);
+	MarkAddressDirty(address);
 
 	// If we're holding a cached copy of the latest memory state, update it.
 	if (_latestMemoryBufferExists && updateLatestBufferContents)
@@ -269,6 +275,18 @@ void RandomTimeAccessBuffer<DataType, TimesliceType>::Write(unsigned int address
 template<class DataType, class TimesliceType>
 DataType& RandomTimeAccessBuffer<DataType, TimesliceType>::ReferenceCommitted(unsigned int address)
 {
+	// We have no way of knowing whether the caller will modify the target through the
+	// returned reference, so we have to assume it will. Since any modification only
+	// happens after we return, marking the block as dirty here isn't enough, as the
+	// changes could be collected between our mark and the write, and the write would then
+	// never be reported. Instead, we record the block as referenced. Referenced blocks are
+	// marked dirty again each time changes are collected, and are finally marked and
+	// released on the next write-side operation on this buffer, by which point the caller
+	// has finished with the reference.
+	std::unique_lock<std::mutex> lock(_accessLock);
+	ReleaseReferencedBlocks();
+	_referencedBlocks.push_back(address / DirtyBlockSize);
+	MarkAddressDirty(address);
 	return _memory[address];
 }
 
@@ -333,6 +351,13 @@ void RandomTimeAccessBuffer<DataType, TimesliceType>::WriteCommitted(unsigned in
 	// core, and incorrectly too from what I can tell. Calling WriteLatest is the correct
 	// thing to do in this kind of case, not WriteCommitted.
 	_memory[address] = data;
+
+	// Note that we mark the block as dirty only after the write has been made, so that a
+	// concurrent collection of changes either sees the new value, or has a block
+	// generation which causes the block to be reported again on the next collection.
+	std::unique_lock<std::mutex> lock(_accessLock);
+	ReleaseReferencedBlocks();
+	MarkAddressDirty(address);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -370,6 +395,7 @@ template<class DataType, class TimesliceType>
 void RandomTimeAccessBuffer<DataType, TimesliceType>::WriteLatest(unsigned int address, const DataType& data)
 {
 	std::unique_lock<std::mutex> lock(_accessLock);
+	ReleaseReferencedBlocks();
 
 	// Erase any write entries to this address in any timeslice. We do this to prevent
 	// uncommitted writes from overwriting this change. This write function should make
@@ -389,6 +415,7 @@ void RandomTimeAccessBuffer<DataType, TimesliceType>::WriteLatest(unsigned int a
 
 	// Write the new value directly to the committed state
 	_memory[address] = data;
+	MarkAddressDirty(address);
 
 	// If we're holding a cached copy of the latest memory state, update it.
 	if (_latestMemoryBufferExists)
@@ -454,6 +481,110 @@ void RandomTimeAccessBuffer<DataType, TimesliceType>::GetLatestBufferCopy(DataTy
 	}
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// This function updates a copy of the latest buffer state which was previously populated
+// by this function, copying only the blocks of DirtyBlockSize entries which have been
+// modified since the generation number returned by the prior call. Passing a generation
+// number of 0 copies the entire buffer. The changedBlockBitmap array must contain at least
+// (GetDirtyBlockCount(bufferSize) + 31) / 32 entries, and on return has a bit set for each
+// block which was copied, with block 0 in bit 0 of the first entry. The returned generation
+// number should be passed back in on the next call.
+//----------------------------------------------------------------------------------------------------------------------
+template<class DataType, class TimesliceType>
+unsigned int RandomTimeAccessBuffer<DataType, TimesliceType>::GetLatestBufferChanges(unsigned int sinceGeneration, DataType* buffer, unsigned int bufferSize, unsigned int* changedBlockBitmap) const
+{
+	std::unique_lock<std::mutex> lock(_accessLock);
+
+	// Determine the number of elements and blocks to examine
+	unsigned int copySize = (bufferSize > (unsigned int)_memory.size())? (unsigned int)_memory.size(): bufferSize;
+	unsigned int blockCount = GetDirtyBlockCount(copySize);
+	unsigned int bitmapEntryCount = (GetDirtyBlockCount(bufferSize) + 31) / 32;
+	for (unsigned int i = 0; i < bitmapEntryCount; ++i)
+	{
+		changedBlockBitmap[i] = 0;
+	}
+
+	// Copy each block which has been modified since the target generation
+	const std::vector<DataType>& sourceMemory = (_latestMemoryBufferExists)? _latestMemory: _memory;
+	for (unsigned int blockNo = 0; blockNo < blockCount; ++blockNo)
+	{
+		if (_blockGeneration[blockNo] < sinceGeneration)
+		{
+			continue;
+		}
+		unsigned int blockStart = blockNo * DirtyBlockSize;
+		unsigned int blockSize = ((copySize - blockStart) < DirtyBlockSize)? (copySize - blockStart): DirtyBlockSize;
+		memcpy((void*)&buffer[blockStart], (const void*)&sourceMemory[blockStart], (size_t)blockSize * sizeof(DataType));
+		changedBlockBitmap[blockNo / 32] |= (1u << (blockNo % 32));
+	}
+
+	// If we're not caching the latest memory state, apply each buffered write entry which
+	// falls within a copied block. Writes to blocks we didn't copy are already reflected in
+	// the caller's buffer.
+	if (!_latestMemoryBufferExists)
+	{
+		for (typename std::list<WriteEntry>::const_iterator i = _writeList.begin(); i != _writeList.end(); ++i)
+		{
+			unsigned int blockNo = i->writeAddress / DirtyBlockSize;
+			if ((i->writeAddress < copySize) && (_blockGeneration[blockNo] >= sinceGeneration))
+			{
+				buffer[i->writeAddress] = i->newValue;
+			}
+		}
+	}
+
+	// Advance to a new generation, so that any further changes are reported on the next
+	// call. Blocks which are still referenced through ReferenceCommitted may yet be
+	// modified, so we keep them marked as dirty in the new generation.
+	++_dirtyGeneration;
+	for (unsigned int i = 0; i < (unsigned int)_referencedBlocks.size(); ++i)
+	{
+		_blockGeneration[_referencedBlocks[i]] = _dirtyGeneration;
+	}
+	return _dirtyGeneration;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class DataType, class TimesliceType>
+unsigned int RandomTimeAccessBuffer<DataType, TimesliceType>::GetDirtyBlockCount(unsigned int bufferSize)
+{
+	return (bufferSize + (DirtyBlockSize - 1)) / DirtyBlockSize;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Dirty block tracking functions
+//----------------------------------------------------------------------------------------------------------------------
+// Note that the block generation and current generation numbers are only accessed with
+// the access lock held, which must be held when calling any of these functions, except
+// from a constructor.
+//----------------------------------------------------------------------------------------------------------------------
+template<class DataType, class TimesliceType>
+void RandomTimeAccessBuffer<DataType, TimesliceType>::MarkAddressDirty(unsigned int address) const
+{
+	_blockGeneration[address / DirtyBlockSize] = _dirtyGeneration;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class DataType, class TimesliceType>
+void RandomTimeAccessBuffer<DataType, TimesliceType>::MarkAllDirty()
+{
+	_blockGeneration.assign(GetDirtyBlockCount((unsigned int)_memory.size()), _dirtyGeneration);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class DataType, class TimesliceType>
+void RandomTimeAccessBuffer<DataType, TimesliceType>::ReleaseReferencedBlocks()
+{
+	// Any references previously returned by ReferenceCommitted are no longer in use once a
+	// further write-side operation is made on this buffer, so we mark the referenced
+	// blocks as dirty one final time now that any modifications have been made.
+	for (unsigned int i = 0; i < (unsigned int)_referencedBlocks.size(); ++i)
+	{
+		_blockGeneration[_referencedBlocks[i]] = _dirtyGeneration;
+	}
+	_referencedBlocks.clear();
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Time management functions
 //----------------------------------------------------------------------------------------------------------------------
@@ -461,6 +592,7 @@ template<class DataType, class TimesliceType>
 void RandomTimeAccessBuffer<DataType, TimesliceType>::Initialize()
 {
 	std::unique_lock<std::mutex> lock(_accessLock);
+	_referencedBlocks.clear();
 
 	// Initialize buffers
 	for (unsigned int i = 0; i < _memory.size(); ++i)
@@ -478,6 +610,7 @@ void RandomTimeAccessBuffer<DataType, TimesliceType>::Initialize()
 	_timesliceList.clear();
 	_currentTimeOffset = 0;
 	_latestTimeslice = _timesliceList.end();
+	MarkAllDirty();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -911,6 +1044,7 @@ template<class DataType, class TimesliceType>
 void RandomTimeAccessBuffer<DataType, TimesliceType>::Commit()
 {
 	std::unique_lock<std::mutex> lock(_accessLock);
+	ReleaseReferencedBlocks();
 
 	// Flag all timeslices as committed
 	typename std::list<TimesliceEntry>::reverse_iterator i = _timesliceList.rbegin();
@@ -926,11 +1060,13 @@ template<class DataType, class TimesliceType>
 void RandomTimeAccessBuffer<DataType, TimesliceType>::Rollback()
 {
 	std::unique_lock<std::mutex> lock(_accessLock);
+	ReleaseReferencedBlocks();
 
 	// Erase non-committed memory writes
 	typename std::list<WriteEntry>::reverse_iterator writeListIterator = _writeList.rbegin();
 	while ((writeListIterator != _writeList.rend()) && (!writeListIterator->currentTimeslice->committed))
 	{
+		MarkAddressDirty(writeListIterator->writeAddress);
 		++writeListIterator;
 	}
 	_writeList.erase(writeListIterator.base(), _writeList.end());
@@ -1092,6 +1228,11 @@ bool RandomTimeAccessBuffer<DataType, TimesliceType>::LoadState(IHierarchicalSto
 		}
 	}
 
+	// Mark the whole buffer as dirty now that the new state has been loaded
+	std::unique_lock<std::mutex> lock(_accessLock);
+	_referencedBlocks.clear();
+	MarkAllDirty();
+
 	return true;
 }
 
@@ -0,0 +1,150 @@
+#include "catch.hpp"
+#include "TimedBuffers/TimedBuffers.pkg"
+#include <thread>
+#include <atomic>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Types
+//----------------------------------------------------------------------------------------------------------------------
+typedef RandomTimeAccessBuffer<unsigned int, double> TestBuffer;
+static const unsigned int TestBufferSize = 1000;
+static const unsigned int TestBlockCount = (TestBufferSize + (TestBuffer::DirtyBlockSize - 1)) / TestBuffer::DirtyBlockSize;
+static const unsigned int TestBitmapSize = (TestBlockCount + 31) / 32;
+
+//----------------------------------------------------------------------------------------------------------------------
+// Helper functions
+//----------------------------------------------------------------------------------------------------------------------
+static bool IsBlockChanged(const std::vector<unsigned int>& changedBlockBitmap, unsigned int blockNo)
+{
+	return (changedBlockBitmap[blockNo / 32] & (1u << (blockNo % 32))) != 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static unsigned int CountChangedBlocks(const std::vector<unsigned int>& changedBlockBitmap)
+{
+	unsigned int changedBlockCount = 0;
+	for (unsigned int blockNo = 0; blockNo < TestBlockCount; ++blockNo)
+	{
+		if (IsBlockChanged(changedBlockBitmap, blockNo))
+		{
+			++changedBlockCount;
+		}
+	}
+	return changedBlockCount;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Tests
+//----------------------------------------------------------------------------------------------------------------------
+TEST_CASE("RandomTimeAccessBuffer::GetLatestBufferChanges", "")
+{
+	TestBuffer buffer(TestBufferSize, false, 0);
+	std::vector<unsigned int> mirror(TestBufferSize, 0xFFFFFFFF);
+	std::vector<unsigned int> changedBlockBitmap(TestBitmapSize);
+
+	// The first call has to report the entire buffer
+	unsigned int generation = buffer.GetLatestBufferChanges(0, &mirror[0], TestBufferSize, &changedBlockBitmap[0]);
+	REQUIRE(CountChangedBlocks(changedBlockBitmap) == TestBlockCount);
+	for (unsigned int i = 0; i < TestBufferSize; ++i)
+	{
+		REQUIRE(mirror[i] == 0);
+	}
+
+	// With no changes, nothing should be reported
+	generation = buffer.GetLatestBufferChanges(generation, &mirror[0], TestBufferSize, &changedBlockBitmap[0]);
+	REQUIRE(CountChangedBlocks(changedBlockBitmap) == 0);
+
+	SECTION("Committed writes", "")
+	{
+		unsigned int address = (TestBuffer::DirtyBlockSize * 2) + 5;
+		buffer.WriteCommitted(address, 0x1234);
+		generation = buffer.GetLatestBufferChanges(generation, &mirror[0], TestBufferSize, &changedBlockBitmap[0]);
+		REQUIRE(CountChangedBlocks(changedBlockBitmap) == 1);
+		REQUIRE(IsBlockChanged(changedBlockBitmap, 2));
+		REQUIRE(mirror[address] == 0x1234);
+
+		generation = buffer.GetLatestBufferChanges(generation, &mirror[0], TestBufferSize, &changedBlockBitmap[0]);
+		REQUIRE(CountChangedBlocks(changedBlockBitmap) == 0);
+	}
+
+	SECTION("Buffered writes", "")
+	{
+		unsigned int address = (TestBuffer::DirtyBlockSize * 5) + 1;
+		buffer.AddTimeslice(1000.0);
+		buffer.Write(address, 10.0, 0x55);
+		generation = buffer.GetLatestBufferChanges(generation, &mirror[0], TestBufferSize, &changedBlockBitmap[0]);
+		REQUIRE(CountChangedBlocks(changedBlockBitmap) == 1);
+		REQUIRE(IsBlockChanged(changedBlockBitmap, 5));
+		REQUIRE(mirror[address] == 0x55);
+	}
+
+	SECTION("Writes through references", "")
+	{
+		// Obtain a reference, then collect changes before the write is made through it, as
+		// can happen when a debugger view refreshes while the owning device is running.
+		unsigned int address = (TestBuffer::DirtyBlockSize * 7) + 3;
+		unsigned int& target = buffer.ReferenceCommitted(address);
+		generation = buffer.GetLatestBufferChanges(generation, &mirror[0], TestBufferSize, &changedBlockBitmap[0]);
+		REQUIRE(IsBlockChanged(changedBlockBitmap, 7));
+		REQUIRE(mirror[address] == 0);
+		target = 0xABCD;
+
+		// The write must be picked up on the next call
+		generation = buffer.GetLatestBufferChanges(generation, &mirror[0], TestBufferSize, &changedBlockBitmap[0]);
+		REQUIRE(IsBlockChanged(changedBlockBitmap, 7));
+		REQUIRE(mirror[address] == 0xABCD);
+
+		// Once another write-side operation has been made, the reference is released, and
+		// the block is reported one final time only.
+		buffer.WriteCommitted(0, 1);
+		generation = buffer.GetLatestBufferChanges(generation, &mirror[0], TestBufferSize, &changedBlockBitmap[0]);
+		REQUIRE(CountChangedBlocks(changedBlockBitmap) == 2);
+		REQUIRE(IsBlockChanged(changedBlockBitmap, 0));
+		REQUIRE(IsBlockChanged(changedBlockBitmap, 7));
+		generation = buffer.GetLatestBufferChanges(generation, &mirror[0], TestBufferSize, &changedBlockBitmap[0]);
+		REQUIRE(CountChangedBlocks(changedBlockBitmap) == 0);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST_CASE("RandomTimeAccessBuffer::GetLatestBufferChanges concurrent writes", "")
+{
+	TestBuffer buffer(TestBufferSize, false, 0);
+	std::vector<unsigned int> mirror(TestBufferSize, 0);
+	std::vector<unsigned int> changedBlockBitmap(TestBitmapSize);
+	unsigned int generation = buffer.GetLatestBufferChanges(0, &mirror[0], TestBufferSize, &changedBlockBitmap[0]);
+
+	// Modify the buffer from a separate thread, alternating between direct writes and
+	// writes through references, while we repeatedly collect changes on this thread.
+	std::atomic<bool> writerComplete(false);
+	std::thread writerThread([&]()
+	{
+		unsigned int address = 0;
+		for (unsigned int i = 1; i <= 200000; ++i)
+		{
+			address = (address + 97) % TestBufferSize;
+			if ((i % 2) == 0)
+			{
+				buffer.WriteCommitted(address, i);
+			}
+			else
+			{
+				buffer.ReferenceCommitted(address) = i;
+			}
+		}
+		writerComplete = true;
+	});
+	while (!writerComplete)
+	{
+		generation = buffer.GetLatestBufferChanges(generation, &mirror[0], TestBufferSize, &changedBlockBitmap[0]);
+	}
+	writerThread.join();
+
+	// A single further call must be enough to bring our copy fully up to date
+	buffer.GetLatestBufferChanges(generation, &mirror[0], TestBufferSize, &changedBlockBitmap[0]);
+	for (unsigned int i = 0; i < TestBufferSize; ++i)
+	{
+		REQUIRE(mirror[i] == buffer.ReadCommitted(i));
+	}
+}
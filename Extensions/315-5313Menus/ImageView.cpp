@@ -523,13 +523,18 @@ void ImageView::UpdateImage()
 		--_windowPendingClearCount;
 	}
 
-	// Determine the index of the current image plane that is being used for display
-	unsigned int displayingImageBufferPlane = _model.GetImageCompletedBufferPlaneNo();
+	// Pin the latest completed image plane for display. The plane contents and frame
+	// settings remain stable until we release it at the end of this update. Note that the
+	// frame token is read after the plane is pinned, so if the plane has just moved on to
+	// a newer frame, the new token will always be visible here.
+	unsigned int displayingImageBufferPlane = _model.LockImageBufferData();
+	unsigned int latestLastRenderedFrameToken = _model.GetImageLastRenderedFrameToken();
 
 	// Obtain the number of rows in this frame
 	unsigned int rowCount = _model.GetImageBufferLineCount(displayingImageBufferPlane);
 	if (rowCount <= 0)
 	{
+		_model.UnlockImageBufferData();
 		return;
 	}
 
@@ -541,13 +546,10 @@ void ImageView::UpdateImage()
 
 	// If a new frame is ready to be displayed, update our image texture with the new
 	// rendered image data.
-	unsigned int latestLastRenderedFrameToken = _model.GetImageLastRenderedFrameToken();
 	if (_model.GetVideoSingleBuffering() || (_lastRenderedFrameTokenCached != latestLastRenderedFrameToken))
 	{
 		// Copy the contents of the image buffer into our image texture for rendering
-		_model.LockImageBufferData(displayingImageBufferPlane);
 		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _model.ImageBufferWidth, rowCount, GL_RGBA, GL_UNSIGNED_BYTE, _model.GetImageBufferData(displayingImageBufferPlane));
-		_model.UnlockImageBufferData(displayingImageBufferPlane);
 
 		// Update our cached last rendered frame token
 		unsigned int framesCompletedDrawing = latestLastRenderedFrameToken - _lastRenderedFrameTokenCached;
@@ -758,6 +760,9 @@ void ImageView::UpdateImage()
 		}
 	}
 
+	// Release our pin on the displayed image plane
+	_model.UnlockImageBufferData();
+
 	// Signal the OpenGL drawing operations to start as quickly as possible
 	glFlush();
 }
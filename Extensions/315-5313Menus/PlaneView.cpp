@@ -1,6 +1,7 @@
 #include "PlaneView.h"
 #include "resource.h"
 #include <DataConversion/DataConversion.pkg>
+#include <algorithm>
 
 //----------------------------------------------------------------------------------------------------------------------
 // Constructors
@@ -11,6 +12,7 @@ PlaneView::PlaneView(IUIManager& uiManager, PlaneViewPresenter& presenter, IS315
 	_glrc = 0;
 	_buffer = 0;
 	_hwndRender = NULL;
+	_vramDataGeneration = 0;
 	_zoomSettings = { 1.0f, 1.5f, 2.0f, 2.5f, 3.0f, 3.5f, 4.0f, 4.5f, 5.0f, 5.5f, 6.0f, 6.5f, 7.0f, 7.5f, 8.0f, 8.5f, 9.0f, 9.5f, 10.0f };
 
 	_selectedLayer = SELECTEDLAYER_LAYERA;
@@ -867,82 +869,69 @@ LRESULT PlaneView::msgRenderWM_TIMER(HWND hwnd, WPARAM wparam, LPARAM lparam)
 	renderRegionPixelEndX = (renderRegionPixelEndX >= (selectedPlaneWidth * blockPixelSizeX)) ? (selectedPlaneWidth * blockPixelSizeX) : renderRegionPixelEndX;
 	renderRegionPixelEndY = (renderRegionPixelEndY >= (selectedPlaneHeight * blockPixelSizeY)) ? (selectedPlaneHeight * blockPixelSizeY) : renderRegionPixelEndY;
 
-	// Obtain a copy of the current VRAM data buffer
+	// Update our copy of the current VRAM data buffer. Only the blocks of data which have
+	// changed since our last update are retrieved.
 	_model.LockExternalBuffers();
 	ITimedBufferInt* vramBuffer = _model.GetVRAMBuffer();
-	std::vector<unsigned char> vramDataCopy(IS315_5313::VramSize, 0);
 	if (vramBuffer != 0)
 	{
-		vramBuffer->GetLatestBufferCopy(vramDataCopy);
+		_vramDataGeneration = vramBuffer->GetLatestBufferChanges(_vramDataGeneration, _vramDataCopy, _vramChangedBlockBitmap);
 	}
 	_model.UnlockExternalBuffers();
+	if (_vramDataCopy.size() < IS315_5313::VramSize)
+	{
+		_vramDataCopy.assign(IS315_5313::VramSize, 0);
+		_vramDataGeneration = 0;
+	}
+	const std::vector<unsigned char>& vramDataCopy = _vramDataCopy;
 
-	// Fill the plane render buffer
-	for (unsigned int ypos = 0; ypos < _bufferHeight; ++ypos)
+	// Decode the full set of palette colours
+	VDPDecoder::RGBAColor palette[VDPDecoder::PaletteRowCount * VDPDecoder::PaletteRowEntryCount];
+	for (unsigned int paletteRow = 0; paletteRow < VDPDecoder::PaletteRowCount; ++paletteRow)
 	{
-		for (unsigned int xpos = 0; xpos < _bufferWidth; ++xpos)
+		for (unsigned int paletteIndex = 0; paletteIndex < VDPDecoder::PaletteRowEntryCount; ++paletteIndex)
 		{
-			// Calculate the position of the current pixel in the currently selected layer
-			unsigned int layerPixelPosX = renderRegionPixelStartX + xpos;
-			unsigned int layerPixelPosY = renderRegionPixelStartY + ypos;
-
-			// Retrieve the pixel value for the selected layer at the current position
-			bool outsideSelectedPlane = true;
-			unsigned int paletteRow = { };
-			unsigned int paletteIndex = { };
-			switch (_selectedLayer)
-			{
-			case SELECTEDLAYER_LAYERA:
-				GetScrollPlanePaletteInfo(vramDataCopy, _layerAMappingBase, _layerAPatternBase, _layerAScrollPlaneWidth, _layerAScrollPlaneHeight, layerPixelPosX, layerPixelPosY, interlaceMode2Active, paletteRow, paletteIndex);
-				outsideSelectedPlane = (layerPixelPosX >= (_layerAScrollPlaneWidth * blockPixelSizeX)) || (layerPixelPosY >= (_layerAScrollPlaneHeight * blockPixelSizeY));
-				break;
-			case SELECTEDLAYER_LAYERB:
-				GetScrollPlanePaletteInfo(vramDataCopy, _layerBMappingBase, _layerBPatternBase, _layerBScrollPlaneWidth, _layerBScrollPlaneHeight, layerPixelPosX, layerPixelPosY, interlaceMode2Active, paletteRow, paletteIndex);
-				outsideSelectedPlane = (layerPixelPosX >= (_layerBScrollPlaneWidth * blockPixelSizeX)) || (layerPixelPosY >= (_layerBScrollPlaneHeight * blockPixelSizeY));
-				break;
-			case SELECTEDLAYER_WINDOW:
-				GetScrollPlanePaletteInfo(vramDataCopy, _windowMappingBase, _windowPatternBase, _windowScrollPlaneWidth, _windowScrollPlaneHeight, layerPixelPosX, layerPixelPosY, interlaceMode2Active, paletteRow, paletteIndex);
-				outsideSelectedPlane = (layerPixelPosX >= (_windowScrollPlaneWidth * blockPixelSizeX)) || (layerPixelPosY >= (_windowScrollPlaneHeight * blockPixelSizeY));
-				break;
-			case SELECTEDLAYER_SPRITES:
-				// If the sprite plane is selected, just fill the buffer with the backdrop
-				// colour where appropriate for now. We'll fill in sprite data later.
-				paletteRow = 0;
-				paletteIndex = 0;
-				outsideSelectedPlane = (layerPixelPosX >= (_spriteScrollPlaneWidth * blockPixelSizeX)) || (layerPixelPosY >= (_spriteScrollPlaneHeight * blockPixelSizeY));
-				break;
-			}
-
-			// Set the initial state for the output colour for this pixel
-			unsigned char colorR = 0;
-			unsigned char colorG = 0;
-			unsigned char colorB = 0;
-
-			// If this pixel isn't outside the boundaries of the currently selected plane,
-			// decode the selected palette colour value for this pixel.
-			if (!outsideSelectedPlane)
-			{
-				// If the pixel for the selected layer is transparent, select the current
-				// background colour.
-				if (paletteIndex == 0)
-				{
-					paletteRow = paletteRowBackground;
-					paletteIndex = paletteIndexBackground;
-				}
-
-				// Decode the colour for the target palette entry
-				IS315_5313::DecodedPaletteColorEntry color = _model.ReadDecodedPaletteColor(paletteRow, paletteIndex);
-				colorR = _model.ColorValueTo8BitValue(color.r, false, false);
-				colorG = _model.ColorValueTo8BitValue(color.g, false, false);
-				colorB = _model.ColorValueTo8BitValue(color.b, false, false);
-			}
-
-			// Write this pixel colour value into the data buffer
-			_buffer[((xpos + (ypos * _bufferWidth)) * 4) + 0] = colorR;
-			_buffer[((xpos + (ypos * _bufferWidth)) * 4) + 1] = colorG;
-			_buffer[((xpos + (ypos * _bufferWidth)) * 4) + 2] = colorB;
-			_buffer[((xpos + (ypos * _bufferWidth)) * 4) + 3] = 0xFF;
+			IS315_5313::DecodedPaletteColorEntry color = _model.ReadDecodedPaletteColor(paletteRow, paletteIndex);
+			unsigned char colorR = _model.ColorValueTo8BitValue(color.r, false, false);
+			unsigned char colorG = _model.ColorValueTo8BitValue(color.g, false, false);
+			unsigned char colorB = _model.ColorValueTo8BitValue(color.b, false, false);
+			palette[(paletteRow * VDPDecoder::PaletteRowEntryCount) + paletteIndex] = VDPDecoder::RGBAColor(colorR, colorG, colorB);
+		}
+	}
+	VDPDecoder::RGBAColor backdropColor = palette[(paletteRowBackground * VDPDecoder::PaletteRowEntryCount) + paletteIndexBackground];
+
+	// Calculate the size of the region of the data buffer which lies within the boundaries
+	// of the currently selected plane
+	unsigned int selectedPlanePixelWidth = selectedPlaneWidth * blockPixelSizeX;
+	unsigned int selectedPlanePixelHeight = selectedPlaneHeight * blockPixelSizeY;
+	unsigned int planeRegionWidth = (renderRegionPixelStartX < selectedPlanePixelWidth)? selectedPlanePixelWidth - renderRegionPixelStartX: 0;
+	unsigned int planeRegionHeight = (renderRegionPixelStartY < selectedPlanePixelHeight)? selectedPlanePixelHeight - renderRegionPixelStartY: 0;
+	planeRegionWidth = (planeRegionWidth > _bufferWidth)? _bufferWidth: planeRegionWidth;
+	planeRegionHeight = (planeRegionHeight > _bufferHeight)? _bufferHeight: planeRegionHeight;
+
+	// Fill the plane render buffer. Any pixels which lie outside the boundaries of the
+	// currently selected plane are set to black.
+	VDPDecoder::RGBAColor* outputBuffer = (VDPDecoder::RGBAColor*)_buffer;
+	std::fill(outputBuffer, outputBuffer + (_bufferWidth * _bufferHeight), VDPDecoder::RGBAColor(0, 0, 0));
+	switch (_selectedLayer)
+	{
+	case SELECTEDLAYER_LAYERA:
+		VDPDecoder::DecodeNameTableRegion(&vramDataCopy[0], _layerAMappingBase, _layerAPatternBase, _layerAScrollPlaneWidth, _layerAScrollPlaneHeight, interlaceMode2Active, renderRegionPixelStartX, renderRegionPixelStartY, planeRegionWidth, planeRegionHeight, &palette[0], backdropColor, outputBuffer, _bufferWidth);
+		break;
+	case SELECTEDLAYER_LAYERB:
+		VDPDecoder::DecodeNameTableRegion(&vramDataCopy[0], _layerBMappingBase, _layerBPatternBase, _layerBScrollPlaneWidth, _layerBScrollPlaneHeight, interlaceMode2Active, renderRegionPixelStartX, renderRegionPixelStartY, planeRegionWidth, planeRegionHeight, &palette[0], backdropColor, outputBuffer, _bufferWidth);
+		break;
+	case SELECTEDLAYER_WINDOW:
+		VDPDecoder::DecodeNameTableRegion(&vramDataCopy[0], _windowMappingBase, _windowPatternBase, _windowScrollPlaneWidth, _windowScrollPlaneHeight, interlaceMode2Active, renderRegionPixelStartX, renderRegionPixelStartY, planeRegionWidth, planeRegionHeight, &palette[0], backdropColor, outputBuffer, _bufferWidth);
+		break;
+	case SELECTEDLAYER_SPRITES:
+		// If the sprite plane is selected, just fill the buffer with the backdrop colour
+		// where appropriate for now. We'll fill in sprite data later.
+		for (unsigned int ypos = 0; ypos < planeRegionHeight; ++ypos)
+		{
+			std::fill(outputBuffer + (ypos * _bufferWidth), outputBuffer + (ypos * _bufferWidth) + planeRegionWidth, backdropColor);
 		}
+		break;
 	}
 
 	// If the sprite plane is currently selected, render each sprite to the buffer.
@@ -953,77 +942,17 @@ LRESULT PlaneView::msgRenderWM_TIMER(HWND hwnd, WPARAM wparam, LPARAM lparam)
 		unsigned int maxSpriteCount = (h40ModeActive)? 80: 64;
 		unsigned int currentSpriteNo = 0;
 		std::set<unsigned int> processedSprites;
+		unsigned int renderRegionWidth = (renderRegionPixelEndX > renderRegionPixelStartX)? renderRegionPixelEndX - renderRegionPixelStartX: 0;
+		unsigned int renderRegionHeight = (renderRegionPixelEndY > renderRegionPixelStartY)? renderRegionPixelEndY - renderRegionPixelStartY: 0;
 		do
 		{
 			// Read the mapping data for this sprite
-			IS315_5313::SpriteMappingTableEntry spriteMapping = _model.GetSpriteMappingTableEntry(_spriteMappingBase, currentSpriteNo);
+			VDPDecoder::SpriteTableEntry spriteMapping = VDPDecoder::DecodeSpriteTableEntry(&vramDataCopy[0], _spriteMappingBase, currentSpriteNo);
 
 			// Render this sprite to the buffer
 			unsigned int spriteHeightInCells = spriteMapping.height + 1;
 			unsigned int spriteWidthInCells = spriteMapping.width + 1;
-			for (unsigned int ypos = 0; ypos < (spriteHeightInCells * blockPixelSizeY); ++ypos)
-			{
-				for (unsigned int xpos = 0; xpos < (spriteWidthInCells * blockPixelSizeX); ++xpos)
-				{
-					// If this sprite pixel lies outside the visible buffer region, skip
-					// it.
-					if (((spriteMapping.xpos + xpos) < renderRegionPixelStartX) || ((spriteMapping.xpos + xpos) >= renderRegionPixelEndX)
-					|| ((spriteMapping.ypos + ypos) < renderRegionPixelStartY) || ((spriteMapping.ypos + ypos) >= renderRegionPixelEndY))
-					{
-						continue;
-					}
-
-					// Calculate the target pixel row and column number within the sprite
-					unsigned int pixelRowNo = (spriteMapping.vflip)? ((spriteHeightInCells * blockPixelSizeY) - 1) - ypos: ypos;
-					unsigned int pixelColumnNo = (spriteMapping.hflip)? ((spriteWidthInCells * blockPixelSizeX) - 1) - xpos: xpos;
-
-					// Calculate the row and column numbers for the target block within the
-					// sprite, and the target pattern data within that block.
-					unsigned int blockRowNo = pixelRowNo / blockPixelSizeY;
-					unsigned int blockColumnNo = pixelColumnNo / blockPixelSizeX;
-					unsigned int blockOffset = (blockColumnNo * spriteHeightInCells) + blockRowNo;
-					unsigned int patternRowNo = pixelRowNo % blockPixelSizeY;
-					unsigned int patternColumnNo = pixelColumnNo % blockPixelSizeX;
-
-					// Calculate the VRAM address of the target pattern row data
-					const unsigned int patternDataRowByteSize = 4;
-					const unsigned int blockPatternByteSize = blockPixelSizeY * patternDataRowByteSize;
-					unsigned int patternRowDataAddress = (((spriteMapping.blockNumber + blockOffset) * blockPatternByteSize) + (patternRowNo * patternDataRowByteSize)) % (unsigned int)vramDataCopy.size();
-					patternRowDataAddress = (_spritePatternBase + patternRowDataAddress) % (unsigned int)vramDataCopy.size();
-
-					// Read the pattern data byte for the target pixel in the target block
-					const unsigned int pixelsPerPatternByte = 2;
-					unsigned int patternByteNo = patternColumnNo / pixelsPerPatternByte;
-					bool patternDataUpperHalf = (patternColumnNo % pixelsPerPatternByte) == 0;
-					Data patternData(8, vramDataCopy[patternRowDataAddress + patternByteNo]);
-
-					// Return the target palette row and index numbers
-					unsigned int paletteRow = spriteMapping.paletteLine;
-					unsigned int paletteIndex = patternData.GetDataSegment((patternDataUpperHalf)? 4: 0, 4);
-
-					// If this pixel is transparent, skip it.
-					if (paletteIndex == 0)
-					{
-						continue;
-					}
-
-					// Decode the colour for the target palette entry
-					IS315_5313::DecodedPaletteColorEntry color = _model.ReadDecodedPaletteColor(paletteRow, paletteIndex);
-					unsigned char colorR = _model.ColorValueTo8BitValue(color.r, false, false);
-					unsigned char colorG = _model.ColorValueTo8BitValue(color.g, false, false);
-					unsigned char colorB = _model.ColorValueTo8BitValue(color.b, false, false);
-
-					// Calculate the location of the target pixel within the data buffer
-					unsigned int spritePixelPosXInBuffer = (spriteMapping.xpos + xpos) - renderRegionPixelStartX;
-					unsigned int spritePixelPosYInBuffer = (spriteMapping.ypos + ypos) - renderRegionPixelStartY;
-
-					// Write this pixel colour value into the data buffer
-					_buffer[((spritePixelPosXInBuffer + (spritePixelPosYInBuffer * _bufferWidth)) * 4) + 0] = colorR;
-					_buffer[((spritePixelPosXInBuffer + (spritePixelPosYInBuffer * _bufferWidth)) * 4) + 1] = colorG;
-					_buffer[((spritePixelPosXInBuffer + (spritePixelPosYInBuffer * _bufferWidth)) * 4) + 2] = colorB;
-					_buffer[((spritePixelPosXInBuffer + (spritePixelPosYInBuffer * _bufferWidth)) * 4) + 3] = 0xFF;
-				}
-			}
+			VDPDecoder::DecodeSprite(&vramDataCopy[0], _spritePatternBase, spriteMapping, interlaceMode2Active, &palette[0], renderRegionPixelStartX, renderRegionPixelStartY, renderRegionWidth, renderRegionHeight, outputBuffer, _bufferWidth);
 
 			// Calculate the boundaries of this sprite if requested
 			if (_spriteBoundaries)
@@ -1333,42 +1262,6 @@ void PlaneView::UpdateRenderWindowSize(HWND hwnd, int renderWindowWidth, int ren
 
 //----------------------------------------------------------------------------------------------------------------------
 // Render helper methods
-//----------------------------------------------------------------------------------------------------------------------
-void PlaneView::GetScrollPlanePaletteInfo(const std::vector<unsigned char>& vramData, unsigned int mappingBaseAddress, unsigned int patternBaseAddress, unsigned int planeWidth, unsigned int planeHeight, unsigned int xpos, unsigned int ypos, bool interlaceMode2Active, unsigned int& paletteRow, unsigned int& paletteIndex) const
-{
-	// Constants
-	const unsigned int mappingByteSize = 2;
-	const unsigned int pixelsPerPatternByte = 2;
-	unsigned int blockPixelSizeX = 8;
-	unsigned int blockPixelSizeY = (interlaceMode2Active)? 16: 8;
-
-	// Determine the address of the mapping data to use for this layer
-	unsigned int mappingIndex = (((ypos / blockPixelSizeY) % planeHeight) * planeWidth) + ((xpos / blockPixelSizeX) % planeWidth);
-	unsigned int mappingAddress = (mappingBaseAddress + (mappingIndex * mappingByteSize)) % (unsigned int)vramData.size();
-
-	// Read the mapping data
-	Data mappingData(16);
-	mappingData.SetUpperHalf(vramData[mappingAddress+0]);
-	mappingData.SetLowerHalf(vramData[mappingAddress+1]);
-
-	// Determine the address of the target row in the target block
-	unsigned int patternRowNumberNoFlip = ypos % blockPixelSizeY;
-	unsigned int patternRowNumber = _model.CalculatePatternDataRowNumber(patternRowNumberNoFlip, interlaceMode2Active, mappingData);
-	unsigned int patternRowDataAddress = _model.CalculatePatternDataRowAddress(patternRowNumber, 0, interlaceMode2Active, mappingData);
-	patternRowDataAddress = (patternBaseAddress + patternRowDataAddress) % (unsigned int)vramData.size();
-
-	// Read the pattern data byte for the target pixel in the target block
-	bool patternHFlip = mappingData.GetBit(11);
-	unsigned int patternColumnNo = (patternHFlip)? (blockPixelSizeX - 1) - (xpos % blockPixelSizeX): (xpos % blockPixelSizeX);
-	unsigned int patternByteNo = patternColumnNo / pixelsPerPatternByte;
-	bool patternDataUpperHalf = (patternColumnNo % pixelsPerPatternByte) == 0;
-	Data patternData(8, vramData[patternRowDataAddress + patternByteNo]);
-
-	// Return the target palette row and index numbers
-	paletteRow = mappingData.GetDataSegment(13, 2);
-	paletteIndex = patternData.GetDataSegment((patternDataUpperHalf)? 4: 0, 4);
-}
-
 //----------------------------------------------------------------------------------------------------------------------
 void PlaneView::GetScrollPlaneHScrollData(const std::vector<unsigned char>& vramData, unsigned int screenRowNumber, unsigned int hscrollDataBase, bool hscrState, bool lscrState, bool layerA, unsigned int& layerHscrollPatternDisplacement, unsigned int& layerHscrollMappingDisplacement) const
 {
@@ -4,6 +4,7 @@
 #include "DeviceInterface/DeviceInterface.pkg"
 #include "PlaneViewPresenter.h"
 #include "315-5313/IS315_5313.h"
+#include "315-5313/VDPDecoder.h"
 
 class PlaneView :public ViewBase
 {
@@ -41,7 +42,6 @@ private:
 	void UpdateRenderWindowSize(HWND hwnd, int renderWindowWidth, int renderWindowHeight);
 
 	// Render helper methods
-	void GetScrollPlanePaletteInfo(const std::vector<unsigned char>& vramData, unsigned int mappingBaseAddress, unsigned int patternBaseAddress, unsigned int planeWidth, unsigned int planeHeight, unsigned int xpos, unsigned int ypos, bool interlaceMode2Active, unsigned int& paletteRow, unsigned int& paletteIndex) const;
 	void GetScrollPlaneHScrollData(const std::vector<unsigned char>& vramData, unsigned int screenRowNumber, unsigned int hscrollDataBase, bool hscrState, bool lscrState, bool layerA, unsigned int& layerHscrollPatternDisplacement, unsigned int& layerHscrollMappingDisplacement) const;
 
 private:
@@ -84,6 +84,9 @@ private:
 	unsigned int _bufferWidth;
 	unsigned int _bufferHeight;
 	std::vector<float> _zoomSettings;
+	std::vector<unsigned char> _vramDataCopy;
+	std::vector<unsigned int> _vramChangedBlockBitmap;
+	unsigned int _vramDataGeneration;
 
 	SelectedLayer _selectedLayer;
 	bool _displayScreen;
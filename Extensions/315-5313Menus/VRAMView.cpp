@@ -21,6 +21,10 @@ VRAMView::VRAMView(IUIManager& uiManager, VRAMViewPresenter& presenter, IS315_53
 	_hwndDetails = NULL;
 	_hwndDetails16 = NULL;
 	_detailsVisible = false;
+	_vramImageValid = false;
+	_vramDataGeneration = 0;
+	_renderedBlockPixelSizeY = 0;
+	_renderedBlocksPerRenderRow = 0;
 
 	_blocksPerRenderRowSetting = 0;
 	_blockMagnificationFactorSetting = 0;
@@ -399,14 +403,15 @@ LRESULT VRAMView::msgRenderWM_PAINT(HWND hwnd, WPARAM wParam, LPARAM lParam)
 //----------------------------------------------------------------------------------------------------------------------
 LRESULT VRAMView::msgRenderWM_TIMER(HWND hwnd, WPARAM wparam, LPARAM lparam)
 {
-	// Obtain a copy of the current VRAM data buffer
+	// Update our copy of the current VRAM data buffer. Only the blocks of data which have
+	// changed since our last update are retrieved.
 	bool obtainedVRAMData = false;
+	std::vector<unsigned int> changedBlockBitmap;
 	_model.LockExternalBuffers();
 	ITimedBufferInt* vramBuffer = _model.GetVRAMBuffer();
-	std::vector<unsigned char> vramDataCopy;
 	if (vramBuffer != 0)
 	{
-		vramBuffer->GetLatestBufferCopy(vramDataCopy);
+		_vramDataGeneration = vramBuffer->GetLatestBufferChanges(_vramDataGeneration, _vramDataCopy, changedBlockBitmap);
 		obtainedVRAMData = true;
 	}
 	_model.UnlockExternalBuffers();
@@ -424,107 +429,168 @@ LRESULT VRAMView::msgRenderWM_TIMER(HWND hwnd, WPARAM wparam, LPARAM lparam)
 	unsigned int pixelsPerBufferRow = _blocksPerRenderRow * blockPixelSizeX;
 	unsigned int bufferVisibleBlockRowCount = ((pixelsInVRAM / (pixelsPerBufferRow * blockPixelSizeY)) + (((pixelsInVRAM % (pixelsPerBufferRow * blockPixelSizeY)) > 0)? 1: 0));
 	unsigned int bufferVisiblePixelRowCount = bufferVisibleBlockRowCount * blockPixelSizeY;
+	unsigned int dirtyBlockSize = ITimedBufferInt::GetDirtyBlockSize();
+	if (_vramDataCopy.size() < vramSize)
+	{
+		return 0;
+	}
+
+	// Decode the colour for each of the 16 possible pixel values using the current palette
+	// settings
+	VDPDecoder::RGBAColor palette[VDPDecoder::PaletteRowEntryCount];
+	for (unsigned int index = 0; index < VDPDecoder::PaletteRowEntryCount; ++index)
+	{
+		unsigned char r = 0;
+		unsigned char g = 0;
+		unsigned char b = 0;
+		if (_selectedPalette == PALETTE_LOWHIGH)
+		{
+			r = (unsigned char)index * 17;
+			g = (unsigned char)index * 17;
+			b = (unsigned char)index * 17;
+			if (_shadow && !_highlight)
+			{
+				r /= 2;
+				g /= 2;
+				b /= 2;
+			}
+			else if (_highlight && !_shadow)
+			{
+				r = (r / 2) + 0x80;
+				g = (g / 2) + 0x80;
+				b = (b / 2) + 0x80;
+			}
+		}
+		else if (_selectedPalette == PALETTE_HIGHLOW)
+		{
+			r = 0xFF - ((unsigned char)index * 17);
+			g = 0xFF - ((unsigned char)index * 17);
+			b = 0xFF - ((unsigned char)index * 17);
+			if (_shadow && !_highlight)
+			{
+				r /= 2;
+				g /= 2;
+				b /= 2;
+			}
+			else if (_highlight && !_shadow)
+			{
+				r = (r / 2) + 0x80;
+				g = (g / 2) + 0x80;
+				b = (b / 2) + 0x80;
+			}
+		}
+		else
+		{
+			// Decode the colour for the target palette entry
+			IS315_5313::DecodedPaletteColorEntry color = _model.ReadDecodedPaletteColor(_selectedPalette, index);
+			r = _model.ColorValueTo8BitValue(color.r, _shadow, _highlight);
+			g = _model.ColorValueTo8BitValue(color.g, _shadow, _highlight);
+			b = _model.ColorValueTo8BitValue(color.b, _shadow, _highlight);
+		}
+		palette[index] = VDPDecoder::RGBAColor(r, g, b);
+	}
 
-	_vramImage.SetImageFormat(pixelsPerBufferRow, bufferVisiblePixelRowCount, IImage::PIXELFORMAT_RGB, IImage::DATAFORMAT_8BIT);
+	// If the layout of the render buffer or the decoded palette has changed since our last
+	// update, we need to redraw every block. Otherwise, we only redraw the blocks which
+	// contain modified VRAM data.
+	bool fullRedrawRequired = !_vramImageValid || (_renderedBlockPixelSizeY != blockPixelSizeY) || (_renderedBlocksPerRenderRow != _blocksPerRenderRow);
+	for (unsigned int index = 0; !fullRedrawRequired && (index < VDPDecoder::PaletteRowEntryCount); ++index)
+	{
+		fullRedrawRequired = (palette[index].r != _renderedPalette[index].r) || (palette[index].g != _renderedPalette[index].g) || (palette[index].b != _renderedPalette[index].b);
+	}
+	if (fullRedrawRequired)
+	{
+		_vramImage.SetImageFormat(pixelsPerBufferRow, bufferVisiblePixelRowCount, IImage::PIXELFORMAT_RGB, IImage::DATAFORMAT_8BIT);
+		_renderedBlockPixelSizeY = blockPixelSizeY;
+		_renderedBlocksPerRenderRow = _blocksPerRenderRow;
+		for (unsigned int index = 0; index < VDPDecoder::PaletteRowEntryCount; ++index)
+		{
+			_renderedPalette[index] = palette[index];
+		}
+		_vramImageValid = true;
+	}
 
 	// Fill the VRAM render buffer
-	for (unsigned int byteNo = 0; byteNo < vramSize; ++byteNo)
+	unsigned int bytesPerBlock = (blockPixelSizeX * blockPixelSizeY) / pixelsPerByte;
+	unsigned int blockCount = vramSize / bytesPerBlock;
+	bool renderBufferChanged = fullRedrawRequired;
+	VDPDecoder::RGBAColor blockPixels[16 * blockPixelSizeX];
+	for (unsigned int blockNo = 0; blockNo < blockCount; ++blockNo)
 	{
-		unsigned char nextByte = vramDataCopy[byteNo];
-		for (unsigned int pixelNo = 0; pixelNo < pixelsPerByte; ++pixelNo)
+		// Skip over any unmodified blocks if we're not performing a full redraw
+		if (!fullRedrawRequired)
 		{
-			// Decode the colour for the selected pixel
-			unsigned int index = (nextByte >> (((pixelsPerByte - 1) - pixelNo) * 4)) & 0x0F;
-			unsigned char r = 0;
-			unsigned char g = 0;
-			unsigned char b = 0;
-			if (_selectedPalette == PALETTE_LOWHIGH)
+			bool blockModified = false;
+			unsigned int lastDirtyBlockNo = (((blockNo + 1) * bytesPerBlock) - 1) / dirtyBlockSize;
+			for (unsigned int dirtyBlockNo = (blockNo * bytesPerBlock) / dirtyBlockSize; !blockModified && (dirtyBlockNo <= lastDirtyBlockNo); ++dirtyBlockNo)
 			{
-				r = (unsigned char)index * 17;
-				g = (unsigned char)index * 17;
-				b = (unsigned char)index * 17;
-				if (_shadow && !_highlight)
-				{
-					r /= 2;
-					g /= 2;
-					b /= 2;
-				}
-				else if (_highlight && !_shadow)
-				{
-					r = (r / 2) + 0x80;
-					g = (g / 2) + 0x80;
-					b = (b / 2) + 0x80;
-				}
+				blockModified = (changedBlockBitmap[dirtyBlockNo / 32] & (1u << (dirtyBlockNo % 32))) != 0;
 			}
-			else if (_selectedPalette == PALETTE_HIGHLOW)
+			if (!blockModified)
 			{
-				r = 0xFF - ((unsigned char)index * 17);
-				g = 0xFF - ((unsigned char)index * 17);
-				b = 0xFF - ((unsigned char)index * 17);
-				if (_shadow && !_highlight)
-				{
-					r /= 2;
-					g /= 2;
-					b /= 2;
-				}
-				else if (_highlight && !_shadow)
-				{
-					r = (r / 2) + 0x80;
-					g = (g / 2) + 0x80;
-					b = (b / 2) + 0x80;
-				}
+				continue;
 			}
-			else
+			renderBufferChanged = true;
+		}
+
+		// Decode the pattern data for this block, and copy it into the correct position in
+		// the render buffer.
+		VDPDecoder::DecodePattern(&_vramDataCopy[0], blockNo * bytesPerBlock, blockPixelSizeY, &palette[0], &blockPixels[0], blockPixelSizeX);
+		unsigned int blockBufferRowNo = (blockNo / _blocksPerRenderRow) * blockPixelSizeY;
+		unsigned int blockBufferColumnNo = (blockNo % _blocksPerRenderRow) * blockPixelSizeX;
+		for (unsigned int blockRowNo = 0; blockRowNo < blockPixelSizeY; ++blockRowNo)
+		{
+			for (unsigned int blockColumnNo = 0; blockColumnNo < blockPixelSizeX; ++blockColumnNo)
 			{
-				// Decode the colour for the target palette entry
-				IS315_5313::DecodedPaletteColorEntry color = _model.ReadDecodedPaletteColor(_selectedPalette, index);
-				r = _model.ColorValueTo8BitValue(color.r, _shadow, _highlight);
-				g = _model.ColorValueTo8BitValue(color.g, _shadow, _highlight);
-				b = _model.ColorValueTo8BitValue(color.b, _shadow, _highlight);
+				const VDPDecoder::RGBAColor& color = blockPixels[(blockRowNo * blockPixelSizeX) + blockColumnNo];
+				_vramImage.WritePixelData(blockBufferColumnNo + blockColumnNo, blockBufferRowNo + blockRowNo, 0, color.r);
+				_vramImage.WritePixelData(blockBufferColumnNo + blockColumnNo, blockBufferRowNo + blockRowNo, 1, color.g);
+				_vramImage.WritePixelData(blockBufferColumnNo + blockColumnNo, blockBufferRowNo + blockRowNo, 2, color.b);
 			}
+		}
+	}
 
-			// Calculate the position in the data buffer to store the decoded colour. Note
-			// that a lot of math is required here. We've got to convert a raw byte index
-			// for a tile-based image buffer into a raw byte index for a scanline-based
-			// image buffer, so this is a non-trivial conversion.
-			unsigned int blockNo = (byteNo * pixelsPerByte) / (blockPixelSizeX * blockPixelSizeY);
-			unsigned int pixelNoWithinBlock = ((byteNo * pixelsPerByte) + pixelNo) % (blockPixelSizeX * blockPixelSizeY);
-			unsigned int blockRowNo = pixelNoWithinBlock / blockPixelSizeX;
-			unsigned int blockColumnNo = pixelNoWithinBlock % blockPixelSizeX;
-			unsigned int blockBufferRowNo = ((blockNo / _blocksPerRenderRow) * blockPixelSizeY) + blockRowNo;
-			unsigned int blockBufferColumnNo = ((blockNo % _blocksPerRenderRow) * blockPixelSizeX) + blockColumnNo;
-
-			// Copy the decoded colour data into the buffer
-			_vramImage.WritePixelData(blockBufferColumnNo, blockBufferRowNo, 0, r);
-			_vramImage.WritePixelData(blockBufferColumnNo, blockBufferRowNo, 1, g);
-			_vramImage.WritePixelData(blockBufferColumnNo, blockBufferRowNo, 2, b);
-
-			// Copy the data into the details popup
-			if (blockNo == _tileNumber)
+	// If we've just rebuilt the render buffer, pad the scanlines containing the last block
+	// out to the end of each line.
+	if (fullRedrawRequired)
+	{
+		unsigned int lastBlockNo = blockCount - 1;
+		unsigned int paddingStartColumnNo = ((lastBlockNo % _blocksPerRenderRow) + 1) * blockPixelSizeX;
+		unsigned int paddingStartRowNo = (lastBlockNo / _blocksPerRenderRow) * blockPixelSizeY;
+		for (unsigned int rowNo = paddingStartRowNo; rowNo < (paddingStartRowNo + blockPixelSizeY); ++rowNo)
+		{
+			for (unsigned int columnNo = paddingStartColumnNo; columnNo < pixelsPerBufferRow; ++columnNo)
 			{
-				_tileDetails[blockRowNo][blockColumnNo].r = r;
-				_tileDetails[blockRowNo][blockColumnNo].g = g;
-				_tileDetails[blockRowNo][blockColumnNo].b = b;
-				_tileDetails[blockRowNo][blockColumnNo].value = index;
+				_vramImage.WritePixelData(columnNo, rowNo, 0, (unsigned char)0);
+				_vramImage.WritePixelData(columnNo, rowNo, 1, (unsigned char)0);
+				_vramImage.WritePixelData(columnNo, rowNo, 2, (unsigned char)0);
 			}
+		}
+	}
 
-			// If we've just output the last pixel at the end of a row within the last
-			// block, pad this scanline in the data buffer out to the end of the line.
-			unsigned int lastBlockNo = ((pixelsInVRAM / (blockPixelSizeX * blockPixelSizeY)) - 1);
-			if ((blockNo == lastBlockNo) && (blockColumnNo == (blockPixelSizeX - 1)))
+	// Copy the data for the selected tile into the details popup
+	if (_tileNumber < blockCount)
+	{
+		unsigned char paletteIndices[16 * blockPixelSizeX];
+		VDPDecoder::UnpackPatternData(&_vramDataCopy[_tileNumber * bytesPerBlock], bytesPerBlock, &paletteIndices[0]);
+		for (unsigned int blockRowNo = 0; blockRowNo < blockPixelSizeY; ++blockRowNo)
+		{
+			for (unsigned int blockColumnNo = 0; blockColumnNo < blockPixelSizeX; ++blockColumnNo)
 			{
-				unsigned int paddingPixelsAfterLastBlock = ((_blocksPerRenderRow - 1) - (lastBlockNo % _blocksPerRenderRow)) * blockPixelSizeX;
-				for (unsigned int i = 0; i < paddingPixelsAfterLastBlock; ++i)
-				{
-					_vramImage.WritePixelData(blockBufferColumnNo + 1 + i, blockBufferRowNo, 0, (unsigned char)0);
-					_vramImage.WritePixelData(blockBufferColumnNo + 1 + i, blockBufferRowNo, 1, (unsigned char)0);
-					_vramImage.WritePixelData(blockBufferColumnNo + 1 + i, blockBufferRowNo, 2, (unsigned char)0);
-				}
+				unsigned int index = paletteIndices[(blockRowNo * blockPixelSizeX) + blockColumnNo];
+				_tileDetails[blockRowNo][blockColumnNo].r = palette[index].r;
+				_tileDetails[blockRowNo][blockColumnNo].g = palette[index].g;
+				_tileDetails[blockRowNo][blockColumnNo].b = palette[index].b;
+				_tileDetails[blockRowNo][blockColumnNo].value = index;
 			}
 		}
 	}
 
-	InvalidateRect(hwnd, NULL, FALSE);
+	// Only trigger a repaint of the render window if its contents have changed
+	if (renderBufferChanged)
+	{
+		InvalidateRect(hwnd, NULL, FALSE);
+	}
 
 	return 0;
 }
@@ -5,6 +5,7 @@
 #include "Image/Image.pkg"
 #include "VRAMViewPresenter.h"
 #include "315-5313/IS315_5313.h"
+#include "315-5313/VDPDecoder.h"
 
 class VRAMView :public ViewBase
 {
@@ -94,6 +95,12 @@ private:
 	std::wstring _previousText;
 	unsigned int _currentControlFocus;
 	Image _vramImage;
+	bool _vramImageValid;
+	std::vector<unsigned char> _vramDataCopy;
+	unsigned int _vramDataGeneration;
+	unsigned int _renderedBlockPixelSizeY;
+	unsigned int _renderedBlocksPerRenderRow;
+	VDPDecoder::RGBAColor _renderedPalette[VDPDecoder::PaletteRowEntryCount];
 
 	HWND _hwndLayoutGrid;
 	HWND _hwndScrollViewer;
@@ -143,10 +143,7 @@ INT_PTR DeviceControlView::msgWM_COMMAND(HWND hwnd, WPARAM wparam, LPARAM lparam
 			{
 				//##TODO## Show a dialog box indicating the current step progress, and
 				// giving the user an option to cancel.
-				for (unsigned int i = 0; i < _deviceStep; ++i)
-				{
-					_model.ExecuteDeviceStep(device);
-				}
+				_model.ExecuteDeviceSteps(device, _deviceStep);
 			}
 			break;}
 		case IDC_DEVICECONTROL_DEVICE_ENABLED:{
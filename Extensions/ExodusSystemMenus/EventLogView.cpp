@@ -19,6 +19,10 @@ EventLogView::EventLogView(IUIManager& uiManager, EventLogViewPresenter& present
 	_loggerLevel4Enabled = true;
 	_loggerLevel5Enabled = true;
 	_logLastModifiedToken = 0;
+	_eventLogNextEntryNo = 0;
+	_eventLogClearGeneration = 0;
+	_eventLogVisibleRowCount = 0;
+	_eventLogRebuildRequired = true;
 	SetWindowSettings(presenter.GetUnqualifiedViewTitle(), 0, WS_EX_COMPOSITED, 640, 200);
 	SetDockableViewType(true, DockPos::Bottom);
 }
@@ -137,48 +141,116 @@ LRESULT EventLogView::msgWM_ERASEBKGND(HWND hwnd, WPARAM wParam, LPARAM lParam)
 //----------------------------------------------------------------------------------------------------------------------
 LRESULT EventLogView::msgWM_TIMER(HWND hwnd, WPARAM wparam, LPARAM lparam)
 {
+	// If the event log hasn't changed since our last update, abort any further processing.
 	unsigned int newEventLogLastModifiedToken = _model.GetEventLogLastModifiedToken();
-	if (newEventLogLastModifiedToken != _logLastModifiedToken)
+	if (!_eventLogRebuildRequired && (newEventLogLastModifiedToken == _logLastModifiedToken))
 	{
-		std::vector<ISystemGUIInterface::SystemLogEntry> newEventLog = _model.GetEventLog();
-		if (_eventLog.empty() || (newEventLog.size() < _eventLog.size()) || (_eventLog[0].eventTimeString != newEventLog[0].eventTimeString) || (_eventLog[_eventLog.size()-1].eventTimeString != newEventLog[_eventLog.size()-1].eventTimeString))
+		return 0;
+	}
+	_logLastModifiedToken = newEventLogLastModifiedToken;
+
+	// If the event log has been cleared since our last update, whether by us or by any
+	// other client of the system, discard our copy of the log and rebuild the grid from
+	// the start of the log. We check this before reading new entries, so that if the log
+	// is cleared while we're reading it, we'll detect the clear on our next update.
+	unsigned int newEventLogClearGeneration = _model.GetEventLogClearGeneration();
+	if (newEventLogClearGeneration != _eventLogClearGeneration)
+	{
+		_eventLogClearGeneration = newEventLogClearGeneration;
+		RebuildEventLog();
+	}
+
+	// Retrieve any entries which have been added to the event log since our last update,
+	// and add them to the front of our copy of the log, so that the most recent entry is
+	// listed first.
+	std::vector<ISystemGUIInterface::SystemLogEntry> newEventLogEntries;
+	_eventLogNextEntryNo = _model.GetEventLogEntries(_eventLogNextEntryNo, newEventLogEntries);
+	_eventLog.insert(_eventLog.begin(), newEventLogEntries.rbegin(), newEventLogEntries.rend());
+
+	// Discard any entries beyond the current size of the event log, and determine how many
+	// of the discarded entries are currently displayed in the grid.
+	unsigned int discardedVisibleRowCount = 0;
+	size_t eventLogSize = (size_t)_model.GetEventLogSize();
+	if (_eventLog.size() > eventLogSize)
+	{
+		for (size_t i = eventLogSize; i < _eventLog.size(); ++i)
 		{
-			SendMessage(_hwndEventLogGrid, (UINT)WC_DataGrid::WindowMessages::DeleteRows, 0, (LPARAM)&(const WC_DataGrid::Grid_DeleteRows&)WC_DataGrid::Grid_DeleteRows(0, (unsigned int)_eventLog.size()));
-			_eventLog.clear();
+			discardedVisibleRowCount += IsLogEntryVisible(_eventLog[i])? 1: 0;
 		}
-		unsigned int currentEntryCount = (unsigned int)_eventLog.size();
-		unsigned int addedEntryCount = (unsigned int)(newEventLog.size() - _eventLog.size());
+		_eventLog.resize(eventLogSize);
+	}
 
-		// Add log entries which are not currently filtered
+	// If we need to rebuild the grid, replace all the rows in the grid with the current
+	// contents of the log, otherwise insert rows for just the new entries at the top of the
+	// grid, and remove the rows for any discarded entries from the bottom.
+	if (_eventLogRebuildRequired)
+	{
 		WC_DataGrid::Grid_InsertRows insertRowsInfo;
-		insertRowsInfo.targetRowNo = currentEntryCount;
-		insertRowsInfo.rowCount = addedEntryCount;
-		insertRowsInfo.rowData.reserve(addedEntryCount);
-		for (unsigned int i = 0; i < addedEntryCount; ++i)
+		insertRowsInfo.clearExistingRows = true;
+		for (size_t i = 0; i < _eventLog.size(); ++i)
 		{
-			const ISystemGUIInterface::SystemLogEntry& logEntry = newEventLog[currentEntryCount + i];
-			if ((_loggerLevel1Enabled && (logEntry.eventLevel == ILogEntry::EventLevel::Info))
-			|| (_loggerLevel2Enabled && (logEntry.eventLevel == ILogEntry::EventLevel::Debug))
-			|| (_loggerLevel3Enabled && (logEntry.eventLevel == ILogEntry::EventLevel::Warning))
-			|| (_loggerLevel4Enabled && (logEntry.eventLevel == ILogEntry::EventLevel::Error))
-			|| (_loggerLevel5Enabled && (logEntry.eventLevel == ILogEntry::EventLevel::Critical)))
-			{
-				insertRowsInfo.rowData.resize(i+1);
-				insertRowsInfo.rowData[i][1] = logEntry.eventTimeString;
-				insertRowsInfo.rowData[i][2] = logEntry.eventLevelString;
-				insertRowsInfo.rowData[i][3] = logEntry.source;
-				insertRowsInfo.rowData[i][4] = logEntry.text;
-			}
+			AddLogEntryToGridRows(_eventLog[i], insertRowsInfo);
 		}
 		SendMessage(_hwndEventLogGrid, (UINT)WC_DataGrid::WindowMessages::InsertRows, 0, (LPARAM)&insertRowsInfo);
-
-		_eventLog = newEventLog;
-		_logLastModifiedToken = newEventLogLastModifiedToken;
+		_eventLogVisibleRowCount = insertRowsInfo.rowCount;
+		_eventLogRebuildRequired = false;
+	}
+	else
+	{
+		WC_DataGrid::Grid_InsertRows insertRowsInfo;
+		for (size_t i = 0; i < newEventLogEntries.size(); ++i)
+		{
+			AddLogEntryToGridRows(newEventLogEntries[newEventLogEntries.size() - (i + 1)], insertRowsInfo);
+		}
+		if (insertRowsInfo.rowCount > 0)
+		{
+			SendMessage(_hwndEventLogGrid, (UINT)WC_DataGrid::WindowMessages::InsertRows, 0, (LPARAM)&insertRowsInfo);
+			_eventLogVisibleRowCount += insertRowsInfo.rowCount;
+		}
+		if (discardedVisibleRowCount > 0)
+		{
+			_eventLogVisibleRowCount -= discardedVisibleRowCount;
+			SendMessage(_hwndEventLogGrid, (UINT)WC_DataGrid::WindowMessages::DeleteRows, 0, (LPARAM)&(const WC_DataGrid::Grid_DeleteRows&)WC_DataGrid::Grid_DeleteRows(_eventLogVisibleRowCount, discardedVisibleRowCount));
+		}
 	}
 
 	return 0;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Event log functions
+//----------------------------------------------------------------------------------------------------------------------
+bool EventLogView::IsLogEntryVisible(const ISystemGUIInterface::SystemLogEntry& logEntry) const
+{
+	return (_loggerLevel1Enabled && (logEntry.eventLevel == ILogEntry::EventLevel::Info))
+	    || (_loggerLevel2Enabled && (logEntry.eventLevel == ILogEntry::EventLevel::Debug))
+	    || (_loggerLevel3Enabled && (logEntry.eventLevel == ILogEntry::EventLevel::Warning))
+	    || (_loggerLevel4Enabled && (logEntry.eventLevel == ILogEntry::EventLevel::Error))
+	    || (_loggerLevel5Enabled && (logEntry.eventLevel == ILogEntry::EventLevel::Critical));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void EventLogView::AddLogEntryToGridRows(const ISystemGUIInterface::SystemLogEntry& logEntry, WC_DataGrid::Grid_InsertRows& insertRowsInfo) const
+{
+	if (IsLogEntryVisible(logEntry))
+	{
+		insertRowsInfo.rowData.resize(insertRowsInfo.rowCount + 1);
+		std::map<unsigned int, std::wstring>& rowData = insertRowsInfo.rowData[insertRowsInfo.rowCount++];
+		rowData[1] = logEntry.eventTimeString;
+		rowData[2] = logEntry.eventLevelString;
+		rowData[3] = logEntry.source;
+		rowData[4] = logEntry.text;
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void EventLogView::RebuildEventLog()
+{
+	_eventLog.clear();
+	_eventLogNextEntryNo = 0;
+	_eventLogRebuildRequired = true;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Member window procedure
 //----------------------------------------------------------------------------------------------------------------------
@@ -261,6 +333,7 @@ INT_PTR EventLogView::msgPanelWM_COMMAND(HWND hwnd, WPARAM wparam, LPARAM lparam
 		{
 		case IDC_EVENTLOG_CLEAR:
 			_model.ClearEventLog();
+			RebuildEventLog();
 			break;
 		case IDC_EVENTLOG_SAVE:{
 			std::wstring selectedFilePath;
@@ -271,28 +344,23 @@ INT_PTR EventLogView::msgPanelWM_COMMAND(HWND hwnd, WPARAM wparam, LPARAM lparam
 			break;}
 		case IDC_EVENTLOG_SHOW_1:
 			_loggerLevel1Enabled = (IsDlgButtonChecked(hwnd, LOWORD(wparam)) == BST_CHECKED);
-			_eventLog.clear();
-			_logLastModifiedToken = 0;
+			RebuildEventLog();
 			break;
 		case IDC_EVENTLOG_SHOW_2:
 			_loggerLevel2Enabled = (IsDlgButtonChecked(hwnd, LOWORD(wparam)) == BST_CHECKED);
-			_eventLog.clear();
-			_logLastModifiedToken = 0;
+			RebuildEventLog();
 			break;
 		case IDC_EVENTLOG_SHOW_3:
 			_loggerLevel3Enabled = (IsDlgButtonChecked(hwnd, LOWORD(wparam)) == BST_CHECKED);
-			_eventLog.clear();
-			_logLastModifiedToken = 0;
+			RebuildEventLog();
 			break;
 		case IDC_EVENTLOG_SHOW_4:
 			_loggerLevel4Enabled = (IsDlgButtonChecked(hwnd, LOWORD(wparam)) == BST_CHECKED);
-			_eventLog.clear();
-			_logLastModifiedToken = 0;
+			RebuildEventLog();
 			break;
 		case IDC_EVENTLOG_SHOW_5:
 			_loggerLevel5Enabled = (IsDlgButtonChecked(hwnd, LOWORD(wparam)) == BST_CHECKED);
-			_eventLog.clear();
-			_logLastModifiedToken = 0;
+			RebuildEventLog();
 			break;
 		}
 	}
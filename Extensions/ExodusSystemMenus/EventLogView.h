@@ -1,6 +1,7 @@
 #ifndef __EVENTLOGVIEW_H__
 #define __EVENTLOGVIEW_H__
 #include "WindowsSupport/WindowsSupport.pkg"
+#include "WindowsControls/WindowsControls.pkg"
 #include "SystemInterface/SystemInterface.pkg"
 #include "EventLogViewPresenter.h"
 
@@ -22,6 +23,11 @@ private:
 	LRESULT msgWM_ERASEBKGND(HWND hwnd, WPARAM wParam, LPARAM lParam);
 	LRESULT msgWM_TIMER(HWND hwnd, WPARAM wParam, LPARAM lParam);
 
+	// Event log functions
+	bool IsLogEntryVisible(const ISystemGUIInterface::SystemLogEntry& logEntry) const;
+	void AddLogEntryToGridRows(const ISystemGUIInterface::SystemLogEntry& logEntry, WC_DataGrid::Grid_InsertRows& insertRowsInfo) const;
+	void RebuildEventLog();
+
 	// Panel dialog window procedure
 	static INT_PTR CALLBACK WndProcPanelStatic(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam);
 	INT_PTR WndProcPanel(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam);
@@ -43,6 +49,10 @@ private:
 	bool _loggerLevel4Enabled;
 	bool _loggerLevel5Enabled;
 	unsigned int _logLastModifiedToken;
+	unsigned int _eventLogNextEntryNo;
+	unsigned int _eventLogClearGeneration;
+	unsigned int _eventLogVisibleRowCount;
+	bool _eventLogRebuildRequired;
 	std::vector<ISystemGUIInterface::SystemLogEntry> _eventLog;
 };
 
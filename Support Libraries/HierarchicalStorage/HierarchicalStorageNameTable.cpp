@@ -0,0 +1,30 @@
+#include "HierarchicalStorageNameTable.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+// Name functions
+//----------------------------------------------------------------------------------------------------------------------
+const std::wstring* HierarchicalStorageNameTable::InternName(const std::wstring& name)
+{
+	// Note that elements in an unordered_set are never moved once inserted, even when the
+	// table is rehashed, so it's safe to hand out the address of the stored string.
+	std::unique_lock<std::mutex> lock(GetAccessMutex());
+	return &(*GetNameSet().insert(name).first);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Table functions
+//----------------------------------------------------------------------------------------------------------------------
+std::mutex& HierarchicalStorageNameTable::GetAccessMutex()
+{
+	// We use function local statics here so that the table is always constructed before
+	// its first use, even when nodes are created during static initialization.
+	static std::mutex accessMutex;
+	return accessMutex;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::unordered_set<std::wstring>& HierarchicalStorageNameTable::GetNameSet()
+{
+	static std::unordered_set<std::wstring> nameSet;
+	return nameSet;
+}
@@ -0,0 +1,25 @@
+#ifndef __HIERARCHICALSTORAGENAMETABLE_H__
+#define __HIERARCHICALSTORAGENAMETABLE_H__
+#include <string>
+#include <unordered_set>
+#include <mutex>
+
+// Notes:
+// -Node and attribute names are interned through this table when they're assigned, so that
+// each distinct name is only stored once, no matter how many nodes share it. Lookups don't
+// go through this table, so the table lock is only taken when names are assigned.
+// -Interned names are never released. The set of distinct element and attribute names used
+// by our data files is small and fixed, so the table doesn't grow beyond a modest size.
+class HierarchicalStorageNameTable
+{
+public:
+	// Name functions
+	static const std::wstring* InternName(const std::wstring& name);
+
+private:
+	// Table functions
+	static std::mutex& GetAccessMutex();
+	static std::unordered_set<std::wstring>& GetNameSet();
+};
+
+#endif
@@ -1,15 +1,16 @@
 #include "HierarchicalStorageNode.h"
+#include "HierarchicalStorageNameTable.h"
 
 //----------------------------------------------------------------------------------------------------------------------
 // Constructors
 //----------------------------------------------------------------------------------------------------------------------
 HierarchicalStorageNode::HierarchicalStorageNode()
-:_parent(0), _binaryDataPresent(false), _inlineBinaryData(false), _dataStream(Stream::IStream::TextEncoding::UTF16, Stream::IStream::NewLineEncoding::Unix, Stream::IStream::ByteOrder::BigEndian, 0)
+:_name(HierarchicalStorageNameTable::InternName(L"")), _parent(0), _childIndexBuilt(false), _binaryDataPresent(false), _inlineBinaryData(false), _dataStream(Stream::IStream::TextEncoding::UTF16, Stream::IStream::NewLineEncoding::Unix, Stream::IStream::ByteOrder::BigEndian, 0)
 { }
 
 //----------------------------------------------------------------------------------------------------------------------
 HierarchicalStorageNode::HierarchicalStorageNode(const std::wstring& name)
-:_name(name), _parent(0), _binaryDataPresent(false), _inlineBinaryData(false), _dataStream(Stream::IStream::TextEncoding::UTF16, Stream::IStream::NewLineEncoding::Unix, Stream::IStream::ByteOrder::BigEndian, 0)
+:_name(HierarchicalStorageNameTable::InternName(name)), _parent(0), _childIndexBuilt(false), _binaryDataPresent(false), _inlineBinaryData(false), _dataStream(Stream::IStream::TextEncoding::UTF16, Stream::IStream::NewLineEncoding::Unix, Stream::IStream::ByteOrder::BigEndian, 0)
 { }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -30,6 +31,8 @@ void HierarchicalStorageNode::Initialize()
 		delete i->second;
 	}
 	_children.clear();
+	_childIndex.clear();
+	_childIndexBuilt = false;
 	_attributes.clear();
 	_binaryDataName.clear();
 	_binaryDataPresent = false;
@@ -40,13 +43,21 @@ void HierarchicalStorageNode::Initialize()
 //----------------------------------------------------------------------------------------------------------------------
 Marshal::Ret<std::wstring> HierarchicalStorageNode::GetName() const
 {
-	return _name;
+	return *_name;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void HierarchicalStorageNode::SetName(const Marshal::In<std::wstring>& name)
 {
-	_name = name;
+	// Since the name of this node is used as the key in the child index of our parent,
+	// move this node to the index entry for its new name if we're renaming an existing
+	// child.
+	const std::wstring* previousName = _name;
+	_name = HierarchicalStorageNameTable::InternName(name);
+	if ((_parent != 0) && (_name != previousName))
+	{
+		_parent->RenameChildInIndex(this, previousName);
+	}
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -91,8 +102,7 @@ Stream::IStream& HierarchicalStorageNode::GetInternalStream() const
 IHierarchicalStorageNode& HierarchicalStorageNode::CreateChild()
 {
 	HierarchicalStorageNode* child = new HierarchicalStorageNode();
-	child->SetParent(this);
-	_children.push_back(child);
+	AddChild(child);
 	return *child;
 }
 
@@ -100,8 +110,7 @@ IHierarchicalStorageNode& HierarchicalStorageNode::CreateChild()
 IHierarchicalStorageNode& HierarchicalStorageNode::CreateChild(const Marshal::In<std::wstring>& name)
 {
 	HierarchicalStorageNode* child = new HierarchicalStorageNode(name);
-	child->SetParent(this);
-	_children.push_back(child);
+	AddChild(child);
 	return *child;
 }
 
@@ -114,6 +123,7 @@ void HierarchicalStorageNode::DeleteChild(IHierarchicalStorageNode& node)
 		if (*childListIterator == &node)
 		{
 			_children.erase(childListIterator);
+			RebuildChildIndex();
 			return;
 		}
 		++childListIterator;
@@ -134,27 +144,48 @@ Marshal::Ret<std::list<IHierarchicalStorageNode*>> HierarchicalStorageNode::GetC
 //----------------------------------------------------------------------------------------------------------------------
 bool HierarchicalStorageNode::IsChildPresent(const Marshal::In<std::wstring>& name) const
 {
-	std::wstring nameResolved = name.Get();
-	for (ChildList::const_iterator i = _children.begin(); i != _children.end(); ++i)
-	{
-		HierarchicalStorageNode* childNode = *i;
-		if (childNode->GetName() == nameResolved)
-		{
-			return true;
-		}
-	}
-	return false;
+	return (GetChild(name) != 0);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 IHierarchicalStorageNode* HierarchicalStorageNode::GetChild(const Marshal::In<std::wstring>& name, const IHierarchicalStorageNode* searchAfterChildNode) const
 {
+	// Note that we compare names by content here rather than resolving the interned form
+	// of the target name, so that lookups never need to take the lock on the shared name
+	// table.
 	std::wstring nameResolved = name.Get();
+
+	// If this node has an index of its children, look up the list of children with the
+	// target name from the index. Note that the index lists children in the same order
+	// they appear in the child list, so if we're continuing a search from a previous
+	// child with the same name, the next match is simply the next entry in the index.
+	if (_childIndexBuilt)
+	{
+		ChildIndex::const_iterator childIndexIterator = _childIndex.find(&nameResolved);
+		if (childIndexIterator == _childIndex.end())
+		{
+			return 0;
+		}
+		const ChildList& matchingChildren = childIndexIterator->second;
+		if (searchAfterChildNode == 0)
+		{
+			return matchingChildren.front();
+		}
+		for (size_t i = 0; i < matchingChildren.size(); ++i)
+		{
+			if (matchingChildren[i] == searchAfterChildNode)
+			{
+				return ((i + 1) < matchingChildren.size())? matchingChildren[i + 1]: 0;
+			}
+		}
+	}
+
+	// Search the child list directly for the next child with the target name
 	bool foundSearchStartNode = (searchAfterChildNode == 0);
 	for (ChildList::const_iterator i = _children.begin(); i != _children.end(); ++i)
 	{
 		HierarchicalStorageNode* childNode = *i;
-		if (foundSearchStartNode && (childNode->GetName() == nameResolved))
+		if (foundSearchStartNode && (*childNode->_name == nameResolved))
 		{
 			return childNode;
 		}
@@ -164,28 +195,101 @@ IHierarchicalStorageNode* HierarchicalStorageNode::GetChild(const Marshal::In<st
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-// Attribute functions
+void HierarchicalStorageNode::AddChild(HierarchicalStorageNode* child)
+{
+	// Add the new child to the end of the child list. If the index has already been
+	// built, we can simply append the child to the index entry for its name, otherwise we
+	// build the index once the child list has grown large enough to need it.
+	child->SetParent(this);
+	_children.push_back(child);
+	if (_childIndexBuilt)
+	{
+		_childIndex[child->_name].push_back(child);
+	}
+	else if (_children.size() >= ChildIndexMinimumChildCount)
+	{
+		RebuildChildIndex();
+	}
+}
+
 //----------------------------------------------------------------------------------------------------------------------
-bool HierarchicalStorageNode::IsAttributePresent(const Marshal::In<std::wstring>& name) const
+void HierarchicalStorageNode::RenameChildInIndex(HierarchicalStorageNode* child, const std::wstring* previousName)
 {
-	std::wstring nameResolved = name.Get();
-	for (AttributeList::const_iterator i = _attributes.begin(); i != _attributes.end(); ++i)
+	// If the index hasn't been built yet, there's nothing to update.
+	if (!_childIndexBuilt)
 	{
-		if (i->first == nameResolved)
+		return;
+	}
+
+	// Remove the child from the index entry for its previous name. Note that children are
+	// almost always renamed immediately after they're created, such as when loading a
+	// tree, so we search the entry from the back.
+	ChildIndex::iterator previousEntry = _childIndex.find(previousName);
+	if (previousEntry != _childIndex.end())
+	{
+		ChildList& previousEntryChildren = previousEntry->second;
+		for (size_t i = previousEntryChildren.size(); i > 0; --i)
+		{
+			if (previousEntryChildren[i - 1] == child)
+			{
+				previousEntryChildren.erase(previousEntryChildren.begin() + (i - 1));
+				break;
+			}
+		}
+		if (previousEntryChildren.empty())
+		{
+			_childIndex.erase(previousEntry);
+		}
+	}
+
+	// Add the child to the index entry for its new name. Index entries need to list
+	// children in the same order they appear in the child list, so if this isn't the last
+	// child, we rebuild the index to place it correctly.
+	if (_children.back() == child)
+	{
+		_childIndex[child->_name].push_back(child);
+	}
+	else
+	{
+		RebuildChildIndex();
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void HierarchicalStorageNode::RebuildChildIndex()
+{
+	// Note that children are rarely deleted or renamed out of order once a tree has been
+	// built, so we simply rebuild the whole index in these cases rather than trying to
+	// patch it.
+	_childIndex.clear();
+	_childIndexBuilt = (_children.size() >= ChildIndexMinimumChildCount);
+	if (_childIndexBuilt)
+	{
+		for (ChildList::const_iterator i = _children.begin(); i != _children.end(); ++i)
 		{
-			return true;
+			_childIndex[(*i)->_name].push_back(*i);
 		}
 	}
-	return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Attribute functions
+//----------------------------------------------------------------------------------------------------------------------
+bool HierarchicalStorageNode::IsAttributePresent(const Marshal::In<std::wstring>& name) const
+{
+	return (GetAttribute(name) != 0);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 IHierarchicalStorageAttribute* HierarchicalStorageNode::GetAttribute(const Marshal::In<std::wstring>& name) const
 {
+	// Search the attribute list by name. Nodes only carry a handful of attributes, so we
+	// don't index them. Note that as with child lookups, we compare by content here so
+	// that we don't need to take the lock on the shared name table.
 	std::wstring nameResolved = name.Get();
 	for (AttributeList::const_iterator i = _attributes.begin(); i != _attributes.end(); ++i)
 	{
-		if (i->first == nameResolved)
+		if (*i->first == nameResolved)
 		{
 			return i->second;
 		}
@@ -196,14 +300,18 @@ IHierarchicalStorageAttribute* HierarchicalStorageNode::GetAttribute(const Marsh
 //----------------------------------------------------------------------------------------------------------------------
 IHierarchicalStorageAttribute& HierarchicalStorageNode::CreateAttribute(const Marshal::In<std::wstring>& name)
 {
-	IHierarchicalStorageAttribute* attribute = GetAttribute(name);
-	if (attribute == 0)
+	std::wstring nameResolved = name.Get();
+	const std::wstring* internedName = HierarchicalStorageNameTable::InternName(nameResolved);
+	for (AttributeList::const_iterator i = _attributes.begin(); i != _attributes.end(); ++i)
 	{
-		HierarchicalStorageAttribute* newAttribute = new HierarchicalStorageAttribute(name);
-		attribute = newAttribute;
-		_attributes.push_back(AttributeListEntry(name, newAttribute));
+		if (i->first == internedName)
+		{
+			return *(i->second);
+		}
 	}
-	return *attribute;
+	HierarchicalStorageAttribute* newAttribute = new HierarchicalStorageAttribute(nameResolved);
+	_attributes.push_back(AttributeListEntry(internedName, newAttribute));
+	return *newAttribute;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -217,6 +325,7 @@ void HierarchicalStorageNode::DeleteAttribute(IHierarchicalStorageAttribute& att
 			_attributes.erase(attributeIterator);
 			return;
 		}
+		++attributeIterator;
 	}
 }
 
@@ -298,3 +407,168 @@ void HierarchicalStorageNode::AddBinaryDataEntitiesToList(std::list<IHierarchica
 		(*i)->AddBinaryDataEntitiesToList(binaryEntityList);
 	}
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Indexed access functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int HierarchicalStorageNode::GetChildCount() const
+{
+	return (unsigned int)_children.size();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IHierarchicalStorageNode* HierarchicalStorageNode::GetChildByIndex(unsigned int index) const
+{
+	return (index < _children.size())? _children[index]: 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int HierarchicalStorageNode::GetAttributeCount() const
+{
+	return (unsigned int)_attributes.size();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IHierarchicalStorageAttribute* HierarchicalStorageNode::GetAttributeByIndex(unsigned int index) const
+{
+	return (index < _attributes.size())? _attributes[index].second: 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Binary storage functions
+//----------------------------------------------------------------------------------------------------------------------
+bool HierarchicalStorageNode::SaveBinaryNode(Stream::IStream& target) const
+{
+	// Write the node name and attributes
+	bool result = SaveBinaryString(target, *_name);
+	result &= target.WriteDataLittleEndian((unsigned int)_attributes.size());
+	for (AttributeList::const_iterator i = _attributes.begin(); i != _attributes.end(); ++i)
+	{
+		result &= SaveBinaryString(target, *(i->first));
+		result &= SaveBinaryString(target, i->second->GetValue());
+	}
+
+	// Write the node content. Note that we store the raw contents of the data stream here
+	// rather than the decoded data, so the node is restored exactly as it was when loaded,
+	// whether it holds text, inline binary data, or nothing at all.
+	result &= target.WriteDataLittleEndian(_binaryDataPresent);
+	result &= target.WriteDataLittleEndian(_inlineBinaryData);
+	result &= SaveBinaryString(target, _binaryDataName);
+	unsigned int dataSize = (unsigned int)_dataStream.Size();
+	result &= target.WriteDataLittleEndian(dataSize);
+	if (dataSize > 0)
+	{
+		result &= target.WriteData(_dataStream.GetRawBuffer(), dataSize);
+	}
+
+	// Write each child node
+	result &= target.WriteDataLittleEndian((unsigned int)_children.size());
+	for (ChildList::const_iterator i = _children.begin(); result && (i != _children.end()); ++i)
+	{
+		result &= (*i)->SaveBinaryNode(target);
+	}
+	return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool HierarchicalStorageNode::LoadBinaryNode(Stream::IStream& source)
+{
+	// Read the node name and attributes
+	std::wstring name;
+	unsigned int attributeCount;
+	if (!LoadBinaryString(source, name) || !source.ReadDataLittleEndian(attributeCount))
+	{
+		return false;
+	}
+
+	// Reject counts and sizes which run past the end of the source stream, so that a
+	// truncated or corrupt source can't trigger a huge allocation. Each attribute holds at
+	// least two string lengths, and each child node holds at least five length or count
+	// fields, so we can bound those counts by the number of bytes remaining.
+	const Stream::IStream::SizeType minimumAttributeSize = 2 * (Stream::IStream::SizeType)sizeof(unsigned int);
+	const Stream::IStream::SizeType minimumChildNodeSize = 5 * (Stream::IStream::SizeType)sizeof(unsigned int);
+	if ((Stream::IStream::SizeType)attributeCount > ((source.Size() - source.GetStreamPos()) / minimumAttributeSize))
+	{
+		return false;
+	}
+	SetName(name);
+	for (unsigned int i = 0; i < attributeCount; ++i)
+	{
+		std::wstring attributeName;
+		std::wstring attributeValue;
+		if (!LoadBinaryString(source, attributeName) || !LoadBinaryString(source, attributeValue))
+		{
+			return false;
+		}
+		CreateAttribute(attributeName, attributeValue);
+	}
+
+	// Read the node content
+	unsigned int dataSize;
+	if (!source.ReadDataLittleEndian(_binaryDataPresent) || !source.ReadDataLittleEndian(_inlineBinaryData) || !LoadBinaryString(source, _binaryDataName) || !source.ReadDataLittleEndian(dataSize))
+	{
+		return false;
+	}
+	if ((Stream::IStream::SizeType)dataSize > (source.Size() - source.GetStreamPos()))
+	{
+		return false;
+	}
+	_dataStream.Resize(dataSize);
+	if ((dataSize > 0) && !source.ReadData(_dataStream.GetRawBuffer(), dataSize))
+	{
+		return false;
+	}
+	_dataStream.SetStreamPos(0);
+
+	// Read each child node
+	unsigned int childCount;
+	if (!source.ReadDataLittleEndian(childCount))
+	{
+		return false;
+	}
+	if ((Stream::IStream::SizeType)childCount > ((source.Size() - source.GetStreamPos()) / minimumChildNodeSize))
+	{
+		return false;
+	}
+	_children.reserve(childCount);
+	for (unsigned int i = 0; i < childCount; ++i)
+	{
+		HierarchicalStorageNode& child = (HierarchicalStorageNode&)CreateChild();
+		if (!child.LoadBinaryNode(source))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool HierarchicalStorageNode::SaveBinaryString(Stream::IStream& target, const std::wstring& data)
+{
+	unsigned int length = (unsigned int)data.size();
+	bool result = target.WriteDataLittleEndian(length);
+	if (length > 0)
+	{
+		result &= target.WriteDataLittleEndian(data.data(), length);
+	}
+	return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool HierarchicalStorageNode::LoadBinaryString(Stream::IStream& source, std::wstring& data)
+{
+	unsigned int length;
+	if (!source.ReadDataLittleEndian(length))
+	{
+		return false;
+	}
+
+	// Reject lengths which run past the end of the source stream, so that a truncated or
+	// corrupt source can't trigger a huge allocation.
+	if ((Stream::IStream::SizeType)length > ((source.Size() - source.GetStreamPos()) / (Stream::IStream::SizeType)sizeof(wchar_t)))
+	{
+		return false;
+	}
+	data.resize(length);
+	return (length == 0) || source.ReadDataLittleEndian(&data[0], length);
+}
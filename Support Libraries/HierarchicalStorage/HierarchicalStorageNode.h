@@ -5,6 +5,7 @@
 #include "Stream/Stream.pkg"
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <string>
 
 class HierarchicalStorageNode :public IHierarchicalStorageNode
@@ -52,6 +53,16 @@ public:
 	virtual void SetInlineBinaryDataEnabled(bool state);
 	void AddBinaryDataEntitiesToList(std::list<IHierarchicalStorageNode*>& binaryEntityList);
 
+	// Indexed access functions
+	virtual unsigned int GetChildCount() const;
+	virtual IHierarchicalStorageNode* GetChildByIndex(unsigned int index) const;
+	virtual unsigned int GetAttributeCount() const;
+	virtual IHierarchicalStorageAttribute* GetAttributeByIndex(unsigned int index) const;
+
+	// Binary storage functions
+	bool SaveBinaryNode(Stream::IStream& target) const;
+	bool LoadBinaryNode(Stream::IStream& source);
+
 protected:
 	// Stream functions
 	virtual void ResetInternalStreamPosition() const;
@@ -64,18 +75,55 @@ private:
 	// Parent functions
 	void SetParent(HierarchicalStorageNode* parent);
 
+	// Child functions
+	void AddChild(HierarchicalStorageNode* child);
+	void RenameChildInIndex(HierarchicalStorageNode* child, const std::wstring* previousName);
+	void RebuildChildIndex();
+
+	// Binary storage functions
+	static bool SaveBinaryString(Stream::IStream& target, const std::wstring& data);
+	static bool LoadBinaryString(Stream::IStream& source, std::wstring& data);
+
+private:
+	// Structures
+	// Note that the child index is keyed by interned name, but hashed and compared by the
+	// content of the name, so that lookups can be performed with any string without first
+	// resolving it through the shared name table.
+	struct NameHash
+	{
+		size_t operator()(const std::wstring* name) const { return std::hash<std::wstring>()(*name); }
+	};
+	struct NameEqual
+	{
+		bool operator()(const std::wstring* first, const std::wstring* second) const { return (first == second) || (*first == *second); }
+	};
+
 private:
 	// Typedefs
 	typedef std::vector<HierarchicalStorageNode*> ChildList;
-	typedef std::pair<std::wstring, HierarchicalStorageAttribute*> AttributeListEntry;
+	typedef std::unordered_map<const std::wstring*, ChildList, NameHash, NameEqual> ChildIndex;
+	typedef std::pair<const std::wstring*, HierarchicalStorageAttribute*> AttributeListEntry;
 	// Note that this is a vector rather than a map, so that we can preserve the explicit
 	// ordering of attributes.
 	typedef std::vector<AttributeListEntry> AttributeList;
 
 private:
-	std::wstring _name;
+	// Constants
+	// Child lists shorter than this are searched directly, as maintaining an index for
+	// them would cost more than it saves.
+	static const size_t ChildIndexMinimumChildCount = 8;
+
+private:
+	// Note that node and attribute names are interned, so that each distinct name is only
+	// stored once.
+	const std::wstring* _name;
 	HierarchicalStorageNode* _parent;
+	// Note that the child index is maintained by the functions which modify the child
+	// list, and is never modified by a const function, so concurrent lookups on a tree
+	// which isn't being modified are safe without any locking.
 	ChildList _children;
+	ChildIndex _childIndex;
+	bool _childIndexBuilt;
 	AttributeList _attributes;
 	bool _binaryDataPresent;
 	bool _inlineBinaryData;
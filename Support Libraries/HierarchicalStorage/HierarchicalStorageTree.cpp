@@ -27,11 +27,23 @@ void HierarchicalStorageTree::Initialize()
 //----------------------------------------------------------------------------------------------------------------------
 bool HierarchicalStorageTree::SaveTree(Stream::IStream& target)
 {
-	return SaveNode(*_root, target, L"");
+	return (_storageMode == StorageMode::Binary)? SaveTreeBinary(target): SaveTreeXML(target);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool HierarchicalStorageTree::LoadTree(Stream::IStream& source)
+{
+	return (_storageMode == StorageMode::Binary)? LoadTreeBinary(source): LoadTreeXML(source);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool HierarchicalStorageTree::SaveTreeXML(Stream::IStream& target)
+{
+	return SaveNode(*_root, target, L"");
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool HierarchicalStorageTree::LoadTreeXML(Stream::IStream& source)
 {
 	// Load the contents of the source stream into a buffer of unicode characters
 	std::wstring buffer;
@@ -75,6 +87,43 @@ bool HierarchicalStorageTree::LoadTree(Stream::IStream& source)
 	return true;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+bool HierarchicalStorageTree::SaveTreeBinary(Stream::IStream& target)
+{
+	bool result = target.WriteDataLittleEndian(BinaryStorageSignature);
+	result &= target.WriteDataLittleEndian(BinaryStorageVersion);
+	result &= _root->SaveBinaryNode(target);
+	return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool HierarchicalStorageTree::LoadTreeBinary(Stream::IStream& source)
+{
+	// Validate the binary storage header
+	unsigned int signature;
+	unsigned int version;
+	if (!source.ReadDataLittleEndian(signature) || !source.ReadDataLittleEndian(version))
+	{
+		_errorString = L"Unexpected end of binary data while reading the header";
+		return false;
+	}
+	if ((signature != BinaryStorageSignature) || (version != BinaryStorageVersion))
+	{
+		_errorString = L"Unrecognized binary data format";
+		return false;
+	}
+
+	// Load the node tree
+	_root->Initialize();
+	if (!_root->LoadBinaryNode(source))
+	{
+		_errorString = L"Binary data is truncated or corrupt";
+		_root->Initialize();
+		return false;
+	}
+	return true;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 bool HierarchicalStorageTree::SaveNode(IHierarchicalStorageNode& node, Stream::IStream& stream, const std::wstring& indentPrefix) const
 {
@@ -84,11 +133,12 @@ bool HierarchicalStorageTree::SaveNode(IHierarchicalStorageNode& node, Stream::I
 	streamView << indentPrefix << L'<' << node.GetName();
 
 	// Write attributes
-	std::list<IHierarchicalStorageAttribute*> attributeList = node.GetAttributeList();
-	for (std::list<IHierarchicalStorageAttribute*>::const_iterator i = attributeList.begin(); i != attributeList.end(); ++i)
+	unsigned int attributeCount = node.GetAttributeCount();
+	for (unsigned int attributeNo = 0; attributeNo < attributeCount; ++attributeNo)
 	{
-		std::wstring name = (*i)->GetName();
-		std::wstring value = (*i)->GetValue();
+		IHierarchicalStorageAttribute* attribute = node.GetAttributeByIndex(attributeNo);
+		std::wstring name = attribute->GetName();
+		std::wstring value = attribute->GetValue();
 		std::wstring finalValue;
 		for (unsigned int valuePos = 0; valuePos < value.length(); ++valuePos)
 		{
@@ -112,8 +162,8 @@ bool HierarchicalStorageTree::SaveNode(IHierarchicalStorageNode& node, Stream::I
 		}
 	}
 
-	std::list<IHierarchicalStorageNode*> childList = node.GetChildList();
-	if (childList.empty() && !node.GetBinaryDataPresent() && node.GetData().empty())
+	unsigned int childCount = node.GetChildCount();
+	if ((childCount == 0) && !node.GetBinaryDataPresent() && node.GetData().empty())
 	{
 		// If this entity contains no children and no data, shortcut the rest of the save
 		// process and use an empty element tag.
@@ -166,13 +216,14 @@ bool HierarchicalStorageTree::SaveNode(IHierarchicalStorageNode& node, Stream::I
 		}
 
 		// Write child elements
-		if (!childList.empty())
+		if (childCount > 0)
 		{
 			streamView << L"\n";
-			for (std::list<IHierarchicalStorageNode*>::const_iterator i = childList.begin(); i != childList.end(); ++i)
+			std::wstring childIndentPrefix = indentPrefix + L'\t';
+			for (unsigned int childNo = 0; childNo < childCount; ++childNo)
 			{
 				//##TODO## Add error handling
-				SaveNode(*(*i), stream, indentPrefix + L'\t');
+				SaveNode(*node.GetChildByIndex(childNo), stream, childIndentPrefix);
 			}
 			streamView << indentPrefix;
 		}
@@ -189,20 +240,23 @@ bool HierarchicalStorageTree::SaveNode(IHierarchicalStorageNode& node, Stream::I
 //----------------------------------------------------------------------------------------------------------------------
 void XMLCALL HierarchicalStorageTree::LoadStartElement(void *userData, const XML_Char *aname, const XML_Char **aatts)
 {
+	// Note that we create each child node with its final name, rather than renaming it
+	// after it's been added to its parent, so that the child index of the parent node
+	// doesn't need to be updated as each element is loaded.
 	HierarchicalStorageTree* tree = (HierarchicalStorageTree*)userData;
 	HierarchicalStorageNode* node = 0;
 	if (tree->_currentNodeDuringLoad == 0)
 	{
 		node = tree->_root;
 		tree->_currentNodeDuringLoad = node;
+		node->SetName(std::wstring(aname));
 	}
 	else
 	{
-		node = (HierarchicalStorageNode*)(&tree->_currentNodeDuringLoad->CreateChild());
+		node = (HierarchicalStorageNode*)(&tree->_currentNodeDuringLoad->CreateChild(std::wstring(aname)));
 		tree->_currentNodeDuringLoad = node;
 	}
 
-	node->SetName(std::wstring(aname));
 	while (*aatts != 0)
 	{
 		std::wstring name;
@@ -16,7 +16,6 @@ public:
 	void Initialize();
 
 	// Save/Load functions
-	//##TODO## Take the storage mode into account when saving and loading
 	virtual bool SaveTree(Stream::IStream& target);
 	virtual bool LoadTree(Stream::IStream& source);
 
@@ -33,8 +32,21 @@ public:
 	virtual IHierarchicalStorageNode& GetRootNode() const;
 	virtual Marshal::Ret<std::list<IHierarchicalStorageNode*>> GetBinaryDataNodeList();
 
+private:
+	// Constants
+	// The binary storage format is intended for caching trees which were originally loaded
+	// from XML, and isn't guaranteed to be readable by other versions of this library. We
+	// increment the version number whenever the format changes, so that stale binary data
+	// is rejected rather than misinterpreted.
+	static const unsigned int BinaryStorageSignature = 0x53484845;
+	static const unsigned int BinaryStorageVersion = 1;
+
 private:
 	// Save/Load functions
+	bool SaveTreeXML(Stream::IStream& target);
+	bool LoadTreeXML(Stream::IStream& source);
+	bool SaveTreeBinary(Stream::IStream& target);
+	bool LoadTreeBinary(Stream::IStream& source);
 	bool SaveNode(IHierarchicalStorageNode& node, Stream::IStream& stream, const std::wstring& indentPrefix) const;
 	static void XMLCALL LoadStartElement(void *userData, const XML_Char *aname, const XML_Char **aatts);
 	static void XMLCALL LoadEndElement(void *userData, const XML_Char *aname);
@@ -102,6 +102,13 @@ protected:
 	// Stream functions
 	virtual void ResetInternalStreamPosition() const = 0;
 	virtual Stream::IStream& GetInternalStream() const = 0;
+
+public:
+	// Indexed access functions
+	virtual unsigned int GetChildCount() const = 0;
+	virtual IHierarchicalStorageNode* GetChildByIndex(unsigned int index) const = 0;
+	virtual unsigned int GetAttributeCount() const = 0;
+	virtual IHierarchicalStorageAttribute* GetAttributeByIndex(unsigned int index) const = 0;
 };
 IHierarchicalStorageNode::~IHierarchicalStorageNode() { }
 
@@ -3,5 +3,6 @@
 //----------------------------------------------------------------------------------------------------------------------
 enum class IHierarchicalStorageTree::StorageMode
 {
-	XML
+	XML,
+	Binary
 };
@@ -1,4 +1,5 @@
 #include "HasMarshalConstructor.h"
+#include "IsBitwiseCopyable.h"
 #include "INestedMarshaller.h"
 #include "IsLastNestedContainerElement.h"
 #include <memory.h>
@@ -27,7 +28,7 @@ void DecomposeSTLContainer(void* itemArray, size_t elementSizeArray[], INestedMa
 	size_t containerEntryCount = element.size();
 	elementSizeArray[elementSizeArrayIndex++] = containerEntryCount;
 #ifdef MARSHALSUPPORT_CPP11SUPPORTED
-	if (!has_marshal_constructor<ElementType>::value && std::is_trivial<ElementType>::value)
+	if (is_bitwise_copyable<ElementType>::value)
 	{
 		ElementType* itemArrayWithType = (ElementType*)itemArray;
 		memcpy((void*)&itemArrayWithType[elementArrayIndex], (const void*)element.data(), containerEntryCount * sizeof(ElementType));
@@ -50,7 +51,7 @@ void DecomposeSTLContainer(void* itemArray, size_t elementSizeArray[], INestedMa
 {
 	size_t containerEntryCount = element.size();
 	elementSizeArray[elementSizeArrayIndex++] = containerEntryCount;
-	if (!has_marshal_constructor<ElementType>::value && std::is_trivial<ElementType>::value)
+	if (is_bitwise_copyable<ElementType>::value)
 	{
 		ElementType* itemArrayWithType = (ElementType*)itemArray;
 		memcpy((void*)&itemArrayWithType[elementArrayIndex], (const void*)element.data(), containerEntryCount * sizeof(ElementType));
@@ -88,7 +89,7 @@ inline void DecomposeSTLContainer(void* itemArray, size_t elementSizeArray[], IN
 template<class ElementType, size_t ArraySize>
 void DecomposeSTLContainer(void* itemArray, size_t elementSizeArray[], INestedMarshallerBase* const nestedMarshallerArray[], size_t& elementArrayIndex, size_t& elementSizeArrayIndex, size_t nestedMarshallerArrayIndex, const std::array<ElementType, ArraySize>& element)
 {
-	if (!has_marshal_constructor<ElementType>::value && std::is_trivial<ElementType>::value)
+	if (is_bitwise_copyable<ElementType>::value)
 	{
 		ElementType* itemArrayWithType = (ElementType*)itemArray;
 		memcpy((void*)&itemArrayWithType[elementArrayIndex], (const void*)element.data(), ArraySize * sizeof(ElementType));
@@ -107,7 +108,7 @@ void DecomposeSTLContainer(void* itemArray, size_t elementSizeArray[], INestedMa
 template<class ElementType, size_t ArraySize>
 void DecomposeSTLContainer(void* itemArray, size_t elementSizeArray[], INestedMarshallerBase* const nestedMarshallerArray[], size_t& elementArrayIndex, size_t& elementSizeArrayIndex, size_t nestedMarshallerArrayIndex, std::array<ElementType, ArraySize>&& element)
 {
-	if (!has_marshal_constructor<ElementType>::value && std::is_trivial<ElementType>::value)
+	if (is_bitwise_copyable<ElementType>::value)
 	{
 		ElementType* itemArrayWithType = (ElementType*)itemArray;
 		memcpy((void*)&itemArrayWithType[elementArrayIndex], (const void*)element.data(), ArraySize * sizeof(ElementType));
@@ -578,7 +579,7 @@ void DecomposeSTLContainer(void* itemArray, size_t elementSizeArray[], INestedMa
 	size_t containerEntryCount = element.size();
 	elementSizeArray[elementSizeArrayIndex++] = containerEntryCount;
 #ifdef MARSHALSUPPORT_CPP11SUPPORTED
-	if (!has_marshal_constructor<ElementType>::value && std::is_trivial<ElementType>::value)
+	if (is_bitwise_copyable<ElementType>::value)
 	{
 		ElementType* itemArrayWithType = (ElementType*)itemArray;
 		memcpy((void*)&itemArrayWithType[elementArrayIndex], (const void*)element.data(), containerEntryCount * sizeof(ElementType));
@@ -601,7 +602,7 @@ void DecomposeSTLContainer(void* itemArray, size_t elementSizeArray[], INestedMa
 {
 	size_t containerEntryCount = element.size();
 	elementSizeArray[elementSizeArrayIndex++] = containerEntryCount;
-	if (!has_marshal_constructor<ElementType>::value && std::is_trivial<ElementType>::value)
+	if (is_bitwise_copyable<ElementType>::value)
 	{
 		ElementType* itemArrayWithType = (ElementType*)itemArray;
 		memcpy((void*)&itemArrayWithType[elementArrayIndex], (const void*)element.data(), containerEntryCount * sizeof(ElementType));
@@ -8,6 +8,7 @@
 #include "IsSTLContainerNestedElementMarshallableOrSameSize.h"
 #include "EnsureSTLContainerKeySizesMatch.h"
 #include "HasMarshalConstructor.h"
+#include "IsBitwiseCopyable.h"
 #include "ClearSTLContainer.h"
 #include "MarshalObjectHelper.h"
 #include "RecomposeSTLContainer.h"
@@ -712,12 +713,12 @@ private:
 		{
 			// Directly initialize the target vector with the supplied array of data, performing a move operation if one
 			// is available and permitted. Note that in addition, we only use move iterators where the target elements
-			// use a non-trivial type. This is done as an optimization. Although the assign method in theory has all the
+			// aren't trivially copyable. This is done as an optimization. Although the assign method in theory has all the
 			// necessary information to optimize copying an array of standard layout types in one process using memcpy,
 			// in VS2013 it was observed that the move iterator wrappers prevent this optimization occurring. We avoid
 			// using move iterators in this case to achieve maximum efficiency.
 #ifdef MARSHALSUPPORT_CPP11SUPPORTED
-			if (!std::is_trivial<ElementType>::value && sourceDataMovable && AllowMove)
+			if (!Internal::is_bitwise_copyable<ElementType>::value && sourceDataMovable && AllowMove)
 			{
 				targetObject.assign(std::make_move_iterator(const_cast<ElementType*>(sourceData)), std::make_move_iterator(const_cast<ElementType*>(sourceData) + sourceDataLength));
 			}
@@ -989,7 +990,7 @@ private:
 		{
 			// Directly initialize the target array with the supplied array of data, performing a direct memory copy if
 			// safe, or performing a move operation if one is available and permitted.
-			if (std::is_trivial<ElementType>::value)
+			if (Internal::is_bitwise_copyable<ElementType>::value)
 			{
 				memcpy((void*)targetObject.data(), (const void*)sourceData, ArraySize * sizeof(ElementType));
 			}
@@ -1195,12 +1196,12 @@ private:
 		{
 			// Directly initialize the target vector with the supplied array of data, performing a move operation if one
 			// is available and permitted. Note that in addition, we only use move iterators where the target elements
-			// use a non-trivial type. This is done as an optimization. Although the assign method in theory has all the
+			// aren't trivially copyable. This is done as an optimization. Although the assign method in theory has all the
 			// necessary information to optimize copying an array of standard layout types in one process using memcpy,
 			// in VS2013 it was observed that the move iterator wrappers prevent this optimization occurring. We avoid
 			// using move iterators in this case to achieve maximum efficiency.
 #ifdef MARSHALSUPPORT_CPP11SUPPORTED
-			if (!std::is_trivial<ElementType>::value && sourceDataMovable && AllowMove)
+			if (!Internal::is_bitwise_copyable<ElementType>::value && sourceDataMovable && AllowMove)
 			{
 				targetObject.assign(std::make_move_iterator(const_cast<ElementType*>(sourceData)), std::make_move_iterator(const_cast<ElementType*>(sourceData) + sourceDataLength));
 			}
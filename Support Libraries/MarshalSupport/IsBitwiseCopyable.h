@@ -0,0 +1,33 @@
+#ifndef __ISBITWISECOPYABLE_H__
+#define __ISBITWISECOPYABLE_H__
+#include "MarshalPreprocessorMacros.h"
+#include "HasMarshalConstructor.h"
+#ifdef MARSHALSUPPORT_CPP11SUPPORTED
+#include <type_traits>
+#endif
+namespace MarshalSupport {
+namespace Internal {
+
+// Define a helper type to determine whether arrays of a specific type can be transferred between assemblies with a raw
+// memory copy. This is true for any type which has no custom marshal constructor and is trivially copyable. Note that
+// this is a wider set of types than those which are trivial, as a trivially copyable type is still permitted to supply
+// its own default constructor. Since a trivially copyable type cannot supply its own copy or move operations or
+// destructor, copying the object representation is exactly equivalent to invoking its copy constructor. Note that
+// VS2010 doesn't supply std::is_trivially_copyable, so we fall back to the narrower std::is_trivial test there.
+template<class T>
+struct is_bitwise_copyable
+{
+public:
+	// Result
+#if defined(MARSHALSUPPORT_CPP11SUPPORTED) && (!defined(_MSC_VER) || (_MSC_VER >= 1700))
+	static const bool value = !has_marshal_constructor<T>::value && std::is_trivially_copyable<T>::value;
+#elif defined(MARSHALSUPPORT_CPP11SUPPORTED)
+	static const bool value = !has_marshal_constructor<T>::value && std::is_trivial<T>::value;
+#else
+	static const bool value = false;
+#endif
+};
+
+} // Close namespace Internal
+} // Close namespace MarshalSupport
+#endif
@@ -6,6 +6,7 @@
 #include "MarshalOut.h"
 #include "MarshalInOut.h"
 #include "MarshalRet.h"
+#include "MarshalSpan.h"
 namespace MarshalSupport {
 namespace Operators {
 namespace Marshal {
@@ -29,6 +30,9 @@ using InOut = MarshalSupport::Marshal::InOut<ContainerType, IsLastElement, IsThi
 template<class ContainerType, bool IsOnlyMovable = MarshalSupport::Internal::is_only_movable<typename MarshalSupport::Internal::get_last_nested_container_element_type<ContainerType>::type>::value>
 using Ret = MarshalSupport::Marshal::Ret<ContainerType, IsOnlyMovable>;
 
+template<class ElementType>
+using Span = MarshalSupport::Marshal::Span<ElementType>;
+
 } // Close namespace Marshal
 } // Close namespace Operators
 } // Close namespace MarshalSupport
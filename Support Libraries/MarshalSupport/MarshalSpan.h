@@ -0,0 +1,129 @@
+#ifndef __MARSHALSUPPORT_MARSHALSPAN_H__
+#define __MARSHALSUPPORT_MARSHALSPAN_H__
+#include "MarshalPreprocessorMacros.h"
+#include "IsBitwiseCopyable.h"
+#include <vector>
+#include <string>
+#include <cstddef>
+#ifdef MARSHALSUPPORT_CPP11SUPPORTED
+#include <array>
+#endif
+namespace MarshalSupport {
+namespace Marshal {
+
+//----------------------------------------------------------------------------------------------------------------------
+// The Marshal::Span class template provides a non-owning view over a contiguous block of elements, which can be passed
+// across an assembly boundary as a simple pointer and length pair. Unlike the other marshallers, no copy of the data is
+// made when the span is constructed, and the receiver chooses whether to read the elements in place, or copy them into a
+// container of its own using the Get methods, which perform a single bulk copy into memory allocated by the receiver.
+// Since the receiver interprets the referenced memory directly, this is only safe for element types which have the same
+// size and layout on both sides of the boundary, so spans are restricted to trivially copyable element types with no
+// custom marshaller.
+//
+// A span never owns the memory it refers to, and the following lifetime rules apply:
+// -When a span is passed as an argument, the referenced memory is only guaranteed to remain valid until the called
+//  function returns. The callee must copy out any data it needs to retain beyond that point, and must never store the
+//  span itself.
+// -When a span is returned from a function, the referenced memory is owned by the called object, and remains valid only
+//  while that object exists and until the next call which could modify the referenced data. Functions returning a span
+//  must document what the span refers to, and callers are responsible for ensuring any required locks are held while
+//  the span is being read.
+// -A span constructed from a container is invalidated by any operation on that container that would invalidate its
+//  iterators.
+template<class ElementType>
+class Span
+{
+public:
+	// Constructors
+	inline Span()
+	:_data(0), _size(0)
+	{
+		AssertElementTypeValid();
+	}
+	inline Span(const ElementType* data, size_t size)
+	:_data(data), _size(size)
+	{
+		AssertElementTypeValid();
+	}
+	template<class Alloc>
+	inline Span(const std::vector<ElementType, Alloc>& source)
+	:_data(source.empty() ? 0 : &source[0]), _size(source.size())
+	{
+		AssertElementTypeValid();
+	}
+	template<class traits, class Alloc>
+	inline Span(const std::basic_string<ElementType, traits, Alloc>& source)
+	:_data(source.data()), _size(source.size())
+	{
+		AssertElementTypeValid();
+	}
+#ifdef MARSHALSUPPORT_CPP11SUPPORTED
+	template<size_t ArraySize>
+	inline Span(const std::array<ElementType, ArraySize>& source)
+	:_data(source.data()), _size(ArraySize)
+	{
+		AssertElementTypeValid();
+	}
+#endif
+
+	// Element access methods
+	inline const ElementType* data() const
+	{
+		return _data;
+	}
+	inline size_t size() const
+	{
+		return _size;
+	}
+	inline bool empty() const
+	{
+		return (_size == 0);
+	}
+	inline const ElementType& operator[](size_t index) const
+	{
+		return _data[index];
+	}
+	inline const ElementType* begin() const
+	{
+		return _data;
+	}
+	inline const ElementType* end() const
+	{
+		return _data + _size;
+	}
+
+	// Marshal methods
+	inline std::vector<ElementType> Get() const
+	{
+		return std::vector<ElementType>(_data, _data + _size);
+	}
+	template<class Alloc>
+	inline void Get(std::vector<ElementType, Alloc>& targetObject) const
+	{
+		targetObject.assign(_data, _data + _size);
+	}
+	template<class traits, class Alloc>
+	inline void Get(std::basic_string<ElementType, traits, Alloc>& targetObject) const
+	{
+		targetObject.assign(_data, _size);
+	}
+
+private:
+	// Validation methods
+	static inline void AssertElementTypeValid()
+	{
+#ifdef MARSHALSUPPORT_CPP11SUPPORTED
+		static_assert(MarshalSupport::Internal::is_bitwise_copyable<ElementType>::value, "Marshal::Span can only be used with trivially copyable element types which have no custom marshaller");
+#endif
+	}
+
+private:
+	// Note that the layout of this type must remain identical on both sides of an assembly boundary, so no other data
+	// members should be added here.
+	const ElementType* _data;
+	size_t _size;
+};
+
+} // Close namespace Marshal
+} // Close namespace MarshalSupport
+#endif
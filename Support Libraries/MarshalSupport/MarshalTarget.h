@@ -9,6 +9,7 @@
 #include "IsSTLContainerNestedElementMarshallableOrSameSize.h"
 #include "EnsureSTLContainerKeySizesMatch.h"
 #include "HasMarshalConstructor.h"
+#include "IsBitwiseCopyable.h"
 #include "ClearSTLContainer.h"
 #include "MarshalObjectHelper.h"
 #include "RecomposeSTLContainer.h"
@@ -283,13 +284,13 @@ protected:
 		else
 		{
 			// Directly initialize the target vector with the supplied array of data. Note that we only perform the
-			// assignment using move iterators where the target elements use a non-trivial type. This is done as an
+			// assignment using move iterators where the target elements aren't trivially copyable. This is done as an
 			// optimization. Although the assign method in theory has all the necessary information to optimize copying
 			// an array of standard layout types in one process using memcpy, in VS2013 it was observed that the move
 			// iterator wrappers prevent this optimization occurring. We avoid using move iterators in this case to
 			// achieve maximum efficiency.
 #ifdef MARSHALSUPPORT_CPP11SUPPORTED
-			if (!std::is_trivial<ElementType>::value)
+			if (!Internal::is_bitwise_copyable<ElementType>::value)
 			{
 				_targetObject->assign(std::make_move_iterator(const_cast<ElementType*>(sourceData)), std::make_move_iterator(const_cast<ElementType*>(sourceData + sourceDataLength)));
 			}
@@ -373,7 +374,7 @@ protected:
 			}
 		}
 #ifdef MARSHALSUPPORT_CPP11SUPPORTED
-		else if (!std::is_trivial<ElementType>::value)
+		else if (!Internal::is_bitwise_copyable<ElementType>::value)
 #else
 		else
 #endif
@@ -415,7 +416,7 @@ protected:
 				nextSourceObject = reinterpret_cast<ElementType*>(reinterpret_cast<unsigned char*>(nextSourceObject) + elementByteSize);
 			}
 		}
-		else if (!std::is_trivial<ElementType>::value)
+		else if (!Internal::is_bitwise_copyable<ElementType>::value)
 		{
 			for (size_t i = 0; i < sourceDataLength; ++i)
 			{
@@ -561,7 +562,7 @@ protected:
 				nextSourceObject = reinterpret_cast<ElementType*>(reinterpret_cast<unsigned char*>(nextSourceObject) + elementByteSize);
 			}
 		}
-		else if (!std::is_trivial<ElementType>::value)
+		else if (!Internal::is_bitwise_copyable<ElementType>::value)
 		{
 			for (size_t i = 0; i < sourceDataLength; ++i)
 			{
@@ -682,7 +683,7 @@ protected:
 				nextSourceObject = reinterpret_cast<const ElementType*>(reinterpret_cast<const unsigned char*>(nextSourceObject) + elementByteSize);
 			}
 		}
-		else if (!std::is_trivial<ElementType>::value)
+		else if (!Internal::is_bitwise_copyable<ElementType>::value)
 		{
 			for (size_t i = 0; i < sourceDataLength; ++i)
 			{
@@ -721,7 +722,7 @@ protected:
 				nextSourceObject = reinterpret_cast<ElementType*>(reinterpret_cast<unsigned char*>(nextSourceObject) + elementByteSize);
 			}
 		}
-		else if (!std::is_trivial<ElementType>::value)
+		else if (!Internal::is_bitwise_copyable<ElementType>::value)
 		{
 			for (size_t i = 0; i < sourceDataLength; ++i)
 			{
@@ -916,13 +917,13 @@ protected:
 		else
 		{
 			// Directly initialize the target vector with the supplied array of data. Note that we only perform the
-			// assignment using move iterators where the target elements use a non-trivial type. This is done as an
+			// assignment using move iterators where the target elements aren't trivially copyable. This is done as an
 			// optimization. Although the assign method in theory has all the necessary information to optimize copying
 			// an array of standard layout types in one process using memcpy, in VS2013 it was observed that the move
 			// iterator wrappers prevent this optimization occurring. We avoid using move iterators in this case to
 			// achieve maximum efficiency.
 #ifdef MARSHALSUPPORT_CPP11SUPPORTED
-			if (!std::is_trivial<ElementType>::value)
+			if (!Internal::is_bitwise_copyable<ElementType>::value)
 			{
 				_targetObject->assign(std::make_move_iterator(sourceData), std::make_move_iterator(sourceData + sourceDataLength));
 			}
@@ -1,4 +1,5 @@
 #include "HasMarshalConstructor.h"
+#include "IsBitwiseCopyable.h"
 #include "INestedMarshaller.h"
 #include "MarshalObjectHelper.h"
 #include "IsThisOrNestedElementLastNestedContainerElement.h"
@@ -55,7 +56,7 @@ void RecomposeSTLContainerHelper<true, IsOnlyMovable>::RecomposeSTLContainer(siz
 {
 	size_t containerEntryCount = elementSizeArray[elementSizeArrayIndex++];
 #ifdef MARSHALSUPPORT_CPP11SUPPORTED
-	if (!has_marshal_constructor<ElementType>::value && std::is_trivial<ElementType>::value)
+	if (is_bitwise_copyable<ElementType>::value)
 	{
 		ElementType* itemArrayWithType = (ElementType*)itemArray;
 		element.assign(itemArrayWithType + elementArrayIndex, itemArrayWithType + elementArrayIndex + containerEntryCount);
@@ -109,7 +110,7 @@ template<bool IsOnlyMovable>
 template<class ElementType, size_t ArraySize>
 void RecomposeSTLContainerHelper<true, IsOnlyMovable>::RecomposeSTLContainer(size_t elementByteSize, void* itemArray, const size_t elementSizeArray[], INestedMarshallerBase* const nestedMarshallerArray[], size_t& elementArrayIndex, size_t& elementSizeArrayIndex, size_t nestedMarshallerArrayIndex, std::array<ElementType, ArraySize>& element)
 {
-	if (!has_marshal_constructor<ElementType>::value && std::is_trivial<ElementType>::value)
+	if (is_bitwise_copyable<ElementType>::value)
 	{
 		ElementType* itemArrayWithType = (ElementType*)itemArray;
 		memcpy((void*)element.data(), (const void*)&itemArrayWithType[elementArrayIndex], ArraySize * sizeof(ElementType));
@@ -586,7 +587,7 @@ void RecomposeSTLContainerHelper<true, IsOnlyMovable>::RecomposeSTLContainer(siz
 {
 	size_t containerEntryCount = elementSizeArray[elementSizeArrayIndex++];
 #ifdef MARSHALSUPPORT_CPP11SUPPORTED
-	if (!has_marshal_constructor<ElementType>::value && std::is_trivial<ElementType>::value)
+	if (is_bitwise_copyable<ElementType>::value)
 	{
 		ElementType* itemArrayWithType = (ElementType*)itemArray;
 		element.assign(itemArrayWithType + elementArrayIndex, itemArrayWithType + elementArrayIndex + containerEntryCount);
@@ -17,6 +17,7 @@ using namespace MarshalSupport;
 #include "CustomMarshalObject.h"
 #include "MoveTypeNoCopy.h"
 #include "MoveTypeConstructOnly.h"
+#include "TriviallyCopyableObject.h"
 
 class IMarshalTest
 {
@@ -238,6 +239,20 @@ public:
 	virtual void OutTestPair01(const Marshal::Out<std::pair<std::wstring, int>>& marshaller) const = 0;
 	virtual Marshal::Ret<std::pair<std::wstring, int>> RetTestPair01() const = 0;
 
+	//Span tests
+	virtual bool InTestSpan01(const Marshal::Span<int>& marshaller) const = 0;
+	virtual bool InTestSpan02(const Marshal::Span<char>& marshaller) const = 0;
+	virtual bool InTestSpan03(const Marshal::Span<TriviallyCopyableObject>& marshaller) const = 0;
+	virtual Marshal::Span<int> RetTestSpan01() const = 0;
+
+	//Trivially copyable type tests
+	virtual bool InTestTriviallyCopyable01(const Marshal::In<std::vector<TriviallyCopyableObject>>& marshaller) const = 0;
+	virtual bool InTestTriviallyCopyable02(const Marshal::In<std::vector<std::vector<TriviallyCopyableObject>>>& marshaller) const = 0;
+	virtual void OutTestTriviallyCopyable01(const Marshal::Out<std::vector<TriviallyCopyableObject>>& marshaller) const = 0;
+	virtual void OutTestTriviallyCopyable02(const Marshal::Out<std::vector<std::vector<TriviallyCopyableObject>>>& marshaller) const = 0;
+	virtual Marshal::Ret<std::vector<TriviallyCopyableObject>> RetTestTriviallyCopyable01() const = 0;
+	virtual Marshal::Ret<std::vector<std::vector<TriviallyCopyableObject>>> RetTestTriviallyCopyable02() const = 0;
+
 protected:
 	inline ~IMarshalTest() { }
 };
@@ -17,6 +17,7 @@ public:
 	virtual void StringInNoMarshalling(const char* data, std::string& out) const = 0;
 	virtual void StringInNoMarshallingWithSize(const char* data, size_t length, std::string& out) const = 0;
 	virtual void StringInWithMarshalling(const Marshal::In<std::string>& data, std::string& out) const = 0;
+	virtual void StringInWithSpan(const Marshal::Span<char>& data, std::string& out) const = 0;
 
 	virtual void FillVectorNoMarshalling(double* data, size_t entryCount, std::vector<double>& out) const = 0;
 	virtual void FillVectorNoMarshallingPushBack(double* data, size_t entryCount, std::vector<double>& out) const = 0;
@@ -26,6 +27,10 @@ public:
 	virtual void FillVectorWithMarshallingPushBack(double* data, size_t entryCount, const Marshal::Out<std::vector<double>>& out) const = 0;
 	virtual void FillVectorWithMarshallingAssign(double* data, size_t entryCount, const Marshal::Out<std::vector<double>>& out) const = 0;
 	virtual void FillVectorWithMarshallingConstruct(double* data, size_t entryCount, const Marshal::Out<std::vector<double>>& out) const = 0;
+	virtual void FillVectorWithSpan(const Marshal::Span<double>& data, std::vector<double>& out) const = 0;
+	virtual void FillVectorWithSpanPushBack(const Marshal::Span<double>& data, std::vector<double>& out) const = 0;
+	virtual void FillVectorWithSpanAssign(const Marshal::Span<double>& data, std::vector<double>& out) const = 0;
+	virtual void FillVectorWithSpanConstruct(const Marshal::Span<double>& data, std::vector<double>& out) const = 0;
 };
 
 #endif
@@ -833,6 +833,59 @@ protected:
 	}
 #endif
 
+	//Span tests
+	virtual bool InTestSpan01(const Marshal::Span<int>& marshaller) const
+	{
+		return CompareTestData(marshaller.Get(), testData.testPrimitive01);
+	}
+	virtual bool InTestSpan02(const Marshal::Span<char>& marshaller) const
+	{
+		std::string result;
+		marshaller.Get(result);
+		return CompareTestData(result, testData.testPrimitive33);
+	}
+	virtual bool InTestSpan03(const Marshal::Span<TriviallyCopyableObject>& marshaller) const
+	{
+		bool result = true;
+		REQUIRE(marshaller.size() == testData.testTriviallyCopyable01.size());
+		result &= (marshaller.size() == testData.testTriviallyCopyable01.size());
+		for(size_t i = 0; result && (i < marshaller.size()); ++i)
+		{
+			result &= CompareTestData(marshaller[i], testData.testTriviallyCopyable01[i]);
+		}
+		return result;
+	}
+	virtual Marshal::Span<int> RetTestSpan01() const
+	{
+		return testData.testPrimitive01;
+	}
+
+	//Trivially copyable type tests
+	virtual bool InTestTriviallyCopyable01(const Marshal::In<std::vector<TriviallyCopyableObject>>& marshaller) const
+	{
+		return CompareTestData(marshaller.Get(), testData.testTriviallyCopyable01);
+	}
+	virtual bool InTestTriviallyCopyable02(const Marshal::In<std::vector<std::vector<TriviallyCopyableObject>>>& marshaller) const
+	{
+		return CompareTestData(marshaller.Get(), testData.testTriviallyCopyable02);
+	}
+	virtual void OutTestTriviallyCopyable01(const Marshal::Out<std::vector<TriviallyCopyableObject>>& marshaller) const
+	{
+		marshaller = testData.testTriviallyCopyable01;
+	}
+	virtual void OutTestTriviallyCopyable02(const Marshal::Out<std::vector<std::vector<TriviallyCopyableObject>>>& marshaller) const
+	{
+		marshaller = testData.testTriviallyCopyable02;
+	}
+	virtual Marshal::Ret<std::vector<TriviallyCopyableObject>> RetTestTriviallyCopyable01() const
+	{
+		return testData.testTriviallyCopyable01;
+	}
+	virtual Marshal::Ret<std::vector<std::vector<TriviallyCopyableObject>>> RetTestTriviallyCopyable02() const
+	{
+		return testData.testTriviallyCopyable02;
+	}
+
 #ifdef MARSHALSUPPORT_CPP11SUPPORTED
 	//std::tuple tests
 	virtual bool InTestTuple01(const Marshal::In<std::tuple<std::wstring, int, bool, std::string>>& marshaller) const
@@ -25,6 +25,7 @@ using namespace MarshalSupport;
 #include "MoveTypeNoCopy.h"
 #endif
 #include "CustomMarshalObject.h"
+#include "TriviallyCopyableObject.h"
 #include "VectorHasher.h"
 
 class MarshalTestData
@@ -181,6 +182,15 @@ public:
 #ifdef MARSHALSUPPORT_CPP11SUPPORTED
 		testTuple01 = std::make_tuple(std::wstring(L"Test"), 1234, true, std::string("MoreData"));
 #endif
+
+		for(int i = 0; i < 1000; ++i)
+		{
+			testTriviallyCopyable01.push_back(TriviallyCopyableObject(i));
+		}
+		for(int i = 0; i < 10; ++i)
+		{
+			testTriviallyCopyable02.push_back(std::vector<TriviallyCopyableObject>(testTriviallyCopyable01.begin(), testTriviallyCopyable01.begin() + (i * 100)));
+		}
 	}
 
 	//In tests
@@ -284,6 +294,9 @@ public:
 	std::tuple<std::string, MoveTypeNoCopy> testTuple02;
 	std::tuple<> testTuple03;
 #endif
+
+	std::vector<TriviallyCopyableObject> testTriviallyCopyable01;
+	std::vector<std::vector<TriviallyCopyableObject>> testTriviallyCopyable02;
 };
 
 #endif
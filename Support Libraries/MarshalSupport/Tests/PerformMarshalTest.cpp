@@ -231,6 +231,50 @@ extern "C" __declspec(dllexport) bool MarshalTestTuple(IMarshalTestBase& marshal
 	return result;
 }
 
+//----------------------------------------------------------------------------------------
+extern "C" __declspec(dllexport) bool MarshalTestSpan(IMarshalTestBase& marshalTest)
+{
+	MarshalTestData testData;
+
+	bool result = true;
+	result &= marshalTest.InTestSpan01(testData.testPrimitive01);
+	result &= marshalTest.InTestSpan01(Marshal::Span<int>(&testData.testPrimitive01[0], testData.testPrimitive01.size()));
+	result &= marshalTest.InTestSpan02(testData.testPrimitive33);
+	result &= marshalTest.InTestSpan03(testData.testTriviallyCopyable01);
+	std::vector<int> retTestSpan01;
+	marshalTest.RetTestSpan01().Get(retTestSpan01);
+
+	MarshalTestData originalTestData;
+	result &= CompareTestData(originalTestData.testPrimitive01, retTestSpan01);
+	REQUIRE(Marshal::Span<int>().empty());
+
+	return result;
+}
+
+//----------------------------------------------------------------------------------------
+extern "C" __declspec(dllexport) bool MarshalTestTriviallyCopyable(IMarshalTestBase& marshalTest)
+{
+	MarshalTestData testData;
+
+	bool result = true;
+	std::vector<TriviallyCopyableObject> outTestTriviallyCopyable01;
+	std::vector<std::vector<TriviallyCopyableObject>> outTestTriviallyCopyable02;
+	result &= marshalTest.InTestTriviallyCopyable01(testData.testTriviallyCopyable01);
+	result &= marshalTest.InTestTriviallyCopyable02(testData.testTriviallyCopyable02);
+	marshalTest.OutTestTriviallyCopyable01(outTestTriviallyCopyable01);
+	marshalTest.OutTestTriviallyCopyable02(outTestTriviallyCopyable02);
+	std::vector<TriviallyCopyableObject> retTestTriviallyCopyable01(marshalTest.RetTestTriviallyCopyable01());
+	std::vector<std::vector<TriviallyCopyableObject>> retTestTriviallyCopyable02(marshalTest.RetTestTriviallyCopyable02());
+
+	MarshalTestData originalTestData;
+	result &= CompareTestData(originalTestData.testTriviallyCopyable01, outTestTriviallyCopyable01);
+	result &= CompareTestData(originalTestData.testTriviallyCopyable02, outTestTriviallyCopyable02);
+	result &= CompareTestData(originalTestData.testTriviallyCopyable01, retTestTriviallyCopyable01);
+	result &= CompareTestData(originalTestData.testTriviallyCopyable02, retTestTriviallyCopyable02);
+
+	return result;
+}
+
 //----------------------------------------------------------------------------------------
 extern "C" __declspec(dllexport) bool MarshalTestUniquePtr(IMarshalTestBase& marshalTest)
 {
@@ -14,6 +14,8 @@ extern "C" __declspec(dllimport) bool MarshalTestNoCopyTypes(IMarshalTest& marsh
 extern "C" __declspec(dllimport) bool MarshalTestPair(IMarshalTest& marshalTest);
 extern "C" __declspec(dllimport) bool MarshalTestTuple(IMarshalTest& marshalTest);
 extern "C" __declspec(dllimport) bool MarshalTestUniquePtr(IMarshalTest& marshalTest);
+extern "C" __declspec(dllimport) bool MarshalTestSpan(IMarshalTest& marshalTest);
+extern "C" __declspec(dllimport) bool MarshalTestTriviallyCopyable(IMarshalTest& marshalTest);
 
 extern "C" __declspec(dllimport) bool MarshalTestInPrimitive(IMarshalTest& marshalTest);
 extern "C" __declspec(dllimport) bool MarshalTestInComplex(IMarshalTest& marshalTest);
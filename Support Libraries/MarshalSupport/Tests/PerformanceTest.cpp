@@ -15,6 +15,11 @@ void PerformanceTest::StringInWithMarshalling(const Marshal::In<std::string>& da
 	data.Get(out);
 }
 
+void PerformanceTest::StringInWithSpan(const Marshal::Span<char>& data, std::string& out) const
+{
+	data.Get(out);
+}
+
 void PerformanceTest::FillVectorNoMarshalling(double* data, size_t entryCount, std::vector<double>& out) const
 {
 	out.resize(entryCount);
@@ -72,3 +77,34 @@ void PerformanceTest::FillVectorWithMarshallingConstruct(double* data, size_t en
 {
 	out = std::vector<double>(data, (data + entryCount));
 }
+
+void PerformanceTest::FillVectorWithSpan(const Marshal::Span<double>& data, std::vector<double>& out) const
+{
+	size_t entryCount = data.size();
+	out.resize(entryCount);
+	for(size_t i = 0; i < entryCount; ++i)
+	{
+		out[i] = data[i];
+	}
+}
+
+void PerformanceTest::FillVectorWithSpanPushBack(const Marshal::Span<double>& data, std::vector<double>& out) const
+{
+	size_t entryCount = data.size();
+	out.clear();
+	out.reserve(entryCount);
+	for(size_t i = 0; i < entryCount; ++i)
+	{
+		out.push_back(data[i]);
+	}
+}
+
+void PerformanceTest::FillVectorWithSpanAssign(const Marshal::Span<double>& data, std::vector<double>& out) const
+{
+	data.Get(out);
+}
+
+void PerformanceTest::FillVectorWithSpanConstruct(const Marshal::Span<double>& data, std::vector<double>& out) const
+{
+	out = std::vector<double>(data.begin(), data.end());
+}
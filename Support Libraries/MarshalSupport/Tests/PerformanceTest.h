@@ -7,6 +7,7 @@ class PerformanceTest :public IPerformanceTest
 	virtual void StringInNoMarshalling(const char* data, std::string& out) const;
 	virtual void StringInNoMarshallingWithSize(const char* data, size_t length, std::string& out) const;
 	virtual void StringInWithMarshalling(const Marshal::In<std::string>& data, std::string& out) const;
+	virtual void StringInWithSpan(const Marshal::Span<char>& data, std::string& out) const;
 
 	virtual void FillVectorNoMarshalling(double* data, size_t entryCount, std::vector<double>& out) const;
 	virtual void FillVectorNoMarshallingPushBack(double* data, size_t entryCount, std::vector<double>& out) const;
@@ -16,6 +17,10 @@ class PerformanceTest :public IPerformanceTest
 	virtual void FillVectorWithMarshallingPushBack(double* data, size_t entryCount, const Marshal::Out<std::vector<double>>& out) const;
 	virtual void FillVectorWithMarshallingAssign(double* data, size_t entryCount, const Marshal::Out<std::vector<double>>& out) const;
 	virtual void FillVectorWithMarshallingConstruct(double* data, size_t entryCount, const Marshal::Out<std::vector<double>>& out) const;
+	virtual void FillVectorWithSpan(const Marshal::Span<double>& data, std::vector<double>& out) const;
+	virtual void FillVectorWithSpanPushBack(const Marshal::Span<double>& data, std::vector<double>& out) const;
+	virtual void FillVectorWithSpanAssign(const Marshal::Span<double>& data, std::vector<double>& out) const;
+	virtual void FillVectorWithSpanConstruct(const Marshal::Span<double>& data, std::vector<double>& out) const;
 };
 
 #endif
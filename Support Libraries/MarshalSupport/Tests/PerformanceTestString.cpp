@@ -13,13 +13,14 @@ int main()
 	std::chrono::duration<float> secs = t1_cpu - t0_cpu;
 
 	std::cout << "MarshalSupport std::string performance test" << std::endl;
-	std::cout << "\t\tchar*\t\tchar* + size\tMarshal" << std::endl;
+	std::cout << "\t\tchar*\t\tchar* + size\tMarshal\t\tSpan" << std::endl;
 
 	std::cout << std::showpoint << std::fixed << std::setprecision(8);
 
 	std::string stringResult0;
 	std::string stringResult1;
 	std::string stringResult2;
+	std::string stringResult3;
 	unsigned int stringLoopCount = 10000000;
 	unsigned int stringLength = 98;
 	bool enableOutput = false;
@@ -62,6 +63,15 @@ int main()
 		}
 		t1_cpu = std::chrono::high_resolution_clock::now();
 		secs = t1_cpu - t0_cpu;
+		if(enableOutput) std::cout << secs.count() << '\t';
+
+		t0_cpu = std::chrono::high_resolution_clock::now();
+		for(unsigned int j = 0; j < stringLoopCount; j++)
+		{
+			performanceTestInterface->StringInWithSpan(testString, stringResult3);
+		}
+		t1_cpu = std::chrono::high_resolution_clock::now();
+		secs = t1_cpu - t0_cpu;
 		if(enableOutput) std::cout << secs.count() << '\n';
 
 		stringLength = (stringLength + 1) % 100;
@@ -106,8 +106,8 @@ int main()
 
 	if(columnOutput)
 	{
-		std::cout << "\tPushBck\t\t\tResize\t\t\tConstr\t\t\tAssign" << std::endl;
-		std::cout << "Direct\tNative\tMarshal\tDirect\tNative\tMarshal\tDirect\tNative\tMarshal\tDirect\tNative\tMarshal" << std::endl;
+		std::cout << "\tPushBck\t\t\t\tResize\t\t\t\tConstr\t\t\t\tAssign" << std::endl;
+		std::cout << "Direct\tNative\tMarshal\tSpan\tDirect\tNative\tMarshal\tSpan\tDirect\tNative\tMarshal\tSpan\tDirect\tNative\tMarshal\tSpan" << std::endl;
 		std::cout << std::showpoint << std::fixed << std::setprecision(5);
 	}
 	else
@@ -115,7 +115,7 @@ int main()
 		std::cout << "\tPushBck\t\tResize\t\tConstr\t\tAssign" << std::endl;
 		std::cout << std::showpoint << std::fixed << std::setprecision(8);
 	}
-	std::chrono::duration<float> durations[4][3];
+	std::chrono::duration<float> durations[4][4];
 
 	while(true)
 	{
@@ -302,12 +302,73 @@ int main()
 		if(checkResult) CheckResult(data, result0, result1, result2, result3);
 		if(clearResult) ClearResult(result0, result1, result2, result3);
 
+		if(!columnOutput) std::cout << std::endl << "Span";
+		t0_cpu = std::chrono::high_resolution_clock::now();
+		for(int j = 0; j < N; j++)
+		{
+			performanceTestInterface->FillVectorWithSpanPushBack(Marshal::Span<double>(&data[M*(4*j+0)], M), result0);
+			performanceTestInterface->FillVectorWithSpanPushBack(Marshal::Span<double>(&data[M*(4*j+1)], M), result1);
+			performanceTestInterface->FillVectorWithSpanPushBack(Marshal::Span<double>(&data[M*(4*j+2)], M), result2);
+			performanceTestInterface->FillVectorWithSpanPushBack(Marshal::Span<double>(&data[M*(4*j+3)], M), result3);
+		}
+		t1_cpu = std::chrono::high_resolution_clock::now();
+		secs = t1_cpu - t0_cpu;
+		durations[0][3] = secs;
+		if(!columnOutput) std::cout << "\t" << secs.count() << " " << (int)((secs.count() / durations[0][0].count()) * 100) << "%";
+		if(checkResult) CheckResult(data, result0, result1, result2, result3);
+		if(clearResult) ClearResult(result0, result1, result2, result3);
+
+		t0_cpu = std::chrono::high_resolution_clock::now();
+		for(int j = 0; j < N; j++)
+		{
+			performanceTestInterface->FillVectorWithSpan(Marshal::Span<double>(&data[M*(4*j+0)], M), result0);
+			performanceTestInterface->FillVectorWithSpan(Marshal::Span<double>(&data[M*(4*j+1)], M), result1);
+			performanceTestInterface->FillVectorWithSpan(Marshal::Span<double>(&data[M*(4*j+2)], M), result2);
+			performanceTestInterface->FillVectorWithSpan(Marshal::Span<double>(&data[M*(4*j+3)], M), result3);
+		}
+		t1_cpu = std::chrono::high_resolution_clock::now();
+		secs = t1_cpu - t0_cpu;
+		durations[1][3] = secs;
+		if(!columnOutput) std::cout << "\t" << secs.count() << " " << (int)((secs.count() / durations[1][0].count()) * 100) << "%";
+		if(checkResult) CheckResult(data, result0, result1, result2, result3);
+		if(clearResult) ClearResult(result0, result1, result2, result3);
+
+		t0_cpu = std::chrono::high_resolution_clock::now();
+		for(int j = 0; j < N; j++)
+		{
+			performanceTestInterface->FillVectorWithSpanConstruct(Marshal::Span<double>(&data[M*(4*j+0)], M), result0);
+			performanceTestInterface->FillVectorWithSpanConstruct(Marshal::Span<double>(&data[M*(4*j+1)], M), result1);
+			performanceTestInterface->FillVectorWithSpanConstruct(Marshal::Span<double>(&data[M*(4*j+2)], M), result2);
+			performanceTestInterface->FillVectorWithSpanConstruct(Marshal::Span<double>(&data[M*(4*j+3)], M), result3);
+		}
+		t1_cpu = std::chrono::high_resolution_clock::now();
+		secs = t1_cpu - t0_cpu;
+		durations[2][3] = secs;
+		if(!columnOutput) std::cout << "\t" << secs.count() << " " << (int)((secs.count() / durations[2][0].count()) * 100) << "%";
+		if(checkResult) CheckResult(data, result0, result1, result2, result3);
+		if(clearResult) ClearResult(result0, result1, result2, result3);
+
+		t0_cpu = std::chrono::high_resolution_clock::now();
+		for(int j = 0; j < N; j++)
+		{
+			performanceTestInterface->FillVectorWithSpanAssign(Marshal::Span<double>(&data[M*(4*j+0)], M), result0);
+			performanceTestInterface->FillVectorWithSpanAssign(Marshal::Span<double>(&data[M*(4*j+1)], M), result1);
+			performanceTestInterface->FillVectorWithSpanAssign(Marshal::Span<double>(&data[M*(4*j+2)], M), result2);
+			performanceTestInterface->FillVectorWithSpanAssign(Marshal::Span<double>(&data[M*(4*j+3)], M), result3);
+		}
+		t1_cpu = std::chrono::high_resolution_clock::now();
+		secs = t1_cpu - t0_cpu;
+		durations[3][3] = secs;
+		if(!columnOutput) std::cout << "\t" << secs.count() << " " << (int)((secs.count() / durations[3][0].count()) * 100) << "%";
+		if(checkResult) CheckResult(data, result0, result1, result2, result3);
+		if(clearResult) ClearResult(result0, result1, result2, result3);
+
 		if(columnOutput)
 		{
-			std::cout << durations[0][0].count() << "\t" << durations[0][1].count() << "\t" << durations[0][2].count() << "\t"
-			          << durations[1][0].count() << "\t" << durations[1][1].count() << "\t" << durations[1][2].count() << "\t"
-			          << durations[2][0].count() << "\t" << durations[2][1].count() << "\t" << durations[2][2].count() << "\t"
-			          << durations[3][0].count() << "\t" << durations[3][1].count() << "\t" << durations[3][2].count() << "\n";
+			std::cout << durations[0][0].count() << "\t" << durations[0][1].count() << "\t" << durations[0][2].count() << "\t" << durations[0][3].count() << "\t"
+			          << durations[1][0].count() << "\t" << durations[1][1].count() << "\t" << durations[1][2].count() << "\t" << durations[1][3].count() << "\t"
+			          << durations[2][0].count() << "\t" << durations[2][1].count() << "\t" << durations[2][2].count() << "\t" << durations[2][3].count() << "\t"
+			          << durations[3][0].count() << "\t" << durations[3][1].count() << "\t" << durations[3][2].count() << "\t" << durations[3][3].count() << "\n";
 		}
 		else
 		{
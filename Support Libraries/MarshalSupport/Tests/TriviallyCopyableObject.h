@@ -0,0 +1,27 @@
+#ifndef __TRIVIALLYCOPYABLEOBJECT_H__
+#define __TRIVIALLYCOPYABLEOBJECT_H__
+
+// This type supplies its own constructors, so it isn't a trivial type, but it is trivially copyable, which allows
+// containers of this type to be marshalled using a direct memory copy.
+class TriviallyCopyableObject
+{
+public:
+	TriviallyCopyableObject()
+	:data1(-1), data2(-1), data3(0.0)
+	{ }
+	TriviallyCopyableObject(int someData)
+	:data1(someData), data2((short)(someData * 2)), data3(someData * 0.5)
+	{ }
+
+	bool operator==(const TriviallyCopyableObject& target) const
+	{
+		return (data1 == target.data1) && (data2 == target.data2) && (data3 == target.data3);
+	}
+
+private:
+	int data1;
+	short data2;
+	double data3;
+};
+
+#endif
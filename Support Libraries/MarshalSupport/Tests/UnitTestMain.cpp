@@ -132,6 +132,23 @@ TEST_CASE("Composite types", "")
 #endif
 }
 
+TEST_CASE("Bulk copy types", "")
+{
+	Catch::IContext& catchContext = Catch::getCurrentContext();
+	ResultCaptureWrapper captureWrapper(catchContext.getResultCapture());
+	ConfigureCatchTestFramework(&captureWrapper, catchContext.getRunner(), catchContext.getConfig());
+
+	MarshalTest marshalTest;
+	SECTION("Marshal::Span", "")
+	{
+		REQUIRE(MarshalTestSpan(marshalTest));
+	}
+	SECTION("Trivially copyable types", "")
+	{
+		REQUIRE(MarshalTestTriviallyCopyable(marshalTest));
+	}
+}
+
 #ifdef MARSHALSUPPORT_CPP11SUPPORTED
 TEST_CASE("STL pointer types", "")
 {
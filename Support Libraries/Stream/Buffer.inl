@@ -146,9 +146,10 @@ bool Buffer::ReadBinary(unsigned char* rawData, SizeType bytesToRead)
 	}
 
 	// Read the data from the buffer
-	for (SizeType i = 0; i < bytesToRead; ++i)
+	if (bytesToRead > 0)
 	{
-		*(rawData + i) = _buffer[(size_t)_streamPos++];
+		memcpy((void*)rawData, (const void*)&_buffer[(size_t)_streamPos], (size_t)bytesToRead);
+		_streamPos += bytesToRead;
 	}
 	return true;
 }
@@ -163,9 +164,10 @@ bool Buffer::WriteBinary(const unsigned char* rawData, SizeType bytesToWrite)
 	}
 
 	// Write the data to the buffer
-	for (SizeType i = 0; i < bytesToWrite; ++i)
+	if (bytesToWrite > 0)
 	{
-		_buffer[(size_t)_streamPos++] = *(rawData + i);
+		memcpy((void*)&_buffer[(size_t)_streamPos], (const void*)rawData, (size_t)bytesToWrite);
+		_streamPos += bytesToWrite;
 	}
 	return true;
 }
@@ -13,6 +13,11 @@ public:
 	enum class OpenMode;
 	enum class CreateMode;
 
+	// Constants
+	// The default buffer size is large enough to cover typical savestate and ROM image
+	// reads in a small number of operating system calls.
+	static const SizeType DefaultBufferSize = 0x10000;
+
 	// Make sure the File object is non-copyable
 	protected: File(const File& object) { } public:
 
@@ -24,7 +29,7 @@ public:
 	virtual ~File();
 
 	// File binding
-	inline bool Open(const std::wstring& filename, OpenMode openMode, CreateMode createMode, SizeType bufferSize = 8192);
+	inline bool Open(const std::wstring& filename, OpenMode openMode, CreateMode createMode, SizeType bufferSize = DefaultBufferSize);
 	inline void Close();
 	inline bool IsOpen() const;
 
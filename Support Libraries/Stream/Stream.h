@@ -2,8 +2,13 @@
 Things to do:
 -Apparently, wchar_t is 32-bit (UTF32 encoding) on unix. Make this library fully portable,
 so that it can work regardless of the particular encoding wchar_t uses.
+-There's no span style bulk API yet. Bulk reads and writes currently go through the
+pointer and length array overloads of ReadData and WriteData, or the std::vector
+overloads. Add span style overloads to IStream when we're able to move to a language
+standard which provides std::span, so that the interface doesn't need its own span type.
 \*--------------------------------------------------------------------------------------------------------------------*/
 #include "StreamInterface/StreamInterface.pkg"
+#include <cstring>
 #ifndef __STREAM_H__
 #define __STREAM_H__
 namespace Stream {
@@ -568,6 +573,19 @@ private:
 	inline static unsigned char BoolToByte(bool data);
 	inline static bool ByteToBool(unsigned char data);
 
+	// Byte order inversion functions
+	// These functions reverse the byte order of each element in a block of data in a single
+	// pass. The source and target may refer to the same memory. Fixed width kernels are
+	// used for 2, 4, and 8 byte types, which compilers are able to vectorize. Note that the
+	// kernels work on the raw bytes of each element, and move each element in and out of
+	// an integer with memcpy, so that types such as float and double are never accessed
+	// through an integer pointer.
+	template<class T>
+	inline static void InvertByteOrder(const T* source, T* target, typename B::SizeType length);
+	inline static void InvertByteOrderKernel16(const unsigned char* source, unsigned char* target, size_t length);
+	inline static void InvertByteOrderKernel32(const unsigned char* source, unsigned char* target, size_t length);
+	inline static void InvertByteOrderKernel64(const unsigned char* source, unsigned char* target, size_t length);
+
 private:
 	typename B::ByteOrder _byteOrder;
 	typename B::TextEncoding _textEncoding;
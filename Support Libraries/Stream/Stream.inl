@@ -729,13 +729,7 @@ bool Stream<B>::ReadBinaryInvertedByteOrder(T& data)
 	}
 
 	// Invert the byte order
-	unsigned char* binaryData = (unsigned char*)&data;
-	unsigned char* binaryTemp = (unsigned char*)&temp;
-	for (unsigned int i = 0; i < sizeof(data); ++i)
-	{
-		*(binaryData + i) = *(binaryTemp + ((sizeof(data) - 1) - i));
-	}
-
+	InvertByteOrder(&temp, &data, 1);
 	return true;
 }
 
@@ -743,27 +737,15 @@ bool Stream<B>::ReadBinaryInvertedByteOrder(T& data)
 template<class B> template<class T>
 bool Stream<B>::ReadBinaryInvertedByteOrder(T* data, typename B::SizeType length)
 {
-	// Read the data in the native byte order
-	T* temp = new T[(size_t)length];
-	if (!ReadBinaryNativeByteOrder(temp, length))
+	// Read the data in the native byte order directly into the target buffer as a single
+	// block
+	if (!ReadBinaryNativeByteOrder(data, length))
 	{
-		delete[] temp;
 		return false;
 	}
 
-	// Invert the byte order
-	unsigned int dataTypeSize = sizeof(*data);
-	for (unsigned int entry = 0; entry < length; ++entry)
-	{
-		unsigned char* binaryData = (unsigned char*)&data[entry];
-		unsigned char* binaryTemp = (unsigned char*)&temp[entry];
-		for (unsigned int i = 0; i < dataTypeSize; ++i)
-		{
-			*(binaryData + i) = *(binaryTemp + ((dataTypeSize - 1) - i));
-		}
-	}
-
-	delete[] temp;
+	// Invert the byte order in place
+	InvertByteOrder(data, data, length);
 	return true;
 }
 
@@ -1705,12 +1687,7 @@ bool Stream<B>::WriteBinaryInvertedByteOrder(T data)
 {
 	// Invert the byte order
 	T temp;
-	unsigned char* binaryData = (unsigned char*)&data;
-	unsigned char* binaryTemp = (unsigned char*)&temp;
-	for (unsigned int i = 0; i < sizeof(data); ++i)
-	{
-		*(binaryTemp + i) = *(binaryData + ((sizeof(data) - 1) - i));
-	}
+	InvertByteOrder(&data, &temp, 1);
 
 	// Write the data in the native byte order
 	return WriteBinaryNativeByteOrder(temp);
@@ -1720,22 +1697,24 @@ bool Stream<B>::WriteBinaryInvertedByteOrder(T data)
 template<class B> template<class T>
 bool Stream<B>::WriteBinaryInvertedByteOrder(const T* data, typename B::SizeType length)
 {
-	// Invert the byte order
-	T* temp = new T[(size_t)length];
-
-	unsigned int dataTypeSize = sizeof(*data);
-	for (unsigned int entry = 0; entry < length; ++entry)
+	// Since we can't modify the source data, we convert it in fixed size blocks through a
+	// temporary buffer on the stack, and write each converted block in the native byte
+	// order. This avoids allocating a copy of the entire array on the heap for large
+	// writes, while still passing the data to the underlying stream in bulk.
+	const size_t chunkLength = ((4096 / sizeof(T)) > 0)? (4096 / sizeof(T)): 1;
+	T temp[chunkLength];
+	typename B::SizeType entriesWritten = 0;
+	while (entriesWritten < length)
 	{
-		const unsigned char* binaryData = (const unsigned char*)&data[entry];
-		unsigned char* binaryTemp = (unsigned char*)&temp[entry];
-		for (unsigned int i = 0; i < dataTypeSize; ++i)
+		typename B::SizeType entriesInChunk = ((length - entriesWritten) < (typename B::SizeType)chunkLength)? (length - entriesWritten): (typename B::SizeType)chunkLength;
+		InvertByteOrder(data + entriesWritten, &temp[0], entriesInChunk);
+		if (!WriteBinaryNativeByteOrder(&temp[0], entriesInChunk))
 		{
-			*(binaryTemp + i) = *(binaryData + ((dataTypeSize - 1) - i));
+			return false;
 		}
+		entriesWritten += entriesInChunk;
 	}
-
-	// Write the data in the native byte order
-	return WriteBinaryNativeByteOrder(temp, length);
+	return true;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1754,6 +1733,94 @@ bool Stream<B>::ByteToBool(unsigned char data)
 	return (data != 0);
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Byte order inversion functions
+//----------------------------------------------------------------------------------------------------------------------
+template<class B> template<class T>
+void Stream<B>::InvertByteOrder(const T* source, T* target, typename B::SizeType length)
+{
+	// Dispatch to a fixed width kernel based on the size of the data type. Since the size
+	// is known at compile time, the compiler will discard all but one of these branches.
+	// Note that accessing the data through unsigned char pointers is always permitted,
+	// regardless of the actual data type.
+	size_t elementCount = (size_t)length;
+	const unsigned char* sourceBytes = (const unsigned char*)source;
+	unsigned char* targetBytes = (unsigned char*)target;
+	switch (sizeof(T))
+	{
+	case 1:
+		if (source != target)
+		{
+			memmove((void*)targetBytes, (const void*)sourceBytes, elementCount);
+		}
+		return;
+	case 2:
+		InvertByteOrderKernel16(sourceBytes, targetBytes, elementCount);
+		return;
+	case 4:
+		InvertByteOrderKernel32(sourceBytes, targetBytes, elementCount);
+		return;
+	case 8:
+		InvertByteOrderKernel64(sourceBytes, targetBytes, elementCount);
+		return;
+	}
+
+	// For any other data type size, fall back to swapping the bytes of each element
+	// individually. We read the entire element into a temporary before writing any bytes,
+	// so that this is safe to perform in place.
+	for (size_t entry = 0; entry < elementCount; ++entry)
+	{
+		unsigned char temp[sizeof(T)];
+		memcpy((void*)&temp[0], (const void*)(sourceBytes + (entry * sizeof(T))), sizeof(T));
+		unsigned char* binaryTarget = targetBytes + (entry * sizeof(T));
+		for (size_t i = 0; i < sizeof(T); ++i)
+		{
+			*(binaryTarget + i) = temp[(sizeof(T) - 1) - i];
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class B>
+void Stream<B>::InvertByteOrderKernel16(const unsigned char* source, unsigned char* target, size_t length)
+{
+	for (size_t i = 0; i < length; ++i)
+	{
+		unsigned short value;
+		memcpy((void*)&value, (const void*)(source + (i * sizeof(value))), sizeof(value));
+		value = (unsigned short)((value >> 8) | (value << 8));
+		memcpy((void*)(target + (i * sizeof(value))), (const void*)&value, sizeof(value));
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class B>
+void Stream<B>::InvertByteOrderKernel32(const unsigned char* source, unsigned char* target, size_t length)
+{
+	for (size_t i = 0; i < length; ++i)
+	{
+		unsigned int value;
+		memcpy((void*)&value, (const void*)(source + (i * sizeof(value))), sizeof(value));
+		value = ((value >> 24) & 0x000000FFu) | ((value >> 8) & 0x0000FF00u) | ((value << 8) & 0x00FF0000u) | ((value << 24) & 0xFF000000u);
+		memcpy((void*)(target + (i * sizeof(value))), (const void*)&value, sizeof(value));
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class B>
+void Stream<B>::InvertByteOrderKernel64(const unsigned char* source, unsigned char* target, size_t length)
+{
+	for (size_t i = 0; i < length; ++i)
+	{
+		unsigned long long value;
+		memcpy((void*)&value, (const void*)(source + (i * sizeof(value))), sizeof(value));
+		value = ((value >> 8) & 0x00FF00FF00FF00FFull) | ((value << 8) & 0xFF00FF00FF00FF00ull);
+		value = ((value >> 16) & 0x0000FFFF0000FFFFull) | ((value << 16) & 0xFFFF0000FFFF0000ull);
+		value = (value >> 32) | (value << 32);
+		memcpy((void*)(target + (i * sizeof(value))), (const void*)&value, sizeof(value));
+	}
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Explicit template instantiation declarations
 //----------------------------------------------------------------------------------------------------------------------
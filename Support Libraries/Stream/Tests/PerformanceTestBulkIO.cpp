@@ -0,0 +1,224 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <cstdio>
+#include "Stream/Stream.pkg"
+
+const unsigned int ElementCount = 1024 * 1024;
+const unsigned int Iterations = 64;
+const unsigned int FileIterations = 8;
+
+// Reference implementations of the array read and write operations, which transfer each
+// element individually. These are used as a baseline for the timing tests.
+template<class T>
+bool ReferenceWriteArray(Stream::IStream& stream, Stream::IStream::ByteOrder byteOrder, const std::vector<T>& data)
+{
+	for (size_t i = 0; i < data.size(); ++i)
+	{
+		if (!stream.WriteData(byteOrder, data[i]))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+template<class T>
+bool ReferenceReadArray(Stream::IStream& stream, Stream::IStream::ByteOrder byteOrder, std::vector<T>& data)
+{
+	for (size_t i = 0; i < data.size(); ++i)
+	{
+		if (!stream.ReadData(byteOrder, data[i]))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+template<class T>
+bool CompareArrays(const std::vector<T>& first, const std::vector<T>& second)
+{
+	// Note that we compare the raw bytes of each element, so that float and double values
+	// are compared exactly, and any NaN values in the test data compare equal to
+	// themselves.
+	return (first.size() == second.size()) && (memcmp(&first[0], &second[0], first.size() * sizeof(T)) == 0);
+}
+
+template<class T>
+void FillTestData(std::vector<T>& data, size_t elementCount = ElementCount)
+{
+	// Fill the array with a byte pattern which differs within each element, so that an
+	// incorrect byte order inversion is always detected.
+	data.resize(elementCount);
+	unsigned char* dataBytes = (unsigned char*)&data[0];
+	for (size_t i = 0; i < (data.size() * sizeof(T)); ++i)
+	{
+		dataBytes[i] = (unsigned char)((i * 7) + (i / sizeof(T)));
+	}
+}
+
+double CalculateMegabytesPerSecond(size_t byteCount, std::chrono::duration<double> elapsedTime, unsigned int iterations = Iterations)
+{
+	return ((double)byteCount * (double)iterations) / (elapsedTime.count() * 1024.0 * 1024.0);
+}
+
+template<class T>
+bool RunTest(const char* typeName, Stream::IStream::ByteOrder byteOrder, const char* byteOrderName)
+{
+	std::vector<T> sourceData;
+	FillTestData(sourceData);
+	std::vector<T> referenceResult(sourceData.size());
+	std::vector<T> bulkResult(sourceData.size());
+	size_t byteCount = sourceData.size() * sizeof(T);
+	Stream::Buffer referenceBuffer((Stream::IStream::SizeType)byteCount);
+	Stream::Buffer bulkBuffer((Stream::IStream::SizeType)byteCount);
+
+	// Time the reference element by element transfers
+	auto referenceWriteStart = std::chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < Iterations; ++i)
+	{
+		referenceBuffer.SetStreamPos(0);
+		ReferenceWriteArray(referenceBuffer, byteOrder, sourceData);
+	}
+	auto referenceReadStart = std::chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < Iterations; ++i)
+	{
+		referenceBuffer.SetStreamPos(0);
+		ReferenceReadArray(referenceBuffer, byteOrder, referenceResult);
+	}
+	auto referenceEnd = std::chrono::high_resolution_clock::now();
+
+	// Time the bulk array transfers
+	auto bulkWriteStart = std::chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < Iterations; ++i)
+	{
+		bulkBuffer.SetStreamPos(0);
+		bulkBuffer.WriteData(byteOrder, &sourceData[0], (Stream::IStream::SizeType)sourceData.size());
+	}
+	auto bulkReadStart = std::chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < Iterations; ++i)
+	{
+		bulkBuffer.SetStreamPos(0);
+		bulkBuffer.ReadData(byteOrder, &bulkResult[0], (Stream::IStream::SizeType)bulkResult.size());
+	}
+	auto bulkEnd = std::chrono::high_resolution_clock::now();
+
+	// Verify that both paths produced the same stream contents, and read back the original
+	// data.
+	bool resultsMatch = (memcmp(referenceBuffer.GetRawBuffer(), bulkBuffer.GetRawBuffer(), byteCount) == 0) && CompareArrays(sourceData, referenceResult) && CompareArrays(sourceData, bulkResult);
+
+	std::cout << typeName << '\t' << byteOrderName << '\t';
+	std::cout << CalculateMegabytesPerSecond(byteCount, referenceReadStart - referenceWriteStart) << '\t' << CalculateMegabytesPerSecond(byteCount, bulkReadStart - bulkWriteStart) << '\t';
+	std::cout << CalculateMegabytesPerSecond(byteCount, referenceEnd - referenceReadStart) << '\t' << CalculateMegabytesPerSecond(byteCount, bulkEnd - bulkReadStart) << '\t';
+	std::cout << (resultsMatch? "OK": "MISMATCH") << std::endl;
+	return resultsMatch;
+}
+
+template<class T>
+bool RunFileTest(const char* sizeName, const char* typeName, size_t byteCount, Stream::IStream::ByteOrder byteOrder, const char* byteOrderName, Stream::IStream::SizeType bufferSize)
+{
+	// Open a pair of scratch files to run the transfers through. Unlike the buffer tests,
+	// these go through the read and write buffering in Stream::File, and the operating
+	// system file cache, which is the path taken when savestates and ROM images are loaded
+	// and saved.
+	const std::wstring referenceFileName = L"PerformanceTestBulkIO_Reference.bin";
+	const std::wstring bulkFileName = L"PerformanceTestBulkIO_Bulk.bin";
+	std::vector<T> sourceData;
+	FillTestData(sourceData, byteCount / sizeof(T));
+	std::vector<T> referenceResult(sourceData.size());
+	std::vector<T> bulkResult(sourceData.size());
+	Stream::File referenceFile;
+	Stream::File bulkFile;
+	if (!referenceFile.Open(referenceFileName, Stream::File::OpenMode::ReadAndWrite, Stream::File::CreateMode::Create, bufferSize) || !bulkFile.Open(bulkFileName, Stream::File::OpenMode::ReadAndWrite, Stream::File::CreateMode::Create, bufferSize))
+	{
+		std::cout << sizeName << '\t' << typeName << '\t' << byteOrderName << '\t' << bufferSize << "\tFailed to create scratch files" << std::endl;
+		return false;
+	}
+
+	// Time the reference element by element transfers
+	auto referenceWriteStart = std::chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < FileIterations; ++i)
+	{
+		referenceFile.SetStreamPos(0);
+		ReferenceWriteArray(referenceFile, byteOrder, sourceData);
+	}
+	auto referenceReadStart = std::chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < FileIterations; ++i)
+	{
+		referenceFile.SetStreamPos(0);
+		ReferenceReadArray(referenceFile, byteOrder, referenceResult);
+	}
+	auto referenceEnd = std::chrono::high_resolution_clock::now();
+
+	// Time the bulk array transfers
+	auto bulkWriteStart = std::chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < FileIterations; ++i)
+	{
+		bulkFile.SetStreamPos(0);
+		bulkFile.WriteData(byteOrder, &sourceData[0], (Stream::IStream::SizeType)sourceData.size());
+	}
+	auto bulkReadStart = std::chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < FileIterations; ++i)
+	{
+		bulkFile.SetStreamPos(0);
+		bulkFile.ReadData(byteOrder, &bulkResult[0], (Stream::IStream::SizeType)bulkResult.size());
+	}
+	auto bulkEnd = std::chrono::high_resolution_clock::now();
+
+	// Verify that both paths wrote the same file contents, and read back the original
+	// data.
+	std::vector<unsigned char> referenceFileData(byteCount);
+	std::vector<unsigned char> bulkFileData(byteCount);
+	referenceFile.SetStreamPos(0);
+	bulkFile.SetStreamPos(0);
+	bool resultsMatch = referenceFile.ReadData(&referenceFileData[0], (Stream::IStream::SizeType)byteCount) && bulkFile.ReadData(&bulkFileData[0], (Stream::IStream::SizeType)byteCount);
+	resultsMatch = resultsMatch && (referenceFileData == bulkFileData) && CompareArrays(sourceData, referenceResult) && CompareArrays(sourceData, bulkResult);
+	referenceFile.Close();
+	bulkFile.Close();
+	_wremove(referenceFileName.c_str());
+	_wremove(bulkFileName.c_str());
+
+	std::cout << sizeName << '\t' << typeName << '\t' << byteOrderName << '\t' << bufferSize << '\t';
+	std::cout << CalculateMegabytesPerSecond(byteCount, referenceReadStart - referenceWriteStart, FileIterations) << '\t' << CalculateMegabytesPerSecond(byteCount, bulkReadStart - bulkWriteStart, FileIterations) << '\t';
+	std::cout << CalculateMegabytesPerSecond(byteCount, referenceEnd - referenceReadStart, FileIterations) << '\t' << CalculateMegabytesPerSecond(byteCount, bulkEnd - bulkReadStart, FileIterations) << '\t';
+	std::cout << (resultsMatch? "OK": "MISMATCH") << std::endl;
+	return resultsMatch;
+}
+
+int main()
+{
+	std::cout << "Stream bulk array read and write performance test (MB/s)" << std::endl;
+	std::cout << "Type\tOrder\tWrite (element)\tWrite (bulk)\tRead (element)\tRead (bulk)\tResult" << std::endl;
+	std::cout << std::fixed << std::setprecision(2);
+
+	bool result = true;
+	Stream::IStream::ByteOrder byteOrders[] = {Stream::IStream::ByteOrder::LittleEndian, Stream::IStream::ByteOrder::BigEndian};
+	const char* byteOrderNames[] = {"Little", "Big"};
+	for (unsigned int i = 0; i < (sizeof(byteOrders) / sizeof(byteOrders[0])); ++i)
+	{
+		result &= RunTest<unsigned short>("u16", byteOrders[i], byteOrderNames[i]);
+		result &= RunTest<unsigned int>("u32", byteOrders[i], byteOrderNames[i]);
+		result &= RunTest<unsigned long long>("u64", byteOrders[i], byteOrderNames[i]);
+		result &= RunTest<float>("float", byteOrders[i], byteOrderNames[i]);
+		result &= RunTest<double>("double", byteOrders[i], byteOrderNames[i]);
+	}
+
+	// Run the same comparison through Stream::File, at the sizes of typical data loaded
+	// and saved by the emulator. Cartridge ROM images are stored as big endian 16-bit
+	// words, while the bulk of a savestate is made up of memory and timed buffer dumps,
+	// which we represent here with 8-bit and 32-bit little endian data. Each size is run
+	// with the previous 8KB file buffer and the current default buffer size.
+	std::cout << std::endl;
+	std::cout << "Stream::File bulk array read and write performance test (MB/s)" << std::endl;
+	std::cout << "Size\tType\tOrder\tBuffer\tWrite (element)\tWrite (bulk)\tRead (element)\tRead (bulk)\tResult" << std::endl;
+	Stream::IStream::SizeType bufferSizes[] = {0x2000, Stream::File::DefaultBufferSize};
+	for (unsigned int i = 0; i < (sizeof(bufferSizes) / sizeof(bufferSizes[0])); ++i)
+	{
+		result &= RunFileTest<unsigned char>("256KB", "u8", 256 * 1024, Stream::IStream::ByteOrder::LittleEndian, "Little", bufferSizes[i]);
+		result &= RunFileTest<unsigned int>("1MB", "u32", 1024 * 1024, Stream::IStream::ByteOrder::LittleEndian, "Little", bufferSizes[i]);
+		result &= RunFileTest<unsigned short>("4MB", "u16", 4 * 1024 * 1024, Stream::IStream::ByteOrder::BigEndian, "Big", bufferSizes[i]);
+	}
+	return result? 0: 1;
+}
@@ -0,0 +1,337 @@
+#include "VGMFile.h"
+#include "File.h"
+namespace Stream {
+
+//----------------------------------------------------------------------------------------------------------------------
+// Register write functions
+//----------------------------------------------------------------------------------------------------------------------
+void VGMFile::AddRegisterWrite(Command command, unsigned int address, unsigned int data, unsigned long long sampleNo)
+{
+	// Encode any wait required to bring the log up to the target sample, then encode the
+	// register write itself.
+	AdvanceToSample(sampleNo);
+	switch (command)
+	{
+	case Command::SN76489Write:
+		_commandData.push_back(0x50);
+		_commandData.push_back((unsigned char)(data & 0xFF));
+		break;
+	case Command::YM2612Port0Write:
+		_commandData.push_back(0x52);
+		_commandData.push_back((unsigned char)(address & 0xFF));
+		_commandData.push_back((unsigned char)(data & 0xFF));
+		break;
+	case Command::YM2612Port1Write:
+		_commandData.push_back(0x53);
+		_commandData.push_back((unsigned char)(address & 0xFF));
+		_commandData.push_back((unsigned char)(data & 0xFF));
+		break;
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void VGMFile::AdvanceToSample(unsigned long long sampleNo)
+{
+	// Writes can never be placed before a wait that has already been encoded, so a target
+	// sample earlier than the current end of the log is clamped to the current position.
+	if (sampleNo <= _totalSampleCount)
+	{
+		return;
+	}
+	unsigned long long remainingSamples = sampleNo - _totalSampleCount;
+	_totalSampleCount = sampleNo;
+	while (remainingSamples > 0)
+	{
+		if (remainingSamples <= 16)
+		{
+			_commandData.push_back((unsigned char)(0x70 | (unsigned char)(remainingSamples - 1)));
+			remainingSamples = 0;
+		}
+		else if (remainingSamples == 735)
+		{
+			_commandData.push_back(0x62);
+			remainingSamples = 0;
+		}
+		else if (remainingSamples == 882)
+		{
+			_commandData.push_back(0x63);
+			remainingSamples = 0;
+		}
+		else
+		{
+			unsigned int waitSamples = (remainingSamples > 0xFFFF)? 0xFFFF: (unsigned int)remainingSamples;
+			_commandData.push_back(0x61);
+			_commandData.push_back((unsigned char)(waitSamples & 0xFF));
+			_commandData.push_back((unsigned char)((waitSamples >> 8) & 0xFF));
+			remainingSamples -= waitSamples;
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool VGMFile::DecodeRegisterWrites(std::vector<RegisterWrite>& registerWrites) const
+{
+	// Decode the command stream into a list of register writes for the chips we support.
+	// Commands for other chips are skipped based on their operand size. YM2612 PCM data
+	// blocks are retained so that the compressed DAC write commands can be expanded into
+	// plain register writes.
+	registerWrites.clear();
+	std::vector<unsigned char> pcmData;
+	size_t pcmDataOffset = 0;
+	unsigned long long sampleNo = 0;
+	size_t commandDataSize = _commandData.size();
+	size_t offset = 0;
+	while (offset < commandDataSize)
+	{
+		unsigned char commandByte = _commandData[offset++];
+		size_t operandSize = 0;
+		if (commandByte == 0x50)
+		{
+			operandSize = 1;
+			if ((offset + operandSize) > commandDataSize)
+			{
+				return false;
+			}
+			RegisterWrite registerWrite = {sampleNo, Command::SN76489Write, 0, _commandData[offset]};
+			registerWrites.push_back(registerWrite);
+		}
+		else if ((commandByte == 0x52) || (commandByte == 0x53))
+		{
+			operandSize = 2;
+			if ((offset + operandSize) > commandDataSize)
+			{
+				return false;
+			}
+			RegisterWrite registerWrite = {sampleNo, (commandByte == 0x52)? Command::YM2612Port0Write: Command::YM2612Port1Write, _commandData[offset], _commandData[offset + 1]};
+			registerWrites.push_back(registerWrite);
+		}
+		else if (commandByte == 0x61)
+		{
+			operandSize = 2;
+			if ((offset + operandSize) > commandDataSize)
+			{
+				return false;
+			}
+			sampleNo += ReadLittleEndian(_commandData, offset, 2);
+		}
+		else if (commandByte == 0x62)
+		{
+			sampleNo += 735;
+		}
+		else if (commandByte == 0x63)
+		{
+			sampleNo += 882;
+		}
+		else if (commandByte == 0x66)
+		{
+			break;
+		}
+		else if (commandByte == 0x67)
+		{
+			// Data block. Only uncompressed YM2612 PCM data is retained.
+			operandSize = 6;
+			if ((offset + operandSize) > commandDataSize)
+			{
+				return false;
+			}
+			unsigned int dataType = _commandData[offset + 1];
+			size_t dataSize = ReadLittleEndian(_commandData, offset + 2, 4) & 0x7FFFFFFF;
+			if ((offset + operandSize + dataSize) > commandDataSize)
+			{
+				return false;
+			}
+			if (dataType == 0x00)
+			{
+				pcmData.insert(pcmData.end(), _commandData.begin() + (offset + operandSize), _commandData.begin() + (offset + operandSize + dataSize));
+			}
+			operandSize += dataSize;
+		}
+		else if ((commandByte & 0xF0) == 0x70)
+		{
+			sampleNo += (unsigned long long)(commandByte & 0x0F) + 1;
+		}
+		else if ((commandByte & 0xF0) == 0x80)
+		{
+			unsigned int data = (pcmDataOffset < pcmData.size())? pcmData[pcmDataOffset]: 0;
+			++pcmDataOffset;
+			RegisterWrite registerWrite = {sampleNo, Command::YM2612Port0Write, 0x2A, data};
+			registerWrites.push_back(registerWrite);
+			sampleNo += (unsigned long long)(commandByte & 0x0F);
+		}
+		else if (commandByte == 0xE0)
+		{
+			operandSize = 4;
+			if ((offset + operandSize) > commandDataSize)
+			{
+				return false;
+			}
+			pcmDataOffset = ReadLittleEndian(_commandData, offset, 4);
+		}
+		else if ((commandByte >= 0x30) && (commandByte <= 0x3F))
+		{
+			operandSize = 1;
+		}
+		else if ((commandByte >= 0x40) && (commandByte <= 0x4E))
+		{
+			operandSize = 2;
+		}
+		else if (commandByte == 0x4F)
+		{
+			operandSize = 1;
+		}
+		else if ((commandByte >= 0x51) && (commandByte <= 0x5F))
+		{
+			operandSize = 2;
+		}
+		else if (commandByte == 0x68)
+		{
+			operandSize = 11;
+		}
+		else if ((commandByte == 0x90) || (commandByte == 0x91) || (commandByte == 0x95))
+		{
+			operandSize = 4;
+		}
+		else if (commandByte == 0x92)
+		{
+			operandSize = 5;
+		}
+		else if (commandByte == 0x93)
+		{
+			operandSize = 10;
+		}
+		else if (commandByte == 0x94)
+		{
+			operandSize = 1;
+		}
+		else if ((commandByte >= 0xA0) && (commandByte <= 0xBF))
+		{
+			operandSize = 2;
+		}
+		else if ((commandByte >= 0xC0) && (commandByte <= 0xDF))
+		{
+			operandSize = 3;
+		}
+		else if (commandByte >= 0xE1)
+		{
+			operandSize = 4;
+		}
+		else
+		{
+			// Unknown command bytes in the reserved ranges have no defined size, so we can't
+			// safely continue decoding past them.
+			return false;
+		}
+		offset += operandSize;
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// File functions
+//----------------------------------------------------------------------------------------------------------------------
+bool VGMFile::Load(const std::wstring& filename)
+{
+	// Read the entire file into memory
+	File file;
+	if (!file.Open(filename, File::OpenMode::ReadOnly, File::CreateMode::Open))
+	{
+		return false;
+	}
+	File::SizeType fileSize = file.Size();
+	if (fileSize < HeaderSize)
+	{
+		return false;
+	}
+	std::vector<unsigned char> fileData((size_t)fileSize);
+	if (!file.ReadData(&fileData[0], fileSize))
+	{
+		return false;
+	}
+	file.Close();
+
+	// Validate the file identifier
+	if ((fileData[0] != 'V') || (fileData[1] != 'g') || (fileData[2] != 'm') || (fileData[3] != ' '))
+	{
+		return false;
+	}
+
+	// Decode the header fields we use. The YM2612 clock was only given its own field in
+	// version 1.10, with earlier files sharing the YM2413 clock field for all FM chips. The
+	// data offset field was added in version 1.50, with data following a fixed size header
+	// in earlier versions.
+	unsigned int version = ReadLittleEndian(fileData, 0x08, 4);
+	_sn76489ClockRate = ReadLittleEndian(fileData, 0x0C, 4) & 0x3FFFFFFF;
+	_ym2612ClockRate = ReadLittleEndian(fileData, (version >= 0x110)? 0x2C: 0x10, 4) & 0x3FFFFFFF;
+	_sn76489NoiseFeedback = (version >= 0x110)? ReadLittleEndian(fileData, 0x28, 2): 0;
+	_sn76489ShiftRegisterWidth = (version >= 0x110)? ReadLittleEndian(fileData, 0x2A, 1): 0;
+	_totalSampleCount = ReadLittleEndian(fileData, 0x18, 4);
+	size_t dataOffset = HeaderSize;
+	if (version >= 0x150)
+	{
+		unsigned int relativeDataOffset = ReadLittleEndian(fileData, 0x34, 4);
+		if (relativeDataOffset != 0)
+		{
+			dataOffset = 0x34 + (size_t)relativeDataOffset;
+		}
+	}
+	size_t dataEnd = (size_t)ReadLittleEndian(fileData, 0x04, 4) + 0x04;
+	unsigned int gd3RelativeOffset = ReadLittleEndian(fileData, 0x14, 4);
+	if ((gd3RelativeOffset != 0) && (((size_t)gd3RelativeOffset + 0x14) > dataOffset) && (((size_t)gd3RelativeOffset + 0x14) < dataEnd))
+	{
+		dataEnd = (size_t)gd3RelativeOffset + 0x14;
+	}
+	if (dataEnd > fileData.size())
+	{
+		dataEnd = fileData.size();
+	}
+	if (dataOffset > dataEnd)
+	{
+		return false;
+	}
+
+	// Retain the command data
+	_commandData.assign(fileData.begin() + dataOffset, fileData.begin() + dataEnd);
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool VGMFile::Save(const std::wstring& filename) const
+{
+	// Build the version 1.50 header. Version 1.50 is the earliest version which defines all
+	// the fields we populate, so it gives the broadest compatibility with existing players.
+	std::vector<unsigned char> header(HeaderSize, 0);
+	header[0] = 'V';
+	header[1] = 'g';
+	header[2] = 'm';
+	header[3] = ' ';
+	size_t fileSize = HeaderSize + _commandData.size() + 1;
+	WriteLittleEndian(header, 0x04, (unsigned int)(fileSize - 0x04), 4);
+	WriteLittleEndian(header, 0x08, 0x150, 4);
+	WriteLittleEndian(header, 0x0C, _sn76489ClockRate, 4);
+	WriteLittleEndian(header, 0x18, (unsigned int)_totalSampleCount, 4);
+	WriteLittleEndian(header, 0x28, _sn76489NoiseFeedback, 2);
+	WriteLittleEndian(header, 0x2A, _sn76489ShiftRegisterWidth, 1);
+	WriteLittleEndian(header, 0x2C, _ym2612ClockRate, 4);
+	WriteLittleEndian(header, 0x34, HeaderSize - 0x34, 4);
+
+	// Write the header, followed by the command data and the end of data marker
+	File file;
+	if (!file.Open(filename, File::OpenMode::WriteOnly, File::CreateMode::Create))
+	{
+		return false;
+	}
+	bool result = file.WriteData(&header[0], (File::SizeType)header.size());
+	if (result && !_commandData.empty())
+	{
+		result = file.WriteData(&_commandData[0], (File::SizeType)_commandData.size());
+	}
+	if (result)
+	{
+		unsigned char endOfData = 0x66;
+		result = file.WriteData(endOfData);
+	}
+	file.Close();
+	return result;
+}
+
+} // Close namespace Stream
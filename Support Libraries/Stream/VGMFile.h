@@ -0,0 +1,73 @@
+#ifndef __VGMFILE_H__
+#define __VGMFILE_H__
+#include <string>
+#include <vector>
+namespace Stream {
+
+// The VGMFile class records and replays timestamped sound chip register writes using the
+// VGM file format. Register writes are held in memory in their encoded form as they're
+// added, so a log can be built up over a long session with little overhead, and saved once
+// capture is complete. Only the commands for the SN76489 and YM2612 are generated, but all
+// commands defined by the format are recognized when a log is decoded, so logs created by
+// other tools can also be replayed. Times are measured in samples at the fixed 44100Hz
+// rate defined by the format.
+class VGMFile
+{
+public:
+	// Enumerations
+	enum class Command;
+
+	// Structures
+	struct RegisterWrite;
+
+	// Constants
+	static const unsigned int SampleRate = 44100;
+
+public:
+	// Constructors
+	inline VGMFile();
+
+	// Chip settings
+	inline unsigned int GetSN76489ClockRate() const;
+	inline void SetSN76489ClockRate(unsigned int clockRate);
+	inline unsigned int GetSN76489NoiseFeedback() const;
+	inline void SetSN76489NoiseFeedback(unsigned int noiseFeedback);
+	inline unsigned int GetSN76489ShiftRegisterWidth() const;
+	inline void SetSN76489ShiftRegisterWidth(unsigned int shiftRegisterWidth);
+	inline unsigned int GetYM2612ClockRate() const;
+	inline void SetYM2612ClockRate(unsigned int clockRate);
+
+	// Register write functions
+	inline void Clear();
+	inline unsigned long long GetTotalSampleCount() const;
+	inline static unsigned long long ConvertTimeToSampleNo(double nanoseconds);
+	inline static double ConvertSampleNoToTime(unsigned long long sampleNo);
+	void AddRegisterWrite(Command command, unsigned int address, unsigned int data, unsigned long long sampleNo);
+	void AdvanceToSample(unsigned long long sampleNo);
+	bool DecodeRegisterWrites(std::vector<RegisterWrite>& registerWrites) const;
+
+	// File functions
+	bool Load(const std::wstring& filename);
+	bool Save(const std::wstring& filename) const;
+
+private:
+	// Constants
+	static const unsigned int HeaderSize = 0x40;
+
+private:
+	// Header encoding functions
+	inline static unsigned int ReadLittleEndian(const std::vector<unsigned char>& buffer, size_t offset, unsigned int byteCount);
+	inline static void WriteLittleEndian(std::vector<unsigned char>& buffer, size_t offset, unsigned int data, unsigned int byteCount);
+
+private:
+	unsigned int _sn76489ClockRate;
+	unsigned int _sn76489NoiseFeedback;
+	unsigned int _sn76489ShiftRegisterWidth;
+	unsigned int _ym2612ClockRate;
+	unsigned long long _totalSampleCount;
+	std::vector<unsigned char> _commandData;
+};
+
+} // Close namespace Stream
+#include "VGMFile.inl"
+#endif
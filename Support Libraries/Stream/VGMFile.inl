@@ -0,0 +1,130 @@
+namespace Stream {
+
+//----------------------------------------------------------------------------------------------------------------------
+// Enumerations
+//----------------------------------------------------------------------------------------------------------------------
+enum class VGMFile::Command
+{
+	SN76489Write,
+	YM2612Port0Write,
+	YM2612Port1Write
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Structures
+//----------------------------------------------------------------------------------------------------------------------
+struct VGMFile::RegisterWrite
+{
+	unsigned long long sampleNo;
+	Command command;
+	unsigned int address;
+	unsigned int data;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+VGMFile::VGMFile()
+:_sn76489ClockRate(0), _sn76489NoiseFeedback(0), _sn76489ShiftRegisterWidth(0), _ym2612ClockRate(0), _totalSampleCount(0)
+{ }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Chip settings
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int VGMFile::GetSN76489ClockRate() const
+{
+	return _sn76489ClockRate;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void VGMFile::SetSN76489ClockRate(unsigned int clockRate)
+{
+	_sn76489ClockRate = clockRate;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int VGMFile::GetSN76489NoiseFeedback() const
+{
+	return _sn76489NoiseFeedback;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void VGMFile::SetSN76489NoiseFeedback(unsigned int noiseFeedback)
+{
+	_sn76489NoiseFeedback = noiseFeedback;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int VGMFile::GetSN76489ShiftRegisterWidth() const
+{
+	return _sn76489ShiftRegisterWidth;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void VGMFile::SetSN76489ShiftRegisterWidth(unsigned int shiftRegisterWidth)
+{
+	_sn76489ShiftRegisterWidth = shiftRegisterWidth;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int VGMFile::GetYM2612ClockRate() const
+{
+	return _ym2612ClockRate;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void VGMFile::SetYM2612ClockRate(unsigned int clockRate)
+{
+	_ym2612ClockRate = clockRate;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Register write functions
+//----------------------------------------------------------------------------------------------------------------------
+void VGMFile::Clear()
+{
+	_totalSampleCount = 0;
+	_commandData.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned long long VGMFile::GetTotalSampleCount() const
+{
+	return _totalSampleCount;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned long long VGMFile::ConvertTimeToSampleNo(double nanoseconds)
+{
+	return (nanoseconds <= 0.0)? 0: (unsigned long long)(nanoseconds * ((double)SampleRate / 1000000000.0));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+double VGMFile::ConvertSampleNoToTime(unsigned long long sampleNo)
+{
+	return (double)sampleNo * (1000000000.0 / (double)SampleRate);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Header encoding functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int VGMFile::ReadLittleEndian(const std::vector<unsigned char>& buffer, size_t offset, unsigned int byteCount)
+{
+	unsigned int data = 0;
+	for (unsigned int i = 0; i < byteCount; ++i)
+	{
+		data |= (unsigned int)buffer[offset + i] << (i * 8);
+	}
+	return data;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void VGMFile::WriteLittleEndian(std::vector<unsigned char>& buffer, size_t offset, unsigned int data, unsigned int byteCount)
+{
+	for (unsigned int i = 0; i < byteCount; ++i)
+	{
+		buffer[offset + i] = (unsigned char)((data >> (i * 8)) & 0xFF);
+	}
+}
+
+} // Close namespace Stream
@@ -0,0 +1,158 @@
+#include "WAVFileAsyncWriter.h"
+#include <functional>
+namespace Stream {
+
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+WAVFileAsyncWriter::~WAVFileAsyncWriter()
+{
+	Close();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// File binding
+//----------------------------------------------------------------------------------------------------------------------
+bool WAVFileAsyncWriter::Open(const std::wstring& filename, unsigned int channelCount, unsigned int samplesPerSec)
+{
+	// If a file is currently open, close it.
+	if (_fileOpen)
+	{
+		Close();
+	}
+
+	// Open the target file. We size the file buffer to match our capture block size, so
+	// that each block is passed through to the file in a single operation.
+	_wavFile.SetDataFormat(channelCount, 16, samplesPerSec);
+	if (!_wavFile.Open(filename, WAVFile::OpenMode::WriteOnly, WAVFile::CreateMode::Create, (WAVFile::SizeType)(_blockSampleCount * sizeof(short))))
+	{
+		return false;
+	}
+
+	// Reset our capture state
+	_currentBlock.resize(_blockSampleCount);
+	_currentBlockPos = 0;
+	_writtenSampleCount = 0;
+	_droppedSampleCount = 0;
+	_fileOpen = true;
+
+	// Start the writer thread
+	_writerThreadActive = true;
+	_writerThread = std::thread(std::bind(std::mem_fn(&WAVFileAsyncWriter::WriterThread), this));
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void WAVFileAsyncWriter::Close()
+{
+	if (!_fileOpen)
+	{
+		return;
+	}
+
+	// Submit any partially filled block, so that all captured samples are written.
+	SubmitCurrentBlock();
+
+	// Instruct the writer thread to stop once all pending blocks have been written, and
+	// wait for it to finish.
+	{
+		std::unique_lock<std::mutex> lock(_writerMutex);
+		_writerThreadActive = false;
+		_writerThreadUpdate.notify_all();
+	}
+	_writerThread.join();
+
+	// Close the target file
+	_wavFile.Close();
+	_fileOpen = false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Capture statistics
+//----------------------------------------------------------------------------------------------------------------------
+unsigned long long WAVFileAsyncWriter::GetWrittenSampleCount() const
+{
+	std::unique_lock<std::mutex> lock(_writerMutex);
+	return _writtenSampleCount;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned long long WAVFileAsyncWriter::GetDroppedSampleCount() const
+{
+	std::unique_lock<std::mutex> lock(_writerMutex);
+	return _droppedSampleCount;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Block management functions
+//----------------------------------------------------------------------------------------------------------------------
+void WAVFileAsyncWriter::SubmitCurrentBlock()
+{
+	if (_currentBlockPos <= 0)
+	{
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(_writerMutex);
+
+	// If the writer thread has reached its limit of pending blocks, discard the current
+	// block contents and record the dropped samples. The current block is retained for
+	// reuse.
+	if (_pendingBlocks.size() >= _maxPendingBlockCount)
+	{
+		_droppedSampleCount += _currentBlockPos;
+		_currentBlockPos = 0;
+		return;
+	}
+
+	// Queue the current block for the writer thread
+	_currentBlock.resize(_currentBlockPos);
+	_pendingBlocks.push_back(std::move(_currentBlock));
+	_writerThreadUpdate.notify_all();
+
+	// Begin a new capture block, reusing a block which has already been written if one is
+	// available.
+	if (!_freeBlocks.empty())
+	{
+		_currentBlock = std::move(_freeBlocks.back());
+		_freeBlocks.pop_back();
+	}
+	else
+	{
+		_currentBlock = std::vector<short>();
+	}
+	_currentBlock.resize(_blockSampleCount);
+	_currentBlockPos = 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Writer thread functions
+//----------------------------------------------------------------------------------------------------------------------
+void WAVFileAsyncWriter::WriterThread()
+{
+	std::unique_lock<std::mutex> lock(_writerMutex);
+	while (_writerThreadActive || !_pendingBlocks.empty())
+	{
+		// If there are no blocks waiting to be written, wait for a new block to be
+		// submitted or for this thread to be instructed to stop.
+		if (_pendingBlocks.empty())
+		{
+			_writerThreadUpdate.wait(lock);
+			continue;
+		}
+
+		// Write the next pending block to the file. We release the lock while the write is
+		// in progress, so that the capture thread can continue to submit new blocks.
+		std::vector<short> block = std::move(_pendingBlocks.front());
+		_pendingBlocks.pop_front();
+		lock.unlock();
+		_wavFile.WriteData(&block[0], (WAVFile::SizeType)block.size());
+		lock.lock();
+
+		// Return the written block to the free list for reuse
+		_writtenSampleCount += block.size();
+		_freeBlocks.push_back(std::move(block));
+	}
+}
+
+} // Close namespace Stream
@@ -0,0 +1,82 @@
+#include "WAVFile.h"
+#ifndef __WAVFILEASYNCWRITER_H__
+#define __WAVFILEASYNCWRITER_H__
+#include <string>
+#include <vector>
+#include <list>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+namespace Stream {
+
+// The WAVFileAsyncWriter class allows audio samples to be captured to a WAV file without
+// performing any file operations on the calling thread. Samples are appended to an
+// in-memory block, and once a block is full it's handed off to a background writer thread
+// which flushes it to the target file. The number of blocks which may be waiting to be
+// written at any one time is bounded. If the writer thread falls so far behind that this
+// limit is reached, newly completed blocks are discarded and the number of dropped
+// samples is recorded, rather than stalling the caller or growing memory use without
+// limit. Sample capture functions must only be called from a single thread at a time, and
+// must not be called concurrently with Open or Close.
+class WAVFileAsyncWriter
+{
+public:
+	// Constants
+	static const size_t DefaultBlockSampleCount = 0x4000;
+	static const size_t DefaultMaxPendingBlockCount = 32;
+
+	// Make sure the WAVFileAsyncWriter object is non-copyable
+	protected: WAVFileAsyncWriter(const WAVFileAsyncWriter& object) { } public:
+
+	// Constructors
+	inline WAVFileAsyncWriter(size_t blockSampleCount = DefaultBlockSampleCount, size_t maxPendingBlockCount = DefaultMaxPendingBlockCount);
+	~WAVFileAsyncWriter();
+
+	// File binding
+	bool Open(const std::wstring& filename, unsigned int channelCount, unsigned int samplesPerSec);
+	void Close();
+	inline bool IsOpen() const;
+
+	// Sample capture functions
+	inline void WriteSample(short sample);
+	inline void WriteSamples(const short* samples, size_t sampleCount);
+	inline void WriteSamples(const std::vector<short>& samples);
+
+	// Capture statistics
+	unsigned long long GetWrittenSampleCount() const;
+	unsigned long long GetDroppedSampleCount() const;
+
+private:
+	// Block management functions
+	void SubmitCurrentBlock();
+
+	// Writer thread functions
+	void WriterThread();
+
+private:
+	// File handling
+	bool _fileOpen;
+	WAVFile _wavFile;
+
+	// Capture block state
+	size_t _blockSampleCount;
+	size_t _maxPendingBlockCount;
+	std::vector<short> _currentBlock;
+	size_t _currentBlockPos;
+
+	// Writer thread state
+	// Note that the writer thread is always joined by Close, which the destructor calls,
+	// so the thread can never outlive the members it uses.
+	std::thread _writerThread;
+	mutable std::mutex _writerMutex;
+	std::condition_variable _writerThreadUpdate;
+	bool _writerThreadActive;
+	std::list<std::vector<short>> _pendingBlocks;
+	std::list<std::vector<short>> _freeBlocks;
+	unsigned long long _writtenSampleCount;
+	unsigned long long _droppedSampleCount;
+};
+
+} // Close namespace Stream
+#include "WAVFileAsyncWriter.inl"
+#endif
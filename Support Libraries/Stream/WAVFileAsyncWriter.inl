@@ -0,0 +1,65 @@
+namespace Stream {
+
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+WAVFileAsyncWriter::WAVFileAsyncWriter(size_t blockSampleCount, size_t maxPendingBlockCount)
+:_fileOpen(false), _blockSampleCount((blockSampleCount > 0)? blockSampleCount: 1), _maxPendingBlockCount(maxPendingBlockCount), _currentBlockPos(0), _writerThreadActive(false), _writtenSampleCount(0), _droppedSampleCount(0)
+{ }
+
+//----------------------------------------------------------------------------------------------------------------------
+// File binding
+//----------------------------------------------------------------------------------------------------------------------
+bool WAVFileAsyncWriter::IsOpen() const
+{
+	return _fileOpen;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Sample capture functions
+//----------------------------------------------------------------------------------------------------------------------
+void WAVFileAsyncWriter::WriteSample(short sample)
+{
+	if (!_fileOpen)
+	{
+		return;
+	}
+	_currentBlock[_currentBlockPos++] = sample;
+	if (_currentBlockPos >= _blockSampleCount)
+	{
+		SubmitCurrentBlock();
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void WAVFileAsyncWriter::WriteSamples(const short* samples, size_t sampleCount)
+{
+	if (!_fileOpen)
+	{
+		return;
+	}
+	while (sampleCount > 0)
+	{
+		size_t samplesToCopy = _blockSampleCount - _currentBlockPos;
+		samplesToCopy = (sampleCount < samplesToCopy)? sampleCount: samplesToCopy;
+		memcpy((void*)&_currentBlock[_currentBlockPos], (const void*)samples, samplesToCopy * sizeof(short));
+		_currentBlockPos += samplesToCopy;
+		samples += samplesToCopy;
+		sampleCount -= samplesToCopy;
+		if (_currentBlockPos >= _blockSampleCount)
+		{
+			SubmitCurrentBlock();
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void WAVFileAsyncWriter::WriteSamples(const std::vector<short>& samples)
+{
+	if (!samples.empty())
+	{
+		WriteSamples(&samples[0], samples.size());
+	}
+}
+
+} // Close namespace Stream
@@ -1,6 +1,6 @@
 #ifndef __PERFORMANCETIMER_H__
 #define __PERFORMANCETIMER_H__
-#include "WindowsSupport/WindowsSupport.pkg"
+#include <chrono>
 
 class PerformanceTimer
 {
@@ -12,10 +12,44 @@ public:
 	inline void Reset();
 	inline void Sync(double targetExecutionTime, bool enableSync = true, bool outputTimerDebug = false, double executeAheadTolerance = 0.001);
 
+	// Statistics functions
+	inline void ResetStatistics();
+	inline unsigned int GetSyncCount() const;
+	inline double GetAverageJitterInNanoseconds() const;
+	inline double GetMaxJitterInNanoseconds() const;
+	inline double GetSleepLatencyInNanoseconds() const;
+
+private:
+	// Typedefs
+	typedef std::chrono::steady_clock Clock;
+	typedef std::chrono::duration<double, std::nano> NanosecondDuration;
+
+private:
+	// Synchronization functions
+	inline void SleepUntil(Clock::time_point targetTime);
+
 private:
-	LARGE_INTEGER _counterFrequency;
-	LARGE_INTEGER _executionTimeStart;
-	LONGLONG _executionTimeAhead;
+	// Constants
+	// The initial estimate for how late a thread wakes up after a requested sleep, before
+	// any measurements have been taken. This is deliberately pessimistic, and is refined
+	// as sleeps are measured.
+	static const long long InitialSleepLatencyInNanoseconds = 2000000;
+
+	// Sleep requests shorter than this are not worth making. Any remaining time shorter
+	// than this is carried forward to the next synchronization point instead.
+	static const long long MinimumSleepTimeInNanoseconds = 500000;
+
+private:
+	Clock::time_point _executionTimeStart;
+	double _executionTimeAhead;
+
+	// Sleep calibration
+	double _sleepLatencyInNanoseconds;
+
+	// Jitter statistics
+	unsigned int _syncCount;
+	double _totalJitterInNanoseconds;
+	double _maxJitterInNanoseconds;
 };
 
 #include "PerformanceTimer.inl"
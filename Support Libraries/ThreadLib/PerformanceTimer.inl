@@ -1,13 +1,14 @@
 //##DEBUG##
 #include <iostream>
 #include <iomanip>
+#include <thread>
 
 //----------------------------------------------------------------------------------------------------------------------
 // Constructors
 //----------------------------------------------------------------------------------------------------------------------
 PerformanceTimer::PerformanceTimer()
+:_sleepLatencyInNanoseconds((double)InitialSleepLatencyInNanoseconds)
 {
-	QueryPerformanceFrequency(&_counterFrequency);
 	Reset();
 }
 
@@ -17,33 +18,21 @@ PerformanceTimer::PerformanceTimer()
 void PerformanceTimer::Reset()
 {
 	_executionTimeAhead = 0;
-	QueryPerformanceCounter(&_executionTimeStart);
+	_executionTimeStart = Clock::now();
+	ResetStatistics();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void PerformanceTimer::Sync(double targetExecutionTime, bool enableSync, bool outputTimerDebug, double executeAheadTolerance)
 {
-	// Obtain the current time in ticks, making allowance for counter overflow if it
-	// occurs. Note that the official documentation doesn't give any assurance as to the
-	// point at which wrapping occurs, and the counter value itself is defined as signed,
-	// so we don't try and guess the wrapping point here for safety reasons, rather, we
-	// just assume the counter wraps back around to 0, and we rebase our start time from 0.
-	// This will probably result in a too short execution timespan being calculated at the
-	// time the counter wraps, but it's the safest option pending further testing, or some
-	// assurance from the documentation as to the wrap point.
-	LARGE_INTEGER executionTimeEnd;
-	QueryPerformanceCounter(&executionTimeEnd);
-	if (executionTimeEnd.QuadPart < _executionTimeStart.QuadPart)
-	{
-		_executionTimeStart.QuadPart = 0;
-	}
+	// Obtain the current time. Note that we use a steady clock here, which is guaranteed
+	// never to go backwards, so unlike a raw performance counter, we don't need to make
+	// any allowance for the counter wrapping.
+	Clock::time_point executionTimeEnd = Clock::now();
 
 	// Record the captured current time as the real end time for this execution block. We
 	// only do this so we can report on it later.
-	LARGE_INTEGER executionTimeRealEnd = executionTimeEnd;
-
-	// Calculate how long we would have expected the target execution time to take in ticks
-	LONGLONG executionTimeInTicks = (LONGLONG)((targetExecutionTime * ((double)_counterFrequency.QuadPart/1000000000.0)) + 0.5);
+	Clock::time_point executionTimeRealEnd = executionTimeEnd;
 
 	// If synchronization is enabled, block until we reach the correct time.
 	if (enableSync)
@@ -55,51 +44,125 @@ void PerformanceTimer::Sync(double targetExecutionTime, bool enableSync, bool ou
 		// target time, it's far more likely that we will slightly overshoot it each time.
 		// Adding this tolerance factor allows us to float near the target, just a bit
 		// before or after, which will over time average out to the correct execution time.
-		LONGLONG executeAheadToleranceInTicks = (LONGLONG)((double)executionTimeInTicks * executeAheadTolerance);
-		LONGLONG targetExecutionSpanInTicks = executionTimeInTicks - executeAheadToleranceInTicks;
-		targetExecutionSpanInTicks += _executionTimeAhead;
-
-		// If we're significantly ahead of the target time, yield this thread until we get
-		// closer to the target time. Note that according to research, it appears that all
-		// versions of Windows based on the Windows NT line actually have a minimum
-		// resolution 10 milliseconds for the sleep timer. To account for this, we only
-		// allow the Sleep function to be called if there is at least 15 milliseconds of
-		// free time, and we subtract 15 milliseconds from the sleep time, to ensure we
-		// don't delay too long.
-		static const double sleepErrorAdjustmentInNanoseconds = 15000000.0;
-		double executionTimeInNanoseconds = (double)(executionTimeEnd.QuadPart - _executionTimeStart.QuadPart) * (1000000000.0/(double)_counterFrequency.QuadPart);
-		double remainingTimeInNanoseconds = targetExecutionTime - executionTimeInNanoseconds;
-		if (remainingTimeInNanoseconds >= sleepErrorAdjustmentInNanoseconds)
-		{
-			DWORD sleepTimeInMilliseconds = (DWORD)((remainingTimeInNanoseconds - sleepErrorAdjustmentInNanoseconds) / 1000000.0);
-			Sleep(sleepTimeInMilliseconds);
-		}
+		// Note that the span we're required to fill here is the target time for this block
+		// plus any time we were ahead at the last synchronization point, since that lead
+		// hasn't been paid back yet.
+		double requiredExecutionSpanInNanoseconds = targetExecutionTime + _executionTimeAhead;
+		double targetExecutionSpanInNanoseconds = requiredExecutionSpanInNanoseconds - (targetExecutionTime * executeAheadTolerance);
+		Clock::time_point targetTime = _executionTimeStart + std::chrono::duration_cast<Clock::duration>(NanosecondDuration(targetExecutionSpanInNanoseconds));
 
-		// Spin around sampling the current time until we reach the target time, taking
-		// counter overflow into account.
-		do
-		{
-			QueryPerformanceCounter(&executionTimeEnd);
-			if (executionTimeEnd.QuadPart < _executionTimeStart.QuadPart)
-			{
-				_executionTimeStart.QuadPart = 0;
-			}
-		}
-		while ((executionTimeEnd.QuadPart - _executionTimeStart.QuadPart) < targetExecutionSpanInTicks);
+		// If we're ahead of the target time, sleep this thread until we get close to the
+		// target time. Rather than assuming a fixed resolution for the sleep timer, we
+		// measure how late each sleep actually wakes up, and stop short of the target by
+		// that amount. This lets us sleep for nearly all of the remaining time on
+		// platforms with a fine timer resolution, without overshooting the target on
+		// platforms with a coarse one. Note that we don't spin on the remaining time once
+		// the sleep returns. Whatever time is left is carried forward below, and reclaimed
+		// at the next synchronization point.
+		SleepUntil(targetTime);
+		executionTimeEnd = Clock::now();
+
+		// Record the amount of time which we are ahead of where we should be, so that it
+		// can be reclaimed at the next synchronization point. If we resumed late, we carry
+		// the overshoot forward as a negative lead, so that wake-up jitter averages out
+		// over time rather than accumulating as drift. We limit how far behind we carry
+		// forward to a single block however, so that if execution itself falls behind, we
+		// don't try to catch up by running in a burst once it recovers.
+		double actualExecutionSpanInNanoseconds = NanosecondDuration(executionTimeEnd - _executionTimeStart).count();
+		_executionTimeAhead = requiredExecutionSpanInNanoseconds - actualExecutionSpanInNanoseconds;
+		_executionTimeAhead = (_executionTimeAhead < -targetExecutionTime)? -targetExecutionTime: _executionTimeAhead;
 
-		// If we stopped slightly before the target time, record the number of ticks which
-		// we are ahead of where we should be.
-		LONGLONG actualExecutionSpanInTicks = executionTimeEnd.QuadPart - _executionTimeStart.QuadPart;
-		_executionTimeAhead = (actualExecutionSpanInTicks >= executionTimeInTicks)? 0: executionTimeInTicks - actualExecutionSpanInTicks;
+		// Update our pacing statistics with the difference between the time we were aiming
+		// for, and the time we actually resumed execution. Since we no longer wait out the
+		// last part of the sleep, we can resume either side of the target time, so we
+		// record the magnitude of the difference.
+		double jitterInNanoseconds = NanosecondDuration(executionTimeEnd - targetTime).count();
+		jitterInNanoseconds = (jitterInNanoseconds < 0)? -jitterInNanoseconds: jitterInNanoseconds;
+		++_syncCount;
+		_totalJitterInNanoseconds += jitterInNanoseconds;
+		_maxJitterInNanoseconds = (jitterInNanoseconds > _maxJitterInNanoseconds)? jitterInNanoseconds: _maxJitterInNanoseconds;
 	}
 
 	//##DEBUG##
 	if (outputTimerDebug)
 	{
-		std::wcout << std::setprecision(16) << targetExecutionTime << '\t' << executionTimeInTicks << '\t' << executionTimeEnd.QuadPart - _executionTimeStart.QuadPart << '\t' << executionTimeRealEnd.QuadPart - _executionTimeStart.QuadPart << '\t' << std::setprecision(4) << ((double)executionTimeInTicks / (double)(executionTimeEnd.QuadPart - _executionTimeStart.QuadPart)) * 100.0 << '\t' << std::setprecision(4) << ((double)executionTimeInTicks / (double)(executionTimeRealEnd.QuadPart - _executionTimeStart.QuadPart)) * 100.0 << '\t' << _executionTimeAhead << '\n';
+		double executionSpanInNanoseconds = NanosecondDuration(executionTimeEnd - _executionTimeStart).count();
+		double realExecutionSpanInNanoseconds = NanosecondDuration(executionTimeRealEnd - _executionTimeStart).count();
+		std::wcout << std::setprecision(16) << targetExecutionTime << '\t' << executionSpanInNanoseconds << '\t' << realExecutionSpanInNanoseconds << '\t' << std::setprecision(4) << (targetExecutionTime / executionSpanInNanoseconds) * 100.0 << '\t' << std::setprecision(4) << (targetExecutionTime / realExecutionSpanInNanoseconds) * 100.0 << '\t' << _executionTimeAhead << '\t' << GetAverageJitterInNanoseconds() << '\t' << _maxJitterInNanoseconds << '\t' << _sleepLatencyInNanoseconds << '\n';
 	}
 
 	// Save the end time for this synchronization point as the start time for the next
 	// synchronization point
 	_executionTimeStart = executionTimeEnd;
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+void PerformanceTimer::SleepUntil(Clock::time_point targetTime)
+{
+	// Sleep in steps until we're within the expected wake-up latency of the target time.
+	// We break the sleep into steps so that each sleep gives us a fresh measurement of the
+	// wake-up latency, and so that a single late wake-up can't push us far past the
+	// target.
+	Clock::time_point currentTime = Clock::now();
+	double remainingTimeInNanoseconds = NanosecondDuration(targetTime - currentTime).count();
+	while ((remainingTimeInNanoseconds - _sleepLatencyInNanoseconds) >= (double)MinimumSleepTimeInNanoseconds)
+	{
+		// Sleep for the remaining time, less the time we expect to lose waking up
+		double requestedSleepTimeInNanoseconds = remainingTimeInNanoseconds - _sleepLatencyInNanoseconds;
+		std::this_thread::sleep_for(std::chrono::duration_cast<Clock::duration>(NanosecondDuration(requestedSleepTimeInNanoseconds)));
+		Clock::time_point wakeTime = Clock::now();
+
+		// Update our estimate of the wake-up latency. We adapt quickly when we wake up
+		// later than expected, so that we don't repeatedly overshoot, and decay slowly
+		// when we wake up early, so that the estimate tracks the worst case we've seen
+		// recently rather than the average.
+		double measuredLatencyInNanoseconds = NanosecondDuration(wakeTime - currentTime).count() - requestedSleepTimeInNanoseconds;
+		measuredLatencyInNanoseconds = (measuredLatencyInNanoseconds < 0)? 0: measuredLatencyInNanoseconds;
+		if (measuredLatencyInNanoseconds > _sleepLatencyInNanoseconds)
+		{
+			_sleepLatencyInNanoseconds = (_sleepLatencyInNanoseconds + measuredLatencyInNanoseconds) / 2.0;
+		}
+		else
+		{
+			_sleepLatencyInNanoseconds = ((_sleepLatencyInNanoseconds * 15.0) + measuredLatencyInNanoseconds) / 16.0;
+		}
+
+		// Calculate the time which remains until the target time
+		currentTime = wakeTime;
+		remainingTimeInNanoseconds = NanosecondDuration(targetTime - currentTime).count();
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Statistics functions
+//----------------------------------------------------------------------------------------------------------------------
+void PerformanceTimer::ResetStatistics()
+{
+	_syncCount = 0;
+	_totalJitterInNanoseconds = 0;
+	_maxJitterInNanoseconds = 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int PerformanceTimer::GetSyncCount() const
+{
+	return _syncCount;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+double PerformanceTimer::GetAverageJitterInNanoseconds() const
+{
+	return (_syncCount > 0)? _totalJitterInNanoseconds / (double)_syncCount: 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+double PerformanceTimer::GetMaxJitterInNanoseconds() const
+{
+	return _maxJitterInNanoseconds;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+double PerformanceTimer::GetSleepLatencyInNanoseconds() const
+{
+	return _sleepLatencyInNanoseconds;
+}
@@ -1,163 +1,239 @@
 #include "ReadWriteLock.h"
 
+//----------------------------------------------------------------------------------------------------------------------
+// Static members
+//----------------------------------------------------------------------------------------------------------------------
+thread_local std::vector<ReadWriteLock::ThreadLockCount> ReadWriteLock::_threadLockCounts;
+
 //----------------------------------------------------------------------------------------------------------------------
 // Constructors
 //----------------------------------------------------------------------------------------------------------------------
 ReadWriteLock::ReadWriteLock()
-:_writeLocked(false)
+:_state(0), _waitingThreadCount(0)
 { }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Thread lock count functions
+//----------------------------------------------------------------------------------------------------------------------
+ReadWriteLock::ThreadLockCount& ReadWriteLock::GetThreadLockCount()
+{
+	// Search for an existing lock count entry for this lock in the calling thread. Note
+	// that a thread only ever holds a handful of locks at any one time, so a linear search
+	// here is faster than any kind of lookup structure.
+	for (size_t i = 0; i < _threadLockCounts.size(); ++i)
+	{
+		if (_threadLockCounts[i].lock == this)
+		{
+			return _threadLockCounts[i];
+		}
+	}
+
+	// Since no entry exists for this lock in the calling thread, create a new entry.
+	ThreadLockCount entry;
+	entry.lock = this;
+	entry.readLockCount = 0;
+	entry.writeLockCount = 0;
+	_threadLockCounts.push_back(entry);
+	return _threadLockCounts.back();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ReadWriteLock::RemoveThreadLockCountIfUnused()
+{
+	// If the calling thread no longer holds any locks on this object, remove the lock
+	// count entry for this lock, so that the table doesn't keep growing, and so that a new
+	// lock allocated at the same address doesn't inherit a stale entry.
+	for (size_t i = 0; i < _threadLockCounts.size(); ++i)
+	{
+		if (_threadLockCounts[i].lock == this)
+		{
+			if ((_threadLockCounts[i].readLockCount == 0) && (_threadLockCounts[i].writeLockCount == 0))
+			{
+				_threadLockCounts[i] = _threadLockCounts.back();
+				_threadLockCounts.pop_back();
+			}
+			return;
+		}
+	}
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Lock functions
 //----------------------------------------------------------------------------------------------------------------------
 void ReadWriteLock::ObtainReadLock()
 {
-	// Obtain the current thread ID
-	DWORD currentThreadID = GetCurrentThreadId();
+	// If the calling thread already holds a read or write lock, increment the read lock
+	// count for this thread and return. We don't wait for pending write locks in this case,
+	// as the pending writer would be waiting on us.
+	ThreadLockCount& threadLockCount = GetThreadLockCount();
+	if ((threadLockCount.readLockCount > 0) || (threadLockCount.writeLockCount > 0))
+	{
+		++threadLockCount.readLockCount;
+		return;
+	}
 
-	// Wait until no write lock is present or pending from another thread
-	std::unique_lock<std::mutex> lock(_accessMutex);
-	while ((_writeLocked && (_writeLockThreadID != currentThreadID)) || !_writeLockPendingThreadIDs.empty())
+	// Attempt to register a new read lock, as long as no write lock is present or pending.
+	unsigned int state = _state.load();
+	while (((state & (StateWriteLockedFlag | StateWriteLockPendingMask)) == 0) && !_state.compare_exchange_weak(state, state + 1))
+	{ }
+
+	// If a write lock is present or pending, wait for it to be released.
+	if ((state & (StateWriteLockedFlag | StateWriteLockPendingMask)) != 0)
 	{
-		_writeLockReleased.wait(lock);
+		++_waitingThreadCount;
+		std::unique_lock<std::mutex> lock(_accessMutex);
+		bool lockObtained = false;
+		while (!lockObtained)
+		{
+			state = _state.load();
+			if ((state & (StateWriteLockedFlag | StateWriteLockPendingMask)) != 0)
+			{
+				_lockStateChanged.wait(lock);
+			}
+			else
+			{
+				lockObtained = _state.compare_exchange_weak(state, state + 1);
+			}
+		}
+		--_waitingThreadCount;
 	}
 
-	// Increment the read lock count for this thread
-	++_readLockCount[currentThreadID];
+	// Record the new read lock for this thread
+	threadLockCount.readLockCount = 1;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool ReadWriteLock::TryObtainReadLock()
 {
-	// Obtain the current thread ID
-	DWORD currentThreadID = GetCurrentThreadId();
+	// If the calling thread already holds a read or write lock, increment the read lock
+	// count for this thread and return true.
+	ThreadLockCount& threadLockCount = GetThreadLockCount();
+	if ((threadLockCount.readLockCount > 0) || (threadLockCount.writeLockCount > 0))
+	{
+		++threadLockCount.readLockCount;
+		return true;
+	}
 
 	// If a write lock is present or pending from another thread, return false.
-	std::unique_lock<std::mutex> lock(_accessMutex);
-	if ((_writeLocked && (_writeLockThreadID != currentThreadID)) || !_writeLockPendingThreadIDs.empty())
+	unsigned int state = _state.load();
+	do
 	{
-		return false;
+		if ((state & (StateWriteLockedFlag | StateWriteLockPendingMask)) != 0)
+		{
+			RemoveThreadLockCountIfUnused();
+			return false;
+		}
 	}
+	while (!_state.compare_exchange_weak(state, state + 1));
 
-	// Increment the read lock count for this thread, and return true.
-	++_readLockCount[currentThreadID];
+	// Record the new read lock for this thread, and return true.
+	threadLockCount.readLockCount = 1;
 	return true;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void ReadWriteLock::ReleaseReadLock()
 {
-	// Obtain the current thread ID
-	DWORD currentThreadID = GetCurrentThreadId();
-
-	// Decrement the read lock count
-	std::unique_lock<std::mutex> lock(_accessMutex);
-	int newReadLockCount = --_readLockCount[currentThreadID];
-
-	// If we've just released the last read lock for this thread, remove this thread from
-	// the list of threads with active read locks.
-	if (newReadLockCount == 0)
+	// Decrement the read lock count for this thread. If this thread still holds other read
+	// locks, or its read locks are covered by a write lock, there's nothing more to do.
+	ThreadLockCount& threadLockCount = GetThreadLockCount();
+	--threadLockCount.readLockCount;
+	if ((threadLockCount.readLockCount > 0) || (threadLockCount.writeLockCount > 0))
 	{
-		// Remove the read lock entry for this thread
-		_readLockCount.erase(currentThreadID);
+		return;
+	}
+	RemoveThreadLockCountIfUnused();
 
-		// If there's at least one thread waiting for a write lock, notify a single waiting
-		// thread that a write lock may now be available.
-		if (!_writeLockPendingThreadIDs.empty())
-		{
-			_writeLockAvailable.notify_one();
-		}
+	// Release the read lock held by this thread. If we've just released the last read
+	// lock, and there's at least one thread waiting for a write lock, notify waiting
+	// threads that a write lock may now be available.
+	unsigned int previousState = _state.fetch_sub(1);
+	if (((previousState & StateReadLockCountMask) == 1) && ((previousState & StateWriteLockPendingMask) != 0))
+	{
+		NotifyWaitingThreads();
 	}
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void ReadWriteLock::ObtainWriteLock()
 {
-	// Obtain the current thread ID
-	DWORD currentThreadID = GetCurrentThreadId();
-
 	// If the calling thread already has a write lock, increment the write lock count and
 	// abort any further processing.
-	std::unique_lock<std::mutex> lock(_accessMutex);
-	if (_writeLocked && (_writeLockThreadID == currentThreadID))
+	ThreadLockCount& threadLockCount = GetThreadLockCount();
+	if (threadLockCount.writeLockCount > 0)
 	{
-		++_writeLockCount;
+		++threadLockCount.writeLockCount;
 		return;
 	}
 
-	// If a write lock isn't currently available for the calling thread, wait for it to
-	// become available.
-	if (!IsNewWriteLockAvailableForThread(currentThreadID))
+	// If the calling thread holds a read lock, temporarily give up the read lock while
+	// we're obtaining the write lock. The read lock count for this thread is retained,
+	// and the read lock is restored when the write lock is released.
+	bool readLockHeld = (threadLockCount.readLockCount > 0);
+	unsigned int state = readLockHeld? _state.fetch_sub(1) - 1: _state.load();
+
+	// Attempt to obtain the write lock immediately if no other locks are held
+	bool lockObtained = false;
+	while (((state & (StateWriteLockedFlag | StateReadLockCountMask)) == 0) && !lockObtained)
 	{
-		// Add this thread to the list of threads waiting for a write lock
-		_writeLockPendingThreadIDs.insert(currentThreadID);
+		lockObtained = _state.compare_exchange_weak(state, state | StateWriteLockedFlag);
+	}
 
-		// Wait for a write lock to become available for this thread
-		do
+	// If the write lock isn't currently available, flag that a write lock is pending, and
+	// wait for it to become available.
+	if (!lockObtained)
+	{
+		++_waitingThreadCount;
+		_state.fetch_add(StateWriteLockPendingIncrement);
+		std::unique_lock<std::mutex> lock(_accessMutex);
+		while (!lockObtained)
 		{
-			_writeLockAvailable.wait(lock);
+			state = _state.load();
+			if ((state & (StateWriteLockedFlag | StateReadLockCountMask)) != 0)
+			{
+				_lockStateChanged.wait(lock);
+			}
+			else
+			{
+				lockObtained = _state.compare_exchange_weak(state, (state - StateWriteLockPendingIncrement) | StateWriteLockedFlag);
+			}
 		}
-		while (!IsNewWriteLockAvailableForThread(currentThreadID));
-
-		// Remove this thread from the list of threads waiting for a write lock
-		_writeLockPendingThreadIDs.erase(currentThreadID);
+		--_waitingThreadCount;
 	}
 
-	// Assign an exclusive write lock to this thread
-	_writeLockThreadID = currentThreadID;
-	_writeLockCount = 1;
-	_writeLocked = true;
+	// Record the new write lock for this thread
+	threadLockCount.writeLockCount = 1;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 bool ReadWriteLock::TryObtainWriteLock()
 {
-	// Obtain the current thread ID
-	DWORD currentThreadID = GetCurrentThreadId();
-
 	// If the calling thread already has a write lock, increment the write lock count and
 	// abort any further processing.
-	std::unique_lock<std::mutex> lock(_accessMutex);
-	if (_writeLocked && (_writeLockThreadID == currentThreadID))
-	{
-		++_writeLockCount;
-		return true;
-	}
-
-	// If a write lock isn't currently available for the calling thread, return false.
-	if (!IsNewWriteLockAvailableForThread(currentThreadID))
-	{
-		return false;
-	}
-
-	// Assign an exclusive write lock to this thread, and return true.
-	_writeLockThreadID = currentThreadID;
-	_writeLockCount = 1;
-	_writeLocked = true;
-	return true;
-}
-
-//----------------------------------------------------------------------------------------------------------------------
-bool ReadWriteLock::IsNewWriteLockAvailableForThread(DWORD threadID)
-{
-	// If no write lock is currently active, return true.
-	if (!_writeLocked)
+	ThreadLockCount& threadLockCount = GetThreadLockCount();
+	if (threadLockCount.writeLockCount > 0)
 	{
+		++threadLockCount.writeLockCount;
 		return true;
 	}
 
-	// If any read locks are currently owned by other threads that are not blocked waiting
-	// for a write lock, return false.
-	for (std::map<DWORD, unsigned int>::const_iterator i = _readLockCount.begin(); i != _readLockCount.end(); ++i)
+	// If a write lock isn't currently available for the calling thread, return false. Note
+	// that if the calling thread holds a read lock, we can take over that read lock as the
+	// write lock, as long as it's the only read lock currently held.
+	unsigned int readLockCountForThread = (threadLockCount.readLockCount > 0)? 1: 0;
+	unsigned int state = _state.load();
+	do
 	{
-		DWORD readLockThreadID = i->first;
-		if ((readLockThreadID != threadID) && (_writeLockPendingThreadIDs.find(readLockThreadID) == _writeLockPendingThreadIDs.end()))
+		if (((state & StateWriteLockedFlag) != 0) || ((state & StateReadLockCountMask) != readLockCountForThread))
 		{
+			RemoveThreadLockCountIfUnused();
 			return false;
 		}
 	}
+	while (!_state.compare_exchange_weak(state, (state - readLockCountForThread) | StateWriteLockedFlag));
 
-	// Since a write lock should be available for the target thread, return true.
+	// Record the new write lock for this thread, and return true.
+	threadLockCount.writeLockCount = 1;
 	return true;
 }
 
@@ -165,25 +241,41 @@ bool ReadWriteLock::IsNewWriteLockAvailableForThread(DWORD threadID)
 void ReadWriteLock::ReleaseWriteLock()
 {
 	// Decrement the write lock count
-	std::unique_lock<std::mutex> lock(_accessMutex);
-	--_writeLockCount;
+	ThreadLockCount& threadLockCount = GetThreadLockCount();
+	--threadLockCount.writeLockCount;
 
 	// If the write lock count has reached zero, release the write lock.
-	if (_writeLockCount == 0)
+	if (threadLockCount.writeLockCount == 0)
 	{
-		// Release the write lock
-		_writeLocked = false;
+		// Release the write lock. If the calling thread still holds a read lock, restore
+		// its entry in the read lock count as part of the same operation.
+		unsigned int readLockCountForThread = (threadLockCount.readLockCount > 0)? 1: 0;
+		unsigned int state = _state.load();
+		while (!_state.compare_exchange_weak(state, (state & ~StateWriteLockedFlag) + readLockCountForThread))
+		{ }
+		RemoveThreadLockCountIfUnused();
 
-		// If any other threads are waiting for a write lock, notify a single waiting
-		// thread that a write lock is now available, otherwise notify any threads waiting
-		// for a read lock that the write lock has been released.
-		if (!_writeLockPendingThreadIDs.empty())
-		{
-			_writeLockAvailable.notify_one();
-		}
-		else
-		{
-			_writeLockReleased.notify_all();
-		}
+		// Notify any threads waiting for a read or write lock that the write lock has been
+		// released.
+		NotifyWaitingThreads();
 	}
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+void ReadWriteLock::NotifyWaitingThreads()
+{
+	// If no threads are waiting on this lock, abort any further processing. Note that
+	// waiting threads increment the waiting thread count before they test the lock state,
+	// and we've already changed the lock state before calling this function, so either
+	// the waiting thread sees the new state, or we see the waiting thread here.
+	if (_waitingThreadCount == 0)
+	{
+		return;
+	}
+
+	// Wake all waiting threads so they can test the new lock state. Readers will remain
+	// blocked while any writers are still pending, and only one pending writer can claim
+	// the lock, so this preserves the write lock priority.
+	std::unique_lock<std::mutex> lock(_accessMutex);
+	_lockStateChanged.notify_all();
+}
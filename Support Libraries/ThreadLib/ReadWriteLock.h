@@ -1,10 +1,9 @@
 #ifndef __READWRITELOCK_H__
 #define __READWRITELOCK_H__
-#include <WindowsSupport/WindowsSupport.pkg>
 #include <mutex>
 #include <condition_variable>
-#include <map>
-#include <set>
+#include <atomic>
+#include <vector>
 
 // Notes:
 // -Locks are re-entrant. The same calling thread can take multiple write locks for example
@@ -23,7 +22,13 @@
 // write locks.
 // -Write lock requests will not be blocked forever by constant overlapping requests for
 // read locks from other threads, as write lock attempts take priority, and attempts to
-// obtain read locks are blocked while any requests for write locks are pending.
+// obtain new read locks are blocked while any requests for write locks are pending. A
+// thread which already holds a read lock can always take another one, as blocking it would
+// deadlock against the pending writer.
+// -The number of locks held by each thread is tracked in thread local storage, and the
+// shared state of the lock is held in a single atomic state word. Obtaining or releasing
+// an uncontended lock only requires a single atomic operation, and never touches the
+// internal mutex, which is only used to put threads to sleep while they wait for the lock.
 class ReadWriteLock
 {
 public:
@@ -39,23 +44,38 @@ public:
 	void ReleaseWriteLock();
 
 private:
+	// Structures
+	struct ThreadLockCount;
+
+	// Constants
+	// The state word holds the number of threads holding read locks in the lower bits, the
+	// number of threads waiting for a write lock in the middle bits, and a flag in the
+	// uppermost bit indicating whether a write lock is currently held.
+	static const unsigned int StateReadLockCountMask = 0x0000FFFF;
+	static const unsigned int StateWriteLockPendingIncrement = 0x00010000;
+	static const unsigned int StateWriteLockPendingMask = 0x7FFF0000;
+	static const unsigned int StateWriteLockedFlag = 0x80000000;
+
+private:
+	// Thread lock count functions
+	ThreadLockCount& GetThreadLockCount();
+	void RemoveThreadLockCountIfUnused();
+
 	// Lock functions
-	bool IsNewWriteLockAvailableForThread(DWORD threadID);
+	void NotifyWaitingThreads();
 
 private:
+	// Lock state
+	std::atomic<unsigned int> _state;
+
 	// Thread synchronization
+	std::atomic<unsigned int> _waitingThreadCount;
 	std::mutex _accessMutex;
-	std::condition_variable _writeLockReleased;
-	std::condition_variable _writeLockAvailable;
-
-	// Read lock info
-	std::map<DWORD, unsigned int> _readLockCount;
+	std::condition_variable _lockStateChanged;
 
-	// Write lock info
-	bool _writeLocked;
-	DWORD _writeLockThreadID;
-	unsigned int _writeLockCount;
-	std::set<DWORD> _writeLockPendingThreadIDs;
+	// Thread local lock counts
+	static thread_local std::vector<ThreadLockCount> _threadLockCounts;
 };
 
+#include "ReadWriteLock.inl"
 #endif
@@ -0,0 +1,9 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Structures
+//----------------------------------------------------------------------------------------------------------------------
+struct ReadWriteLock::ThreadLockCount
+{
+	const ReadWriteLock* lock;
+	unsigned int readLockCount;
+	unsigned int writeLockCount;
+};
@@ -0,0 +1,90 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include "ThreadLib/ReadWriteLock.h"
+
+const int IterationsPerThread = 1000000;
+const int WriteLockInterval = 64;
+const int MaxThreadCount = 8;
+
+// Our stand-in for an item guarded by a lock. The reads and writes are kept trivial, so
+// that the test measures the overhead of the locks themselves.
+struct SharedData
+{
+	volatile unsigned int values[16];
+};
+
+template<class ObtainRead, class ReleaseRead, class ObtainWrite, class ReleaseWrite>
+std::chrono::duration<float> RunContentionTest(int threadCount, SharedData& data, ObtainRead obtainRead, ReleaseRead releaseRead, ObtainWrite obtainWrite, ReleaseWrite releaseWrite)
+{
+	std::vector<std::thread> threads;
+	auto t0_cpu = std::chrono::high_resolution_clock::now();
+	for(int threadNo = 0; threadNo < threadCount; ++threadNo)
+	{
+		threads.push_back(std::thread([=, &data]()
+		{
+			unsigned int sum = 0;
+			for(int i = 0; i < IterationsPerThread; ++i)
+			{
+				if(((i + threadNo) % WriteLockInterval) == 0)
+				{
+					obtainWrite();
+					++data.values[i % 16];
+					releaseWrite();
+				}
+				else
+				{
+					obtainRead();
+					sum += data.values[i % 16];
+					releaseRead();
+				}
+			}
+			data.values[threadNo] += (sum & 0);
+		}));
+	}
+	for(size_t i = 0; i < threads.size(); ++i)
+	{
+		threads[i].join();
+	}
+	auto t1_cpu = std::chrono::high_resolution_clock::now();
+	return t1_cpu - t0_cpu;
+}
+
+int main()
+{
+	std::cout << "ReadWriteLock contention performance test" << std::endl;
+	std::cout << "Threads\tMutex\t\tRWLock\t\tRWLockNested" << std::endl;
+	std::cout << std::showpoint << std::fixed << std::setprecision(8);
+
+	SharedData data = {};
+	std::mutex mutex;
+	ReadWriteLock readWriteLock;
+	for(int threadCount = 1; threadCount <= MaxThreadCount; threadCount *= 2)
+	{
+		std::cout << threadCount;
+
+		// Measure a plain exclusive mutex as a baseline
+		std::chrono::duration<float> mutexDuration = RunContentionTest(threadCount, data,
+			[&]() { mutex.lock(); }, [&]() { mutex.unlock(); },
+			[&]() { mutex.lock(); }, [&]() { mutex.unlock(); });
+		std::cout << "\t" << mutexDuration.count();
+
+		// Measure read and write locks taken from an unlocked state
+		std::chrono::duration<float> readWriteLockDuration = RunContentionTest(threadCount, data,
+			[&]() { readWriteLock.ObtainReadLock(); }, [&]() { readWriteLock.ReleaseReadLock(); },
+			[&]() { readWriteLock.ObtainWriteLock(); }, [&]() { readWriteLock.ReleaseWriteLock(); });
+		std::cout << "\t" << readWriteLockDuration.count() << " " << (int)((readWriteLockDuration.count() / mutexDuration.count()) * 100) << "%";
+
+		// Measure re-entrant read locks, as taken by nested calls into a locked object
+		std::chrono::duration<float> readWriteLockNestedDuration = RunContentionTest(threadCount, data,
+			[&]() { readWriteLock.ObtainReadLock(); readWriteLock.ObtainReadLock(); }, [&]() { readWriteLock.ReleaseReadLock(); readWriteLock.ReleaseReadLock(); },
+			[&]() { readWriteLock.ObtainWriteLock(); readWriteLock.ObtainReadLock(); }, [&]() { readWriteLock.ReleaseReadLock(); readWriteLock.ReleaseWriteLock(); });
+		std::cout << "\t" << readWriteLockNestedDuration.count() << " " << (int)((readWriteLockNestedDuration.count() / mutexDuration.count()) * 100) << "%";
+
+		std::cout << std::endl;
+	}
+	return 0;
+}
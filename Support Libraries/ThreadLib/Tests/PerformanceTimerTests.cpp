@@ -0,0 +1,49 @@
+#include "catch.hpp"
+#include "../PerformanceTimer.h"
+#include <chrono>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Runs a series of synchronization points with the given target interval, with no work
+// performed between them, and returns the real time which elapsed as a fraction of the
+// total target time. A perfectly paced timer returns 1.0.
+//----------------------------------------------------------------------------------------------------------------------
+static double MeasurePacing(double intervalInNanoseconds, unsigned int syncCount)
+{
+	PerformanceTimer timer;
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	timer.Reset();
+	for (unsigned int i = 0; i < syncCount; ++i)
+	{
+		timer.Sync(intervalInNanoseconds);
+	}
+	double elapsedTimeInNanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+	return elapsedTimeInNanoseconds / (intervalInNanoseconds * (double)syncCount);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST_CASE("PerformanceTimer long-run drift", "")
+{
+	// Each run covers two seconds of target time. Individual synchronization points may
+	// resume either side of their target, but any lead or lag must be carried forward, so
+	// that over a long run the total elapsed time matches the total target time.
+	SECTION("20ms interval", "")
+	{
+		double pacing = MeasurePacing(20000000.0, 100);
+		REQUIRE(pacing > 0.995);
+		REQUIRE(pacing < 1.01);
+	}
+
+	SECTION("5ms interval", "")
+	{
+		double pacing = MeasurePacing(5000000.0, 400);
+		REQUIRE(pacing > 0.995);
+		REQUIRE(pacing < 1.01);
+	}
+
+	SECTION("2ms interval", "")
+	{
+		double pacing = MeasurePacing(2000000.0, 1000);
+		REQUIRE(pacing > 0.995);
+		REQUIRE(pacing < 1.01);
+	}
+}
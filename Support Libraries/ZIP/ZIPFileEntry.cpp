@@ -1,6 +1,7 @@
 #include "ZIPFileEntry.h"
 #include "Deflate.h"
 #include "WindowsSupport/WindowsSupport.pkg"
+#include <zlib.h>
 
 //----------------------------------------------------------------------------------------------------------------------
 // Constructors
@@ -18,8 +19,13 @@ ZIPFileEntry::ZIPFileEntry()
 //----------------------------------------------------------------------------------------------------------------------
 bool ZIPFileEntry::LoadFromStream(Stream::IStream& source)
 {
-	// Load the local file header and compressed file data from the stream
-	_localFileHeader.LoadFromStream(source);
+	// Load the local file header and compressed file data from the stream. Note that we
+	// validate the header before trusting the size fields, since callers may probe the
+	// start of a file which isn't a zip archive at all.
+	if (!_localFileHeader.LoadFromStream(source))
+	{
+		return false;
+	}
 	_data.Resize(_localFileHeader.compressedSize);
 	if (!source.ReadData(_data.GetRawBuffer(), _localFileHeader.compressedSize))
 	{
@@ -71,15 +77,7 @@ bool ZIPFileEntry::Compress(Stream::IStream& source, unsigned int inputCacheSize
 	}
 
 	// Write the current system time as the modification time for the file
-	SYSTEMTIME systemTime;
-	FILETIME fileTime;
-	WORD dosTime = 0;
-	WORD dosDate = 0;
-	GetLocalTime(&systemTime);
-	SystemTimeToFileTime(&systemTime, &fileTime);
-	FileTimeToDosDateTime(&fileTime, &dosDate, &dosTime);
-	_localFileHeader.modFileDate = dosDate;
-	_localFileHeader.modFileTime = dosTime;
+	UpdateModificationTime();
 
 	// Write header information for the data we just compressed
 	//##TODO## Fix up the version to extract and compression method settings here
@@ -95,6 +93,41 @@ bool ZIPFileEntry::Compress(Stream::IStream& source, unsigned int inputCacheSize
 	return true;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+bool ZIPFileEntry::Store(Stream::IStream& source)
+{
+	// Calculate the size of the data to store
+	Stream::IStream::SizeType dataSize = source.Size() - source.GetStreamPos();
+	if (dataSize < 0)
+	{
+		dataSize = 0;
+	}
+
+	// Copy the source data directly into our data buffer without compression
+	_data.Resize(dataSize);
+	if ((dataSize > 0) && !source.ReadData(_data.GetRawBuffer(), dataSize))
+	{
+		return false;
+	}
+
+	// Write the current system time as the modification time for the file
+	UpdateModificationTime();
+
+	// Write header information for the stored data
+	uLong crc = crc32(0, Z_NULL, 0);
+	crc = crc32(crc, _data.GetRawBuffer(), (uInt)dataSize);
+	_localFileHeader.versionToExtract = 10;
+	_localFileHeader.compressionMethod = 0;	// No compression
+	_localFileHeader.compressedSize = (unsigned int)dataSize;
+	_localFileHeader.uncompressedSize = (unsigned int)dataSize;
+	_localFileHeader.crc32 = (unsigned int)crc;
+
+	// Flag that the object has been populated with a data stream
+	_compressedDataWritten = true;
+
+	return true;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 bool ZIPFileEntry::Decompress(Stream::IStream& target, unsigned int outputCacheSize)
 {
@@ -105,6 +138,19 @@ bool ZIPFileEntry::Decompress(Stream::IStream& target, unsigned int outputCacheS
 		return false;
 	}
 
+	// If the data was stored without compression, copy it directly to the target stream,
+	// validating the CRC as we go.
+	if (_localFileHeader.compressionMethod == 0)
+	{
+		uLong crc = crc32(0, Z_NULL, 0);
+		crc = crc32(crc, _data.GetRawBuffer(), (uInt)_data.Size());
+		if ((unsigned int)crc != _localFileHeader.crc32)
+		{
+			return false;
+		}
+		return target.WriteData(_data.GetRawBuffer(), _data.Size());
+	}
+
 	// Attempt to decompress the file from our buffer using deflate compression
 	unsigned int calculatedCRC;
 	if (!Deflate::DeflateDecompress(_data, target, calculatedCRC, (unsigned int)_data.Size(), outputCacheSize))
@@ -143,3 +189,19 @@ ZIPChunkCentralFileHeader ZIPFileEntry::GetCentralDirectoryFileHeader() const
 {
 	return ZIPChunkCentralFileHeader(_localFileHeader);
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Modification time functions
+//----------------------------------------------------------------------------------------------------------------------
+void ZIPFileEntry::UpdateModificationTime()
+{
+	SYSTEMTIME systemTime;
+	FILETIME fileTime;
+	WORD dosTime = 0;
+	WORD dosDate = 0;
+	GetLocalTime(&systemTime);
+	SystemTimeToFileTime(&systemTime, &fileTime);
+	FileTimeToDosDateTime(&fileTime, &dosDate, &dosTime);
+	_localFileHeader.modFileDate = dosDate;
+	_localFileHeader.modFileTime = dosTime;
+}
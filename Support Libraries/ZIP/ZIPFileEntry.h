@@ -26,6 +26,7 @@ public:
 	//##TODO## Implement a compressionMethod flag to the Compress function, and modify the
 	// function to support multiple compression methods.
 	bool Compress(Stream::IStream& source, unsigned int inputCacheSize = 0);
+	bool Store(Stream::IStream& source);
 	//##TODO## Implement support for multiple compression methods.
 	bool Decompress(Stream::IStream& target, unsigned int outputCacheSize = 0);
 
@@ -36,6 +37,10 @@ public:
 	// File header functions
 	ZIPChunkCentralFileHeader GetCentralDirectoryFileHeader() const;
 
+private:
+	// Modification time functions
+	void UpdateModificationTime();
+
 private:
 	bool _compressedDataWritten;
 	Stream::Buffer _data;
@@ -8,7 +8,7 @@
 // Constructors
 //----------------------------------------------------------------------------------------------------------------------
 BusInterface::BusInterface()
-:_memoryInterfaceDefined(false), _portInterfaceDefined(false), _nextCELineID(1)
+:_memoryInterfaceDefined(false), _portInterfaceDefined(false), _nextCELineID(1), _accessWatchSourceDevice(0), _accessWatchTargetDevice(0), _accessWatchTriggered(false)
 { }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -2443,6 +2443,7 @@ BusInterface::AccessResult BusInterface::ReadMemory(unsigned int location, Data&
 	MapEntry* mapEntry = ResolveMemoryAddress(ce, location);
 	if (mapEntry != 0)
 	{
+		CheckAccessWatch(caller, mapEntry->device);
 		unsigned int interfaceOffset;
 		if (mapEntry->remapAddressLines)
 		{
@@ -2496,6 +2497,7 @@ BusInterface::AccessResult BusInterface::WriteMemory(unsigned int location, cons
 	MapEntry* mapEntry = ResolveMemoryAddress(ce, location);
 	if (mapEntry != 0)
 	{
+		CheckAccessWatch(caller, mapEntry->device);
 		unsigned int interfaceOffset;
 		if (mapEntry->remapAddressLines)
 		{
@@ -2636,6 +2638,7 @@ BusInterface::AccessResult BusInterface::ReadPort(unsigned int location, Data& d
 	MapEntry* mapEntry = ResolvePortAddress(ce, location);
 	if (mapEntry != 0)
 	{
+		CheckAccessWatch(caller, mapEntry->device);
 		unsigned int interfaceOffset;
 		if (mapEntry->remapAddressLines)
 		{
@@ -2689,6 +2692,7 @@ BusInterface::AccessResult BusInterface::WritePort(unsigned int location, const
 	MapEntry* mapEntry = ResolvePortAddress(ce, location);
 	if (mapEntry != 0)
 	{
+		CheckAccessWatch(caller, mapEntry->device);
 		unsigned int interfaceOffset;
 		if (mapEntry->remapAddressLines)
 		{
@@ -2801,6 +2805,7 @@ bool BusInterface::SetLineState(unsigned int sourceLine, const Data& lineData, I
 				for (unsigned int i = 0; i < mappedLineList->arraySize; ++i)
 				{
 					const LineEntry* lineEntry = mappedLineList->array[i];
+					CheckAccessWatch(sourceDevice, lineEntry->targetDevice);
 					//##DEBUG##
 					// std::wcout << "SetLineState:\t" << lineEntry->sourceDevice->GetDeviceInstanceName() << '\t' << lineEntry->targetDevice->GetDeviceInstanceName() << '\t' << lineEntry->sourceLine << '\t' << lineEntry->targetLine << '\n';
 
@@ -47,6 +47,7 @@ frequently.
 #include <vector>
 #include <list>
 #include <map>
+#include <atomic>
 #include "HierarchicalStorageInterface/HierarchicalStorageInterface.pkg"
 #include "ThinContainers/ThinContainers.pkg"
 #include "DeviceInterface/DeviceInterface.pkg"
@@ -125,6 +126,10 @@ public:
 	virtual void SetClockRate(double newClockRate, const IClockSource* sourceClock, IDeviceContext* callingDevice, double accessTime, unsigned int accessContext);
 	virtual void TransparentSetClockRate(double newClockRate, const IClockSource* sourceClock);
 
+	// Access watch functions
+	inline void BeginAccessWatch(IDeviceContext* sourceDevice, IDevice* targetDevice);
+	inline bool EndAccessWatch();
+
 private:
 	// Structures
 	struct MapEntry;
@@ -196,6 +201,9 @@ private:
 	template<class T>
 	static ThinVector<T*,1>* RemoveItemFromThinVector(ThinVector<T*,1>* existingArray, T* item);
 
+	// Access watch functions
+	inline void CheckAccessWatch(IDeviceContext* sourceDevice, const IDevice* targetDevice);
+
 private:
 	// Memory map
 	bool _memoryInterfaceDefined;
@@ -236,6 +244,11 @@ private:
 
 	// Clock source mappings
 	std::list<ClockSourceEntry> _clockSourceMap;
+
+	// Access watch
+	std::atomic<IDeviceContext*> _accessWatchSourceDevice;
+	IDevice* _accessWatchTargetDevice;
+	std::atomic<bool> _accessWatchTriggered;
 };
 
 #include "BusInterface.inl"
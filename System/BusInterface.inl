@@ -252,3 +252,35 @@ struct BusInterface::ClockSourceEntry
 	IDevice* targetDevice;
 	unsigned int targetClockLine;
 };
+
+//----------------------------------------------------------------------------------------------------------------------
+// Access watch functions
+//----------------------------------------------------------------------------------------------------------------------
+// An access watch records whether a given device accesses another given device through
+// this bus, by memory or port access or by changing the state of a mapped line. The
+// system uses this to confirm that an access it predicted actually took place. While no
+// watch is active, the only cost on the access path is a single pointer comparison.
+//----------------------------------------------------------------------------------------------------------------------
+void BusInterface::BeginAccessWatch(IDeviceContext* sourceDevice, IDevice* targetDevice)
+{
+	_accessWatchTargetDevice = targetDevice;
+	_accessWatchTriggered.store(false, std::memory_order_relaxed);
+	_accessWatchSourceDevice.store(sourceDevice, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool BusInterface::EndAccessWatch()
+{
+	_accessWatchSourceDevice.store(0, std::memory_order_relaxed);
+	return _accessWatchTriggered.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void BusInterface::CheckAccessWatch(IDeviceContext* sourceDevice, const IDevice* targetDevice)
+{
+	IDeviceContext* watchSourceDevice = _accessWatchSourceDevice.load(std::memory_order_acquire);
+	if ((watchSourceDevice != 0) && (watchSourceDevice == sourceDevice) && (targetDevice == _accessWatchTargetDevice))
+	{
+		_accessWatchTriggered.store(true, std::memory_order_relaxed);
+	}
+}
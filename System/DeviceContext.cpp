@@ -1,6 +1,7 @@
 #include "DeviceContext.h"
 #include "ThreadLib/ThreadLib.pkg"
 #include "Debug/Debug.pkg"
+#include "DataConversion/DataConversion.pkg"
 #include <thread>
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -151,6 +152,11 @@ void DeviceContext::SuspendTimesliceExecution()
 
 	_timesliceSuspended = true;
 	_executeCompletionStateChanged.notify_all();
+	_profileSuspendCount.fetch_add(1, std::memory_order_relaxed);
+	if (_traceRecorder.TraceRecordingEnabled())
+	{
+		_traceRecorder.RecordTraceEvent(ITraceRecorder::EventType::Instant, "TimesliceSuspend");
+	}
 
 	if (_suspendedThreadCount != nullptr)
 	{
@@ -165,11 +171,14 @@ void DeviceContext::SuspendTimesliceExecution()
 void DeviceContext::WaitForTimesliceExecutionResume() const
 {
 	// Wait for the timeslice to resume execution, or for timeslice suspension to be disabled.
+	ExecutionProfileTimer::Clock::time_point waitStartTime = ExecutionProfileTimer::Now();
+	ITraceRecorder::Scope traceScope(_traceRecorder, "TimesliceSuspendWait");
 	std::unique_lock<std::mutex> lock(_executeThreadMutex);
 	while (_timesliceSuspended && !_timesliceSuspensionDisable)
 	{
 		_executeCompletionStateChanged.wait(lock);
 	}
+	_profileSuspendWaitTimer.AddSample(waitStartTime);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -184,6 +193,11 @@ void DeviceContext::ResumeTimesliceExecution()
 
 	_timesliceSuspended = false;
 	_executeCompletionStateChanged.notify_all();
+	_profileResumeCount.fetch_add(1, std::memory_order_relaxed);
+	if (_traceRecorder.TraceRecordingEnabled())
+	{
+		_traceRecorder.RecordTraceEvent(ITraceRecorder::EventType::Instant, "TimesliceResume");
+	}
 
 	if (_suspendedThreadCount != nullptr)
 	{
@@ -327,6 +341,68 @@ void DeviceContext::SetDeviceDependencyEnable(IDeviceContext* targetDevice, bool
 	}
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Profiling functions
+//----------------------------------------------------------------------------------------------------------------------
+void DeviceContext::GetExecutionProfile(ISystemGUIInterface::ExecutionProfileDeviceEntry& profileEntry) const
+{
+	profileEntry.deviceName = GetFullyQualifiedDeviceInstanceName();
+	profileEntry.timesliceCount = _profileTimesliceTimer.GetSampleCount();
+	profileEntry.timesliceNanoseconds = _profileTimesliceTimer.GetTotalNanoseconds();
+	profileEntry.timingPointStepCount = _profileTimingPointStepTimer.GetSampleCount();
+	profileEntry.timingPointStepNanoseconds = _profileTimingPointStepTimer.GetTotalNanoseconds();
+	profileEntry.suspendCount = _profileSuspendCount.load(std::memory_order_relaxed);
+	profileEntry.resumeCount = _profileResumeCount.load(std::memory_order_relaxed);
+	profileEntry.suspendWaitNanoseconds = _profileSuspendWaitTimer.GetTotalNanoseconds();
+	profileEntry.commitNanoseconds = _profileCommitTimer.GetTotalNanoseconds();
+	profileEntry.rollbackNanoseconds = _profileRollbackTimer.GetTotalNanoseconds();
+	profileEntry.rollbackRequestCount = _profileRollbackRequestCount.load(std::memory_order_relaxed);
+	profileEntry.rollbackTriggerCount = _profileRollbackTriggerCount.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DeviceContext::ResetExecutionProfile()
+{
+	_profileTimesliceTimer.Reset();
+	_profileTimingPointStepTimer.Reset();
+	_profileSuspendWaitTimer.Reset();
+	_profileCommitTimer.Reset();
+	_profileRollbackTimer.Reset();
+	_profileSuspendCount.store(0, std::memory_order_relaxed);
+	_profileResumeCount.store(0, std::memory_order_relaxed);
+	_profileRollbackRequestCount.store(0, std::memory_order_relaxed);
+	_profileRollbackTriggerCount.store(0, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Cooperative execute functions
+//----------------------------------------------------------------------------------------------------------------------
+void DeviceContext::ExecuteCooperativeTimeslice()
+{
+	_device.ExecuteTimeslice(_timeslice);
+	_remainingTime = 0;
+	_currentTimesliceProgress = _timeslice;
+	_device.NotifyAfterExecuteStepFinishedTimeslice();
+	_timesliceCompleted = true;
+	RecordTimesliceCompleted();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DeviceContext::CompleteCooperativeTimeslice()
+{
+	// Timeslice devices complete their timeslice as soon as they execute it, so we only
+	// need to finalize step devices here.
+	if (_timesliceCompleted)
+	{
+		return;
+	}
+	_remainingTime = _currentTimesliceProgress - _timeslice;
+	_device.NotifyAfterExecuteStepFinishedTimeslice();
+	_timesliceSuspended = false;
+	_timesliceCompleted = true;
+	RecordTimesliceCompleted();
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Worker thread control
 //----------------------------------------------------------------------------------------------------------------------
@@ -335,6 +411,42 @@ void DeviceContext::StartExecution()
 	StartExecuteWorkerThread();
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void DeviceContext::StartCooperativeExecution()
+{
+	std::unique_lock<std::mutex> lock(_executeThreadMutex);
+	if (_cooperativeExecutionActive || _executeWorkerThreadActive || !ActiveDevice())
+	{
+		return;
+	}
+
+	// Initialize the timeslice completed state to true, since no timeslice is pending.
+	// Note that devices never share an execution thread in cooperative mode, as all
+	// devices are advanced from the thread which executes the timeslice.
+	_timesliceCompleted = true;
+	_sharingExecuteThread = false;
+	_cooperativeExecutionActive = true;
+
+	// Notify the device that execution is about to begin
+	lock.unlock();
+	_device.BeginExecution();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DeviceContext::StopCooperativeExecution()
+{
+	std::unique_lock<std::mutex> lock(_executeThreadMutex);
+	if (!_cooperativeExecutionActive)
+	{
+		return;
+	}
+	_cooperativeExecutionActive = false;
+
+	// Notify the device that execution is being suspended
+	lock.unlock();
+	_device.SuspendExecution();
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void DeviceContext::StopExecution()
 {
@@ -356,6 +468,11 @@ void DeviceContext::StartExecuteWorkerThread()
 	// there is no timeslice pending.
 	_timesliceCompleted = true;
 
+	// Build the name used for timeslice events from this device in trace recordings. We do
+	// this here rather than in the execute thread, so that no string conversion is required
+	// while recording.
+	_traceTimesliceEventName = "Timeslice - " + WStringToString(_device.GetDeviceInstanceName());
+
 	// Notify the device that execution is about to begin
 	lock.unlock();
 	_device.BeginExecution();
@@ -459,6 +576,7 @@ void DeviceContext::ExecuteWorkerThread()
 	// Set the name of this thread for the debugger
 	std::wstring debuggerThreadName = L"DCExecute - " + _device.GetDeviceInstanceName();
 	SetCallingThreadName(debuggerThreadName);
+	_traceRecorder.SetCurrentThreadTraceName(debuggerThreadName);
 
 	if (_device.GetUpdateMethod() == IDevice::UpdateMethod::Step)
 	{
@@ -497,6 +615,7 @@ void DeviceContext::ExecuteWorkerThreadStep()
 	while (_executeWorkerThreadActive)
 	{
 		lock.unlock();
+		bool traceActive = TraceTimesliceBegin();
 		while (_currentTimesliceProgress < _timeslice)
 		{
 			_currentTimesliceProgress += _device.ExecuteStep();
@@ -510,10 +629,12 @@ void DeviceContext::ExecuteWorkerThreadStep()
 		}
 		_remainingTime = _currentTimesliceProgress - _timeslice;
 		_device.NotifyAfterExecuteStepFinishedTimeslice();
+		TraceTimesliceEnd(traceActive);
 		lock.lock();
 
 		_timesliceSuspended = false;
 		_timesliceCompleted = true;
+		RecordTimesliceCompleted();
 		lock.unlock();
 		WakeSuspendedDevicesIfRequired();
 		lock.lock();
@@ -540,6 +661,7 @@ void DeviceContext::ExecuteWorkerThreadStepWithDependencies()
 	while (_executeWorkerThreadActive)
 	{
 		lock.unlock();
+		bool traceActive = TraceTimesliceBegin();
 		unsigned int dependentTargetCount = (unsigned int)_deviceDependencies.size();
 		while (_currentTimesliceProgress < _timeslice)
 		{
@@ -561,10 +683,12 @@ void DeviceContext::ExecuteWorkerThreadStepWithDependencies()
 		}
 		_remainingTime = _currentTimesliceProgress - _timeslice;
 		_device.NotifyAfterExecuteStepFinishedTimeslice();
+		TraceTimesliceEnd(traceActive);
 		lock.lock();
 
 		_timesliceSuspended = false;
 		_timesliceCompleted = true;
+		RecordTimesliceCompleted();
 		lock.unlock();
 		WakeSuspendedDevicesIfRequired();
 		lock.lock();
@@ -587,6 +711,7 @@ void DeviceContext::ExecuteWorkerThreadStepMultipleDeviceSharedDependencies(Devi
 	// Set the name of this thread for the benefit of an attached debugger
 	std::wstring debuggerThreadName = L"DCExePri - \"" + device1->_device.GetDeviceInstanceName() + L"\" and \"" + device2->_device.GetDeviceInstanceName() + L"\"";
 	SetCallingThreadName(debuggerThreadName);
+	device1->_traceRecorder.SetCurrentThreadTraceName(debuggerThreadName);
 
 	// Start our parallel execution thread for these locked devices, so that if the device
 	// dependency is enabled, the second device can be spun off into this parallel
@@ -638,6 +763,8 @@ void DeviceContext::ExecuteWorkerThreadStepMultipleDeviceSharedDependencies(Devi
 	{
 		lock1.unlock();
 		lock2.unlock();
+		bool device1TraceActive = device1->TraceTimesliceBegin();
+		bool device2TraceActive = device2->TraceTimesliceBegin();
 
 		// If our spinoff thread is currently active and waiting to advance a device, send
 		// a notification to the spinoff thread about the new timeslice that has been
@@ -733,6 +860,8 @@ void DeviceContext::ExecuteWorkerThreadStepMultipleDeviceSharedDependencies(Devi
 			device2->_remainingTime = device2->_currentTimesliceProgress - device2->_timeslice;
 			device2->_device.NotifyAfterExecuteStepFinishedTimeslice();
 		}
+		device2->TraceTimesliceEnd(device2TraceActive);
+		device1->TraceTimesliceEnd(device1TraceActive);
 
 		// Notify the command thread that this execute command has been completed for all
 		// devices which are currently executing in this combined execution thread
@@ -741,6 +870,7 @@ void DeviceContext::ExecuteWorkerThreadStepMultipleDeviceSharedDependencies(Devi
 		{
 			device1->_timesliceSuspended = false;
 			device1->_timesliceCompleted = true;
+			device1->RecordTimesliceCompleted();
 			lock1.unlock();
 			device1->WakeSuspendedDevicesIfRequired();
 			lock1.lock();
@@ -751,6 +881,7 @@ void DeviceContext::ExecuteWorkerThreadStepMultipleDeviceSharedDependencies(Devi
 			lock2.lock();
 			device2->_timesliceSuspended = false;
 			device2->_timesliceCompleted = true;
+			device2->RecordTimesliceCompleted();
 			lock2.unlock();
 			lock1.unlock();
 			device2->WakeSuspendedDevicesIfRequired();
@@ -807,6 +938,7 @@ void DeviceContext::ExecuteWorkerThreadStepSharedExecutionThreadSpinoff()
 	// Set the name of this thread for the benefit of an attached debugger
 	std::wstring debuggerThreadName = L"DCExeSec - \"" + primaryDevice->_device.GetDeviceInstanceName() + L"\" and \"" + secondaryDevice->_device.GetDeviceInstanceName() + L"\"";
 	SetCallingThreadName(debuggerThreadName);
+	_traceRecorder.SetCurrentThreadTraceName(debuggerThreadName);
 
 	// Process execute requests from the primary execution thread until this thread is
 	// requested to terminate
@@ -851,6 +983,7 @@ void DeviceContext::ExecuteWorkerThreadStepSharedExecutionThreadSpinoff()
 		// spinoff thread is requested to rejoin the main execution thread.
 		DeviceContext* spinoffThreadTargetDevice = (primaryDevice->_currentSharedExecuteThreadOwner == this)? _otherSharedExecuteThreadDevice: this;
 		unsigned int dependentTargetCount = (unsigned int)spinoffThreadTargetDevice->_deviceDependencies.size();
+		bool traceActive = spinoffThreadTargetDevice->TraceTimesliceBegin();
 		while (!primaryDevice->_sharedExecuteThreadSpinoffRejoinRequested && (spinoffThreadTargetDevice->_currentTimesliceProgress < spinoffThreadTargetDevice->_timeslice))
 		{
 			for (unsigned int i = 0; i < dependentTargetCount; ++i)
@@ -870,6 +1003,8 @@ void DeviceContext::ExecuteWorkerThreadStepSharedExecutionThreadSpinoff()
 			}
 		}
 
+		spinoffThreadTargetDevice->TraceTimesliceEnd(traceActive);
+
 		// If our spinoff thread has been requested to rejoin the main execution thread,
 		// restart the loop in order to process the request.
 		if (primaryDevice->_sharedExecuteThreadSpinoffRejoinRequested)
@@ -888,6 +1023,7 @@ void DeviceContext::ExecuteWorkerThreadStepSharedExecutionThreadSpinoff()
 		primaryDeviceLock.lock();
 		spinoffThreadTargetDevice->_timesliceSuspended = false;
 		spinoffThreadTargetDevice->_timesliceCompleted = true;
+		spinoffThreadTargetDevice->RecordTimesliceCompleted();
 		primaryDeviceLock.unlock();
 		WakeSuspendedDevicesIfRequired();
 		primaryDeviceLock.lock();
@@ -913,14 +1049,17 @@ void DeviceContext::ExecuteWorkerThreadTimeslice()
 	while (_executeWorkerThreadActive)
 	{
 		lock.unlock();
+		bool traceActive = TraceTimesliceBegin();
 		_device.ExecuteTimeslice(_timeslice);
 		_remainingTime = 0;
 		_currentTimesliceProgress = _timeslice;
 		_device.NotifyAfterExecuteStepFinishedTimeslice();
+		TraceTimesliceEnd(traceActive);
 		lock.lock();
 
 		_timesliceSuspended = false;
 		_timesliceCompleted = true;
+		RecordTimesliceCompleted();
 		lock.unlock();
 		WakeSuspendedDevicesIfRequired();
 		lock.lock();
@@ -947,10 +1086,12 @@ void DeviceContext::ExecuteWorkerThreadTimesliceWithDependencies()
 	while (_executeWorkerThreadActive)
 	{
 		lock.unlock();
+		bool traceActive = TraceTimesliceBegin();
 		_device.ExecuteTimeslice(_timeslice);
 		_remainingTime = 0;
 		_currentTimesliceProgress = _timeslice;
 		_device.NotifyAfterExecuteStepFinishedTimeslice();
+		TraceTimesliceEnd(traceActive);
 		lock.lock();
 
 		unsigned int dependentTargetCount = (unsigned int)_deviceDependencies.size();
@@ -966,6 +1107,7 @@ void DeviceContext::ExecuteWorkerThreadTimesliceWithDependencies()
 
 		_timesliceSuspended = false;
 		_timesliceCompleted = true;
+		RecordTimesliceCompleted();
 		lock.unlock();
 		WakeSuspendedDevicesIfRequired();
 		lock.lock();
@@ -30,6 +30,7 @@ conditional, which unlocks the calling thread.
 #include "ThreadLib/ThreadLib.pkg"
 #include "SystemInterface/SystemInterface.pkg"
 #include "IExecutionSuspendManager.h"
+#include "ExecutionProfileTimer.h"
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
@@ -59,12 +60,22 @@ public:
 	inline void WaitForCompletion();
 	inline void Commit();
 	inline void Rollback();
+	inline bool UsesParallelCommit() const;
 	inline void Initialize();
 
+	// Cooperative execute functions
+	inline void BeginCooperativeTimeslice(double nanoseconds);
+	inline bool CooperativeTimesliceCompleted() const;
+	inline bool CooperativeStepPending() const;
+	inline void ExecuteCooperativeStep();
+	void ExecuteCooperativeTimeslice();
+	void CompleteCooperativeTimeslice();
+
 	// Timing functions
 	virtual double GetCurrentTimesliceProgress() const;
 	virtual void SetCurrentTimesliceProgress(double executionProgress);
 	inline double GetNextTimingPoint(unsigned int& accessContext) const;
+	inline bool UsesTimingPoints() const;
 	inline double GetCurrentRemainingTime() const;
 	inline double GetInitialRemainingTime() const;
 	inline void ClearRemainingTime();
@@ -76,6 +87,8 @@ public:
 	// Worker thread control
 	void StartExecution();
 	void StopExecution();
+	void StartCooperativeExecution();
+	void StopCooperativeExecution();
 
 	// Device interface
 	virtual IDevice& GetTargetDevice() const;
@@ -114,6 +127,12 @@ public:
 	inline const std::vector<DeviceDependency>& GetDeviceDependencyArray() const;
 	inline const std::vector<DeviceContext*>& GetDependentDeviceArray() const;
 
+	// Profiling functions
+	inline void NotifyRollbackRequested();
+	inline void NotifyRollbackTriggered();
+	void GetExecutionProfile(ISystemGUIInterface::ExecutionProfileDeviceEntry& profileEntry) const;
+	void ResetExecutionProfile();
+
 private:
 	// Execute worker thread control
 	void StartExecuteWorkerThread();
@@ -127,6 +146,9 @@ private:
 	void ExecuteWorkerThreadTimesliceWithDependencies();
 	void WakeSuspendedDevicesIfRequired();
 	void ClearSuspendManagerState();
+	inline void RecordTimesliceCompleted();
+	inline bool TraceTimesliceBegin() const;
+	inline void TraceTimesliceEnd(bool traceActive) const;
 
 	// Dependent device functions
 	inline void AddDependentDevice(DeviceContext* targetDevice);
@@ -141,7 +163,7 @@ private:
 	std::vector<DeviceContext*> _dependentDevices;
 
 	// Execute worker thread data
-	bool _executeWorkerThreadActive;
+	std::atomic<bool> _executeWorkerThreadActive;
 	mutable std::mutex _executeThreadMutex;
 	std::condition_variable _executeTaskSent;
 	mutable std::condition_variable _executeCompletionStateChanged;
@@ -151,6 +173,7 @@ private:
 	std::atomic<unsigned int>* _executingThreadCount;
 	std::atomic<unsigned int>* _suspendedThreadCount;
 	IExecutionSuspendManager* _suspendManager;
+	bool _cooperativeExecutionActive;
 
 	volatile bool _timesliceCompleted;
 	volatile bool _timesliceSuspended;
@@ -176,6 +199,22 @@ private:
 	std::condition_variable _sharedExecuteThreadSpinoffStoppedOrPaused;
 	std::condition_variable _sharedExecuteThreadSpinoffTimesliceProcessingBegun;
 
+	// Profiling data
+	ExecutionProfileTimer::Clock::time_point _profileTimesliceStartTime;
+	ExecutionProfileTimer _profileTimesliceTimer;
+	ExecutionProfileTimer _profileTimingPointStepTimer;
+	mutable ExecutionProfileTimer _profileSuspendWaitTimer;
+	ExecutionProfileTimer _profileCommitTimer;
+	ExecutionProfileTimer _profileRollbackTimer;
+	std::atomic<unsigned long long> _profileSuspendCount;
+	std::atomic<unsigned long long> _profileResumeCount;
+	std::atomic<unsigned long long> _profileRollbackRequestCount;
+	std::atomic<unsigned long long> _profileRollbackTriggerCount;
+
+	// Trace data
+	ITraceRecorder& _traceRecorder;
+	std::string _traceTimesliceEventName;
+
 	// Callback parameters
 	ISystemGUIInterface& _systemObject;
 };
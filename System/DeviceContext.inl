@@ -13,12 +13,13 @@ struct DeviceContext::DeviceDependency
 // Constructors
 //----------------------------------------------------------------------------------------------------------------------
 DeviceContext::DeviceContext(IDevice& device, ISystemGUIInterface& systemObject)
-:_device(device), _systemObject(systemObject), _deviceDependencies(0), _executingThreadCount(0), _suspendedThreadCount(0), _suspendManager(0), _otherSharedExecuteThreadDevice(0), _currentSharedExecuteThreadOwner(0)
+:_device(device), _systemObject(systemObject), _deviceDependencies(0), _executingThreadCount(0), _suspendedThreadCount(0), _suspendManager(0), _otherSharedExecuteThreadDevice(0), _currentSharedExecuteThreadOwner(0), _profileSuspendCount(0), _profileResumeCount(0), _profileRollbackRequestCount(0), _profileRollbackTriggerCount(0), _traceRecorder(systemObject.GetTraceRecorder())
 {
 	_deviceIndexNo = 0;
 	_deviceEnabled = true;
 	_executeWorkerThreadActive = false;
 	_executeThreadRunningState = false;
+	_cooperativeExecutionActive = false;
 
 	_timesliceCompleted = false;
 	_timesliceSuspended = false;
@@ -85,6 +86,7 @@ void DeviceContext::BeginExecuteTimeslice(double nanoseconds, std::atomic<unsign
 	std::unique_lock<std::mutex> lock(_executeThreadMutex);
 	_timeslice = nanoseconds;
 	_timesliceCompleted = false;
+	_profileTimesliceStartTime = ExecutionProfileTimer::Now();
 	_executingThreadCount = executingThreadCount;
 	_suspendedThreadCount = suspendedThreadCount;
 	_suspendManager = suspendManager;
@@ -108,6 +110,7 @@ double DeviceContext::ExecuteStep()
 //----------------------------------------------------------------------------------------------------------------------
 double DeviceContext::ExecuteStep(unsigned int accessContext)
 {
+	ExecutionProfileTimer::Clock::time_point stepStartTime = ExecutionProfileTimer::Now();
 	double additionalTime = 0;
 
 	if (_device.GetUpdateMethod() == IDevice::UpdateMethod::Step)
@@ -120,6 +123,7 @@ double DeviceContext::ExecuteStep(unsigned int accessContext)
 		_device.ExecuteTimesliceTimingPointStep(accessContext);
 	}
 
+	_profileTimingPointStepTimer.AddSample(stepStartTime);
 	return additionalTime;
 }
 
@@ -136,15 +140,25 @@ void DeviceContext::WaitForCompletion()
 //----------------------------------------------------------------------------------------------------------------------
 void DeviceContext::Commit()
 {
+	ExecutionProfileTimer::Clock::time_point commitStartTime = ExecutionProfileTimer::Now();
 	_remainingTimeBackup = _remainingTime;
 	_device.ExecuteCommit();
+	_profileCommitTimer.AddSample(commitStartTime);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void DeviceContext::Rollback()
 {
+	ExecutionProfileTimer::Clock::time_point rollbackStartTime = ExecutionProfileTimer::Now();
 	_remainingTime = _remainingTimeBackup;
 	_device.ExecuteRollback();
+	_profileRollbackTimer.AddSample(rollbackStartTime);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool DeviceContext::UsesParallelCommit() const
+{
+	return _device.UsesParallelCommit();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -155,6 +169,44 @@ void DeviceContext::Initialize()
 	_currentTimesliceProgress = 0;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Cooperative execute functions
+//----------------------------------------------------------------------------------------------------------------------
+void DeviceContext::BeginCooperativeTimeslice(double nanoseconds)
+{
+	// Note that no suspend manager is provided to the device in cooperative mode. All
+	// devices are advanced from the one thread, so there's nothing which could release a
+	// suspended device, and execution suspend remains disabled for the whole timeslice.
+	_timeslice = nanoseconds;
+	_timesliceCompleted = false;
+	_profileTimesliceStartTime = ExecutionProfileTimer::Now();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool DeviceContext::CooperativeTimesliceCompleted() const
+{
+	return _timesliceCompleted;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool DeviceContext::CooperativeStepPending() const
+{
+	return (_currentTimesliceProgress < _timeslice);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DeviceContext::ExecuteCooperativeStep()
+{
+	_currentTimesliceProgress += _device.ExecuteStep();
+	if (_systemObject.IsSystemRollbackFlagged())
+	{
+		if (_currentTimesliceProgress >= _systemObject.SystemRollbackTime())
+		{
+			_currentTimesliceProgress = _timeslice;
+		}
+	}
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Timing functions
 //----------------------------------------------------------------------------------------------------------------------
@@ -178,6 +230,12 @@ double DeviceContext::GetNextTimingPoint(unsigned int& accessContext) const
 	return result;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+bool DeviceContext::UsesTimingPoints() const
+{
+	return _device.UsesTimingPoints();
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 double DeviceContext::GetCurrentRemainingTime() const
 {
@@ -286,3 +344,47 @@ const std::vector<DeviceContext*>& DeviceContext::GetDependentDeviceArray() cons
 {
 	return _dependentDevices;
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Profiling functions
+//----------------------------------------------------------------------------------------------------------------------
+void DeviceContext::NotifyRollbackRequested()
+{
+	_profileRollbackRequestCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DeviceContext::NotifyRollbackTriggered()
+{
+	_profileRollbackTriggerCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DeviceContext::RecordTimesliceCompleted()
+{
+	_profileTimesliceTimer.AddSample(_profileTimesliceStartTime);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Trace functions
+//----------------------------------------------------------------------------------------------------------------------
+bool DeviceContext::TraceTimesliceBegin() const
+{
+	// Note that we return the recording state we saw here, so that the caller only records
+	// the matching end event if the begin event was recorded.
+	if (!_traceRecorder.TraceRecordingEnabled())
+	{
+		return false;
+	}
+	_traceRecorder.RecordTraceEvent(ITraceRecorder::EventType::Begin, _traceTimesliceEventName.c_str());
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DeviceContext::TraceTimesliceEnd(bool traceActive) const
+{
+	if (traceActive)
+	{
+		_traceRecorder.RecordTraceEvent(ITraceRecorder::EventType::End, _traceTimesliceEventName.c_str());
+	}
+}
@@ -0,0 +1,151 @@
+#include "EventLogBuffer.h"
+#include <thread>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+EventLogBuffer::EventLogBuffer(unsigned int size)
+:_size((size < 1)? 1: size), _slots(new Slot[(size < 1)? 1: size]), _nextEntryNo(0), _firstEntryNo(0)
+{ }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Size functions
+//----------------------------------------------------------------------------------------------------------------------
+void EventLogBuffer::SetSize(unsigned int size)
+{
+	// Allocate the new ring buffer, and move across the most recent entries from the
+	// current buffer which fit within the new size.
+	size = (size < 1)? 1: size;
+	std::unique_ptr<Slot[]> newSlots(new Slot[size]);
+	_lock.ObtainWriteLock();
+	unsigned int nextEntryNo = _nextEntryNo.load();
+	for (unsigned int i = 0; i < _size; ++i)
+	{
+		Slot& slot = _slots[i];
+		if (slot.entryPresent && ((nextEntryNo - slot.entryNo) <= size))
+		{
+			Slot& newSlot = newSlots[slot.entryNo % size];
+			newSlot.entryPresent = true;
+			newSlot.entryNo = slot.entryNo;
+			newSlot.eventLevel = slot.eventLevel;
+			newSlot.sourceID = slot.sourceID;
+			newSlot.text.swap(slot.text);
+			newSlot.eventTimeString.swap(slot.eventTimeString);
+		}
+	}
+
+	// Only the most recent entries which fit within both the old and new sizes have been
+	// retained, so advance the first entry number past any entries which have been
+	// discarded. If the buffer has grown, the entries before this point were already
+	// overwritten in the old buffer, and their slots in the new buffer are empty. Without
+	// this, a read from an entry number before this point would stop at the first empty
+	// slot, and never reach the entries which were retained.
+	unsigned int retainedEntryCount = (_size < size)? _size: size;
+	unsigned int oldestRetainedEntryNo = nextEntryNo - retainedEntryCount;
+	if ((int)(oldestRetainedEntryNo - _firstEntryNo) > 0)
+	{
+		_firstEntryNo = oldestRetainedEntryNo;
+	}
+	_slots.swap(newSlots);
+	_size = size;
+	_lock.ReleaseWriteLock();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Entry functions
+//----------------------------------------------------------------------------------------------------------------------
+void EventLogBuffer::WriteEntry(ILogEntry::EventLevel eventLevel, unsigned int sourceID, std::wstring& text, std::wstring& eventTimeString)
+{
+	// Claim the next entry number, and lock the slot it maps to. The slot lock is only
+	// ever contended if a reader is copying the same slot, or the buffer has wrapped
+	// around completely while a previous writer to this slot was still working, so a spin
+	// lock is appropriate here.
+	_lock.ObtainReadLock();
+	unsigned int entryNo = _nextEntryNo.fetch_add(1);
+	Slot& slot = _slots[entryNo % _size];
+	while (slot.entryLocked.test_and_set(std::memory_order_acquire))
+	{
+		std::this_thread::yield();
+	}
+
+	// Write our entry to the slot, unless a writer with a later entry number mapping to
+	// this slot beat us to it, in which case our entry has already been discarded. Note
+	// that we swap in the supplied strings rather than copying them, so the only work
+	// done while we hold the slot is a pointer exchange.
+	if (!slot.entryPresent || ((int)(entryNo - slot.entryNo) > 0))
+	{
+		slot.entryPresent = true;
+		slot.entryNo = entryNo;
+		slot.eventLevel = eventLevel;
+		slot.sourceID = sourceID;
+		slot.text.swap(text);
+		slot.eventTimeString.swap(eventTimeString);
+	}
+	slot.entryLocked.clear(std::memory_order_release);
+	_lock.ReleaseReadLock();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int EventLogBuffer::ReadEntries(unsigned int firstEntryNo, std::vector<Entry>& entries) const
+{
+	_lock.ObtainReadLock();
+
+	// Skip any requested entries which have been cleared, or which have been overwritten
+	// since the caller last read the log.
+	unsigned int nextEntryNo = _nextEntryNo.load();
+	if ((int)(_firstEntryNo - firstEntryNo) > 0)
+	{
+		firstEntryNo = _firstEntryNo;
+	}
+	if ((nextEntryNo - firstEntryNo) > _size)
+	{
+		firstEntryNo = nextEntryNo - _size;
+	}
+
+	// Copy each entry in the requested range. If we reach an entry which has been claimed
+	// but not yet written, we stop there, and the caller picks up from that entry on the
+	// next read.
+	entries.reserve(entries.size() + (nextEntryNo - firstEntryNo));
+	unsigned int entryNo = firstEntryNo;
+	while (entryNo != nextEntryNo)
+	{
+		Slot& slot = _slots[entryNo % _size];
+		while (slot.entryLocked.test_and_set(std::memory_order_acquire))
+		{
+			std::this_thread::yield();
+		}
+		bool entryPending = !slot.entryPresent || ((int)(entryNo - slot.entryNo) > 0);
+		if (!entryPending && (slot.entryNo == entryNo))
+		{
+			Entry entry;
+			entry.eventLevel = slot.eventLevel;
+			entry.sourceID = slot.sourceID;
+			entry.text = slot.text;
+			entry.eventTimeString = slot.eventTimeString;
+			entries.push_back(entry);
+		}
+		slot.entryLocked.clear(std::memory_order_release);
+		if (entryPending)
+		{
+			break;
+		}
+		++entryNo;
+	}
+
+	_lock.ReleaseReadLock();
+	return entryNo;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void EventLogBuffer::Clear()
+{
+	_lock.ObtainWriteLock();
+	for (unsigned int i = 0; i < _size; ++i)
+	{
+		_slots[i].entryPresent = false;
+		_slots[i].text.clear();
+		_slots[i].eventTimeString.clear();
+	}
+	_firstEntryNo = _nextEntryNo.load();
+	_lock.ReleaseWriteLock();
+}
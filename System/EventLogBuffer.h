@@ -0,0 +1,51 @@
+#ifndef __EVENTLOGBUFFER_H__
+#define __EVENTLOGBUFFER_H__
+#include "DeviceInterface/DeviceInterface.pkg"
+#include "ThreadLib/ThreadLib.pkg"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Holds the system event log as a fixed size ring buffer. Each entry is assigned an
+// incrementing entry number as it's written, and entry number N is held in slot
+// (N % size). Writers only hold a read lock on the buffer, and claim a slot with an atomic
+// increment of the next entry number. The write lock is only taken when the buffer itself
+// needs to be cleared or reallocated. Readers request entries from a given entry number
+// onwards, and are returned the entry number to continue from on their next read, so that
+// they only need to copy entries which have been written since they last read the log.
+// Note that entry numbers wrap around, so all comparisons between entry numbers are made
+// on the signed difference between them.
+class EventLogBuffer
+{
+public:
+	// Structures
+	struct Entry;
+
+public:
+	// Constructors
+	explicit EventLogBuffer(unsigned int size);
+
+	// Size functions
+	inline unsigned int GetSize() const;
+	void SetSize(unsigned int size);
+
+	// Entry functions
+	void WriteEntry(ILogEntry::EventLevel eventLevel, unsigned int sourceID, std::wstring& text, std::wstring& eventTimeString);
+	unsigned int ReadEntries(unsigned int firstEntryNo, std::vector<Entry>& entries) const;
+	void Clear();
+
+private:
+	// Structures
+	struct Slot;
+
+private:
+	mutable ReadWriteLock _lock;
+	unsigned int _size;
+	std::unique_ptr<Slot[]> _slots;
+	std::atomic<unsigned int> _nextEntryNo;
+	unsigned int _firstEntryNo;
+};
+
+#include "EventLogBuffer.inl"
+#endif
@@ -0,0 +1,36 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Structures
+//----------------------------------------------------------------------------------------------------------------------
+struct EventLogBuffer::Entry
+{
+	ILogEntry::EventLevel eventLevel;
+	unsigned int sourceID;
+	std::wstring text;
+	std::wstring eventTimeString;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+struct EventLogBuffer::Slot
+{
+	Slot()
+	:entryPresent(false), entryNo(0), eventLevel(ILogEntry::EventLevel::Info), sourceID(0)
+	{
+		entryLocked.clear();
+	}
+
+	std::atomic_flag entryLocked;
+	bool entryPresent;
+	unsigned int entryNo;
+	ILogEntry::EventLevel eventLevel;
+	unsigned int sourceID;
+	std::wstring text;
+	std::wstring eventTimeString;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Size functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int EventLogBuffer::GetSize() const
+{
+	return _size;
+}
@@ -1,5 +1,104 @@
 #include "ExecutionManager.h"
 
+//----------------------------------------------------------------------------------------------------------------------
+// Cooperative execute functions
+//----------------------------------------------------------------------------------------------------------------------
+void ExecutionManager::ExecuteTimesliceCooperative(double nanoseconds)
+{
+	// Ensure execution suspend is disabled for all devices which support it. There are no
+	// other threads in this mode which could release a suspended device, so a device
+	// which attempted to suspend would wait forever.
+	DisableTimesliceExecutionSuspend();
+
+	// Start all devices on the new timeslice
+	for (unsigned int i = 0; i < _activeDeviceCount; ++i)
+	{
+		_activeDeviceArray[i]->BeginCooperativeTimeslice(nanoseconds);
+	}
+
+	// Advance the step devices in timestamp order, by always stepping the device which is
+	// furthest behind. Since no device can get ahead of another by more than a single
+	// step, accesses between step devices occur in order, and dependency waits are never
+	// required between them. If the device we're about to step depends on a timeslice
+	// device which hasn't executed yet, we execute that device's timeslice first, along
+	// with any timeslice devices it depends on in turn, so that it has caught up before
+	// it is accessed.
+	unsigned int stepDeviceCount = (unsigned int)_cooperativeStepDeviceArray.size();
+	while (true)
+	{
+		DeviceContext* nextDevice = 0;
+		for (unsigned int i = 0; i < stepDeviceCount; ++i)
+		{
+			DeviceContext* device = _cooperativeStepDeviceArray[i];
+			if (device->CooperativeStepPending() && ((nextDevice == 0) || (device->GetCurrentTimesliceProgress() < nextDevice->GetCurrentTimesliceProgress())))
+			{
+				nextDevice = device;
+			}
+		}
+		if (nextDevice == 0)
+		{
+			break;
+		}
+
+		const std::vector<DeviceContext::DeviceDependency>& deviceDependencies = nextDevice->GetDeviceDependencyArray();
+		for (unsigned int i = 0; i < (unsigned int)deviceDependencies.size(); ++i)
+		{
+			DeviceContext* dependencyDevice = deviceDependencies[i].device;
+			if (deviceDependencies[i].dependencyEnabled && (dependencyDevice->GetTargetDevice().GetUpdateMethod() == IDevice::UpdateMethod::Timeslice))
+			{
+				ExecuteCooperativeTimesliceWithDependencies(dependencyDevice);
+			}
+		}
+
+		nextDevice->ExecuteCooperativeStep();
+	}
+	for (unsigned int i = 0; i < stepDeviceCount; ++i)
+	{
+		_cooperativeStepDeviceArray[i]->CompleteCooperativeTimeslice();
+	}
+
+	// Execute the timeslice for any timeslice devices which haven't already been caught up
+	// above, as a single batch. Each device executes after the timeslice devices it
+	// depends on, regardless of the order the devices were added in, so a device never
+	// accesses another timeslice device which is still at the start of the timeslice.
+	unsigned int timesliceDeviceCount = (unsigned int)_cooperativeTimesliceDeviceArray.size();
+	for (unsigned int i = 0; i < timesliceDeviceCount; ++i)
+	{
+		ExecuteCooperativeTimesliceWithDependencies(_cooperativeTimesliceDeviceArray[i]);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ExecutionManager::ExecuteCooperativeTimesliceWithDependencies(DeviceContext* device)
+{
+	// If this device has already executed its timeslice, or we're already part way through
+	// executing its dependencies further up the call chain, there's nothing to do here.
+	// Devices which depend on each other in a cycle have no order which satisfies all
+	// their dependencies, so they execute in the order we first reach them.
+	if (device->CooperativeTimesliceCompleted() || (std::find(_cooperativeDependencyPath.begin(), _cooperativeDependencyPath.end(), device) != _cooperativeDependencyPath.end()))
+	{
+		return;
+	}
+
+	// Execute any enabled timeslice devices this device depends on first. Step devices it
+	// depends on are advanced in timestamp order by the caller, so we don't follow them
+	// here.
+	_cooperativeDependencyPath.push_back(device);
+	const std::vector<DeviceContext::DeviceDependency>& deviceDependencies = device->GetDeviceDependencyArray();
+	for (unsigned int i = 0; i < (unsigned int)deviceDependencies.size(); ++i)
+	{
+		DeviceContext* dependencyDevice = deviceDependencies[i].device;
+		if (deviceDependencies[i].dependencyEnabled && (dependencyDevice->GetTargetDevice().GetUpdateMethod() == IDevice::UpdateMethod::Timeslice))
+		{
+			ExecuteCooperativeTimesliceWithDependencies(dependencyDevice);
+		}
+	}
+	_cooperativeDependencyPath.pop_back();
+
+	// Execute the timeslice for this device
+	device->ExecuteCooperativeTimeslice();
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Suspend functions
 //----------------------------------------------------------------------------------------------------------------------
@@ -29,11 +128,13 @@ bool ExecutionManager::AllDevicesSuspended(unsigned int executingThreadCount, un
 {
 	// Go through each device that supports transient execution, and see if any of them are
 	// currently executing.
+	ExecutionProfileTimer::Clock::time_point checkStartTime = ExecutionProfileTimer::Now();
 	for (size_t transientDeviceNo = 0; transientDeviceNo < _transientDeviceCount; ++transientDeviceNo)
 	{
 		const DeviceContext* transientDevice = _transientDeviceArray[transientDeviceNo];
 		if (!transientDevice->TimesliceExecutionSuspended() && transientDevice->TransientExecutionActive())
 		{
+			_profileSuspendCheckTimer.AddSample(checkStartTime);
 			return false;
 		}
 	}
@@ -59,6 +160,11 @@ bool ExecutionManager::AllDevicesSuspended(unsigned int executingThreadCount, un
 	// Determine if all remaining devices are blocked or suspended, and return the result
 	// to the caller.
 	bool allDevicesBlocked = ((unsigned int)executingThreadCount == blockedDeviceCount);
+	_profileSuspendCheckTimer.AddSample(checkStartTime);
+	if (allDevicesBlocked)
+	{
+		_profileSuspendReleaseCount.fetch_add(1, std::memory_order_relaxed);
+	}
 	return allDevicesBlocked;
 }
 
@@ -77,3 +183,73 @@ void ExecutionManager::BuildBlockedDependentDeviceSet(const DeviceContext* sourc
 		}
 	}
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Profiling functions
+//----------------------------------------------------------------------------------------------------------------------
+void ExecutionManager::GetExecutionProfile(ISystemGUIInterface::ExecutionProfile& profile) const
+{
+	profile.notifyUpcomingTimesliceCount = _profileNotifyUpcomingTimesliceTimer.GetSampleCount();
+	profile.notifyUpcomingTimesliceNanoseconds = _profileNotifyUpcomingTimesliceTimer.GetTotalNanoseconds();
+	profile.executeTimesliceCount = _profileExecuteTimesliceTimer.GetSampleCount();
+	profile.executeTimesliceNanoseconds = _profileExecuteTimesliceTimer.GetTotalNanoseconds();
+	profile.commitCount = _profileCommitTimer.GetSampleCount();
+	profile.commitNanoseconds = _profileCommitTimer.GetTotalNanoseconds();
+	profile.rollbackCount = _profileRollbackTimer.GetSampleCount();
+	profile.rollbackNanoseconds = _profileRollbackTimer.GetTotalNanoseconds();
+	profile.timingPointSearchCount = _profileTimingPointSearchTimer.GetSampleCount();
+	profile.timingPointSearchNanoseconds = _profileTimingPointSearchTimer.GetTotalNanoseconds();
+	profile.timingPointStepCount = _profileTimingPointStepTimer.GetSampleCount();
+	profile.timingPointStepNanoseconds = _profileTimingPointStepTimer.GetTotalNanoseconds();
+	profile.suspendCheckCount = _profileSuspendCheckTimer.GetSampleCount();
+	profile.suspendCheckNanoseconds = _profileSuspendCheckTimer.GetTotalNanoseconds();
+	profile.suspendReleaseCount = _profileSuspendReleaseCount.load(std::memory_order_relaxed);
+
+	// Return the timeslice length histogram, trimmed after the last bucket in use.
+	unsigned int usedBucketCount = 0;
+	for (unsigned int i = 0; i < TimesliceLengthHistogramBucketCount; ++i)
+	{
+		if (_profileTimesliceLengthHistogram[i].load(std::memory_order_relaxed) != 0)
+		{
+			usedBucketCount = i + 1;
+		}
+	}
+	profile.timesliceLengthHistogram.resize(usedBucketCount);
+	for (unsigned int i = 0; i < usedBucketCount; ++i)
+	{
+		profile.timesliceLengthHistogram[i] = _profileTimesliceLengthHistogram[i].load(std::memory_order_relaxed);
+	}
+
+	// Collect the profile data for each device. Note that the per-device statistics are
+	// all atomic, so we only need to hold the profile device list lock here, and don't
+	// need to wait for the current timeslice to complete.
+	std::lock_guard<std::mutex> lock(_profileDeviceMutex);
+	profile.devices.resize(_profileDeviceArray.size());
+	for (size_t i = 0; i < _profileDeviceArray.size(); ++i)
+	{
+		_profileDeviceArray[i]->GetExecutionProfile(profile.devices[i]);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ExecutionManager::ResetExecutionProfile()
+{
+	_profileNotifyUpcomingTimesliceTimer.Reset();
+	_profileExecuteTimesliceTimer.Reset();
+	_profileCommitTimer.Reset();
+	_profileRollbackTimer.Reset();
+	_profileTimingPointSearchTimer.Reset();
+	_profileTimingPointStepTimer.Reset();
+	_profileSuspendCheckTimer.Reset();
+	_profileSuspendReleaseCount.store(0, std::memory_order_relaxed);
+	for (unsigned int i = 0; i < TimesliceLengthHistogramBucketCount; ++i)
+	{
+		_profileTimesliceLengthHistogram[i].store(0, std::memory_order_relaxed);
+	}
+
+	std::lock_guard<std::mutex> lock(_profileDeviceMutex);
+	for (size_t i = 0; i < _profileDeviceArray.size(); ++i)
+	{
+		_profileDeviceArray[i]->ResetExecutionProfile();
+	}
+}
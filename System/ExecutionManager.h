@@ -5,8 +5,12 @@
 #include "ThreadLib/ThreadLib.pkg"
 #include "DeviceContext.h"
 #include "IExecutionSuspendManager.h"
+#include "ExecutionProfileTimer.h"
+#include "ExecutionWorkerPool.h"
 #include <vector>
+#include <algorithm>
 #include <mutex>
+#include <thread>
 
 class ExecutionManager : public IExecutionSuspendManager
 {
@@ -23,6 +27,7 @@ public:
 	inline void NotifyUpcomingTimeslice(double nanoseconds);
 	inline void NotifyBeforeExecuteCalled();
 	inline void NotifyAfterExecuteCalled();
+	inline void NotifyAfterExecuteStepFinishedTimeslice();
 	inline void ExecuteTimeslice(double nanoseconds);
 	inline void Commit();
 	inline void Rollback();
@@ -43,18 +48,74 @@ public:
 	inline void StartExecution();
 	inline void StopExecution();
 
+	// Execution mode functions
+	inline bool GetCooperativeExecutionEnabled() const;
+	inline void SetCooperativeExecutionEnabled(bool state);
+	inline unsigned int GetWorkerThreadCount() const;
+	inline void SetWorkerThreadCount(unsigned int workerThreadCount);
+
+	// Profiling functions
+	inline void AddTimingPointStepSample(ExecutionProfileTimer::Clock::time_point stepStartTime);
+	void GetExecutionProfile(ISystemGUIInterface::ExecutionProfile& profile) const;
+	void ResetExecutionProfile();
+
+private:
+	// Constants
+	static const unsigned int TimesliceLengthHistogramBucketCount = 32;
+
+private:
+	// Cooperative execute functions
+	void ExecuteTimesliceCooperative(double nanoseconds);
+	void ExecuteCooperativeTimesliceWithDependencies(DeviceContext* device);
+
+	// Profiling functions
+	static inline unsigned int GetTimesliceLengthHistogramBucket(double nanoseconds);
+
 private:
-	std::mutex _accessMutex;
+	mutable std::mutex _accessMutex;
 	unsigned int _deviceCount;
 	unsigned int _activeDeviceCount;
 	unsigned int _suspendDeviceCount;
 	unsigned int _transientDeviceCount;
+	unsigned int _timingPointDeviceCount;
+	unsigned int _parallelCommitDeviceCount;
+	unsigned int _serialCommitDeviceCount;
 	std::vector<DeviceContext*> _deviceArray;
 	std::vector<DeviceContext*> _activeDeviceArray;
 	std::vector<DeviceContext*> _suspendDeviceArray;
 	std::vector<DeviceContext*> _transientDeviceArray;
+	std::vector<DeviceContext*> _timingPointDeviceArray;
+	std::vector<DeviceContext*> _parallelCommitDeviceArray;
+	std::vector<DeviceContext*> _serialCommitDeviceArray;
 	std::vector<unsigned int> _nextTimesliceContextValues;
 	std::vector<double> _nextTimesliceValues;
+	ExecutionWorkerPool _workerPool;
+	ExecutionWorkerPool _deviceControlPool;
+
+	// Cooperative execution data
+	std::atomic<bool> _cooperativeExecutionEnabled;
+	bool _cooperativeExecutionActive;
+	std::vector<DeviceContext*> _cooperativeStepDeviceArray;
+	std::vector<DeviceContext*> _cooperativeTimesliceDeviceArray;
+	std::vector<DeviceContext*> _cooperativeDependencyPath;
+
+	// Profiling data
+	ExecutionProfileTimer _profileNotifyUpcomingTimesliceTimer;
+	ExecutionProfileTimer _profileExecuteTimesliceTimer;
+	ExecutionProfileTimer _profileCommitTimer;
+	ExecutionProfileTimer _profileRollbackTimer;
+	ExecutionProfileTimer _profileTimingPointSearchTimer;
+	ExecutionProfileTimer _profileTimingPointStepTimer;
+	mutable ExecutionProfileTimer _profileSuspendCheckTimer;
+	mutable std::atomic<unsigned long long> _profileSuspendReleaseCount;
+	std::atomic<unsigned long long> _profileTimesliceLengthHistogram[TimesliceLengthHistogramBucketCount];
+
+	// Note that the access mutex is held for the duration of each timeslice, so profile
+	// queries use their own copy of the device list, guarded by a separate lock which is
+	// only held while the list is copied or read. The device list is republished
+	// whenever a device is added or removed.
+	mutable std::mutex _profileDeviceMutex;
+	std::vector<DeviceContext*> _profileDeviceArray;
 };
 
 #include "ExecutionManager.inl"
@@ -2,8 +2,13 @@
 // Constructors
 //----------------------------------------------------------------------------------------------------------------------
 ExecutionManager::ExecutionManager()
-:_deviceCount(0), _activeDeviceCount(0), _suspendDeviceCount(0), _transientDeviceCount(0)
-{ }
+:_deviceCount(0), _activeDeviceCount(0), _suspendDeviceCount(0), _transientDeviceCount(0), _timingPointDeviceCount(0), _parallelCommitDeviceCount(0), _serialCommitDeviceCount(0), _deviceControlPool(0), _cooperativeExecutionEnabled(false), _cooperativeExecutionActive(false), _profileSuspendReleaseCount(0)
+{
+	for (unsigned int i = 0; i < TimesliceLengthHistogramBucketCount; ++i)
+	{
+		_profileTimesliceLengthHistogram[i].store(0, std::memory_order_relaxed);
+	}
+}
 
 //----------------------------------------------------------------------------------------------------------------------
 // Device functions
@@ -25,16 +30,35 @@ void ExecutionManager::AddDevice(DeviceContext* device)
 	{
 		_transientDeviceArray.push_back(device);
 	}
+	if (device->UsesTimingPoints())
+	{
+		_timingPointDeviceArray.push_back(device);
+	}
+	if (device->UsesParallelCommit())
+	{
+		_parallelCommitDeviceArray.push_back(device);
+	}
+	else
+	{
+		_serialCommitDeviceArray.push_back(device);
+	}
 
 	// Update the device counts
 	_deviceCount = (unsigned int)_deviceArray.size();
 	_activeDeviceCount = (unsigned int)_activeDeviceArray.size();
 	_suspendDeviceCount = (unsigned int)_suspendDeviceArray.size();
 	_transientDeviceCount = (unsigned int)_transientDeviceArray.size();
+	_timingPointDeviceCount = (unsigned int)_timingPointDeviceArray.size();
+	_parallelCommitDeviceCount = (unsigned int)_parallelCommitDeviceArray.size();
+	_serialCommitDeviceCount = (unsigned int)_serialCommitDeviceArray.size();
+
+	// Resize the timing point results arrays
+	_nextTimesliceValues.resize(_timingPointDeviceCount);
+	_nextTimesliceContextValues.resize(_timingPointDeviceCount);
 
-	// Resize the message results array
-	_nextTimesliceValues.resize(_deviceCount);
-	_nextTimesliceContextValues.resize(_deviceCount);
+	// Publish the new device list for profiling
+	std::lock_guard<std::mutex> profileLock(_profileDeviceMutex);
+	_profileDeviceArray = _deviceArray;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -108,15 +132,70 @@ void ExecutionManager::RemoveDevice(DeviceContext* device)
 		}
 	}
 
+	// Remove the specified device from the timing point device array
+	done = false;
+	i = _timingPointDeviceArray.begin();
+	while (!done && (i != _timingPointDeviceArray.end()))
+	{
+		if (*i == device)
+		{
+			_timingPointDeviceArray.erase(i);
+			done = true;
+		}
+		else
+		{
+			++i;
+		}
+	}
+
+	// Remove the specified device from the parallel commit device array
+	done = false;
+	i = _parallelCommitDeviceArray.begin();
+	while (!done && (i != _parallelCommitDeviceArray.end()))
+	{
+		if (*i == device)
+		{
+			_parallelCommitDeviceArray.erase(i);
+			done = true;
+		}
+		else
+		{
+			++i;
+		}
+	}
+
+	// Remove the specified device from the serial commit device array
+	done = false;
+	i = _serialCommitDeviceArray.begin();
+	while (!done && (i != _serialCommitDeviceArray.end()))
+	{
+		if (*i == device)
+		{
+			_serialCommitDeviceArray.erase(i);
+			done = true;
+		}
+		else
+		{
+			++i;
+		}
+	}
+
 	// Update the device counts
 	_deviceCount = (unsigned int)_deviceArray.size();
 	_activeDeviceCount = (unsigned int)_activeDeviceArray.size();
 	_suspendDeviceCount = (unsigned int)_suspendDeviceArray.size();
 	_transientDeviceCount = (unsigned int)_transientDeviceArray.size();
+	_timingPointDeviceCount = (unsigned int)_timingPointDeviceArray.size();
+	_parallelCommitDeviceCount = (unsigned int)_parallelCommitDeviceArray.size();
+	_serialCommitDeviceCount = (unsigned int)_serialCommitDeviceArray.size();
+
+	// Resize the timing point results arrays
+	_nextTimesliceValues.resize(_timingPointDeviceCount);
+	_nextTimesliceContextValues.resize(_timingPointDeviceCount);
 
-	// Resize the message results array
-	_nextTimesliceValues.resize(_deviceCount);
-	_nextTimesliceContextValues.resize(_deviceCount);
+	// Publish the new device list for profiling
+	std::lock_guard<std::mutex> profileLock(_profileDeviceMutex);
+	_profileDeviceArray = _deviceArray;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -128,6 +207,9 @@ void ExecutionManager::ClearAllDevices()
 	_activeDeviceArray.clear();
 	_suspendDeviceArray.clear();
 	_transientDeviceArray.clear();
+	_timingPointDeviceArray.clear();
+	_parallelCommitDeviceArray.clear();
+	_serialCommitDeviceArray.clear();
 	_nextTimesliceValues.clear();
 	_nextTimesliceContextValues.clear();
 
@@ -135,6 +217,14 @@ void ExecutionManager::ClearAllDevices()
 	_deviceCount = 0;
 	_activeDeviceCount = 0;
 	_suspendDeviceCount = 0;
+	_transientDeviceCount = 0;
+	_timingPointDeviceCount = 0;
+	_parallelCommitDeviceCount = 0;
+	_serialCommitDeviceCount = 0;
+
+	// Publish the new device list for profiling
+	std::lock_guard<std::mutex> profileLock(_profileDeviceMutex);
+	_profileDeviceArray.clear();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -143,10 +233,12 @@ void ExecutionManager::ClearAllDevices()
 void ExecutionManager::NotifyUpcomingTimeslice(double nanoseconds)
 {
 	std::lock_guard<std::mutex> lock(_accessMutex);
+	ExecutionProfileTimer::Clock::time_point notifyStartTime = ExecutionProfileTimer::Now();
 	for (unsigned int i = 0; i < _deviceCount; ++i)
 	{
 		_deviceArray[i]->NotifyUpcomingTimeslice(nanoseconds);
 	}
+	_profileNotifyUpcomingTimesliceTimer.AddSample(notifyStartTime);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -169,11 +261,33 @@ void ExecutionManager::NotifyAfterExecuteCalled()
 	}
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void ExecutionManager::NotifyAfterExecuteStepFinishedTimeslice()
+{
+	// Device contexts raise this notification themselves when they finish a timeslice. We
+	// only need to raise it here for single device steps, where no timeslice is executed
+	// through the device contexts, but devices have still been notified of an upcoming
+	// zero-length timeslice.
+	std::lock_guard<std::mutex> lock(_accessMutex);
+	for (unsigned int i = 0; i < _deviceCount; ++i)
+	{
+		_deviceArray[i]->GetTargetDevice().NotifyAfterExecuteStepFinishedTimeslice();
+	}
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void ExecutionManager::ExecuteTimeslice(double nanoseconds)
 {
 	// Enable execution suspend features for devices that support it
 	std::lock_guard<std::mutex> lock(_accessMutex);
+	ExecutionProfileTimer::Clock::time_point executeStartTime = ExecutionProfileTimer::Now();
+	_profileTimesliceLengthHistogram[GetTimesliceLengthHistogramBucket(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+	if (_cooperativeExecutionActive)
+	{
+		ExecuteTimesliceCooperative(nanoseconds);
+		_profileExecuteTimesliceTimer.AddSample(executeStartTime);
+		return;
+	}
 	EnableTimesliceExecutionSuspend();
 
 	// Start all devices executing the new timeslice
@@ -194,26 +308,37 @@ void ExecutionManager::ExecuteTimeslice(double nanoseconds)
 	// suspend may be disabled automatically before the timeslice is completed if all
 	// remaining devices are in the suspend state.
 	DisableTimesliceExecutionSuspend();
+	_profileExecuteTimesliceTimer.AddSample(executeStartTime);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void ExecutionManager::Commit()
 {
+	// Devices which have declared through UsesParallelCommit that their commit only
+	// touches their own state are committed in parallel across the worker pool. All other
+	// devices are committed serially, in the order they were added, as they always have
+	// been.
 	std::lock_guard<std::mutex> lock(_accessMutex);
-	for (unsigned int i = 0; i < _deviceCount; ++i)
+	ExecutionProfileTimer::Clock::time_point commitStartTime = ExecutionProfileTimer::Now();
+	_workerPool.ParallelFor(_parallelCommitDeviceCount, [&](unsigned int i) { _parallelCommitDeviceArray[i]->Commit(); });
+	for (unsigned int i = 0; i < _serialCommitDeviceCount; ++i)
 	{
-		_deviceArray[i]->Commit();
+		_serialCommitDeviceArray[i]->Commit();
 	}
+	_profileCommitTimer.AddSample(commitStartTime);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void ExecutionManager::Rollback()
 {
 	std::lock_guard<std::mutex> lock(_accessMutex);
-	for (unsigned int i = 0; i < _deviceCount; ++i)
+	ExecutionProfileTimer::Clock::time_point rollbackStartTime = ExecutionProfileTimer::Now();
+	_workerPool.ParallelFor(_parallelCommitDeviceCount, [&](unsigned int i) { _parallelCommitDeviceArray[i]->Rollback(); });
+	for (unsigned int i = 0; i < _serialCommitDeviceCount; ++i)
 	{
-		_deviceArray[i]->Rollback();
+		_serialCommitDeviceArray[i]->Rollback();
 	}
+	_profileRollbackTimer.AddSample(rollbackStartTime);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -259,27 +384,41 @@ void ExecutionManager::NegateCurrentOutputLineState()
 double ExecutionManager::GetNextTimingPoint(double maximumTimeslice, DeviceContext*& nextDeviceStep, unsigned int& nextDeviceStepContext)
 {
 	std::lock_guard<std::mutex> lock(_accessMutex);
-	for (unsigned int i = 0; i < _deviceCount; ++i)
+	ExecutionProfileTimer::Clock::time_point searchStartTime = ExecutionProfileTimer::Now();
+
+	// Obtain the next timing point from each device which uses timing points. Devices
+	// which have declared they never use timing points are excluded when they're added,
+	// so we only make virtual calls into the small number of devices which need them.
+	for (unsigned int i = 0; i < _timingPointDeviceCount; ++i)
 	{
 		_nextTimesliceContextValues[i] = 0;
-		_nextTimesliceValues[i] = _deviceArray[i]->GetNextTimingPoint(_nextTimesliceContextValues[i]);
+		_nextTimesliceValues[i] = _timingPointDeviceArray[i]->GetNextTimingPoint(_nextTimesliceContextValues[i]);
 	}
 
 	// Determine the maximum length of time all devices can run unsynchronized before the
-	// next timing point
+	// next timing point. Note that we only track the index of the nearest timing point
+	// here, so this loop touches nothing but the contiguous array of timing point values.
 	double timeslice = maximumTimeslice;
-	nextDeviceStep = 0;
-	for (unsigned int i = 0; i < _deviceCount; ++i)
+	unsigned int nextTimingPointIndex = _timingPointDeviceCount;
+	for (unsigned int i = 0; i < _timingPointDeviceCount; ++i)
 	{
 		double deviceTimingPoint = _nextTimesliceValues[i];
 		if ((deviceTimingPoint < timeslice) && (deviceTimingPoint >= 0))
 		{
 			timeslice = deviceTimingPoint;
-			nextDeviceStep = _deviceArray[i];
-			nextDeviceStepContext = _nextTimesliceContextValues[i];
+			nextTimingPointIndex = i;
 		}
 	}
 
+	// Return the device and access context for the nearest timing point, if any
+	nextDeviceStep = 0;
+	if (nextTimingPointIndex < _timingPointDeviceCount)
+	{
+		nextDeviceStep = _timingPointDeviceArray[nextTimingPointIndex];
+		nextDeviceStepContext = _nextTimesliceContextValues[nextTimingPointIndex];
+	}
+
+	_profileTimingPointSearchTimer.AddSample(searchStartTime);
 	return timeslice;
 }
 
@@ -288,31 +427,105 @@ double ExecutionManager::GetNextTimingPoint(double maximumTimeslice, DeviceConte
 //----------------------------------------------------------------------------------------------------------------------
 void ExecutionManager::StartExecution()
 {
+	// If cooperative execution is enabled, we don't start any worker threads. All devices
+	// are advanced from the thread which calls ExecuteTimeslice. Note that the execution
+	// mode is latched here, so that a change to the mode while the system is running only
+	// takes effect the next time execution is started.
 	std::lock_guard<std::mutex> lock(_accessMutex);
-	std::vector<std::thread> threads;
-	threads.reserve(_activeDeviceCount);
-	for (unsigned int i = 0; i < _activeDeviceCount; ++i)
+	if (_cooperativeExecutionEnabled.load(std::memory_order_relaxed))
 	{
-		threads.emplace_back(std::thread([&, i] { _activeDeviceArray[i]->StartExecution(); }));
-	}
-	for (unsigned int i = 0; i < _activeDeviceCount; ++i)
-	{
-		threads[i].join();
+		_cooperativeStepDeviceArray.clear();
+		_cooperativeTimesliceDeviceArray.clear();
+		for (unsigned int i = 0; i < _activeDeviceCount; ++i)
+		{
+			DeviceContext* device = _activeDeviceArray[i];
+			if (device->GetTargetDevice().GetUpdateMethod() == IDevice::UpdateMethod::Step)
+			{
+				_cooperativeStepDeviceArray.push_back(device);
+			}
+			else
+			{
+				_cooperativeTimesliceDeviceArray.push_back(device);
+			}
+			device->StartCooperativeExecution();
+		}
+		_cooperativeExecutionActive = true;
+		return;
 	}
+
+	// Note that devices with interlocked dependencies share a single execute thread, which
+	// is started by one device while the other waits for it to come up, so every device
+	// must be started concurrently here. We can't route this through the commit worker
+	// pool, which may have fewer threads than there are devices, so we use a separate pool
+	// with one thread for each device besides the calling thread. Its threads persist
+	// between calls, and are only recreated when the number of active devices changes.
+	_deviceControlPool.SetWorkerThreadCount((_activeDeviceCount > 0)? _activeDeviceCount - 1: 0);
+	_deviceControlPool.ParallelFor(_activeDeviceCount, [&](unsigned int i) { _activeDeviceArray[i]->StartExecution(); });
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void ExecutionManager::StopExecution()
 {
 	std::lock_guard<std::mutex> lock(_accessMutex);
-	std::vector<std::thread> threads;
-	threads.reserve(_activeDeviceCount);
-	for (unsigned int i = 0; i < _activeDeviceCount; ++i)
+	if (_cooperativeExecutionActive)
 	{
-		threads.emplace_back(std::thread([&, i] { _activeDeviceArray[i]->StopExecution(); }));
+		for (unsigned int i = 0; i < _activeDeviceCount; ++i)
+		{
+			_activeDeviceArray[i]->StopCooperativeExecution();
+		}
+		_cooperativeExecutionActive = false;
+		return;
 	}
-	for (unsigned int i = 0; i < _activeDeviceCount; ++i)
+
+	_deviceControlPool.SetWorkerThreadCount((_activeDeviceCount > 0)? _activeDeviceCount - 1: 0);
+	_deviceControlPool.ParallelFor(_activeDeviceCount, [&](unsigned int i) { _activeDeviceArray[i]->StopExecution(); });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Execution mode functions
+//----------------------------------------------------------------------------------------------------------------------
+bool ExecutionManager::GetCooperativeExecutionEnabled() const
+{
+	return _cooperativeExecutionEnabled.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ExecutionManager::SetCooperativeExecutionEnabled(bool state)
+{
+	_cooperativeExecutionEnabled.store(state, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int ExecutionManager::GetWorkerThreadCount() const
+{
+	return _workerPool.GetWorkerThreadCount();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ExecutionManager::SetWorkerThreadCount(unsigned int workerThreadCount)
+{
+	_workerPool.SetWorkerThreadCount(workerThreadCount);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Profiling functions
+//----------------------------------------------------------------------------------------------------------------------
+void ExecutionManager::AddTimingPointStepSample(ExecutionProfileTimer::Clock::time_point stepStartTime)
+{
+	_profileTimingPointStepTimer.AddSample(stepStartTime);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int ExecutionManager::GetTimesliceLengthHistogramBucket(double nanoseconds)
+{
+	// Timeslices are grouped by the position of the highest set bit in their length in
+	// whole nanoseconds, with zero length timeslices in the first bucket.
+	unsigned long long timesliceLength = (nanoseconds > 0)? (unsigned long long)nanoseconds: 0;
+	unsigned int bucketNo = 0;
+	while ((timesliceLength != 0) && (bucketNo < (TimesliceLengthHistogramBucketCount - 1)))
 	{
-		threads[i].join();
+		timesliceLength >>= 1;
+		++bucketNo;
 	}
+	return bucketNo;
 }
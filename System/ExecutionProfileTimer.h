@@ -0,0 +1,35 @@
+#ifndef __EXECUTIONPROFILETIMER_H__
+#define __EXECUTIONPROFILETIMER_H__
+#include <atomic>
+#include <chrono>
+
+// Accumulates the number of samples and the total wall time spent in a single phase of
+// system execution. Samples may be added from any thread. All updates use relaxed atomic
+// operations, as the accumulated values are only ever read for reporting purposes.
+class ExecutionProfileTimer
+{
+public:
+	// Typedefs
+	typedef std::chrono::steady_clock Clock;
+
+public:
+	// Constructors
+	inline ExecutionProfileTimer();
+
+	// Sample functions
+	static inline Clock::time_point Now();
+	inline void AddSample(Clock::time_point startTime);
+	inline void AddSample(Clock::time_point startTime, Clock::time_point endTime);
+	inline void Reset();
+
+	// Statistics functions
+	inline unsigned long long GetSampleCount() const;
+	inline unsigned long long GetTotalNanoseconds() const;
+
+private:
+	std::atomic<unsigned long long> _sampleCount;
+	std::atomic<unsigned long long> _totalNanoseconds;
+};
+
+#include "ExecutionProfileTimer.inl"
+#endif
@@ -0,0 +1,49 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+ExecutionProfileTimer::ExecutionProfileTimer()
+:_sampleCount(0), _totalNanoseconds(0)
+{ }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Sample functions
+//----------------------------------------------------------------------------------------------------------------------
+ExecutionProfileTimer::Clock::time_point ExecutionProfileTimer::Now()
+{
+	return Clock::now();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ExecutionProfileTimer::AddSample(Clock::time_point startTime)
+{
+	AddSample(startTime, Clock::now());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ExecutionProfileTimer::AddSample(Clock::time_point startTime, Clock::time_point endTime)
+{
+	unsigned long long elapsedNanoseconds = (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
+	_sampleCount.fetch_add(1, std::memory_order_relaxed);
+	_totalNanoseconds.fetch_add(elapsedNanoseconds, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ExecutionProfileTimer::Reset()
+{
+	_sampleCount.store(0, std::memory_order_relaxed);
+	_totalNanoseconds.store(0, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Statistics functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned long long ExecutionProfileTimer::GetSampleCount() const
+{
+	return _sampleCount.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned long long ExecutionProfileTimer::GetTotalNanoseconds() const
+{
+	return _totalNanoseconds.load(std::memory_order_relaxed);
+}
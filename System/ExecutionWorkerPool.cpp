@@ -0,0 +1,175 @@
+#include "ExecutionWorkerPool.h"
+#include "Debug/Debug.pkg"
+
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+ExecutionWorkerPool::ExecutionWorkerPool()
+:_workerThreadsStarted(false), _stopRequested(false), _dispatchNo(0), _busyWorkerThreadCount(0), _itemCallback(0), _itemCount(0), _nextItemIndex(0)
+{
+	unsigned int hardwareThreadCount = std::thread::hardware_concurrency();
+	_workerThreadCount = (hardwareThreadCount > 1)? hardwareThreadCount - 1: 0;
+	_workerThreadCount = (_workerThreadCount > MaxWorkerThreadCount)? MaxWorkerThreadCount: _workerThreadCount;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+ExecutionWorkerPool::ExecutionWorkerPool(unsigned int workerThreadCount)
+:_workerThreadCount(workerThreadCount), _workerThreadsStarted(false), _stopRequested(false), _dispatchNo(0), _busyWorkerThreadCount(0), _itemCallback(0), _itemCount(0), _nextItemIndex(0)
+{ }
+
+//----------------------------------------------------------------------------------------------------------------------
+ExecutionWorkerPool::~ExecutionWorkerPool()
+{
+	std::unique_lock<std::mutex> dispatchLock(_dispatchMutex);
+	StopWorkerThreads();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Worker thread count functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int ExecutionWorkerPool::GetWorkerThreadCount() const
+{
+	std::unique_lock<std::mutex> dispatchLock(_dispatchMutex);
+	return _workerThreadCount;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ExecutionWorkerPool::SetWorkerThreadCount(unsigned int workerThreadCount)
+{
+	// Stop any worker threads we've already started. The new set of worker threads will be
+	// started on the next dispatch.
+	std::unique_lock<std::mutex> dispatchLock(_dispatchMutex);
+	if (_workerThreadCount == workerThreadCount)
+	{
+		return;
+	}
+	StopWorkerThreads();
+	_workerThreadCount = workerThreadCount;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Dispatch functions
+//----------------------------------------------------------------------------------------------------------------------
+void ExecutionWorkerPool::ParallelFor(unsigned int itemCount, const std::function<void(unsigned int)>& itemCallback)
+{
+	// If there's only a single item to process, there's no benefit in waking the worker
+	// threads, so we process it directly.
+	if (itemCount <= 1)
+	{
+		for (unsigned int i = 0; i < itemCount; ++i)
+		{
+			itemCallback(i);
+		}
+		return;
+	}
+
+	// Start the worker threads if this is the first dispatch. If the host doesn't have
+	// any spare cores, we'll end up with no worker threads, and the calling thread will
+	// process all the items itself.
+	std::unique_lock<std::mutex> dispatchLock(_dispatchMutex);
+	if (!_workerThreadsStarted)
+	{
+		StartWorkerThreads();
+	}
+
+	// Publish the new work to the worker threads
+	std::unique_lock<std::mutex> lock(_workerThreadMutex);
+	_itemCallback = &itemCallback;
+	_itemCount = itemCount;
+	_nextItemIndex.store(0);
+	_busyWorkerThreadCount = (unsigned int)_workerThreads.size();
+	++_dispatchNo;
+	_workAvailable.notify_all();
+	lock.unlock();
+
+	// Process items on this thread alongside the worker threads, then wait for all the
+	// worker threads to finish with the current dispatch. Note that we need to wait for
+	// every worker thread to acknowledge the dispatch, not just for all items to be
+	// claimed, since the callback object is only valid until we return.
+	ProcessItems();
+	lock.lock();
+	while (_busyWorkerThreadCount > 0)
+	{
+		_workCompleted.wait(lock);
+	}
+	_itemCallback = 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Worker thread functions
+//----------------------------------------------------------------------------------------------------------------------
+void ExecutionWorkerPool::StartWorkerThreads()
+{
+	// Note that we pass the current dispatch number into each worker thread here, rather
+	// than having the worker threads sample it themselves once they start running. The
+	// first dispatch is published as soon as we return, so a worker thread which was slow
+	// to start would otherwise see the new dispatch number as its starting point, never
+	// process that dispatch, and leave the dispatching thread waiting forever. This is
+	// safe since the dispatch number is only ever changed while the dispatch mutex is
+	// held, which our caller holds for the duration of this call.
+	_workerThreads.reserve(_workerThreadCount);
+	for (unsigned int i = 0; i < _workerThreadCount; ++i)
+	{
+		_workerThreads.emplace_back(std::thread(std::bind(std::mem_fn(&ExecutionWorkerPool::WorkerThread), this, _dispatchNo)));
+	}
+	_workerThreadsStarted = true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ExecutionWorkerPool::StopWorkerThreads()
+{
+	// Note that our caller must hold the dispatch mutex
+	std::unique_lock<std::mutex> lock(_workerThreadMutex);
+	_stopRequested = true;
+	_workAvailable.notify_all();
+	lock.unlock();
+	for (unsigned int i = 0; i < (unsigned int)_workerThreads.size(); ++i)
+	{
+		_workerThreads[i].join();
+	}
+	_workerThreads.clear();
+	_workerThreadsStarted = false;
+	_stopRequested = false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ExecutionWorkerPool::WorkerThread(unsigned long long initialDispatchNo)
+{
+	// Set the name of this thread for the debugger
+	SetCallingThreadName(L"ExecutionWorkerPool");
+
+	std::unique_lock<std::mutex> lock(_workerThreadMutex);
+	unsigned long long lastDispatchNo = initialDispatchNo;
+	while (true)
+	{
+		while (!_stopRequested && (_dispatchNo == lastDispatchNo))
+		{
+			_workAvailable.wait(lock);
+		}
+		if (_stopRequested)
+		{
+			return;
+		}
+		lastDispatchNo = _dispatchNo;
+
+		lock.unlock();
+		ProcessItems();
+		lock.lock();
+
+		if (--_busyWorkerThreadCount == 0)
+		{
+			_workCompleted.notify_all();
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ExecutionWorkerPool::ProcessItems()
+{
+	unsigned int itemIndex = _nextItemIndex.fetch_add(1);
+	while (itemIndex < _itemCount)
+	{
+		(*_itemCallback)(itemIndex);
+		itemIndex = _nextItemIndex.fetch_add(1);
+	}
+}
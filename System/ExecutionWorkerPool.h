@@ -0,0 +1,60 @@
+#ifndef __EXECUTIONWORKERPOOL_H__
+#define __EXECUTIONWORKERPOOL_H__
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Maintains a persistent set of worker threads which the execution manager uses to
+// dispatch per-device operations, such as commit and rollback, in parallel. The worker
+// threads are created the first time work is dispatched, and remain idle waiting on a
+// condition variable between dispatches, so no threads are created or destroyed for each
+// operation. The calling thread always takes part in processing the dispatched items. By
+// default, one worker thread is created for each spare hardware thread on the host, but
+// an explicit worker thread count can be given, with zero making the pool fully serial.
+// The worker thread count can also be changed later, provided no dispatch is in progress.
+class ExecutionWorkerPool
+{
+public:
+	// Constructors
+	ExecutionWorkerPool();
+	explicit ExecutionWorkerPool(unsigned int workerThreadCount);
+	~ExecutionWorkerPool();
+
+	// Worker thread count functions
+	unsigned int GetWorkerThreadCount() const;
+	void SetWorkerThreadCount(unsigned int workerThreadCount);
+
+	// Dispatch functions
+	void ParallelFor(unsigned int itemCount, const std::function<void(unsigned int)>& itemCallback);
+
+private:
+	// Constants
+	static const unsigned int MaxWorkerThreadCount = 7;
+
+private:
+	// Worker thread functions
+	void StartWorkerThreads();
+	void StopWorkerThreads();
+	void WorkerThread(unsigned long long initialDispatchNo);
+	void ProcessItems();
+
+private:
+	mutable std::mutex _dispatchMutex;
+	std::mutex _workerThreadMutex;
+	std::condition_variable _workAvailable;
+	std::condition_variable _workCompleted;
+	unsigned int _workerThreadCount;
+	std::vector<std::thread> _workerThreads;
+	bool _workerThreadsStarted;
+	bool _stopRequested;
+	unsigned long long _dispatchNo;
+	unsigned int _busyWorkerThreadCount;
+	const std::function<void(unsigned int)>* _itemCallback;
+	unsigned int _itemCount;
+	std::atomic<unsigned int> _nextItemIndex;
+};
+
+#endif
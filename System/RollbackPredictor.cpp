@@ -0,0 +1,205 @@
+#include "RollbackPredictor.h"
+#include <cmath>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Constants
+//----------------------------------------------------------------------------------------------------------------------
+// Note that the interval tolerance is a fraction of the interval itself. Step devices
+// report rollbacks on instruction boundaries, so a rollback which recurs at the same point
+// in each frame will show a small amount of jitter in the measured interval.
+const double RollbackPredictor::PatternIntervalTolerance = 1.0 / 1000.0;
+const double RollbackPredictor::PatternMinimumInterval = 1000.0;
+
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+RollbackPredictor::RollbackPredictor()
+:_predictionEnabled(true), _currentTime(0), _activePatternIndex(0), _predictionActive(false), _predictionCount(0), _avoidedRollbackCount(0), _mispredictionCount(0)
+{ }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Prediction state functions
+//----------------------------------------------------------------------------------------------------------------------
+void RollbackPredictor::Reset()
+{
+	_currentTime = 0;
+	_patterns.clear();
+	_predictionActive = false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Prediction functions
+//----------------------------------------------------------------------------------------------------------------------
+bool RollbackPredictor::GetPredictedTimingPoint(double maximumTimeslice, double& timeslice, IDeviceContext*& device, unsigned int& accessContext)
+{
+	_predictionActive = false;
+	if (!_predictionEnabled.load(std::memory_order_relaxed))
+	{
+		return false;
+	}
+
+	// Find the earliest predicted rollback which falls within the upcoming timeslice. If
+	// we've already passed the predicted time for a pattern without reaching it, which can
+	// happen when an unrelated rollback or timing point moves the timeslice boundaries,
+	// we skip forward to the next predicted occurrence.
+	bool foundPrediction = false;
+	double earliestPredictedTimeslice = maximumTimeslice;
+	for (unsigned int i = 0; i < (unsigned int)_patterns.size(); ++i)
+	{
+		RollbackPattern& pattern = _patterns[i];
+		if (pattern.confirmationCount < PatternConfirmationCount)
+		{
+			continue;
+		}
+		while (pattern.nextPredictedTime <= _currentTime)
+		{
+			pattern.nextPredictedTime += pattern.interval;
+		}
+		double predictedTimeslice = pattern.nextPredictedTime - _currentTime;
+		if (predictedTimeslice < earliestPredictedTimeslice)
+		{
+			earliestPredictedTimeslice = predictedTimeslice;
+			_activePatternIndex = i;
+			foundPrediction = true;
+		}
+	}
+	if (!foundPrediction)
+	{
+		return false;
+	}
+
+	// Replace the timing point with our predicted rollback point
+	const RollbackPattern& pattern = _patterns[_activePatternIndex];
+	timeslice = earliestPredictedTimeslice;
+	device = pattern.rollbackDevice;
+	accessContext = pattern.accessContext;
+	_predictionActive = true;
+	_predictionCount.fetch_add(1, std::memory_order_relaxed);
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void RollbackPredictor::NotifyRollback(IDeviceContext* triggerDevice, IDeviceContext* rollbackDevice, unsigned int accessContext, double rollbackTimeslice)
+{
+	// Locate the pattern for this rollback, creating a new one if required. If we've hit
+	// our pattern limit, we recycle the least confirmed pattern.
+	double rollbackTime = _currentTime + rollbackTimeslice;
+	unsigned int patternIndex = (unsigned int)_patterns.size();
+	for (unsigned int i = 0; i < (unsigned int)_patterns.size(); ++i)
+	{
+		const RollbackPattern& pattern = _patterns[i];
+		if ((pattern.triggerDevice == triggerDevice) && (pattern.rollbackDevice == rollbackDevice) && (pattern.accessContext == accessContext))
+		{
+			patternIndex = i;
+			break;
+		}
+	}
+	if (patternIndex >= (unsigned int)_patterns.size())
+	{
+		RollbackPattern newPattern;
+		newPattern.triggerDevice = triggerDevice;
+		newPattern.rollbackDevice = rollbackDevice;
+		newPattern.accessContext = accessContext;
+		newPattern.lastOccurrenceTime = rollbackTime;
+		newPattern.interval = 0;
+		newPattern.nextPredictedTime = 0;
+		newPattern.confirmationCount = 0;
+		newPattern.mispredictionCount = 0;
+		if (_patterns.size() < MaxPatternCount)
+		{
+			_patterns.push_back(newPattern);
+		}
+		else
+		{
+			unsigned int replaceIndex = 0;
+			for (unsigned int i = 1; i < (unsigned int)_patterns.size(); ++i)
+			{
+				if (_patterns[i].confirmationCount < _patterns[replaceIndex].confirmationCount)
+				{
+					replaceIndex = i;
+				}
+			}
+			_patterns[replaceIndex] = newPattern;
+		}
+		_predictionActive = false;
+		return;
+	}
+
+	// If we predicted this rollback for the current timeslice and it occurred anyway, our
+	// prediction didn't help.
+	RollbackPattern& pattern = _patterns[patternIndex];
+	if (_predictionActive && (_activePatternIndex == patternIndex))
+	{
+		RecordMisprediction(pattern);
+	}
+	_predictionActive = false;
+
+	// Update the interval for this pattern. Note that a rollback can be reported more than
+	// once for the same point in time, as the rolled back timeslice can itself be rolled
+	// back again, so we ignore intervals which are too short to be meaningful. Also note
+	// that occurrences which we avoided, or which didn't conflict, never produce a
+	// rollback, so a real rollback which lands a whole number of intervals after the last
+	// one still confirms the pattern.
+	double interval = rollbackTime - pattern.lastOccurrenceTime;
+	if (interval < PatternMinimumInterval)
+	{
+		return;
+	}
+	bool intervalMatched = false;
+	if (pattern.interval > 0)
+	{
+		double intervalCount = std::floor((interval / pattern.interval) + 0.5);
+		intervalMatched = (intervalCount >= 1.0) && (std::fabs(interval - (intervalCount * pattern.interval)) <= (intervalCount * pattern.interval * PatternIntervalTolerance));
+	}
+	if (intervalMatched)
+	{
+		++pattern.confirmationCount;
+	}
+	else
+	{
+		pattern.interval = interval;
+		pattern.confirmationCount = 1;
+	}
+	pattern.lastOccurrenceTime = rollbackTime;
+	pattern.nextPredictedTime = rollbackTime + pattern.interval;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void RollbackPredictor::NotifyTimesliceCommitted(double timeslice, bool predictedAccessObserved)
+{
+	// If we reached a predicted rollback point without a rollback occurring, we only count
+	// it as an avoided rollback if the predicted access was actually observed when the
+	// device was stepped at that point. If it wasn't, the pattern has drifted or stopped
+	// occurring, so we count it as a misprediction. Note that we don't update the learned
+	// timing of the pattern here. The predicted point isn't a measured occurrence, so the
+	// timing is only ever updated from real rollbacks.
+	if (_predictionActive)
+	{
+		RollbackPattern& pattern = _patterns[_activePatternIndex];
+		if (predictedAccessObserved)
+		{
+			_avoidedRollbackCount.fetch_add(1, std::memory_order_relaxed);
+			pattern.mispredictionCount = 0;
+		}
+		else
+		{
+			RecordMisprediction(pattern);
+		}
+		pattern.nextPredictedTime += pattern.interval;
+		_predictionActive = false;
+	}
+	_currentTime += timeslice;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void RollbackPredictor::RecordMisprediction(RollbackPattern& pattern)
+{
+	// If a pattern keeps mispredicting, we drop the confirmation on it so that it has to be
+	// learned again.
+	_mispredictionCount.fetch_add(1, std::memory_order_relaxed);
+	if (++pattern.mispredictionCount >= PatternMispredictionLimit)
+	{
+		pattern.confirmationCount = 0;
+		pattern.mispredictionCount = 0;
+	}
+}
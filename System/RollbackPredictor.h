@@ -0,0 +1,71 @@
+#ifndef __ROLLBACKPREDICTOR_H__
+#define __ROLLBACKPREDICTOR_H__
+#include "DeviceInterface/DeviceInterface.pkg"
+#include <atomic>
+#include <vector>
+
+// Learns recurring rollback patterns during system execution, and predicts the times at
+// which they will occur again, so that the system can end a timeslice at the predicted
+// time rather than executing the whole timeslice and rolling it back. Patterns are
+// identified by the device which triggered the rollback, the device which was stepped
+// through at the rollback point, and the access context. Once the interval between
+// successive rollbacks for a pattern has repeated enough times, the pattern is
+// considered confirmed, and a timing point is predicted one interval after the last
+// occurrence. A rollback is only counted as avoided if the predicted access is actually
+// observed when the device is stepped at the predicted point. Predictions which miss
+// count against the pattern, and a pattern which misses repeatedly has to be learned
+// again. A misprediction only costs a shorter timeslice, as the normal rollback
+// mechanism still catches any conflict which does occur. All functions other than the
+// statistics and enable state functions must be called from the system execute thread.
+class RollbackPredictor
+{
+public:
+	// Constructors
+	RollbackPredictor();
+
+	// Prediction state functions
+	inline bool GetPredictionEnabled() const;
+	inline void SetPredictionEnabled(bool state);
+	void Reset();
+
+	// Prediction functions
+	bool GetPredictedTimingPoint(double maximumTimeslice, double& timeslice, IDeviceContext*& device, unsigned int& accessContext);
+	void NotifyRollback(IDeviceContext* triggerDevice, IDeviceContext* rollbackDevice, unsigned int accessContext, double rollbackTimeslice);
+	void NotifyTimesliceCommitted(double timeslice, bool predictedAccessObserved);
+	inline bool GetActivePrediction(IDeviceContext*& triggerDevice, IDeviceContext*& rollbackDevice) const;
+	inline void CancelPrediction();
+
+	// Statistics functions
+	inline unsigned long long GetPredictionCount() const;
+	inline unsigned long long GetAvoidedRollbackCount() const;
+	inline unsigned long long GetMispredictionCount() const;
+	inline void ResetStatistics();
+
+private:
+	// Constants
+	static const unsigned int MaxPatternCount = 32;
+	static const unsigned int PatternConfirmationCount = 3;
+	static const unsigned int PatternMispredictionLimit = 4;
+	static const double PatternIntervalTolerance;
+	static const double PatternMinimumInterval;
+
+	// Structures
+	struct RollbackPattern;
+
+private:
+	// Prediction functions
+	void RecordMisprediction(RollbackPattern& pattern);
+
+private:
+	std::atomic<bool> _predictionEnabled;
+	double _currentTime;
+	std::vector<RollbackPattern> _patterns;
+	unsigned int _activePatternIndex;
+	bool _predictionActive;
+	std::atomic<unsigned long long> _predictionCount;
+	std::atomic<unsigned long long> _avoidedRollbackCount;
+	std::atomic<unsigned long long> _mispredictionCount;
+};
+
+#include "RollbackPredictor.inl"
+#endif
@@ -0,0 +1,77 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Structures
+//----------------------------------------------------------------------------------------------------------------------
+struct RollbackPredictor::RollbackPattern
+{
+	IDeviceContext* triggerDevice;
+	IDeviceContext* rollbackDevice;
+	unsigned int accessContext;
+	double lastOccurrenceTime;
+	double interval;
+	double nextPredictedTime;
+	unsigned int confirmationCount;
+	unsigned int mispredictionCount;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Prediction state functions
+//----------------------------------------------------------------------------------------------------------------------
+bool RollbackPredictor::GetPredictionEnabled() const
+{
+	return _predictionEnabled.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void RollbackPredictor::SetPredictionEnabled(bool state)
+{
+	_predictionEnabled.store(state, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Prediction functions
+//----------------------------------------------------------------------------------------------------------------------
+bool RollbackPredictor::GetActivePrediction(IDeviceContext*& triggerDevice, IDeviceContext*& rollbackDevice) const
+{
+	if (!_predictionActive)
+	{
+		return false;
+	}
+	const RollbackPattern& pattern = _patterns[_activePatternIndex];
+	triggerDevice = pattern.triggerDevice;
+	rollbackDevice = pattern.rollbackDevice;
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void RollbackPredictor::CancelPrediction()
+{
+	_predictionActive = false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Statistics functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned long long RollbackPredictor::GetPredictionCount() const
+{
+	return _predictionCount.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned long long RollbackPredictor::GetAvoidedRollbackCount() const
+{
+	return _avoidedRollbackCount.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned long long RollbackPredictor::GetMispredictionCount() const
+{
+	return _mispredictionCount.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void RollbackPredictor::ResetStatistics()
+{
+	_predictionCount.store(0, std::memory_order_relaxed);
+	_avoidedRollbackCount.store(0, std::memory_order_relaxed);
+	_mispredictionCount.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,154 @@
+#include "SaveStateHeader.h"
+#include "Image/Image.pkg"
+#include "ZIP/ZIP.pkg"
+#include <algorithm>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Header functions
+//----------------------------------------------------------------------------------------------------------------------
+bool SaveStateHeader::Save(Stream::IStream& target, const Info& info, const IImage* screenshot)
+{
+	// Build a reduced size copy of the screenshot which fits within the thumbnail bounds,
+	// preserving the aspect ratio of the original image.
+	Image thumbnail;
+	unsigned int thumbnailWidth = 0;
+	unsigned int thumbnailHeight = 0;
+	if ((screenshot != 0) && (screenshot->GetImageWidth() > 0) && (screenshot->GetImageHeight() > 0))
+	{
+		unsigned int imageWidth = screenshot->GetImageWidth();
+		unsigned int imageHeight = screenshot->GetImageHeight();
+		if ((imageWidth * ThumbnailMaxHeight) > (imageHeight * ThumbnailMaxWidth))
+		{
+			thumbnailWidth = ThumbnailMaxWidth;
+			thumbnailHeight = std::max(1u, ((imageHeight * ThumbnailMaxWidth) + (imageWidth / 2)) / imageWidth);
+		}
+		else
+		{
+			thumbnailHeight = ThumbnailMaxHeight;
+			thumbnailWidth = std::max(1u, ((imageWidth * ThumbnailMaxHeight) + (imageHeight / 2)) / imageHeight);
+		}
+		thumbnail.ResampleBilinear(*screenshot, thumbnailWidth, thumbnailHeight);
+	}
+	bool thumbnailPresent = (thumbnailWidth > 0) && (thumbnailHeight > 0);
+
+	// Build the flags for this savestate
+	unsigned int flags = 0;
+	flags |= (info.debuggerState)? FlagDebuggerState: 0;
+	flags |= (info.screenshotPresent)? FlagScreenshotPresent: 0;
+	flags |= (thumbnailPresent)? FlagThumbnailPresent: 0;
+
+	// Write the fixed size header fields
+	bool result = true;
+	result &= target.WriteDataLittleEndian(Signature);
+	result &= target.WriteDataLittleEndian(Version);
+	result &= target.WriteDataLittleEndian(flags);
+	result &= target.WriteDataLittleEndian(thumbnailWidth);
+	result &= target.WriteDataLittleEndian(thumbnailHeight);
+	result &= target.WriteTextLittleEndianFixedLengthBufferAsUTF16(DateLength, info.creationDate);
+	result &= target.WriteTextLittleEndianFixedLengthBufferAsUTF16(TimeLength, info.creationTime);
+	result &= target.WriteTextLittleEndianFixedLengthBufferAsUTF16(CommentsLength, info.comments);
+	result &= target.WriteTextLittleEndianFixedLengthBufferAsUTF16(ScreenshotFilenameLength, info.screenshotFilename);
+
+	// Write the thumbnail as raw 8-bit RGB data. The thumbnail region always occupies the
+	// space required for the largest possible thumbnail, with a row stride equal to the
+	// maximum thumbnail width, so that the record has a fixed size.
+	std::vector<unsigned char> pixelData(ThumbnailMaxWidth * ThumbnailMaxHeight * 3, 0);
+	if (thumbnailPresent)
+	{
+		unsigned int planeCount = thumbnail.GetDataPlaneCount();
+		for (unsigned int ypos = 0; ypos < thumbnailHeight; ++ypos)
+		{
+			for (unsigned int xpos = 0; xpos < thumbnailWidth; ++xpos)
+			{
+				for (unsigned int plane = 0; plane < 3; ++plane)
+				{
+					unsigned char data;
+					thumbnail.ReadPixelData(xpos, ypos, (plane < planeCount)? plane: 0, data);
+					pixelData[(((ypos * ThumbnailMaxWidth) + xpos) * 3) + plane] = data;
+				}
+			}
+		}
+	}
+	result &= target.WriteData(&pixelData[0], pixelData.size());
+
+	return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool SaveStateHeader::Load(Stream::IStream& source, Info& info, IImage& thumbnail)
+{
+	// Read and validate the fixed size header fields
+	bool result = true;
+	unsigned int signature = 0;
+	unsigned int version = 0;
+	unsigned int flags = 0;
+	unsigned int thumbnailWidth = 0;
+	unsigned int thumbnailHeight = 0;
+	result &= source.ReadDataLittleEndian(signature);
+	result &= source.ReadDataLittleEndian(version);
+	result &= source.ReadDataLittleEndian(flags);
+	result &= source.ReadDataLittleEndian(thumbnailWidth);
+	result &= source.ReadDataLittleEndian(thumbnailHeight);
+	if (!result || (signature != Signature) || (version != Version) || (thumbnailWidth > ThumbnailMaxWidth) || (thumbnailHeight > ThumbnailMaxHeight))
+	{
+		return false;
+	}
+	result &= source.ReadTextLittleEndianFixedLengthBufferAsUTF16(DateLength, info.creationDate);
+	result &= source.ReadTextLittleEndianFixedLengthBufferAsUTF16(TimeLength, info.creationTime);
+	result &= source.ReadTextLittleEndianFixedLengthBufferAsUTF16(CommentsLength, info.comments);
+	result &= source.ReadTextLittleEndianFixedLengthBufferAsUTF16(ScreenshotFilenameLength, info.screenshotFilename);
+
+	// Read the thumbnail pixel data
+	std::vector<unsigned char> pixelData(ThumbnailMaxWidth * ThumbnailMaxHeight * 3);
+	result &= source.ReadData(&pixelData[0], pixelData.size());
+	if (!result)
+	{
+		return false;
+	}
+
+	// Populate the savestate info
+	info.debuggerState = (flags & FlagDebuggerState) != 0;
+	info.screenshotPresent = (flags & FlagScreenshotPresent) != 0;
+	info.thumbnailPresent = ((flags & FlagThumbnailPresent) != 0) && (thumbnailWidth > 0) && (thumbnailHeight > 0);
+
+	// Decode the thumbnail into the target image
+	if (info.thumbnailPresent)
+	{
+		thumbnail.SetImageFormat(thumbnailWidth, thumbnailHeight, IImage::PIXELFORMAT_RGB, IImage::DATAFORMAT_8BIT);
+		for (unsigned int ypos = 0; ypos < thumbnailHeight; ++ypos)
+		{
+			for (unsigned int xpos = 0; xpos < thumbnailWidth; ++xpos)
+			{
+				for (unsigned int plane = 0; plane < 3; ++plane)
+				{
+					thumbnail.WritePixelData(xpos, ypos, plane, pixelData[(((ypos * ThumbnailMaxWidth) + xpos) * 3) + plane]);
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool SaveStateHeader::LoadFromZIPArchive(Stream::IStream& source, Info& info, IImage& thumbnail)
+{
+	// Load only the first file entry from the zip archive. Savestates which contain a
+	// header always store it as the first file in the archive, so we never need to read
+	// the central directory, or any of the compressed savestate data which follows. If
+	// the first file isn't a header, this savestate was created before headers were
+	// introduced.
+	ZIPFileEntry entry;
+	if (!entry.LoadFromStream(source) || (entry.GetFileName() != L"header.bin"))
+	{
+		return false;
+	}
+	Stream::Buffer buffer(0);
+	if (!entry.Decompress(buffer))
+	{
+		return false;
+	}
+	buffer.SetStreamPos(0);
+	return Load(buffer, info, thumbnail);
+}
@@ -0,0 +1,42 @@
+#ifndef __SAVESTATEHEADER_H__
+#define __SAVESTATEHEADER_H__
+#include "StreamInterface/StreamInterface.pkg"
+#include "ImageInterface/ImageInterface.pkg"
+#include <string>
+
+// Reads and writes the savestate header record. The savestate header is a small fixed
+// layout record which is stored uncompressed as the first file in a savestate archive, or
+// alongside the state file for xml savestates. It allows the savestate slot browser to
+// obtain the info and thumbnail for a savestate without needing to decompress and parse
+// the full state tree.
+class SaveStateHeader
+{
+public:
+	// Structures
+	struct Info;
+
+	// Constants
+	static const unsigned int ThumbnailMaxWidth = 128;
+	static const unsigned int ThumbnailMaxHeight = 96;
+
+public:
+	// Header functions
+	static bool Save(Stream::IStream& target, const Info& info, const IImage* screenshot);
+	static bool Load(Stream::IStream& source, Info& info, IImage& thumbnail);
+	static bool LoadFromZIPArchive(Stream::IStream& source, Info& info, IImage& thumbnail);
+
+private:
+	// Constants
+	static const unsigned int Signature = 0x48535845;
+	static const unsigned int Version = 1;
+	static const unsigned int DateLength = 32;
+	static const unsigned int TimeLength = 32;
+	static const unsigned int CommentsLength = 256;
+	static const unsigned int ScreenshotFilenameLength = 64;
+	static const unsigned int FlagDebuggerState = 0x01;
+	static const unsigned int FlagScreenshotPresent = 0x02;
+	static const unsigned int FlagThumbnailPresent = 0x04;
+};
+
+#include "SaveStateHeader.inl"
+#endif
@@ -0,0 +1,17 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Structures
+//----------------------------------------------------------------------------------------------------------------------
+struct SaveStateHeader::Info
+{
+	Info()
+	:debuggerState(false), screenshotPresent(false), thumbnailPresent(false)
+	{ }
+
+	std::wstring creationDate;
+	std::wstring creationTime;
+	std::wstring comments;
+	std::wstring screenshotFilename;
+	bool debuggerState;
+	bool screenshotPresent;
+	bool thumbnailPresent;
+};
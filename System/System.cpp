@@ -1,4 +1,6 @@
 #include "System.h"
+#include "SystemBatchRunner.h"
+#include "SaveStateHeader.h"
 #include "HierarchicalStorage/HierarchicalStorage.pkg"
 #include "Stream/Stream.pkg"
 #include "ZIP/ZIP.pkg"
@@ -17,10 +19,10 @@
 // Constructors
 //----------------------------------------------------------------------------------------------------------------------
 System::System(IGUIExtensionInterface& guiExtensionInterface)
-:_guiExtensionInterface(guiExtensionInterface), _stopSystem(false), _systemStopped(true), _initialize(true), _rollback(false), _performingSingleDeviceStep(false), _enableThrottling(true), _runWhenProgramModuleLoaded(true), _enablePersistentState(true)
+:_guiExtensionInterface(guiExtensionInterface), _stopSystem(false), _systemStopped(true), _initialize(true), _rollback(false), _performingSingleDeviceStep(false), _lastSystemStepEndedOnTimingPoint(false), _enableThrottling(true), _throttlingSyncInterval(20000000.0), _runWhenProgramModuleLoaded(true), _enablePersistentState(true), _eventLog(500)
 {
-	_eventLogSize = 500;
 	_eventLogLastModifiedToken = 0;
+	_eventLogClearGeneration = 0;
 
 	_embeddedROMInfoLastModifiedToken = 0;
 
@@ -255,6 +257,11 @@ bool System::LoadState(const Marshal::In<std::wstring>& filePath, FileType fileT
 		return false;
 	}
 
+	// Discard any learned rollback patterns. Patterns are tracked against the elapsed
+	// system time, which no longer lines up with the execution state once a state has
+	// been loaded.
+	_rollbackPredictor.Reset();
+
 	// Restore system state from XML data
 	ModuleRelationshipMap relationshipMap;
 	std::list<IHierarchicalStorageNode*> childList = rootNode.GetChildList();
@@ -364,6 +371,10 @@ bool System::SaveState(const Marshal::In<std::wstring>& filePath, FileType fileT
 	stateInfo.CreateAttribute(L"CreationDate", timestamp.GetDate());
 	stateInfo.CreateAttribute(L"CreationTime", timestamp.GetTime());
 	stateInfo.CreateAttribute(L"DebuggerState", debuggerState);
+	if (!_saveStateComments.empty())
+	{
+		stateInfo.CreateAttribute(L"Comments", _saveStateComments);
+	}
 	Image screenshot;
 	bool screenshotPresent = false;
 	std::wstring screenshotFilename = L"screenshot.png";
@@ -379,6 +390,27 @@ bool System::SaveState(const Marshal::In<std::wstring>& filePath, FileType fileT
 		}
 	}
 
+	// Build the savestate header record. This record duplicates the general savestate
+	// information from the XML tree, along with a reduced size thumbnail of the
+	// screenshot, so that it can be retrieved without loading the full savestate.
+	SaveStateHeader::Info headerInfo;
+	headerInfo.creationDate = timestamp.GetDate();
+	headerInfo.creationTime = timestamp.GetTime();
+	headerInfo.comments = _saveStateComments;
+	headerInfo.debuggerState = debuggerState;
+	headerInfo.screenshotPresent = screenshotPresent;
+	headerInfo.screenshotFilename = (screenshotPresent)? screenshotFilename: L"";
+	Stream::Buffer headerBuffer(0);
+	if (!SaveStateHeader::Save(headerBuffer, headerInfo, (screenshotPresent)? &screenshot: 0))
+	{
+		WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Failed to save state to file " + filePath + L" because there was an error building the savestate header!"));
+		if (running)
+		{
+			RunSystem();
+		}
+		return false;
+	}
+
 	// Save the ModuleRelationships node
 	IHierarchicalStorageNode& moduleRelationshipsNode = tree.GetRootNode().CreateChild(L"ModuleRelationships");
 	SaveModuleRelationshipsNode(moduleRelationshipsNode);
@@ -414,7 +446,25 @@ bool System::SaveState(const Marshal::In<std::wstring>& filePath, FileType fileT
 			return false;
 		}
 
+		// Add the savestate header as the first file in the archive. We store this file
+		// without compression, so that it can be read directly from the start of the
+		// file without processing the rest of the archive.
 		ZIPArchive archive;
+		ZIPFileEntry headerEntry;
+		headerEntry.SetFileName(L"header.bin");
+		headerBuffer.SetStreamPos(0);
+		if (!headerEntry.Store(headerBuffer))
+		{
+			WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Failed to save state to file " + filePath + L" because there was an error storing the header.bin file!"));
+			if (running)
+			{
+				RunSystem();
+			}
+			return false;
+		}
+		archive.AddFileEntry(headerEntry);
+
+		// Add the compressed XML tree to the archive
 		ZIPFileEntry entry;
 		entry.SetFileName(L"save.xml");
 		buffer.SetStreamPos(0);
@@ -524,9 +574,32 @@ bool System::SaveState(const Marshal::In<std::wstring>& filePath, FileType fileT
 			return false;
 		}
 
-		// Save external binary data to separate files
+		// Save the savestate header to a separate file
 		std::wstring fileName = PathGetFileName(filePath);
 		std::wstring fileDir = PathGetDirectory(filePath);
+		std::wstring headerFileName = fileName + L" - header.bin";
+		std::wstring headerFilePath = PathCombinePaths(fileDir, headerFileName);
+		Stream::File headerFile;
+		if (!headerFile.Open(headerFilePath, Stream::File::OpenMode::ReadAndWrite, Stream::File::CreateMode::Create))
+		{
+			WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Failed to save state to file " + filePath + L" because there was an error creating the header file " + headerFileName + L" at the full path of " + headerFilePath + L"!"));
+			if (running)
+			{
+				RunSystem();
+			}
+			return false;
+		}
+		if (!headerFile.WriteData(headerBuffer.GetRawBuffer(), headerBuffer.Size()))
+		{
+			WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Failed to save state to file " + filePath + L" because there was an error writing to the header file " + headerFileName + L"!"));
+			if (running)
+			{
+				RunSystem();
+			}
+			return false;
+		}
+
+		// Save external binary data to separate files
 		std::list<IHierarchicalStorageNode*> binaryList;
 		binaryList = tree.GetBinaryDataNodeList();
 		for (std::list<IHierarchicalStorageNode*>::iterator i = binaryList.begin(); i != binaryList.end(); ++i)
@@ -1032,6 +1105,71 @@ Marshal::Ret<System::StateInfo> System::GetStateInfo(const Marshal::In<std::wstr
 	return stateInfo;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+Marshal::Ret<System::StateInfo> System::GetStateHeaderInfo(const Marshal::In<std::wstring>& filePath, FileType fileType, IImage& thumbnail) const
+{
+	StateInfo stateInfo;
+	stateInfo.valid = false;
+
+	// Determine the path of the file containing the savestate header. For xml savestates,
+	// the header is stored in a separate file alongside the savestate.
+	std::wstring headerFilePath = filePath;
+	if (fileType == FileType::XML)
+	{
+		headerFilePath = PathCombinePaths(PathGetDirectory(filePath), PathGetFileName(filePath) + L" - header.bin");
+	}
+
+	// Open the target file
+	FileStreamReference sourceStreamReference(_guiExtensionInterface);
+	if (!sourceStreamReference.OpenExistingFileForRead(headerFilePath))
+	{
+		return stateInfo;
+	}
+	Stream::IStream& source = *sourceStreamReference;
+
+	// Load the savestate header. Note that only the header record is read here. The
+	// savestate data itself is never decompressed or parsed.
+	SaveStateHeader::Info headerInfo;
+	bool headerLoaded = false;
+	if (fileType == FileType::ZIP)
+	{
+		headerLoaded = SaveStateHeader::LoadFromZIPArchive(source, headerInfo, thumbnail);
+	}
+	else if (fileType == FileType::XML)
+	{
+		headerLoaded = SaveStateHeader::Load(source, headerInfo, thumbnail);
+	}
+	if (!headerLoaded)
+	{
+		return stateInfo;
+	}
+
+	// Populate the savestate info from the header
+	stateInfo.valid = true;
+	stateInfo.creationDate = headerInfo.creationDate;
+	stateInfo.creationTime = headerInfo.creationTime;
+	stateInfo.comments = headerInfo.comments;
+	stateInfo.screenshotFilename = headerInfo.screenshotFilename;
+	stateInfo.debuggerState = headerInfo.debuggerState;
+	stateInfo.screenshotPresent = headerInfo.screenshotPresent;
+	stateInfo.thumbnailPresent = headerInfo.thumbnailPresent;
+	return stateInfo;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+Marshal::Ret<std::wstring> System::GetSaveStateComments() const
+{
+	return _saveStateComments;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void System::SetSaveStateComments(const Marshal::In<std::wstring>& comments)
+{
+	// Note that these comments are recorded in every savestate which is created from this
+	// point on, both in the savestate info and in the savestate header.
+	_saveStateComments = comments;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 bool System::LoadSavedRelationshipMap(IHierarchicalStorageNode& node, SavedRelationshipMap& relationshipMap) const
 {
@@ -1316,66 +1454,142 @@ bool System::DoesLoadedModuleMatchSavedModule(const SavedRelationshipMap& savedR
 //----------------------------------------------------------------------------------------------------------------------
 void System::WriteLogEvent(const ILogEntry& entry) const
 {
-	std::unique_lock<std::mutex> lock(_eventLogMutex);
-	SystemLogEntry logEntryInternal;
-	logEntryInternal.text = entry.GetText();
-	logEntryInternal.source = entry.GetSource();
-	logEntryInternal.eventLevel = entry.GetEventLevel();
-	logEntryInternal.eventLevelString = entry.GetEventLevelString();
-	logEntryInternal.eventTimeString = entry.GetTimeString();
-	_log.push_front(logEntryInternal);
-	if (_log.size() > _eventLogSize)
-	{
-		_log.pop_back();
-	}
-	++_eventLogLastModifiedToken;
+	// Extract the entry data before we touch the event log, so that the only work done
+	// while we hold a slot in the event log is swapping in the new strings.
+	std::wstring text = entry.GetText();
+	std::wstring eventTimeString = entry.GetTimeString();
+	ILogEntry::EventLevel eventLevel = entry.GetEventLevel();
+	unsigned int sourceID = GetLogSourceID(entry.GetSource());
+	_eventLog.WriteEntry(eventLevel, sourceID, text, eventTimeString);
+	_eventLogLastModifiedToken.fetch_add(1, std::memory_order_release);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 Marshal::Ret<std::vector<System::SystemLogEntry>> System::GetEventLog() const
 {
-	std::unique_lock<std::mutex> lock(_eventLogMutex);
-	std::vector<SystemLogEntry> eventLogCopy(_log.size());
-	unsigned int eventLogCopyIndex = 0;
-	for (std::list<SystemLogEntry>::const_iterator i = _log.begin(); i != _log.end(); ++i)
-	{
-		eventLogCopy[eventLogCopyIndex++] = *i;
-	}
+	// Note that this function returns the log with the most recent entry first
+	std::vector<SystemLogEntry> eventLogCopy;
+	ReadEventLogEntries(0, eventLogCopy);
+	std::reverse(eventLogCopy.begin(), eventLogCopy.end());
 	return eventLogCopy;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int System::GetEventLogEntries(unsigned int firstEntryNo, const Marshal::Out<std::vector<SystemLogEntry>>& entries) const
+{
+	std::vector<SystemLogEntry> newEntries;
+	unsigned int nextEntryNo = ReadEventLogEntries(firstEntryNo, newEntries);
+	entries = newEntries;
+	return nextEntryNo;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 unsigned int System::GetEventLogLastModifiedToken() const
 {
-	std::unique_lock<std::mutex> lock(_eventLogMutex);
-	return _eventLogLastModifiedToken;
+	return _eventLogLastModifiedToken.load(std::memory_order_acquire);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int System::GetEventLogClearGeneration() const
+{
+	// Note that this value changes each time the event log is cleared. Callers which hold
+	// their own copy of the log, and track their position in it with the entry number
+	// returned from GetEventLogEntries, use this to detect that their copy is stale.
+	return _eventLogClearGeneration.load(std::memory_order_acquire);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void System::ClearEventLog()
 {
-	std::unique_lock<std::mutex> lock(_eventLogMutex);
-	_log.clear();
-	++_eventLogLastModifiedToken;
+	_eventLog.Clear();
+	_eventLogClearGeneration.fetch_add(1, std::memory_order_release);
+	_eventLogLastModifiedToken.fetch_add(1, std::memory_order_release);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 unsigned int System::GetEventLogSize() const
 {
-	std::unique_lock<std::mutex> lock(_eventLogMutex);
-	return _eventLogSize;
+	return _eventLog.GetSize();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void System::SetEventLogSize(unsigned int logSize)
 {
-	std::unique_lock<std::mutex> lock(_eventLogMutex);
-	_eventLogSize = logSize;
-	while (_log.size() > _eventLogSize)
+	_eventLog.SetSize(logSize);
+	_eventLogLastModifiedToken.fetch_add(1, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int System::ReadEventLogEntries(unsigned int firstEntryNo, std::vector<SystemLogEntry>& entries) const
+{
+	// Copy the requested entries from the event log, and resolve the source name and event
+	// level string for each one.
+	std::vector<EventLogBuffer::Entry> logEntries;
+	unsigned int nextEntryNo = _eventLog.ReadEntries(firstEntryNo, logEntries);
+	entries.reserve(entries.size() + logEntries.size());
+	for (size_t i = 0; i < logEntries.size(); ++i)
+	{
+		EventLogBuffer::Entry& logEntry = logEntries[i];
+		SystemLogEntry entry;
+		entry.eventLevel = logEntry.eventLevel;
+		entry.text.swap(logEntry.text);
+		entry.eventTimeString.swap(logEntry.eventTimeString);
+		entries.push_back(entry);
+		entries.back().source = GetLogSourceName(logEntry.sourceID);
+		entries.back().eventLevelString = LogEntry(logEntry.eventLevel).GetEventLevelString();
+	}
+	return nextEntryNo;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int System::GetLogSourceID(const std::wstring& source)
+{
+	// Log source names are interned into a process-wide table, so that each log entry only
+	// needs to store a small integer for its source. Each thread keeps its own cache of
+	// source IDs it's already resolved, so the shared table only needs to be locked the
+	// first time a thread logs from a given source.
+	static thread_local std::map<std::wstring, unsigned int> threadSourceIDCache;
+	std::map<std::wstring, unsigned int>::const_iterator threadSourceIDCacheIterator = threadSourceIDCache.find(source);
+	if (threadSourceIDCacheIterator != threadSourceIDCache.end())
+	{
+		return threadSourceIDCacheIterator->second;
+	}
+
+	std::unique_lock<std::mutex> lock(GetLogSourceTableMutex());
+	std::vector<std::wstring>& sourceNames = GetLogSourceTable();
+	unsigned int sourceID = 0;
+	while ((sourceID < (unsigned int)sourceNames.size()) && (sourceNames[sourceID] != source))
 	{
-		_log.pop_back();
+		++sourceID;
 	}
-	++_eventLogLastModifiedToken;
+	if (sourceID == (unsigned int)sourceNames.size())
+	{
+		sourceNames.push_back(source);
+	}
+	threadSourceIDCache.insert(std::pair<std::wstring, unsigned int>(source, sourceID));
+	return sourceID;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::wstring System::GetLogSourceName(unsigned int sourceID)
+{
+	std::unique_lock<std::mutex> lock(GetLogSourceTableMutex());
+	std::vector<std::wstring>& sourceNames = GetLogSourceTable();
+	return (sourceID < (unsigned int)sourceNames.size())? sourceNames[sourceID]: std::wstring();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::mutex& System::GetLogSourceTableMutex()
+{
+	static std::mutex logSourceTableMutex;
+	return logSourceTableMutex;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::vector<std::wstring>& System::GetLogSourceTable()
+{
+	static std::vector<std::wstring> logSourceTable;
+	return logSourceTable;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1476,15 +1690,18 @@ bool System::ReloadEmbeddedROMData(const EmbeddedROMInfoInternal& targetEmbedded
 	bool result = file.Open(targetEmbeddedROMInfo.filePath, Stream::File::OpenMode::ReadOnly, Stream::File::CreateMode::Open);
 	if (result)
 	{
+		// Decode the entire ROM image before passing it to the target device as a single
+		// block, so that devices which share their ROM data can replace it in one step.
 		Data romDataEntry(targetEmbeddedROMInfo.romEntryBitCount);
 		Stream::ViewBinary viewBinary(file);
-		unsigned int deviceAddress = 0;
-		while (!viewBinary.IsAtEnd() && viewBinary.NoErrorsOccurred() && (deviceAddress < targetEmbeddedROMInfo.romRegionSize))
+		std::vector<unsigned int> romData;
+		romData.reserve(targetEmbeddedROMInfo.romRegionSize);
+		while (!viewBinary.IsAtEnd() && viewBinary.NoErrorsOccurred() && ((unsigned int)romData.size() < targetEmbeddedROMInfo.romRegionSize))
 		{
 			viewBinary >> romDataEntry;
-			targetEmbeddedROMInfo.targetDevice->TransparentWriteInterface(targetEmbeddedROMInfo.interfaceNumber, deviceAddress, romDataEntry, 0, 0);
-			++deviceAddress;
+			romData.push_back(romDataEntry.GetData());
 		}
+		targetEmbeddedROMInfo.targetDevice->TransparentWriteInterfaceBlock(targetEmbeddedROMInfo.interfaceNumber, 0, romData, targetEmbeddedROMInfo.romEntryBitCount, 0, 0);
 	}
 
 	// Restore the running state
@@ -1748,6 +1965,12 @@ void System::SetCapturePath(const Marshal::In<std::wstring>& path)
 	_capturePath = path;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void System::SetModuleCachePath(const Marshal::In<std::wstring>& path)
+{
+	_moduleCachePath = path;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Loaded entity functions
 //----------------------------------------------------------------------------------------------------------------------
@@ -1953,6 +2176,10 @@ void System::InitializeInternal()
 	// Initialize the devices
 	_executionManager.Initialize();
 
+	// Discard any learned rollback patterns. Patterns are tracked against the elapsed
+	// system time, which no longer lines up with the execution state after a reset.
+	_rollbackPredictor.Reset();
+
 	// Load the persistent state for all loaded modules
 	if (_enablePersistentState)
 	{
@@ -2065,6 +2292,25 @@ void System::SetThrottlingState(bool state)
 	_enableThrottling = state;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+double System::GetThrottlingSyncInterval() const
+{
+	return _throttlingSyncInterval;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void System::SetThrottlingSyncInterval(double intervalInNanoseconds)
+{
+	_throttlingSyncInterval = intervalInNanoseconds;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+Marshal::Ret<System::ThrottlingStatistics> System::GetThrottlingStatistics() const
+{
+	std::unique_lock<std::mutex> lock(_throttlingStatisticsMutex);
+	return _throttlingStatistics;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 bool System::GetRunWhenProgramModuleLoadedState() const
 {
@@ -2089,6 +2335,186 @@ void System::SetEnablePersistentState(bool state)
 	_enablePersistentState = state;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+bool System::GetRollbackPredictionState() const
+{
+	return _rollbackPredictor.GetPredictionEnabled();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void System::SetRollbackPredictionState(bool state)
+{
+	_rollbackPredictor.SetPredictionEnabled(state);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool System::GetCooperativeExecutionState() const
+{
+	return _executionManager.GetCooperativeExecutionEnabled();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void System::SetCooperativeExecutionState(bool state)
+{
+	// Note that a change to the execution mode only takes effect the next time the system
+	// starts executing, so if the system is currently running, we restart it here.
+	bool systemRunning = SystemRunning();
+	if (systemRunning)
+	{
+		StopSystem();
+	}
+	_executionManager.SetCooperativeExecutionEnabled(state);
+	if (systemRunning)
+	{
+		RunSystem();
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int System::GetExecutionWorkerThreadCount() const
+{
+	return _executionManager.GetWorkerThreadCount();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void System::SetExecutionWorkerThreadCount(unsigned int workerThreadCount)
+{
+	// Note that this only controls the worker threads used to commit and roll back devices
+	// in parallel. Each device still executes on its own thread, unless cooperative
+	// execution is enabled. A worker thread count of zero performs all these operations on
+	// the system thread.
+	_executionManager.SetWorkerThreadCount(workerThreadCount);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Execution profiling functions
+//----------------------------------------------------------------------------------------------------------------------
+Marshal::Ret<System::ExecutionProfile> System::GetExecutionProfile() const
+{
+	ExecutionProfile profile;
+	_executionManager.GetExecutionProfile(profile);
+	profile.rollbackPredictionCount = _rollbackPredictor.GetPredictionCount();
+	profile.rollbackAvoidedCount = _rollbackPredictor.GetAvoidedRollbackCount();
+	profile.rollbackMispredictionCount = _rollbackPredictor.GetMispredictionCount();
+	return profile;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void System::ResetExecutionProfile()
+{
+	_executionManager.ResetExecutionProfile();
+	_rollbackPredictor.ResetStatistics();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool System::SaveExecutionProfile(const Marshal::In<std::wstring>& filePath) const
+{
+	ExecutionProfile profile = GetExecutionProfile();
+
+	// Build a JSON representation of the profile. All times are recorded in nanoseconds of
+	// host wall time.
+	std::wstringstream json;
+	json << L"{\n";
+	json << L"\t\"notifyUpcomingTimeslice\": { \"count\": " << profile.notifyUpcomingTimesliceCount << L", \"nanoseconds\": " << profile.notifyUpcomingTimesliceNanoseconds << L" },\n";
+	json << L"\t\"executeTimeslice\": { \"count\": " << profile.executeTimesliceCount << L", \"nanoseconds\": " << profile.executeTimesliceNanoseconds << L" },\n";
+	json << L"\t\"commit\": { \"count\": " << profile.commitCount << L", \"nanoseconds\": " << profile.commitNanoseconds << L" },\n";
+	json << L"\t\"rollback\": { \"count\": " << profile.rollbackCount << L", \"nanoseconds\": " << profile.rollbackNanoseconds << L" },\n";
+	json << L"\t\"timingPointSearch\": { \"count\": " << profile.timingPointSearchCount << L", \"nanoseconds\": " << profile.timingPointSearchNanoseconds << L" },\n";
+	json << L"\t\"timingPointStep\": { \"count\": " << profile.timingPointStepCount << L", \"nanoseconds\": " << profile.timingPointStepNanoseconds << L" },\n";
+	json << L"\t\"suspendCheck\": { \"count\": " << profile.suspendCheckCount << L", \"nanoseconds\": " << profile.suspendCheckNanoseconds << L", \"releaseCount\": " << profile.suspendReleaseCount << L" },\n";
+	json << L"\t\"rollbackPrediction\": { \"predictionCount\": " << profile.rollbackPredictionCount << L", \"avoidedCount\": " << profile.rollbackAvoidedCount << L", \"mispredictionCount\": " << profile.rollbackMispredictionCount << L" },\n";
+	json << L"\t\"timesliceLengthHistogram\": [";
+	for (size_t i = 0; i < profile.timesliceLengthHistogram.size(); ++i)
+	{
+		json << ((i > 0)? L", ": L"") << profile.timesliceLengthHistogram[i];
+	}
+	json << L"],\n";
+	json << L"\t\"devices\": [\n";
+	for (size_t i = 0; i < profile.devices.size(); ++i)
+	{
+		const ExecutionProfileDeviceEntry& device = profile.devices[i];
+		std::wstring escapedDeviceName;
+		for (wchar_t deviceNameChar : device.deviceName)
+		{
+			if ((deviceNameChar == L'\"') || (deviceNameChar == L'\\'))
+			{
+				escapedDeviceName.push_back(L'\\');
+			}
+			escapedDeviceName.push_back(deviceNameChar);
+		}
+		json << L"\t\t{ \"name\": \"" << escapedDeviceName << L"\"";
+		json << L", \"timesliceCount\": " << device.timesliceCount << L", \"timesliceNanoseconds\": " << device.timesliceNanoseconds;
+		json << L", \"timingPointStepCount\": " << device.timingPointStepCount << L", \"timingPointStepNanoseconds\": " << device.timingPointStepNanoseconds;
+		json << L", \"suspendCount\": " << device.suspendCount << L", \"resumeCount\": " << device.resumeCount << L", \"suspendWaitNanoseconds\": " << device.suspendWaitNanoseconds;
+		json << L", \"commitNanoseconds\": " << device.commitNanoseconds << L", \"rollbackNanoseconds\": " << device.rollbackNanoseconds;
+		json << L", \"rollbackRequestCount\": " << device.rollbackRequestCount << L", \"rollbackTriggerCount\": " << device.rollbackTriggerCount << L" }";
+		json << (((i + 1) < profile.devices.size())? L",\n": L"\n");
+	}
+	json << L"\t]\n";
+	json << L"}\n";
+
+	// Save the profile to the target file
+	Stream::File file(Stream::IStream::TextEncoding::UTF8);
+	if (!file.Open(filePath, Stream::File::OpenMode::ReadAndWrite, Stream::File::CreateMode::Create))
+	{
+		WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Failed to save the execution profile because there was an error creating the file at the full path of " + filePath + L"!"));
+		return false;
+	}
+	if (!file.WriteText(json.str()))
+	{
+		WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Failed to save the execution profile because there was an error writing to the file at the full path of " + filePath + L"!"));
+		return false;
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Tracing functions
+//----------------------------------------------------------------------------------------------------------------------
+ITraceRecorder& System::GetTraceRecorder() const
+{
+	return _traceRecorder;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool System::GetTraceRecordingState() const
+{
+	return _traceRecorder.TraceRecordingEnabled();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void System::SetTraceRecordingState(bool state)
+{
+	_traceRecorder.SetTraceRecordingEnabled(state);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void System::ClearTrace()
+{
+	_traceRecorder.ClearTrace();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool System::SaveTrace(const Marshal::In<std::wstring>& filePath) const
+{
+	// Build the trace in the Chrome trace event format
+	std::string json = _traceRecorder.BuildChromeTraceJSON();
+
+	// Save the trace to the target file
+	Stream::File file(Stream::IStream::TextEncoding::UTF8);
+	if (!file.Open(filePath, Stream::File::OpenMode::ReadAndWrite, Stream::File::CreateMode::Create))
+	{
+		WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Failed to save the trace because there was an error creating the file at the full path of " + filePath + L"!"));
+		return false;
+	}
+	if (!file.WriteText(json))
+	{
+		WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Failed to save the trace because there was an error writing to the file at the full path of " + filePath + L"!"));
+		return false;
+	}
+	return true;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void System::SignalSystemStopped()
 {
@@ -2149,6 +2575,77 @@ void System::FlagStopSystem()
 //----------------------------------------------------------------------------------------------------------------------
 void System::ExecuteDeviceStep(IDevice* device)
 {
+	ExecuteDeviceSteps(device, 1);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void System::ExecuteDeviceSteps(IDevice* device, unsigned int stepCount)
+{
+	// Start execution once for the entire batch of steps. Starting and stopping the device
+	// worker threads costs far more than a single step, so stepping through many
+	// instructions one call at a time is extremely slow.
+	BeginStepExecution();
+
+	// Step through the target device until the requested number of steps have been
+	// performed, or a breakpoint or other event has requested the system to stop.
+	DeviceContext* deviceContext = (DeviceContext*)device->GetDeviceContext();
+	for (unsigned int i = 0; (i < stepCount) && !_stopSystem; ++i)
+	{
+		ExecuteDeviceStepInternal(deviceContext);
+	}
+
+	// Stop execution now that the batch is complete
+	EndStepExecution();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void System::ExecuteSystemStep(double targetTime)
+{
+	BeginStepExecution();
+
+	// Advance the system until we reach the target time
+	double totalSystemExecutionTime = 0;
+	while (totalSystemExecutionTime < targetTime)
+	{
+		double timeRemainingToTarget = targetTime - totalSystemExecutionTime;
+		totalSystemExecutionTime += ExecuteSystemStepInternal(timeRemainingToTarget);
+	}
+
+	EndStepExecution();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+double System::ExecuteSystemStepToTimingPoint(double maximumTimeslice)
+{
+	BeginStepExecution();
+
+	// Advance the system until a timeslice ends on a timing point reported by a device,
+	// such as the vsync timing point of a video device, or until we reach the maximum
+	// time. Note that we don't stop on a zero length step, so that if the system is
+	// already sitting on a timing point, we advance to the next one.
+	double totalSystemExecutionTime = 0;
+	bool reachedTimingPoint = false;
+	while (!reachedTimingPoint && (totalSystemExecutionTime < maximumTimeslice))
+	{
+		double timeRemainingToTarget = maximumTimeslice - totalSystemExecutionTime;
+		totalSystemExecutionTime += ExecuteSystemStepInternal(timeRemainingToTarget);
+		reachedTimingPoint = _lastSystemStepEndedOnTimingPoint && (totalSystemExecutionTime > 0);
+	}
+
+	EndStepExecution();
+	return totalSystemExecutionTime;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void System::BeginStepExecution()
+{
+	// Stop the system if it is currently running
+	StopSystem();
+
+	// Clear any stop request left over from a breakpoint hit during a previous step, so
+	// that it doesn't terminate this batch of steps before it begins.
+	_stopSystem = false;
+
 	// Initialize all devices if it has been requested
 	if (_initialize)
 	{
@@ -2166,34 +2663,32 @@ void System::ExecuteDeviceStep(IDevice* device)
 	// manual changes made through the debug interface while the system was idle, and the
 	// initialize step above, are not lost in the event of a rollback.
 	_executionManager.Commit();
+}
 
-	// Flag that we're performing a single device step
-	_performingSingleDeviceStep = true;
-
-	// Notify upcoming timeslice
-	_executionManager.NotifyUpcomingTimeslice(0.0);
+//----------------------------------------------------------------------------------------------------------------------
+void System::EndStepExecution()
+{
+	// Stop active device threads
+	_executionManager.StopExecution();
+}
 
-	// Notify before execute called
-	_executionManager.NotifyBeforeExecuteCalled();
+//----------------------------------------------------------------------------------------------------------------------
+void System::ExecuteDeviceStepInternal(DeviceContext* deviceContext)
+{
+	// Only devices which use the step execution method can be stepped individually.
+	// Devices which execute in timeslices have no concept of a single step outside their
+	// own timing points.
+	if (deviceContext->GetTargetDevice().GetUpdateMethod() != IDevice::UpdateMethod::Step)
+	{
+		return;
+	}
 
-	// Step through the target device
-	//##FIX## This execution model is not only unusual, it now also causes a deadlock, due
-	// to the missed NotifyAfterExecuteStepFinishedTimeslice() event. It could also cause
-	// logic problems for timeslice execution devices, which receive a notification of an
-	// upcoming timeslice, but never receive the timeslice itself. I think perhaps it's
-	// time to unify device stepping with our normal execution model, and just make a
-	// device step execute a system step for a time of 0.0, then step through the device
-	// as a timing point. Actually, looking at our system implementation, it has the exact
-	// same problems and deadlock case. We need to review our execution model here.
+	// Step through the target device as a timing point at the current system time. This
+	// is the same zero-length system step we perform in ExecuteSystemStepInternal when a
+	// device is sitting on a timing point, so devices see the same sequence of
+	// notifications whether they're being stepped by the debugger or by the system.
 	_rollback = false;
-	DeviceContext* deviceContext = (DeviceContext*)device->GetDeviceContext();
-	double timeslice = deviceContext->ExecuteStep();
-
-	// Notify after execute called
-	_executionManager.NotifyAfterExecuteCalled();
-
-	// Flag that we're no longer performing a single device step
-	_performingSingleDeviceStep = false;
+	double timeslice = ExecuteTimingPointStep(deviceContext, 0, false, 0, 0);
 
 	if (_rollback)
 	{
@@ -2201,15 +2696,15 @@ void System::ExecuteDeviceStep(IDevice* device)
 		// now, since we've just advanced it through its timing point in lock step. We need
 		// to perform this operation here, as if we try and step through a device sitting
 		// on a timing point using the loop method below, only the device will advance, and
-		// ExecuteSystemStep will correctly return 0. This will leave us in an infinite
-		// loop.
+		// ExecuteSystemStepInternal will correctly return 0. This will leave us in an
+		// infinite loop.
 		_executionManager.Commit();
 	}
 	else
 	{
 		// If the device we're trying to step through is not sitting on a timing point,
-		// roll back the execution, and pass the execution time to ExecuteSystemStep to
-		// advance the entire system by the target amount.
+		// roll back the execution, and advance the entire system by the time the step took
+		// to execute.
 		_executionManager.Rollback();
 
 		double totalTimeExecuted = 0;
@@ -2218,35 +2713,6 @@ void System::ExecuteDeviceStep(IDevice* device)
 			totalTimeExecuted += ExecuteSystemStepInternal(timeslice - totalTimeExecuted);
 		}
 	}
-
-	// Stop active device threads
-	_executionManager.StopExecution();
-}
-
-//----------------------------------------------------------------------------------------------------------------------
-void System::ExecuteSystemStep(double targetTime)
-{
-	// Stop the system if it is currently running
-	StopSystem();
-
-	// Start active device threads
-	_executionManager.StartExecution();
-
-	// Commit the current state of each device. We perform this task here to ensure that
-	// manual changes made through the debug interface while the system was idle are not
-	// lost in the event of a rollback.
-	_executionManager.Commit();
-
-	// Advance the system until we reach the target time
-	double totalSystemExecutionTime = 0;
-	while (totalSystemExecutionTime < targetTime)
-	{
-		double timeRemainingToTarget = targetTime - totalSystemExecutionTime;
-		totalSystemExecutionTime += ExecuteSystemStepInternal(timeRemainingToTarget);
-	}
-
-	// Stop active device threads
-	_executionManager.StopExecution();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -2257,6 +2723,19 @@ double System::ExecuteSystemStepInternal(double maximumTimeslice)
 	DeviceContext* nextDeviceStep = 0;
 	unsigned int nextDeviceStepContext = 0;
 	double timeslice = _executionManager.GetNextTimingPoint(maximumTimeslice, nextDeviceStep, nextDeviceStepContext);
+	bool timesliceEndsOnTimingPoint = (nextDeviceStep != 0);
+
+	// If we've learned that a rollback is likely to occur before the next timing point,
+	// end the timeslice at the predicted rollback point instead, and step through the
+	// device which would have been stepped after the rollback. If the prediction is wrong,
+	// the rollback will still be caught below, so this can only cost us a shorter
+	// timeslice.
+	IDeviceContext* predictedDeviceStep = 0;
+	if (_rollbackPredictor.GetPredictedTimingPoint(timeslice, timeslice, predictedDeviceStep, nextDeviceStepContext))
+	{
+		nextDeviceStep = (DeviceContext*)predictedDeviceStep;
+		timesliceEndsOnTimingPoint = false;
+	}
 
 	bool callbackStep = false;
 	void (*callbackFunction)(void*) = 0;
@@ -2278,7 +2757,10 @@ double System::ExecuteSystemStepInternal(double maximumTimeslice)
 		_executionManager.NotifyBeforeExecuteCalled();
 
 		// Execute next timeslice
-		_executionManager.ExecuteTimeslice(timeslice);
+		{
+			ITraceRecorder::Scope traceScope(_traceRecorder, "ExecuteTimeslice");
+			_executionManager.ExecuteTimeslice(timeslice);
+		}
 
 		// Notify after execute called
 		_executionManager.NotifyAfterExecuteCalled();
@@ -2310,7 +2792,23 @@ double System::ExecuteSystemStepInternal(double maximumTimeslice)
 		{
 			//##DEBUG##
 			std::wcout << "Rollback\t" << std::setprecision(16) << _rollbackTimeslice << '\n';
-			_executionManager.Rollback();
+			{
+				ITraceRecorder::Scope traceScope(_traceRecorder, "Rollback");
+				_executionManager.Rollback();
+			}
+			((DeviceContext*)_rollbackTriggerDevice)->NotifyRollbackTriggered();
+
+			// Record this rollback so we can learn recurring rollback patterns. Rollbacks
+			// which use a callback function can't be replayed from a prediction, since the
+			// callback parameters are only valid for this rollback.
+			if (!_useRollbackFunction)
+			{
+				_rollbackPredictor.NotifyRollback(_rollbackTriggerDevice, _rollbackDevice, _rollbackContext, _rollbackTimeslice);
+			}
+			else
+			{
+				_rollbackPredictor.CancelPrediction();
+			}
 
 			//##DEBUG##
 			if (_rollbackTimeslice < 0)
@@ -2322,6 +2820,7 @@ double System::ExecuteSystemStepInternal(double maximumTimeslice)
 			timeslice = _rollbackTimeslice;
 			nextDeviceStep = (DeviceContext*)_rollbackDevice;
 			nextDeviceStepContext = _rollbackContext;
+			timesliceEndsOnTimingPoint = false;
 			callbackStep = _useRollbackFunction;
 			if (callbackStep)
 			{
@@ -2333,48 +2832,105 @@ double System::ExecuteSystemStepInternal(double maximumTimeslice)
 	}
 	while (_rollback && (_rollbackTimeslice > 0));
 
+	// If we ended this timeslice at a predicted rollback point, watch the buses for the
+	// predicted access while we step through the device at the boundary, so that the
+	// rollback is only counted as avoided if the access actually occurred.
+	IDeviceContext* predictedTriggerDevice = 0;
+	IDeviceContext* predictedRollbackDevice = 0;
+	bool watchPredictedAccess = _rollbackPredictor.GetActivePrediction(predictedTriggerDevice, predictedRollbackDevice);
+	if (watchPredictedAccess)
+	{
+		for (BusInterfaceList::iterator i = _busInterfaces.begin(); i != _busInterfaces.end(); ++i)
+		{
+			i->busInterface->BeginAccessWatch(predictedRollbackDevice, &predictedTriggerDevice->GetTargetDevice());
+		}
+	}
+
 	// If we are currently sitting on a timing point for a device, step through it.
 	if (nextDeviceStep != 0)
 	{
-		// Flag that we're performing a single device step
-		_performingSingleDeviceStep = true;
+		ExecuteTimingPointStep(nextDeviceStep, nextDeviceStepContext, callbackStep, callbackFunction, callbackParams);
+	}
 
-		// Notify upcoming timeslice
-		_executionManager.NotifyUpcomingTimeslice(0.0);
+	// Collect the result of the predicted access watch
+	bool predictedAccessObserved = false;
+	if (watchPredictedAccess)
+	{
+		for (BusInterfaceList::iterator i = _busInterfaces.begin(); i != _busInterfaces.end(); ++i)
+		{
+			if (i->busInterface->EndAccessWatch())
+			{
+				predictedAccessObserved = true;
+			}
+		}
+	}
 
-		// Notify before execute called
-		_executionManager.NotifyBeforeExecuteCalled();
+	// Commit all changes
+	{
+		ITraceRecorder::Scope traceScope(_traceRecorder, "Commit");
+		_executionManager.Commit();
+	}
+	_rollbackPredictor.NotifyTimesliceCommitted(timeslice, predictedAccessObserved);
+
+	// Clear all input events which have been successfully processed
+	ClearSentStoredInputEvents();
+
+	// Record whether this timeslice ended on a timing point reported by a device, rather
+	// than at the maximum time or at a rollback point.
+	_lastSystemStepEndedOnTimingPoint = timesliceEndsOnTimingPoint;
+
+	return timeslice;
+}
 
+//----------------------------------------------------------------------------------------------------------------------
+double System::ExecuteTimingPointStep(DeviceContext* deviceContext, unsigned int accessContext, bool callbackStep, void (*callbackFunction)(void*), void* callbackParams)
+{
+	// Flag that we're performing a single device step
+	_performingSingleDeviceStep = true;
+
+	// Notify upcoming timeslice
+	_executionManager.NotifyUpcomingTimeslice(0.0);
+
+	// Notify before execute called
+	_executionManager.NotifyBeforeExecuteCalled();
+
+	// Step through the target device, or invoke the rollback callback in its place
+	double stepTime = 0;
+	{
+		ITraceRecorder::Scope traceScope(_traceRecorder, "TimingPointStep");
+		ExecutionProfileTimer::Clock::time_point stepStartTime = ExecutionProfileTimer::Now();
 		if (!callbackStep)
 		{
-			nextDeviceStep->ExecuteStep(nextDeviceStepContext);
+			stepTime = deviceContext->ExecuteStep(accessContext);
 		}
 		else
 		{
 			callbackFunction(callbackParams);
 		}
-
-		// Notify after execute called
-		_executionManager.NotifyAfterExecuteCalled();
-
-		// Flag that we're no longer performing a single device step
-		_performingSingleDeviceStep = false;
+		_executionManager.AddTimingPointStepSample(stepStartTime);
 	}
 
-	// Commit all changes
-	_executionManager.Commit();
+	// Complete the zero-length timeslice we notified devices about above. Devices which
+	// wait for the end of the current timeslice before processing pending line state
+	// changes would otherwise deadlock on the next step, since no timeslice is executed
+	// through the device contexts here.
+	_executionManager.NotifyAfterExecuteStepFinishedTimeslice();
 
-	// Clear all input events which have been successfully processed
-	ClearSentStoredInputEvents();
+	// Notify after execute called
+	_executionManager.NotifyAfterExecuteCalled();
 
-	return timeslice;
+	// Flag that we're no longer performing a single device step
+	_performingSingleDeviceStep = false;
+	return stepTime;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void System::ExecuteThread()
 {
 	// Set the name of this thread to assist in debugging
-	SetCallingThreadName(L"SystemExecuteThread");
+	std::wstring threadName = L"SystemExecuteThread";
+	SetCallingThreadName(threadName);
+	_traceRecorder.SetCurrentThreadTraceName(threadName);
 
 	// Boost the system thread priority. This thread is always on the critical path. We
 	// don't want secondary threads from various devices in the system preventing this
@@ -2426,12 +2982,20 @@ void System::ExecuteThread()
 //		std::wcout << std::setprecision(16) << "System Step: " << systemStepTime << '\t' << accumulatedExecutionTime << '\n';
 
 		// If we're running too fast (*chuckle*), delay execution until we get back in
-		// sync.
-		if (accumulatedExecutionTime >= 20000000.0)
-//		if (accumulatedExecutionTime >= 1000000000.0)
+		// sync. Note that the sync interval is configurable. Shorter intervals give
+		// smoother pacing, at the cost of more frequent sleeps.
+		if (accumulatedExecutionTime >= _throttlingSyncInterval)
 		{
 			timer.Sync(accumulatedExecutionTime, _enableThrottling, _guiExtensionInterface.GetGlobalPreferenceShowDebugConsole());
 			accumulatedExecutionTime = 0;
+
+			// Publish the pacing statistics from the timer, so that they can be retrieved
+			// without touching the timer from another thread.
+			std::unique_lock<std::mutex> lock(_throttlingStatisticsMutex);
+			_throttlingStatistics.syncCount = timer.GetSyncCount();
+			_throttlingStatistics.averageJitterInNanoseconds = timer.GetAverageJitterInNanoseconds();
+			_throttlingStatistics.maxJitterInNanoseconds = timer.GetMaxJitterInNanoseconds();
+			_throttlingStatistics.sleepLatencyInNanoseconds = timer.GetSleepLatencyInNanoseconds();
 		}
 	}
 
@@ -2465,6 +3029,7 @@ void System::SetSystemRollback(IDeviceContext* triggerDevice, IDeviceContext* ro
 	}
 	message << std::setprecision(16) << targetTime << '\t' << conflictingEventTime << '\n';
 	std::wcout << message.str();
+	((DeviceContext*)triggerDevice)->NotifyRollbackRequested();
 
 	std::unique_lock<std::mutex> lock(_systemRollbackMutex);
 	if (!_rollback || (targetTime < _rollbackTimeslice))
@@ -2472,6 +3037,7 @@ void System::SetSystemRollback(IDeviceContext* triggerDevice, IDeviceContext* ro
 		_rollback = true;
 		_rollbackContext = accessContext;
 		_rollbackDevice = rollbackDevice;
+		_rollbackTriggerDevice = triggerDevice;
 
 		// If the device which triggered the rollback uses the step execution method, we
 		// trigger the rollback using the reported current timeslice progress of the device
@@ -2507,6 +3073,30 @@ bool System::PerformingSingleDeviceStep() const
 	return _performingSingleDeviceStep;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Batch execution functions
+//----------------------------------------------------------------------------------------------------------------------
+bool System::RunBatchJobs(const Marshal::In<std::wstring>& jobListFilePath, const Marshal::In<std::wstring>& resultsFilePath, bool verifyDeterminism)
+{
+	// Load the list of jobs to run. Each job runs within its own system, using the devices
+	// and extensions which have been registered with this system.
+	SystemBatchRunner batchRunner(_guiExtensionInterface, *this);
+	if (!batchRunner.LoadJobList(jobListFilePath.Get()))
+	{
+		WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Failed to load batch job list from file " + jobListFilePath + L"!"));
+		return false;
+	}
+
+	// Run each job, and save the results to the target file
+	std::vector<SystemBatchRunner::JobResult> results = batchRunner.Run(0, verifyDeterminism);
+	if (!SystemBatchRunner::SaveResults(results, resultsFilePath.Get()))
+	{
+		WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Failed to save batch job results to file " + resultsFilePath + L"!"));
+		return false;
+	}
+	return true;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Device registration
 //----------------------------------------------------------------------------------------------------------------------
@@ -2699,6 +3289,25 @@ void System::UnregisterExtension(const Marshal::In<std::wstring>& extensionName)
 	}
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Plugin registry functions
+//----------------------------------------------------------------------------------------------------------------------
+bool System::ImportPluginRegistry(const System& sourceSystem)
+{
+	// Copy the registered devices and extensions from the source system. Registry entries
+	// only refer to the allocator and destructor functions exported by each loaded
+	// assembly, so any number of systems within the same process can share the same set of
+	// loaded assemblies in this way. Note that the source system must outlive this system,
+	// as it owns the assembly handles referenced by these entries.
+	if (&sourceSystem == this)
+	{
+		return false;
+	}
+	_deviceLibrary = sourceSystem._deviceLibrary;
+	_extensionLibrary = sourceSystem._extensionLibrary;
+	return true;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // Device creation and deletion
 //----------------------------------------------------------------------------------------------------------------------
@@ -2788,6 +3397,9 @@ void System::UnloadDevice(IDevice* device)
 	_executionManager.RemoveDevice((DeviceContext*)device->GetDeviceContext());
 	RemoveDeviceFromDeviceList(_devices, device);
 
+	// Discard any learned rollback patterns, since they may refer to the removed device
+	_rollbackPredictor.Reset();
+
 	// Destroy the device
 	DestroyDevice(device->GetDeviceClassName(), device);
 }
@@ -3324,31 +3936,206 @@ bool System::LoadModule(const Marshal::In<std::wstring>& filePath, const Marshal
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-bool System::LoadModuleInternal(const std::wstring& filePath, const ConnectorMappingList& connectorMappings, std::list<ViewOpenRequest>& viewOpenRequests, std::list<InputRegistration>& inputRegistrationRequests, std::list<SystemStateChange>& systemSettingsChangeRequests, std::list<unsigned int>& addedModuleIDs)
+bool System::LoadModuleDefinition(const std::wstring& filePath, IHierarchicalStorageTree& tree) const
 {
-	// Update the name of the currently loading module
-	std::wstring fileName = PathGetFileName(filePath);
-	PushLoadModuleCurrentModuleName(fileName);
-
 	// Open the target file
 	FileStreamReference sourceStreamReference(_guiExtensionInterface);
 	if (!sourceStreamReference.OpenExistingFileForRead(filePath))
 	{
 		WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Could not open module file " + filePath + L"!"));
-		PopLoadModuleCurrentModuleName();
 		return false;
 	}
 	Stream::IStream& source = *sourceStreamReference;
 
+	// Read the raw contents of the module file. Note that we key the module cache on a hash
+	// of the file contents rather than the file path or modification time, so that edited
+	// module files are always recompiled, even when they're supplied through an archive or
+	// other source which doesn't preserve timestamps.
+	Stream::IStream::SizeType sourceSize = source.Size();
+	std::vector<unsigned char> sourceData((size_t)sourceSize);
+	if ((sourceSize > 0) && !source.ReadData(&sourceData[0], sourceSize))
+	{
+		WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Could not read module file " + filePath + L"!"));
+		return false;
+	}
+	unsigned long long sourceHash = CalculateModuleDefinitionHash(sourceData);
+
+	// If a compiled form of this module definition is present in the module cache, load the
+	// tree directly from the cache, and skip parsing the XML data entirely.
+	std::wstring cacheFilePath;
+	if (!_moduleCachePath.empty())
+	{
+		std::wstringstream cacheFileNameStream;
+		cacheFileNameStream << std::hex << std::uppercase << std::setfill(L'0') << std::setw(16) << sourceHash << L'_' << std::setw(8) << (unsigned int)sourceSize << L".bin";
+		cacheFilePath = PathCombinePaths(_moduleCachePath, cacheFileNameStream.str());
+		Stream::File cacheFile;
+		if (cacheFile.Open(cacheFilePath, Stream::File::OpenMode::ReadOnly, Stream::File::CreateMode::Open))
+		{
+			unsigned long long cachedSourceHash;
+			unsigned long long cachedSourceSize;
+			bool cacheEntryValid = cacheFile.ReadDataLittleEndian(cachedSourceHash) && cacheFile.ReadDataLittleEndian(cachedSourceSize);
+			cacheEntryValid &= (cachedSourceHash == sourceHash) && (cachedSourceSize == (unsigned long long)sourceSize);
+			if (cacheEntryValid)
+			{
+				tree.SetStorageMode(IHierarchicalStorageTree::StorageMode::Binary);
+				cacheEntryValid = tree.LoadTree(cacheFile);
+				tree.SetStorageMode(IHierarchicalStorageTree::StorageMode::XML);
+			}
+			if (cacheEntryValid)
+			{
+				TouchModuleCacheEntry(cacheFilePath);
+				return true;
+			}
+		}
+	}
+
 	// Determine the text format for the file, and strip any present byte order mark.
-	source.SetTextEncoding(Stream::IStream::TextEncoding::UTF8);
-	source.ProcessByteOrderMark();
+	Stream::Buffer sourceBuffer(Stream::IStream::TextEncoding::UTF8, 0);
+	if (sourceSize > 0)
+	{
+		sourceBuffer.WriteData(&sourceData[0], sourceSize);
+		sourceBuffer.SetStreamPos(0);
+	}
+	sourceBuffer.ProcessByteOrderMark();
 
 	// Load the XML structure from the file
-	HierarchicalStorageTree tree;
-	if (!tree.LoadTree(source))
+	if (!tree.LoadTree(sourceBuffer))
 	{
 		WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Error loading XML structure from module file " + filePath + L"! The xml error string is as follows: " + tree.GetErrorString()));
+		return false;
+	}
+
+	// Save the compiled form of this module definition into the module cache. We write the
+	// cache entry to a temporary file first and move it into place once it's complete, so
+	// that other processes sharing the same module cache never see a partial entry. Note
+	// that failing to write the cache entry isn't an error, as the cache is only an
+	// optimization.
+	if (!cacheFilePath.empty())
+	{
+		std::wstringstream tempFilePathStream;
+		tempFilePathStream << cacheFilePath << L'.' << GetCurrentProcessId() << L".tmp";
+		std::wstring tempFilePath = tempFilePathStream.str();
+		Stream::File cacheFile;
+		if (cacheFile.Open(tempFilePath, Stream::File::OpenMode::ReadAndWrite, Stream::File::CreateMode::Create))
+		{
+			bool cacheEntryWritten = cacheFile.WriteDataLittleEndian(sourceHash) && cacheFile.WriteDataLittleEndian((unsigned long long)sourceSize);
+			tree.SetStorageMode(IHierarchicalStorageTree::StorageMode::Binary);
+			cacheEntryWritten = cacheEntryWritten && tree.SaveTree(cacheFile);
+			tree.SetStorageMode(IHierarchicalStorageTree::StorageMode::XML);
+			cacheFile.Close();
+			if (!cacheEntryWritten || (MoveFileExW(tempFilePath.c_str(), cacheFilePath.c_str(), MOVEFILE_REPLACE_EXISTING) == 0))
+			{
+				DeleteFileW(tempFilePath.c_str());
+			}
+			else
+			{
+				TrimModuleCache();
+			}
+		}
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void System::TouchModuleCacheEntry(const std::wstring& cacheFilePath)
+{
+	// Update the last write time of a module cache entry when it's used, so that the
+	// entries which are trimmed from the cache are the ones which were least recently
+	// used, rather than the ones which were created first. We don't rely on the last
+	// access time here, since it's often disabled on NTFS volumes.
+	HANDLE fileHandle = CreateFileW(cacheFilePath.c_str(), FILE_WRITE_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return;
+	}
+	FILETIME currentTime;
+	GetSystemTimeAsFileTime(&currentTime);
+	SetFileTime(fileHandle, NULL, NULL, &currentTime);
+	CloseHandle(fileHandle);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void System::TrimModuleCache() const
+{
+	// Build a list of all the entries in the module cache. Note that we only consider
+	// files which match the naming scheme used for cache entries, so that nothing else
+	// which happens to be stored in the same folder is ever deleted.
+	struct CacheEntry
+	{
+		std::wstring filePath;
+		unsigned long long lastWriteTime;
+		unsigned long long fileSize;
+	};
+	const size_t cacheEntryFileNameLength = 16 + 1 + 8 + 4;
+	std::vector<CacheEntry> cacheEntries;
+	unsigned long long totalCacheSize = 0;
+	WIN32_FIND_DATAW findData;
+	HANDLE findFileHandle = FindFirstFileW(PathCombinePaths(_moduleCachePath, L"*.bin").c_str(), &findData);
+	if (findFileHandle == INVALID_HANDLE_VALUE)
+	{
+		return;
+	}
+	bool foundFile = true;
+	while (foundFile)
+	{
+		std::wstring entryName = findData.cFileName;
+		if (((findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0) && (entryName.size() == cacheEntryFileNameLength) && (entryName[16] == L'_'))
+		{
+			CacheEntry cacheEntry;
+			cacheEntry.filePath = PathCombinePaths(_moduleCachePath, entryName);
+			cacheEntry.lastWriteTime = ((unsigned long long)findData.ftLastWriteTime.dwHighDateTime << 32) | (unsigned long long)findData.ftLastWriteTime.dwLowDateTime;
+			cacheEntry.fileSize = ((unsigned long long)findData.nFileSizeHigh << 32) | (unsigned long long)findData.nFileSizeLow;
+			totalCacheSize += cacheEntry.fileSize;
+			cacheEntries.push_back(cacheEntry);
+		}
+		foundFile = FindNextFileW(findFileHandle, &findData) != 0;
+	}
+	FindClose(findFileHandle);
+
+	// If the cache is within its limits, there's nothing to trim.
+	size_t cacheEntryCount = cacheEntries.size();
+	if ((cacheEntryCount <= ModuleCacheMaxEntryCount) && (totalCacheSize <= ModuleCacheMaxSizeInBytes))
+	{
+		return;
+	}
+
+	// Delete the least recently used entries until the cache is back within its limits.
+	// Note that another process sharing the module cache may be trimming it at the same
+	// time, so failing to delete an entry isn't an error.
+	std::sort(cacheEntries.begin(), cacheEntries.end(), [](const CacheEntry& left, const CacheEntry& right) { return left.lastWriteTime < right.lastWriteTime; });
+	for (size_t i = 0; (i < cacheEntries.size()) && ((cacheEntryCount > ModuleCacheMaxEntryCount) || (totalCacheSize > ModuleCacheMaxSizeInBytes)); ++i)
+	{
+		DeleteFileW(cacheEntries[i].filePath.c_str());
+		--cacheEntryCount;
+		totalCacheSize -= cacheEntries[i].fileSize;
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned long long System::CalculateModuleDefinitionHash(const std::vector<unsigned char>& data)
+{
+	// Calculate a 64-bit FNV-1a hash of the data. This is not a cryptographic hash, but
+	// it's fast, and more than sufficient to distinguish revisions of a module file.
+	unsigned long long hash = 0xCBF29CE484222325ULL;
+	for (size_t i = 0; i < data.size(); ++i)
+	{
+		hash ^= (unsigned long long)data[i];
+		hash *= 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool System::LoadModuleInternal(const std::wstring& filePath, const ConnectorMappingList& connectorMappings, std::list<ViewOpenRequest>& viewOpenRequests, std::list<InputRegistration>& inputRegistrationRequests, std::list<SystemStateChange>& systemSettingsChangeRequests, std::list<unsigned int>& addedModuleIDs)
+{
+	// Update the name of the currently loading module
+	std::wstring fileName = PathGetFileName(filePath);
+	PushLoadModuleCurrentModuleName(fileName);
+
+	// Load the module definition from the file
+	HierarchicalStorageTree tree;
+	if (!LoadModuleDefinition(filePath, tree))
+	{
 		PopLoadModuleCurrentModuleName();
 		return false;
 	}
@@ -3523,124 +4310,124 @@ bool System::LoadModuleInternal(const std::wstring& filePath, const ConnectorMap
 	NameToIDMap connectorNameToIDMap;
 	NameToIDMap lineGroupNameToIDMap;
 	unsigned int entriesProcessed = 0;
-	std::list<IHierarchicalStorageNode*> childList = rootNode.GetChildList();
-	unsigned int entryCount = (unsigned int)childList.size();
-	for (std::list<IHierarchicalStorageNode*>::const_iterator i = childList.begin(); !_loadSystemAbort && (i != childList.end()); ++i)
+	unsigned int entryCount = rootNode.GetChildCount();
+	for (unsigned int entryNo = 0; !_loadSystemAbort && (entryNo < entryCount); ++entryNo)
 	{
 		_loadSystemProgress = ((float)++entriesProcessed / (float)entryCount);
 
-		std::wstring elementName = (*i)->GetName();
+		IHierarchicalStorageNode& entryNode = *rootNode.GetChildByIndex(entryNo);
+		std::wstring elementName = entryNode.GetName();
 		if (elementName == L"Device")
 		{
-			loadedWithoutErrors &= LoadModule_Device(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_Device(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"Device.SetDependentDevice")
 		{
-			loadedWithoutErrors &= LoadModule_Device_SetDependentDevice(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_Device_SetDependentDevice(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"Device.ReferenceDevice")
 		{
-			loadedWithoutErrors &= LoadModule_Device_ReferenceDevice(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_Device_ReferenceDevice(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"Device.ReferenceExtension")
 		{
-			loadedWithoutErrors &= LoadModule_Device_ReferenceExtension(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_Device_ReferenceExtension(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"Device.ReferenceBus")
 		{
-			loadedWithoutErrors &= LoadModule_Device_ReferenceBus(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_Device_ReferenceBus(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"Device.ReferenceClockSource")
 		{
-			loadedWithoutErrors &= LoadModule_Device_ReferenceClockSource(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_Device_ReferenceClockSource(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"Device.RegisterInput")
 		{
-			loadedWithoutErrors &= LoadModule_Device_RegisterInput(*(*i), moduleInfo.moduleID, inputRegistrationRequests);
+			loadedWithoutErrors &= LoadModule_Device_RegisterInput(entryNode, moduleInfo.moduleID, inputRegistrationRequests);
 		}
 		else if (elementName == L"GlobalExtension")
 		{
-			loadedWithoutErrors &= LoadModule_GlobalExtension(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_GlobalExtension(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"Extension")
 		{
-			loadedWithoutErrors &= LoadModule_Extension(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_Extension(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"Extension.ReferenceDevice")
 		{
-			loadedWithoutErrors &= LoadModule_Extension_ReferenceDevice(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_Extension_ReferenceDevice(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"Extension.ReferenceExtension")
 		{
-			loadedWithoutErrors &= LoadModule_Extension_ReferenceExtension(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_Extension_ReferenceExtension(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"Extension.ReferenceBus")
 		{
-			loadedWithoutErrors &= LoadModule_Extension_ReferenceBus(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_Extension_ReferenceBus(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"Extension.ReferenceClockSource")
 		{
-			loadedWithoutErrors &= LoadModule_Extension_ReferenceClockSource(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_Extension_ReferenceClockSource(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"BusInterface")
 		{
-			loadedWithoutErrors &= LoadModule_BusInterface(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_BusInterface(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"BusInterface.DefineLineGroup")
 		{
-			loadedWithoutErrors &= LoadModule_BusInterface_DefineLineGroup(*(*i), moduleInfo.moduleID, lineGroupNameToIDMap);
+			loadedWithoutErrors &= LoadModule_BusInterface_DefineLineGroup(entryNode, moduleInfo.moduleID, lineGroupNameToIDMap);
 		}
 		else if (elementName == L"BusInterface.DefineCELineMemory")
 		{
-			loadedWithoutErrors &= LoadModule_BusInterface_DefineCELineMemory(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_BusInterface_DefineCELineMemory(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"BusInterface.DefineCELinePort")
 		{
-			loadedWithoutErrors &= LoadModule_BusInterface_DefineCELinePort(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_BusInterface_DefineCELinePort(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"BusInterface.MapCELineInputMemory")
 		{
-			loadedWithoutErrors &= LoadModule_BusInterface_MapCELineInputMemory(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_BusInterface_MapCELineInputMemory(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"BusInterface.MapCELineInputPort")
 		{
-			loadedWithoutErrors &= LoadModule_BusInterface_MapCELineInputPort(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_BusInterface_MapCELineInputPort(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"BusInterface.MapCELineOutputMemory")
 		{
-			loadedWithoutErrors &= LoadModule_BusInterface_MapCELineOutputMemory(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_BusInterface_MapCELineOutputMemory(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"BusInterface.MapCELineOutputPort")
 		{
-			loadedWithoutErrors &= LoadModule_BusInterface_MapCELineOutputPort(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_BusInterface_MapCELineOutputPort(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"BusInterface.MapDevice")
 		{
-			loadedWithoutErrors &= LoadModule_BusInterface_MapDevice(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_BusInterface_MapDevice(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"BusInterface.MapPort")
 		{
-			loadedWithoutErrors &= LoadModule_BusInterface_MapPort(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_BusInterface_MapPort(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"BusInterface.MapLine")
 		{
-			loadedWithoutErrors &= LoadModule_BusInterface_MapLine(*(*i), moduleInfo.moduleID, lineGroupNameToIDMap);
+			loadedWithoutErrors &= LoadModule_BusInterface_MapLine(entryNode, moduleInfo.moduleID, lineGroupNameToIDMap);
 		}
 		else if (elementName == L"BusInterface.MapClockSource")
 		{
-			loadedWithoutErrors &= LoadModule_BusInterface_MapClockSource(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_BusInterface_MapClockSource(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"BusInterface.UnmappedLineState")
 		{
-			loadedWithoutErrors &= LoadModule_BusInterface_UnmappedLineState(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_BusInterface_UnmappedLineState(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"ClockSource")
 		{
-			loadedWithoutErrors &= LoadModule_ClockSource(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_ClockSource(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"ClockSource.SetInputClockSource")
 		{
-			loadedWithoutErrors &= LoadModule_ClockSource_SetInputClockSource(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_ClockSource_SetInputClockSource(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"System.OpenView")
 		{
@@ -3649,35 +4436,35 @@ bool System::LoadModuleInternal(const std::wstring& filePath, const ConnectorMap
 			// has loaded successfully. This removes the need to worry about locked threads
 			// waiting for views to open preventing us from doing cleanup of this module,
 			// in the case that the load fails.
-			loadedWithoutErrors &= LoadModule_System_OpenView(*(*i), moduleInfo.moduleID, viewOpenRequests);
+			loadedWithoutErrors &= LoadModule_System_OpenView(entryNode, moduleInfo.moduleID, viewOpenRequests);
 		}
 		else if (elementName == L"System.ExportConnector")
 		{
-			loadedWithoutErrors &= LoadModule_System_ExportConnector(*(*i), moduleInfo.moduleID, moduleInfo.systemClassName, connectorNameToIDMap);
+			loadedWithoutErrors &= LoadModule_System_ExportConnector(entryNode, moduleInfo.moduleID, moduleInfo.systemClassName, connectorNameToIDMap);
 		}
 		else if (elementName == L"System.ExportDevice")
 		{
-			loadedWithoutErrors &= LoadModule_System_ExportDevice(*(*i), moduleInfo.moduleID, connectorNameToIDMap);
+			loadedWithoutErrors &= LoadModule_System_ExportDevice(entryNode, moduleInfo.moduleID, connectorNameToIDMap);
 		}
 		else if (elementName == L"System.ExportExtension")
 		{
-			loadedWithoutErrors &= LoadModule_System_ExportExtension(*(*i), moduleInfo.moduleID, connectorNameToIDMap);
+			loadedWithoutErrors &= LoadModule_System_ExportExtension(entryNode, moduleInfo.moduleID, connectorNameToIDMap);
 		}
 		else if (elementName == L"System.ExportBusInterface")
 		{
-			loadedWithoutErrors &= LoadModule_System_ExportBusInterface(*(*i), moduleInfo.moduleID, connectorNameToIDMap, lineGroupNameToIDMap);
+			loadedWithoutErrors &= LoadModule_System_ExportBusInterface(entryNode, moduleInfo.moduleID, connectorNameToIDMap, lineGroupNameToIDMap);
 		}
 		else if (elementName == L"System.ExportClockSource")
 		{
-			loadedWithoutErrors &= LoadModule_System_ExportClockSource(*(*i), moduleInfo.moduleID, connectorNameToIDMap);
+			loadedWithoutErrors &= LoadModule_System_ExportClockSource(entryNode, moduleInfo.moduleID, connectorNameToIDMap);
 		}
 		else if (elementName == L"System.ExportSystemLine")
 		{
-			loadedWithoutErrors &= LoadModule_System_ExportSystemLine(*(*i), moduleInfo.moduleID, connectorNameToIDMap);
+			loadedWithoutErrors &= LoadModule_System_ExportSystemLine(entryNode, moduleInfo.moduleID, connectorNameToIDMap);
 		}
 		else if (elementName == L"System.ExportSystemSetting")
 		{
-			loadedWithoutErrors &= LoadModule_System_ExportSystemSetting(*(*i), moduleInfo.moduleID, connectorNameToIDMap);
+			loadedWithoutErrors &= LoadModule_System_ExportSystemSetting(entryNode, moduleInfo.moduleID, connectorNameToIDMap);
 		}
 		else if (elementName == L"System.ImportConnector")
 		{
@@ -3685,52 +4472,52 @@ bool System::LoadModuleInternal(const std::wstring& filePath, const ConnectorMap
 			// connector to import, specifying a target connector. This is required, in
 			// order to allow the user to specify connections between modules before
 			// performing a load.
-			loadedWithoutErrors &= LoadModule_System_ImportConnector(*(*i), moduleInfo.moduleID, moduleInfo.systemClassName, connectorMappings, connectorNameToIDMap);
+			loadedWithoutErrors &= LoadModule_System_ImportConnector(entryNode, moduleInfo.moduleID, moduleInfo.systemClassName, connectorMappings, connectorNameToIDMap);
 		}
 		else if (elementName == L"System.ImportDevice")
 		{
-			loadedWithoutErrors &= LoadModule_System_ImportDevice(*(*i), moduleInfo.moduleID, connectorNameToIDMap);
+			loadedWithoutErrors &= LoadModule_System_ImportDevice(entryNode, moduleInfo.moduleID, connectorNameToIDMap);
 		}
 		else if (elementName == L"System.ImportExtension")
 		{
-			loadedWithoutErrors &= LoadModule_System_ImportExtension(*(*i), moduleInfo.moduleID, connectorNameToIDMap);
+			loadedWithoutErrors &= LoadModule_System_ImportExtension(entryNode, moduleInfo.moduleID, connectorNameToIDMap);
 		}
 		else if (elementName == L"System.ImportBusInterface")
 		{
-			loadedWithoutErrors &= LoadModule_System_ImportBusInterface(*(*i), moduleInfo.moduleID, connectorNameToIDMap, lineGroupNameToIDMap);
+			loadedWithoutErrors &= LoadModule_System_ImportBusInterface(entryNode, moduleInfo.moduleID, connectorNameToIDMap, lineGroupNameToIDMap);
 		}
 		else if (elementName == L"System.ImportClockSource")
 		{
-			loadedWithoutErrors &= LoadModule_System_ImportClockSource(*(*i), moduleInfo.moduleID, connectorNameToIDMap);
+			loadedWithoutErrors &= LoadModule_System_ImportClockSource(entryNode, moduleInfo.moduleID, connectorNameToIDMap);
 		}
 		else if (elementName == L"System.ImportSystemLine")
 		{
-			loadedWithoutErrors &= LoadModule_System_ImportSystemLine(*(*i), moduleInfo.moduleID, connectorNameToIDMap);
+			loadedWithoutErrors &= LoadModule_System_ImportSystemLine(entryNode, moduleInfo.moduleID, connectorNameToIDMap);
 		}
 		else if (elementName == L"System.ImportSystemSetting")
 		{
-			loadedWithoutErrors &= LoadModule_System_ImportSystemSetting(*(*i), moduleInfo.moduleID, connectorNameToIDMap);
+			loadedWithoutErrors &= LoadModule_System_ImportSystemSetting(entryNode, moduleInfo.moduleID, connectorNameToIDMap);
 		}
 		else if (elementName == L"System.DefineEmbeddedROM")
 		{
-			loadedWithoutErrors &= LoadModule_System_DefineEmbeddedROM(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_System_DefineEmbeddedROM(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"System.DefineSystemLine")
 		{
-			loadedWithoutErrors &= LoadModule_System_DefineSystemLine(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_System_DefineSystemLine(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"System.MapSystemLine")
 		{
-			loadedWithoutErrors &= LoadModule_System_MapSystemLine(*(*i), moduleInfo.moduleID);
+			loadedWithoutErrors &= LoadModule_System_MapSystemLine(entryNode, moduleInfo.moduleID);
 		}
 		else if (elementName == L"System.Setting")
 		{
-			loadedWithoutErrors &= LoadModule_System_Setting(*(*i), moduleInfo.moduleID, fileName);
+			loadedWithoutErrors &= LoadModule_System_Setting(entryNode, moduleInfo.moduleID, fileName);
 		}
 		else if (elementName == L"System.SelectSettingOption")
 		{
 			SystemStateChange systemStateChange;
-			if (LoadModule_System_SelectSettingOption(*(*i), moduleInfo.moduleID, systemStateChange))
+			if (LoadModule_System_SelectSettingOption(entryNode, moduleInfo.moduleID, systemStateChange))
 			{
 				systemSettingsChangeRequests.push_back(systemStateChange);
 			}
@@ -3742,7 +4529,7 @@ bool System::LoadModuleInternal(const std::wstring& filePath, const ConnectorMap
 		else if (elementName == L"System.SetClockFrequency")
 		{
 			SystemStateChange systemStateChange;
-			if (LoadModule_System_SetClockFrequency(*(*i), moduleInfo.moduleID, systemStateChange))
+			if (LoadModule_System_SetClockFrequency(entryNode, moduleInfo.moduleID, systemStateChange))
 			{
 				systemSettingsChangeRequests.push_back(systemStateChange);
 			}
@@ -3754,7 +4541,7 @@ bool System::LoadModuleInternal(const std::wstring& filePath, const ConnectorMap
 		else if (elementName == L"System.SetLineState")
 		{
 			SystemStateChange systemStateChange;
-			if (LoadModule_System_SetLineState(*(*i), moduleInfo.moduleID, systemStateChange))
+			if (LoadModule_System_SetLineState(entryNode, moduleInfo.moduleID, systemStateChange))
 			{
 				systemSettingsChangeRequests.push_back(systemStateChange);
 			}
@@ -3966,16 +4753,19 @@ bool System::LoadSystem_System_LoadEmbeddedROMData(const std::wstring& fileDir,
 	}
 	Stream::IStream& file = *fileStreamReference;
 
-	// Load the data from the target file into this embedded ROM
+	// Load the data from the target file into this embedded ROM. We decode the entire
+	// image before passing it to the target device as a single block, so that devices
+	// which share their ROM data can replace it in one step.
 	Data romDataEntry(embeddedROMInfoEntry->romEntryBitCount);
 	Stream::ViewBinary viewBinary(file);
-	unsigned int deviceAddress = 0;
-	while (!viewBinary.IsAtEnd() && viewBinary.NoErrorsOccurred() && (deviceAddress < embeddedROMInfoEntry->romRegionSize))
+	std::vector<unsigned int> romData;
+	romData.reserve(embeddedROMInfoEntry->romRegionSize);
+	while (!viewBinary.IsAtEnd() && viewBinary.NoErrorsOccurred() && ((unsigned int)romData.size() < embeddedROMInfoEntry->romRegionSize))
 	{
 		viewBinary >> romDataEntry;
-		embeddedROMInfoEntry->targetDevice->TransparentWriteInterface(embeddedROMInfoEntry->interfaceNumber, deviceAddress, romDataEntry, 0, 0);
-		++deviceAddress;
+		romData.push_back(romDataEntry.GetData());
 	}
+	embeddedROMInfoEntry->targetDevice->TransparentWriteInterfaceBlock(embeddedROMInfoEntry->interfaceNumber, 0, romData, embeddedROMInfoEntry->romEntryBitCount, 0, 0);
 	bool romDataLoadedSuccessfully = viewBinary.NoErrorsOccurred();
 
 	// Update the last modified token for embedded ROM data
@@ -8182,24 +8972,10 @@ void System::UnloadAllModules()
 //----------------------------------------------------------------------------------------------------------------------
 bool System::ReadModuleConnectorInfo(const Marshal::In<std::wstring>& filePath, const Marshal::Out<std::wstring>& systemClassName, const Marshal::Out<ConnectorImportList>& connectorsImported, const Marshal::Out<ConnectorExportList>& connectorsExported) const
 {
-	// Open the target file
-	FileStreamReference streamReference(_guiExtensionInterface);
-	if (!streamReference.OpenExistingFileForRead(filePath))
-	{
-		WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Could not open module file " + filePath + L"!"));
-		return false;
-	}
-	Stream::IStream& source = *streamReference;
-
-	// Determine the text format for the file, and strip any present byte order mark.
-	source.SetTextEncoding(Stream::IStream::TextEncoding::UTF8);
-	source.ProcessByteOrderMark();
-
-	// Load the XML structure from the file
+	// Load the module definition from the file
 	HierarchicalStorageTree tree;
-	if (!tree.LoadTree(source))
+	if (!LoadModuleDefinition(filePath, tree))
 	{
-		WriteLogEvent(LogEntry(LogEntry::EventLevel::Error, L"System", L"Error loading XML structure from module file " + filePath + L"! The xml error string is as follows: " + tree.GetErrorString()));
 		return false;
 	}
 	IHierarchicalStorageNode& rootNode = tree.GetRootNode();
@@ -22,15 +22,21 @@ should be able to be sent to all devices simultaneously.
 #include "WindowsSupport/WindowsSupport.pkg"
 #include "DeviceInterface/DeviceInterface.pkg"
 #include "SystemInterface/SystemInterface.pkg"
+#include "ThreadLib/ThreadLib.pkg"
 #include "BusInterface.h"
 #include "ClockSource.h"
 #include "DeviceContext.h"
 #include "ExecutionManager.h"
+#include "TraceRecorder.h"
+#include "RollbackPredictor.h"
+#include "EventLogBuffer.h"
 #include <string>
 #include <vector>
 #include <map>
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
+#include <memory>
 
 // Terminology:
 // Assembly  - An assembly (IE, a dll) which contains the definition of one or more devices
@@ -74,13 +80,18 @@ public:
 	virtual bool LoadState(const Marshal::In<std::wstring>& filePath, FileType fileType, bool debuggerState);
 	virtual bool SaveState(const Marshal::In<std::wstring>& filePath, FileType fileType, bool debuggerState);
 	virtual Marshal::Ret<StateInfo> GetStateInfo(const Marshal::In<std::wstring>& filePath, FileType fileType) const;
+	virtual Marshal::Ret<StateInfo> GetStateHeaderInfo(const Marshal::In<std::wstring>& filePath, FileType fileType, IImage& thumbnail) const;
+	virtual Marshal::Ret<std::wstring> GetSaveStateComments() const;
+	virtual void SetSaveStateComments(const Marshal::In<std::wstring>& comments);
 	virtual bool LoadModuleRelationshipsNode(IHierarchicalStorageNode& node, const Marshal::Out<ModuleRelationshipMap>& relationshipMap) const;
 	virtual void SaveModuleRelationshipsNode(IHierarchicalStorageNode& node, bool saveFilePathInfo = false, const Marshal::In<std::wstring>& relativePathBase = L"") const;
 
 	// Logging functions
 	virtual void WriteLogEvent(const ILogEntry& entry) const;
 	virtual Marshal::Ret<std::vector<SystemLogEntry>> GetEventLog() const;
+	virtual unsigned int GetEventLogEntries(unsigned int firstEntryNo, const Marshal::Out<std::vector<SystemLogEntry>>& entries) const;
 	virtual unsigned int GetEventLogLastModifiedToken() const;
+	virtual unsigned int GetEventLogClearGeneration() const;
 	virtual void ClearEventLog();
 	virtual unsigned int GetEventLogSize() const;
 	virtual void SetEventLogSize(unsigned int logSize);
@@ -104,6 +115,7 @@ public:
 	// Path functions
 	virtual Marshal::Ret<std::wstring> GetCapturePath() const;
 	virtual void SetCapturePath(const Marshal::In<std::wstring>& path);
+	virtual void SetModuleCachePath(const Marshal::In<std::wstring>& path);
 
 	// System interface functions
 	virtual void FlagInitialize();
@@ -111,10 +123,31 @@ public:
 	virtual void InitializeDevice(IDevice* device);
 	virtual bool GetThrottlingState() const;
 	virtual void SetThrottlingState(bool state);
+	virtual double GetThrottlingSyncInterval() const;
+	virtual void SetThrottlingSyncInterval(double intervalInNanoseconds);
+	virtual Marshal::Ret<ThrottlingStatistics> GetThrottlingStatistics() const;
 	virtual bool GetRunWhenProgramModuleLoadedState() const;
 	virtual void SetRunWhenProgramModuleLoadedState(bool state);
 	virtual bool GetEnablePersistentState() const;
 	virtual void SetEnablePersistentState(bool state);
+	virtual bool GetRollbackPredictionState() const;
+	virtual void SetRollbackPredictionState(bool state);
+	virtual bool GetCooperativeExecutionState() const;
+	virtual void SetCooperativeExecutionState(bool state);
+	unsigned int GetExecutionWorkerThreadCount() const;
+	void SetExecutionWorkerThreadCount(unsigned int workerThreadCount);
+
+	// Execution profiling functions
+	virtual Marshal::Ret<ExecutionProfile> GetExecutionProfile() const;
+	virtual void ResetExecutionProfile();
+	virtual bool SaveExecutionProfile(const Marshal::In<std::wstring>& filePath) const;
+
+	// Tracing functions
+	virtual ITraceRecorder& GetTraceRecorder() const;
+	virtual bool GetTraceRecordingState() const;
+	virtual void SetTraceRecordingState(bool state);
+	virtual void ClearTrace();
+	virtual bool SaveTrace(const Marshal::In<std::wstring>& filePath) const;
 
 	// Device registration
 	virtual bool RegisterDevice(const IDeviceInfo& entry, AssemblyHandle assemblyHandle);
@@ -124,6 +157,9 @@ public:
 	virtual bool RegisterExtension(const IExtensionInfo& entry, AssemblyHandle assemblyHandle);
 	virtual void UnregisterExtension(const Marshal::In<std::wstring>& extensionName);
 
+	// Plugin registry functions
+	bool ImportPluginRegistry(const System& sourceSystem);
+
 	// Module loading and unloading
 	virtual void LoadModuleSynchronous(const Marshal::In<std::wstring>& filePath, const Marshal::In<ConnectorMappingList>& connectorMappings);
 	virtual void LoadModuleSynchronousAbort();
@@ -168,12 +204,17 @@ public:
 	virtual void StopSystem();
 	virtual void FlagStopSystem();
 	virtual void ExecuteDeviceStep(IDevice* device);
+	virtual void ExecuteDeviceSteps(IDevice* device, unsigned int stepCount);
 	virtual void ExecuteSystemStep(double maximumTimeslice);
+	double ExecuteSystemStepToTimingPoint(double maximumTimeslice);
 	virtual bool IsSystemRollbackFlagged() const;
 	virtual double SystemRollbackTime() const;
 	virtual void SetSystemRollback(IDeviceContext* triggerDevice, IDeviceContext* rollbackDevice, double targetTime, double conflictingEventTime, unsigned int accessContext, void (*callbackFunction)(void*), void* callbackParams);
 	virtual bool PerformingSingleDeviceStep() const;
 
+	// Batch execution functions
+	virtual bool RunBatchJobs(const Marshal::In<std::wstring>& jobListFilePath, const Marshal::In<std::wstring>& resultsFilePath, bool verifyDeterminism);
+
 	// View functions
 	virtual void BuildFileOpenMenu(IMenuSubmenu& menuSubmenu) const;
 	virtual void BuildSystemMenu(IMenuSubmenu& menuSubmenu) const;
@@ -233,7 +274,6 @@ private:
 	struct ConnectorInfoInternal;
 	struct InputMapEntry;
 	struct InputEventEntry;
-	struct LogEntryInternal;
 	struct ViewOpenRequest;
 	struct InputRegistration;
 	struct UnmappedLineStateInfo;
@@ -287,6 +327,13 @@ private:
 	typedef std::list<ImportedSystemSettingInfo> ImportedSystemSettingList;
 	typedef std::list<SystemLineMapping> SystemLineMappingList;
 
+private:
+	// Module cache constants
+	// The module cache is trimmed back to these limits each time a new entry is added,
+	// discarding the least recently used entries first.
+	static const unsigned int ModuleCacheMaxEntryCount = 512;
+	static const unsigned long long ModuleCacheMaxSizeInBytes = 64ULL * 1024 * 1024;
+
 private:
 	// Embedded ROM functions
 	bool ReloadEmbeddedROMData(const EmbeddedROMInfoInternal& targetEmbeddedROMInfo);
@@ -368,6 +415,10 @@ private:
 	bool LoadModule_System_SetClockFrequency(IHierarchicalStorageNode& node, unsigned int moduleID, SystemStateChange& stateChange);
 	bool LoadModule_System_SetLineState(IHierarchicalStorageNode& node, unsigned int moduleID, SystemStateChange& stateChange);
 	bool LoadModule_ProcessViewQueue(const std::list<ViewOpenRequest>& viewOpenRequests);
+	bool LoadModuleDefinition(const std::wstring& filePath, IHierarchicalStorageTree& tree) const;
+	static unsigned long long CalculateModuleDefinitionHash(const std::vector<unsigned char>& data);
+	static void TouchModuleCacheEntry(const std::wstring& cacheFilePath);
+	void TrimModuleCache() const;
 	bool LoadModuleInternal(const std::wstring& filePath, const ConnectorMappingList& connectorMappings, std::list<ViewOpenRequest>& viewOpenRequests, std::list<InputRegistration>& inputRegistrationRequests, std::list<SystemStateChange>& systemSettingsChangeRequests, std::list<unsigned int>& addedModuleIDs);
 	void UnloadModuleInternal(unsigned int moduleID);
 	bool LoadSystem_Device_Settings(IHierarchicalStorageNode& node, std::map<unsigned int, unsigned int>& savedModuleIDToLoadedModuleIDMap);
@@ -380,6 +431,13 @@ private:
 	void PushUnloadModuleCurrentModuleName(const std::wstring& moduleName);
 	void PopUnloadModuleCurrentModuleName();
 
+	// Logging functions
+	unsigned int ReadEventLogEntries(unsigned int firstEntryNo, std::vector<SystemLogEntry>& entries) const;
+	static unsigned int GetLogSourceID(const std::wstring& source);
+	static std::wstring GetLogSourceName(unsigned int sourceID);
+	static std::mutex& GetLogSourceTableMutex();
+	static std::vector<std::wstring>& GetLogSourceTable();
+
 	// Device creation and deletion
 	bool AddDevice(unsigned int moduleID, IDevice* device, DeviceContext* deviceContext);
 	IDevice* CreateDevice(const std::wstring& deviceName, const std::wstring& instanceName, unsigned int moduleID) const;
@@ -400,7 +458,11 @@ private:
 	void SignalSystemStopped();
 
 	// System execution functions
+	void BeginStepExecution();
+	void EndStepExecution();
+	void ExecuteDeviceStepInternal(DeviceContext* deviceContext);
 	double ExecuteSystemStepInternal(double maximumTimeslice);
+	double ExecuteTimingPointStep(DeviceContext* deviceContext, unsigned int accessContext, bool callbackStep, void (*callbackFunction)(void*), void* callbackParams);
 	void ExecuteThread();
 
 	// Output stream functions
@@ -485,6 +547,8 @@ private:
 	LoadedDeviceInfoList _loadedDeviceInfoList;
 	ImportedDeviceInfoList _importedDeviceInfoList;
 	ExecutionManager _executionManager;
+	mutable TraceRecorder _traceRecorder;
+	RollbackPredictor _rollbackPredictor;
 	DeviceArray _devices;
 
 	// Extensions
@@ -534,7 +598,12 @@ private:
 
 	// System settings
 	std::wstring _capturePath;
+	std::wstring _moduleCachePath;
+	std::wstring _saveStateComments;
 	bool _enableThrottling;
+	std::atomic<double> _throttlingSyncInterval;
+	mutable std::mutex _throttlingStatisticsMutex;
+	ThrottlingStatistics _throttlingStatistics;
 	bool _runWhenProgramModuleLoaded;
 	bool _enablePersistentState;
 
@@ -551,7 +620,6 @@ private:
 	mutable std::mutex _systemStateMutex;
 	mutable std::mutex _moduleLoadMutex;
 	mutable std::mutex _loadedElementMutex;
-	mutable std::mutex _eventLogMutex;
 	mutable std::mutex _embeddedROMMutex;
 	mutable std::recursive_mutex _moduleSettingMutex;
 
@@ -569,6 +637,7 @@ private:
 	volatile bool _loadSystemAbort;
 	volatile bool _clearSystemComplete;
 	volatile bool _performingSingleDeviceStep;
+	bool _lastSystemStepEndedOnTimingPoint;
 	std::list<std::wstring> _loadSystemCurrentModuleNameStack;
 	std::list<std::wstring> _unloadSystemCurrentModuleNameStack;
 
@@ -576,14 +645,15 @@ private:
 	volatile double _rollbackTimeslice;
 	unsigned int _rollbackContext;
 	IDeviceContext* _rollbackDevice;
+	IDeviceContext* _rollbackTriggerDevice;
 	bool _useRollbackFunction;
 	void (*_rollbackFunction)(void*);
 	void* _rollbackParams;
 
 	// Event log settings
-	unsigned int _eventLogSize;
-	mutable unsigned int _eventLogLastModifiedToken;
-	mutable std::list<SystemLogEntry> _log;
+	mutable EventLogBuffer _eventLog;
+	mutable std::atomic<unsigned int> _eventLogLastModifiedToken;
+	std::atomic<unsigned int> _eventLogClearGeneration;
 
 	// Notification settings
 	ObserverCollection _loadedModuleChangeObservers;
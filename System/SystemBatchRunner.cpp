@@ -0,0 +1,303 @@
+#include "SystemBatchRunner.h"
+#include "System.h"
+#include "ExecutionProfileTimer.h"
+#include "HierarchicalStorage/HierarchicalStorage.pkg"
+#include "Stream/Stream.pkg"
+#include <atomic>
+#include <thread>
+#include <sstream>
+#include <iomanip>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+SystemBatchRunner::SystemBatchRunner(IGUIExtensionInterface& guiExtensionInterface, const System& pluginRegistrySource)
+:_guiExtensionInterface(guiExtensionInterface), _pluginRegistrySource(pluginRegistrySource)
+{ }
+
+//----------------------------------------------------------------------------------------------------------------------
+// Job functions
+//----------------------------------------------------------------------------------------------------------------------
+void SystemBatchRunner::AddJob(const Job& job)
+{
+	_jobs.push_back(job);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void SystemBatchRunner::ClearJobs()
+{
+	_jobs.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int SystemBatchRunner::GetJobCount() const
+{
+	return (unsigned int)_jobs.size();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool SystemBatchRunner::LoadJobList(const std::wstring& filePath)
+{
+	// Attempt to open the target job list file
+	Stream::File file;
+	if (!file.Open(filePath, Stream::File::OpenMode::ReadOnly, Stream::File::CreateMode::Open))
+	{
+		return false;
+	}
+
+	// Attempt to decode the XML contents of the file
+	file.SetTextEncoding(Stream::IStream::TextEncoding::UTF8);
+	file.ProcessByteOrderMark();
+	HierarchicalStorageTree tree;
+	if (!tree.LoadTree(file))
+	{
+		return false;
+	}
+
+	// Validate the root node of the XML tree
+	IHierarchicalStorageNode& rootNode = tree.GetRootNode();
+	if (rootNode.GetName() != L"BatchJobs")
+	{
+		return false;
+	}
+
+	// Load each job from the job list. Each job lists the modules to load in order as
+	// child nodes, for example:
+	// <Job Name="Example" FrameCount="600">
+	//   <Module FilePath="Modules\Sega Mega Drive 1600.xml" />
+	//   <Module FilePath="Cache\Example.xml" />
+	// </Job>
+	std::list<IHierarchicalStorageNode*> jobNodes = rootNode.GetChildList();
+	for (std::list<IHierarchicalStorageNode*>::const_iterator i = jobNodes.begin(); i != jobNodes.end(); ++i)
+	{
+		IHierarchicalStorageNode& jobNode = *(*i);
+		if (jobNode.GetName() != L"Job")
+		{
+			continue;
+		}
+		Job job;
+		jobNode.ExtractAttribute(L"Name", job.jobName);
+		jobNode.ExtractAttribute(L"FrameCount", job.frameCount);
+		jobNode.ExtractAttribute(L"MaximumFramePeriod", job.maximumFramePeriodInNanoseconds);
+		std::list<IHierarchicalStorageNode*> moduleNodes = jobNode.GetChildList();
+		for (std::list<IHierarchicalStorageNode*>::const_iterator moduleNodeIterator = moduleNodes.begin(); moduleNodeIterator != moduleNodes.end(); ++moduleNodeIterator)
+		{
+			std::wstring moduleFilePath;
+			if (((*moduleNodeIterator)->GetName() == L"Module") && (*moduleNodeIterator)->ExtractAttribute(L"FilePath", moduleFilePath))
+			{
+				job.moduleFilePaths.push_back(moduleFilePath);
+			}
+		}
+		AddJob(job);
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Execution functions
+//----------------------------------------------------------------------------------------------------------------------
+std::vector<SystemBatchRunner::JobResult> SystemBatchRunner::Run(unsigned int maxConcurrentJobs, bool verifyDeterminism) const
+{
+	// Determine the number of worker threads to use. If no limit was specified, we run one
+	// job for each hardware thread. Since each job system executes cooperatively, a job
+	// never occupies more than one hardware thread.
+	std::vector<JobResult> results(_jobs.size());
+	unsigned int workerThreadCount = (maxConcurrentJobs > 0)? maxConcurrentJobs: std::thread::hardware_concurrency();
+	workerThreadCount = (workerThreadCount < 1)? 1: workerThreadCount;
+	workerThreadCount = (workerThreadCount > (unsigned int)_jobs.size())? (unsigned int)_jobs.size(): workerThreadCount;
+
+	// Run each job on the next available worker thread. Jobs are claimed in order through a
+	// shared index, and each job writes only to its own result entry.
+	std::atomic<unsigned int> nextJobIndex(0);
+	std::vector<std::thread> workerThreads;
+	for (unsigned int i = 0; i < workerThreadCount; ++i)
+	{
+		workerThreads.push_back(std::thread([&]
+		{
+			unsigned int jobIndex;
+			while ((jobIndex = nextJobIndex.fetch_add(1)) < (unsigned int)_jobs.size())
+			{
+				RunJob(_jobs[jobIndex], results[jobIndex], verifyDeterminism);
+			}
+		}));
+	}
+	for (unsigned int i = 0; i < (unsigned int)workerThreads.size(); ++i)
+	{
+		workerThreads[i].join();
+	}
+	return results;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool SystemBatchRunner::SaveResults(const std::vector<JobResult>& results, const std::wstring& filePath)
+{
+	// Build a JSON representation of the results. All times are recorded in nanoseconds of
+	// host wall time, and frame hashes are written as hexadecimal strings. The determinism
+	// result is only written for jobs which were run a second time to verify it.
+	std::wstringstream json;
+	json << L"{\n";
+	json << L"\t\"jobs\": [\n";
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		const JobResult& result = results[i];
+		std::wstring escapedJobName;
+		for (wchar_t jobNameChar : result.jobName)
+		{
+			if ((jobNameChar == L'\"') || (jobNameChar == L'\\'))
+			{
+				escapedJobName.push_back(L'\\');
+			}
+			escapedJobName.push_back(jobNameChar);
+		}
+		json << L"\t\t{ \"name\": \"" << escapedJobName << L"\"";
+		json << L", \"loadSucceeded\": " << (result.loadSucceeded? L"true": L"false") << L", \"loadNanoseconds\": " << result.loadNanoseconds << L", \"executionNanoseconds\": " << result.executionNanoseconds;
+		if (result.determinismVerified)
+		{
+			json << L", \"deterministic\": " << (result.deterministic? L"true": L"false");
+			if (!result.deterministic)
+			{
+				json << L", \"firstDivergentFrame\": " << result.firstDivergentFrameNo;
+			}
+		}
+		json << L", \"frameHashes\": [";
+		for (size_t frameNo = 0; frameNo < result.frameHashes.size(); ++frameNo)
+		{
+			json << ((frameNo > 0)? L", ": L"") << L"\"" << std::hex << std::setw(16) << std::setfill(L'0') << result.frameHashes[frameNo] << std::dec << L"\"";
+		}
+		json << L"], \"frameNanoseconds\": [";
+		for (size_t frameNo = 0; frameNo < result.frameNanoseconds.size(); ++frameNo)
+		{
+			json << ((frameNo > 0)? L", ": L"") << result.frameNanoseconds[frameNo];
+		}
+		json << L"] }";
+		json << (((i + 1) < results.size())? L",\n": L"\n");
+	}
+	json << L"\t]\n";
+	json << L"}\n";
+
+	// Save the results to the target file
+	Stream::File file(Stream::IStream::TextEncoding::UTF8);
+	if (!file.Open(filePath, Stream::File::OpenMode::ReadAndWrite, Stream::File::CreateMode::Create))
+	{
+		return false;
+	}
+	return file.WriteText(json.str());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Job execution functions
+//----------------------------------------------------------------------------------------------------------------------
+void SystemBatchRunner::RunJob(const Job& job, JobResult& result, bool verifyDeterminism) const
+{
+	// Run the job, recording the results of this run.
+	ExecuteJob(job, result);
+	if (!verifyDeterminism || !result.loadSucceeded)
+	{
+		return;
+	}
+
+	// Run the job a second time within a new system, and compare the frame hashes of both
+	// runs. Since each job system starts from the same modules and receives no input, any
+	// difference in the committed device state at any frame indicates that emulation of
+	// this job isn't deterministic.
+	JobResult verificationResult;
+	ExecuteJob(job, verificationResult);
+	result.determinismVerified = true;
+	result.deterministic = verificationResult.loadSucceeded && (verificationResult.frameHashes.size() == result.frameHashes.size());
+	result.firstDivergentFrameNo = (unsigned int)((result.frameHashes.size() < verificationResult.frameHashes.size())? result.frameHashes.size(): verificationResult.frameHashes.size());
+	for (unsigned int frameNo = 0; frameNo < result.firstDivergentFrameNo; ++frameNo)
+	{
+		if (result.frameHashes[frameNo] != verificationResult.frameHashes[frameNo])
+		{
+			result.deterministic = false;
+			result.firstDivergentFrameNo = frameNo;
+			break;
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void SystemBatchRunner::ExecuteJob(const Job& job, JobResult& result) const
+{
+	// Create a new system for this job, sharing the registered devices and extensions of
+	// our template system. We disable throttling so the job runs as fast as the host
+	// allows, and disable persistent state so that concurrent jobs using the same modules
+	// don't compete to load and save the same persistent state files. We also commit and
+	// roll back devices on this thread, since there are already as many jobs running as
+	// there are hardware threads, and a worker pool for each job would oversubscribe them.
+	result.jobName = job.jobName;
+	System system(_guiExtensionInterface);
+	system.ImportPluginRegistry(_pluginRegistrySource);
+	system.SetThrottlingState(false);
+	system.SetRunWhenProgramModuleLoadedState(false);
+	system.SetEnablePersistentState(false);
+	system.SetCooperativeExecutionState(true);
+	system.SetExecutionWorkerThreadCount(0);
+
+	// Load each module for this job in order
+	ExecutionProfileTimer::Clock::time_point loadStartTime = ExecutionProfileTimer::Now();
+	bool loadSucceeded = true;
+	for (std::list<std::wstring>::const_iterator i = job.moduleFilePaths.begin(); loadSucceeded && (i != job.moduleFilePaths.end()); ++i)
+	{
+		loadSucceeded = system.LoadModule(*i, ISystemGUIInterface::ConnectorMappingList());
+	}
+	result.loadNanoseconds = (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(ExecutionProfileTimer::Now() - loadStartTime).count();
+	result.loadSucceeded = loadSucceeded;
+	if (!loadSucceeded)
+	{
+		return;
+	}
+
+	// Advance the system one frame at a time, recording a hash of the committed device
+	// state and the host time taken to emulate each frame. Each frame ends at the next
+	// timing point reported by a device, so that frames stay aligned to the vsync point of
+	// the emulated video device regardless of the frame rate of the emulated system.
+	system.Initialize();
+	result.frameHashes.reserve(job.frameCount);
+	result.frameNanoseconds.reserve(job.frameCount);
+	for (unsigned int frameNo = 0; frameNo < job.frameCount; ++frameNo)
+	{
+		ExecutionProfileTimer::Clock::time_point frameStartTime = ExecutionProfileTimer::Now();
+		system.ExecuteSystemStepToTimingPoint(job.maximumFramePeriodInNanoseconds);
+		unsigned long long frameNanoseconds = (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(ExecutionProfileTimer::Now() - frameStartTime).count();
+		result.frameNanoseconds.push_back(frameNanoseconds);
+		result.executionNanoseconds += frameNanoseconds;
+		result.frameHashes.push_back(HashSystemState(system));
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned long long SystemBatchRunner::HashSystemState(System& system)
+{
+	// Save the state of each loaded device into a state tree, in the same form we use for
+	// savestates, and build a 64-bit FNV-1a hash over the binary encoding of the tree. Note
+	// that we don't hash the screenshots presented by video devices here, since these are
+	// produced asynchronously by the render thread of the device, and may not yet reflect
+	// the frame we've just stepped to. The saved state of each device, including video and
+	// palette memory, is fixed once the system step has been committed.
+	HierarchicalStorageTree tree;
+	tree.GetRootNode().SetName(L"State");
+	std::list<IDevice*> devices = system.GetLoadedDevices();
+	for (std::list<IDevice*>::const_iterator i = devices.begin(); i != devices.end(); ++i)
+	{
+		IHierarchicalStorageNode& node = tree.GetRootNode().CreateChild(L"Device");
+		node.CreateAttribute(L"Name", (*i)->GetDeviceInstanceName());
+		(*i)->SaveState(node);
+	}
+	Stream::Buffer stateBuffer(0);
+	tree.SetStorageMode(IHierarchicalStorageTree::StorageMode::Binary);
+	if (!tree.SaveTree(stateBuffer))
+	{
+		return 0;
+	}
+
+	const unsigned long long fnvPrime = 0x100000001B3ULL;
+	unsigned long long hash = 0xCBF29CE484222325ULL;
+	const unsigned char* stateData = stateBuffer.GetRawBuffer();
+	Stream::IStream::SizeType stateDataSize = stateBuffer.Size();
+	for (Stream::IStream::SizeType i = 0; i < stateDataSize; ++i)
+	{
+		hash = (hash ^ stateData[i]) * fnvPrime;
+	}
+	return hash;
+}
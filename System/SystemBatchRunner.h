@@ -0,0 +1,57 @@
+#ifndef __SYSTEMBATCHRUNNER_H__
+#define __SYSTEMBATCHRUNNER_H__
+#include "SystemInterface/SystemInterface.pkg"
+#include "ExtensionInterface/ExtensionInterface.pkg"
+#include <string>
+#include <list>
+#include <vector>
+class System;
+
+// Runs a batch of independent emulation jobs, each within its own System instance, across
+// a set of worker threads. Every job loads a list of module files, such as a system module
+// followed by the module generated for a ROM image, then advances the system one frame at a
+// time, recording a hash of the committed state of the loaded devices and the host time
+// taken for each frame. Frames are delimited by the timing points devices report, such as
+// the vsync timing point of a video device, so each hash is taken at the same point within
+// the emulated frame. All job systems share the plugin registry of a single template
+// system, so device and extension assemblies only need to be loaded once per process. Each
+// job system is placed into cooperative execution mode with no execution worker threads, so
+// that a job executes entirely on the worker thread it was assigned to, and jobs never
+// contend for device or commit worker threads. If determinism verification is requested,
+// each job is run a second time in a new system, and the frame hashes of the two runs are
+// compared.
+class SystemBatchRunner
+{
+public:
+	// Structures
+	struct Job;
+	struct JobResult;
+
+public:
+	// Constructors
+	SystemBatchRunner(IGUIExtensionInterface& guiExtensionInterface, const System& pluginRegistrySource);
+
+	// Job functions
+	void AddJob(const Job& job);
+	void ClearJobs();
+	unsigned int GetJobCount() const;
+	bool LoadJobList(const std::wstring& filePath);
+
+	// Execution functions
+	std::vector<JobResult> Run(unsigned int maxConcurrentJobs = 0, bool verifyDeterminism = false) const;
+	static bool SaveResults(const std::vector<JobResult>& results, const std::wstring& filePath);
+
+private:
+	// Job execution functions
+	void RunJob(const Job& job, JobResult& result, bool verifyDeterminism) const;
+	void ExecuteJob(const Job& job, JobResult& result) const;
+	static unsigned long long HashSystemState(System& system);
+
+private:
+	IGUIExtensionInterface& _guiExtensionInterface;
+	const System& _pluginRegistrySource;
+	std::vector<Job> _jobs;
+};
+
+#include "SystemBatchRunner.inl"
+#endif
@@ -0,0 +1,35 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Structures
+//----------------------------------------------------------------------------------------------------------------------
+struct SystemBatchRunner::Job
+{
+	Job()
+	:frameCount(0), maximumFramePeriodInNanoseconds(1000000000.0 / 25.0)
+	{ }
+
+	std::wstring jobName;
+	std::list<std::wstring> moduleFilePaths;
+	unsigned int frameCount;
+	// Note that each frame ends at the next timing point reported by a device. This is the
+	// longest time a frame is advanced by if no device reports a timing point, which by
+	// default is two PAL frames.
+	double maximumFramePeriodInNanoseconds;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+struct SystemBatchRunner::JobResult
+{
+	JobResult()
+	:loadSucceeded(false), loadNanoseconds(0), executionNanoseconds(0), determinismVerified(false), deterministic(false), firstDivergentFrameNo(0)
+	{ }
+
+	std::wstring jobName;
+	bool loadSucceeded;
+	unsigned long long loadNanoseconds;
+	unsigned long long executionNanoseconds;
+	std::vector<unsigned long long> frameHashes;
+	std::vector<unsigned long long> frameNanoseconds;
+	bool determinismVerified;
+	bool deterministic;
+	unsigned int firstDivergentFrameNo;
+};
@@ -0,0 +1,131 @@
+#include "catch.hpp"
+#include "../EventLogBuffer.h"
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+static void WriteEntries(EventLogBuffer& eventLog, unsigned int firstValue, unsigned int entryCount)
+{
+	for (unsigned int i = 0; i < entryCount; ++i)
+	{
+		std::wstring text = std::to_wstring(firstValue + i);
+		std::wstring eventTimeString;
+		eventLog.WriteEntry(ILogEntry::EventLevel::Info, 0, text, eventTimeString);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static bool EntriesMatch(const std::vector<EventLogBuffer::Entry>& entries, unsigned int firstValue, unsigned int entryCount)
+{
+	if (entries.size() != entryCount)
+	{
+		return false;
+	}
+	for (unsigned int i = 0; i < entryCount; ++i)
+	{
+		if (entries[i].text != std::to_wstring(firstValue + i))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST_CASE("EventLogBuffer::ReadEntries", "")
+{
+	SECTION("Read from start", "")
+	{
+		EventLogBuffer eventLog(8);
+		WriteEntries(eventLog, 0, 5);
+		std::vector<EventLogBuffer::Entry> entries;
+		REQUIRE(eventLog.ReadEntries(0, entries) == 5);
+		REQUIRE(EntriesMatch(entries, 0, 5));
+	}
+	SECTION("Read continues from returned entry number", "")
+	{
+		EventLogBuffer eventLog(8);
+		WriteEntries(eventLog, 0, 3);
+		std::vector<EventLogBuffer::Entry> entries;
+		unsigned int nextEntryNo = eventLog.ReadEntries(0, entries);
+		WriteEntries(eventLog, 3, 2);
+		entries.clear();
+		REQUIRE(eventLog.ReadEntries(nextEntryNo, entries) == 5);
+		REQUIRE(EntriesMatch(entries, 3, 2));
+	}
+	SECTION("Overwritten entries are skipped", "")
+	{
+		EventLogBuffer eventLog(8);
+		WriteEntries(eventLog, 0, 20);
+		std::vector<EventLogBuffer::Entry> entries;
+		REQUIRE(eventLog.ReadEntries(0, entries) == 20);
+		REQUIRE(EntriesMatch(entries, 12, 8));
+	}
+	SECTION("Cleared entries are skipped", "")
+	{
+		EventLogBuffer eventLog(8);
+		WriteEntries(eventLog, 0, 5);
+		eventLog.Clear();
+		WriteEntries(eventLog, 5, 2);
+		std::vector<EventLogBuffer::Entry> entries;
+		REQUIRE(eventLog.ReadEntries(0, entries) == 7);
+		REQUIRE(EntriesMatch(entries, 5, 2));
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST_CASE("EventLogBuffer::SetSize", "")
+{
+	SECTION("Grow after wrapping", "")
+	{
+		// The old buffer has wrapped, so only its most recent entries remain, and the
+		// slots in the new buffer for the overwritten entries are empty. Reading from the
+		// start of the log needs to skip past these empty slots to the retained entries.
+		EventLogBuffer eventLog(8);
+		WriteEntries(eventLog, 0, 20);
+		eventLog.SetSize(32);
+		REQUIRE(eventLog.GetSize() == 32);
+		std::vector<EventLogBuffer::Entry> entries;
+		REQUIRE(eventLog.ReadEntries(0, entries) == 20);
+		REQUIRE(EntriesMatch(entries, 12, 8));
+	}
+	SECTION("Grow then write", "")
+	{
+		EventLogBuffer eventLog(8);
+		WriteEntries(eventLog, 0, 20);
+		eventLog.SetSize(32);
+		WriteEntries(eventLog, 20, 10);
+		std::vector<EventLogBuffer::Entry> entries;
+		REQUIRE(eventLog.ReadEntries(0, entries) == 30);
+		REQUIRE(EntriesMatch(entries, 12, 18));
+	}
+	SECTION("Grow before wrapping", "")
+	{
+		EventLogBuffer eventLog(8);
+		WriteEntries(eventLog, 0, 5);
+		eventLog.SetSize(32);
+		std::vector<EventLogBuffer::Entry> entries;
+		REQUIRE(eventLog.ReadEntries(0, entries) == 5);
+		REQUIRE(EntriesMatch(entries, 0, 5));
+	}
+	SECTION("Shrink", "")
+	{
+		EventLogBuffer eventLog(32);
+		WriteEntries(eventLog, 0, 20);
+		eventLog.SetSize(8);
+		std::vector<EventLogBuffer::Entry> entries;
+		REQUIRE(eventLog.ReadEntries(0, entries) == 20);
+		REQUIRE(EntriesMatch(entries, 12, 8));
+	}
+	SECTION("Grow after clear", "")
+	{
+		EventLogBuffer eventLog(8);
+		WriteEntries(eventLog, 0, 20);
+		eventLog.Clear();
+		WriteEntries(eventLog, 20, 3);
+		eventLog.SetSize(32);
+		std::vector<EventLogBuffer::Entry> entries;
+		REQUIRE(eventLog.ReadEntries(0, entries) == 23);
+		REQUIRE(EntriesMatch(entries, 20, 3));
+	}
+}
@@ -0,0 +1,110 @@
+#include "catch.hpp"
+#include "../ExecutionWorkerPool.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_CASE("ExecutionWorkerPool::ParallelFor", "")
+{
+	SECTION("Trivial item counts", "")
+	{
+		ExecutionWorkerPool workerPool(4);
+		unsigned int callCount = 0;
+		workerPool.ParallelFor(0, [&](unsigned int i) { ++callCount; });
+		REQUIRE(callCount == 0);
+		workerPool.ParallelFor(1, [&](unsigned int i) { callCount += (i == 0)? 1: 100; });
+		REQUIRE(callCount == 1);
+	}
+	SECTION("No worker threads", "")
+	{
+		ExecutionWorkerPool workerPool(0);
+		std::vector<unsigned int> itemCallCounts(16, 0);
+		workerPool.ParallelFor(16, [&](unsigned int i) { ++itemCallCounts[i]; });
+		for (unsigned int i = 0; i < 16; ++i)
+		{
+			REQUIRE(itemCallCounts[i] == 1);
+		}
+	}
+	SECTION("Each item processed exactly once", "")
+	{
+		const unsigned int itemCount = 64;
+		ExecutionWorkerPool workerPool(4);
+		std::vector<std::atomic<unsigned int>> itemCallCounts(itemCount);
+		for (unsigned int dispatchNo = 0; dispatchNo < 1000; ++dispatchNo)
+		{
+			for (unsigned int i = 0; i < itemCount; ++i)
+			{
+				itemCallCounts[i].store(0);
+			}
+			workerPool.ParallelFor(itemCount, [&](unsigned int i) { itemCallCounts[i].fetch_add(1); });
+			for (unsigned int i = 0; i < itemCount; ++i)
+			{
+				REQUIRE(itemCallCounts[i].load() == 1);
+			}
+		}
+	}
+	SECTION("Back to back dispatches on fresh pools", "")
+	{
+		// The first dispatch on a new pool is published while the worker threads are
+		// still starting up. This used to cause a worker thread to miss the first
+		// dispatch, leaving the dispatching thread waiting on it forever, so we create a
+		// large number of fresh pools here and run a burst of dispatches on each one.
+		for (unsigned int poolNo = 0; poolNo < 200; ++poolNo)
+		{
+			ExecutionWorkerPool workerPool(1 + (poolNo % 7));
+			std::atomic<unsigned int> totalCallCount(0);
+			for (unsigned int dispatchNo = 0; dispatchNo < 50; ++dispatchNo)
+			{
+				workerPool.ParallelFor(2 + (dispatchNo % 8), [&](unsigned int i) { totalCallCount.fetch_add(1); });
+			}
+			unsigned int expectedCallCount = 0;
+			for (unsigned int dispatchNo = 0; dispatchNo < 50; ++dispatchNo)
+			{
+				expectedCallCount += 2 + (dispatchNo % 8);
+			}
+			REQUIRE(totalCallCount.load() == expectedCallCount);
+		}
+	}
+	SECTION("Items run concurrently with a thread for each item", "")
+	{
+		// The execution manager relies on this to start and stop devices which wait on
+		// each other. Each item here blocks until every other item has started, so this
+		// would hang if any item had to wait for a thread to finish an earlier item.
+		for (unsigned int itemCount = 2; itemCount <= 8; ++itemCount)
+		{
+			ExecutionWorkerPool workerPool(itemCount - 1);
+			for (unsigned int dispatchNo = 0; dispatchNo < 20; ++dispatchNo)
+			{
+				std::atomic<unsigned int> startedItemCount(0);
+				workerPool.ParallelFor(itemCount, [&](unsigned int i)
+				{
+					startedItemCount.fetch_add(1);
+					while (startedItemCount.load() < itemCount)
+					{
+						std::this_thread::yield();
+					}
+				});
+				REQUIRE(startedItemCount.load() == itemCount);
+			}
+		}
+	}
+	SECTION("Changing the worker thread count between dispatches", "")
+	{
+		ExecutionWorkerPool workerPool(4);
+		const unsigned int workerThreadCounts[] = { 4, 0, 2, 2, 6, 0 };
+		for (unsigned int countNo = 0; countNo < (sizeof(workerThreadCounts) / sizeof(workerThreadCounts[0])); ++countNo)
+		{
+			workerPool.SetWorkerThreadCount(workerThreadCounts[countNo]);
+			REQUIRE(workerPool.GetWorkerThreadCount() == workerThreadCounts[countNo]);
+			std::vector<std::atomic<unsigned int>> itemCallCounts(32);
+			for (unsigned int dispatchNo = 0; dispatchNo < 20; ++dispatchNo)
+			{
+				workerPool.ParallelFor(32, [&](unsigned int i) { itemCallCounts[i].fetch_add(1); });
+			}
+			for (unsigned int i = 0; i < 32; ++i)
+			{
+				REQUIRE(itemCallCounts[i].load() == 20);
+			}
+		}
+	}
+}
@@ -0,0 +1,169 @@
+#include "catch.hpp"
+#include "../RollbackPredictor.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+// The predictor never dereferences the device pointers it's given, it only uses them to
+// tell patterns apart, so we use the addresses of some local objects as our devices.
+//----------------------------------------------------------------------------------------------------------------------
+static int triggerDeviceObject;
+static int rollbackDeviceObject;
+static IDeviceContext* const TriggerDevice = reinterpret_cast<IDeviceContext*>(&triggerDeviceObject);
+static IDeviceContext* const RollbackDevice = reinterpret_cast<IDeviceContext*>(&rollbackDeviceObject);
+static const unsigned int AccessContext = 7;
+static const double PatternInterval = 1000000.0;
+static const double PatternOffset = 500.0;
+static const double MaximumTimeslice = 20000000.0;
+
+//----------------------------------------------------------------------------------------------------------------------
+// Executes up to the given absolute time, rolling back and stepping through the rollback
+// device at that point, as the system does when a real rollback occurs.
+//----------------------------------------------------------------------------------------------------------------------
+static void ExecuteRollbackAt(RollbackPredictor& predictor, double& currentTime, double rollbackTime)
+{
+	double timeslice = rollbackTime - currentTime;
+	predictor.NotifyRollback(TriggerDevice, RollbackDevice, AccessContext, timeslice);
+	predictor.NotifyTimesliceCommitted(timeslice, false);
+	currentTime = rollbackTime;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Feeds in enough rollbacks on a fixed interval for the pattern to become confirmed
+//----------------------------------------------------------------------------------------------------------------------
+static void LearnPattern(RollbackPredictor& predictor, double& currentTime, unsigned int& occurrenceNo)
+{
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		ExecuteRollbackAt(predictor, currentTime, PatternOffset + ((double)occurrenceNo++ * PatternInterval));
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Requests a prediction, and if one is made, ends the timeslice at the predicted point
+//----------------------------------------------------------------------------------------------------------------------
+static bool ExecutePredictedTimeslice(RollbackPredictor& predictor, double& currentTime, bool predictedAccessObserved)
+{
+	double timeslice = MaximumTimeslice;
+	IDeviceContext* device = 0;
+	unsigned int accessContext = 0;
+	if (!predictor.GetPredictedTimingPoint(MaximumTimeslice, timeslice, device, accessContext))
+	{
+		return false;
+	}
+	predictor.NotifyTimesliceCommitted(timeslice, predictedAccessObserved);
+	currentTime += timeslice;
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST_CASE("RollbackPredictor", "")
+{
+	RollbackPredictor predictor;
+	double currentTime = 0;
+	unsigned int occurrenceNo = 0;
+
+	SECTION("Learn", "")
+	{
+		// A pattern needs to repeat its interval before we predict anything
+		double timeslice = MaximumTimeslice;
+		IDeviceContext* device = 0;
+		unsigned int accessContext = 0;
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			ExecuteRollbackAt(predictor, currentTime, PatternOffset + ((double)occurrenceNo++ * PatternInterval));
+			REQUIRE_FALSE(predictor.GetPredictedTimingPoint(MaximumTimeslice, timeslice, device, accessContext));
+		}
+
+		// Once the interval has been confirmed, the next occurrence is predicted
+		ExecuteRollbackAt(predictor, currentTime, PatternOffset + ((double)occurrenceNo++ * PatternInterval));
+		REQUIRE(predictor.GetPredictedTimingPoint(MaximumTimeslice, timeslice, device, accessContext));
+		REQUIRE(timeslice == PatternInterval);
+		REQUIRE(device == RollbackDevice);
+		REQUIRE(accessContext == AccessContext);
+		IDeviceContext* predictedTriggerDevice = 0;
+		IDeviceContext* predictedRollbackDevice = 0;
+		REQUIRE(predictor.GetActivePrediction(predictedTriggerDevice, predictedRollbackDevice));
+		REQUIRE(predictedTriggerDevice == TriggerDevice);
+		REQUIRE(predictedRollbackDevice == RollbackDevice);
+	}
+	SECTION("Irregular intervals aren't predicted", "")
+	{
+		const double rollbackTimes[] = {500.0, 1000500.0, 2300500.0, 2900500.0, 4700500.0, 5100500.0};
+		for (unsigned int i = 0; i < (sizeof(rollbackTimes) / sizeof(rollbackTimes[0])); ++i)
+		{
+			ExecuteRollbackAt(predictor, currentTime, rollbackTimes[i]);
+		}
+		REQUIRE_FALSE(ExecutePredictedTimeslice(predictor, currentTime, true));
+	}
+	SECTION("Predict", "")
+	{
+		// Each prediction where the access is observed at the boundary is an avoided
+		// rollback, and the following prediction stays on the learned schedule.
+		LearnPattern(predictor, currentTime, occurrenceNo);
+		for (unsigned int i = 0; i < 10; ++i)
+		{
+			REQUIRE(ExecutePredictedTimeslice(predictor, currentTime, true));
+			REQUIRE(currentTime == PatternOffset + ((double)occurrenceNo++ * PatternInterval));
+		}
+		REQUIRE(predictor.GetPredictionCount() == 10);
+		REQUIRE(predictor.GetAvoidedRollbackCount() == 10);
+		REQUIRE(predictor.GetMispredictionCount() == 0);
+
+		// A real rollback after a run of avoided ones lands a whole number of intervals
+		// after the last real rollback, which must still confirm the pattern.
+		occurrenceNo += 2;
+		ExecuteRollbackAt(predictor, currentTime, PatternOffset + ((double)occurrenceNo++ * PatternInterval));
+		REQUIRE(ExecutePredictedTimeslice(predictor, currentTime, true));
+		REQUIRE(currentTime == PatternOffset + ((double)occurrenceNo++ * PatternInterval));
+	}
+	SECTION("Mispredict", "")
+	{
+		// A prediction where the access isn't observed at the boundary isn't an avoided
+		// rollback.
+		LearnPattern(predictor, currentTime, occurrenceNo);
+		REQUIRE(ExecutePredictedTimeslice(predictor, currentTime, false));
+		REQUIRE(predictor.GetAvoidedRollbackCount() == 0);
+		REQUIRE(predictor.GetMispredictionCount() == 1);
+
+		// A rollback for the predicted pattern within the predicted timeslice is also a
+		// misprediction.
+		double timeslice = MaximumTimeslice;
+		IDeviceContext* device = 0;
+		unsigned int accessContext = 0;
+		REQUIRE(predictor.GetPredictedTimingPoint(MaximumTimeslice, timeslice, device, accessContext));
+		predictor.NotifyRollback(TriggerDevice, RollbackDevice, AccessContext, timeslice - 100.0);
+		REQUIRE(predictor.GetMispredictionCount() == 2);
+		IDeviceContext* predictedTriggerDevice = 0;
+		IDeviceContext* predictedRollbackDevice = 0;
+		REQUIRE_FALSE(predictor.GetActivePrediction(predictedTriggerDevice, predictedRollbackDevice));
+		REQUIRE(predictor.GetAvoidedRollbackCount() == 0);
+	}
+	SECTION("Decay", "")
+	{
+		// If the predicted access stops occurring, the pattern is dropped after repeated
+		// mispredictions, and isn't predicted again until it has been relearned.
+		LearnPattern(predictor, currentTime, occurrenceNo);
+		unsigned int predictionCount = 0;
+		while (ExecutePredictedTimeslice(predictor, currentTime, false))
+		{
+			++predictionCount;
+			REQUIRE(predictionCount <= 4);
+		}
+		REQUIRE(predictionCount == 4);
+		REQUIRE(predictor.GetAvoidedRollbackCount() == 0);
+		REQUIRE(predictor.GetMispredictionCount() == 4);
+	}
+	SECTION("Reset", "")
+	{
+		LearnPattern(predictor, currentTime, occurrenceNo);
+		predictor.Reset();
+		REQUIRE_FALSE(ExecutePredictedTimeslice(predictor, currentTime, true));
+	}
+	SECTION("Disabled", "")
+	{
+		LearnPattern(predictor, currentTime, occurrenceNo);
+		predictor.SetPredictionEnabled(false);
+		REQUIRE_FALSE(ExecutePredictedTimeslice(predictor, currentTime, true));
+		predictor.SetPredictionEnabled(true);
+		REQUIRE(ExecutePredictedTimeslice(predictor, currentTime, true));
+	}
+}
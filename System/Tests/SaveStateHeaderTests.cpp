@@ -0,0 +1,187 @@
+#include "catch.hpp"
+#include "../SaveStateHeader.h"
+#include "Image/Image.pkg"
+#include "Stream/Stream.pkg"
+#include "ZIP/ZIP.pkg"
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+static SaveStateHeader::Info BuildTestInfo()
+{
+	SaveStateHeader::Info info;
+	info.creationDate = L"2026-10-19";
+	info.creationTime = L"13:41:00";
+	info.comments = L"Before the final boss";
+	info.screenshotFilename = L"screenshot.png";
+	info.debuggerState = false;
+	info.screenshotPresent = true;
+	return info;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static void BuildTestScreenshot(Image& screenshot)
+{
+	screenshot.SetImageFormat(320, 224, IImage::PIXELFORMAT_RGB, IImage::DATAFORMAT_8BIT);
+	for (unsigned int ypos = 0; ypos < 224; ++ypos)
+	{
+		for (unsigned int xpos = 0; xpos < 320; ++xpos)
+		{
+			screenshot.WritePixelData(xpos, ypos, 0, (unsigned char)10);
+			screenshot.WritePixelData(xpos, ypos, 1, (unsigned char)200);
+			screenshot.WritePixelData(xpos, ypos, 2, (unsigned char)30);
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static void BuildTestArchive(Stream::IStream& target, bool includeHeader)
+{
+	// Build a savestate archive with the header stored first, followed by state data
+	// which isn't valid xml, so that any attempt to parse the state would fail.
+	ZIPArchive archive;
+	if (includeHeader)
+	{
+		Stream::Buffer headerBuffer(0);
+		Image screenshot;
+		BuildTestScreenshot(screenshot);
+		REQUIRE(SaveStateHeader::Save(headerBuffer, BuildTestInfo(), &screenshot));
+		ZIPFileEntry headerEntry;
+		headerEntry.SetFileName(L"header.bin");
+		headerBuffer.SetStreamPos(0);
+		REQUIRE(headerEntry.Store(headerBuffer));
+		archive.AddFileEntry(headerEntry);
+	}
+	Stream::Buffer stateBuffer(0);
+	unsigned int randomValue = 1;
+	for (unsigned int i = 0; i < 0x10000; ++i)
+	{
+		randomValue = (randomValue * 1103515245) + 12345;
+		stateBuffer.WriteData((unsigned char)(randomValue >> 16));
+	}
+	ZIPFileEntry stateEntry;
+	stateEntry.SetFileName(L"save.xml");
+	stateBuffer.SetStreamPos(0);
+	REQUIRE(stateEntry.Compress(stateBuffer));
+	archive.AddFileEntry(stateEntry);
+	REQUIRE(archive.SaveToStream(target));
+	target.SetStreamPos(0);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST_CASE("SaveStateHeader::Load", "")
+{
+	SECTION("Header round trip", "")
+	{
+		Stream::Buffer buffer(0);
+		Image screenshot;
+		BuildTestScreenshot(screenshot);
+		SaveStateHeader::Info info = BuildTestInfo();
+		REQUIRE(SaveStateHeader::Save(buffer, info, &screenshot));
+		Stream::IStream::SizeType headerSize = buffer.Size();
+		buffer.SetStreamPos(0);
+
+		SaveStateHeader::Info loadedInfo;
+		Image thumbnail;
+		REQUIRE(SaveStateHeader::Load(buffer, loadedInfo, thumbnail));
+		REQUIRE(buffer.GetStreamPos() == headerSize);
+		REQUIRE(loadedInfo.creationDate == info.creationDate);
+		REQUIRE(loadedInfo.creationTime == info.creationTime);
+		REQUIRE(loadedInfo.comments == info.comments);
+		REQUIRE(loadedInfo.screenshotFilename == info.screenshotFilename);
+		REQUIRE(loadedInfo.debuggerState == info.debuggerState);
+		REQUIRE(loadedInfo.screenshotPresent == info.screenshotPresent);
+		REQUIRE(loadedInfo.thumbnailPresent);
+
+		// The thumbnail is scaled to fit within the maximum thumbnail size, preserving the
+		// aspect ratio of the screenshot.
+		REQUIRE(thumbnail.GetImageWidth() == SaveStateHeader::ThumbnailMaxWidth);
+		REQUIRE(thumbnail.GetImageHeight() == 90);
+		unsigned char red;
+		unsigned char green;
+		unsigned char blue;
+		thumbnail.ReadPixelData(64, 45, 0, red);
+		thumbnail.ReadPixelData(64, 45, 1, green);
+		thumbnail.ReadPixelData(64, 45, 2, blue);
+		REQUIRE(((red >= 9) && (red <= 11)));
+		REQUIRE(((green >= 199) && (green <= 201)));
+		REQUIRE(((blue >= 29) && (blue <= 31)));
+	}
+	SECTION("Header size is fixed", "")
+	{
+		Stream::Buffer firstBuffer(0);
+		Stream::Buffer secondBuffer(0);
+		SaveStateHeader::Info firstInfo = BuildTestInfo();
+		SaveStateHeader::Info secondInfo;
+		secondInfo.debuggerState = true;
+		Image screenshot;
+		BuildTestScreenshot(screenshot);
+		REQUIRE(SaveStateHeader::Save(firstBuffer, firstInfo, &screenshot));
+		REQUIRE(SaveStateHeader::Save(secondBuffer, secondInfo, 0));
+		REQUIRE(firstBuffer.Size() == secondBuffer.Size());
+
+		SaveStateHeader::Info loadedInfo;
+		Image thumbnail;
+		secondBuffer.SetStreamPos(0);
+		REQUIRE(SaveStateHeader::Load(secondBuffer, loadedInfo, thumbnail));
+		REQUIRE(loadedInfo.debuggerState);
+		REQUIRE(loadedInfo.comments.empty());
+		REQUIRE(!loadedInfo.thumbnailPresent);
+	}
+	SECTION("Invalid header data", "")
+	{
+		Stream::Buffer buffer(0);
+		REQUIRE(SaveStateHeader::Save(buffer, BuildTestInfo(), 0));
+		SaveStateHeader::Info loadedInfo;
+		Image thumbnail;
+
+		// A truncated header is rejected
+		Stream::Buffer truncatedBuffer(0);
+		truncatedBuffer.WriteData(buffer.GetRawBuffer(), buffer.Size() / 2);
+		truncatedBuffer.SetStreamPos(0);
+		REQUIRE(!SaveStateHeader::Load(truncatedBuffer, loadedInfo, thumbnail));
+
+		// A header with an unknown signature is rejected
+		buffer[0] ^= 0xFF;
+		buffer.SetStreamPos(0);
+		REQUIRE(!SaveStateHeader::Load(buffer, loadedInfo, thumbnail));
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST_CASE("SaveStateHeader::LoadFromZIPArchive", "")
+{
+	SECTION("Header read without loading the state", "")
+	{
+		Stream::Buffer archiveBuffer(0);
+		BuildTestArchive(archiveBuffer, true);
+		SaveStateHeader::Info loadedInfo;
+		Image thumbnail;
+		REQUIRE(SaveStateHeader::LoadFromZIPArchive(archiveBuffer, loadedInfo, thumbnail));
+		REQUIRE(loadedInfo.comments == BuildTestInfo().comments);
+		REQUIRE(loadedInfo.thumbnailPresent);
+
+		// Only the leading header entry should have been read from the archive. We confirm
+		// this by reading the header again from a copy of the archive which has been cut
+		// off at the point where the first read stopped, which drops the state data and
+		// the central directory entirely.
+		Stream::IStream::SizeType bytesRead = archiveBuffer.GetStreamPos();
+		REQUIRE(bytesRead < archiveBuffer.Size());
+		Stream::Buffer truncatedArchiveBuffer(0);
+		truncatedArchiveBuffer.WriteData(archiveBuffer.GetRawBuffer(), bytesRead);
+		truncatedArchiveBuffer.SetStreamPos(0);
+		SaveStateHeader::Info truncatedLoadedInfo;
+		Image truncatedThumbnail;
+		REQUIRE(SaveStateHeader::LoadFromZIPArchive(truncatedArchiveBuffer, truncatedLoadedInfo, truncatedThumbnail));
+		REQUIRE(truncatedLoadedInfo.comments == BuildTestInfo().comments);
+	}
+	SECTION("Archives without a header", "")
+	{
+		// Savestates created before headers were introduced store the state first
+		Stream::Buffer archiveBuffer(0);
+		BuildTestArchive(archiveBuffer, false);
+		SaveStateHeader::Info loadedInfo;
+		Image thumbnail;
+		REQUIRE(!SaveStateHeader::LoadFromZIPArchive(archiveBuffer, loadedInfo, thumbnail));
+	}
+}
@@ -0,0 +1,217 @@
+#include "TraceRecorder.h"
+#include <sstream>
+#include <iomanip>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------------------------------------------------
+TraceRecorder::TraceRecorder()
+:_recordingEnabled(false), _nextThreadNo(1)
+{
+	// Assign a unique ID to this recorder. Each thread caches the buffer it last used
+	// along with the ID of the recorder that owns it, and an ID can't be reused by a later
+	// recorder allocated at the same address, unlike a pointer.
+	static std::atomic<unsigned int> nextRecorderID(1);
+	_recorderID = nextRecorderID.fetch_add(1);
+	_baseTime = std::chrono::steady_clock::now();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Interface version functions
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int TraceRecorder::GetITraceRecorderVersion() const
+{
+	return ThisITraceRecorderVersion();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Recording functions
+//----------------------------------------------------------------------------------------------------------------------
+bool TraceRecorder::TraceRecordingEnabled() const
+{
+	return _recordingEnabled.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TraceRecorder::SetTraceRecordingEnabled(bool state)
+{
+	_recordingEnabled.store(state, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TraceRecorder::RecordTraceEvent(EventType eventType, const char* eventName)
+{
+	if (!_recordingEnabled.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	// Write the event into the next slot in the ring for the calling thread, overwriting
+	// the oldest event if the ring is full, then publish it. Note that the ring is only
+	// allocated when the thread records its first event, so threads which never record
+	// anything don't pay for it.
+	ThreadBuffer& threadBuffer = GetCurrentThreadBuffer();
+	if (threadBuffer.events.empty())
+	{
+		threadBuffer.events.resize(ThreadBufferEventCount);
+	}
+	unsigned long long eventNo = threadBuffer.eventCount.load(std::memory_order_relaxed);
+	TraceEvent& traceEvent = threadBuffer.events[(size_t)(eventNo % ThreadBufferEventCount)];
+	traceEvent.timestamp = (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _baseTime).count();
+	traceEvent.eventType = eventType;
+	unsigned int nameLength = 0;
+	while ((nameLength < (EventNameBufferSize - 1)) && (eventName[nameLength] != '\0'))
+	{
+		traceEvent.eventName[nameLength] = eventName[nameLength];
+		++nameLength;
+	}
+	traceEvent.eventName[nameLength] = '\0';
+	threadBuffer.eventCount.store(eventNo + 1, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TraceRecorder::SetCurrentThreadTraceName(const Marshal::In<std::wstring>& threadName)
+{
+	// If this thread already has a buffer, rename it. Otherwise, continue in the buffer
+	// of a previous thread with the same name which has since exited, or create a new
+	// buffer if there isn't one.
+	std::wstring threadNameString = threadName;
+	ThreadBufferBinding& binding = GetCurrentThreadBufferBinding();
+	if (binding.recorderID == _recorderID)
+	{
+		std::unique_lock<std::mutex> lock(_threadBufferMutex);
+		binding.threadBuffer->threadName = threadNameString;
+		return;
+	}
+	CreateThreadBuffer(threadNameString);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TraceRecorder::ClearTrace()
+{
+	std::unique_lock<std::mutex> lock(_threadBufferMutex);
+	for (const std::shared_ptr<ThreadBuffer>& threadBuffer : _threadBuffers)
+	{
+		threadBuffer->clearedEventCount.store(threadBuffer->eventCount.load(std::memory_order_acquire), std::memory_order_relaxed);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Export functions
+//----------------------------------------------------------------------------------------------------------------------
+std::string TraceRecorder::BuildChromeTraceJSON() const
+{
+	// Note that events are read while other threads may still be recording. Each event is
+	// only read after its slot has been published, but if a thread wraps around its ring
+	// during the export, the oldest events for that thread may be replaced before they're
+	// read. Recording should be disabled before exporting to obtain a consistent trace.
+	std::ostringstream json;
+	json << std::fixed << std::setprecision(3);
+	json << "{\"traceEvents\":[\n";
+	bool firstEntry = true;
+	std::unique_lock<std::mutex> lock(_threadBufferMutex);
+	for (const std::shared_ptr<ThreadBuffer>& threadBuffer : _threadBuffers)
+	{
+		// Write the thread name as a metadata event
+		std::string threadName;
+		for (wchar_t threadNameChar : threadBuffer->threadName)
+		{
+			threadName.push_back(((threadNameChar >= L' ') && (threadNameChar < 0x7F) && (threadNameChar != L'"') && (threadNameChar != L'\\'))? (char)threadNameChar: '_');
+		}
+		if (threadName.empty())
+		{
+			threadName = "Thread " + std::to_string(threadBuffer->threadNo);
+		}
+		json << (firstEntry? "": ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadBuffer->threadNo << ",\"args\":{\"name\":\"" << threadName << "\"}}";
+		firstEntry = false;
+
+		// Write each event which is still held in the ring for this thread
+		unsigned long long eventCount = threadBuffer->eventCount.load(std::memory_order_acquire);
+		unsigned long long firstEventNo = threadBuffer->clearedEventCount.load(std::memory_order_relaxed);
+		if ((eventCount - firstEventNo) > ThreadBufferEventCount)
+		{
+			firstEventNo = eventCount - ThreadBufferEventCount;
+		}
+		for (unsigned long long eventNo = firstEventNo; eventNo < eventCount; ++eventNo)
+		{
+			const TraceEvent& traceEvent = threadBuffer->events[(size_t)(eventNo % ThreadBufferEventCount)];
+			const char* phase = (traceEvent.eventType == EventType::Begin)? "B": (traceEvent.eventType == EventType::End)? "E": "i";
+			json << ",\n{\"name\":\"";
+			for (const char* eventNameChar = &traceEvent.eventName[0]; *eventNameChar != '\0'; ++eventNameChar)
+			{
+				json << (((*eventNameChar == '"') || (*eventNameChar == '\\'))? '_': *eventNameChar);
+			}
+			json << "\",\"ph\":\"" << phase << "\",\"ts\":" << ((double)traceEvent.timestamp / 1000.0) << ",\"pid\":1,\"tid\":" << threadBuffer->threadNo;
+			if (traceEvent.eventType == EventType::Instant)
+			{
+				json << ",\"s\":\"t\"";
+			}
+			json << "}";
+		}
+	}
+	json << "\n],\"displayTimeUnit\":\"ns\"}\n";
+	return json.str();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Buffer functions
+//----------------------------------------------------------------------------------------------------------------------
+TraceRecorder::ThreadBuffer& TraceRecorder::GetCurrentThreadBuffer()
+{
+	ThreadBufferBinding& binding = GetCurrentThreadBufferBinding();
+	if (binding.recorderID == _recorderID)
+	{
+		return *binding.threadBuffer;
+	}
+	return CreateThreadBuffer(L"");
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TraceRecorder::ThreadBufferBinding& TraceRecorder::GetCurrentThreadBufferBinding()
+{
+	thread_local ThreadBufferBinding binding;
+	return binding;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TraceRecorder::ThreadBuffer& TraceRecorder::CreateThreadBuffer(const std::wstring& threadName)
+{
+	std::unique_lock<std::mutex> lock(_threadBufferMutex);
+
+	// Attempt to find a buffer with the same name which is no longer bound to a thread
+	std::shared_ptr<ThreadBuffer> threadBuffer;
+	if (!threadName.empty())
+	{
+		for (const std::shared_ptr<ThreadBuffer>& existingThreadBuffer : _threadBuffers)
+		{
+			if ((existingThreadBuffer->threadName == threadName) && !existingThreadBuffer->threadActive.load(std::memory_order_acquire))
+			{
+				threadBuffer = existingThreadBuffer;
+				break;
+			}
+		}
+	}
+
+	// Create a new buffer if we didn't find one to reuse
+	if (!threadBuffer)
+	{
+		threadBuffer.reset(new ThreadBuffer());
+		threadBuffer->threadNo = _nextThreadNo++;
+		threadBuffer->threadName = threadName;
+		threadBuffer->eventCount.store(0, std::memory_order_relaxed);
+		threadBuffer->clearedEventCount.store(0, std::memory_order_relaxed);
+		_threadBuffers.push_back(threadBuffer);
+	}
+	threadBuffer->threadActive.store(true, std::memory_order_relaxed);
+
+	// Bind the buffer to the calling thread. If this thread was previously bound to a
+	// buffer in another recorder, that buffer is released for reuse.
+	ThreadBufferBinding& binding = GetCurrentThreadBufferBinding();
+	if (binding.threadBuffer)
+	{
+		binding.threadBuffer->threadActive.store(false, std::memory_order_release);
+	}
+	binding.recorderID = _recorderID;
+	binding.threadBuffer = threadBuffer;
+	return *threadBuffer;
+}
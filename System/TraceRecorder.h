@@ -0,0 +1,63 @@
+#ifndef __TRACERECORDER_H__
+#define __TRACERECORDER_H__
+#include "DeviceInterface/DeviceInterface.pkg"
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <vector>
+
+// Records scheduling events from any thread into per-thread buffers, and exports them in
+// the Chrome trace event format, which can be loaded into chrome://tracing or Perfetto.
+// Each thread owns its own fixed size ring of events, so recording an event never takes
+// a lock once the thread has been registered. When recording is disabled, the only cost
+// at each trace point is a check of the enable flag.
+class TraceRecorder :public ITraceRecorder
+{
+public:
+	// Constructors
+	TraceRecorder();
+
+	// Interface version functions
+	virtual unsigned int GetITraceRecorderVersion() const;
+
+	// Recording functions
+	virtual bool TraceRecordingEnabled() const;
+	void SetTraceRecordingEnabled(bool state);
+	virtual void RecordTraceEvent(EventType eventType, const char* eventName);
+	virtual void SetCurrentThreadTraceName(const Marshal::In<std::wstring>& threadName);
+	void ClearTrace();
+
+	// Export functions
+	std::string BuildChromeTraceJSON() const;
+
+private:
+	// Constants
+	static const unsigned int ThreadBufferEventCount = 0x10000;
+	static const unsigned int EventNameBufferSize = 48;
+
+	// Structures
+	struct TraceEvent;
+	struct ThreadBuffer;
+	struct ThreadBufferBinding;
+
+private:
+	// Buffer functions
+	ThreadBuffer& GetCurrentThreadBuffer();
+	static ThreadBufferBinding& GetCurrentThreadBufferBinding();
+	ThreadBuffer& CreateThreadBuffer(const std::wstring& threadName);
+
+private:
+	unsigned int _recorderID;
+	std::atomic<bool> _recordingEnabled;
+	std::chrono::steady_clock::time_point _baseTime;
+	mutable std::mutex _threadBufferMutex;
+	std::list<std::shared_ptr<ThreadBuffer>> _threadBuffers;
+	unsigned int _nextThreadNo;
+};
+
+#include "TraceRecorder.inl"
+#endif
@@ -0,0 +1,49 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Structures
+//----------------------------------------------------------------------------------------------------------------------
+struct TraceRecorder::TraceEvent
+{
+	unsigned long long timestamp;
+	EventType eventType;
+	char eventName[EventNameBufferSize];
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+struct TraceRecorder::ThreadBuffer
+{
+	unsigned int threadNo;
+	std::wstring threadName;
+	std::atomic<bool> threadActive;
+	std::vector<TraceEvent> events;
+
+	// Note that the event count is only ever advanced by the owning thread. Events are
+	// written into the ring before the count is published, so a reader only needs to
+	// acquire the count to see complete events. The cleared event count records the event
+	// count at the time the trace was last cleared, so that clearing the trace never
+	// needs to modify the count the owning thread is advancing.
+	std::atomic<unsigned long long> eventCount;
+	std::atomic<unsigned long long> clearedEventCount;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Binds a thread to the buffer it records into. This is held in thread local storage, and
+// flags the buffer as no longer in use when the thread exits, so that the next thread
+// registered with the same name can continue in the same buffer. Device worker threads
+// are recreated each time the system starts, so without this a new buffer would be
+// created for each run.
+struct TraceRecorder::ThreadBufferBinding
+{
+	ThreadBufferBinding()
+	:recorderID(0)
+	{ }
+	~ThreadBufferBinding()
+	{
+		if (threadBuffer)
+		{
+			threadBuffer->threadActive.store(false, std::memory_order_release);
+		}
+	}
+
+	unsigned int recorderID;
+	std::shared_ptr<ThreadBuffer> threadBuffer;
+};